@@ -48,6 +48,7 @@
 #include <86box/config.h>
 #include <86box/mem.h>
 #include "cpu.h"
+#include "opbench.h"
 #ifdef USE_DYNAREC
 #    include "codegen_public.h"
 #endif
@@ -89,7 +90,15 @@
 #include <86box/scsi_disk.h>
 #include <86box/cdrom_image.h>
 #include <86box/thread.h>
+#include <86box/bench.h>
 #include <86box/network.h>
+#include <86box/replay.h>
+#include <86box/postff.h>
+#include <86box/frameexport.h>
+#include <86box/telemetry.h>
+#include <86box/perfstats.h>
+#include <86box/control.h>
+#include <86box/watchdog.h>
 #include <86box/sound.h>
 #include <86box/midi.h>
 #include <86box/snd_speaker.h>
@@ -187,6 +196,9 @@ uint32_t mem_size                               = 0;              /* (C) memory
                                                                          system board)*/
 uint32_t isa_mem_size                           = 0;              /* (C) memory size (ISA Memory Cards) */
 int      cpu_use_dynarec                        = 0;              /* (C) cpu uses/needs Dyna */
+int      cpu_dynarec_threshold                  = 0;              /* (C) dynarec warm-up threshold */
+int      mem_hugepages                          = 0;              /* (C) use host huge pages for
+                                                                         guest RAM and the JIT arena */
 int      cpu                                    = 0;              /* (C) cpu type */
 int      fpu_type                               = 0;              /* (C) fpu type */
 int      fpu_softfloat                          = 0;              /* (C) fpu uses softfloat */
@@ -213,6 +225,18 @@ extern int writelnum;
 int fps;
 int framecount;
 
+/* Cycle-slice governor: pc_run() measures the host time each emulated
+   slice takes; once a second pc_onesec() turns the samples into speed
+   percentiles, steers the slice length from the median, and the title
+   readout shows the median instead of the raw frame count. */
+int pc_slice_ms  = 10;
+int pc_speed_p50 = 100;
+int pc_speed_p99 = 100;
+
+#define SLICE_SAMPLES 128
+static uint16_t slice_speed[SLICE_SAMPLES];
+static int      slice_samples = 0;
+
 extern int CPUID;
 extern int output;
 int        atfullspeed;
@@ -227,8 +251,7 @@ int   scrnsz_y = SCREEN_RES_Y; /* current screen size, Y */
 #endif
 int config_changed; /* config has changed */
 int title_update;
-int framecountx        = 0;
-int hard_reset_pending = 0;
+int framecountx = 0;
 
 #if 0
 int unscaled_size_x = SCREEN_RES_X; /* current unscaled size X */
@@ -241,6 +264,47 @@ static wchar_t mouse_msg[3][200];
 static volatile atomic_int do_pause_ack = 0;
 static volatile atomic_int pause_ack = 0;
 
+/* Lock-free single-producer/single-consumer command ring between the UI
+   thread (producer) and the CPU thread (consumer). Each index is only ever
+   advanced by its owning thread, so a release store by the writer paired
+   with an acquire load by the reader is all the synchronization needed -
+   the CPU thread's per-frame poll never takes a mutex, and the UI thread
+   no longer pokes at emulator state (keyboard queue, device teardown)
+   behind the CPU thread's back. */
+#define PC_CMD_QUEUE_LEN  16 /* must be a power of two */
+#define PC_CMD_QUEUE_MASK (PC_CMD_QUEUE_LEN - 1)
+
+enum {
+    PC_CMD_HARD_RESET = 1, /* tear down and reinitialize the machine */
+    PC_CMD_SEND_CA         /* inject Ctrl+Alt+<payload scancode> */
+};
+
+typedef struct pc_cmd_t {
+    int      cmd;
+    uint16_t payload;
+} pc_cmd_t;
+
+static pc_cmd_t             pc_cmd_ring[PC_CMD_QUEUE_LEN];
+static volatile atomic_uint pc_cmd_head = 0;
+static volatile atomic_uint pc_cmd_tail = 0;
+
+/* Queue a command for the CPU thread. UI thread only. */
+static void
+pc_cmd_queue(int cmd, uint16_t payload)
+{
+    unsigned int head = atomic_load_explicit(&pc_cmd_head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&pc_cmd_tail, memory_order_acquire);
+
+    /* A full ring means the CPU thread is already about to process a frame's
+       worth of commands - dropping matches what the old one-shot flags did. */
+    if ((head - tail) >= PC_CMD_QUEUE_LEN)
+        return;
+
+    pc_cmd_ring[head & PC_CMD_QUEUE_MASK].cmd     = cmd;
+    pc_cmd_ring[head & PC_CMD_QUEUE_MASK].payload = payload;
+    atomic_store_explicit(&pc_cmd_head, head + 1, memory_order_release);
+}
+
 #ifndef RELEASE_BUILD
 static char buff[1024];
 static int  seen = 0;
@@ -462,6 +526,11 @@ pc_init(int argc, char *argv[])
     time_t           now;
     int              c;
     int              lvmp = 0;
+    int              bench_secs = 0;
+    char             bench_file[1024] = { 0 };
+    int              control_port = 0;
+    int              watchdog_secs = 0;
+    char             watchdog_file[1024] = { 0 };
 #ifdef ENABLE_NG
     int ng = 0;
 #endif
@@ -522,7 +591,12 @@ usage:
             printf("\nUsage: 86box [options] [cfg-file]\n\n");
             printf("Valid options are:\n\n");
             printf("-? or --help            - show this information\n");
+            printf("-A or --frameexport p   - export frames to the shared-memory file 'p'\n");
+            printf("-B or --bench s,path    - run for 's' emulated seconds, then write\n");
+            printf("                          a JSON benchmark report to 'path' and exit\n");
             printf("-C or --config path     - set 'path' to be config file\n");
+            printf("      --control port    - accept orchestration commands on loopback\n");
+            printf("                          TCP port 'port'\n");
 #ifdef _WIN32
             printf("-D or --debug           - force debug output logging\n");
 #endif
@@ -542,12 +616,22 @@ usage:
             printf("-L or --logfile path    - set 'path' to be the logfile\n");
             printf("-M or --missing         - dump missing machines and video cards\n");
             printf("-N or --noconfirm       - do not ask for confirmation on quit\n");
+            printf("-O or --opbench path    - write a per-opcode host-cycle report to\n");
+            printf("                          'path' on exit\n");
             printf("-P or --vmpath path     - set 'path' to be root for vm\n");
+            printf("-Q or --replay path     - replay the input recording at 'path'\n");
             printf("-R or --rompath path    - set 'path' to be ROM path\n");
+            printf("-T or --postff secs     - snapshot 'secs' seconds after the first hard\n");
+            printf("                          reset and fast-forward POST on later ones\n");
 #ifndef USE_SDL_UI
             printf("-S or --settings        - show only the settings dialog\n");
 #endif
+            printf("-U or --record path     - record nondeterministic inputs to 'path'\n");
             printf("-V or --vmname name     - overrides the name of the running VM\n");
+            printf("-W or --telemetry p     - export per-slice timing records to the\n");
+            printf("                          shared-memory file 'p'\n");
+            printf("      --watchdog s,path - write a hang dump to 'path' when no\n");
+            printf("                          emulation slice completes for 's' seconds\n");
             printf("-X or --clear what      - clears the 'what' (cmos/flash/both)\n");
             printf("-Y or --donothing       - do not show any UI or run the emulation\n");
             printf("-Z or --lastvmpath      - the last parameter is VM path rather than config\n");
@@ -573,6 +657,36 @@ usage:
                 goto usage;
 
             strcpy(log_path, argv[++c]);
+        } else if (!strcasecmp(argv[c], "--opbench") || !strcasecmp(argv[c], "-O")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            opbench_start(argv[++c]);
+        } else if (!strcasecmp(argv[c], "--replay") || !strcasecmp(argv[c], "-Q")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            replay_start_play(argv[++c]);
+        } else if (!strcasecmp(argv[c], "--record") || !strcasecmp(argv[c], "-U")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            replay_start_record(argv[++c]);
+        } else if (!strcasecmp(argv[c], "--postff") || !strcasecmp(argv[c], "-T")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            postff_start(atoi(argv[++c]));
+        } else if (!strcasecmp(argv[c], "--frameexport") || !strcasecmp(argv[c], "-A")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            frameexport_start(argv[++c]);
+        } else if (!strcasecmp(argv[c], "--telemetry") || !strcasecmp(argv[c], "-W")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            telemetry_start(argv[++c]);
         } else if (!strcasecmp(argv[c], "--vmpath") || !strcasecmp(argv[c], "-P")) {
             if ((c + 1) == argc)
                 goto usage;
@@ -584,6 +698,37 @@ usage:
 
             rpath = argv[++c];
             rom_add_path(rpath);
+        } else if (!strcasecmp(argv[c], "--bench") || !strcasecmp(argv[c], "-B")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            temp2 = (char *) calloc(2048, 1);
+            if (sscanf(argv[++c], "%i,%2047s", &bench_secs, temp2) != 2) {
+                free(temp2);
+                goto usage;
+            }
+            strcpy(bench_file, temp2);
+            free(temp2);
+            temp2 = NULL;
+        } else if (!strcasecmp(argv[c], "--watchdog")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            temp2 = (char *) calloc(2048, 1);
+            if (sscanf(argv[++c], "%i,%2047s", &watchdog_secs, temp2) != 2) {
+                free(temp2);
+                goto usage;
+            }
+            strcpy(watchdog_file, temp2);
+            free(temp2);
+            temp2 = NULL;
+        } else if (!strcasecmp(argv[c], "--control")) {
+            if ((c + 1) == argc)
+                goto usage;
+
+            control_port = atoi(argv[++c]);
+            if ((control_port <= 0) || (control_port > 65535))
+                goto usage;
         } else if (!strcasecmp(argv[c], "--config") || !strcasecmp(argv[c], "-C")) {
             if ((c + 1) == argc || plat_dir_check(argv[c + 1]))
                 goto usage;
@@ -881,6 +1026,16 @@ usage:
 
     gdbstub_init();
 
+    if (control_port > 0)
+        control_init(control_port);
+
+    if (watchdog_secs > 0)
+        watchdog_start(watchdog_secs, watchdog_file);
+
+    /* Start the benchmark harness if we were asked to. */
+    if (bench_secs > 0)
+        bench_start(bench_file, bench_secs);
+
     /* All good! */
     return 1;
 }
@@ -938,6 +1093,9 @@ pc_init_modules(void)
     }
 
     pc_log("Scanning for ROM images:\n");
+    /* Probe all machines in parallel; the loops below then hit the
+       availability cache. Nearly all of the cold-start cost is here. */
+    machine_available_scan_all();
     c = m = 0;
     while (machine_get_internal_name_ex(m) != NULL) {
         c += machine_available(m);
@@ -1042,8 +1200,9 @@ pc_init_modules(void)
     return 1;
 }
 
-void
-pc_send_ca(uint16_t sc)
+/* Inject a Ctrl+Alt+key sequence into the keyboard queue. CPU thread only. */
+static void
+pc_send_ca_now(uint16_t sc)
 {
     keyboard_input(1, 0x1D); /* Ctrl key pressed */
     keyboard_input(1, 0x38); /* Alt key pressed */
@@ -1053,6 +1212,12 @@ pc_send_ca(uint16_t sc)
     keyboard_input(0, 0x1D); /* Ctrl key released */
 }
 
+void
+pc_send_ca(uint16_t sc)
+{
+    pc_cmd_queue(PC_CMD_SEND_CA, sc);
+}
+
 /* Send the machine a Control-Alt-DEL sequence. */
 void
 pc_send_cad(void)
@@ -1235,6 +1400,8 @@ pc_reset_hard_init(void)
        the IDE controllers present are not some form of PCI. */
     ide_drives_set_shadow();
 
+    replay_machine_init();
+
     /* Reset the CPU module. */
     resetx86();
     dma_reset();
@@ -1252,6 +1419,10 @@ pc_reset_hard_init(void)
     cycles_main = 0;
 #endif
 
+    /* Restore the post-POST state (or arm its capture) now that the whole
+       machine has been reinitialized. */
+    postff_machine_init();
+
     update_mouse_msg();
 
     ui_hard_reset_completed();
@@ -1297,7 +1468,7 @@ update_mouse_msg(void)
 void
 pc_reset_hard(void)
 {
-    hard_reset_pending = 1;
+    pc_cmd_queue(PC_CMD_HARD_RESET, 0);
 }
 
 void
@@ -1314,8 +1485,16 @@ pc_close(UNUSED(thread_t *ptr))
 
     nvr_save();
 
+#if defined(USE_DYNAREC) && defined(USE_NEW_DYNAREC)
+    codegen_cache_save();
+#endif
+
     config_save();
 
+    opbench_report();
+
+    replay_close();
+
     plat_mouse_capture(0);
 
     /* Close all the memory mappings. */
@@ -1377,36 +1556,80 @@ ack_pause(void)
     }
 }
 
+/* Drain pending UI commands. CPU thread only. */
+static void
+pc_cmd_process(void)
+{
+    unsigned int tail = atomic_load_explicit(&pc_cmd_tail, memory_order_relaxed);
+
+    while (atomic_load_explicit(&pc_cmd_head, memory_order_acquire) != tail) {
+        const pc_cmd_t *cmd = &pc_cmd_ring[tail & PC_CMD_QUEUE_MASK];
+
+        switch (cmd->cmd) {
+            case PC_CMD_HARD_RESET:
+                pc_reset_hard_close();
+                pc_reset_hard_init();
+                break;
+
+            case PC_CMD_SEND_CA:
+                pc_send_ca_now(cmd->payload);
+                break;
+
+            default:
+                break;
+        }
+
+        tail++;
+        atomic_store_explicit(&pc_cmd_tail, tail, memory_order_release);
+    }
+}
+
 void
 pc_run(void)
 {
-    int     mouse_msg_idx;
-    wchar_t temp[200];
-
-    /* Trigger a hard reset if one is pending. */
-    if (hard_reset_pending) {
-        hard_reset_pending = 0;
-        pc_reset_hard_close();
-        pc_reset_hard_init();
-    }
+    int      mouse_msg_idx;
+    int      slice = pc_slice_ms;
+    uint32_t slice_start;
+    uint32_t slice_us;
+    uint32_t pct;
+    wchar_t  temp[200];
+
+    slice_start = plat_get_micro_ticks();
+
+    /* Process any commands the UI thread has queued. */
+    pc_cmd_process();
 
     /* Run a block of code. */
     startblit();
-    cpu_exec((int32_t) cpu_s->rspeed / 100);
+    cpu_exec(((int32_t) cpu_s->rspeed / 100) * (slice / 10));
     ack_pause();
 #ifdef USE_GDBSTUB /* avoid a KBC FIFO overflow when CPU emulation is stalled */
     if (gdbstub_step == GDBSTUB_EXEC) {
 #endif
         if (!mouse_timed)
             mouse_process();
+        keyboard_process();
 #ifdef USE_GDBSTUB /* avoid a KBC FIFO overflow when CPU emulation is stalled */
     }
 #endif
     joystick_process();
     endblit();
 
+    /* Return idle all-zero guest RAM to the host between slices. */
+    mem_scavenge(64);
+
+    /* Achieved speed of this slice in percent of real time. */
+    slice_us = plat_get_micro_ticks() - slice_start;
+    pct      = ((uint32_t) slice * 100000) / (slice_us ? slice_us : 1);
+    if (pct > 999)
+        pct = 999;
+    if (slice_samples < SLICE_SAMPLES)
+        slice_speed[slice_samples++] = pct;
+    telemetry_slice(slice, slice_us, pct);
+    watchdog_slice();
+
     /* Done with this frame, update statistics. */
-    framecount++;
+    framecount += slice / 10;
     if (++framecountx >= 100) {
         framecountx = 0;
         frames      = 0;
@@ -1414,7 +1637,7 @@ pc_run(void)
 
     if (title_update) {
         mouse_msg_idx = ((mouse_type == MOUSE_TYPE_NONE) || (mouse_input_mode >= 1)) ? 2 : !!mouse_capture;
-        swprintf(temp, sizeof_w(temp), mouse_msg[mouse_msg_idx], fps);
+        swprintf(temp, sizeof_w(temp), mouse_msg[mouse_msg_idx], pc_speed_p50);
 #ifdef __APPLE__
         /* Needed due to modifying the UI on the non-main thread is a big no-no. */
         dispatch_async_f(dispatch_get_main_queue(), wcsdup((const wchar_t *) temp), _ui_window_title);
@@ -1425,6 +1648,12 @@ pc_run(void)
     }
 }
 
+static int
+slice_speed_cmp(const void *a, const void *b)
+{
+    return (int) *(const uint16_t *) a - (int) *(const uint16_t *) b;
+}
+
 /* Handler for the 1-second timer to refresh the window title. */
 void
 pc_onesec(void)
@@ -1432,6 +1661,27 @@ pc_onesec(void)
     fps        = framecount;
     framecount = 0;
 
+    if (slice_samples > 0) {
+        qsort(slice_speed, slice_samples, sizeof(uint16_t), slice_speed_cmp);
+        pc_speed_p50 = slice_speed[slice_samples / 2];
+        pc_speed_p99 = slice_speed[slice_samples / 100];
+
+        /* Steer the slice length: when the median slice cannot hold real
+           time, widen it to amortize the per-slice overhead; narrow it
+           again once there is headroom, to keep input latency down. */
+        if ((pc_speed_p50 < 100) && (pc_slice_ms < 40))
+            pc_slice_ms <<= 1;
+        else if ((pc_speed_p50 >= 110) && (pc_slice_ms > 10))
+            pc_slice_ms >>= 1;
+
+        slice_samples = 0;
+    }
+
+    bench_onesec(fps);
+    /* Snapshot the counters before perfstats_onesec() resets them. */
+    control_onesec(fps);
+    perfstats_onesec(fps);
+
     title_update = 1;
 }
 
@@ -1601,4 +1851,11 @@ do_pause(int p)
             ;
     }
     atomic_store(&pause_ack, 0);
+
+    /* The machine is now parked: the CPU thread has acknowledged the pause
+       and burns no cycles, all timers are frozen in emulated time (so they
+       simply continue from the same point on resume), and guest RAM can be
+       reclaimed by the host until the guest touches it again. */
+    if ((p == 1) && !old_p)
+        mem_compact();
 }
@@ -1251,6 +1251,50 @@ acpi_aux_reg_write_common(int size, uint16_t addr, uint8_t val, void *priv)
         acpi_aux_reg_write_smc(size, addr, val, priv);
 }
 
+/* Dedicated PM_TMR read handlers: Windows polls the timer register hard
+   enough that it shows up in I/O port traces, and every vendor maps it at
+   offset 0x08 through the common register block. These skip the per-byte
+   vendor dispatch, derive the value from the TSC once per access and keep
+   the port eligible for the flattened single-handler dispatch in io.c. */
+static uint8_t
+acpi_pm_tmr_read(uint16_t addr, void *priv)
+{
+    acpi_t *dev = (acpi_t *) priv;
+    uint8_t ret = (acpi_timer_get(dev) >> ((addr & 3) << 3)) & 0xff;
+
+#ifdef USE_DYNAREC
+    if (cpu_use_dynarec)
+        update_tsc();
+#endif
+    return ret;
+}
+
+static uint16_t
+acpi_pm_tmr_readw(uint16_t addr, void *priv)
+{
+    acpi_t  *dev = (acpi_t *) priv;
+    uint16_t ret = (acpi_timer_get(dev) >> ((addr & 3) << 3)) & 0xffff;
+
+#ifdef USE_DYNAREC
+    if (cpu_use_dynarec)
+        update_tsc();
+#endif
+    return ret;
+}
+
+static uint32_t
+acpi_pm_tmr_readl(uint16_t addr, void *priv)
+{
+    acpi_t  *dev = (acpi_t *) priv;
+    uint32_t ret = acpi_timer_get(dev) >> ((addr & 3) << 3);
+
+#ifdef USE_DYNAREC
+    if (cpu_use_dynarec)
+        update_tsc();
+#endif
+    return ret;
+}
+
 static uint32_t
 acpi_reg_readl(uint16_t addr, void *priv)
 {
@@ -1412,7 +1456,13 @@ acpi_update_io_mapping(acpi_t *dev, uint32_t base, int chipset_en)
     acpi_log("ACPI: Update I/O %04X to %04X (%sabled)\n", dev->io_base, base, chipset_en ? "en" : "dis");
 
     if (dev->io_base != 0x0000) {
-        io_removehandler(dev->io_base, size,
+        io_removehandler(dev->io_base, 0x008,
+                         acpi_reg_read, acpi_reg_readw, acpi_reg_readl,
+                         acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
+        io_removehandler(dev->io_base + 0x008, 0x004,
+                         acpi_pm_tmr_read, acpi_pm_tmr_readw, acpi_pm_tmr_readl,
+                         acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
+        io_removehandler(dev->io_base + 0x00c, size - 0x00c,
                          acpi_reg_read, acpi_reg_readw, acpi_reg_readl,
                          acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
     }
@@ -1420,7 +1470,14 @@ acpi_update_io_mapping(acpi_t *dev, uint32_t base, int chipset_en)
     dev->io_base = base;
 
     if (chipset_en && (dev->io_base != 0x0000)) {
-        io_sethandler(dev->io_base, size,
+        /* The PM_TMR dword gets its own read handlers; see above. */
+        io_sethandler(dev->io_base, 0x008,
+                      acpi_reg_read, acpi_reg_readw, acpi_reg_readl,
+                      acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
+        io_sethandler(dev->io_base + 0x008, 0x004,
+                      acpi_pm_tmr_read, acpi_pm_tmr_readw, acpi_pm_tmr_readl,
+                      acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
+        io_sethandler(dev->io_base + 0x00c, size - 0x00c,
                       acpi_reg_read, acpi_reg_readw, acpi_reg_readl,
                       acpi_reg_write, acpi_reg_writew, acpi_reg_writel, dev);
     }
@@ -0,0 +1,144 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Macro-benchmark harness. Started from the command line
+ *          (--bench secs,path), it samples the performance counters and
+ *          the host wall clock once per emulated second, and after the
+ *          requested number of emulated seconds writes a JSON report and
+ *          powers the machine off. Combined with a fixed config and a
+ *          scripted workload on the boot disk this gives a deterministic,
+ *          machine-readable run for regression tracking and bisection.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/machine.h>
+#include <86box/plat.h>
+#include <86box/bench.h>
+#include <86box/perfstats.h>
+
+/* One sample is taken per emulated second. */
+typedef struct bench_sample_t {
+    uint64_t insns;       /* guest instructions executed */
+    uint64_t blocks;      /* recompiler blocks compiled */
+    uint64_t evictions;   /* recompiler blocks deleted */
+    uint64_t lookups;     /* address lookup cache fills */
+    uint64_t timers;      /* timer callbacks dispatched */
+    uint32_t host_ms;     /* host wall-clock time spent on this emulated second */
+    int      fps;         /* frames rendered */
+} bench_sample_t;
+
+int bench_on = 0;
+
+static char            bench_path[1024];
+static int             bench_seconds  = 0;
+static int             bench_cur      = 0;
+static uint32_t        bench_last_ms  = 0;
+static bench_sample_t *bench_samples  = NULL;
+
+void
+bench_start(const char *path, int seconds)
+{
+    strncpy(bench_path, path, sizeof(bench_path) - 1);
+    bench_seconds = seconds;
+    bench_cur     = 0;
+    bench_samples = (bench_sample_t *) calloc(seconds, sizeof(bench_sample_t));
+    bench_last_ms = plat_get_ticks();
+    bench_on      = 1;
+}
+
+static void
+bench_report(void)
+{
+    FILE    *fp;
+    uint64_t total_insns = 0;
+    uint64_t total_ms    = 0;
+    uint64_t total_fps   = 0;
+
+    fp = plat_fopen(bench_path, "w");
+    if (fp == NULL) {
+        pclog("BENCH: unable to open \"%s\" for writing\n", bench_path);
+        return;
+    }
+
+    for (int i = 0; i < bench_cur; i++) {
+        total_insns += bench_samples[i].insns;
+        total_ms += bench_samples[i].host_ms;
+        total_fps += bench_samples[i].fps;
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"vm\": \"%s\",\n", vm_name);
+    fprintf(fp, "  \"machine\": \"%s\",\n", machine_get_internal_name());
+    fprintf(fp, "  \"cpu\": \"%s\",\n", cpu_s->name);
+    fprintf(fp, "  \"dynarec\": %d,\n", cpu_use_dynarec);
+    fprintf(fp, "  \"emulated_seconds\": %d,\n", bench_cur);
+    fprintf(fp, "  \"host_ms\": %" PRIu64 ",\n", total_ms);
+    fprintf(fp, "  \"avg_mips\": %.3f,\n",
+            total_ms ? ((double) total_insns / 1000.0 / (double) total_ms) : 0.0);
+    fprintf(fp, "  \"avg_fps\": %.1f,\n",
+            bench_cur ? ((double) total_fps / (double) bench_cur) : 0.0);
+    fprintf(fp, "  \"seconds\": [\n");
+    for (int i = 0; i < bench_cur; i++) {
+        const bench_sample_t *s = &bench_samples[i];
+
+        fprintf(fp,
+                "    { \"insns\": %" PRIu64 ", \"blocks\": %" PRIu64
+                ", \"evictions\": %" PRIu64 ", \"lookups\": %" PRIu64
+                ", \"timers\": %" PRIu64 ", \"host_ms\": %u, \"fps\": %d }%s\n",
+                s->insns, s->blocks, s->evictions, s->lookups, s->timers,
+                s->host_ms, s->fps, (i < (bench_cur - 1)) ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+    fclose(fp);
+
+    pclog("BENCH: report written to \"%s\"\n", bench_path);
+}
+
+/* Called from the 1-second timer, before the performance counters are reset. */
+void
+bench_onesec(int cur_fps)
+{
+    bench_sample_t *s;
+    uint32_t        now = plat_get_ticks();
+
+    if (!bench_on || (bench_cur >= bench_seconds))
+        return;
+
+    s            = &bench_samples[bench_cur++];
+    s->insns     = perfc.insns;
+    s->blocks    = perfc.blocks_compiled;
+    s->evictions = perfc.blocks_deleted;
+    s->lookups   = perfc.lookup_fills;
+    s->timers    = perfc.timer_fires;
+    s->host_ms   = now - bench_last_ms;
+    s->fps       = cur_fps;
+    bench_last_ms = now;
+
+    if (bench_cur == bench_seconds) {
+        bench_on = 0;
+        bench_report();
+        free(bench_samples);
+        bench_samples = NULL;
+        plat_power_off();
+    }
+}
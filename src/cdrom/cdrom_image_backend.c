@@ -23,6 +23,7 @@
 #include <ctype.h>
 #include <inttypes.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -38,6 +39,7 @@
 #include <86box/86box.h>
 #include <86box/path.h>
 #include <86box/plat.h>
+#include <86box/thread.h>
 #include <86box/cdrom_image_backend.h>
 
 #define CDROM_BCD(x)        (((x) % 10) | (((x) / 10) << 4))
@@ -48,6 +50,57 @@
 
 static char temp_keyword[1024];
 
+/* Chunked read cache with background prefetch for binary track files.
+   Both data reads and CD audio playback funnel through bin_read, so one
+   cache smooths out host latency (network shares and the like) for both. */
+#define BIN_CACHE_CHUNK_SIZE (128 * 1024)
+#define BIN_CACHE_CHUNKS     8
+#define BIN_CACHE_PF_DEPTH   3 /* Chunks fetched speculatively ahead of the reader. */
+
+typedef struct bin_chunk_t {
+    uint64_t tag; /* Chunk index within the file. */
+    uint32_t lru;
+    uint8_t  valid;
+    uint8_t *data;
+} bin_chunk_t;
+
+typedef struct bin_cache_t {
+    bin_chunk_t chunks[BIN_CACHE_CHUNKS];
+    uint32_t    tick;
+    uint64_t    file_len;
+    uint64_t    last_tag;
+    int         dir; /* Current read direction: +1 forward, -1 backward. */
+
+    /* Serializes readers: a shared file can be hit from the CPU thread
+       (data) and the sound thread (audio) at the same time. */
+    mutex_t *lock;
+
+    /* Prefetch worker - at most one batch in flight; the reader thread only
+       touches the file or the chunks after bin_cache_drain(). */
+    thread_t  *thread;
+    event_t   *wake;
+    event_t   *idle;
+    atomic_int busy;
+    int        exiting;
+    int        pf_count;                     /* Chunks in the current batch. */
+    int        slot[BIN_CACHE_PF_DEPTH];     /* Chunk slots the worker fills. */
+    uint64_t   pf_tag[BIN_CACHE_PF_DEPTH];   /* Chunks the worker reads. */
+} bin_cache_t;
+
+/* Shared read-only pool for binary track files: drives that mount the same
+   host file get one track_file_t between them - one descriptor, one chunk
+   cache, one prefetch thread - instead of each buffering the image on its
+   own. Entries are refcounted by bin_init()/bin_close() calls; the OS page
+   cache takes care of sharing across processes. */
+typedef struct bin_shared_t {
+    track_file_t        *tf;
+    int                  refs;
+    struct bin_shared_t *next;
+} bin_shared_t;
+
+static bin_shared_t *bin_shared_head  = NULL;
+static mutex_t      *bin_shared_mutex = NULL;
+
 #ifdef ENABLE_CDROM_IMAGE_BACKEND_LOG
 int cdrom_image_backend_do_log = ENABLE_CDROM_IMAGE_BACKEND_LOG;
 
@@ -66,6 +119,298 @@ cdrom_image_backend_log(const char *fmt, ...)
 #    define cdrom_image_backend_log(fmt, ...)
 #endif
 
+/* Shared pool functions. */
+static track_file_t *
+bin_shared_get(const char *filename)
+{
+    track_file_t *tf = NULL;
+
+    /* First bin_init() happens on the config-load path, before any other
+       consumer can race the lazy creation. */
+    if (bin_shared_mutex == NULL)
+        bin_shared_mutex = thread_create_mutex();
+
+    thread_wait_mutex(bin_shared_mutex);
+    for (bin_shared_t *sh = bin_shared_head; sh != NULL; sh = sh->next) {
+        if (!strcmp(sh->tf->fn, filename)) {
+            sh->refs++;
+            tf = sh->tf;
+            break;
+        }
+    }
+    thread_release_mutex(bin_shared_mutex);
+
+    return tf;
+}
+
+static void
+bin_shared_put(track_file_t *tf)
+{
+    bin_shared_t *sh = (bin_shared_t *) calloc(1, sizeof(bin_shared_t));
+
+    /* Without an entry the file simply is not shared. */
+    if (sh == NULL)
+        return;
+
+    sh->tf   = tf;
+    sh->refs = 1;
+
+    thread_wait_mutex(bin_shared_mutex);
+    sh->next        = bin_shared_head;
+    bin_shared_head = sh;
+    thread_release_mutex(bin_shared_mutex);
+}
+
+/* Returns non-zero when the file is still open through another consumer
+   and must not be torn down. */
+static int
+bin_shared_unref(track_file_t *tf)
+{
+    bin_shared_t **prev = &bin_shared_head;
+    int            busy = 0;
+
+    if (bin_shared_mutex == NULL)
+        return 0;
+
+    thread_wait_mutex(bin_shared_mutex);
+    for (bin_shared_t *sh = bin_shared_head; sh != NULL; sh = sh->next) {
+        if (sh->tf == tf) {
+            if (--sh->refs > 0)
+                busy = 1;
+            else {
+                *prev = sh->next;
+                free(sh);
+            }
+            break;
+        }
+        prev = &sh->next;
+    }
+    thread_release_mutex(bin_shared_mutex);
+
+    return busy;
+}
+
+/* Chunk cache functions. */
+static void
+bin_cache_drain(bin_cache_t *bc)
+{
+    if (bc->busy) {
+        thread_wait_event(bc->idle, -1);
+        thread_reset_event(bc->idle);
+    }
+}
+
+/* Read one whole chunk from the file; short chunks at the end of the file
+   are zero-padded. Runs on either the reader or the prefetch thread, never
+   both at once. */
+static int
+bin_cache_fill(track_file_t *tf, bin_chunk_t *ch, uint64_t tag)
+{
+    bin_cache_t *bc       = (bin_cache_t *) tf->priv;
+    uint64_t     start    = tag * BIN_CACHE_CHUNK_SIZE;
+    size_t       expected = BIN_CACHE_CHUNK_SIZE;
+
+    if ((start + expected) > bc->file_len)
+        expected = bc->file_len - start;
+
+    ch->valid = 0;
+    ch->tag   = tag;
+
+    if (fseeko64(tf->fp, start, SEEK_SET) == -1)
+        return 0;
+    if (fread(ch->data, 1, expected, tf->fp) != expected)
+        return 0;
+    if (expected < BIN_CACHE_CHUNK_SIZE)
+        memset(ch->data + expected, 0x00, BIN_CACHE_CHUNK_SIZE - expected);
+
+    ch->valid = 1;
+    return 1;
+}
+
+static void
+bin_cache_thread(void *priv)
+{
+    track_file_t *tf = (track_file_t *) priv;
+    bin_cache_t  *bc = (bin_cache_t *) tf->priv;
+
+    while (1) {
+        thread_wait_event(bc->wake, -1);
+        thread_reset_event(bc->wake);
+
+        if (bc->exiting)
+            break;
+
+        for (int i = 0; i < bc->pf_count; i++)
+            bin_cache_fill(tf, &bc->chunks[bc->slot[i]], bc->pf_tag[i]);
+
+        bc->busy = 0;
+        thread_set_event(bc->idle);
+    }
+}
+
+static bin_chunk_t *
+bin_cache_lookup(bin_cache_t *bc, uint64_t tag)
+{
+    for (int i = 0; i < BIN_CACHE_CHUNKS; i++) {
+        if (bc->chunks[i].valid && (bc->chunks[i].tag == tag))
+            return &bc->chunks[i];
+    }
+
+    return NULL;
+}
+
+/* Pick the replacement chunk, skipping slots already claimed by the batch
+   being assembled (exclude is a slot bitmask). */
+static bin_chunk_t *
+bin_cache_victim(bin_cache_t *bc, uint32_t exclude)
+{
+    bin_chunk_t *best = NULL;
+
+    for (int i = 0; i < BIN_CACHE_CHUNKS; i++) {
+        if (exclude & (1 << i))
+            continue;
+        if (!bc->chunks[i].valid)
+            return &bc->chunks[i];
+        if ((best == NULL) || (bc->chunks[i].lru < best->lru))
+            best = &bc->chunks[i];
+    }
+
+    return best;
+}
+
+static int
+bin_cache_read(track_file_t *tf, uint8_t *buffer, uint64_t seek, size_t count)
+{
+    bin_cache_t *bc = (bin_cache_t *) tf->priv;
+    bin_chunk_t *ch;
+    uint64_t     last;
+    uint64_t     next;
+
+    /* The direct path fails reads past the end of the file, so do the same. */
+    if ((seek + count) > bc->file_len)
+        return 0;
+
+    bin_cache_drain(bc);
+
+    last = seek / BIN_CACHE_CHUNK_SIZE;
+
+    while (count > 0) {
+        uint64_t tag = seek / BIN_CACHE_CHUNK_SIZE;
+        uint32_t off = seek % BIN_CACHE_CHUNK_SIZE;
+        size_t   n   = BIN_CACHE_CHUNK_SIZE - off;
+
+        if (n > count)
+            n = count;
+
+        ch = bin_cache_lookup(bc, tag);
+        if (ch == NULL) {
+            ch = bin_cache_victim(bc, 0);
+            if (!bin_cache_fill(tf, ch, tag))
+                return 0;
+        }
+        ch->lru = ++bc->tick;
+
+        memcpy(buffer, ch->data + off, n);
+
+        buffer += n;
+        seek += n;
+        count -= n;
+        last = tag;
+    }
+
+    /* Track the read direction and speculatively prefetch the next chunks
+       along it in the background, so sequential reads always find their
+       chunk already resident. */
+    if (last == (bc->last_tag + 1))
+        bc->dir = 1;
+    else if ((bc->last_tag > 0) && (last == (bc->last_tag - 1)))
+        bc->dir = -1;
+    bc->last_tag = last;
+
+    uint32_t claimed = 0;
+
+    bc->pf_count = 0;
+    for (int d = 1; d <= BIN_CACHE_PF_DEPTH; d++) {
+        if ((bc->dir < 0) && (last < (uint64_t) d))
+            break;
+        next = last + ((uint64_t) d * bc->dir);
+        if ((next * BIN_CACHE_CHUNK_SIZE) >= bc->file_len)
+            break;
+        if (bin_cache_lookup(bc, next) != NULL)
+            continue;
+
+        ch      = bin_cache_victim(bc, claimed);
+        ch->lru = ++bc->tick;
+        claimed |= 1 << (int) (ch - bc->chunks);
+
+        bc->slot[bc->pf_count]   = (int) (ch - bc->chunks);
+        bc->pf_tag[bc->pf_count] = next;
+        bc->pf_count++;
+    }
+
+    if (bc->pf_count > 0) {
+        bc->busy = 1;
+        thread_reset_event(bc->idle);
+        thread_set_event(bc->wake);
+    }
+
+    return 1;
+}
+
+static void
+bin_cache_close(track_file_t *tf)
+{
+    bin_cache_t *bc = (bin_cache_t *) tf->priv;
+
+    if (bc == NULL)
+        return;
+
+    bin_cache_drain(bc);
+    bc->exiting = 1;
+    thread_set_event(bc->wake);
+    thread_wait(bc->thread);
+    thread_destroy_event(bc->wake);
+    thread_destroy_event(bc->idle);
+    thread_close_mutex(bc->lock);
+
+    for (int i = 0; i < BIN_CACHE_CHUNKS; i++)
+        free(bc->chunks[i].data);
+
+    free(bc);
+    tf->priv = NULL;
+}
+
+static void
+bin_cache_init(track_file_t *tf)
+{
+    bin_cache_t *bc = (bin_cache_t *) calloc(1, sizeof(bin_cache_t));
+
+    if (bc == NULL)
+        return;
+
+    for (int i = 0; i < BIN_CACHE_CHUNKS; i++) {
+        bc->chunks[i].data = (uint8_t *) malloc(BIN_CACHE_CHUNK_SIZE);
+        if (bc->chunks[i].data == NULL) {
+            /* No cache then - bin_read falls back to the direct path. */
+            for (int j = 0; j < i; j++)
+                free(bc->chunks[j].data);
+            free(bc);
+            return;
+        }
+    }
+
+    fseeko64(tf->fp, 0, SEEK_END);
+    bc->file_len = (uint64_t) ftello64(tf->fp);
+    bc->dir      = 1;
+
+    bc->wake = thread_create_event();
+    bc->idle = thread_create_event();
+    bc->lock = thread_create_mutex();
+
+    tf->priv   = bc;
+    bc->thread = thread_create(bin_cache_thread, tf);
+}
+
 /* Binary file functions. */
 static int
 bin_read(void *priv, uint8_t *buffer, uint64_t seek, size_t count)
@@ -78,6 +423,16 @@ bin_read(void *priv, uint8_t *buffer, uint64_t seek, size_t count)
     if (tf->fp == NULL)
         return 0;
 
+    if (tf->priv != NULL) {
+        bin_cache_t *bc = (bin_cache_t *) tf->priv;
+        int          ret;
+
+        thread_wait_mutex(bc->lock);
+        ret = bin_cache_read(tf, buffer, seek, count);
+        thread_release_mutex(bc->lock);
+        return ret;
+    }
+
     if (fseeko64(tf->fp, seek, SEEK_SET) == -1) {
 #ifdef ENABLE_CDROM_IMAGE_BACKEND_LOG
         cdrom_image_backend_log("CDROM: binary_read failed during seek!\n");
@@ -106,6 +461,16 @@ bin_get_length(void *priv)
     if (tf->fp == NULL)
         return 0;
 
+    if (tf->priv != NULL) {
+        bin_cache_t *bc = (bin_cache_t *) tf->priv;
+
+        thread_wait_mutex(bc->lock);
+        bin_cache_drain(bc);
+        len = (off64_t) bc->file_len;
+        thread_release_mutex(bc->lock);
+        return len;
+    }
+
     fseeko64(tf->fp, 0, SEEK_END);
     len = ftello64(tf->fp);
     cdrom_image_backend_log("CDROM: binary_length(%08lx) = %" PRIu64 "\n", tf->fp, len);
@@ -121,6 +486,13 @@ bin_close(void *priv)
     if (tf == NULL)
         return;
 
+    /* Another drive (or a later track) may still be reading through
+       this file. */
+    if (bin_shared_unref(tf))
+        return;
+
+    bin_cache_close(tf);
+
     if (tf->fp != NULL) {
         fclose(tf->fp);
         tf->fp = NULL;
@@ -134,9 +506,18 @@ bin_close(void *priv)
 static track_file_t *
 bin_init(const char *filename, int *error)
 {
-    track_file_t *tf = (track_file_t *) malloc(sizeof(track_file_t));
+    track_file_t *tf;
     struct stat   stats;
 
+    /* Mounting a file that is already open shares the existing descriptor
+       and chunk cache instead of buffering the image again. */
+    tf = bin_shared_get(filename);
+    if (tf != NULL) {
+        *error = 0;
+        return tf;
+    }
+
+    tf = (track_file_t *) malloc(sizeof(track_file_t));
     if (tf == NULL) {
         *error = 1;
         return NULL;
@@ -144,7 +525,8 @@ bin_init(const char *filename, int *error)
 
     memset(tf->fn, 0x00, sizeof(tf->fn));
     strncpy(tf->fn, filename, sizeof(tf->fn) - 1);
-    tf->fp = plat_fopen64(tf->fn, "rb");
+    tf->priv = NULL;
+    tf->fp   = plat_fopen64(tf->fn, "rb");
     cdrom_image_backend_log("CDROM: binary_open(%s) = %08lx\n", tf->fn, tf->fp);
 
     if (stat(tf->fn, &stats) != 0) {
@@ -158,6 +540,11 @@ bin_init(const char *filename, int *error)
         tf->read       = bin_read;
         tf->get_length = bin_get_length;
         tf->close      = bin_close;
+        bin_cache_init(tf);
+        /* Only cached files enter the pool - on the uncached fallback path
+           concurrent consumers would race the bare fseek/fread pair. */
+        if (tf->priv != NULL)
+            bin_shared_put(tf);
     } else {
         /* From the check above, error may still be non-zero if opening a directory.
          * The error is set for viso to try and open the directory following this function.
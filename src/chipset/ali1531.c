@@ -66,6 +66,8 @@ ali1531_log(const char *fmt, ...)
 static void
 ali1531_smram_recalc(uint8_t val, ali1531_t *dev)
 {
+    mem_recalc_begin();
+
     smram_disable_all();
 
     if (val & 1) {
@@ -95,6 +97,7 @@ ali1531_smram_recalc(uint8_t val, ali1531_t *dev)
     }
 
     flushmmucache_nopc();
+    mem_recalc_commit();
 }
 
 static void
@@ -108,6 +111,9 @@ ali1531_shadow_recalc(UNUSED(int cur_reg), ali1531_t *dev)
 
     shadowbios = shadowbios_write = 0;
 
+    /* 16 granules, one recalc. */
+    mem_recalc_begin();
+
     for (uint8_t i = 0; i < 16; i++) {
         base  = 0x000c0000 + (i << 14);
         bit   = i & 7;
@@ -130,6 +136,7 @@ ali1531_shadow_recalc(UNUSED(int cur_reg), ali1531_t *dev)
     }
 
     flushmmucache_nopc();
+    mem_recalc_commit();
 }
 
 static void
@@ -195,6 +202,8 @@ ali1531_write(UNUSED(int func), int addr, uint8_t val, void *priv)
         case 0x47:
             dev->pci_conf[addr] = val & 0xfc;
 
+            mem_recalc_begin();
+
             if (mem_size > 0xe00000)
                 mem_set_mem_state_both(0xe00000, 0x100000, (val & 0x20) ? (MEM_READ_EXTANY | MEM_WRITE_EXTANY) : (MEM_READ_INTERNAL | MEM_WRITE_INTERNAL));
 
@@ -205,6 +214,7 @@ ali1531_write(UNUSED(int func), int addr, uint8_t val, void *priv)
             mem_set_mem_state_both(0x80000, 0x20000, (val & 4) ? (MEM_READ_EXTANY | MEM_WRITE_EXTANY) : (MEM_READ_INTERNAL | MEM_WRITE_INTERNAL));
 
             flushmmucache_nopc();
+            mem_recalc_commit();
             break;
 
         case 0x48: /* SMRAM */
@@ -254,6 +254,10 @@ i4x0_write(int func, int addr, uint8_t val, void *priv)
     if (func > 0)
         return;
 
+    /* PAM and SMRAM writes fan out into several mem state updates; batch
+       them into a single recalc and flush. */
+    mem_recalc_begin();
+
     if (func == 0)
         switch (addr) {
             case 0x04: /*Command register*/
@@ -1241,6 +1245,10 @@ i4x0_write(int func, int addr, uint8_t val, void *priv)
                 }
                 break;
             case 0x93:
+                /* TRC mirror - the 0xcf9 write can kick off a reset, so
+                   close the transaction around it rather than letting the
+                   whole reset sequence run against stale dispatch tables. */
+                mem_recalc_commit();
                 switch (dev->type) {
                     case INTEL_440FX:
                         regs[0x93] = (val & 0x0f);
@@ -1254,6 +1262,7 @@ i4x0_write(int func, int addr, uint8_t val, void *priv)
                     default:
                         break;
                 }
+                mem_recalc_begin();
                 break;
             case 0xa7:
                 switch (dev->type) {
@@ -1507,6 +1516,8 @@ i4x0_write(int func, int addr, uint8_t val, void *priv)
             default:
                 break;
         }
+
+    mem_recalc_commit();
 }
 
 static uint8_t
@@ -1535,6 +1546,9 @@ i4x0_reset(void *priv)
     if ((dev->type == INTEL_440LX) || (dev->type == INTEL_440BX) || (dev->type == INTEL_440ZX))
         memset(dev->regs_locked, 0x00, 256 * sizeof(uint8_t));
 
+    /* One recalc for the whole register sweep. */
+    mem_recalc_begin();
+
     if (dev->type >= INTEL_430FX)
         i4x0_write(0, 0x59, 0x00, priv);
     else
@@ -1566,6 +1580,8 @@ i4x0_reset(void *priv)
         i4x0_write(0, (dev->type >= INTEL_440BX) ? 0x73 : 0x71,
                    (dev->type >= INTEL_440BX) ? 0x38 : 0x00, priv);
     }
+
+    mem_recalc_commit();
 }
 
 static void
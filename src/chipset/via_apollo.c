@@ -243,6 +243,10 @@ via_apollo_host_bridge_write(int func, int addr, uint8_t val, void *priv)
     if (((addr == 0x67) || ((addr >= 0xf0) && (addr < 0xfc))) && (dev->id < VIA_691))
         return;
 
+    /* A single shadow/SMRAM register write fans out into several
+       apollo_map()/apollo_smram_map() calls; batch the recalcs. */
+    mem_recalc_begin();
+
     switch (addr) {
         case 0x04:
             dev->pci_conf[0x04] = (dev->pci_conf[0x04] & ~0x40) | (val & 0x40);
@@ -670,6 +674,8 @@ via_apollo_host_bridge_write(int func, int addr, uint8_t val, void *priv)
             dev->pci_conf[addr] = val;
             break;
     }
+
+    mem_recalc_commit();
 }
 
 static uint8_t
@@ -704,9 +710,11 @@ via_apollo_write(int func, int addr, uint8_t val, void *priv)
 static void
 via_apollo_reset(void *priv)
 {
+    mem_recalc_begin();
     via_apollo_write(0, 0x61, 0x00, priv);
     via_apollo_write(0, 0x62, 0x00, priv);
     via_apollo_write(0, 0x63, 0x00, priv);
+    mem_recalc_commit();
 }
 
 static void *
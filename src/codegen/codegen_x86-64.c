@@ -15,6 +15,7 @@
 #    include "x86seg.h"
 #    include "x87.h"
 #    include <86box/mem.h>
+#    include <86box/perfstats.h>
 #    include <86box/plat_unused.h>
 
 #    include "386_common.h"
@@ -177,6 +178,8 @@ delete_block(codeblock_t *block)
 {
     uint32_t old_pc = block->pc;
 
+    perfc.blocks_deleted++;
+
     if (block == codeblock_hash[HASH(block->phys)])
         codeblock_hash[HASH(block->phys)] = NULL;
 
@@ -54,6 +54,7 @@
 #    include "x87.h"
 /*ex*/
 #    include <86box/nmi.h>
+#    include <86box/perfstats.h>
 #    include <86box/pic.h>
 
 #    include "386_common.h"
@@ -1353,6 +1354,8 @@ delete_block(codeblock_t *block)
 {
     uint32_t old_pc = block->pc;
 
+    perfc.blocks_deleted++;
+
     if (block == codeblock_hash[HASH(block->phys)])
         codeblock_hash[HASH(block->phys)] = NULL;
 
@@ -39,6 +39,11 @@ typedef struct codeblock_t {
     uint8_t  ins;
     uint8_t  TOP;
 
+    /*Number of times this block has been interpreted since creation. When
+      cpu_dynarec_threshold is non-zero, recompilation is held off until this
+      reaches the threshold, so one-shot code is never compiled.*/
+    uint8_t exec_count;
+
     /*Pointers for codeblock tree, used to search for blocks when hash lookup
       fails.*/
     uint16_t parent, left, right;
@@ -57,12 +62,27 @@ typedef struct codeblock_t {
     /*First mem_block_t used by this block. Any subsequent mem_block_ts
       will be in the list starting at head_mem_block->next.*/
     struct mem_block_t *head_mem_block;
+
+    /*Direct block linking. When execution falls through from this block
+      into another compiled block, the successor's block number and entry
+      PC are cached here so that the next dispatch from this block can
+      skip the hash lookup and page tree walk. Two slots cover the taken
+      and not-taken paths of a conditional branch. Links are advisory -
+      the dispatcher re-validates the target block before entering it -
+      and are cleared when the linking block is deleted.*/
+    uint16_t link_nr[2];
+    uint32_t link_pc[2];
 } codeblock_t;
 
 extern codeblock_t *codeblock;
 
 extern uint16_t *codeblock_hash;
 
+/*Block number of the most recently executed compiled block, used by the
+  dispatcher to fill in and follow direct block links. BLOCK_INVALID when the
+  last block executed was interpreted or has been deleted.*/
+extern uint16_t codegen_linked_prev_block;
+
 extern uint8_t *block_write_data;
 
 /*Code block uses FPU*/
@@ -307,6 +327,11 @@ x86seg     *codegen_generate_ea(struct ir_data_t *ir, x86seg *op_ea_seg, uint32_
 extern void codegen_check_seg_read(codeblock_t *block, struct ir_data_t *ir, x86seg *seg);
 extern void codegen_check_seg_write(codeblock_t *block, struct ir_data_t *ir, x86seg *seg);
 
+/*Persistent hot-page profile, used to skip the warm-up threshold for pages
+  that produced compiled blocks in a previous session*/
+extern int  codegen_page_is_hot(uint32_t phys_addr);
+extern void codegen_cache_save(void);
+
 extern int codegen_purge_purgable_list(void);
 /*Delete a random code block to free memory. This is obviously quite expensive, and
   will only be called when the allocator is out of memory*/
@@ -365,7 +390,6 @@ extern int codegen_flags_changed;
 extern int codegen_fpu_entered;
 extern int codegen_mmx_entered;
 
-extern int codegen_fpu_loaded_iq[8];
 extern int codegen_reg_loaded[8];
 
 extern int codegen_in_recompile;
@@ -12,9 +12,11 @@
 #    include "x87.h"
 #    include "386_common.h"
 #    include "codegen.h"
+#    include "codegen_allocator.h"
 #    include "codegen_backend.h"
 #    include "codegen_backend_x86-64_defs.h"
 #    include "codegen_backend_x86-64_ops.h"
+#    include "codegen_backend_x86-64_ops_helpers.h"
 #    include "codegen_backend_x86-64_ops_sse.h"
 #    include "codegen_ir_defs.h"
 
@@ -1003,9 +1005,60 @@ codegen_MEM_LOAD_REG(codeblock_t *block, uop_t *uop)
     } else if (REG_IS_W(dest_size)) {
         host_x86_CALL(block, codegen_mem_load_word);
     } else if (REG_IS_L(dest_size)) {
+        /*Inline the readlookup2 probe for the common aligned dword case,
+          only calling out of line on a lookup miss or misaligned address.
+          This is the same fast path as build_load_routine().*/
+        uint8_t *misaligned_offset;
+        uint8_t *miss_offset;
+        uint8_t *done_offset;
+
+        /*Reserve space for the whole sequence up front so the allocator
+          cannot switch to a new mem block between the short branches and
+          their targets*/
+        codegen_alloc_bytes(block, 80);
+        host_x86_MOV32_REG_REG(block, REG_ECX, REG_ESI);
+        host_x86_SHR32_IMM(block, REG_ESI, 12);
+        host_x86_MOV64_REG_IMM(block, REG_RDI, (uint64_t) (uintptr_t) readlookup2);
+        host_x86_MOV64_REG_BASE_INDEX_SHIFT(block, REG_RSI, REG_RDI, REG_RSI, 3);
+        host_x86_TEST32_REG_IMM(block, REG_ECX, 3);
+        misaligned_offset = host_x86_JNZ_short(block);
+        host_x86_CMP64_REG_IMM(block, REG_RSI, (uint32_t) -1);
+        miss_offset = host_x86_JZ_short(block);
+        host_x86_MOV32_REG_BASE_INDEX(block, REG_ECX, REG_RSI, REG_RCX);
+        host_x86_XOR32_REG_REG(block, REG_ESI, REG_ESI);
+        done_offset = host_x86_JMP_short(block);
+
+        *misaligned_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) misaligned_offset) - 1;
+        *miss_offset       = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) miss_offset) - 1;
+        host_x86_MOV32_REG_REG(block, REG_ESI, REG_ECX);
         host_x86_CALL(block, codegen_mem_load_long);
+
+        *done_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) done_offset) - 1;
     } else if (REG_IS_Q(dest_size)) {
+        /*Same inline probe for the aligned qword case (MMX MOVQ)*/
+        uint8_t *misaligned_offset;
+        uint8_t *miss_offset;
+        uint8_t *done_offset;
+
+        codegen_alloc_bytes(block, 80);
+        host_x86_MOV32_REG_REG(block, REG_ECX, REG_ESI);
+        host_x86_SHR32_IMM(block, REG_ESI, 12);
+        host_x86_MOV64_REG_IMM(block, REG_RDI, (uint64_t) (uintptr_t) readlookup2);
+        host_x86_MOV64_REG_BASE_INDEX_SHIFT(block, REG_RSI, REG_RDI, REG_RSI, 3);
+        host_x86_TEST32_REG_IMM(block, REG_ECX, 7);
+        misaligned_offset = host_x86_JNZ_short(block);
+        host_x86_CMP64_REG_IMM(block, REG_RSI, (uint32_t) -1);
+        miss_offset = host_x86_JZ_short(block);
+        host_x86_MOVQ_XREG_BASE_INDEX(block, REG_XMM_TEMP, REG_RSI, REG_RCX);
+        host_x86_XOR32_REG_REG(block, REG_ESI, REG_ESI);
+        done_offset = host_x86_JMP_short(block);
+
+        *misaligned_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) misaligned_offset) - 1;
+        *miss_offset       = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) miss_offset) - 1;
+        host_x86_MOV32_REG_REG(block, REG_ESI, REG_ECX);
         host_x86_CALL(block, codegen_mem_load_quad);
+
+        *done_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) done_offset) - 1;
     }
 #    ifdef RECOMPILER_DEBUG
     else
@@ -1159,11 +1212,61 @@ codegen_MEM_STORE_REG(codeblock_t *block, uop_t *uop)
         host_x86_MOV16_REG_REG(block, REG_ECX, src_reg);
         host_x86_CALL(block, codegen_mem_store_word);
     } else if (REG_IS_L(src_size)) {
+        /*Inline the writelookup2 probe for the common aligned dword case,
+          only calling out of line on a lookup miss or misaligned address.
+          This is the same fast path as build_store_routine().*/
+        uint8_t *misaligned_offset;
+        uint8_t *miss_offset;
+        uint8_t *done_offset;
+
         host_x86_MOV32_REG_REG(block, REG_ECX, src_reg);
+
+        codegen_alloc_bytes(block, 80);
+        host_x86_MOV32_REG_REG(block, REG_EDI, REG_ESI);
+        host_x86_SHR32_IMM(block, REG_ESI, 12);
+        host_x86_MOV64_REG_IMM(block, REG_R8, (uint64_t) (uintptr_t) writelookup2);
+        host_x86_MOV64_REG_BASE_INDEX_SHIFT(block, REG_RSI, REG_R8, REG_RSI, 3);
+        host_x86_TEST32_REG_IMM(block, REG_EDI, 3);
+        misaligned_offset = host_x86_JNZ_short(block);
+        host_x86_CMP64_REG_IMM(block, REG_RSI, (uint32_t) -1);
+        miss_offset = host_x86_JZ_short(block);
+        host_x86_MOV32_BASE_INDEX_REG(block, REG_RSI, REG_RDI, REG_ECX);
+        host_x86_XOR32_REG_REG(block, REG_ESI, REG_ESI);
+        done_offset = host_x86_JMP_short(block);
+
+        *misaligned_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) misaligned_offset) - 1;
+        *miss_offset       = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) miss_offset) - 1;
+        host_x86_MOV32_REG_REG(block, REG_ESI, REG_EDI);
         host_x86_CALL(block, codegen_mem_store_long);
+
+        *done_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) done_offset) - 1;
     } else if (REG_IS_Q(src_size)) {
+        /*Same inline probe for the aligned qword case (MMX MOVQ)*/
+        uint8_t *misaligned_offset;
+        uint8_t *miss_offset;
+        uint8_t *done_offset;
+
         host_x86_MOVQ_XREG_XREG(block, REG_XMM_TEMP, src_reg);
+
+        codegen_alloc_bytes(block, 80);
+        host_x86_MOV32_REG_REG(block, REG_EDI, REG_ESI);
+        host_x86_SHR32_IMM(block, REG_ESI, 12);
+        host_x86_MOV64_REG_IMM(block, REG_R8, (uint64_t) (uintptr_t) writelookup2);
+        host_x86_MOV64_REG_BASE_INDEX_SHIFT(block, REG_RSI, REG_R8, REG_RSI, 3);
+        host_x86_TEST32_REG_IMM(block, REG_EDI, 7);
+        misaligned_offset = host_x86_JNZ_short(block);
+        host_x86_CMP64_REG_IMM(block, REG_RSI, (uint32_t) -1);
+        miss_offset = host_x86_JZ_short(block);
+        host_x86_MOVQ_BASE_INDEX_XREG(block, REG_RSI, REG_RDI, REG_XMM_TEMP);
+        host_x86_XOR32_REG_REG(block, REG_ESI, REG_ESI);
+        done_offset = host_x86_JMP_short(block);
+
+        *misaligned_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) misaligned_offset) - 1;
+        *miss_offset       = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) miss_offset) - 1;
+        host_x86_MOV32_REG_REG(block, REG_ESI, REG_EDI);
         host_x86_CALL(block, codegen_mem_store_quad);
+
+        *done_offset = (uint8_t) ((uintptr_t) &block_write_data[block_pos] - (uintptr_t) done_offset) - 1;
     }
 #    ifdef RECOMPILER_DEBUG
     else
@@ -1,10 +1,15 @@
 #include <inttypes.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <86box/86box.h>
 #include "cpu.h"
 #include <86box/mem.h>
+#include <86box/perfstats.h>
+#include <86box/timer.h>
+#include <86box/nvr.h>
 #include <86box/plat_unused.h>
 
 #include "x86.h"
@@ -28,16 +33,25 @@ uint8_t *block_write_data = NULL;
 int      codegen_flat_ds;
 int      codegen_flat_ss;
 int      mmx_ebx_ecx_loaded;
+/*Set when an instruction in the block being compiled has updated the lazy
+  flags state, letting branch codegen specialise on the known flags_op. Note
+  that the flags_op/flags_res/flags_op1/flags_op2 slots in cpu_state must be
+  kept current at every barrier and block exit even when no code in the block
+  reads them: any memory uOP can fault into the exception path, and any exit
+  can fall back to the dispatcher or interpreter, all of which share the lazy
+  flags contract. Cross-block dead flag store elimination is therefore not
+  possible without also proving the fault paths dead.*/
 int      codegen_flags_changed = 0;
 int      codegen_fpu_entered   = 0;
 int      codegen_mmx_entered   = 0;
-int      codegen_fpu_loaded_iq[8];
 x86seg  *op_ea_seg;
 int      op_ssegs;
 uint32_t op_old_pc;
 
 uint32_t recomp_page = -1;
 
+uint16_t codegen_linked_prev_block = BLOCK_INVALID;
+
 int        block_current = 0;
 static int block_num;
 int        block_pos;
@@ -60,6 +74,73 @@ static uint16_t block_free_list;
 static void     delete_block(codeblock_t *block);
 static void     delete_dirty_block(codeblock_t *block);
 
+/*Persistent hot-page profile. Compiled code itself cannot be reused across
+  sessions, as generated blocks embed absolute host addresses, but the set of
+  physical pages that produced compiled blocks is stable for a given guest
+  image. It is saved per VM alongside the NVR data so that, when a warm-up
+  threshold is configured, a warm start can skip the interpretation warm-up
+  for pages that were hot last session.*/
+#define HOT_PAGES_FN      "hotpages.bin"
+#define HOT_PAGES_MAGIC   0x43423638
+#define HOT_PAGES_VERSION 1
+#define HOT_PAGES_NR      (1 << 20)
+
+static uint8_t *codegen_hot_pages = NULL;
+
+int
+codegen_page_is_hot(uint32_t phys_addr)
+{
+    uint32_t page = (phys_addr >> 12) & (HOT_PAGES_NR - 1);
+
+    if (!codegen_hot_pages)
+        return 0;
+    return codegen_hot_pages[page >> 3] & (1 << (page & 7));
+}
+
+static void
+codegen_mark_page_hot(uint32_t phys_addr)
+{
+    uint32_t page = (phys_addr >> 12) & (HOT_PAGES_NR - 1);
+
+    if (codegen_hot_pages)
+        codegen_hot_pages[page >> 3] |= 1 << (page & 7);
+}
+
+static void
+codegen_cache_load(void)
+{
+    FILE    *fp = fopen(nvr_path(HOT_PAGES_FN), "rb");
+    uint32_t header[2];
+    uint32_t page;
+
+    if (!fp)
+        return;
+    if ((fread(header, sizeof(header), 1, fp) == 1) && (header[0] == HOT_PAGES_MAGIC) && (header[1] == HOT_PAGES_VERSION)) {
+        while (fread(&page, sizeof(page), 1, fp) == 1)
+            codegen_mark_page_hot(page << 12);
+    }
+    fclose(fp);
+}
+
+void
+codegen_cache_save(void)
+{
+    FILE    *fp;
+    uint32_t header[2] = { HOT_PAGES_MAGIC, HOT_PAGES_VERSION };
+
+    if (!codegen_hot_pages)
+        return;
+    fp = fopen(nvr_path(HOT_PAGES_FN), "wb");
+    if (!fp)
+        return;
+    fwrite(header, sizeof(header), 1, fp);
+    for (uint32_t page = 0; page < HOT_PAGES_NR; page++) {
+        if (codegen_hot_pages[page >> 3] & (1 << (page & 7)))
+            fwrite(&page, sizeof(page), 1, fp);
+    }
+    fclose(fp);
+}
+
 /*Temporary list of code blocks that have recently been evicted. This allows for
   some historical state to be kept when a block is the target of self-modifying
   code.
@@ -224,6 +305,11 @@ codegen_init(void)
         block_free_list_add(&codeblock[c]);
     block_dirty_list_head = block_dirty_list_tail = 0;
     dirty_list_size                               = 0;
+
+    if (!codegen_hot_pages) {
+        codegen_hot_pages = calloc(HOT_PAGES_NR / 8, 1);
+        codegen_cache_load();
+    }
 #ifdef DEBUG_EXTRA
     memset(instr_counts, 0, sizeof(instr_counts));
 #endif
@@ -246,6 +332,7 @@ codegen_reset(void)
 
     memset(codeblock, 0, BLOCK_SIZE * sizeof(codeblock_t));
     memset(codeblock_hash, 0, HASH_SIZE * sizeof(uint16_t));
+    codegen_linked_prev_block = BLOCK_INVALID;
     mem_reset_page_blocks();
 
     block_free_list = 0;
@@ -382,6 +469,15 @@ invalidate_block(codeblock_t *block)
     block->head_mem_block = NULL;
 }
 
+static void
+block_clear_links(codeblock_t *block)
+{
+    block->link_nr[0] = block->link_nr[1] = BLOCK_INVALID;
+    block->link_pc[0] = block->link_pc[1] = BLOCK_PC_INVALID;
+    if (codegen_linked_prev_block == get_block_nr(block))
+        codegen_linked_prev_block = BLOCK_INVALID;
+}
+
 static void
 delete_block(codeblock_t *block)
 {
@@ -395,6 +491,7 @@ delete_block(codeblock_t *block)
         fatal("Deleting deleted block\n");
 #endif
     block->pc = BLOCK_PC_INVALID;
+    block_clear_links(block);
 
     codeblock_tree_delete(block);
     if (block->flags & CODEBLOCK_IN_DIRTY_LIST)
@@ -418,6 +515,7 @@ delete_dirty_block(codeblock_t *block)
         fatal("Deleting deleted block\n");
 #endif
     block->pc = BLOCK_PC_INVALID;
+    block_clear_links(block);
 
     codeblock_tree_delete(block);
     block_free_list_add(block);
@@ -426,8 +524,10 @@ delete_dirty_block(codeblock_t *block)
 void
 codegen_delete_block(codeblock_t *block)
 {
-    if (block->pc != BLOCK_PC_INVALID)
+    if (block->pc != BLOCK_PC_INVALID) {
+        perfc.blocks_deleted++;
         delete_block(block);
+    }
 }
 
 void
@@ -518,6 +618,7 @@ codegen_block_init(uint32_t phys_addr)
     codeblock_hash[block_num] = block_current;
 
     block->ins         = 0;
+    block->exec_count  = 0;
     block->pc          = cs + cpu_state.pc;
     block->_cs         = cs;
     block->phys        = phys_addr;
@@ -583,8 +684,6 @@ codegen_block_start_recompile(codeblock_t *block)
     codegen_fpu_entered   = 0;
     codegen_mmx_entered   = 0;
 
-    codegen_fpu_loaded_iq[0] = codegen_fpu_loaded_iq[1] = codegen_fpu_loaded_iq[2] = codegen_fpu_loaded_iq[3] = codegen_fpu_loaded_iq[4] = codegen_fpu_loaded_iq[5] = codegen_fpu_loaded_iq[6] = codegen_fpu_loaded_iq[7] = 0;
-
     cpu_state.seg_ds.checked = cpu_state.seg_es.checked = cpu_state.seg_fs.checked = cpu_state.seg_gs.checked = (cr0 & 1) ? 0 : 1;
 
     block->TOP = cpu_state.TOP & 7;
@@ -769,6 +868,7 @@ codegen_block_end_recompile(codeblock_t *block)
     block->next_2 = block->prev_2 = BLOCK_INVALID;
     codegen_block_generate_end_mask_recompile();
     add_to_block_list(block);
+    codegen_mark_page_hot(block->phys);
 
     if (!(block->flags & CODEBLOCK_HAS_FPU))
         block->flags &= ~CODEBLOCK_STATIC_TOP;
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include <86box/86box.h>
 #include "cpu.h"
 #include <86box/mem.h>
@@ -58,6 +59,433 @@ duplicate_uop(ir_data_t *ir, uop_t *uop, int offset)
     }
 }
 
+/*Constant values known for each (register, version) at the current point of
+  the folding pass. const_set_list remembers which entries are live so that
+  forgetting everything at a jump destination or barrier stays cheap.*/
+static uint32_t uop_const_val[IREG_COUNT][256];
+static uint8_t  uop_const_known[IREG_COUNT][256];
+static uint16_t const_set_list[UOP_NR_MAX];
+static int      const_set_nr;
+static uint8_t  uop_is_jump_dest[UOP_NR_MAX];
+
+/*Affine address expressions: a (register, version) may be known to equal an
+  anchor (register, version) plus a constant. push/pop and stack spill
+  sequences derive successive stack addresses from the same ESP version this
+  way, which lets the store-to-load forwarding below prove two addresses
+  equal without knowing their values.*/
+static uint16_t uop_affine_anchor[IREG_COUNT][256];
+static uint32_t uop_affine_off[IREG_COUNT][256];
+static uint8_t  uop_affine_known[IREG_COUNT][256];
+static uint16_t affine_set_list[UOP_NR_MAX];
+static int      affine_set_nr;
+
+/*Most recent store still eligible for store-to-load forwarding. Only
+  SS-relative accesses are tracked: the stack is not expected to point at
+  device memory, while a store/load round trip through a data segment can
+  legitimately hit MMIO where eliding the load would be observable (eg
+  memory size probes against a video RAM window).*/
+static struct {
+    int      valid;
+    ir_reg_t seg_reg;
+    uint16_t addr_anchor;
+    uint32_t addr_off;
+    int      is_imm;
+    ir_reg_t data_reg;
+    uint32_t data_imm;
+    int      size;
+} last_store;
+
+static void
+const_forget_all(void)
+{
+    while (const_set_nr) {
+        uint16_t entry = const_set_list[--const_set_nr];
+
+        uop_const_known[entry >> 8][entry & 0xff] = 0;
+    }
+}
+
+/*Only full-size views of natively 32-bit registers are tracked; partial
+  writes merge with the parent register and are not worth the complication.*/
+static int
+const_reg_ok(ir_reg_t ir_reg)
+{
+    return (IREG_GET_SIZE(ir_reg.reg) == IREG_SIZE_L) && reg_is_native_size(ir_reg);
+}
+
+static void
+const_record(ir_reg_t ir_reg, uint32_t val)
+{
+    int reg     = IREG_GET_REG(ir_reg.reg);
+    int version = ir_reg.version;
+
+    if (!uop_const_known[reg][version]) {
+        uop_const_known[reg][version] = 1;
+        const_set_list[const_set_nr++] = (reg << 8) | version;
+    }
+    uop_const_val[reg][version] = val;
+}
+
+static int
+const_lookup(ir_reg_t ir_reg, uint32_t *val)
+{
+    int reg = IREG_GET_REG(ir_reg.reg);
+
+    if (!const_reg_ok(ir_reg) || !uop_const_known[reg][ir_reg.version])
+        return 0;
+    *val = uop_const_val[reg][ir_reg.version];
+    return 1;
+}
+
+static void
+affine_forget_all(void)
+{
+    while (affine_set_nr) {
+        uint16_t entry = affine_set_list[--affine_set_nr];
+
+        uop_affine_known[entry >> 8][entry & 0xff] = 0;
+    }
+    last_store.valid = 0;
+}
+
+static void
+affine_record(ir_reg_t dst, ir_reg_t src, uint32_t off)
+{
+    int      reg     = IREG_GET_REG(dst.reg);
+    int      version = dst.version;
+    int      src_reg = IREG_GET_REG(src.reg);
+    uint16_t anchor  = (src_reg << 8) | src.version;
+
+    if (!const_reg_ok(dst) || !const_reg_ok(src))
+        return;
+    /*Collapse chains so every expression is anchored on a plain version.*/
+    if (uop_affine_known[src_reg][src.version]) {
+        anchor = uop_affine_anchor[src_reg][src.version];
+        off += uop_affine_off[src_reg][src.version];
+    }
+    if (!uop_affine_known[reg][version]) {
+        uop_affine_known[reg][version]   = 1;
+        affine_set_list[affine_set_nr++] = (reg << 8) | version;
+    }
+    uop_affine_anchor[reg][version] = anchor;
+    uop_affine_off[reg][version]    = off;
+}
+
+static void
+affine_resolve(ir_reg_t ir_reg, uint16_t *anchor, uint32_t *off)
+{
+    int reg = IREG_GET_REG(ir_reg.reg);
+
+    if (uop_affine_known[reg][ir_reg.version]) {
+        *anchor = uop_affine_anchor[reg][ir_reg.version];
+        *off    = uop_affine_off[reg][ir_reg.version];
+    } else {
+        *anchor = (reg << 8) | ir_reg.version;
+        *off    = 0;
+    }
+}
+
+/*Remove one read reference from a register version; mirrors the dead-list
+  conditions of codegen_reg_write(). Versions still holding the current value
+  of their register must survive to the end of the block.*/
+static void
+codegen_ir_drop_ref(ir_reg_t ir_reg)
+{
+    int            reg  = IREG_GET_REG(ir_reg.reg);
+    reg_version_t *regv = &reg_version[reg][ir_reg.version];
+
+    regv->refcount--;
+    if (!regv->refcount && (reg > IREG_EBX) && ir_reg.version && (ir_reg.version != reg_last_version[reg]) && !(regv->flags & REG_FLAGS_REQUIRED) && reg_is_native_size(ir_reg))
+        add_to_dead_list(regv, reg, ir_reg.version);
+}
+
+/*Forward constant folding over the uOP list. Immediates introduced by
+  uop_MOV_IMM are propagated through moves and ALU uOPs, and constant address
+  components are folded into the displacement of memory uOPs. uOPs whose
+  result becomes unreferenced are then swept up by the existing dead register
+  list processing. Folding is only valid along straight-line code, so all
+  known values are forgotten at jump destinations; barrier uOPs can modify
+  guest registers behind the register allocator's back and forget them too.
+
+  The same walk performs store-to-load forwarding: a load whose segment and
+  address expression provably match the preceding stack store is rewritten
+  into a register move (or immediate load) of the stored value, which turns
+  push/pop idioms and stack spill round trips into plain moves. Any other
+  store, barrier or jump destination invalidates the tracked store.*/
+static void
+codegen_ir_optimize(ir_data_t *ir)
+{
+    int c;
+
+    memset(uop_is_jump_dest, 0, ir->wr_pos);
+    for (c = 0; c < ir->wr_pos; c++) {
+        const uop_t *uop = &ir->uops[c];
+
+        if ((uop->type & UOP_TYPE_JUMP) && (uop->jump_dest_uop >= 0) && (uop->jump_dest_uop < ir->wr_pos))
+            uop_is_jump_dest[uop->jump_dest_uop] = 1;
+    }
+
+    for (c = 0; c < ir->wr_pos; c++) {
+        uop_t   *uop = &ir->uops[c];
+        uint32_t val_a;
+        uint32_t val_b;
+
+        if (uop_is_jump_dest[c] || (uop->type & UOP_TYPE_BARRIER)) {
+            const_forget_all();
+            affine_forget_all();
+        }
+
+        switch (uop->type) {
+            case UOP_MOV_IMM:
+                if (const_reg_ok(uop->dest_reg_a))
+                    const_record(uop->dest_reg_a, uop->imm_data);
+                break;
+
+            case UOP_MOV:
+                if (const_reg_ok(uop->dest_reg_a) && const_lookup(uop->src_reg_a, &val_a)) {
+                    codegen_ir_drop_ref(uop->src_reg_a);
+                    uop->src_reg_a = invalid_ir_reg;
+                    uop->type      = UOP_MOV_IMM;
+                    uop->imm_data  = val_a;
+                    const_record(uop->dest_reg_a, val_a);
+                } else
+                    affine_record(uop->dest_reg_a, uop->src_reg_a, 0);
+                break;
+
+            case UOP_ADD:
+            case UOP_SUB:
+            case UOP_AND:
+            case UOP_OR:
+            case UOP_XOR:
+                {
+                    int known_a = const_lookup(uop->src_reg_a, &val_a);
+                    int known_b = const_lookup(uop->src_reg_b, &val_b);
+
+                    if (!const_reg_ok(uop->dest_reg_a) || (!known_a && !known_b))
+                        break;
+                    if (known_a && known_b) {
+                        uint32_t result = 0;
+
+                        switch (uop->type) {
+                            case UOP_ADD:
+                                result = val_a + val_b;
+                                break;
+                            case UOP_SUB:
+                                result = val_a - val_b;
+                                break;
+                            case UOP_AND:
+                                result = val_a & val_b;
+                                break;
+                            case UOP_OR:
+                                result = val_a | val_b;
+                                break;
+                            case UOP_XOR:
+                                result = val_a ^ val_b;
+                                break;
+                        }
+                        codegen_ir_drop_ref(uop->src_reg_a);
+                        codegen_ir_drop_ref(uop->src_reg_b);
+                        uop->src_reg_a = invalid_ir_reg;
+                        uop->src_reg_b = invalid_ir_reg;
+                        uop->imm_data  = result;
+                        uop->type      = UOP_MOV_IMM;
+                        const_record(uop->dest_reg_a, result);
+                        break;
+                    }
+                    if (known_a && (uop->type == UOP_SUB))
+                        break; /*SUB is not commutative*/
+                    if (known_a) {
+                        codegen_ir_drop_ref(uop->src_reg_a);
+                        uop->src_reg_a = uop->src_reg_b;
+                        val_b          = val_a;
+                    } else
+                        codegen_ir_drop_ref(uop->src_reg_b);
+                    uop->src_reg_b = invalid_ir_reg;
+                    uop->imm_data  = val_b;
+                    switch (uop->type) {
+                        case UOP_ADD:
+                            uop->type = UOP_ADD_IMM;
+                            break;
+                        case UOP_SUB:
+                            uop->type = UOP_SUB_IMM;
+                            break;
+                        case UOP_AND:
+                            uop->type = UOP_AND_IMM;
+                            break;
+                        case UOP_OR:
+                            uop->type = UOP_OR_IMM;
+                            break;
+                        case UOP_XOR:
+                            uop->type = UOP_XOR_IMM;
+                            break;
+                    }
+                }
+                if ((uop->type == UOP_ADD_IMM) || (uop->type == UOP_SUB_IMM))
+                    affine_record(uop->dest_reg_a, uop->src_reg_a, (uop->type == UOP_ADD_IMM) ? uop->imm_data : 0 - uop->imm_data);
+                break;
+
+            case UOP_ADD_IMM:
+            case UOP_SUB_IMM:
+            case UOP_AND_IMM:
+            case UOP_OR_IMM:
+            case UOP_XOR_IMM:
+            case UOP_SHL_IMM:
+            case UOP_SHR_IMM:
+            case UOP_SAR_IMM:
+                if (const_reg_ok(uop->dest_reg_a) && const_lookup(uop->src_reg_a, &val_a)) {
+                    uint32_t result = 0;
+
+                    if (((uop->type == UOP_SHL_IMM) || (uop->type == UOP_SHR_IMM) || (uop->type == UOP_SAR_IMM)) && (uop->imm_data >= 32))
+                        break;
+                    switch (uop->type) {
+                        case UOP_ADD_IMM:
+                            result = val_a + uop->imm_data;
+                            break;
+                        case UOP_SUB_IMM:
+                            result = val_a - uop->imm_data;
+                            break;
+                        case UOP_AND_IMM:
+                            result = val_a & uop->imm_data;
+                            break;
+                        case UOP_OR_IMM:
+                            result = val_a | uop->imm_data;
+                            break;
+                        case UOP_XOR_IMM:
+                            result = val_a ^ uop->imm_data;
+                            break;
+                        case UOP_SHL_IMM:
+                            result = val_a << uop->imm_data;
+                            break;
+                        case UOP_SHR_IMM:
+                            result = val_a >> uop->imm_data;
+                            break;
+                        case UOP_SAR_IMM:
+                            result = (uint32_t) ((int32_t) val_a >> uop->imm_data);
+                            break;
+                    }
+                    codegen_ir_drop_ref(uop->src_reg_a);
+                    uop->src_reg_a = invalid_ir_reg;
+                    uop->imm_data  = result;
+                    uop->type      = UOP_MOV_IMM;
+                    const_record(uop->dest_reg_a, result);
+                }
+                if ((uop->type == UOP_ADD_IMM) || (uop->type == UOP_SUB_IMM))
+                    affine_record(uop->dest_reg_a, uop->src_reg_a, (uop->type == UOP_ADD_IMM) ? uop->imm_data : 0 - uop->imm_data);
+                break;
+
+            case UOP_ADD_LSHIFT:
+                if (const_reg_ok(uop->dest_reg_a) && const_lookup(uop->src_reg_b, &val_b)) {
+                    codegen_ir_drop_ref(uop->src_reg_b);
+                    uop->src_reg_b = invalid_ir_reg;
+                    uop->imm_data  = val_b << uop->imm_data;
+                    uop->type      = UOP_ADD_IMM;
+                    if (const_lookup(uop->src_reg_a, &val_a)) {
+                        codegen_ir_drop_ref(uop->src_reg_a);
+                        uop->src_reg_a = invalid_ir_reg;
+                        uop->imm_data += val_a;
+                        uop->type      = UOP_MOV_IMM;
+                        const_record(uop->dest_reg_a, uop->imm_data);
+                    }
+                }
+                break;
+
+            case UOP_MEM_LOAD_REG:
+                if (last_store.valid && (uop->src_reg_a.reg == last_store.seg_reg.reg) && (uop->src_reg_a.version == last_store.seg_reg.version)) {
+                    uint16_t anchor;
+                    uint32_t off;
+
+                    affine_resolve(uop->src_reg_b, &anchor, &off);
+                    off += uop->imm_data;
+                    if ((anchor == last_store.addr_anchor) && (off == last_store.addr_off) && (IREG_GET_SIZE(uop->dest_reg_a.reg) == last_store.size)
+                        && (last_store.is_imm || (reg_version[IREG_GET_REG(last_store.data_reg.reg)][last_store.data_reg.version].refcount < REG_REFCOUNT_MAX))) {
+                        /*The load provably reads back what the tracked store
+                          just wrote, and the store cannot have faulted without
+                          ending the block, so the value is forwarded directly.*/
+                        codegen_ir_drop_ref(uop->src_reg_a);
+                        codegen_ir_drop_ref(uop->src_reg_b);
+                        uop->src_reg_b = invalid_ir_reg;
+                        if (last_store.is_imm) {
+                            uop->src_reg_a = invalid_ir_reg;
+                            uop->imm_data  = last_store.data_imm;
+                            uop->type      = UOP_MOV_IMM;
+                            if (const_reg_ok(uop->dest_reg_a))
+                                const_record(uop->dest_reg_a, uop->imm_data);
+                        } else if (const_reg_ok(uop->dest_reg_a) && const_lookup(last_store.data_reg, &val_a)) {
+                            uop->src_reg_a = invalid_ir_reg;
+                            uop->imm_data  = val_a;
+                            uop->type      = UOP_MOV_IMM;
+                            const_record(uop->dest_reg_a, val_a);
+                        } else {
+                            reg_version[IREG_GET_REG(last_store.data_reg.reg)][last_store.data_reg.version].refcount++;
+                            uop->src_reg_a = last_store.data_reg;
+                            uop->imm_data  = 0;
+                            uop->type      = UOP_MOV;
+                        }
+                        break;
+                    }
+                }
+                if (const_lookup(uop->src_reg_b, &val_b)) {
+                    codegen_ir_drop_ref(uop->src_reg_b);
+                    uop->src_reg_b = invalid_ir_reg;
+                    uop->imm_data += val_b;
+                    uop->type      = UOP_MEM_LOAD_ABS;
+                }
+                break;
+
+            case UOP_MEM_STORE_REG:
+                if (const_lookup(uop->src_reg_b, &val_b)) {
+                    codegen_ir_drop_ref(uop->src_reg_b);
+                    uop->src_reg_b = uop->src_reg_c;
+                    uop->src_reg_c = invalid_ir_reg;
+                    uop->imm_data += val_b;
+                    uop->type      = UOP_MEM_STORE_ABS;
+                    last_store.valid = 0;
+                } else if ((uop->src_reg_a.reg == IREG_SS_base) && ((IREG_GET_SIZE(uop->src_reg_c.reg) == IREG_SIZE_L) || (IREG_GET_SIZE(uop->src_reg_c.reg) == IREG_SIZE_W) || (IREG_GET_SIZE(uop->src_reg_c.reg) == IREG_SIZE_B))) {
+                    last_store.valid   = 1;
+                    last_store.seg_reg = uop->src_reg_a;
+                    affine_resolve(uop->src_reg_b, &last_store.addr_anchor, &last_store.addr_off);
+                    last_store.addr_off += uop->imm_data;
+                    last_store.is_imm   = 0;
+                    last_store.data_reg = uop->src_reg_c;
+                    last_store.size     = IREG_GET_SIZE(uop->src_reg_c.reg);
+                } else
+                    last_store.valid = 0;
+                break;
+
+            case UOP_MEM_STORE_IMM_8:
+            case UOP_MEM_STORE_IMM_16:
+            case UOP_MEM_STORE_IMM_32:
+                if (uop->src_reg_a.reg == IREG_SS_base) {
+                    last_store.valid   = 1;
+                    last_store.seg_reg = uop->src_reg_a;
+                    affine_resolve(uop->src_reg_b, &last_store.addr_anchor, &last_store.addr_off);
+                    last_store.is_imm   = 1;
+                    last_store.data_imm = uop->imm_data;
+                    if (uop->type == UOP_MEM_STORE_IMM_8)
+                        last_store.size = IREG_SIZE_B;
+                    else if (uop->type == UOP_MEM_STORE_IMM_16)
+                        last_store.size = IREG_SIZE_W;
+                    else
+                        last_store.size = IREG_SIZE_L;
+                } else
+                    last_store.valid = 0;
+                break;
+
+            case UOP_MEM_STORE_ABS:
+            case UOP_MEM_STORE_SINGLE:
+            case UOP_MEM_STORE_DOUBLE:
+                last_store.valid = 0;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    const_forget_all();
+    affine_forget_all();
+}
+
 void
 codegen_ir_compile(ir_data_t *ir, codeblock_t *block)
 {
@@ -80,6 +508,7 @@ codegen_ir_compile(ir_data_t *ir, codeblock_t *block)
         }
     }
 
+    codegen_ir_optimize(ir);
     codegen_reg_mark_as_required();
     codegen_reg_process_dead_list(ir);
     block_write_data = codeblock_allocator_get_ptr(block->head_mem_block);
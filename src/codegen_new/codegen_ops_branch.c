@@ -696,6 +696,30 @@ ropJLE_common(codeblock_t *block, ir_data_t *ir, uint32_t dest_addr, uint32_t ne
     int do_unroll = (((NF_SET() ? 1 : 0) != (VF_SET() ? 1 : 0) || ZF_SET()) && codegen_can_unroll(block, ir, next_pc, dest_addr));
 
     switch (codegen_flags_changed ? cpu_state.flags_op : FLAGS_UNKNOWN) {
+        case FLAGS_ZN8:
+            /*C and V flags are always clear. Condition is true if the result
+              is zero or negative, ie signed <= 0*/
+            uop_MOV_IMM(ir, IREG_temp0_B, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res_B, IREG_temp0_B);
+            else
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res_B, IREG_temp0_B);
+            break;
+        case FLAGS_ZN16:
+            uop_MOV_IMM(ir, IREG_temp0_W, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res_W, IREG_temp0_W);
+            else
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res_W, IREG_temp0_W);
+            break;
+        case FLAGS_ZN32:
+            uop_MOV_IMM(ir, IREG_temp0, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res, IREG_temp0);
+            else
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res, IREG_temp0);
+            break;
+
         case FLAGS_SUB8:
         case FLAGS_DEC8:
             if (do_unroll)
@@ -759,6 +783,30 @@ ropJNLE_common(codeblock_t *block, ir_data_t *ir, uint32_t dest_addr, uint32_t n
     int do_unroll = ((NF_SET() ? 1 : 0) == (VF_SET() ? 1 : 0) && !ZF_SET() && codegen_can_unroll(block, ir, next_pc, dest_addr));
 
     switch (codegen_flags_changed ? cpu_state.flags_op : FLAGS_UNKNOWN) {
+        case FLAGS_ZN8:
+            /*C and V flags are always clear. Condition is true if the result
+              is positive and non-zero, ie signed > 0*/
+            uop_MOV_IMM(ir, IREG_temp0_B, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res_B, IREG_temp0_B);
+            else
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res_B, IREG_temp0_B);
+            break;
+        case FLAGS_ZN16:
+            uop_MOV_IMM(ir, IREG_temp0_W, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res_W, IREG_temp0_W);
+            else
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res_W, IREG_temp0_W);
+            break;
+        case FLAGS_ZN32:
+            uop_MOV_IMM(ir, IREG_temp0, 0);
+            if (do_unroll)
+                jump_uop = uop_CMP_JNLE_DEST(ir, IREG_flags_res, IREG_temp0);
+            else
+                jump_uop = uop_CMP_JLE_DEST(ir, IREG_flags_res, IREG_temp0);
+            break;
+
         case FLAGS_SUB8:
         case FLAGS_DEC8:
             if (do_unroll)
@@ -2,6 +2,7 @@
 #include <86box/86box.h>
 #include "cpu.h"
 #include <86box/mem.h>
+#include <86box/perfstats.h>
 #include <86box/plat_unused.h>
 
 #include "x86.h"
@@ -38,6 +39,14 @@ LOAD_IMMEDIATE_FROM_RAM_32_unaligned(UNUSED(codeblock_t *block), ir_data_t *ir,
 #define UNROLL_MAX_REG_REFERENCES 200
 #define UNROLL_MAX_UOPS           1000
 #define UNROLL_MAX_COUNT          10
+/*Loop-specialised compilation: when a conditional branch targets an earlier
+  instruction of the same block, the loop body is duplicated up to
+  UNROLL_MAX_COUNT times with the branch test between copies. Loop-carried
+  guest registers stay pinned in host registers across the copies (only
+  ORDER_BARRIER flushes write them back, without invalidating), and
+  codegen_set_loop_start() re-materialises the per-iteration decode state.
+  The TLB probes of memory uOPs deliberately stay inside the body: they are
+  what catches self-modifying fills and MMIO targets mid-loop.*/
 int
 codegen_can_unroll_full(codeblock_t *block, ir_data_t *ir, UNUSED(uint32_t next_pc), uint32_t dest_addr)
 {
@@ -72,6 +81,7 @@ codegen_can_unroll_full(codeblock_t *block, ir_data_t *ir, UNUSED(uint32_t next_
         return 0;
 
     codegen_ir_set_unroll(max_unroll, start, first_instruction);
+    perfc.blocks_unrolled++;
 
     return 1;
 }
@@ -1,3 +1,4 @@
+#include <limits.h>
 #include <stdint.h>
 #include <86box/86box.h>
 #include "cpu.h"
@@ -528,6 +529,41 @@ codegen_reg_write_imm(codeblock_t *block, ir_reg_t ir_reg, uint32_t imm_data)
 }
 #endif
 
+/*Choose a host register to evict when the set is full. Entries holding an
+  invalid register are free, and registers whose current version has no
+  readers left are nearly so (clean before dirty, as dirty ones must be
+  written back first). Failing those, evict the register with the fewest
+  remaining reads; this keeps guest registers that are referenced many more
+  times in the block (eg the pointers and counter of a string loop) resident
+  in host registers instead of bouncing them through cpu_state.*/
+static int
+codegen_reg_choose_victim(host_reg_set_t *reg_set)
+{
+    int best      = -1;
+    int best_cost = INT_MAX;
+
+    for (int c = 0; c < reg_set->nr_regs; c++) {
+        int cost;
+
+        if (reg_set->locked & (1 << c))
+            continue;
+
+        if (ir_reg_is_invalid(reg_set->regs[c]))
+            return c;
+
+        cost = ir_get_refcount(reg_set->regs[c]) * 2;
+        if (reg_set->dirty[c])
+            cost++;
+
+        if (cost < best_cost) {
+            best      = c;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
 static void
 alloc_reg(ir_reg_t ir_reg)
 {
@@ -626,22 +662,12 @@ codegen_reg_alloc_read_reg(codeblock_t *block, ir_reg_t ir_reg, int *host_reg_id
     }
 
     if (c == reg_set->nr_regs) {
-        /*No unused registers. Search for an unlocked register with no pending reads*/
-        for (c = 0; c < reg_set->nr_regs; c++) {
-            if (!(reg_set->locked & (1 << c)) && IREG_GET_REG(reg_set->regs[c].reg) != IREG_INVALID && !ir_get_refcount(reg_set->regs[c]))
-                break;
-        }
-        if (c == reg_set->nr_regs) {
-            /*Search for any unlocked register*/
-            for (c = 0; c < reg_set->nr_regs; c++) {
-                if (!(reg_set->locked & (1 << c)))
-                    break;
-            }
+        /*Not present - evict the cheapest unlocked register*/
+        c = codegen_reg_choose_victim(reg_set);
 #ifndef RELEASE_BUILD
-            if (c == reg_set->nr_regs)
-                fatal("codegen_reg_alloc_read_reg - out of registers\n");
+        if (c < 0)
+            fatal("codegen_reg_alloc_read_reg - out of registers\n");
 #endif
-        }
         if (reg_set->dirty[c])
             codegen_reg_writeback(reg_set, block, c, 1);
         codegen_reg_load(reg_set, block, c, ir_reg);
@@ -703,25 +729,14 @@ codegen_reg_alloc_write_reg(codeblock_t *block, ir_reg_t ir_reg)
     }
 
     if (c == reg_set->nr_regs) {
-        /*Search for unused registers*/
-        for (c = 0; c < reg_set->nr_regs; c++) {
-            if (ir_reg_is_invalid(reg_set->regs[c]))
-                break;
-        }
-
-        if (c == reg_set->nr_regs) {
-            /*No unused registers. Search for an unlocked register*/
-            for (c = 0; c < reg_set->nr_regs; c++) {
-                if (!(reg_set->locked & (1 << c)))
-                    break;
-            }
+        /*Not present - evict the cheapest unlocked register*/
+        c = codegen_reg_choose_victim(reg_set);
 #ifndef RELEASE_BUILD
-            if (c == reg_set->nr_regs)
-                fatal("codegen_reg_alloc_write_reg - out of registers\n");
+        if (c < 0)
+            fatal("codegen_reg_alloc_write_reg - out of registers\n");
 #endif
-            if (reg_set->dirty[c])
-                codegen_reg_writeback(reg_set, block, c, 1);
-        }
+        if (reg_set->dirty[c])
+            codegen_reg_writeback(reg_set, block, c, 1);
     }
 
     reg_set->regs[c].reg     = ir_reg.reg;
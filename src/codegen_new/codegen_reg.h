@@ -75,7 +75,12 @@ enum {
       When CODEBLOCK_STATIC_TOP is set, the physical register number will be
       used directly to index the stack. When it is clear, the difference
       between the current value of TOP and the value when the block was
-      first compiled will be added to adjust for any changes in TOP.*/
+      first compiled will be added to adjust for any changes in TOP.
+      IREG_ST() resolves TOP at compile time per instruction, so within a
+      block the stack depth is statically known and these map to host SSE
+      registers through the fp register set like any other IR register;
+      cpu_state.ST is only touched when the allocator spills or at block
+      boundaries.*/
     IREG_ST0 = 40,
     IREG_ST1 = 41,
     IREG_ST2 = 42,
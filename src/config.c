@@ -327,6 +327,12 @@ load_machine(void)
         mem_size = machine_get_max_ram(machine);
 
     cpu_use_dynarec = !!ini_section_get_int(cat, "cpu_use_dynarec", 0);
+    cpu_dynarec_threshold = ini_section_get_int(cat, "cpu_dynarec_threshold", 0);
+    if (cpu_dynarec_threshold < 0)
+        cpu_dynarec_threshold = 0;
+    else if (cpu_dynarec_threshold > 255)
+        cpu_dynarec_threshold = 255;
+    mem_hugepages = !!ini_section_get_int(cat, "mem_hugepages", 0);
     fpu_softfloat = !!ini_section_get_int(cat, "fpu_softfloat", 0);
     if ((fpu_type != FPU_NONE) && machine_has_flags(machine, MACHINE_SOFTFLOAT_ONLY))
         fpu_softfloat = 1;
@@ -344,6 +350,9 @@ load_machine(void)
     } else
         time_sync = !!ini_section_get_int(cat, "enable_sync", 1);
 
+    if ((time_sync & TIME_SYNC_ENABLED) && ini_section_get_int(cat, "time_sync_drift", 0))
+        time_sync |= TIME_SYNC_DRIFT;
+
     pit_mode = ini_section_get_int(cat, "pit_mode", -1);
 }
 
@@ -389,6 +398,12 @@ load_video(void)
     xga_active                       = xga_standalone_enabled;
     show_second_monitors             = !!ini_section_get_int(cat, "show_second_monitors", 1);
     video_fullscreen_scale_maximized = !!ini_section_get_int(cat, "video_fullscreen_scale_maximized", 0);
+    video_threaded_render            = !!ini_section_get_int(cat, "threaded_render", 0);
+    video_frame_pacing               = ini_section_get_int(cat, "frame_pacing", 0);
+    if (video_frame_pacing < 0)
+        video_frame_pacing = 0;
+    else if (video_frame_pacing > 4)
+        video_frame_pacing = 4;
 
     p = ini_section_get_string(cat, "gfxcard_2", NULL);
     if (!p)
@@ -570,6 +585,8 @@ load_sound(void)
     p = ini_section_get_string(cat, "fm_driver", "nuked");
     if (!strcmp(p, "ymfm")) {
         fm_driver = FM_DRV_YMFM;
+    } else if (!strcmp(p, "capture")) {
+        fm_driver = FM_DRV_CAPTURE;
     } else {
         fm_driver = FM_DRV_NUKED;
     }
@@ -839,6 +856,14 @@ load_hard_disks(void)
     uint32_t      board = 0;
     uint32_t      dev = 0;
 
+    hdd_cache_size = ini_section_get_int(cat, "block_cache_size", 4);
+    if (hdd_cache_size < 0)
+        hdd_cache_size = 0;
+    if (hdd_cache_size > 64)
+        hdd_cache_size = 64;
+
+    hdd_writeback = !!ini_section_get_int(cat, "write_back", 0);
+
     memset(temp, '\0', sizeof(temp));
     for (uint8_t c = 0; c < HDD_NUM; c++) {
         sprintf(temp, "hdd_%02i_parameters", c + 1);
@@ -1000,6 +1025,10 @@ load_hard_disks(void)
         p = ini_section_get_string(cat, temp, "");
         strncpy(hdd[c].vhd_parent, p, sizeof(hdd[c].vhd_parent) - 1);
 
+        sprintf(temp, "hdd_%02i_cow_base", c + 1);
+        p = ini_section_get_string(cat, temp, "");
+        strncpy(hdd[c].cow_base, p, sizeof(hdd[c].cow_base) - 1);
+
         /* If disk is empty or invalid, mark it for deletion. */
         if (!hdd_is_valid(c)) {
             sprintf(temp, "hdd_%02i_parameters", c + 1);
@@ -1934,6 +1963,14 @@ save_machine(void)
     ini_section_set_int(cat, "mem_size", mem_size);
 
     ini_section_set_int(cat, "cpu_use_dynarec", cpu_use_dynarec);
+    if (cpu_dynarec_threshold == 0)
+        ini_section_delete_var(cat, "cpu_dynarec_threshold");
+    else
+        ini_section_set_int(cat, "cpu_dynarec_threshold", cpu_dynarec_threshold);
+    if (mem_hugepages == 0)
+        ini_section_delete_var(cat, "mem_hugepages");
+    else
+        ini_section_set_int(cat, "mem_hugepages", mem_hugepages);
     ini_section_set_int(cat, "fpu_softfloat", fpu_softfloat);
 
     if (time_sync & TIME_SYNC_ENABLED)
@@ -1944,6 +1981,11 @@ save_machine(void)
     else
         ini_section_set_string(cat, "time_sync", "disabled");
 
+    if (time_sync & TIME_SYNC_DRIFT)
+        ini_section_set_int(cat, "time_sync_drift", 1);
+    else
+        ini_section_delete_var(cat, "time_sync_drift");
+
     if (pit_mode == -1)
         ini_section_delete_var(cat, "pit_mode");
     else
@@ -1991,6 +2033,16 @@ save_video(void)
     else
         ini_section_set_int(cat, "video_fullscreen_scale_maximized", video_fullscreen_scale_maximized);
 
+    if (video_threaded_render == 0)
+        ini_section_delete_var(cat, "threaded_render");
+    else
+        ini_section_set_int(cat, "threaded_render", video_threaded_render);
+
+    if (video_frame_pacing == 0)
+        ini_section_delete_var(cat, "frame_pacing");
+    else
+        ini_section_set_int(cat, "frame_pacing", video_frame_pacing);
+
     ini_delete_section_if_empty(config, cat);
 }
 
@@ -2127,7 +2179,8 @@ save_sound(void)
     else
         ini_section_set_string(cat, "sound_type", (sound_is_float == 1) ? "float" : "int16");
 
-    ini_section_set_string(cat, "fm_driver", (fm_driver == FM_DRV_NUKED) ? "nuked" : "ymfm");
+    ini_section_set_string(cat, "fm_driver",
+                           (fm_driver == FM_DRV_CAPTURE) ? "capture" : ((fm_driver == FM_DRV_NUKED) ? "nuked" : "ymfm"));
 
     ini_delete_section_if_empty(config, cat);
 }
@@ -2381,6 +2434,16 @@ save_hard_disks(void)
     char          tmp2[512];
     char         *p;
 
+    if (hdd_cache_size == 4)
+        ini_section_delete_var(cat, "block_cache_size");
+    else
+        ini_section_set_int(cat, "block_cache_size", hdd_cache_size);
+
+    if (hdd_writeback == 0)
+        ini_section_delete_var(cat, "write_back");
+    else
+        ini_section_set_int(cat, "write_back", hdd_writeback);
+
     memset(temp, 0x00, sizeof(temp));
     for (uint8_t c = 0; c < HDD_NUM; c++) {
         sprintf(temp, "hdd_%02i_parameters", c + 1);
@@ -2454,6 +2517,13 @@ save_hard_disks(void)
         } else
             ini_section_delete_var(cat, temp);
 
+        sprintf(temp, "hdd_%02i_cow_base", c + 1);
+        if (hdd_is_valid(c) && hdd[c].cow_base[0]) {
+            path_normalize(hdd[c].cow_base);
+            ini_section_set_string(cat, temp, hdd[c].cow_base);
+        } else
+            ini_section_delete_var(cat, temp);
+
         sprintf(temp, "hdd_%02i_speed", c + 1);
         if (!hdd_is_valid(c) || ((hdd[c].bus != HDD_BUS_ESDI) && (hdd[c].bus != HDD_BUS_IDE) &&
             (hdd[c].bus != HDD_BUS_SCSI) && (hdd[c].bus != HDD_BUS_ATAPI)))
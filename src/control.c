@@ -0,0 +1,313 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Control socket server. Started from the command line
+ *          (--control port), it listens on the loopback interface and
+ *          lets an external orchestrator drive a running instance over
+ *          a small binary protocol: pause/resume, hard reset, media
+ *          changes through the existing mount paths, screenshots, save
+ *          states and a performance counter query. It needs no UI, so
+ *          headless instances can be managed without faking input
+ *          events; the framing is described in 86box/control.h.
+ *
+ *          Clients are served one at a time on the server thread.
+ *          Commands reuse the entry points the UI threads already call
+ *          from outside the CPU thread: the mount helpers, plat_pause()
+ *          and the queued hard reset.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#ifdef _WIN32
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#else
+#    include <unistd.h>
+#    include <arpa/inet.h>
+#    include <sys/socket.h>
+#    include <errno.h>
+#endif
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/plat.h>
+#include <86box/plat_unused.h>
+#include <86box/thread.h>
+#include <86box/video.h>
+#include <86box/timer.h>
+#include <86box/fdd.h>
+#include <86box/scsi_device.h>
+#include <86box/cdrom.h>
+#include <86box/zip.h>
+#include <86box/mo.h>
+#include <86box/perfstats.h>
+#include <86box/savestate.h>
+#include <86box/control.h>
+
+static int control_socket = -1;
+
+#ifdef _WIN32
+static WSADATA control_wsa;
+#endif
+
+/* Counter snapshot taken once per emulated second, published to the
+   server thread with the same seqlock idiom as the telemetry records:
+   odd sequence values mean a write is in progress. */
+static control_counters_t control_ctrs;
+static volatile uint32_t  control_ctrs_seq = 0;
+
+/* Called from the 1-second title refresh timer, before the counters
+   are reset for the next second. */
+void
+control_onesec(int cur_fps)
+{
+    if (control_socket == -1)
+        return;
+
+    control_ctrs_seq++;
+    atomic_thread_fence(memory_order_release);
+
+    control_ctrs.fps             = cur_fps;
+    control_ctrs.speed_p50       = pc_speed_p50;
+    control_ctrs.speed_p99       = pc_speed_p99;
+    control_ctrs.insns           = perfc.insns;
+    control_ctrs.blocks_compiled = perfc.blocks_compiled;
+    control_ctrs.blocks_unrolled = perfc.blocks_unrolled;
+    control_ctrs.blocks_deleted  = perfc.blocks_deleted;
+    control_ctrs.lookup_fills    = perfc.lookup_fills;
+    control_ctrs.timer_fires     = perfc.timer_fires;
+
+    atomic_thread_fence(memory_order_release);
+    control_ctrs_seq++;
+}
+
+static void
+control_ctrs_read(control_counters_t *out)
+{
+    uint32_t seq0;
+    uint32_t seq1;
+
+    do {
+        seq0 = control_ctrs_seq;
+        atomic_thread_fence(memory_order_acquire);
+        *out = control_ctrs;
+        atomic_thread_fence(memory_order_acquire);
+        seq1 = control_ctrs_seq;
+    } while ((seq0 != seq1) || (seq0 & 1));
+
+    out->paused = !!dopause;
+}
+
+static int
+control_recv_full(int sock, void *buf, size_t len)
+{
+    char *p = (char *) buf;
+
+    while (len > 0) {
+        ssize_t n = recv(sock, p, len, 0);
+        if (n <= 0)
+            return 0;
+        p += n;
+        len -= n;
+    }
+
+    return 1;
+}
+
+static void
+control_respond(int sock, uint8_t cmd, uint8_t status, const void *payload, uint16_t len)
+{
+    control_frame_t frame = { .cmd = cmd, .arg = status, .len = len };
+
+    send(sock, (const char *) &frame, sizeof(frame), 0);
+    if (len > 0)
+        send(sock, (const char *) payload, len, 0);
+}
+
+/* Save or load a state with the emulation thread parked, the way the
+   UI menu entries do. */
+static int
+control_state(const char *path, int load)
+{
+    int old_pause = dopause;
+    int ret;
+
+    plat_pause(1);
+    ret = load ? savestate_load(path) : savestate_save(path);
+    plat_pause(old_pause);
+
+    return ret;
+}
+
+static uint8_t
+control_mount(uint8_t cmd, uint8_t arg, char *path)
+{
+    uint8_t id = arg & CONTROL_ARG_ID_MASK;
+    uint8_t wp = !!(arg & CONTROL_ARG_WP);
+
+    switch (cmd) {
+        case CONTROL_CMD_FLOPPY:
+            if (id >= FDD_NUM)
+                return CONTROL_EARG;
+            if (path[0] == '\0')
+                floppy_eject(id);
+            else
+                floppy_mount(id, path, wp);
+            break;
+
+        case CONTROL_CMD_CDROM:
+            if (id >= CDROM_NUM)
+                return CONTROL_EARG;
+            /* An empty path ejects. */
+            cdrom_mount(id, path);
+            break;
+
+        case CONTROL_CMD_ZIP:
+            if (id >= ZIP_NUM)
+                return CONTROL_EARG;
+            if (path[0] == '\0')
+                zip_eject(id);
+            else
+                zip_mount(id, path, wp);
+            break;
+
+        case CONTROL_CMD_MO:
+            if (id >= MO_NUM)
+                return CONTROL_EARG;
+            if (path[0] == '\0')
+                mo_eject(id);
+            else
+                mo_mount(id, path, wp);
+            break;
+
+        default:
+            return CONTROL_EBADCMD;
+    }
+
+    return CONTROL_OK;
+}
+
+static void
+control_serve(int sock)
+{
+    control_frame_t    frame;
+    control_counters_t ctrs;
+    char               path[2048];
+    uint8_t            status;
+
+    while (control_recv_full(sock, &frame, sizeof(frame))) {
+        /* Payloads are paths; anything longer than ours fit is bogus. */
+        if (frame.len >= sizeof(path)) {
+            control_respond(sock, frame.cmd, CONTROL_EARG, NULL, 0);
+            break;
+        }
+        if (!control_recv_full(sock, path, frame.len))
+            break;
+        path[frame.len] = '\0';
+
+        status = CONTROL_OK;
+
+        switch (frame.cmd) {
+            case CONTROL_CMD_PING:
+                break;
+
+            case CONTROL_CMD_PAUSE:
+                plat_pause(!!frame.arg);
+                break;
+
+            case CONTROL_CMD_RESET:
+                pc_reset_hard();
+                break;
+
+            case CONTROL_CMD_SCREENSHOT:
+                monitors[0].mon_screenshots++;
+                break;
+
+            case CONTROL_CMD_SAVE_STATE:
+            case CONTROL_CMD_LOAD_STATE:
+                if (frame.len == 0)
+                    status = CONTROL_EARG;
+                else if (!control_state(path, frame.cmd == CONTROL_CMD_LOAD_STATE))
+                    status = CONTROL_EFAIL;
+                break;
+
+            case CONTROL_CMD_COUNTERS:
+                control_ctrs_read(&ctrs);
+                control_respond(sock, frame.cmd, CONTROL_OK, &ctrs, sizeof(ctrs));
+                continue;
+
+            case CONTROL_CMD_FLOPPY:
+            case CONTROL_CMD_CDROM:
+            case CONTROL_CMD_ZIP:
+            case CONTROL_CMD_MO:
+                status = control_mount(frame.cmd, frame.arg, path);
+                break;
+
+            default:
+                status = CONTROL_EBADCMD;
+                break;
+        }
+
+        control_respond(sock, frame.cmd, status, NULL, 0);
+    }
+}
+
+static void
+control_server_thread(UNUSED(void *priv))
+{
+    socklen_t          sl = sizeof(struct sockaddr_in);
+    struct sockaddr_in addr;
+    int                sock;
+
+    listen(control_socket, 1);
+
+    /* Serve clients one at a time; commands are short and the protocol
+       is strictly request/response, so there is nothing to overlap. */
+    while ((sock = accept(control_socket, (struct sockaddr *) &addr, &sl)) >= 0) {
+        control_serve(sock);
+        close(sock);
+    }
+}
+
+void
+control_init(uint16_t port)
+{
+#ifdef _WIN32
+    WSAStartup(MAKEWORD(2, 2), &control_wsa);
+#endif
+
+    if ((control_socket = socket(AF_INET, SOCK_STREAM, 0)) == -1) {
+        pclog("CONTROL: failed to create socket\n");
+        return;
+    }
+
+    /* Loopback only: the protocol is unauthenticated by design. */
+    struct sockaddr_in bind_addr = {
+        .sin_family = AF_INET,
+        .sin_addr   = { .s_addr = htonl(INADDR_LOOPBACK) },
+        .sin_port   = htons(port)
+    };
+    if (bind(control_socket, (struct sockaddr *) &bind_addr, sizeof(bind_addr)) == -1) {
+        pclog("CONTROL: failed to bind on port %d\n", port);
+        close(control_socket);
+        control_socket = -1;
+        return;
+    }
+
+    pclog("CONTROL: listening on port %d\n", port);
+    thread_create_named(control_server_thread, NULL, "control server");
+}
@@ -19,7 +19,9 @@
 #include <86box/io.h>
 #include <86box/nmi.h>
 #include <86box/mem.h>
+#include <86box/perfstats.h>
 #include <86box/pic.h>
+#include "opbench.h"
 #include <86box/timer.h>
 #include <86box/pit.h>
 #include <86box/fdd.h>
@@ -231,6 +233,11 @@ exec386_2386(int32_t cycs)
     int32_t  ins_cycles;
     uint32_t addr;
 
+    /* x86_opcodes only ever changes in cpu_set(); latch it in a local so
+       the compiler does not have to reload the global pointer after every
+       indirect call. */
+    const OpFn *opcode_table = x86_opcodes;
+
     cycles += cycs;
 
     while (cycles > 0) {
@@ -260,7 +267,11 @@ exec386_2386(int32_t cycs)
             fetchdat = fastreadl_fetch(cs + cpu_state.pc);
             ol = opcode_length[fetchdat & 0xff];
             CHECK_READ_CS(MIN(ol, 4));
-            ins_fetch_fault = cpu_386_check_instruction_fault();
+            /*Only take the call when a breakpoint is actually armed - this is
+              a per-instruction path and debug registers are almost never in
+              use.*/
+            if ((dr[7] & 0xFF) && !(cpu_state.eflags & RF_FLAG))
+                ins_fetch_fault = cpu_386_check_instruction_fault();
 
             if (!cpu_state.abrt && ins_fetch_fault) {
                 x86gen();
@@ -279,7 +290,14 @@ exec386_2386(int32_t cycs)
                 trap |= !!(cpu_state.flags & T_FLAG);
 
                 cpu_state.pc++;
-                x86_opcodes[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                perfc.insns++;
+                if (opbench_on) {
+                    uint64_t opbench_t = opbench_ts();
+
+                    opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                    opbench_record((opcode | cpu_state.op32) & 0x3ff, opbench_ts() - opbench_t);
+                } else
+                    opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
                 if (x86_was_reset)
                     break;
             }
@@ -350,7 +368,7 @@ block_ended:
 #else
                 nmi = 0;
 #endif
-            } else if ((cpu_state.flags & I_FLAG) && pic.int_pending && !cpu_end_block_after_ins) {
+            } else if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !cpu_end_block_after_ins) {
                 vector = picinterrupt();
                 if (vector != -1) {
                     flags_rebuild();
@@ -384,6 +402,27 @@ block_ended:
             if (TIMER_VAL_LESS_THAN_VAL(timer_target, (uint32_t) tsc))
                 timer_process();
 
+            /* The guest is parked on HLT: nothing can wake it before the next
+               timer event, so take the remaining cycles in one step.  The
+               pc == oldpc check makes sure a wakeup was not just serviced
+               above. */
+            if (cpu_idle_hlt) {
+                cpu_idle_hlt = 0;
+                if ((cycles > 0) && (cpu_state.pc == cpu_state.oldpc)) {
+                    int32_t skip = (int32_t) (timer_target - (uint32_t) tsc) + 1;
+
+                    if (skip > cycles)
+                        skip = cycles;
+                    if (skip > 0) {
+                        cycles -= skip;
+                        tsc += skip;
+                        if (TIMER_VAL_LESS_THAN_VAL(timer_target, (uint32_t) tsc))
+                            timer_process();
+                        cycdiff = oldcyc - cycles;
+                    }
+                }
+            }
+
 #ifdef USE_GDBSTUB
             if (gdbstub_instruction())
                 return;
@@ -17,6 +17,7 @@
 #include "x87.h"
 #include <86box/nmi.h>
 #include <86box/mem.h>
+#include <86box/memtrace.h>
 #include <86box/smram.h>
 #include <86box/pic.h>
 #include <86box/pit.h>
@@ -79,6 +80,11 @@ int smi_latched = 0;
 int smm_in_hlt  = 0;
 int smi_block   = 0;
 
+/* Set by opHLT() when the CPU parks on the halt instruction; the exec
+   loops use it to skip ahead to the next timer event instead of
+   re-executing HLT 100 cycles at a time. */
+int cpu_idle_hlt = 0;
+
 int prefetch_prefixes = 0;
 int rf_flag_no_clear = 0;
 
@@ -1547,27 +1553,106 @@ x86illegal(void)
     x86_int(6);
 }
 
+/* Cache for the TSS I/O permission bitmap. V86 and user-mode I/O re-checks
+   the bitmap on every IN/OUT, which costs two guest memory walks per port
+   access; cached entries are guarded by the descriptor write watch from
+   mem.c, so a guest write to a bitmap page (or any MMU flush) bumps
+   mem_desc_watch_gen and drops them. Entries start zeroed and the
+   generation counter starts at 1, so an empty cache never hits. */
+#define IOBM_CACHE_SIZE 64
+
+typedef struct iobm_cache_t {
+    uint32_t addr; /* linear address of the cached bitmap chunk */
+    uint32_t gen;
+    uint16_t data;
+    uint8_t  wide; /* set if a full word was fetched */
+} iobm_cache_t;
+
+static iobm_cache_t iobm_cache[IOBM_CACHE_SIZE];
+static uint32_t     iobm_off_base; /* tr.base the cached bitmap offset belongs to */
+static uint32_t     iobm_off_gen;
+static uint16_t     iobm_off;
+
+/* Arm the descriptor write watch for the bitmap byte/word at linear addr and
+   return 1 if the result may be cached (plain RAM, not crossing a page). */
+static int
+iobm_cache_arm(uint32_t addr, int len)
+{
+    uint32_t phys;
+
+    if (((addr & 0xfff) + len) > 0x1000)
+        return 0;
+    phys = get_phys_noabrt(addr);
+    if ((phys == 0xffffffff) || !mem_addr_is_ram(phys & rammask))
+        return 0;
+    mem_desc_watch_page((phys & rammask) >> 12);
+    return 1;
+}
+
 int
 checkio(uint32_t port, int mask)
 {
-    uint32_t t;
+    uint32_t      t;
+    uint32_t      addr;
+    int           wide;
+    int           cacheable = is486 && !memtrace_on;
+    iobm_cache_t *cache;
 
     cpl_override = 1;
-    t            = readmemw(tr.base, 0x66);
+    if (cacheable && (iobm_off_base == tr.base) && (iobm_off_gen == mem_desc_watch_gen))
+        t = iobm_off;
+    else {
+        t = readmemw(tr.base, 0x66);
 
-    if (UNLIKELY(cpu_state.abrt)) {
-        cpl_override = 0;
-        return 0;
+        if (UNLIKELY(cpu_state.abrt)) {
+            cpl_override = 0;
+            return 0;
+        }
+        if (cacheable && iobm_cache_arm(tr.base + 0x66, 2)) {
+            iobm_off_base = tr.base;
+            iobm_off      = t;
+            iobm_off_gen  = mem_desc_watch_gen;
+        }
     }
 
     t += (port >> 3UL);
     mask <<= (port & 7);
-    if (UNLIKELY(mask & 0xff00)) {
-        if (LIKELY(t < tr.limit))
-            mask &= readmemwl(tr.base + t);
+    wide  = !!(mask & 0xff00);
+    addr  = tr.base + t;
+    cache = &iobm_cache[(port >> 3) & (IOBM_CACHE_SIZE - 1)];
+    if (UNLIKELY(wide)) {
+        if (LIKELY(t < tr.limit)) {
+            if (cacheable && (cache->addr == addr) && (cache->gen == mem_desc_watch_gen) && cache->wide)
+                mask &= cache->data;
+            else {
+                uint16_t data = readmemwl(addr);
+
+                if (cacheable && !cpu_state.abrt && iobm_cache_arm(addr, 2)) {
+                    cache->addr = addr;
+                    cache->data = data;
+                    cache->wide = 1;
+                    cache->gen  = mem_desc_watch_gen;
+                }
+                mask &= data;
+            }
+        }
     } else {
-        if (LIKELY(t <= tr.limit))
-            mask &= readmembl(tr.base + t);
+        if (LIKELY(t <= tr.limit)) {
+            /* A wide entry at the same address also covers the low byte. */
+            if (cacheable && (cache->addr == addr) && (cache->gen == mem_desc_watch_gen))
+                mask &= cache->data;
+            else {
+                uint8_t data = readmembl(addr);
+
+                if (cacheable && !cpu_state.abrt && iobm_cache_arm(addr, 1)) {
+                    cache->addr = addr;
+                    cache->data = data;
+                    cache->wide = 0;
+                    cache->gen  = mem_desc_watch_gen;
+                }
+                mask &= data;
+            }
+        }
     }
     cpl_override = 0;
     return mask;
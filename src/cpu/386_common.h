@@ -53,10 +53,69 @@
 #    define readmemb_n(s, a, b) ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF) ? readmembl_no_mmut((s) + (a), b) : *(uint8_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))))
 #    define readmemw_n(s, a, b) ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 1)) ? readmemwl_no_mmut((s) + (a), b) : *(uint16_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uint32_t) ((s) + (a))))
 #    define readmeml_n(s, a, b) ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 3)) ? readmemll_no_mmut((s) + (a), b) : *(uint32_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uint32_t) ((s) + (a))))
-#    define readmemb(s, a)      ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF) ? readmembl((s) + (a)) : *(uint8_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))))
-#    define readmemw(s, a)      ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 1)) ? readmemwl((s) + (a)) : *(uint16_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uint32_t) ((s) + (a))))
-#    define readmeml(s, a)      ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 3)) ? readmemll((s) + (a)) : *(uint32_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uint32_t) ((s) + (a))))
-#    define readmemq(s, a)      ((readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 7)) ? readmemql((s) + (a)) : *(uint64_t *) (readlookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))))
+/*Micro-TLB probe: check the last few translated pages before touching the
+  big lookup table, inserting on a table hit. Returns LOOKUP_INV when the
+  access must take the slow path.*/
+static __inline uintptr_t
+mutlb_lookup(mutlb_t *mutlb, const uintptr_t *lookup2, uint32_t addr)
+{
+    uint32_t page = addr >> 12;
+
+    for (uint32_t c = 0; c < MUTLB_NR; c++) {
+        if (mutlb->page[c] == page)
+            return mutlb->lookup[c];
+    }
+    if (lookup2[page] != (uintptr_t) LOOKUP_INV) {
+        mutlb->next                = (mutlb->next + 1) & (MUTLB_NR - 1);
+        mutlb->page[mutlb->next]   = page;
+        mutlb->lookup[mutlb->next] = lookup2[page];
+    }
+    return lookup2[page];
+}
+
+static __inline uint8_t
+readmemb(uint32_t s, uint32_t a)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || ((p = mutlb_lookup(&mutlb_read, readlookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        return readmembl(addr);
+    return *(uint8_t *) (p + addr);
+}
+
+static __inline uint16_t
+readmemw(uint32_t s, uint32_t a)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 1) || ((p = mutlb_lookup(&mutlb_read, readlookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        return readmemwl(addr);
+    return *(uint16_t *) (p + addr);
+}
+
+static __inline uint32_t
+readmeml(uint32_t s, uint32_t a)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 3) || ((p = mutlb_lookup(&mutlb_read, readlookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        return readmemll(addr);
+    return *(uint32_t *) (p + addr);
+}
+
+static __inline uint64_t
+readmemq(uint32_t s, uint32_t a)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 7) || ((p = mutlb_lookup(&mutlb_read, readlookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        return readmemql(addr);
+    return *(uint64_t *) (p + addr);
+}
 
 #    define writememb_n(s, a, b, v)                                                                    \
         if (writelookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF) \
@@ -73,26 +132,53 @@
             writememll_no_mmut((s) + (a), b, v);                                                                            \
         else                                                                                                                \
             *(uint32_t *) (writelookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))) = v
-#    define writememb(s, a, v)                                                                         \
-        if (writelookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF) \
-            writemembl((s) + (a), v);                                                                  \
-        else                                                                                           \
-            *(uint8_t *) (writelookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))) = v
-#    define writememw(s, a, v)                                                                                              \
-        if (writelookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 1)) \
-            writememwl((s) + (a), v);                                                                                       \
-        else                                                                                                                \
-            *(uint16_t *) (writelookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))) = v
-#    define writememl(s, a, v)                                                                                              \
-        if (writelookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 3)) \
-            writememll((s) + (a), v);                                                                                       \
-        else                                                                                                                \
-            *(uint32_t *) (writelookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))) = v
-#    define writememq(s, a, v)                                                                                              \
-        if (writelookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF || (((s) + (a)) & 7)) \
-            writememql((s) + (a), v);                                                                                       \
-        else                                                                                                                \
-            *(uint64_t *) (writelookup2[(uint32_t) ((s) + (a)) >> 12] + (uintptr_t) ((s) + (a))) = v
+static __inline void
+writememb(uint32_t s, uint32_t a, uint8_t v)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || ((p = mutlb_lookup(&mutlb_write, writelookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        writemembl(addr, v);
+    else
+        *(uint8_t *) (p + addr) = v;
+}
+
+static __inline void
+writememw(uint32_t s, uint32_t a, uint16_t v)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 1) || ((p = mutlb_lookup(&mutlb_write, writelookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        writememwl(addr, v);
+    else
+        *(uint16_t *) (p + addr) = v;
+}
+
+static __inline void
+writememl(uint32_t s, uint32_t a, uint32_t v)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 3) || ((p = mutlb_lookup(&mutlb_write, writelookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        writememll(addr, v);
+    else
+        *(uint32_t *) (p + addr) = v;
+}
+
+static __inline void
+writememq(uint32_t s, uint32_t a, uint64_t v)
+{
+    uint32_t  addr = s + a;
+    uintptr_t p;
+
+    if ((s == 0xFFFFFFFF) || (addr & 7) || ((p = mutlb_lookup(&mutlb_write, writelookup2, addr)) == (uintptr_t) LOOKUP_INV))
+        writememql(addr, v);
+    else
+        *(uint64_t *) (p + addr) = v;
+}
 
 #    define do_mmut_rb(s, a, b)                                                                       \
         if (readlookup2[(uint32_t) ((s) + (a)) >> 12] == (uintptr_t) LOOKUP_INV || (s) == 0xFFFFFFFF) \
@@ -240,6 +326,29 @@ fastreadl(uint32_t a)
     return readmemll_2386(a);
 }
 #else
+/* Second-level fetch lookup: consult the direct-mapped pccache_l2 before
+   paying for the full getpccache() walk, so branchy code hopping between a
+   handful of pages stops re-translating on every page crossing. Lines are
+   validated against mem_mapping_generation, and the 286 keeps the direct
+   path because getpccache() refreshes its prefetch cycle counts per call. */
+static __inline uint8_t *
+getpccache_l2(uint32_t a)
+{
+    pccache_line_t *line = &pccache_l2[(a >> 12) & (PCCACHE_L2_NR - 1)];
+    uint8_t        *t;
+
+    if (!is286 && (line->page == (a >> 12)) && (line->generation == mem_mapping_generation))
+        return line->ptr;
+
+    t = getpccache(a);
+    if (!cpu_state.abrt && !is286) {
+        line->page       = a >> 12;
+        line->generation = mem_mapping_generation;
+        line->ptr        = t;
+    }
+    return t;
+}
+
 static __inline uint8_t
 fastreadb(uint32_t a)
 {
@@ -251,7 +360,7 @@ fastreadb(uint32_t a)
 #    else
         return *((uint8_t *) &pccache2[a]);
 #    endif
-    t = getpccache(a);
+    t = getpccache_l2(a);
     if (cpu_state.abrt)
         return 0;
     pccache  = a >> 12;
@@ -279,7 +388,7 @@ fastreadw(uint32_t a)
 #    else
         return *((uint16_t *) &pccache2[a]);
 #    endif
-    t = getpccache(a);
+    t = getpccache_l2(a);
     if (cpu_state.abrt)
         return 0;
 
@@ -299,7 +408,7 @@ fastreadl(uint32_t a)
     uint32_t val;
     if ((a & 0xFFF) < 0xFFD) {
         if ((a >> 12) != pccache) {
-            t = getpccache(a);
+            t = getpccache_l2(a);
             if (cpu_state.abrt)
                 return 0;
             pccache2 = t;
@@ -386,7 +495,7 @@ fastreadw_fetch(uint32_t a)
 #    else
         return *((uint16_t *) &pccache2[a]);
 #    endif
-    t = getpccache(a);
+    t = getpccache_l2(a);
     if (cpu_state.abrt)
         return 0;
 
@@ -406,7 +515,7 @@ fastreadl_fetch(uint32_t a)
     uint32_t val;
     if ((a & 0xFFF) < 0xFFD) {
         if ((a >> 12) != pccache) {
-            t = getpccache(a);
+            t = getpccache_l2(a);
             if (cpu_state.abrt)
                 return 0;
             pccache2 = t;
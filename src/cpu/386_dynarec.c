@@ -23,7 +23,10 @@
 #include <86box/io.h>
 #include <86box/mem.h>
 #include <86box/nmi.h>
+#include <86box/perfstats.h>
 #include <86box/pic.h>
+#include <86box/watchdog.h>
+#include "opbench.h"
 #include <86box/timer.h>
 #include <86box/fdd.h>
 #include <86box/fdc.h>
@@ -230,6 +233,18 @@ int32_t         cycles_main = 0;
 static int32_t  cycles_old  = 0;
 static uint64_t tsc_old     = 0;
 
+#    ifdef USE_NEW_DYNAREC
+/*Round-robin slot selector for filling in direct block links.*/
+static int block_link_slot = 0;
+#    endif
+
+/*Maximum number of blocks recompiled per exec386_dynarec() timeslice. A burst
+  of new code (eg a program launch) can otherwise spend most of a slice in the
+  recompiler, which is felt as input latency; blocks over the budget are
+  interpreted and picked up again in a later slice.*/
+#    define COMPILE_BUDGET 64
+static int compile_budget = COMPILE_BUDGET;
+
 #    ifdef USE_ACYCS
 int32_t acycs = 0;
 #    endif
@@ -265,8 +280,17 @@ update_tsc(void)
 static __inline void
 exec386_dynarec_int(void)
 {
+    /* x86_opcodes only ever changes in cpu_set(); latch it in a local so
+       the compiler does not have to reload the global pointer after every
+       indirect call. */
+    const OpFn *opcode_table = x86_opcodes;
+
     cpu_block_end = 0;
     x86_was_reset = 0;
+#    ifdef USE_NEW_DYNAREC
+    /*Interpreted code breaks the chain of directly linked blocks.*/
+    codegen_linked_prev_block = BLOCK_INVALID;
+#    endif
 
     if (trap == 2) {
         /* Handle the T bit in the new TSS first. */
@@ -298,7 +322,14 @@ exec386_dynarec_int(void)
             trap = cpu_state.flags & T_FLAG;
 
             cpu_state.pc++;
-            x86_opcodes[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+            perfc.insns++;
+            if (opbench_on) {
+                uint64_t opbench_t = opbench_ts();
+
+                opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                opbench_record((opcode | cpu_state.op32) & 0x3ff, opbench_ts() - opbench_t);
+            } else
+                opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
         }
 
 #    ifndef USE_NEW_DYNAREC
@@ -323,7 +354,7 @@ exec386_dynarec_int(void)
             CPU_BLOCK_END();
         else if (nmi && nmi_enable && nmi_mask)
             CPU_BLOCK_END();
-        else if ((cpu_state.flags & I_FLAG) && pic.int_pending && !cpu_end_block_after_ins)
+        else if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !cpu_end_block_after_ins)
             CPU_BLOCK_END();
     }
 
@@ -344,11 +375,34 @@ block_ended:
 static __inline void
 exec386_dynarec_dyn(void)
 {
+    const OpFn *opcode_table = x86_opcodes;
     uint32_t start_pc  = 0;
     uint32_t phys_addr = get_phys(cs + cpu_state.pc);
     int      hash      = HASH(phys_addr);
 #    ifdef USE_NEW_DYNAREC
-    codeblock_t *block = &codeblock[codeblock_hash[hash]];
+    codeblock_t *block  = NULL;
+    int          linked = 0;
+
+    /*Follow a direct link from the previously executed block, if one matches
+      the current PC, instead of going through the hash table. The linked
+      block still goes through the full validity checks below.*/
+    if (codegen_linked_prev_block != BLOCK_INVALID) {
+        codeblock_t *prev_block = &codeblock[codegen_linked_prev_block];
+
+        for (uint8_t c = 0; c < 2; c++) {
+            if ((prev_block->link_nr[c] != BLOCK_INVALID) && (prev_block->link_pc[c] == cs + cpu_state.pc)) {
+                codeblock_t *linked_block = &codeblock[prev_block->link_nr[c]];
+
+                if ((linked_block->pc == cs + cpu_state.pc) && (linked_block->phys == phys_addr)) {
+                    block  = linked_block;
+                    linked = 1;
+                }
+                break;
+            }
+        }
+    }
+    if (!block)
+        block = &codeblock[codeblock_hash[hash]];
 #    else
     codeblock_t *block = codeblock_hash[hash];
 #    endif
@@ -469,9 +523,29 @@ exec386_dynarec_dyn(void)
     {
         void (*code)(void) = (void *) &block->data[BLOCK_START];
 
-#    ifndef USE_NEW_DYNAREC
+#    ifdef USE_NEW_DYNAREC
+        /*Record a direct link from the previously executed block to this one,
+          and remember this block so the next dispatch can link from it.*/
+        if (!linked && (codegen_linked_prev_block != BLOCK_INVALID)) {
+            codeblock_t *prev_block = &codeblock[codegen_linked_prev_block];
+            int          slot;
+
+            if (prev_block->link_pc[0] == cs + cpu_state.pc)
+                slot = 0;
+            else if (prev_block->link_pc[1] == cs + cpu_state.pc)
+                slot = 1;
+            else {
+                block_link_slot ^= 1;
+                slot = block_link_slot;
+            }
+            prev_block->link_nr[slot] = get_block_nr(block);
+            prev_block->link_pc[slot] = cs + cpu_state.pc;
+        }
+        codegen_linked_prev_block = get_block_nr(block);
+#    else
         codeblock_hash[hash] = block;
 #    endif
+        perfc.insns += block->ins;
         inrecomp = 1;
         code();
 #    ifdef USE_ACYCS
@@ -484,13 +558,31 @@ exec386_dynarec_dyn(void)
             cpu_state.pc &= 0xffff;
 #    endif
     } else if (valid_block && !cpu_state.abrt) {
+        if (compile_budget <= 0) {
+            /*Compile budget for this timeslice is spent - interpret the block
+              now and compile it in a later slice.*/
+            exec386_dynarec_int();
+            return;
+        }
+
 #    ifdef USE_NEW_DYNAREC
+        if (cpu_dynarec_threshold && (block->exec_count < cpu_dynarec_threshold) && !codegen_page_is_hot(phys_addr)) {
+            /*Block has not been executed often enough to be worth
+              compiling yet - interpret it and count this execution.*/
+            block->exec_count++;
+            exec386_dynarec_int();
+            return;
+        }
+
+        codegen_linked_prev_block = BLOCK_INVALID;
         start_pc                 = cs + cpu_state.pc;
         const int max_block_size = (block->flags & CODEBLOCK_BYTE_MASK) ? ((128 - 25) - (start_pc & 0x3f)) : 1000;
 #    else
         start_pc = cpu_state.pc;
 #    endif
 
+        compile_budget--;
+
         cpu_block_end = 0;
         x86_was_reset = 0;
 
@@ -501,6 +593,7 @@ exec386_dynarec_dyn(void)
 #    endif
         codegen_block_start_recompile(block);
         codegen_in_recompile = 1;
+        perfc.blocks_compiled++;
 
         while (!cpu_block_end) {
 #    ifndef USE_NEW_DYNAREC
@@ -525,9 +618,10 @@ exec386_dynarec_dyn(void)
 
                 cpu_state.pc++;
 
-                codegen_generate_call(opcode, x86_opcodes[(opcode | cpu_state.op32) & 0x3ff], fetchdat, cpu_state.pc, cpu_state.pc - 1);
+                codegen_generate_call(opcode, opcode_table[(opcode | cpu_state.op32) & 0x3ff], fetchdat, cpu_state.pc, cpu_state.pc - 1);
 
-                x86_opcodes[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                perfc.insns++;
+                opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
 
                 if (x86_was_reset)
                     break;
@@ -555,7 +649,7 @@ exec386_dynarec_dyn(void)
                 CPU_BLOCK_END();
             if (nmi && nmi_enable && nmi_mask)
                 CPU_BLOCK_END();
-            if ((cpu_state.flags & I_FLAG) && pic.int_pending && !cpu_end_block_after_ins)
+            if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !cpu_end_block_after_ins)
                 CPU_BLOCK_END();
 
             if (cpu_end_block_after_ins) {
@@ -588,6 +682,7 @@ exec386_dynarec_dyn(void)
     } else if (!cpu_state.abrt) {
         /* Mark block but do not recompile */
 #    ifdef USE_NEW_DYNAREC
+        codegen_linked_prev_block = BLOCK_INVALID;
         start_pc                 = cs + cpu_state.pc;
         const int max_block_size = (block->flags & CODEBLOCK_BYTE_MASK) ? ((128 - 25) - (start_pc & 0x3f)) : 1000;
 #    else
@@ -598,6 +693,7 @@ exec386_dynarec_dyn(void)
         x86_was_reset = 0;
 
         codegen_block_init(phys_addr);
+        perfc.blocks_compiled++;
 
         while (!cpu_block_end) {
 #    ifndef USE_NEW_DYNAREC
@@ -624,7 +720,8 @@ exec386_dynarec_dyn(void)
 
                 cpu_state.pc++;
 
-                x86_opcodes[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                perfc.insns++;
+                opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
 
                 if (x86_was_reset)
                     break;
@@ -652,7 +749,7 @@ exec386_dynarec_dyn(void)
                 CPU_BLOCK_END();
             if (nmi && nmi_enable && nmi_mask)
                 CPU_BLOCK_END();
-            if ((cpu_state.flags & I_FLAG) && pic.int_pending && !cpu_end_block_after_ins)
+            if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !cpu_end_block_after_ins)
                 CPU_BLOCK_END();
 
             if (cpu_end_block_after_ins) {
@@ -698,6 +795,7 @@ exec386_dynarec(int32_t cycs)
 #    ifdef USE_ACYCS
     acycs = 0;
 #    endif
+    compile_budget = COMPILE_BUDGET;
     cycles_main += cycs;
     while (cycles_main > 0) {
         int32_t cycles_start;
@@ -718,6 +816,7 @@ exec386_dynarec(int32_t cycs)
             cycles_old       = cycles;
             oldtsc           = tsc;
             tsc_old          = tsc;
+            watchdog_block(cs + cpu_state.pc);
             if (!CACHE_ON()) /*Interpret block*/
             {
                 exec386_dynarec_int();
@@ -765,7 +864,7 @@ exec386_dynarec(int32_t cycs)
 #    else
                 nmi = 0;
 #    endif
-            } else if ((cpu_state.flags & I_FLAG) && pic.int_pending) {
+            } else if ((cpu_state.flags & I_FLAG) && pic_irq_pending()) {
                 vector = picinterrupt();
                 if (vector != -1) {
 #    ifndef USE_NEW_DYNAREC
@@ -794,6 +893,26 @@ exec386_dynarec(int32_t cycs)
                     timer_process();
             }
 
+            /* The guest is parked on HLT: nothing can wake it before the next
+               timer event, so take the remaining cycles in one step.  The
+               pc == oldpc check makes sure a wakeup was not just serviced
+               above. */
+            if (cpu_idle_hlt) {
+                cpu_idle_hlt = 0;
+                if ((cycles > 0) && (cpu_state.pc == cpu_state.oldpc)) {
+                    int32_t skip = (int32_t) (timer_target - (uint32_t) tsc) + 1;
+
+                    if (skip > cycles)
+                        skip = cycles;
+                    if (skip > 0) {
+                        cycles -= skip;
+                        tsc += skip;
+                        if (TIMER_VAL_LESS_THAN_VAL(timer_target, (uint32_t) tsc))
+                            timer_process();
+                    }
+                }
+            }
+
 #    ifdef USE_GDBSTUB
             if (gdbstub_instruction())
                 return;
@@ -816,6 +935,8 @@ exec386(int32_t cycs)
     int32_t  ins_cycles;
     uint32_t addr;
 
+    const OpFn *opcode_table = x86_opcodes;
+
     cycles += cycs;
 
     while (cycles > 0) {
@@ -853,7 +974,14 @@ exec386(int32_t cycs)
                 trap = cpu_state.flags & T_FLAG;
 
                 cpu_state.pc++;
-                x86_opcodes[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                perfc.insns++;
+                if (opbench_on) {
+                    uint64_t opbench_t = opbench_ts();
+
+                    opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
+                    opbench_record((opcode | cpu_state.op32) & 0x3ff, opbench_ts() - opbench_t);
+                } else
+                    opcode_table[(opcode | cpu_state.op32) & 0x3ff](fetchdat);
                 if (x86_was_reset)
                     break;
             }
@@ -920,7 +1048,7 @@ exec386(int32_t cycs)
 #else
                 nmi = 0;
 #endif
-            } else if ((cpu_state.flags & I_FLAG) && pic.int_pending && !cpu_end_block_after_ins) {
+            } else if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !cpu_end_block_after_ins) {
                 vector = picinterrupt();
                 if (vector != -1) {
                     flags_rebuild();
@@ -954,6 +1082,27 @@ exec386(int32_t cycs)
             if (TIMER_VAL_LESS_THAN_VAL(timer_target, (uint32_t) tsc))
                 timer_process();
 
+            /* The guest is parked on HLT: nothing can wake it before the next
+               timer event, so take the remaining cycles in one step.  The
+               pc == oldpc check makes sure a wakeup was not just serviced
+               above. */
+            if (cpu_idle_hlt) {
+                cpu_idle_hlt = 0;
+                if ((cycles > 0) && (cpu_state.pc == cpu_state.oldpc)) {
+                    int32_t skip = (int32_t) (timer_target - (uint32_t) tsc) + 1;
+
+                    if (skip > cycles)
+                        skip = cycles;
+                    if (skip > 0) {
+                        cycles -= skip;
+                        tsc += skip;
+                        if (TIMER_VAL_LESS_THAN_VAL(timer_target, (uint32_t) tsc))
+                            timer_process();
+                        cycdiff = oldcyc - cycles;
+                    }
+                }
+            }
+
 #ifdef USE_GDBSTUB
             if (gdbstub_instruction())
                 return;
@@ -42,11 +42,13 @@ int is8086 = 0;
 uint8_t  use_custom_nmi_vector = 0;
 uint32_t custom_nmi_vector     = 0x00000000;
 
-/* The prefetch queue (4 bytes for 8088, 6 bytes for 8086). */
-static uint8_t pfq[6];
+/* The prefetch queue (4 bytes for 8088, 6 bytes for 8086), kept as a ring
+   of 8 so the head index can wrap with a mask instead of shifting the
+   whole array on every byte consumed. */
+static uint8_t pfq[8];
 
 /* Variables to aid with the prefetch queue operation. */
-static int biu_cycles = 0, pfq_pos = 0;
+static int biu_cycles = 0, pfq_pos = 0, pfq_head = 0;
 
 /* The IP equivalent of the current prefetch queue position. */
 static uint16_t pfq_ip;
@@ -424,14 +426,15 @@ pfq_write(void)
     if (is8086 && (pfq_pos < (pfq_size - 1))) {
         /* The 8086 fetches 2 bytes at a time, and only if there's at least 2 bytes
            free in the queue. */
-        tempw                         = readmemwf(pfq_ip);
-        *(uint16_t *) &(pfq[pfq_pos]) = tempw;
+        tempw                             = readmemwf(pfq_ip);
+        pfq[(pfq_head + pfq_pos) & 7]     = tempw & 0xff;
+        pfq[(pfq_head + pfq_pos + 1) & 7] = tempw >> 8;
         pfq_ip += 2;
         pfq_pos += 2;
     } else if (!is8086 && (pfq_pos < pfq_size)) {
         /* The 8088 fetches 1 byte at a time, and only if there's at least 1 byte
            free in the queue. */
-        pfq[pfq_pos] = readmembf(pfq_ip);
+        pfq[(pfq_head + pfq_pos) & 7] = readmembf(pfq_ip);
         pfq_ip++;
         pfq_pos++;
     }
@@ -440,11 +443,10 @@ pfq_write(void)
 static uint8_t
 pfq_read(void)
 {
-    uint8_t temp, i;
+    uint8_t temp;
 
-    temp = pfq[0];
-    for (i = 0; i < (pfq_size - 1); i++)
-        pfq[i] = pfq[i + 1];
+    temp     = pfq[pfq_head];
+    pfq_head = (pfq_head + 1) & 7;
     pfq_pos--;
     cpu_state.pc = (cpu_state.pc + 1) & 0xffff;
     return temp;
@@ -506,16 +508,23 @@ pfq_fetch(void)
 static void
 pfq_add(int c, int add)
 {
-    int d;
+    int fetches;
 
     if ((c <= 0) || (pfq_pos >= pfq_size))
         return;
 
-    for (d = 0; d < c; d++) {
-        biu_cycles = (biu_cycles + 1) & 0x03;
-        if (prefetching && add && (biu_cycles == 0x00))
-            pfq_write();
-    }
+    /* A code fetch completes on every fourth BIU cycle; counting the
+       fetch points arithmetically replaces the old cycle-by-cycle loop
+       with identical timing. pfq_write() itself stops filling once the
+       queue runs full mid-burst, as before. */
+    fetches    = (biu_cycles + c) >> 2;
+    biu_cycles = (biu_cycles + c) & 0x03;
+
+    if (!prefetching || !add)
+        return;
+
+    while (fetches-- > 0)
+        pfq_write();
 }
 
 /* Clear the prefetch queue - called on reset and on anything that affects either CS or IP. */
@@ -523,6 +532,7 @@ static void
 pfq_clear(void)
 {
     pfq_pos     = 0;
+    pfq_head    = 0;
     prefetching = 0;
 }
 
@@ -1023,7 +1033,7 @@ irq_pending(void)
 {
     uint8_t temp;
 
-    temp = (nmi && nmi_enable && nmi_mask) || ((cpu_state.flags & T_FLAG) && !noint) || ((cpu_state.flags & I_FLAG) && pic.int_pending && !noint);
+    temp = (nmi && nmi_enable && nmi_mask) || ((cpu_state.flags & T_FLAG) && !noint) || ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !noint);
 
     return temp;
 }
@@ -1049,7 +1059,7 @@ check_interrupts(void)
 #endif
             return;
         }
-        if ((cpu_state.flags & I_FLAG) && pic.int_pending && !noint) {
+        if ((cpu_state.flags & I_FLAG) && pic_irq_pending() && !noint) {
             repeating = 0;
             completed = 1;
             ovr_seg   = NULL;
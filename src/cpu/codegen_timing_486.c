@@ -313,9 +313,112 @@ COUNT(int *c, int op_32)
     return *c;
 }
 
+/*Flattened copies of the tables above with the CYCLES()/CYCLES2()/pointer
+  encoding already resolved, indexed [opcode][op size]. These bake in the
+  current values of the timing_* globals, so they are rebuilt whenever
+  cpu_set() changes those; in between, per-instruction timing is a single
+  array load instead of the COUNT() decode walk.*/
+static int16_t opcode_timings_pre[256][2];
+static int16_t opcode_timings_mod3_pre[256][2];
+static int16_t opcode_timings_0f_pre[256][2];
+static int16_t opcode_timings_0f_mod3_pre[256][2];
+static int16_t opcode_timings_shift_pre[8][2];
+static int16_t opcode_timings_shift_mod3_pre[8][2];
+static int16_t opcode_timings_f6_pre[8][2];
+static int16_t opcode_timings_f6_mod3_pre[8][2];
+static int16_t opcode_timings_f7_pre[8][2];
+static int16_t opcode_timings_f7_mod3_pre[8][2];
+static int16_t opcode_timings_ff_pre[8][2];
+static int16_t opcode_timings_ff_mod3_pre[8][2];
+static int16_t opcode_timings_d8_pre[8][2];
+static int16_t opcode_timings_d8_mod3_pre[8][2];
+static int16_t opcode_timings_d9_pre[8][2];
+static int16_t opcode_timings_d9_mod3_pre[64][2];
+static int16_t opcode_timings_da_pre[8][2];
+static int16_t opcode_timings_da_mod3_pre[8][2];
+static int16_t opcode_timings_db_pre[8][2];
+static int16_t opcode_timings_db_mod3_pre[64][2];
+static int16_t opcode_timings_dc_pre[8][2];
+static int16_t opcode_timings_dc_mod3_pre[8][2];
+static int16_t opcode_timings_dd_pre[8][2];
+static int16_t opcode_timings_dd_mod3_pre[8][2];
+static int16_t opcode_timings_de_pre[8][2];
+static int16_t opcode_timings_de_mod3_pre[8][2];
+static int16_t opcode_timings_df_pre[8][2];
+static int16_t opcode_timings_df_mod3_pre[8][2];
+static int16_t opcode_timings_8x_pre[8][2];
+static int16_t opcode_timings_8x_mod3_pre[8][2];
+static int16_t opcode_timings_81_pre[8][2];
+static int16_t opcode_timings_81_mod3_pre[8][2];
+
+static const struct {
+    int **src;
+    int16_t (*dst)[2];
+    int nr;
+} timing_tables[] = {
+    // clang-format off
+    { opcode_timings,            opcode_timings_pre,            256 },
+    { opcode_timings_mod3,       opcode_timings_mod3_pre,       256 },
+    { opcode_timings_0f,         opcode_timings_0f_pre,         256 },
+    { opcode_timings_0f_mod3,    opcode_timings_0f_mod3_pre,    256 },
+    { opcode_timings_shift,      opcode_timings_shift_pre,      8   },
+    { opcode_timings_shift_mod3, opcode_timings_shift_mod3_pre, 8   },
+    { opcode_timings_f6,         opcode_timings_f6_pre,         8   },
+    { opcode_timings_f6_mod3,    opcode_timings_f6_mod3_pre,    8   },
+    { opcode_timings_f7,         opcode_timings_f7_pre,         8   },
+    { opcode_timings_f7_mod3,    opcode_timings_f7_mod3_pre,    8   },
+    { opcode_timings_ff,         opcode_timings_ff_pre,         8   },
+    { opcode_timings_ff_mod3,    opcode_timings_ff_mod3_pre,    8   },
+    { opcode_timings_d8,         opcode_timings_d8_pre,         8   },
+    { opcode_timings_d8_mod3,    opcode_timings_d8_mod3_pre,    8   },
+    { opcode_timings_d9,         opcode_timings_d9_pre,         8   },
+    { opcode_timings_d9_mod3,    opcode_timings_d9_mod3_pre,    64  },
+    { opcode_timings_da,         opcode_timings_da_pre,         8   },
+    { opcode_timings_da_mod3,    opcode_timings_da_mod3_pre,    8   },
+    { opcode_timings_db,         opcode_timings_db_pre,         8   },
+    { opcode_timings_db_mod3,    opcode_timings_db_mod3_pre,    64  },
+    { opcode_timings_dc,         opcode_timings_dc_pre,         8   },
+    { opcode_timings_dc_mod3,    opcode_timings_dc_mod3_pre,    8   },
+    { opcode_timings_dd,         opcode_timings_dd_pre,         8   },
+    { opcode_timings_dd_mod3,    opcode_timings_dd_mod3_pre,    8   },
+    { opcode_timings_de,         opcode_timings_de_pre,         8   },
+    { opcode_timings_de_mod3,    opcode_timings_de_mod3_pre,    8   },
+    { opcode_timings_df,         opcode_timings_df_pre,         8   },
+    { opcode_timings_df_mod3,    opcode_timings_df_mod3_pre,    8   },
+    { opcode_timings_8x,         opcode_timings_8x_pre,         8   },
+    { opcode_timings_8x_mod3,    opcode_timings_8x_mod3_pre,    8   },
+    { opcode_timings_81,         opcode_timings_81_pre,         8   },
+    { opcode_timings_81_mod3,    opcode_timings_81_mod3_pre,    8   }
+    // clang-format on
+};
+
+/*Values of the timing_* globals the flattened tables were built against.*/
+static int timing_snapshot[6] = { -1, -1, -1, -1, -1, -1 };
+
+static void
+codegen_timing_486_recalc(void)
+{
+    for (uint8_t t = 0; t < (sizeof(timing_tables) / sizeof(timing_tables[0])); t++) {
+        for (int i = 0; i < timing_tables[t].nr; i++) {
+            timing_tables[t].dst[i][0] = COUNT(timing_tables[t].src[i], 0);
+            timing_tables[t].dst[i][1] = COUNT(timing_tables[t].src[i], 0x100);
+        }
+    }
+
+    timing_snapshot[0] = timing_rr;
+    timing_snapshot[1] = timing_rm;
+    timing_snapshot[2] = timing_mr;
+    timing_snapshot[3] = timing_mm;
+    timing_snapshot[4] = timing_bnt;
+    timing_snapshot[5] = timing_int;
+}
+
 void
 codegen_timing_486_block_start(void)
 {
+    if ((timing_snapshot[0] != timing_rr) || (timing_snapshot[1] != timing_rm) || (timing_snapshot[2] != timing_mr) || (timing_snapshot[3] != timing_mm) || (timing_snapshot[4] != timing_bnt) || (timing_snapshot[5] != timing_int))
+        codegen_timing_486_recalc();
+
     regmask_modified = 0;
 }
 
@@ -329,61 +432,61 @@ codegen_timing_486_start(void)
 void
 codegen_timing_486_prefix(uint8_t prefix, uint32_t fetchdat)
 {
-    timing_count += COUNT(opcode_timings[prefix], 0);
+    timing_count += opcode_timings_pre[prefix][0];
     last_prefix = prefix;
 }
 
 void
 codegen_timing_486_opcode(uint8_t opcode, uint32_t fetchdat, int op_32, UNUSED(uint32_t op_pc))
 {
-    int           **timings;
+    int16_t(*timings)[2];
     const uint64_t *deps;
     int             mod3 = ((fetchdat & 0xc0) == 0xc0);
     int             bit8 = !(opcode & 1);
 
     switch (last_prefix) {
         case 0x0f:
-            timings = mod3 ? opcode_timings_0f_mod3 : opcode_timings_0f;
+            timings = mod3 ? opcode_timings_0f_mod3_pre : opcode_timings_0f_pre;
             deps    = mod3 ? opcode_deps_0f_mod3 : opcode_deps_0f;
             break;
 
         case 0xd8:
-            timings = mod3 ? opcode_timings_d8_mod3 : opcode_timings_d8;
+            timings = mod3 ? opcode_timings_d8_mod3_pre : opcode_timings_d8_pre;
             deps    = mod3 ? opcode_deps_d8_mod3 : opcode_deps_d8;
             opcode  = (opcode >> 3) & 7;
             break;
         case 0xd9:
-            timings = mod3 ? opcode_timings_d9_mod3 : opcode_timings_d9;
+            timings = mod3 ? opcode_timings_d9_mod3_pre : opcode_timings_d9_pre;
             deps    = mod3 ? opcode_deps_d9_mod3 : opcode_deps_d9;
             opcode  = mod3 ? opcode & 0x3f : (opcode >> 3) & 7;
             break;
         case 0xda:
-            timings = mod3 ? opcode_timings_da_mod3 : opcode_timings_da;
+            timings = mod3 ? opcode_timings_da_mod3_pre : opcode_timings_da_pre;
             deps    = mod3 ? opcode_deps_da_mod3 : opcode_deps_da;
             opcode  = (opcode >> 3) & 7;
             break;
         case 0xdb:
-            timings = mod3 ? opcode_timings_db_mod3 : opcode_timings_db;
+            timings = mod3 ? opcode_timings_db_mod3_pre : opcode_timings_db_pre;
             deps    = mod3 ? opcode_deps_db_mod3 : opcode_deps_db;
             opcode  = mod3 ? opcode & 0x3f : (opcode >> 3) & 7;
             break;
         case 0xdc:
-            timings = mod3 ? opcode_timings_dc_mod3 : opcode_timings_dc;
+            timings = mod3 ? opcode_timings_dc_mod3_pre : opcode_timings_dc_pre;
             deps    = mod3 ? opcode_deps_dc_mod3 : opcode_deps_dc;
             opcode  = (opcode >> 3) & 7;
             break;
         case 0xdd:
-            timings = mod3 ? opcode_timings_dd_mod3 : opcode_timings_dd;
+            timings = mod3 ? opcode_timings_dd_mod3_pre : opcode_timings_dd_pre;
             deps    = mod3 ? opcode_deps_dd_mod3 : opcode_deps_dd;
             opcode  = (opcode >> 3) & 7;
             break;
         case 0xde:
-            timings = mod3 ? opcode_timings_de_mod3 : opcode_timings_de;
+            timings = mod3 ? opcode_timings_de_mod3_pre : opcode_timings_de_pre;
             deps    = mod3 ? opcode_deps_de_mod3 : opcode_deps_de;
             opcode  = (opcode >> 3) & 7;
             break;
         case 0xdf:
-            timings = mod3 ? opcode_timings_df_mod3 : opcode_timings_df;
+            timings = mod3 ? opcode_timings_df_mod3_pre : opcode_timings_df_pre;
             deps    = mod3 ? opcode_deps_df_mod3 : opcode_deps_df;
             opcode  = (opcode >> 3) & 7;
             break;
@@ -393,12 +496,12 @@ codegen_timing_486_opcode(uint8_t opcode, uint32_t fetchdat, int op_32, UNUSED(u
                 case 0x80:
                 case 0x82:
                 case 0x83:
-                    timings = mod3 ? opcode_timings_8x_mod3 : opcode_timings_8x;
+                    timings = mod3 ? opcode_timings_8x_mod3_pre : opcode_timings_8x_pre;
                     deps    = mod3 ? opcode_deps_8x_mod3 : opcode_deps_8x;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
                 case 0x81:
-                    timings = mod3 ? opcode_timings_81_mod3 : opcode_timings_81;
+                    timings = mod3 ? opcode_timings_81_mod3_pre : opcode_timings_81_pre;
                     deps    = mod3 ? opcode_deps_81_mod3 : opcode_deps_81;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
@@ -409,35 +512,35 @@ codegen_timing_486_opcode(uint8_t opcode, uint32_t fetchdat, int op_32, UNUSED(u
                 case 0xd1:
                 case 0xd2:
                 case 0xd3:
-                    timings = mod3 ? opcode_timings_shift_mod3 : opcode_timings_shift;
+                    timings = mod3 ? opcode_timings_shift_mod3_pre : opcode_timings_shift_pre;
                     deps    = mod3 ? opcode_deps_shift_mod3 : opcode_deps_shift;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
 
                 case 0xf6:
-                    timings = mod3 ? opcode_timings_f6_mod3 : opcode_timings_f6;
+                    timings = mod3 ? opcode_timings_f6_mod3_pre : opcode_timings_f6_pre;
                     deps    = mod3 ? opcode_deps_f6_mod3 : opcode_deps_f6;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
                 case 0xf7:
-                    timings = mod3 ? opcode_timings_f7_mod3 : opcode_timings_f7;
+                    timings = mod3 ? opcode_timings_f7_mod3_pre : opcode_timings_f7_pre;
                     deps    = mod3 ? opcode_deps_f7_mod3 : opcode_deps_f7;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
                 case 0xff:
-                    timings = mod3 ? opcode_timings_ff_mod3 : opcode_timings_ff;
+                    timings = mod3 ? opcode_timings_ff_mod3_pre : opcode_timings_ff_pre;
                     deps    = mod3 ? opcode_deps_ff_mod3 : opcode_deps_ff;
                     opcode  = (fetchdat >> 3) & 7;
                     break;
 
                 default:
-                    timings = mod3 ? opcode_timings_mod3 : opcode_timings;
+                    timings = mod3 ? opcode_timings_mod3_pre : opcode_timings_pre;
                     deps    = mod3 ? opcode_deps_mod3 : opcode_deps;
                     break;
             }
     }
 
-    timing_count += COUNT(timings[opcode], op_32);
+    timing_count += timings[opcode][(op_32 & 0x100) ? 1 : 0];
     if (regmask_modified & get_addr_regmask(deps[opcode], fetchdat, op_32))
         timing_count++; /*AGI stall*/
     codegen_block_cycles += timing_count;
@@ -77,8 +77,14 @@ enum {
 #define CPUID_3DNOW  (1UL << 31UL)
 #define CPUID_3DNOWE (1UL << 30UL)
 
-/* Make sure this is as low as possible. */
-cpu_state_t cpu_state;
+/* Make sure this is as low as possible. Cache-line aligned so the hot
+   head - regs, EA state and the lazy flags in the first line, pc/cycles
+   in the second - never straddles a line boundary. */
+#ifdef _MSC_VER
+__declspec(align(64)) cpu_state_t cpu_state;
+#else
+cpu_state_t cpu_state __attribute__((aligned(64)));
+#endif
 fpu_state_t fpu_state;
 
 /* Place this immediately after. */
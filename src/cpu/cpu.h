@@ -416,6 +416,16 @@ typedef struct {
     uint16_t new_npxc;
 #endif
 
+    /* Everything above here must stay within the first 256 bytes: the
+       dynarec addresses it with signed 8-bit displacements off
+       &cpu_state + 128 (see cpu_state_offset()). The fields below are
+       outside that window and only ever addressed directly, so they are
+       ordered for the interpreter instead: flags/eflags and the CS/DS
+       descriptors the per-instruction privilege and limit checks touch
+       share the line right after the window. */
+    uint16_t flags;
+    uint16_t eflags;
+
     x86seg seg_cs;
     x86seg seg_ds;
     x86seg seg_es;
@@ -428,9 +438,6 @@ typedef struct {
         uint16_t w;
     } CR0;
 
-    uint16_t flags;
-    uint16_t eflags;
-
     uint32_t _smbase;
 } cpu_state_t;
 
@@ -584,6 +591,7 @@ extern uint32_t cpu_features;
 extern int smi_latched;
 extern int smm_in_hlt;
 extern int smi_block;
+extern int cpu_idle_hlt;
 
 #ifdef USE_NEW_DYNAREC
 extern uint16_t cpu_cur_status;
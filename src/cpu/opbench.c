@@ -0,0 +1,81 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Per-opcode microbenchmark. Enabled from the command line
+ *          (--opbench path), it times every instruction dispatched
+ *          through the interpreter loops and writes a CSV of host
+ *          cycles per guest instruction per opcode on shutdown, so a
+ *          change that regresses one opcode class shows up in a diff
+ *          of two runs instead of in a user report. Generated dynarec
+ *          code cannot be attributed per opcode, so run with the
+ *          dynamic recompiler disabled (or compare interpreter runs)
+ *          for meaningful results.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/plat.h>
+#include "opbench.h"
+
+int opbench_on = 0;
+
+uint64_t opbench_cycles[OPBENCH_NUM_OPS];
+uint64_t opbench_count[OPBENCH_NUM_OPS];
+
+static char opbench_path[1024];
+
+void
+opbench_start(const char *path)
+{
+    strncpy(opbench_path, path, sizeof(opbench_path) - 1);
+    memset(opbench_cycles, 0x00, sizeof(opbench_cycles));
+    memset(opbench_count, 0x00, sizeof(opbench_count));
+    opbench_on = 1;
+}
+
+void
+opbench_report(void)
+{
+    FILE *fp;
+
+    if (!opbench_on)
+        return;
+    opbench_on = 0;
+
+    fp = plat_fopen(opbench_path, "w");
+    if (fp == NULL) {
+        pclog("OPBENCH: unable to open \"%s\" for writing\n", opbench_path);
+        return;
+    }
+
+    fprintf(fp, "# cpu: %s\n", cpu_s->name);
+    fprintf(fp, "opcode,op32,count,host_cycles,host_cycles_per_insn\n");
+    for (int i = 0; i < OPBENCH_NUM_OPS; i++) {
+        if (opbench_count[i] == 0)
+            continue;
+        fprintf(fp, "%02X,%d,%" PRIu64 ",%" PRIu64 ",%.2f\n",
+                i & 0xff, (i >> 8) & 3, opbench_count[i], opbench_cycles[i],
+                (double) opbench_cycles[i] / (double) opbench_count[i]);
+    }
+    fclose(fp);
+
+    pclog("OPBENCH: report written to \"%s\"\n", opbench_path);
+}
@@ -0,0 +1,69 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the per-opcode microbenchmark.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_OPBENCH_H
+#define EMU_OPBENCH_H
+
+#ifdef _MSC_VER
+#    include <intrin.h>
+#elif defined(__amd64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The opcode table index space: 256 opcodes x 16-bit/32-bit operand size,
+   matching the (opcode | cpu_state.op32) & 0x3ff dispatch. */
+#define OPBENCH_NUM_OPS 0x400
+
+extern int opbench_on;
+
+extern uint64_t opbench_cycles[OPBENCH_NUM_OPS];
+extern uint64_t opbench_count[OPBENCH_NUM_OPS];
+
+extern void opbench_start(const char *path);
+extern void opbench_report(void);
+
+/* Cheapest available host timestamp; only deltas are ever used, so the
+   unit (TSC ticks, generic timer ticks) does not need to be known. */
+static __inline uint64_t
+opbench_ts(void)
+{
+#if defined(__amd64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    return plat_timer_read();
+#endif
+}
+
+static __inline void
+opbench_record(uint32_t op, uint64_t delta)
+{
+    opbench_cycles[op] += delta;
+    opbench_count[op]++;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_OPBENCH_H*/
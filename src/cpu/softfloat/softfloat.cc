@@ -34,6 +34,9 @@ these four paragraphs for those parts of this code that are retained.
  *            Stanislav Shwartsman [sshwarts at sourceforge net]
  * ==========================================================================*/
 
+#include <fenv.h>
+#include <math.h>
+
 #include "softfloat.h"
 #include "softfloat-round-pack.h"
 
@@ -3039,6 +3042,164 @@ floatx80 floatx80_round_to_int(floatx80 a, struct float_status_t *status)
     return z;
 }
 
+/*----------------------------------------------------------------------------
+| Host floating-point fast path for the common floatx80 arithmetic cases.
+| When the rounding precision is 53 bits and both operands are exactly
+| representable as double-precision values, add/sub/mul/div round identically
+| to a native double-precision operation for as long as the result stays in
+| double-precision range.  The helpers below detect that case, carry the
+| operation out in host arithmetic (honouring the rounding mode through
+| <fenv.h> and observing inexact/overflow/underflow through the host
+| exception flags), and reconstruct the C1 round-up indication from the
+| exact residual.  Anything the fast path cannot reproduce faithfully -
+| special operands, denormals, results leaving double-precision range -
+| falls back to the generic code below.
+*----------------------------------------------------------------------------*/
+
+enum {
+    floatx80_fast_add = 0,
+    floatx80_fast_sub = 1,
+    floatx80_fast_mul = 2,
+    floatx80_fast_div = 3
+};
+
+/*----------------------------------------------------------------------------
+| Converts the extended double-precision floating-point value `a' to a host
+| double, returning 0 if the value is not exactly representable in double-
+| precision format (including the NaN, infinity, denormal and unnormal
+| encodings, which all need the generic handling).
+*----------------------------------------------------------------------------*/
+
+static int floatx80_to_double_exact(floatx80 a, double *z)
+{
+    Bit64u aSig = extractFloatx80Frac(a);
+    Bit32s aExp = extractFloatx80Exp(a);
+    union { double f; Bit64u u; } u;
+
+    if (aExp == 0) {
+        if (aSig) return 0;     /* (pseudo-)denormal - must raise the denormal flag */
+        u.u = (Bit64u) extractFloatx80Sign(a) << 63;
+        *z = u.f;
+        return 1;
+    }
+    if ((aExp < (0x3FFF - 1022)) || (aExp > (0x3FFF + 1023)))
+        return 0;               /* outside double-precision exponent range */
+    if (!(aSig & BX_CONST64(0x8000000000000000)) || (aSig & 0x7FF))
+        return 0;               /* unnormal, or needs more than 53 significand bits */
+
+    u.u = ((Bit64u) extractFloatx80Sign(a) << 63)
+        | ((Bit64u) (aExp - 0x3FFF + 1023) << 52)
+        | ((aSig >> 11) & BX_CONST64(0x000FFFFFFFFFFFFF));
+    *z = u.f;
+    return 1;
+}
+
+/*----------------------------------------------------------------------------
+| Packs a finite host double into the extended double-precision format.  The
+| conversion is always exact; a subnormal double simply becomes a small
+| normal floatx80 value.
+*----------------------------------------------------------------------------*/
+
+static floatx80 double_to_floatx80(double a)
+{
+    union { double f; Bit64u u; } u;
+    u.f = a;
+    Bit64u aSig = u.u & BX_CONST64(0x000FFFFFFFFFFFFF);
+    Bit16s aExp = (u.u >> 52) & 0x7FF;
+    int aSign = (int) (u.u >> 63);
+
+    if (aExp == 0) {
+        if (aSig == 0) return packFloatx80(aSign, 0, 0);
+        normalizeFloat64Subnormal(aSig, &aExp, &aSig);
+    }
+    return packFloatx80(aSign, aExp + 0x3C00, (aSig | BX_CONST64(0x0010000000000000))<<11);
+}
+
+/*----------------------------------------------------------------------------
+| Attempts to perform the extended double-precision operation `op' on `a' and
+| `b' in host double-precision arithmetic.  Returns 1 and stores the result
+| through `z' if the host operation is exactly equivalent to the generic
+| implementation (result, exception flags and C1 indication included);
+| returns 0 if the caller must take the generic path instead.
+*----------------------------------------------------------------------------*/
+
+static int floatx80_fast_arith(floatx80 a, floatx80 b, int op, floatx80 *z, struct float_status_t *status)
+{
+    static const int host_rounding_modes[4] = { FE_TONEAREST, FE_DOWNWARD, FE_UPWARD, FE_TOWARDZERO };
+    double da, db, dz, bv, residual = 0;
+    int rounding_mode = get_float_rounding_mode(status);
+    int rounded_up = 0, flags;
+
+    if (get_float_rounding_precision(status) != 64)
+        return 0;
+    if (! floatx80_to_double_exact(a, &da) || ! floatx80_to_double_exact(b, &db))
+        return 0;
+    if (op == floatx80_fast_sub) {
+        db = -db;
+        op = floatx80_fast_add;
+    }
+
+    if (rounding_mode != float_round_nearest_even)
+        fesetround(host_rounding_modes[rounding_mode]);
+    feclearexcept(FE_ALL_EXCEPT);
+
+    switch (op) {
+        case floatx80_fast_add:
+            dz = da + db;
+            if (rounding_mode == float_round_nearest_even) {
+                /* 2Sum: exact in round-to-nearest */
+                bv = dz - da;
+                residual = (da - (dz - bv)) + (db - bv);
+            }
+            break;
+        case floatx80_fast_mul:
+            dz = da * db;
+            residual = fma(da, db, -dz);
+            break;
+        case floatx80_fast_div:
+        default:
+            dz = da / db;
+            /* a - z*b is exactly representable, so this residual is exact;
+               divide its sign by b's to get the sign of the true error */
+            residual = fma(-dz, db, da);
+            if (signbit(db))
+                residual = -residual;
+            break;
+    }
+
+    flags = fetestexcept(FE_ALL_EXCEPT);
+    if (rounding_mode != float_round_nearest_even)
+        fesetround(FE_TONEAREST);
+
+    /* The extended exponent range means the generic path neither overflows
+       nor underflows for these operands, and divide-by-zero and invalid have
+       operand-dependent results; leave all of those to the generic code. */
+    if (flags & ~FE_INEXACT)
+        return 0;
+
+    if (flags & FE_INEXACT) {
+        float_raise(status, float_flag_inexact);
+        switch (rounding_mode) {
+            case float_round_nearest_even:
+                rounded_up = (residual != 0) && (signbit(residual) != signbit(dz));
+                break;
+            case float_round_down:
+                rounded_up = signbit(dz);
+                break;
+            case float_round_up:
+                rounded_up = ! signbit(dz);
+                break;
+            default:    /* float_round_to_zero never rounds away */
+                break;
+        }
+        if (rounded_up)
+            set_float_rounding_up(status);
+    }
+
+    *z = double_to_floatx80(dz);
+    return 1;
+}
+
 /*----------------------------------------------------------------------------
 | Returns the result of adding the absolute values of the extended double-
 | precision floating-point values `a' and `b'.  If `zSign' is 1, the sum is
@@ -3231,6 +3392,10 @@ static floatx80 subFloatx80Sigs(floatx80 a, floatx80 b, int zSign, struct float_
 
 floatx80 floatx80_add(floatx80 a, floatx80 b, struct float_status_t *status)
 {
+    floatx80 z;
+    if (floatx80_fast_arith(a, b, floatx80_fast_add, &z, status))
+        return z;
+
     int aSign = extractFloatx80Sign(a);
     int bSign = extractFloatx80Sign(b);
 
@@ -3248,6 +3413,10 @@ floatx80 floatx80_add(floatx80 a, floatx80 b, struct float_status_t *status)
 
 floatx80 floatx80_sub(floatx80 a, floatx80 b, struct float_status_t *status)
 {
+    floatx80 z;
+    if (floatx80_fast_arith(a, b, floatx80_fast_sub, &z, status))
+        return z;
+
     int aSign = extractFloatx80Sign(a);
     int bSign = extractFloatx80Sign(b);
 
@@ -3270,6 +3439,10 @@ floatx80 floatx80_mul(floatx80 a, floatx80 b, struct float_status_t *status)
 *----------------------------------------------------------------------------*/
     const floatx80 floatx80_default_nan = packFloatx80(0, floatx80_default_nan_exp, floatx80_default_nan_fraction);
 
+    floatx80 z;
+    if (floatx80_fast_arith(a, b, floatx80_fast_mul, &z, status))
+        return z;
+
     int aSign, bSign, zSign;
     Bit32s aExp, bExp, zExp;
     Bit64u aSig, bSig, zSig0, zSig1;
@@ -3345,6 +3518,10 @@ floatx80 floatx80_div(floatx80 a, floatx80 b, struct float_status_t *status)
 *----------------------------------------------------------------------------*/
     const floatx80 floatx80_default_nan = packFloatx80(0, floatx80_default_nan_exp, floatx80_default_nan_fraction);
 
+    floatx80 z;
+    if (floatx80_fast_arith(a, b, floatx80_fast_div, &z, status))
+        return z;
+
     int aSign, bSign, zSign;
     Bit32s aExp, bExp, zExp;
     Bit64u aSig, bSig, zSig0, zSig1;
@@ -43,9 +43,7 @@ enum {
 
     FLAGS_DEC8,
     FLAGS_DEC16,
-    FLAGS_DEC32
-#ifdef USE_NEW_DYNAREC
-    ,
+    FLAGS_DEC32,
 
     FLAGS_ADC8,
     FLAGS_ADC16,
@@ -54,7 +52,6 @@ enum {
     FLAGS_SBC8,
     FLAGS_SBC16,
     FLAGS_SBC32
-#endif
 };
 
 static __inline int
@@ -85,14 +82,12 @@ ZF_SET(void)
         case FLAGS_DEC8:
         case FLAGS_DEC16:
         case FLAGS_DEC32:
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
         case FLAGS_ADC16:
         case FLAGS_ADC32:
         case FLAGS_SBC8:
         case FLAGS_SBC16:
         case FLAGS_SBC32:
-#endif
             return !cpu_state.flags_res;
 
 #ifdef USE_NEW_DYNAREC
@@ -128,10 +123,8 @@ NF_SET(void)
         case FLAGS_SAR8:
         case FLAGS_INC8:
         case FLAGS_DEC8:
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
         case FLAGS_SBC8:
-#endif
             return cpu_state.flags_res & 0x80;
 
         case FLAGS_ZN16:
@@ -142,10 +135,8 @@ NF_SET(void)
         case FLAGS_SAR16:
         case FLAGS_INC16:
         case FLAGS_DEC16:
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC16:
         case FLAGS_SBC16:
-#endif
             return cpu_state.flags_res & 0x8000;
 
         case FLAGS_ZN32:
@@ -156,10 +147,8 @@ NF_SET(void)
         case FLAGS_SAR32:
         case FLAGS_INC32:
         case FLAGS_DEC32:
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC32:
         case FLAGS_SBC32:
-#endif
             return cpu_state.flags_res & 0x80000000;
 
 #ifdef USE_NEW_DYNAREC
@@ -211,14 +200,12 @@ PF_SET(void)
         case FLAGS_DEC8:
         case FLAGS_DEC16:
         case FLAGS_DEC32:
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
         case FLAGS_ADC16:
         case FLAGS_ADC32:
         case FLAGS_SBC8:
         case FLAGS_SBC16:
         case FLAGS_SBC32:
-#endif
             return znptable8[cpu_state.flags_res & 0xff] & P_FLAG;
 
 #ifdef USE_NEW_DYNAREC
@@ -254,40 +241,28 @@ VF_SET(void)
         case FLAGS_SAR32:
             return 0;
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
-#endif
         case FLAGS_ADD8:
         case FLAGS_INC8:
             return !((cpu_state.flags_op1 ^ cpu_state.flags_op2) & 0x80) && ((cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x80);
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC16:
-#endif
         case FLAGS_ADD16:
         case FLAGS_INC16:
             return !((cpu_state.flags_op1 ^ cpu_state.flags_op2) & 0x8000) && ((cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x8000);
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC32:
-#endif
         case FLAGS_ADD32:
         case FLAGS_INC32:
             return !((cpu_state.flags_op1 ^ cpu_state.flags_op2) & 0x80000000) && ((cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x80000000);
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_SBC8:
-#endif
         case FLAGS_SUB8:
         case FLAGS_DEC8:
             return ((cpu_state.flags_op1 ^ cpu_state.flags_op2) & (cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x80);
-#ifdef USE_NEW_DYNAREC
         case FLAGS_SBC16:
-#endif
         case FLAGS_SUB16:
         case FLAGS_DEC16:
             return ((cpu_state.flags_op1 ^ cpu_state.flags_op2) & (cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x8000);
-#ifdef USE_NEW_DYNAREC
         case FLAGS_SBC32:
-#endif
         case FLAGS_SUB32:
         case FLAGS_DEC32:
             return ((cpu_state.flags_op1 ^ cpu_state.flags_op2) & (cpu_state.flags_op1 ^ cpu_state.flags_res) & 0x80000000);
@@ -361,14 +336,12 @@ AF_SET(void)
         case FLAGS_INC32:
             return ((cpu_state.flags_op1 & 0xF) + (cpu_state.flags_op2 & 0xF)) & 0x10;
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
             return ((cpu_state.flags_res & 0xf) < (cpu_state.flags_op1 & 0xf)) || ((cpu_state.flags_res & 0xf) == (cpu_state.flags_op1 & 0xf) && cpu_state.flags_op2 == 0xff);
         case FLAGS_ADC16:
             return ((cpu_state.flags_res & 0xf) < (cpu_state.flags_op1 & 0xf)) || ((cpu_state.flags_res & 0xf) == (cpu_state.flags_op1 & 0xf) && cpu_state.flags_op2 == 0xffff);
         case FLAGS_ADC32:
             return ((cpu_state.flags_res & 0xf) < (cpu_state.flags_op1 & 0xf)) || ((cpu_state.flags_res & 0xf) == (cpu_state.flags_op1 & 0xf) && cpu_state.flags_op2 == 0xffffffff);
-#endif
 
         case FLAGS_SUB8:
         case FLAGS_SUB16:
@@ -378,12 +351,12 @@ AF_SET(void)
         case FLAGS_DEC32:
             return ((cpu_state.flags_op1 & 0xF) - (cpu_state.flags_op2 & 0xF)) & 0x10;
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_SBC8:
         case FLAGS_SBC16:
         case FLAGS_SBC32:
             return ((cpu_state.flags_op1 & 0xf) < (cpu_state.flags_op2 & 0xf)) || ((cpu_state.flags_op1 & 0xf) == (cpu_state.flags_op2 & 0xf) && (cpu_state.flags_res & 0xf) != 0);
 
+#ifdef USE_NEW_DYNAREC
         case FLAGS_ROL8:
         case FLAGS_ROL16:
         case FLAGS_ROL32:
@@ -415,26 +388,22 @@ CF_SET(void)
         case FLAGS_ADD32:
             return (cpu_state.flags_res < cpu_state.flags_op1);
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_ADC8:
             return (cpu_state.flags_res < cpu_state.flags_op1) || (cpu_state.flags_res == cpu_state.flags_op1 && cpu_state.flags_op2 == 0xff);
         case FLAGS_ADC16:
             return (cpu_state.flags_res < cpu_state.flags_op1) || (cpu_state.flags_res == cpu_state.flags_op1 && cpu_state.flags_op2 == 0xffff);
         case FLAGS_ADC32:
             return (cpu_state.flags_res < cpu_state.flags_op1) || (cpu_state.flags_res == cpu_state.flags_op1 && cpu_state.flags_op2 == 0xffffffff);
-#endif
 
         case FLAGS_SUB8:
         case FLAGS_SUB16:
         case FLAGS_SUB32:
             return (cpu_state.flags_op1 < cpu_state.flags_op2);
 
-#ifdef USE_NEW_DYNAREC
         case FLAGS_SBC8:
         case FLAGS_SBC16:
         case FLAGS_SBC32:
             return (cpu_state.flags_op1 < cpu_state.flags_op2) || (cpu_state.flags_op1 == cpu_state.flags_op2 && cpu_state.flags_res != 0);
-#endif
 
         case FLAGS_SHL8:
             return ((cpu_state.flags_op1 << (cpu_state.flags_op2 - 1)) & 0x80) ? 1 : 0;
@@ -679,7 +648,6 @@ setsub32nc(uint32_t a, uint32_t b)
     cpu_state.flags_op  = FLAGS_DEC32;
 }
 
-#ifdef USE_NEW_DYNAREC
 static __inline void
 setadc8(uint8_t a, uint8_t b)
 {
@@ -729,97 +697,6 @@ setsbc32(uint32_t a, uint32_t b)
     cpu_state.flags_res = a - (b + tempc);
     cpu_state.flags_op  = FLAGS_SBC32;
 }
-#else
-static __inline void
-setadc8(uint8_t a, uint8_t b)
-{
-    uint16_t c         = (uint16_t) a + (uint16_t) b + tempc;
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= znptable8[c & 0xFF];
-    if (c & 0x100)
-        cpu_state.flags |= C_FLAG;
-    if (!((a ^ b) & 0x80) && ((a ^ c) & 0x80))
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) + (b & 0xF)) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-static __inline void
-setadc16(uint16_t a, uint16_t b)
-{
-    uint32_t c         = (uint32_t) a + (uint32_t) b + tempc;
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= znptable16[c & 0xFFFF];
-    if (c & 0x10000)
-        cpu_state.flags |= C_FLAG;
-    if (!((a ^ b) & 0x8000) && ((a ^ c) & 0x8000))
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) + (b & 0xF)) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-static __inline void
-setadc32(uint32_t a, uint32_t b)
-{
-    uint32_t c         = (uint32_t) a + (uint32_t) b + tempc;
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= ((c & 0x80000000) ? N_FLAG : ((!c) ? Z_FLAG : 0));
-    cpu_state.flags |= (znptable8[c & 0xFF] & P_FLAG);
-    if ((c < a) || (c == a && tempc))
-        cpu_state.flags |= C_FLAG;
-    if (!((a ^ b) & 0x80000000) && ((a ^ c) & 0x80000000))
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) + (b & 0xF) + tempc) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-
-static __inline void
-setsbc8(uint8_t a, uint8_t b)
-{
-    uint16_t c         = (uint16_t) a - (((uint16_t) b) + tempc);
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= znptable8[c & 0xFF];
-    if (c & 0x100)
-        cpu_state.flags |= C_FLAG;
-    if ((a ^ b) & (a ^ c) & 0x80)
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) - (b & 0xF)) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-static __inline void
-setsbc16(uint16_t a, uint16_t b)
-{
-    uint32_t c         = (uint32_t) a - (((uint32_t) b) + tempc);
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= (znptable16[c & 0xFFFF] & ~4);
-    cpu_state.flags |= (znptable8[c & 0xFF] & 4);
-    if (c & 0x10000)
-        cpu_state.flags |= C_FLAG;
-    if ((a ^ b) & (a ^ c) & 0x8000)
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) - (b & 0xF)) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-
-static __inline void
-setsbc32(uint32_t a, uint32_t b)
-{
-    uint32_t c         = (uint32_t) a - (((uint32_t) b) + tempc);
-    cpu_state.flags_op = FLAGS_UNKNOWN;
-    cpu_state.flags &= ~0x8D5;
-    cpu_state.flags |= ((c & 0x80000000) ? N_FLAG : ((!c) ? Z_FLAG : 0));
-    cpu_state.flags |= (znptable8[c & 0xFF] & P_FLAG);
-    if ((c > a) || (c == a && tempc))
-        cpu_state.flags |= C_FLAG;
-    if ((a ^ b) & (a ^ c) & 0x80000000)
-        cpu_state.flags |= V_FLAG;
-    if (((a & 0xF) - ((b & 0xF) + tempc)) & 0x10)
-        cpu_state.flags |= A_FLAG;
-}
-#endif
 
 extern void cpu_386_flags_extract(void);
 extern void cpu_386_flags_rebuild(void);
@@ -709,10 +709,12 @@ opHLT(uint32_t fetchdat)
     }
     if (smi_line)
         enter_smm_check(1);
-    else if (!((cpu_state.flags & I_FLAG) && pic.int_pending)) {
+    else if (!((cpu_state.flags & I_FLAG) && pic_irq_pending())) {
         CLOCK_CYCLES_ALWAYS(100);
-        if (!((cpu_state.flags & I_FLAG) && pic.int_pending))
+        if (!((cpu_state.flags & I_FLAG) && pic_irq_pending())) {
             cpu_state.pc--;
+            cpu_idle_hlt = 1;
+        }
     } else {
         CLOCK_CYCLES(5);
     }
@@ -1,3 +1,102 @@
+/*Bulk path for REP MOVS/STOS: when the run ahead resolves to contiguous RAM
+  through the lookup tables, it is executed as a single host copy/fill with
+  the cycles charged in one lump by the caller. The run is capped at the next
+  page boundary on either side, the segment limits, the 64k offset wrap on
+  16-bit address sizes, the count and the remaining cycle budget. Anything
+  else - MMIO, uncached pages, pages holding code, overlapping forward
+  copies, descending direction, single elements - stays on the per-element
+  loop, which also provides all fault behaviour: the bulk run never covers
+  a byte the per-element loop could fault on.*/
+static __inline uint32_t
+rep_movs_bulk(x86seg *seg, uint32_t src_off, uint32_t dst_off, uint32_t count, uint32_t elsize, int budget, int elem_cycles, int wrap16)
+{
+    uint32_t src = seg->base + src_off;
+    uint32_t dst = cpu_state.seg_es.base + dst_off;
+    uint64_t max;
+    int      budget_elems = (budget / elem_cycles) + 1;
+
+    if ((cpu_state.flags & D_FLAG) || (budget_elems < 2))
+        return 0;
+    if ((seg->base == 0xFFFFFFFF) || (readlookup2[src >> 12] == (uintptr_t) LOOKUP_INV) || (writelookup2[dst >> 12] == (uintptr_t) LOOKUP_INV))
+        return 0;
+    if ((src_off < seg->limit_low) || (src_off > seg->limit_high) || (dst_off < cpu_state.seg_es.limit_low) || (dst_off > cpu_state.seg_es.limit_high))
+        return 0;
+
+    max = (((uint64_t) (seg->limit_high - src_off)) + 1) / elsize;
+    if (count > max)
+        count = max;
+    max = (((uint64_t) (cpu_state.seg_es.limit_high - dst_off)) + 1) / elsize;
+    if (count > max)
+        count = max;
+    if (wrap16) {
+        max = (0x10000 - src_off) / elsize;
+        if (count > max)
+            count = max;
+        max = (0x10000 - dst_off) / elsize;
+        if (count > max)
+            count = max;
+    }
+    max = (0x1000 - (src & 0xfff)) / elsize;
+    if (count > max)
+        count = max;
+    max = (0x1000 - (dst & 0xfff)) / elsize;
+    if (count > max)
+        count = max;
+    if (count > (uint32_t) budget_elems)
+        count = budget_elems;
+    if (count < 2)
+        return 0;
+
+    /*A forward copy onto an overlapping, higher destination replicates the
+      source pattern element by element - leave that to the per-element loop.*/
+    if ((src < dst) && ((dst - src) < (count * elsize)))
+        return 0;
+
+    memmove((void *) (writelookup2[dst >> 12] + dst), (const void *) (readlookup2[src >> 12] + src), count * elsize);
+    return count;
+}
+
+static __inline uint32_t
+rep_stos_bulk(uint32_t dst_off, uint32_t count, uint32_t elsize, int budget, int elem_cycles, int wrap16, uint32_t val)
+{
+    uint32_t dst = cpu_state.seg_es.base + dst_off;
+    uint64_t max;
+    uint8_t *p;
+    int      budget_elems = (budget / elem_cycles) + 1;
+
+    if ((cpu_state.flags & D_FLAG) || (budget_elems < 2))
+        return 0;
+    if (writelookup2[dst >> 12] == (uintptr_t) LOOKUP_INV)
+        return 0;
+    if ((dst_off < cpu_state.seg_es.limit_low) || (dst_off > cpu_state.seg_es.limit_high))
+        return 0;
+
+    max = (((uint64_t) (cpu_state.seg_es.limit_high - dst_off)) + 1) / elsize;
+    if (count > max)
+        count = max;
+    if (wrap16) {
+        max = (0x10000 - dst_off) / elsize;
+        if (count > max)
+            count = max;
+    }
+    max = (0x1000 - (dst & 0xfff)) / elsize;
+    if (count > max)
+        count = max;
+    if (count > (uint32_t) budget_elems)
+        count = budget_elems;
+    if (count < 2)
+        return 0;
+
+    p = (uint8_t *) (writelookup2[dst >> 12] + dst);
+    if (elsize == 1)
+        memset(p, val, count);
+    else {
+        for (uint32_t c = 0; c < count; c++)
+            memcpy(&p[c * elsize], &val, elsize);
+    }
+    return count;
+}
+
 #define REP_OPS(size, CNT_REG, SRC_REG, DEST_REG)                                                                 \
     static int opREP_INSB_##size(uint32_t fetchdat)                                                               \
     {                                                                                                             \
@@ -223,8 +322,23 @@
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
         }                                                                                                         \
         while (CNT_REG > 0) {                                                                                     \
-            uint8_t temp;                                                                                         \
+            uint8_t  temp;                                                                                        \
+            uint32_t bulk;                                                                                        \
                                                                                                                   \
+            bulk = rep_movs_bulk(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 1,                                 \
+                                 cycles - cycles_end, is486 ? 3 : 4, sizeof(SRC_REG) == 2);                       \
+            if (bulk) {                                                                                           \
+                SRC_REG += bulk;                                                                                  \
+                DEST_REG += bulk;                                                                                 \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 3 : 4) * (int) bulk;                                                           \
+                reads += bulk;                                                                                    \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 3 : 4) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_READ_REP(cpu_state.ea_seg, SRC_REG, SRC_REG);                                                   \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG);                                               \
             high_page = 0;                                                                                        \
@@ -278,7 +392,22 @@
         }                                                                                                         \
         while (CNT_REG > 0) {                                                                                     \
             uint16_t temp;                                                                                        \
+            uint32_t bulk;                                                                                        \
                                                                                                                   \
+            bulk = rep_movs_bulk(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 2,                                 \
+                                 cycles - cycles_end, is486 ? 3 : 4, sizeof(SRC_REG) == 2);                       \
+            if (bulk) {                                                                                           \
+                SRC_REG += bulk * 2;                                                                              \
+                DEST_REG += bulk * 2;                                                                             \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 3 : 4) * (int) bulk;                                                           \
+                reads += bulk;                                                                                    \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 3 : 4) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_READ_REP(cpu_state.ea_seg, SRC_REG, SRC_REG + 1UL);                                             \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG + 1UL);                                         \
             high_page = 0;                                                                                        \
@@ -332,7 +461,22 @@
         }                                                                                                         \
         while (CNT_REG > 0) {                                                                                     \
             uint32_t temp;                                                                                        \
+            uint32_t bulk;                                                                                        \
                                                                                                                   \
+            bulk = rep_movs_bulk(cpu_state.ea_seg, SRC_REG, DEST_REG, CNT_REG, 4,                                 \
+                                 cycles - cycles_end, is486 ? 3 : 4, sizeof(SRC_REG) == 2);                       \
+            if (bulk) {                                                                                           \
+                SRC_REG += bulk * 4;                                                                              \
+                DEST_REG += bulk * 4;                                                                             \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 3 : 4) * (int) bulk;                                                           \
+                reads += bulk;                                                                                    \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 3 : 4) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_READ_REP(cpu_state.ea_seg, SRC_REG, SRC_REG + 3UL);                                             \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG + 3UL);                                         \
             high_page = 0;                                                                                        \
@@ -382,6 +526,18 @@
         if (CNT_REG > 0)                                                                                          \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
         while (CNT_REG > 0) {                                                                                     \
+            uint32_t bulk = rep_stos_bulk(DEST_REG, CNT_REG, 1, cycles - cycles_end,                              \
+                                          is486 ? 4 : 5, sizeof(DEST_REG) == 2, AL);                              \
+            if (bulk) {                                                                                           \
+                DEST_REG += bulk;                                                                                 \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 4 : 5) * (int) bulk;                                                           \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 4 : 5) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG);                                               \
             writememb(es, DEST_REG, AL);                                                                          \
             if (cpu_state.abrt)                                                                                   \
@@ -414,6 +570,18 @@
         if (CNT_REG > 0)                                                                                          \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
         while (CNT_REG > 0) {                                                                                     \
+            uint32_t bulk = rep_stos_bulk(DEST_REG, CNT_REG, 2, cycles - cycles_end,                              \
+                                          is486 ? 4 : 5, sizeof(DEST_REG) == 2, AX);                              \
+            if (bulk) {                                                                                           \
+                DEST_REG += bulk * 2;                                                                             \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 4 : 5) * (int) bulk;                                                           \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 4 : 5) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG + 1UL);                                         \
             writememw(es, DEST_REG, AX);                                                                          \
             if (cpu_state.abrt)                                                                                   \
@@ -446,6 +614,18 @@
         if (CNT_REG > 0)                                                                                          \
             SEG_CHECK_WRITE(&cpu_state.seg_es);                                                                   \
         while (CNT_REG > 0) {                                                                                     \
+            uint32_t bulk = rep_stos_bulk(DEST_REG, CNT_REG, 4, cycles - cycles_end,                              \
+                                          is486 ? 4 : 5, sizeof(DEST_REG) == 2, EAX);                             \
+            if (bulk) {                                                                                           \
+                DEST_REG += bulk * 4;                                                                             \
+                CNT_REG -= bulk;                                                                                  \
+                cycles -= (is486 ? 4 : 5) * (int) bulk;                                                           \
+                writes += bulk;                                                                                   \
+                total_cycles += (is486 ? 4 : 5) * (int) bulk;                                                     \
+                if (cycles < cycles_end)                                                                          \
+                    break;                                                                                        \
+                continue;                                                                                         \
+            }                                                                                                     \
             CHECK_WRITE_REP(&cpu_state.seg_es, DEST_REG, DEST_REG + 3UL);                                         \
             writememl(es, DEST_REG, EAX);                                                                         \
             if (cpu_state.abrt)                                                                                   \
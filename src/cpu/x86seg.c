@@ -30,6 +30,7 @@
 #include <86box/timer.h>
 #include <86box/machine.h>
 #include <86box/mem.h>
+#include <86box/memtrace.h>
 #include <86box/nvr.h>
 #include <86box/plat_fallthrough.h>
 #include <86box/plat_unused.h>
@@ -270,6 +271,24 @@ read_descriptor(uint32_t addr, uint16_t *segdat, uint32_t *segdat32, int overrid
         cpl_override = 0;
 }
 
+/*Small direct-mapped cache of data/stack segment descriptors, keyed by
+  selector index (including the table bit) and descriptor table base, and
+  validated against the write-watch generation (see mem_desc_watch_page()).
+  A hit skips the descriptor table walk and the accessed-bit write-back -
+  the cached copy always has the accessed bit already set - while all
+  privilege and type checks still run on the cached bytes, as they depend
+  on CPL and RPL as well. Far control transfers keep the full walk.*/
+#define DESC_CACHE_SIZE 64
+
+typedef struct desc_cache_t {
+    uint32_t key;
+    uint32_t tbl_base;
+    uint32_t gen;
+    uint16_t segdat[4];
+} desc_cache_t;
+
+static desc_cache_t desc_cache[DESC_CACHE_SIZE];
+
 #ifdef USE_NEW_DYNAREC
 int
 #else
@@ -285,6 +304,8 @@ loadseg(uint16_t seg, x86seg *s)
     uint32_t      addr;
     uint32_t     *segdat32 = (uint32_t *) segdat;
     int           dpl;
+    int           cached = 0;
+    desc_cache_t *cache;
     const x86seg *dt;
 
     if ((msw & 1) && !(cpu_state.eflags & VM_FLAG)) {
@@ -320,13 +341,19 @@ loadseg(uint16_t seg, x86seg *s)
 #endif
         }
         addr += dt->base;
-        read_descriptor(addr, segdat, segdat32, 1);
-        if (cpu_state.abrt)
+        cache = &desc_cache[(seg >> 3) & (DESC_CACHE_SIZE - 1)];
+        if ((cache->key == (uint32_t) (seg & 0xfffc)) && (cache->tbl_base == dt->base) && (cache->gen == mem_desc_watch_gen)) {
+            memcpy(segdat, cache->segdat, sizeof(cache->segdat));
+            cached = 1;
+        } else {
+            read_descriptor(addr, segdat, segdat32, 1);
+            if (cpu_state.abrt)
 #ifdef USE_NEW_DYNAREC
-            return 1;
+                return 1;
 #else
-            return;
+                return;
 #endif
+        }
         dpl = (segdat[2] >> 13) & 3;
         if (s == &cpu_state.seg_ss) {
             if (!(seg & 0xfffc)) {
@@ -432,9 +459,30 @@ loadseg(uint16_t seg, x86seg *s)
         s->seg = seg;
         do_seg_load(s, segdat);
 
-        cpl_override = 1;
-        writememw(0, addr + 4, segdat[2] | 0x100); /* Set accessed bit */
-        cpl_override = 0;
+        if (!cached) {
+            cpl_override = 1;
+            writememw(0, addr + 4, segdat[2] | 0x100); /* Set accessed bit */
+            cpl_override = 0;
+
+            /*Cache the descriptor and arm the write watch on its physical
+              page. Descriptors straddling a page boundary are not cached;
+              neither are tables outside of RAM, whose contents the page
+              write handlers would never see change.*/
+            if (!cpu_state.abrt && ((addr & 0xfff) <= 0xff8)) {
+                uint32_t desc_phys = get_phys_noabrt(addr);
+
+                if ((desc_phys != 0xffffffff) && mem_addr_is_ram(desc_phys & rammask)) {
+                    mem_desc_watch_page((desc_phys & rammask) >> 12);
+                    cache->key       = seg & 0xfffc;
+                    cache->tbl_base  = dt->base;
+                    cache->gen       = mem_desc_watch_gen;
+                    cache->segdat[0] = segdat[0];
+                    cache->segdat[1] = segdat[1];
+                    cache->segdat[2] = segdat[2] | 0x100;
+                    cache->segdat[3] = segdat[3];
+                }
+            }
+        }
         s->checked   = 0;
 #ifdef USE_DYNAREC
         if (s == &cpu_state.seg_ds)
@@ -2062,6 +2110,27 @@ pmodeiret(int is32)
         cpu_state.eflags = tempflags >> 16;
 }
 
+#ifndef OPS_286_386
+/* Return a host pointer covering TSS bytes [base + start, base + end] if the
+   span sits within a single page that has a valid fast lookup, NULL otherwise.
+   A valid lookup entry guarantees plain RAM with no code blocks, watchpoints
+   or pending snapshot copies on the page, so the register file can be moved
+   in bulk without going through the per-access helpers. */
+static uint8_t *
+tss_host_ptr(uint32_t base, uint32_t start, uint32_t end, int write)
+{
+    uint32_t  addr = base + start;
+    uintptr_t lookup;
+
+    if (memtrace_on || ((((base + end) ^ addr) & ~0xfffu) != 0))
+        return NULL;
+    lookup = write ? writelookup2[addr >> 12] : readlookup2[addr >> 12];
+    if (lookup == (uintptr_t) LOOKUP_INV)
+        return NULL;
+    return (uint8_t *) (lookup + addr);
+}
+#endif
+
 void
 #ifdef OPS_286_386
 taskswitch286_2386(uint16_t seg, uint16_t *segdat, int is32)
@@ -2096,6 +2165,9 @@ taskswitch286(uint16_t seg, uint16_t *segdat, int is32)
     uint32_t      addr;
     uint32_t     *segdat232 = (uint32_t *) segdat2;
     const x86seg *dt;
+#ifndef OPS_286_386
+    uint8_t      *tss_ptr;
+#endif
 
     base  = segdat[1] | ((segdat[2] & 0x00ff) << 16);
     limit = segdat[0];
@@ -2130,25 +2202,39 @@ taskswitch286(uint16_t seg, uint16_t *segdat, int is32)
             cpu_state.flags &= ~NT_FLAG;
 
         cpu_386_flags_rebuild();
-        writememl(tr.base, 0x1C, cr3);
-        writememl(tr.base, 0x20, cpu_state.pc);
-        writememl(tr.base, 0x24, cpu_state.flags | (cpu_state.eflags << 16));
-
-        writememl(tr.base, 0x28, EAX);
-        writememl(tr.base, 0x2C, ECX);
-        writememl(tr.base, 0x30, EDX);
-        writememl(tr.base, 0x34, EBX);
-        writememl(tr.base, 0x38, ESP);
-        writememl(tr.base, 0x3C, EBP);
-        writememl(tr.base, 0x40, ESI);
-        writememl(tr.base, 0x44, EDI);
-
-        writememl(tr.base, 0x48, ES);
-        writememl(tr.base, 0x4C, CS);
-        writememl(tr.base, 0x50, SS);
-        writememl(tr.base, 0x54, DS);
-        writememl(tr.base, 0x58, FS);
-        writememl(tr.base, 0x5C, GS);
+#ifndef OPS_286_386
+        tss_ptr = tss_host_ptr(tr.base, 0x1C, 0x5F, 1);
+        if (tss_ptr != NULL) {
+            uint32_t tss_buf[17] = { cr3, cpu_state.pc,
+                                     cpu_state.flags | (cpu_state.eflags << 16),
+                                     EAX, ECX, EDX, EBX, ESP, EBP, ESI, EDI,
+                                     ES, CS, SS, DS, FS, GS };
+
+            memcpy(tss_ptr, tss_buf, sizeof(tss_buf));
+        } else {
+#endif
+            writememl(tr.base, 0x1C, cr3);
+            writememl(tr.base, 0x20, cpu_state.pc);
+            writememl(tr.base, 0x24, cpu_state.flags | (cpu_state.eflags << 16));
+
+            writememl(tr.base, 0x28, EAX);
+            writememl(tr.base, 0x2C, ECX);
+            writememl(tr.base, 0x30, EDX);
+            writememl(tr.base, 0x34, EBX);
+            writememl(tr.base, 0x38, ESP);
+            writememl(tr.base, 0x3C, EBP);
+            writememl(tr.base, 0x40, ESI);
+            writememl(tr.base, 0x44, EDI);
+
+            writememl(tr.base, 0x48, ES);
+            writememl(tr.base, 0x4C, CS);
+            writememl(tr.base, 0x50, SS);
+            writememl(tr.base, 0x54, DS);
+            writememl(tr.base, 0x58, FS);
+            writememl(tr.base, 0x5C, GS);
+#ifndef OPS_286_386
+        }
+#endif
 
         if ((optype == JMP) || (optype == IRET)) {
             if (tr.seg & 0x0004)
@@ -2172,30 +2258,59 @@ taskswitch286(uint16_t seg, uint16_t *segdat, int is32)
                 return;
         }
 
-        new_cr3   = readmeml(base, 0x1C);
-        new_pc    = readmeml(base, 0x20);
-        new_flags = readmeml(base, 0x24);
+#ifndef OPS_286_386
+        tss_ptr = tss_host_ptr(base, 0x1C, 0x64, 0);
+        if (tss_ptr != NULL) {
+            new_cr3   = *(uint32_t *) &tss_ptr[0x00];
+            new_pc    = *(uint32_t *) &tss_ptr[0x04];
+            new_flags = *(uint32_t *) &tss_ptr[0x08];
+
+            new_eax = *(uint32_t *) &tss_ptr[0x0C];
+            new_ecx = *(uint32_t *) &tss_ptr[0x10];
+            new_edx = *(uint32_t *) &tss_ptr[0x14];
+            new_ebx = *(uint32_t *) &tss_ptr[0x18];
+            new_esp = *(uint32_t *) &tss_ptr[0x1C];
+            new_ebp = *(uint32_t *) &tss_ptr[0x20];
+            new_esi = *(uint32_t *) &tss_ptr[0x24];
+            new_edi = *(uint32_t *) &tss_ptr[0x28];
+
+            new_es  = *(uint16_t *) &tss_ptr[0x2C];
+            new_cs  = *(uint16_t *) &tss_ptr[0x30];
+            new_ss  = *(uint16_t *) &tss_ptr[0x34];
+            new_ds  = *(uint16_t *) &tss_ptr[0x38];
+            new_fs  = *(uint16_t *) &tss_ptr[0x3C];
+            new_gs  = *(uint16_t *) &tss_ptr[0x40];
+            new_ldt = *(uint16_t *) &tss_ptr[0x44];
+            t_bit   = tss_ptr[0x48] & 1;
+        } else {
+#endif
+            new_cr3   = readmeml(base, 0x1C);
+            new_pc    = readmeml(base, 0x20);
+            new_flags = readmeml(base, 0x24);
+
+            new_eax = readmeml(base, 0x28);
+            new_ecx = readmeml(base, 0x2C);
+            new_edx = readmeml(base, 0x30);
+            new_ebx = readmeml(base, 0x34);
+            new_esp = readmeml(base, 0x38);
+            new_ebp = readmeml(base, 0x3C);
+            new_esi = readmeml(base, 0x40);
+            new_edi = readmeml(base, 0x44);
+
+            new_es  = readmemw(base, 0x48);
+            new_cs  = readmemw(base, 0x4C);
+            new_ss  = readmemw(base, 0x50);
+            new_ds  = readmemw(base, 0x54);
+            new_fs  = readmemw(base, 0x58);
+            new_gs  = readmemw(base, 0x5C);
+            new_ldt = readmemw(base, 0x60);
+            t_bit   = readmemb(base, 0x64) & 1;
+#ifndef OPS_286_386
+        }
+#endif
         if ((optype == OPTYPE_INT) || (optype == CALL))
             new_flags |= NT_FLAG;
 
-        new_eax = readmeml(base, 0x28);
-        new_ecx = readmeml(base, 0x2C);
-        new_edx = readmeml(base, 0x30);
-        new_ebx = readmeml(base, 0x34);
-        new_esp = readmeml(base, 0x38);
-        new_ebp = readmeml(base, 0x3C);
-        new_esi = readmeml(base, 0x40);
-        new_edi = readmeml(base, 0x44);
-
-        new_es  = readmemw(base, 0x48);
-        new_cs  = readmemw(base, 0x4C);
-        new_ss  = readmemw(base, 0x50);
-        new_ds  = readmemw(base, 0x54);
-        new_fs  = readmemw(base, 0x58);
-        new_gs  = readmemw(base, 0x5C);
-        new_ldt = readmemw(base, 0x60);
-        t_bit   = readmemb(base, 0x64) & 1;
-
         cr0 |= 8;
 
         cr3 = new_cr3;
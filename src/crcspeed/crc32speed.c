@@ -0,0 +1,182 @@
+/* Copyright (c) 2014, Matt Stancliff <matt@genges.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Redis nor the names of its contributors may be used
+ *     to endorse or promote products derived from this software without
+ *     specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE. */
+
+/* CRC-32 companion to crc64speed.c, added for 86Box: same slice-by-8
+ * framework, instantiated with the AUTODIN II / Ethernet FCS polynomial
+ * (0x04c11db7, reflected form 0xedb88320). Unlike the CRC-64 flavor the
+ * crc argument is carried in the reflected domain throughout, so calls
+ * chain naturally: start with 0xffffffff for an Ethernet FCS. */
+
+#include "crc32speed.h"
+
+/* If CRC32SPEED_DUAL is defined, we allow calls to
+ * both _little and _big CRC.
+ * By default, we only allow one endianness to be used
+ * and the first call to either _init function will set the
+ * lookup table endianness for the life of this module.
+ * We don't enable dual lookups by default because
+ * each 8x256 lookup table is 8k. */
+#ifndef CRC32SPEED_DUAL
+static uint32_t crc32_table[8][256] = {{0}};
+static void *crc32_table_little = NULL;
+static void *crc32_table_big = NULL;
+static const bool dual = false;
+#else
+static uint32_t crc32_table_little[8][256] = {{0}};
+static uint32_t crc32_table_big[8][256] = {{0}};
+static void *crc32_table = NULL;
+static const bool dual = true;
+#endif
+
+/* value of crc32_table[0][1], architecture dependent. */
+#define LITTLE1 UINT32_C(0x77073096)
+#define BIG1 UINT32_C(0x96300777)
+
+/* Define CRC32SPEED_SAFE if you want runtime checks to stop
+ * CRCs from being calculated by uninitialized tables (and also stop tables
+ * from being initialized more than once). */
+#ifdef CRC32SPEED_SAFE
+#define should_init(table, val)                                                \
+    do {                                                                       \
+        if ((table)[0][1] == (val))                                            \
+            return false;                                                      \
+    } while (0)
+#define check_init(table, val)                                                 \
+    do {                                                                       \
+        if ((table)[0][1] != (val))                                            \
+            return false;                                                      \
+    } while (0)
+#else
+#define should_init(a, b)
+#define check_init(a, b)
+#endif
+
+#define POLY UINT32_C(0xedb88320)
+
+/**
+ *  Update the crc value with new data, bit by bit in the reflected domain.
+ *
+ * \param crc      The current crc value.
+ * \param data     Pointer to a buffer of \a data_len bytes.
+ * \param data_len Number of bytes in the \a data buffer.
+ * \return         The updated crc value.
+ ******************************************************************************/
+uint32_t crc32(uint32_t crc, const void *in_data, const uint64_t len) {
+    const uint8_t *data = (uint8_t *) in_data;
+
+    for (uint64_t offset = 0; offset < len; offset++) {
+        crc ^= data[offset];
+        for (uint_fast8_t i = 0; i < 8; i++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ POLY) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+/* Only for testing; doesn't support DUAL */
+uint32_t crc32_lookup(uint32_t crc, const void *in_data, const uint64_t len) {
+    const uint8_t *data = (uint8_t *) in_data;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc32_table[0][(uint8_t)crc ^ data[i]] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+/* Returns false if CRC32SPEED_SAFE and table already initialized. */
+bool crc32speed_init(void) {
+#ifndef CRC32SPEED_DUAL
+    should_init(crc32_table, LITTLE1);
+#else
+    should_init(crc32_table_little, LITTLE1);
+#endif
+    crcspeed32little_init(crc32, dual ? (uint32_t (*)[256]) crc32_table_little : crc32_table);
+    return true;
+}
+
+/* Returns false if CRC32SPEED_SAFE and table already initialized. */
+bool crc32speed_init_big(void) {
+#ifndef CRC32SPEED_DUAL
+    should_init(crc32_table, BIG1);
+#else
+    should_init(crc32_table_big, BIG1);
+#endif
+    crcspeed32big_init(crc32, dual ? (uint32_t (*)[256]) crc32_table_big : crc32_table);
+    return true;
+}
+
+uint32_t crc32speed(uint32_t crc, const void *s, const uint64_t l) {
+/* Quickly check if CRC table is initialized to little endian correctly. */
+#ifndef CRC32SPEED_DUAL
+    check_init(crc32_table, LITTLE1);
+#else
+    check_init(crc32_table_little, LITTLE1);
+#endif
+    return crcspeed32little(dual ? (uint32_t (*)[256]) crc32_table_little : crc32_table, crc,
+                            (void *)s, l);
+}
+
+uint32_t crc32speed_big(uint32_t crc, const void *s, const uint64_t l) {
+/* Quickly check if CRC table is initialized to big endian correctly. */
+#ifndef CRC32SPEED_DUAL
+    check_init(crc32_table, BIG1);
+#else
+    check_init(crc32_table_big, BIG1);
+#endif
+    return crcspeed32big(dual ? (uint32_t (*)[256]) crc32_table_big : crc32_table, crc, (void *)s,
+                         l);
+}
+
+bool crc32speed_init_native(void) {
+    const uint64_t n = 1;
+    return *(char *)&n ? crc32speed_init() : crc32speed_init_big();
+}
+
+/* Iterate over table to fully load it into a cache near the CPU. */
+void crc32speed_cache_table(void) {
+    uint32_t m;
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 256; ++j) {
+#ifndef CRC32SPEED_DUAL
+            m = crc32_table[i][j];
+#else
+            m = crc32_table_little[i][j];
+            m += crc32_table_big[i][j];
+#endif
+            ++m;
+        }
+    }
+}
+
+/* If you are on a platform where endianness can change at runtime, this
+ * will break unless you compile with CRC32SPEED_DUAL and manually run
+ * _init() and _init_big() instead of using _init_native() */
+uint32_t crc32speed_native(uint32_t crc, const void *s, const uint64_t l) {
+    const uint64_t n = 1;
+    return *(char *)&n ? crc32speed(crc, s, l) : crc32speed_big(crc, s, l);
+}
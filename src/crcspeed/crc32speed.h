@@ -0,0 +1,24 @@
+#ifndef CRC32SPEED_H
+#define CRC32SPEED_H
+#include "crcspeed.h"
+#include "stdbool.h"
+
+/* CRC-32 (AUTODIN II / Ethernet FCS polynomial, reflected). The crc
+ * argument carries the running value directly: pass 0xffffffff to start
+ * a standard Ethernet FCS and use the result without a final inversion. */
+
+/* Does not require init */
+uint32_t crc32(uint32_t crc, const void *data, const uint64_t len);
+void crc32speed_cache_table(void);
+
+/* All other crc functions here require _init() before usage. */
+bool crc32speed_init(void);
+uint32_t crc32_lookup(uint32_t crc, const void *in_data, const uint64_t len);
+uint32_t crc32speed(uint32_t crc, const void *s, const uint64_t l);
+
+bool crc32speed_init_big(void);
+uint32_t crc32speed_big(uint32_t crc, const void *s, const uint64_t l);
+
+bool crc32speed_init_native(void);
+uint32_t crc32speed_native(uint32_t crc, const void *s, const uint64_t l);
+#endif
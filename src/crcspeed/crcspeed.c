@@ -48,6 +48,24 @@ void crcspeed64little_init(crcfn64 crcfn, uint64_t table[8][256]) {
     }
 }
 
+void crcspeed32little_init(crcfn32 crcfn, uint32_t table[8][256]) {
+    uint32_t crc;
+
+    /* generate CRCs for all single byte sequences */
+    for (int n = 0; n < 256; n++) {
+        table[0][n] = crcfn(0, &n, 1);
+    }
+
+    /* generate nested CRC table for future slice-by-8 lookup */
+    for (int n = 0; n < 256; n++) {
+        crc = table[0][n];
+        for (int k = 1; k < 8; k++) {
+            crc = table[0][crc & 0xff] ^ (crc >> 8);
+            table[k][n] = crc;
+        }
+    }
+}
+
 void crcspeed16little_init(crcfn16 crcfn, uint16_t table[8][256]) {
     uint16_t crc;
 
@@ -93,6 +111,26 @@ void crcspeed64big_init(crcfn64 fn, uint64_t big_table[8][256]) {
     }
 }
 
+/* Reverse the bytes in a 32-bit word. */
+static inline uint32_t rev4(uint32_t a) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(a);
+#else
+    a = ((a >> 8) & 0x00ff00ff) | ((a & 0x00ff00ff) << 8);
+    return a >> 16 | a << 16;
+#endif
+}
+
+void crcspeed32big_init(crcfn32 fn, uint32_t big_table[8][256]) {
+    /* Create the little endian table then reverse all the entires. */
+    crcspeed32little_init(fn, big_table);
+    for (int k = 0; k < 8; k++) {
+        for (int n = 0; n < 256; n++) {
+            big_table[k][n] = rev4(big_table[k][n]);
+        }
+    }
+}
+
 void crcspeed16big_init(crcfn16 fn, uint16_t big_table[8][256]) {
     /* Create the little endian table then reverse all the entires. */
     crcspeed16little_init(fn, big_table);
@@ -142,6 +180,44 @@ uint64_t crcspeed64little(uint64_t little_table[8][256], uint64_t crc,
     return crc;
 }
 
+/* 32 bit crc = process 8 bytes at once, the first four folded through the
+ * running crc and the last four through the lower half of the table. */
+uint32_t crcspeed32little(uint32_t little_table[8][256], uint32_t crc,
+                          void *buf, size_t len) {
+    unsigned char *next = buf;
+
+    /* process individual bytes until we reach an 8-byte aligned pointer */
+    while (len && ((uintptr_t)next & 7) != 0) {
+        crc = little_table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+
+    /* fast middle processing, 8 bytes (aligned!) per loop */
+    while (len >= 8) {
+        uint64_t n = *(uint64_t *)next;
+        uint32_t lo = (uint32_t)n ^ crc;
+        uint32_t hi = (uint32_t)(n >> 32);
+        crc = little_table[7][lo & 0xff] ^
+              little_table[6][(lo >> 8) & 0xff] ^
+              little_table[5][(lo >> 16) & 0xff] ^
+              little_table[4][lo >> 24] ^
+              little_table[3][hi & 0xff] ^
+              little_table[2][(hi >> 8) & 0xff] ^
+              little_table[1][(hi >> 16) & 0xff] ^
+              little_table[0][hi >> 24];
+        next += 8;
+        len -= 8;
+    }
+
+    /* process remaining bytes (can't be larger than 8) */
+    while (len) {
+        crc = little_table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+
+    return crc;
+}
+
 uint16_t crcspeed16little(uint16_t little_table[8][256], uint16_t crc,
                           void *buf, size_t len) {
     unsigned char *next = buf;
@@ -211,6 +287,41 @@ uint64_t crcspeed64big(uint64_t big_table[8][256], uint64_t crc, void *buf,
     return rev8(crc);
 }
 
+/* WARNING: Completely untested on big endian architecture.  Possibly broken. */
+uint32_t crcspeed32big(uint32_t big_table[8][256], uint32_t crc, void *buf,
+                       size_t len) {
+    unsigned char *next = buf;
+
+    crc = rev4(crc);
+    while (len && ((uintptr_t)next & 7) != 0) {
+        crc = big_table[0][(crc >> 24) ^ *next++] ^ (crc << 8);
+        len--;
+    }
+
+    while (len >= 8) {
+        uint64_t n = *(uint64_t *)next;
+        uint32_t hi = (uint32_t)(n >> 32) ^ crc;
+        uint32_t lo = (uint32_t)n;
+        crc = big_table[7][hi >> 24] ^
+              big_table[6][(hi >> 16) & 0xff] ^
+              big_table[5][(hi >> 8) & 0xff] ^
+              big_table[4][hi & 0xff] ^
+              big_table[3][lo >> 24] ^
+              big_table[2][(lo >> 16) & 0xff] ^
+              big_table[1][(lo >> 8) & 0xff] ^
+              big_table[0][lo & 0xff];
+        next += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc = big_table[0][(crc >> 24) ^ *next++] ^ (crc << 8);
+        len--;
+    }
+
+    return rev4(crc);
+}
+
 /* WARNING: Completely untested on big endian architecture.  Possibly broken. */
 uint16_t crcspeed16big(uint16_t big_table[8][256], uint16_t crc_in, void *buf,
                        size_t len) {
@@ -257,6 +368,14 @@ uint64_t crcspeed64native(uint64_t table[8][256], uint64_t crc, void *buf,
                        : crcspeed64big(table, crc, buf, len);
 }
 
+uint32_t crcspeed32native(uint32_t table[8][256], uint32_t crc, void *buf,
+                          size_t len) {
+    uint64_t n = 1;
+
+    return *(char *)&n ? crcspeed32little(table, crc, buf, len)
+                       : crcspeed32big(table, crc, buf, len);
+}
+
 uint16_t crcspeed16native(uint16_t table[8][256], uint16_t crc, void *buf,
                           size_t len) {
     uint64_t n = 1;
@@ -273,6 +392,13 @@ void crcspeed64native_init(crcfn64 fn, uint64_t table[8][256]) {
                 : crcspeed64big_init(fn, table);
 }
 
+void crcspeed32native_init(crcfn32 fn, uint32_t table[8][256]) {
+    uint64_t n = 1;
+
+    *(char *)&n ? crcspeed32little_init(fn, table)
+                : crcspeed32big_init(fn, table);
+}
+
 void crcspeed16native_init(crcfn16 fn, uint16_t table[8][256]) {
     uint64_t n = 1;
 
@@ -32,6 +32,7 @@
 #include <stdio.h>
 
 typedef uint64_t (*crcfn64)(uint64_t, const void *, const uint64_t);
+typedef uint32_t (*crcfn32)(uint32_t, const void *, const uint64_t);
 typedef uint16_t (*crcfn16)(uint16_t, const void *, const uint64_t);
 
 /* CRC-64 */
@@ -46,6 +47,18 @@ uint64_t crcspeed64big(uint64_t table[8][256], uint64_t crc, void *buf,
 uint64_t crcspeed64native(uint64_t table[8][256], uint64_t crc, void *buf,
                           size_t len);
 
+/* CRC-32 */
+void crcspeed32little_init(crcfn32 fn, uint32_t table[8][256]);
+void crcspeed32big_init(crcfn32 fn, uint32_t table[8][256]);
+void crcspeed32native_init(crcfn32 fn, uint32_t table[8][256]);
+
+uint32_t crcspeed32little(uint32_t table[8][256], uint32_t crc, void *buf,
+                          size_t len);
+uint32_t crcspeed32big(uint32_t table[8][256], uint32_t crc, void *buf,
+                       size_t len);
+uint32_t crcspeed32native(uint32_t table[8][256], uint32_t crc, void *buf,
+                          size_t len);
+
 /* CRC-16 */
 void crcspeed16little_init(crcfn16 fn, uint16_t table[8][256]);
 void crcspeed16big_init(crcfn16 fn, uint16_t table[8][256]);
@@ -58,6 +58,63 @@
 
 #define DEVICE_MAX 256 /* max # of devices */
 
+/* Machine-lifetime arena. Device init used to scatter hundreds of small
+   structs across the heap; the per-tick poll chains (PIT, serial, input
+   polls) walk those structs every dispatch, so keep them contiguous in
+   init order instead. Chunks are calloc'd, bump-allocated, and released
+   wholesale at the end of device_close_all() - converted devices drop the
+   free(priv) from their close callbacks. */
+#define DEVICE_ARENA_CHUNK_SZ (256 * 1024)
+#define DEVICE_ARENA_ALIGN    16
+
+typedef struct device_arena_chunk_t {
+    struct device_arena_chunk_t *next;
+    size_t                       used;
+    size_t                       size;
+    uint8_t                      data[];
+} device_arena_chunk_t;
+
+static device_arena_chunk_t *device_arena = NULL;
+
+void *
+device_calloc(size_t nmemb, size_t size)
+{
+    device_arena_chunk_t *chunk = device_arena;
+    size_t                sz    = nmemb * size;
+    void                 *ptr;
+
+    sz = (sz + DEVICE_ARENA_ALIGN - 1) & ~((size_t) (DEVICE_ARENA_ALIGN - 1));
+
+    if ((chunk == NULL) || ((chunk->size - chunk->used) < sz)) {
+        size_t chunk_sz = (sz > DEVICE_ARENA_CHUNK_SZ) ? sz : DEVICE_ARENA_CHUNK_SZ;
+
+        chunk = (device_arena_chunk_t *) calloc(1, sizeof(device_arena_chunk_t) + chunk_sz);
+        if (chunk == NULL)
+            fatal("device_calloc(): Out of memory\n");
+        chunk->size  = chunk_sz;
+        chunk->next  = device_arena;
+        device_arena = chunk;
+    }
+
+    /* Chunks come zeroed from calloc and are never reused after the
+       wholesale free, so every allocation starts out cleared. */
+    ptr = &chunk->data[chunk->used];
+    chunk->used += sz;
+
+    return ptr;
+}
+
+static void
+device_arena_close(void)
+{
+    while (device_arena != NULL) {
+        device_arena_chunk_t *next = device_arena->next;
+
+        free(device_arena);
+        device_arena = next;
+    }
+}
+
 static device_t        *devices[DEVICE_MAX];
 static void            *device_priv[DEVICE_MAX];
 static device_context_t device_current;
@@ -88,6 +145,77 @@ device_init(void)
     memset(devices, 0x00, sizeof(devices));
 }
 
+static uint32_t
+device_config_hash(const char *s)
+{
+    /* FNV-1a. */
+    uint32_t h = 0x811c9dc5;
+
+    while (*s) {
+        h ^= (uint8_t) *s++;
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+static void
+device_config_index(device_context_t *c)
+{
+    c->config_hashed = 1;
+
+    for (const device_config_t *e = c->dev ? c->dev->config : NULL; e && (e->type != -1); e++) {
+        uint32_t h = device_config_hash(e->name) & (DEVICE_CONFIG_HASH_SIZE - 1);
+        int      i;
+
+        for (i = 0; i < DEVICE_CONFIG_HASH_SIZE; i++) {
+            if (!c->config_hash[h])
+                break;
+            h = (h + 1) & (DEVICE_CONFIG_HASH_SIZE - 1);
+        }
+
+        if (i == DEVICE_CONFIG_HASH_SIZE) {
+            /* Table full; leave lookups on the linear walk. */
+            c->config_hashed = 0;
+            return;
+        }
+
+        c->config_hash[h] = e;
+    }
+}
+
+/* Resolve a config entry by name through the context's hash index, falling
+   back to the linear walk when the index could not be built. */
+static const device_config_t *
+device_find_config(const char *s)
+{
+    const device_config_t *e = device_current.dev->config;
+
+    if (device_current.config_hashed) {
+        uint32_t h = device_config_hash(s) & (DEVICE_CONFIG_HASH_SIZE - 1);
+
+        for (int i = 0; i < DEVICE_CONFIG_HASH_SIZE; i++) {
+            e = device_current.config_hash[h];
+            if (!e)
+                return NULL;
+            if (!strcmp(s, e->name))
+                return e;
+            h = (h + 1) & (DEVICE_CONFIG_HASH_SIZE - 1);
+        }
+
+        return NULL;
+    }
+
+    while (e && (e->type != -1)) {
+        if (!strcmp(s, e->name))
+            return e;
+
+        e++;
+    }
+
+    return NULL;
+}
+
 void
 device_set_context(device_context_t *c, const device_t *dev, int inst)
 {
@@ -97,6 +225,7 @@ device_set_context(device_context_t *c, const device_t *dev, int inst)
     memset(c, 0, sizeof(device_context_t));
     c->dev      = dev;
     c->instance = inst;
+    device_config_index(c);
     if (inst) {
         sprintf(c->name, "%s #%i", dev->name, inst);
 
@@ -317,6 +446,9 @@ device_close_all(void)
             devices[c] = device_priv[c] = NULL;
         }
     }
+
+    /* All close callbacks have run; release the machine arena wholesale. */
+    device_arena_close();
 }
 
 void
@@ -580,6 +712,93 @@ device_speed_changed(void)
     sound_speed_changed();
 }
 
+/* One sub-chunk per device instance that implements the save_state hook:
+   the internal name, a back-patched payload length, then whatever the
+   hook wrote. Instance order is the registration order, which a machine
+   re-init of the same config reproduces. */
+typedef struct device_state_hdr_t {
+    char     name[64];
+    uint32_t len;
+} device_state_hdr_t;
+
+void
+device_state_save(void *fp)
+{
+    FILE              *file = (FILE *) fp;
+    device_state_hdr_t hdr;
+    long               start;
+    long               end;
+
+    for (uint16_t c = 0; c < DEVICE_MAX; c++) {
+        if ((devices[c] == NULL) || (devices[c]->save_state == NULL))
+            continue;
+
+        memset(&hdr, 0x00, sizeof(hdr));
+        strncpy(hdr.name, devices[c]->internal_name, sizeof(hdr.name) - 1);
+        fwrite(&hdr, sizeof(hdr), 1, file);
+
+        start = ftell(file);
+        devices[c]->save_state(device_priv[c], fp);
+        end = ftell(file);
+
+        fseek(file, start - sizeof(uint32_t), SEEK_SET);
+        hdr.len = end - start;
+        fwrite(&hdr.len, sizeof(uint32_t), 1, file);
+        fseek(file, end, SEEK_SET);
+    }
+}
+
+int
+device_state_load(void *fp, uint32_t len)
+{
+    FILE              *file = (FILE *) fp;
+    device_state_hdr_t hdr;
+    long               end = ftell(file) + len;
+    int                ret = 1;
+
+    while ((ftell(file) + (long) sizeof(hdr)) <= end) {
+        uint16_t c;
+        long     next;
+
+        if (fread(&hdr, sizeof(hdr), 1, file) != 1)
+            return 0;
+        next = ftell(file) + hdr.len;
+
+        for (c = 0; c < DEVICE_MAX; c++) {
+            if ((devices[c] != NULL) && (devices[c]->load_state != NULL) && !strncmp(devices[c]->internal_name, hdr.name, sizeof(hdr.name))) {
+                devices[c]->load_state(device_priv[c], fp, hdr.len);
+                break;
+            }
+        }
+        if (c == DEVICE_MAX) {
+            device_log("DEVICE: no device for state chunk '%s', skipping\n", hdr.name);
+            ret = 0;
+        }
+
+        fseek(file, next, SEEK_SET);
+    }
+
+    return ret;
+}
+
+/* Textual listing of the registered device instances for the hang
+   watchdog. fp is a FILE pointer. */
+void
+device_dump(void *fp)
+{
+    FILE *file = (FILE *) fp;
+
+    fprintf(file, "Registered devices:\n");
+    for (uint16_t c = 0; c < DEVICE_MAX; c++) {
+        if (devices[c] == NULL)
+            continue;
+
+        fprintf(file, "  %3d: %s (%s) flags=%08X priv=%p\n", c,
+                devices[c]->name, devices[c]->internal_name,
+                devices[c]->flags, device_priv[c]);
+    }
+}
+
 void
 device_force_redraw(void)
 {
@@ -600,14 +819,10 @@ device_get_instance(void)
 const char *
 device_get_config_string(const char *s)
 {
-    const device_config_t *c = device_current.dev->config;
+    const device_config_t *c = device_find_config(s);
 
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_string((char *) device_current.name, (char *) s, (char *) c->default_string));
-
-        c++;
-    }
+    if (c)
+        return (config_get_string((char *) device_current.name, (char *) s, (char *) c->default_string));
 
     return (NULL);
 }
@@ -615,14 +830,10 @@ device_get_config_string(const char *s)
 int
 device_get_config_int(const char *s)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_int((char *) device_current.name, (char *) s, c->default_int));
+    const device_config_t *c = device_find_config(s);
 
-        c++;
-    }
+    if (c)
+        return (config_get_int((char *) device_current.name, (char *) s, c->default_int));
 
     return 0;
 }
@@ -630,14 +841,8 @@ device_get_config_int(const char *s)
 int
 device_get_config_int_ex(const char *s, int def)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_int((char *) device_current.name, (char *) s, def));
-
-        c++;
-    }
+    if (device_find_config(s))
+        return (config_get_int((char *) device_current.name, (char *) s, def));
 
     return def;
 }
@@ -645,14 +850,10 @@ device_get_config_int_ex(const char *s, int def)
 int
 device_get_config_hex16(const char *s)
 {
-    const device_config_t *c = device_current.dev->config;
+    const device_config_t *c = device_find_config(s);
 
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_hex16((char *) device_current.name, (char *) s, c->default_int));
-
-        c++;
-    }
+    if (c)
+        return (config_get_hex16((char *) device_current.name, (char *) s, c->default_int));
 
     return 0;
 }
@@ -660,14 +861,10 @@ device_get_config_hex16(const char *s)
 int
 device_get_config_hex20(const char *s)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_hex20((char *) device_current.name, (char *) s, c->default_int));
+    const device_config_t *c = device_find_config(s);
 
-        c++;
-    }
+    if (c)
+        return (config_get_hex20((char *) device_current.name, (char *) s, c->default_int));
 
     return 0;
 }
@@ -675,14 +872,8 @@ device_get_config_hex20(const char *s)
 int
 device_get_config_mac(const char *s, int def)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name))
-            return (config_get_mac((char *) device_current.name, (char *) s, def));
-
-        c++;
-    }
+    if (device_find_config(s))
+        return (config_get_mac((char *) device_current.name, (char *) s, def));
 
     return def;
 }
@@ -690,61 +881,29 @@ device_get_config_mac(const char *s, int def)
 void
 device_set_config_int(const char *s, int val)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name)) {
-            config_set_int((char *) device_current.name, (char *) s, val);
-            break;
-        }
-
-        c++;
-    }
+    if (device_find_config(s))
+        config_set_int((char *) device_current.name, (char *) s, val);
 }
 
 void
 device_set_config_hex16(const char *s, int val)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name)) {
-            config_set_hex16((char *) device_current.name, (char *) s, val);
-            break;
-        }
-
-        c++;
-    }
+    if (device_find_config(s))
+        config_set_hex16((char *) device_current.name, (char *) s, val);
 }
 
 void
 device_set_config_hex20(const char *s, int val)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name)) {
-            config_set_hex20((char *) device_current.name, (char *) s, val);
-            break;
-        }
-
-        c++;
-    }
+    if (device_find_config(s))
+        config_set_hex20((char *) device_current.name, (char *) s, val);
 }
 
 void
 device_set_config_mac(const char *s, int val)
 {
-    const device_config_t *c = device_current.dev->config;
-
-    while (c && c->type != -1) {
-        if (!strcmp(s, c->name)) {
-            config_set_mac((char *) device_current.name, (char *) s, val);
-            break;
-        }
-
-        c++;
-    }
+    if (device_find_config(s))
+        config_set_mac((char *) device_current.name, (char *) s, val);
 }
 
 int
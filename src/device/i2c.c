@@ -42,6 +42,10 @@ typedef struct i2c_bus_t {
     char  *name;
     i2c_t *devices[NADDRS];
     i2c_t *last[NADDRS];
+    /* Addresses flagged by their device as safe to complete without the
+       host controller modeling wire latency (simple memories like the
+       SPD and VGA DDC EEPROMs). */
+    uint8_t fast[NADDRS];
 } i2c_bus_t;
 
 void *i2c_smbus;
@@ -188,6 +192,32 @@ i2c_removehandler(void *bus_handle, uint8_t base, int size,
     }
 }
 
+/* Mark an address range as backed only by devices with no timing of their
+   own; SMBus host controllers may then report such transactions complete
+   immediately instead of arming a response timer. */
+void
+i2c_set_fast(void *bus_handle, uint8_t base, int size, uint8_t fast)
+{
+    i2c_bus_t *bus = (i2c_bus_t *) bus_handle;
+
+    if (!bus_handle || ((base + size) > NADDRS))
+        return;
+
+    for (int c = 0; c < size; c++)
+        bus->fast[base + c] = fast;
+}
+
+uint8_t
+i2c_is_fast(void *bus_handle, uint8_t addr)
+{
+    const i2c_bus_t *bus = (i2c_bus_t *) bus_handle;
+
+    if (!bus_handle)
+        return 0;
+
+    return bus->fast[addr & (NADDRS - 1)];
+}
+
 void
 i2c_handler(int set, void *bus_handle, uint8_t base, int size,
             uint8_t (*start)(void *bus, uint8_t addr, uint8_t read, void *priv),
@@ -323,6 +323,7 @@ ems_write(uint16_t port, uint8_t val, void *priv)
 {
     memdev_t *dev = (memdev_t *) priv;
     int       vpage;
+    int8_t    was_enabled;
 
     /* Get the viewport page number. */
     vpage = (port / EMS_PGSIZE);
@@ -335,6 +336,7 @@ ems_write(uint16_t port, uint8_t val, void *priv)
     switch (port - dev->base_addr) {
         case 0x0000: /* page mapping registers */
             /* Set the page number. */
+            was_enabled             = dev->ems[vpage].enabled;
             dev->ems[vpage].enabled = (val & 0x80);
             dev->ems[vpage].page    = (val & 0x7f);
 
@@ -349,13 +351,22 @@ ems_write(uint16_t port, uint8_t val, void *priv)
                 }
 
                 if (dev->ems[vpage].enabled) {
-                    /* Update the EMS RAM address for this page. */
-                    mem_mapping_set_exec(&dev->ems[vpage].mapping,
-                                         dev->ems[vpage].addr);
-
-                    /* Enable this page. */
-                    mem_mapping_enable(&dev->ems[vpage].mapping);
-                } else {
+                    if (was_enabled) {
+                        /* Only the backing page changed - rewrite the exec
+                           pointers in place instead of recalculating the
+                           mapping.  EMM drivers flip pages thousands of
+                           times per second, so this path must stay cheap. */
+                        mem_mapping_update_exec(&dev->ems[vpage].mapping,
+                                                dev->ems[vpage].addr);
+                    } else {
+                        /* Update the EMS RAM address for this page. */
+                        mem_mapping_set_exec(&dev->ems[vpage].mapping,
+                                             dev->ems[vpage].addr);
+
+                        /* Enable this page. */
+                        mem_mapping_enable(&dev->ems[vpage].mapping);
+                    }
+                } else if (was_enabled) {
                     /* Disable this page. */
                     mem_mapping_disable(&dev->ems[vpage].mapping);
                 }
@@ -199,8 +199,7 @@ kbc_at_dev_init(uint8_t inst)
 {
     atkbc_dev_t *dev;
 
-    dev = (atkbc_dev_t *) malloc(sizeof(atkbc_dev_t));
-    memset(dev, 0x00, sizeof(atkbc_dev_t));
+    dev = (atkbc_dev_t *) device_calloc(1, sizeof(atkbc_dev_t));
 
     dev->port = kbc_at_ports[inst];
 
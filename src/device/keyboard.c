@@ -18,6 +18,7 @@
  *          Copyright 2015-2019 Miran Grca.
  *          Copyright 2017-2019 Fred N. van Kempen.
  */
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -25,6 +26,7 @@
 #include <86box/86box.h>
 #include <86box/machine.h>
 #include <86box/keyboard.h>
+#include <86box/replay.h>
 
 #include "cpu.h"
 
@@ -52,6 +54,19 @@ void (*keyboard_send)(uint16_t val);
 
 static int recv_key[512]; /* keyboard input buffer */
 static int oldkey[512];
+
+/* UI-to-emulation key event ring. The UI thread produces, the emulation
+   thread consumes in keyboard_process(); this keeps keyboard_send() and
+   the controller FIFOs off the UI thread while preserving the make/break
+   ordering of the events. */
+#define KEY_RING_SIZE 256 /* must be a power of two */
+#define KEY_RING_MASK (KEY_RING_SIZE - 1)
+static struct {
+    uint16_t scan;
+    uint8_t  down;
+} key_ring[KEY_RING_SIZE];
+static atomic_int key_ring_head; /* producer index */
+static atomic_int key_ring_tail; /* consumer index */
 #if 0
 static int keydelay[512];
 #endif
@@ -149,6 +164,13 @@ key_process(uint16_t scan, int down)
 void
 keyboard_input(int down, uint16_t scan)
 {
+    if (replay_mode == REPLAY_PLAY) {
+        /* The recording drives the machine; live input is ignored. */
+        if (!replay_injecting)
+            return;
+    } else if (replay_mode == REPLAY_RECORD)
+        replay_record_key(down, scan);
+
     /* Special case for E1 1D, translate it to 0100 - special case. */
     if ((scan >> 8) == 0xe1) {
         if ((scan & 0xff) == 0x1d)
@@ -247,7 +269,28 @@ keyboard_input(int down, uint16_t scan)
     /* pclog("Received scan code: %03X (%s)\n", scan & 0x1ff, down ? "down" : "up"); */
     recv_key[scan & 0x1ff] = down;
 
-    key_process(scan & 0x1ff, down);
+    /* Queue the event for the emulation thread; drop it if the ring is
+       full (the guest is not consuming anyway). */
+    int head = atomic_load(&key_ring_head);
+    if (((head + 1) & KEY_RING_MASK) != atomic_load(&key_ring_tail)) {
+        key_ring[head].scan = scan & 0x1ff;
+        key_ring[head].down = down;
+        atomic_store(&key_ring_head, (head + 1) & KEY_RING_MASK);
+    }
+}
+
+/* Deliver queued key events to the emulated keyboard; called from the
+   emulation thread once per time slice. */
+void
+keyboard_process(void)
+{
+    int tail = atomic_load(&key_ring_tail);
+
+    while (tail != atomic_load(&key_ring_head)) {
+        key_process(key_ring[tail].scan, key_ring[tail].down);
+        tail = (tail + 1) & KEY_RING_MASK;
+        atomic_store(&key_ring_tail, tail);
+    }
 }
 
 static uint8_t
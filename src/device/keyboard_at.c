@@ -25,6 +25,7 @@
 #include <86box/device.h>
 #include <86box/keyboard.h>
 #include <86box/mouse.h>
+#include <86box/plat_unused.h>
 
 #define FLAG_PS2       0x08  /* dev is AT or PS/2 */
 #define FLAG_AT        0x00  /* dev is AT or PS/2 */
@@ -990,10 +991,8 @@ keyboard_at_init(const device_t *info)
 }
 
 static void
-keyboard_at_close(void *priv)
+keyboard_at_close(UNUSED(void *priv))
 {
-    atkbc_dev_t *dev = (atkbc_dev_t *) priv;
-
     keyboard_scan = 0;
     keyboard_send = NULL;
 
@@ -1001,8 +1000,6 @@ keyboard_at_close(void *priv)
     keyboard_set_table(NULL);
 
     SavedKbd = NULL;
-
-    free(dev);
 }
 
 static const device_config_t keyboard_at_config[] = {
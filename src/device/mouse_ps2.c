@@ -355,11 +355,9 @@ mouse_ps2_init(const device_t *info)
 }
 
 static void
-ps2_close(void *priv)
+ps2_close(UNUSED(void *priv))
 {
-    atkbc_dev_t *dev = (atkbc_dev_t *) priv;
-
-    free(dev);
+    /* Arena-backed; released wholesale by device_close_all(). */
 }
 
 static const device_config_t ps2_config[] = {
@@ -89,6 +89,7 @@ serial_reset_port(serial_t *dev)
 
     dev->fifo_enabled                         = 0;
     dev->baud_cycles                          = 0;
+    dev->baud_pending                         = 0;
     dev->out_new                              = 0xffff;
 
     dev->txsr_empty = 1;
@@ -161,7 +162,8 @@ serial_receive_timer(void *priv)
 
     serial_log("serial_receive_timer()\n");
 
-    timer_on_auto(&dev->receive_timer, /* dev->bits * */ dev->transmit_period);
+    /* One-shot: write_fifo() arms this timer when a byte lands in the RSR,
+       so the line no longer costs a wakeup per bit time while it is idle. */
 
     if (dev->fifo_enabled) {
         /* FIFO mode. */
@@ -213,6 +215,13 @@ write_fifo(serial_t *dev, uint8_t dat)
 
     /* Do this here, because in non-FIFO mode, this is read directly. */
     dev->out_new = (uint16_t) dat;
+
+    /* Deliver the byte one bit time from now - the receive timer is armed
+       per deposited byte instead of free-running at the bit rate. */
+    if (!timer_is_enabled(&dev->receive_timer)) {
+        timer_stop(&dev->receive_timer);
+        timer_on_auto(&dev->receive_timer, dev->transmit_period);
+    }
 }
 
 void
@@ -296,6 +305,57 @@ serial_process_txsr(serial_t *dev)
     serial_update_ints(dev);
 }
 
+/* Arm the transmit timer so the next callback lands exactly on the next
+   byte boundary (move or transmit) instead of waking up once per BAUDOUT
+   cycle; the skipped cycles are credited in bulk when it fires. */
+static void
+serial_transmit_timer_arm(serial_t *dev)
+{
+    int delay = ((dev->transmit_enabled & 3) == 3) ? dev->data_bits : 8;
+    int skip  = 0;
+    int until;
+
+    if (dev->transmit_enabled & 2) {
+        until = (int) dev->bits - (int) dev->baud_cycles;
+        if ((until >= 1) && ((skip == 0) || (until < skip)))
+            skip = until;
+    }
+
+    if (dev->transmit_enabled & 1) {
+        until = delay - (int) dev->baud_cycles;
+        if ((until >= 1) && ((skip == 0) || (until < skip)))
+            skip = until;
+    }
+
+    if (skip < 1)
+        skip = 1;
+
+    dev->baud_pending = (uint8_t) (skip - 1);
+    timer_on_auto(&dev->transmit_timer, ((double) skip) * dev->transmit_period);
+}
+
+/* Fold an outstanding batched arm back to single-cycle stepping: credit the
+   bit times that have already gone by and stop the timer so the caller can
+   re-arm it one period out. The credit is capped at the batch length, so no
+   cycle count the batch was aimed at can be stepped over. */
+static void
+serial_transmit_timer_resync(serial_t *dev)
+{
+    int remaining;
+
+    if (dev->baud_pending == 0)
+        return;
+
+    remaining = (int) (((double) timer_get_remaining_u64(&dev->transmit_timer)) /
+                       (dev->transmit_period * ((double) TIMER_USEC)));
+    if (remaining > dev->baud_pending)
+        remaining = dev->baud_pending;
+
+    dev->baud_cycles += (uint8_t) (dev->baud_pending - remaining);
+    dev->baud_pending = 0;
+    timer_stop(&dev->transmit_timer);
+}
+
 /* Transmit_enable flags:
         Bit 0 = Do move if set;
         Bit 1 = Do transmit if set. */
@@ -309,7 +369,9 @@ serial_transmit_timer(void *priv)
         if ((dev->transmit_enabled & 1) && (dev->transmit_enabled & 2))
             delay = dev->data_bits; /* Delay by less if already transmitting. */
 
-        dev->baud_cycles++;
+        /* Credit this callback's cycle plus any cycles batched into it. */
+        dev->baud_cycles += 1 + dev->baud_pending;
+        dev->baud_pending = 0;
 
         /* We have processed (total bits) BAUDOUT cycles, transmit the byte. */
         if ((dev->baud_cycles == dev->bits) && (dev->transmit_enabled & 2))
@@ -320,9 +382,10 @@ serial_transmit_timer(void *priv)
             serial_move_to_txsr(dev);
 
         if (dev->transmit_enabled & 3)
-            timer_on_auto(&dev->transmit_timer, dev->transmit_period);
+            serial_transmit_timer_arm(dev);
     } else {
-        dev->baud_cycles = 0;
+        dev->baud_cycles  = 0;
+        dev->baud_pending = 0;
         return;
     }
 }
@@ -357,10 +420,18 @@ static void
 serial_update_speed(serial_t *dev)
 {
     serial_log("serial_update_speed(%lf)\n", dev->transmit_period);
-    timer_on_auto(&dev->receive_timer, /* dev->bits * */ dev->transmit_period);
 
-    if (dev->transmit_enabled & 3)
+    /* The receive timer is armed per deposited byte - re-arm it at the new
+       rate only if a byte is still waiting in the RSR. */
+    if (dev->out_new != 0xffff) {
+        timer_stop(&dev->receive_timer);
+        timer_on_auto(&dev->receive_timer, dev->transmit_period);
+    }
+
+    if (dev->transmit_enabled & 3) {
+        serial_transmit_timer_resync(dev);
         timer_on_auto(&dev->transmit_timer, dev->transmit_period);
+    }
 
     if (timer_is_on(&dev->timeout_timer))
         timer_on_auto(&dev->timeout_timer, 4.0 * dev->bits * dev->transmit_period);
@@ -463,6 +534,7 @@ serial_write(uint16_t addr, uint8_t val, void *priv)
 
             if (dev->fifo_enabled && (fifo_get_count(dev->xmit_fifo) < 16)) {
                 /* FIFO mode, begin transmitting. */
+                serial_transmit_timer_resync(dev);
                 timer_on_auto(&dev->transmit_timer, dev->transmit_period);
                 dev->transmit_enabled |= 1; /* Start moving. */
                 fifo_write_evt(val, dev->xmit_fifo);
@@ -473,6 +545,7 @@ serial_write(uint16_t addr, uint8_t val, void *priv)
                 serial_update_ints(dev);
 
                 /* Non-FIFO mode, begin transmitting. */
+                serial_transmit_timer_resync(dev);
                 timer_on_auto(&dev->transmit_timer, dev->transmit_period);
                 dev->transmit_enabled |= 1; /* Start moving. */
                 dev->thr = val;
@@ -811,8 +884,6 @@ serial_close(void *priv)
 
     if (com_ports[dev->inst].enabled)
         fifo_close(dev->rcvr_fifo);
-
-    free(dev);
 }
 
 static void
@@ -830,6 +901,7 @@ serial_reset(void *priv)
         dev->dat = dev->int_status = dev->scratch = dev->fcr = 0x00;
         dev->fifo_enabled = dev->bits = 0x000;
         dev->data_bits = dev->baud_cycles = 0x00;
+        dev->baud_pending = 0x00;
         dev->txsr = 0x00;
         dev->txsr_empty = 0x01;
         dev->thr_empty = 0x0001;
@@ -852,8 +924,7 @@ serial_reset(void *priv)
 static void *
 serial_init(const device_t *info)
 {
-    serial_t *dev = (serial_t *) malloc(sizeof(serial_t));
-    memset(dev, 0, sizeof(serial_t));
+    serial_t *dev = (serial_t *) device_calloc(1, sizeof(serial_t));
 
     dev->inst = next_inst;
 
@@ -73,34 +73,51 @@ host_to_serial_cb(void *priv)
 {
     serial_passthrough_t *dev = (serial_passthrough_t *) priv;
 
-    uint8_t byte;
+    double period;
+    int    room;
+
+    /* Top the ring up with one bulk read instead of paying a select() and a
+     * one-byte read() per delivered byte. */
+    if (dev->ring_tail == dev->ring_head) {
+        dev->ring_head = plat_serpt_read_buf(dev, dev->ring, sizeof(dev->ring));
+        dev->ring_tail = 0;
+    }
 
     /* write_fifo has no failure indication, but if we write to fast, the host
      * can never fetch the bytes in time, so check if the fifo is full if in
      * fifo mode or if lsr has bit 0 set if not in fifo mode */
-    if ((dev->serial->type >= SERIAL_16550) && dev->serial->fifo_enabled) {
-        if (fifo_get_full(dev->serial->rcvr_fifo)) {
-            goto no_write_to_machine;
-        }
-    } else {
-        if (dev->serial->lsr & 1) {
-            goto no_write_to_machine;
-        }
-    }
-    if (plat_serpt_read(dev, &byte)) {
+    if ((dev->serial->type >= SERIAL_16550) && dev->serial->fifo_enabled)
+        room = !fifo_get_full(dev->serial->rcvr_fifo);
+    else
+        room = !(dev->serial->lsr & 1);
+
+    /* The UART has a single receive shift register slot - depositing while a
+     * byte is still in flight would drop it on the floor. */
+    if ((dev->ring_tail != dev->ring_head) && room && (dev->serial->out_new == 0xffff)) {
 #if 0
-        printf("got byte %02X\n", byte);
+        printf("got byte %02X\n", dev->ring[dev->ring_tail]);
 #endif
-        serial_write_fifo(dev->serial, byte);
+        serial_write_fifo(dev->serial, dev->ring[dev->ring_tail++]);
 #if 0
         serial_set_dsr(dev->serial, 1);
 #endif
     }
-no_write_to_machine:
 #if 0
     serial_device_timeout(dev->serial);
 #endif
-    timer_on_auto(&dev->host_to_serial_timer, (1000000.0 / dev->baudrate) * (double) dev->bits);
+
+    period = (1000000.0 / dev->baudrate) * (double) dev->bits;
+    if (dev->unthrottled && (dev->ring_tail != dev->ring_head)) {
+        /* Bulk-transfer mode: while the ring holds data, pace at the receive
+         * shift register's one-bit-time delivery rate instead of the full
+         * byte frame, clamped so the timer does not spin. The frame period
+         * above is kept whenever the ring runs dry, so an idle line costs
+         * no more than the throttled mode. */
+        period = 1000000.0 / dev->baudrate;
+        if (period < 20.0)
+            period = 20.0;
+    }
+    timer_on_auto(&dev->host_to_serial_timer, period);
 }
 
 static void
@@ -182,9 +199,10 @@ serial_passthrough_dev_init(const device_t *info)
     memset(dev, 0, sizeof(serial_passthrough_t));
     dev->mode = device_get_config_int("mode");
 
-    dev->port      = device_get_instance() - 1;
-    dev->baudrate  = device_get_config_int("baudrate");
-    dev->data_bits = device_get_config_int("data_bits");
+    dev->port        = device_get_instance() - 1;
+    dev->baudrate    = device_get_config_int("baudrate");
+    dev->data_bits   = device_get_config_int("data_bits");
+    dev->unthrottled = device_get_config_int("unthrottled");
 
     /* Attach passthrough device to a COM port */
     dev->serial = serial_attach_ex(dev->port, serial_passthrough_rcr_cb,
@@ -365,6 +383,13 @@ static const device_config_t serial_passthrough_config[] = {
             { .description =     "75", .value =     75 }
         }
     },
+    {
+        .name = "unthrottled",
+        .description = "Unthrottled host-to-guest delivery (bulk transfers)",
+        .type = CONFIG_BINARY,
+        .default_string = "",
+        .default_int = 0
+    },
     { .name = "", .description = "", .type = CONFIG_END }
 };
 // clang-format on
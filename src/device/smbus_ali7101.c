@@ -232,10 +232,18 @@ smbus_ali7101_write(uint16_t addr, uint8_t val, void *priv)
     }
 
     if (dev->next_stat != 0x04) { /* schedule dispatch of any pending status register update */
-        dev->stat = 0x08;         /* raise HOST_BUSY while waiting */
-        timer_disable(&dev->response_timer);
-        /* delay = ((half clock for start + half clock for stop) + (bytes * (8 bits + ack))) * 60us period measured on real VIA 686B */
-        timer_set_delay_u64(&dev->response_timer, (1 + (timer_bytes * 9)) * 60 * TIMER_USEC);
+        /* Completed transactions against latency-free targets (SPD and other
+           plain EEPROMs) post their status immediately instead of making the
+           guest wait out the response timer. */
+        if ((dev->next_stat == 0x10) && i2c_is_fast(i2c_smbus, dev->addr >> 1)) {
+            dev->stat      = dev->next_stat;
+            dev->next_stat = 0x04;
+        } else {
+            dev->stat = 0x08; /* raise HOST_BUSY while waiting */
+            timer_disable(&dev->response_timer);
+            /* delay = ((half clock for start + half clock for stop) + (bytes * (8 bits + ack))) * 60us period measured on real VIA 686B */
+            timer_set_delay_u64(&dev->response_timer, (1 + (timer_bytes * 9)) * 60 * TIMER_USEC);
+        }
     }
 }
 
@@ -316,10 +316,19 @@ unknown_protocol:
     }
 
     if (dev->next_stat) { /* schedule dispatch of any pending status register update */
-        dev->stat = 0x01; /* raise HOST_BUSY while waiting */
-        timer_disable(&dev->response_timer);
-        /* delay = ((half clock for start + half clock for stop) + (bytes * (8 bits + ack))) * bit period in usecs */
-        timer_set_delay_u64(&dev->response_timer, (1 + (timer_bytes * 9)) * dev->bit_period * TIMER_USEC);
+        /* Completed transactions against latency-free targets (SPD and other
+           plain EEPROMs) post their status immediately - hardware monitoring
+           guests poll these continuously, and every poll would otherwise sit
+           out a full response timer. */
+        if ((dev->next_stat == 0x02) && i2c_is_fast(i2c_smbus, dev->addr >> 1)) {
+            dev->stat      = dev->next_stat;
+            dev->next_stat = 0x00;
+        } else {
+            dev->stat = 0x01; /* raise HOST_BUSY while waiting */
+            timer_disable(&dev->response_timer);
+            /* delay = ((half clock for start + half clock for stop) + (bytes * (8 bits + ack))) * bit period in usecs */
+            timer_set_delay_u64(&dev->response_timer, (1 + (timer_bytes * 9)) * dev->bit_period * TIMER_USEC);
+        }
     }
 }
 
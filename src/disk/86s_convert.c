@@ -0,0 +1,242 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Standalone converter between raw sector images and the native
+ *          86S sparse format (see hdd_image.c for the on-disk layout).
+ *          Built separately from the emulator, so this file is fully
+ *          self-contained.
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#define _FILE_OFFSET_BITS 64
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPR_SIGNATURE       0x525053584f423638ULL /* "86BOXSPR" */
+#define SPR_VERSION         1
+#define SPR_HEADER_SIZE     4096
+#define SPR_CLUSTER_SIZE    (2 << 20)
+#define SPR_UNALLOCATED     0xffffffff
+
+static uint32_t
+table_bytes(uint32_t clusters)
+{
+    return ((clusters * 4) + (SPR_HEADER_SIZE - 1)) & ~(uint32_t) (SPR_HEADER_SIZE - 1);
+}
+
+static int
+cluster_is_zero(const uint8_t *buffer, uint32_t len)
+{
+    const uint64_t *p = (const uint64_t *) buffer;
+
+    for (uint32_t i = 0; i < (len >> 3); i++) {
+        if (p[i] != 0)
+            return 0;
+    }
+
+    return 1;
+}
+
+static int
+raw_to_86s(FILE *in, FILE *out)
+{
+    uint64_t  signature = SPR_SIGNATURE;
+    uint32_t  version   = SPR_VERSION;
+    uint32_t  cluster_size = SPR_CLUSTER_SIZE;
+    uint64_t  disk_size;
+    uint32_t  clusters;
+    uint32_t  allocated = 0;
+    uint32_t *table;
+    uint8_t  *cluster;
+    uint8_t   pad[SPR_HEADER_SIZE];
+
+    if (fseeko(in, 0, SEEK_END) == -1)
+        return 1;
+    disk_size = (uint64_t) ftello(in);
+    if (fseeko(in, 0, SEEK_SET) == -1)
+        return 1;
+    if (disk_size == 0) {
+        fprintf(stderr, "86s_convert: input image is empty\n");
+        return 1;
+    }
+
+    clusters = (uint32_t) ((disk_size + SPR_CLUSTER_SIZE - 1) / SPR_CLUSTER_SIZE);
+    table    = (uint32_t *) malloc(table_bytes(clusters));
+    cluster  = (uint8_t *) malloc(SPR_CLUSTER_SIZE);
+    if ((table == NULL) || (cluster == NULL)) {
+        fprintf(stderr, "86s_convert: out of memory\n");
+        free(table);
+        free(cluster);
+        return 1;
+    }
+    memset(table, 0xff, table_bytes(clusters));
+
+    /* Leave room for the header and table, then pack the allocated
+       clusters densely behind them. */
+    if (fseeko(out, SPR_HEADER_SIZE + table_bytes(clusters), SEEK_SET) == -1)
+        goto fail;
+
+    for (uint32_t c = 0; c < clusters; c++) {
+        size_t n = fread(cluster, 1, SPR_CLUSTER_SIZE, in);
+
+        if (n == 0)
+            break;
+        if (n < SPR_CLUSTER_SIZE)
+            memset(cluster + n, 0x00, SPR_CLUSTER_SIZE - n);
+
+        if (cluster_is_zero(cluster, SPR_CLUSTER_SIZE))
+            continue;
+
+        table[c] = allocated++;
+        if (fwrite(cluster, 1, SPR_CLUSTER_SIZE, out) != SPR_CLUSTER_SIZE)
+            goto fail;
+    }
+
+    if (fseeko(out, 0, SEEK_SET) == -1)
+        goto fail;
+    fwrite(&signature, 1, 8, out);
+    fwrite(&version, 1, 4, out);
+    fwrite(&cluster_size, 1, 4, out);
+    fwrite(&disk_size, 1, 8, out);
+    memset(pad, 0x00, sizeof(pad));
+    fwrite(pad, 1, SPR_HEADER_SIZE - 24, out);
+    if (fwrite(table, 1, table_bytes(clusters), out) != table_bytes(clusters))
+        goto fail;
+
+    printf("86s_convert: %u of %u clusters allocated\n", allocated, clusters);
+
+    free(table);
+    free(cluster);
+    return 0;
+
+fail:
+    fprintf(stderr, "86s_convert: write error\n");
+    free(table);
+    free(cluster);
+    return 1;
+}
+
+static int
+spr_to_raw(FILE *in, FILE *out)
+{
+    uint64_t  signature;
+    uint64_t  disk_size;
+    uint32_t  version;
+    uint32_t  cluster_size;
+    uint32_t  clusters;
+    uint64_t  data_base;
+    uint32_t *table;
+    uint8_t  *cluster;
+
+    if (fread(&signature, 1, 8, in) != 8)
+        return 1;
+    if (fread(&version, 1, 4, in) != 4)
+        return 1;
+    if (fread(&cluster_size, 1, 4, in) != 4)
+        return 1;
+    if (fread(&disk_size, 1, 8, in) != 8)
+        return 1;
+
+    if ((signature != SPR_SIGNATURE) || (version != SPR_VERSION)
+        || (cluster_size != SPR_CLUSTER_SIZE) || (disk_size == 0)) {
+        fprintf(stderr, "86s_convert: not a valid 86S image\n");
+        return 1;
+    }
+
+    clusters  = (uint32_t) ((disk_size + SPR_CLUSTER_SIZE - 1) / SPR_CLUSTER_SIZE);
+    data_base = SPR_HEADER_SIZE + table_bytes(clusters);
+    table     = (uint32_t *) malloc(table_bytes(clusters));
+    cluster   = (uint8_t *) malloc(SPR_CLUSTER_SIZE);
+    if ((table == NULL) || (cluster == NULL)) {
+        fprintf(stderr, "86s_convert: out of memory\n");
+        free(table);
+        free(cluster);
+        return 1;
+    }
+
+    if (fseeko(in, SPR_HEADER_SIZE, SEEK_SET) == -1)
+        goto fail;
+    if (fread(table, 1, clusters * 4, in) != (clusters * 4))
+        goto fail;
+
+    for (uint32_t c = 0; c < clusters; c++) {
+        uint64_t remaining = disk_size - ((uint64_t) c * SPR_CLUSTER_SIZE);
+        uint32_t n         = (remaining < SPR_CLUSTER_SIZE) ? (uint32_t) remaining : SPR_CLUSTER_SIZE;
+
+        if (table[c] == SPR_UNALLOCATED)
+            memset(cluster, 0x00, n);
+        else {
+            if (fseeko(in, data_base + ((uint64_t) table[c] * SPR_CLUSTER_SIZE), SEEK_SET) == -1)
+                goto fail;
+            if (fread(cluster, 1, n, in) != n)
+                goto fail;
+        }
+
+        if (fwrite(cluster, 1, n, out) != n)
+            goto fail;
+    }
+
+    free(table);
+    free(cluster);
+    return 0;
+
+fail:
+    fprintf(stderr, "86s_convert: read/write error\n");
+    free(table);
+    free(cluster);
+    return 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+    FILE    *in;
+    FILE    *out;
+    uint64_t signature = 0;
+    int      ret;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: 86s_convert <input image> <output image>\n\n"
+                        "Converts a raw sector image to the 86S sparse format, or an\n"
+                        "86S image back to raw, depending on the input's signature.\n");
+        return 1;
+    }
+
+    in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        fprintf(stderr, "86s_convert: cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    out = fopen(argv[2], "wb");
+    if (out == NULL) {
+        fprintf(stderr, "86s_convert: cannot create '%s'\n", argv[2]);
+        fclose(in);
+        return 1;
+    }
+
+    if (fread(&signature, 1, 8, in) == 8 && (signature == SPR_SIGNATURE)) {
+        rewind(in);
+        ret = spr_to_raw(in, out);
+    } else {
+        rewind(in);
+        ret = raw_to_86s(in, out);
+    }
+
+    fclose(in);
+    fclose(out);
+
+    if (ret)
+        remove(argv[2]);
+
+    return ret;
+}
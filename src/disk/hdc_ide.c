@@ -1228,22 +1228,24 @@ ide_write_data(ide_t *ide, uint16_t val, int length)
                 ide->tf->pos++;
             }
 
-            if (ide->tf->pos >= 512) {
+            if ((ide->command == WIN_WRITE_MULTIPLE) && ide->blocksize) {
+                /* The block is moved to the image in one go once the host has
+                   filled it, so only charge timing (in a single lump) and run
+                   the callback at the block boundary. */
+                if (!(ide->tf->pos & 511) && (ide->tf->pos >= ide->block_total)) {
+                    uint32_t cnt = ide->block_total >> 9;
+
+                    ide->tf->atastat = BSY_STAT;
+                    double seek_time = hdd_timing_write(&hdd[ide->hdd_num], ide_get_sector(ide), cnt);
+                    double xfer_time = ide_get_xfer_time(ide, 512 * cnt);
+                    ide_set_callback(ide, seek_time + xfer_time);
+                }
+            } else if (ide->tf->pos >= 512) {
                 ide->tf->pos     = 0;
                 ide->tf->atastat = BSY_STAT;
                 double seek_time = hdd_timing_write(&hdd[ide->hdd_num], ide_get_sector(ide), 1);
                 double xfer_time = ide_get_xfer_time(ide, 512);
-                double wait_time = seek_time + xfer_time;
-                if (ide->command == WIN_WRITE_MULTIPLE) {
-                    if ((ide->blockcount + 1) >= ide->blocksize || ide->tf->secount == 1) {
-                        ide_set_callback(ide, seek_time + xfer_time + ide->pending_delay);
-                        ide->pending_delay = 0;
-                    } else {
-                        ide->pending_delay += wait_time;
-                        ide_callback(ide);
-                    }
-                } else
-                    ide_set_callback(ide, wait_time);
+                ide_set_callback(ide, seek_time + xfer_time);
             }
         }
     }
@@ -1433,7 +1435,9 @@ ide_reset_registers(ide_t *ide)
     ide->tf->sector   = 1;
     ide->tf->head     = 0;
 
-    ide->reset        = 0;
+    ide->reset          = 0;
+    ide->dma_io_pending = 0;
+    ide->block_total    = 0;
 
     if (ide->type == IDE_ATAPI)
         ide->sc->callback       = 0.0;
@@ -1576,7 +1580,8 @@ ide_writeb(uint16_t addr, uint8_t val, void *priv)
             ide_irq_lower(ide);
             ide->command = val;
 
-            ide->tf->error = 0;
+            ide->tf->error      = 0;
+            ide->dma_io_pending = 0;
 
             switch (val) {
                 case WIN_RECAL ... 0x1F:
@@ -1661,6 +1666,19 @@ ide_writeb(uint16_t addr, uint8_t val, void *priv)
                 case WIN_WRITE_MULTIPLE:
                     /* Fatal removed for the same reason as for WIN_READ_MULTIPLE. */
                     ide->blockcount = 0;
+                    if ((ide->type != IDE_ATAPI) && (ide->blocksize == 0)) {
+                        /* No Set Multiple Mode - reject before raising DRQ,
+                           like Read Multiple does; the callback aborts the
+                           command. */
+                        ide->tf->atastat = BSY_STAT;
+                        ide_set_callback(ide, 200.0 * IDE_TIME);
+                        break;
+                    }
+                    /* The host hands over a whole block before the next callback runs. */
+                    ide->block_total = ide->tf->secount ? ide->tf->secount : 256;
+                    if (ide->block_total > ide->blocksize)
+                        ide->block_total = ide->blocksize;
+                    ide->block_total <<= 9;
                     /* Turn on the activity indicator *here* so that it gets turned on
                        less times. */
                     ui_sb_update_icon(SB_HDD | hdd[ide->hdd_num].bus, 1);
@@ -1826,38 +1844,49 @@ ide_read_data(ide_t *ide, int length)
             ide->tf->pos++;
         }
 
-        if (ide->tf->pos >= 512) {
+        if ((ide->command == WIN_READ_MULTIPLE) && (ide->type != IDE_ATAPI) && ide->blocksize) {
+            /* The whole block was presented at once, so just track the sector
+               position and only schedule the callback (with the timing for the
+               next block charged in one lump) at the block boundary. */
+            if (!(ide->tf->pos & 511)) {
+                ide->tf->secount--;
+                if (ide->tf->secount)
+                    ide_next_sector(ide);
+
+                if (ide->tf->pos >= ide->block_total) {
+                    ide->tf->pos = 0;
+                    if (ide->tf->secount) {
+                        ide->tf->atastat = BSY_STAT | READY_STAT | DSC_STAT;
+                        uint32_t cnt = ide->tf->secount;
+                        if (cnt > (uint32_t) ide->blocksize)
+                            cnt = ide->blocksize;
+                        seek_us = hdd_timing_read(&hdd[ide->hdd_num],
+                                                  ide_get_sector(ide), cnt);
+                        xfer_us = ide_get_xfer_time(ide, 512 * cnt);
+                        ide_set_callback(ide, seek_us + xfer_us);
+                    } else {
+                        ide->tf->atastat = DRDY_STAT | DSC_STAT;
+                        ui_sb_update_icon(SB_HDD | hdd[ide->hdd_num].bus, 0);
+                    }
+                }
+            }
+        } else if (ide->tf->pos >= 512) {
             ide->tf->pos     = 0;
             ide->tf->atastat = DRDY_STAT | DSC_STAT;
             if (ide->type == IDE_ATAPI)
                 ide->sc->packet_status = PHASE_IDLE;
 
             if ((ide->command == WIN_READ) ||
-                (ide->command == WIN_READ_NORETRY) ||
-                (ide->command == WIN_READ_MULTIPLE)) {
+                (ide->command == WIN_READ_NORETRY)) {
                 ide->tf->secount--;
 
                 if (ide->tf->secount) {
                     ide_next_sector(ide);
                     ide->tf->atastat = BSY_STAT | READY_STAT | DSC_STAT;
-                    if (ide->command == WIN_READ_MULTIPLE) {
-                        if (!ide->blockcount) {
-                            uint32_t cnt = ide->tf->secount ?
-                                           ide->tf->secount : 256;
-                            if (cnt > ide->blocksize)
-                                cnt = ide->blocksize;
-                            seek_us = hdd_timing_read(&hdd[ide->hdd_num],
-                                                      ide_get_sector(ide), cnt);
-                            xfer_us = ide_get_xfer_time(ide, 512 * cnt);
-                            ide_set_callback(ide, seek_us + xfer_us);
-                        } else
-                            ide_callback(ide);
-                    } else {
-                        seek_us = hdd_timing_read(&hdd[ide->hdd_num],
-                                                  ide_get_sector(ide), 1);
-                        xfer_us = ide_get_xfer_time(ide, 512);
-                        ide_set_callback(ide, seek_us + xfer_us);
-                    }
+                    seek_us = hdd_timing_read(&hdd[ide->hdd_num],
+                                              ide_get_sector(ide), 1);
+                    xfer_us = ide_get_xfer_time(ide, 512);
+                    ide_set_callback(ide, seek_us + xfer_us);
                 } else
                     ui_sb_update_icon(SB_HDD | hdd[ide->hdd_num].bus, 0);
             }
@@ -2238,7 +2267,20 @@ ide_callback(void *priv)
                     ide->sector_pos = ide->tf->secount;
                 else
                     ide->sector_pos = 256;
-                hdd_image_read(ide->hdd_num, ide_get_sector(ide), ide->sector_pos, ide->sector_buffer);
+
+                /* Queue the image read on the disk I/O thread and poll for it
+                   from the timer callback - a slow host volume must not stall
+                   the CPU thread. */
+                if (!ide->dma_io_pending) {
+                    ide->dma_io_pending = 1;
+                    hdd_image_read_queued(ide->hdd_num, ide_get_sector(ide),
+                                          ide->sector_pos, ide->sector_buffer);
+                }
+
+                if (!hdd_image_queued_done(ide->hdd_num)) {
+                    ide_set_callback(ide, 6.0 * IDE_TIME);
+                    return;
+                }
 
                 ide->tf->pos = 0;
 
@@ -2246,11 +2288,14 @@ ide_callback(void *priv)
                     /* We should not abort - we should simply wait for the host to start DMA. */
                     ret = bm->dma(ide->sector_buffer, ide->sector_pos * 512, 0, bm->priv);
                     if (ret == 2) {
-                        /* Bus master DMA disabled, simply wait for the host to enable DMA. */
+                        /* Bus master DMA disabled, simply wait for the host to enable DMA.
+                           The sector data is already in the buffer, so keep the request
+                           marked pending and do not read it again. */
                         ide->tf->atastat = DRQ_STAT | DRDY_STAT | DSC_STAT;
                         ide_set_callback(ide, 6.0 * IDE_TIME);
                         return;
                     } else if (ret == 1) {
+                        ide->dma_io_pending = 0;
                         /* DMA successful */
                         ide_log("IDE %i: DMA read successful\n", ide->channel);
 
@@ -2261,10 +2306,12 @@ ide_callback(void *priv)
                     } else {
                         /* Bus master DMAS error, abort the command. */
                         ide_log("IDE %i: DMA read aborted (failed)\n", ide->channel);
+                        ide->dma_io_pending = 0;
                         err = ABRT_ERR;
                     }
                 } else {
                     ide_log("IDE %i: DMA read aborted (no bus master)\n", ide->channel);
+                    ide->dma_io_pending = 0;
                     err = ABRT_ERR;
                 }
             }
@@ -2282,6 +2329,11 @@ ide_callback(void *priv)
             else if (!ide->tf->lba && (ide->cfg_spt == 0))
                 err = IDNF_ERR;
             else {
+                uint32_t cnt = ide->tf->secount ? ide->tf->secount : 256;
+
+                if (cnt > (uint32_t) ide->blocksize)
+                    cnt = ide->blocksize;
+
                 if (ide->do_initial_read) {
                     ide->do_initial_read = 0;
                     ide->sector_pos      = 0;
@@ -2289,17 +2341,17 @@ ide_callback(void *priv)
                                    ide->tf->secount ? ide->tf->secount : 256, ide->sector_buffer);
                 }
 
-                memcpy(ide->buffer, &ide->sector_buffer[ide->sector_pos * 512], 512);
+                /* Present the whole block at once - the timing for it was
+                   already charged in a single lump, so emulating a callback
+                   per sector would only multiply timer and IRQ overhead. */
+                memcpy(ide->buffer, &ide->sector_buffer[ide->sector_pos * 512], cnt << 9);
 
-                ide->sector_pos++;
+                ide->sector_pos += cnt;
+                ide->block_total = cnt << 9;
                 ide->tf->pos     = 0;
 
                 ide->tf->atastat = DRQ_STAT | DRDY_STAT | DSC_STAT;
-                if (!ide->blockcount)
-                    ide_irq_raise(ide);
-                ide->blockcount++;
-                if (ide->blockcount >= ide->blocksize)
-                    ide->blockcount = 0;
+                ide_irq_raise(ide);
             }
             break;
 
@@ -2344,7 +2396,12 @@ ide_callback(void *priv)
                     else
                         ide->sector_pos = 256;
 
-                    ret = bm->dma(ide->sector_buffer, ide->sector_pos * 512, 1, bm->priv);
+                    if (ide->dma_io_pending)
+                        /* The bus master already ran; we are only waiting for
+                           the queued image write to finish. */
+                        ret = 1;
+                    else
+                        ret = bm->dma(ide->sector_buffer, ide->sector_pos * 512, 1, bm->priv);
 
                     if (ret == 2) {
                         /* Bus master DMA disabled, simply wait for the host to enable DMA. */
@@ -2355,8 +2412,17 @@ ide_callback(void *priv)
                         /* DMA successful */
                         ide_log("IDE %i: DMA write successful\n", ide->channel);
 
-                        hdd_image_write(ide->hdd_num, ide_get_sector(ide),
-                                        ide->sector_pos, ide->sector_buffer);
+                        if (!ide->dma_io_pending) {
+                            ide->dma_io_pending = 1;
+                            hdd_image_write_queued(ide->hdd_num, ide_get_sector(ide),
+                                                   ide->sector_pos, ide->sector_buffer);
+                        }
+
+                        if (!hdd_image_queued_done(ide->hdd_num)) {
+                            ide_set_callback(ide, 6.0 * IDE_TIME);
+                            return;
+                        }
+                        ide->dma_io_pending = 0;
 
                         ide->tf->atastat = DRDY_STAT | DSC_STAT;
 
@@ -2385,18 +2451,29 @@ ide_callback(void *priv)
                 err = ABRT_ERR;
             else if (!ide->tf->lba && (ide->cfg_spt == 0))
                 err = IDNF_ERR;
+            else if (ide->block_total == 0)
+                /* A reset cleared the block bookkeeping mid-command - abort
+                   rather than sit in DRQ transferring nothing. */
+                err = ABRT_ERR;
             else {
-                hdd_image_write(ide->hdd_num, ide_get_sector(ide), 1, (uint8_t *) ide->buffer);
-                ide->blockcount++;
-                if (ide->blockcount >= ide->blocksize || ide->tf->secount == 1) {
-                    ide->blockcount = 0;
-                    ide_irq_raise(ide);
+                uint32_t cnt = ide->block_total >> 9;
+
+                /* The host has filled the whole block, so move it to the
+                   image with a single write. */
+                hdd_image_write(ide->hdd_num, ide_get_sector(ide), cnt, (uint8_t *) ide->buffer);
+                ide_irq_raise(ide);
+                for (uint32_t i = 0; i < cnt; i++) {
+                    ide->tf->secount--;
+                    if (ide->tf->secount)
+                        ide_next_sector(ide);
                 }
-                ide->tf->secount--;
                 if (ide->tf->secount) {
                     ide->tf->atastat = DRQ_STAT | DRDY_STAT | DSC_STAT;
                     ide->tf->pos     = 0;
-                    ide_next_sector(ide);
+                    ide->block_total = ide->tf->secount;
+                    if (ide->block_total > ide->blocksize)
+                        ide->block_total = ide->blocksize;
+                    ide->block_total <<= 9;
                 } else {
                     ide->tf->atastat = DRDY_STAT | DSC_STAT;
                     ui_sb_update_icon(SB_HDD | hdd[ide->hdd_num].bus, 0);
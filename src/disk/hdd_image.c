@@ -18,6 +18,7 @@
  */
 #define _GNU_SOURCE
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -31,6 +32,7 @@
 #include <86box/path.h>
 #include <86box/plat.h>
 #include <86box/random.h>
+#include <86box/thread.h>
 #include <86box/hdd.h>
 #include "minivhd/minivhd.h"
 #include "minivhd/internal.h"
@@ -39,6 +41,37 @@
 #define HDD_IMAGE_HDI 1
 #define HDD_IMAGE_HDX 2
 #define HDD_IMAGE_VHD 3
+#define HDD_IMAGE_86S 4
+
+/* Native sparse format: a 4K header, a cluster table of 32-bit entries
+   (0xffffffff = unallocated, reads as zeros), then densely packed 2 MB
+   clusters in allocation order. */
+#define HDD_86S_SIGNATURE       0x525053584f423638LL /* "86BOXSPR" */
+#define HDD_86S_VERSION         1
+#define HDD_86S_HEADER_SIZE     4096
+#define HDD_86S_CLUSTER_SIZE    (2 << 20)
+#define HDD_86S_CLUSTER_SECTORS (HDD_86S_CLUSTER_SIZE >> 9)
+#define HDD_86S_UNALLOCATED     0xffffffff
+
+#define HDD_IMAGE_IO_NONE      0
+#define HDD_IMAGE_IO_READ      1
+#define HDD_IMAGE_IO_WRITE     2
+#define HDD_IMAGE_IO_READAHEAD 3
+#define HDD_IMAGE_IO_FLUSH     4
+#define HDD_IMAGE_IO_EXIT      5
+
+/* Block cache geometry - 64K blocks, LRU replacement. */
+#define HDD_CACHE_BLOCK_SECTORS 128
+#define HDD_CACHE_BLOCK_SIZE    (HDD_CACHE_BLOCK_SECTORS << 9)
+#define HDD_CACHE_TAG(s)        ((s) & ~(uint32_t) (HDD_CACHE_BLOCK_SECTORS - 1))
+
+typedef struct hdd_cache_block_t {
+    uint32_t tag; /* First sector of the cached block. */
+    uint32_t lru;
+    uint8_t  valid;
+    uint8_t  dirty; /* Write-back mode only - block holds data not yet on disk. */
+    uint8_t *data;
+} hdd_cache_block_t;
 
 typedef struct hdd_image_t {
     FILE     *file; /* Used for HDD_IMAGE_RAW, HDD_IMAGE_HDI, and HDD_IMAGE_HDX. */
@@ -46,15 +79,70 @@ typedef struct hdd_image_t {
     uint32_t  base;
     uint32_t  pos;
     uint32_t  last_sector;
-    uint8_t   type; /* HDD_IMAGE_RAW, HDD_IMAGE_HDI, HDD_IMAGE_HDX, or HDD_IMAGE_VHD */
+    uint8_t   type; /* HDD_IMAGE_RAW, HDD_IMAGE_HDI, HDD_IMAGE_HDX, HDD_IMAGE_VHD, or HDD_IMAGE_86S */
     uint8_t   loaded;
+
+    /* Queued I/O - one request in flight per image, serviced by a dedicated
+       thread so a slow host volume does not stall the CPU thread. */
+    thread_t  *io_thread;
+    event_t   *io_wake;
+    event_t   *io_idle;
+    uint8_t    io_op;
+    uint32_t   io_sector;
+    uint32_t   io_count;
+    uint8_t   *io_buffer;
+    atomic_int io_busy;
+
+    /* LRU block cache with sequential read-ahead. */
+    hdd_cache_block_t *cache;
+    uint32_t           cache_blocks;
+    uint32_t           cache_tick;
+    uint32_t           seq_next;
+    uint8_t           *ra_buffer;
+    uint32_t           ra_tag;
+    uint8_t            ra_valid;
+    uint8_t            cache_off;
+    uint32_t           dirty_count;
+
+    /* Native sparse format state. */
+    uint32_t *spr_table;
+    uint32_t  spr_clusters;
+    uint32_t  spr_alloc;
+    uint64_t  spr_data_base;
+
+    /* Copy-on-write overlay state: unallocated overlay clusters read from a
+       shared read-only base image, writes allocate a private copy. */
+    FILE     *cow_file;
+    uint32_t *cow_table; /* Cluster table if the base is itself an 86S image. */
+    uint32_t  cow_clusters;
+    uint64_t  cow_data_base;
+    uint64_t  cow_size; /* Base size in bytes - reads past it return zeros. */
 } hdd_image_t;
 
 hdd_image_t hdd_images[HDD_NUM];
 
+/* Per-image block cache size in megabytes, 0 disables the cache. */
+int hdd_cache_size = 4;
+
+/* Opt-in write-back mode: guest writes accumulate in dirty cache blocks and
+   are flushed in tag order by the image's I/O thread. */
+int hdd_writeback = 0;
+
 static char  empty_sector[512];
 static char *empty_sector_1mb;
 
+static void hdd_image_io_drain(uint8_t id);
+static void hdd_image_io_stop(uint8_t id);
+static void hdd_image_cache_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
+static void hdd_image_cache_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
+static void hdd_image_cache_invalidate(uint8_t id, uint32_t sector, uint32_t count);
+static void hdd_image_cache_flush_direct(uint8_t id);
+static void hdd_image_cache_free(uint8_t id);
+static int  hdd_image_86s_create(uint8_t id, uint64_t full_size);
+static int  hdd_image_86s_load(uint8_t id, uint64_t *full_size);
+static void hdd_image_86s_close(uint8_t id);
+static int  hdd_image_cow_open(uint8_t id, const char *fn);
+
 #ifdef ENABLE_HDD_IMAGE_LOG
 int hdd_image_do_log = ENABLE_HDD_IMAGE_LOG;
 
@@ -137,6 +225,29 @@ image_is_vhd(const char *s, int check_signature)
         return 0;
 }
 
+int
+image_is_86s(const char *s, int check_signature)
+{
+    FILE    *fp;
+    uint64_t signature;
+
+    if (!strcasecmp(path_get_extension((char *) s), "86S")) {
+        if (check_signature) {
+            fp = plat_fopen(s, "rb");
+            if (!fp)
+                return 0;
+            if (fread(&signature, 1, 8, fp) != 8) {
+                fclose(fp);
+                return 0;
+            }
+            fclose(fp);
+            return (signature == HDD_86S_SIGNATURE) ? 1 : 0;
+        } else
+            return 1;
+    } else
+        return 0;
+}
+
 void
 hdd_image_calc_chs(uint32_t *c, uint32_t *h, uint32_t *s, uint32_t size)
 {
@@ -247,6 +358,7 @@ hdd_image_load(int id)
     char    *fn        = hdd[id].fn;
     int      is_hdx[2] = { 0, 0 };
     int      is_vhd[2] = { 0, 0 };
+    int      is_86s[2] = { 0, 0 };
     int      vhd_error = 0;
 
     memset(empty_sector, 0, sizeof(empty_sector));
@@ -257,6 +369,9 @@ hdd_image_load(int id)
     hdd_images[id].base = 0;
 
     if (hdd_images[id].loaded) {
+        hdd_image_io_stop(id);
+        hdd_image_cache_free(id);
+        hdd_image_86s_close(id);
         if (hdd_images[id].file) {
             fclose(hdd_images[id].file);
             hdd_images[id].file = NULL;
@@ -273,6 +388,9 @@ hdd_image_load(int id)
     is_vhd[0] = image_is_vhd(fn, 0);
     is_vhd[1] = image_is_vhd(fn, 1);
 
+    is_86s[0] = image_is_86s(fn, 0);
+    is_86s[1] = image_is_86s(fn, 1);
+
     hdd_images[id].pos = 0;
 
     /* Try to open existing hard disk image */
@@ -364,6 +482,28 @@ retry_vhd:
                     hdd_images[id].type = HDD_IMAGE_VHD;
 
                     return 1;
+                } else if (is_86s[0]) {
+                    full_size = ((uint64_t) hdd[id].spt) * ((uint64_t) hdd[id].hpc) * ((uint64_t) hdd[id].tracks) << 9LL;
+                    if (!hdd_image_86s_create(id, full_size)) {
+                        hdd_image_log("86S: Unable to create sparse image\n");
+                        fclose(hdd_images[id].file);
+                        hdd_images[id].file = NULL;
+                        memset(hdd[id].fn, 0, sizeof(hdd[id].fn));
+                        return 0;
+                    }
+                    hdd_images[id].type        = HDD_IMAGE_86S;
+                    hdd_images[id].last_sector = (uint32_t) (full_size >> 9) - 1;
+                    hdd_images[id].loaded      = 1;
+
+                    /* Don't lock out if the base of a COW overlay doesn't exist. */
+                    if (hdd[id].cow_base[0] && !hdd_image_cow_open(id, hdd[id].cow_base)) {
+                        pclog("hdd_image_load(): 86S: Could not open base image '%s'\n", hdd[id].cow_base);
+                        hdd[id].cow_base[0] = '\0';
+                    }
+
+                    /* Unallocated clusters read back as zeroed sectors (or the
+                       base image), so there is nothing to pre-fill here. */
+                    return 1;
                 } else {
                     hdd_images[id].type = HDD_IMAGE_RAW;
                 }
@@ -465,6 +605,32 @@ retry_vhd:
                image, which means that by definition, all valid sectors
                are there. */
             hdd_images[id].last_sector = (uint32_t) (full_size >> 9) - 1;
+            hdd_images[id].loaded      = 1;
+            return 1;
+        } else if (is_86s[1]) {
+            if (!hdd_image_86s_load(id, &full_size)) {
+                hdd_image_log("86S: Invalid or unsupported sparse image header\n");
+                fclose(hdd_images[id].file);
+                hdd_images[id].file = NULL;
+                memset(hdd[id].fn, 0, sizeof(hdd[id].fn));
+                return 0;
+            }
+            hdd_images[id].type        = HDD_IMAGE_86S;
+            /* The header stores the full virtual size, so all sectors are
+               valid regardless of how many clusters are actually allocated. */
+            hdd_images[id].last_sector = (uint32_t) (full_size >> 9) - 1;
+
+            /* An overlay without its base would read back zeros for every
+               cluster the guest has not yet written - refuse to mount. */
+            if (hdd[id].cow_base[0] && !hdd_image_cow_open(id, hdd[id].cow_base)) {
+                hdd_image_log("86S: Could not open base image\n");
+                hdd_image_86s_close(id);
+                fclose(hdd_images[id].file);
+                hdd_images[id].file = NULL;
+                memset(hdd[id].fn, 0, sizeof(hdd[id].fn));
+                return 0;
+            }
+
             hdd_images[id].loaded      = 1;
             return 1;
         } else {
@@ -493,19 +659,353 @@ hdd_image_seek(uint8_t id, uint32_t sector)
     off64_t addr = sector;
     addr         = (uint64_t) sector << 9LL;
 
+    hdd_image_io_drain(id);
+
     hdd_images[id].pos = sector;
-    if (hdd_images[id].type != HDD_IMAGE_VHD) {
+    if ((hdd_images[id].type != HDD_IMAGE_VHD) && (hdd_images[id].type != HDD_IMAGE_86S)) {
         if (fseeko64(hdd_images[id].file, addr + hdd_images[id].base, SEEK_SET) == -1)
             fatal("hdd_image_seek(): Error seeking\n");
     }
 }
 
-void
-hdd_image_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+static uint32_t
+hdd_image_86s_table_bytes(uint32_t clusters)
+{
+    return ((clusters * 4) + (HDD_86S_HEADER_SIZE - 1)) & ~(uint32_t) (HDD_86S_HEADER_SIZE - 1);
+}
+
+static int
+hdd_image_86s_create(uint8_t id, uint64_t full_size)
+{
+    hdd_image_t *img       = &hdd_images[id];
+    uint64_t     signature = HDD_86S_SIGNATURE;
+    uint32_t     version   = HDD_86S_VERSION;
+    uint32_t     cluster_size = HDD_86S_CLUSTER_SIZE;
+    uint32_t     clusters  = (uint32_t) ((full_size + HDD_86S_CLUSTER_SIZE - 1) / HDD_86S_CLUSTER_SIZE);
+    uint8_t      pad[HDD_86S_HEADER_SIZE];
+
+    img->spr_table = (uint32_t *) malloc(hdd_image_86s_table_bytes(clusters));
+    if (img->spr_table == NULL)
+        return 0;
+    memset(img->spr_table, 0xff, hdd_image_86s_table_bytes(clusters));
+
+    fwrite(&signature, 1, 8, img->file);
+    fwrite(&version, 1, 4, img->file);
+    fwrite(&cluster_size, 1, 4, img->file);
+    fwrite(&full_size, 1, 8, img->file);
+    memset(pad, 0x00, sizeof(pad));
+    fwrite(pad, 1, HDD_86S_HEADER_SIZE - 24, img->file);
+    fwrite(img->spr_table, 1, hdd_image_86s_table_bytes(clusters), img->file);
+    fflush(img->file);
+
+    img->spr_clusters  = clusters;
+    img->spr_alloc     = 0;
+    img->spr_data_base = HDD_86S_HEADER_SIZE + hdd_image_86s_table_bytes(clusters);
+
+    return 1;
+}
+
+static int
+hdd_image_86s_load(uint8_t id, uint64_t *full_size)
+{
+    hdd_image_t *img = &hdd_images[id];
+    uint64_t     signature;
+    uint64_t     disk_size;
+    uint32_t     version;
+    uint32_t     cluster_size;
+    uint32_t     clusters;
+
+    if (fseeko64(img->file, 0, SEEK_SET) == -1)
+        return 0;
+    if (fread(&signature, 1, 8, img->file) != 8)
+        return 0;
+    if (fread(&version, 1, 4, img->file) != 4)
+        return 0;
+    if (fread(&cluster_size, 1, 4, img->file) != 4)
+        return 0;
+    if (fread(&disk_size, 1, 8, img->file) != 8)
+        return 0;
+
+    if ((signature != HDD_86S_SIGNATURE) || (version != HDD_86S_VERSION)
+        || (cluster_size != HDD_86S_CLUSTER_SIZE) || (disk_size == 0))
+        return 0;
+
+    clusters       = (uint32_t) ((disk_size + HDD_86S_CLUSTER_SIZE - 1) / HDD_86S_CLUSTER_SIZE);
+    img->spr_table = (uint32_t *) malloc(hdd_image_86s_table_bytes(clusters));
+    if (img->spr_table == NULL)
+        return 0;
+
+    if (fseeko64(img->file, HDD_86S_HEADER_SIZE, SEEK_SET) == -1)
+        goto fail;
+    if (fread(img->spr_table, 1, clusters * 4, img->file) != (clusters * 4))
+        goto fail;
+
+    img->spr_alloc = 0;
+    for (uint32_t i = 0; i < clusters; i++) {
+        if ((img->spr_table[i] != HDD_86S_UNALLOCATED) && (img->spr_table[i] >= img->spr_alloc))
+            img->spr_alloc = img->spr_table[i] + 1;
+    }
+
+    img->spr_clusters  = clusters;
+    img->spr_data_base = HDD_86S_HEADER_SIZE + hdd_image_86s_table_bytes(clusters);
+    *full_size         = disk_size;
+
+    return 1;
+
+fail:
+    free(img->spr_table);
+    img->spr_table = NULL;
+    return 0;
+}
+
+static void
+hdd_image_86s_close(uint8_t id)
+{
+    free(hdd_images[id].spr_table);
+    hdd_images[id].spr_table    = NULL;
+    hdd_images[id].spr_clusters = 0;
+    hdd_images[id].spr_alloc    = 0;
+
+    if (hdd_images[id].cow_file != NULL) {
+        fclose(hdd_images[id].cow_file);
+        hdd_images[id].cow_file = NULL;
+    }
+    free(hdd_images[id].cow_table);
+    hdd_images[id].cow_table    = NULL;
+    hdd_images[id].cow_clusters = 0;
+    hdd_images[id].cow_size     = 0;
+}
+
+static int
+hdd_image_cow_open(uint8_t id, const char *fn)
+{
+    hdd_image_t *img = &hdd_images[id];
+    uint64_t     signature = 0;
+    uint64_t     disk_size;
+    uint32_t     version;
+    uint32_t     cluster_size;
+
+    /* Open read-only so dozens of VM processes running off the same base
+       image share a single host page cache copy. */
+    img->cow_file = plat_fopen(fn, "rb");
+    if (img->cow_file == NULL)
+        return 0;
+
+    if ((fread(&signature, 1, 8, img->cow_file) == 8) && (signature == HDD_86S_SIGNATURE)) {
+        /* 86S base - load its cluster table. */
+        if (fread(&version, 1, 4, img->cow_file) != 4)
+            goto fail;
+        if (fread(&cluster_size, 1, 4, img->cow_file) != 4)
+            goto fail;
+        if (fread(&disk_size, 1, 8, img->cow_file) != 8)
+            goto fail;
+        if ((version != HDD_86S_VERSION) || (cluster_size != HDD_86S_CLUSTER_SIZE) || (disk_size == 0))
+            goto fail;
+
+        img->cow_clusters = (uint32_t) ((disk_size + HDD_86S_CLUSTER_SIZE - 1) / HDD_86S_CLUSTER_SIZE);
+        img->cow_table    = (uint32_t *) malloc(hdd_image_86s_table_bytes(img->cow_clusters));
+        if (img->cow_table == NULL)
+            goto fail;
+        if (fseeko64(img->cow_file, HDD_86S_HEADER_SIZE, SEEK_SET) == -1)
+            goto fail;
+        if (fread(img->cow_table, 1, img->cow_clusters * 4, img->cow_file) != (img->cow_clusters * 4))
+            goto fail;
+
+        img->cow_data_base = HDD_86S_HEADER_SIZE + hdd_image_86s_table_bytes(img->cow_clusters);
+        img->cow_size      = disk_size;
+    } else {
+        /* Raw base. */
+        if (fseeko64(img->cow_file, 0, SEEK_END) == -1)
+            goto fail;
+        img->cow_size = (uint64_t) ftello64(img->cow_file);
+        if (img->cow_size == 0)
+            goto fail;
+    }
+
+    return 1;
+
+fail:
+    fclose(img->cow_file);
+    img->cow_file = NULL;
+    free(img->cow_table);
+    img->cow_table = NULL;
+    return 0;
+}
+
+/* Read from the base image; sectors past its end return zeros. */
+static void
+hdd_image_cow_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    while (count > 0) {
+        uint32_t n = count;
+        off64_t  addr;
+
+        if (((uint64_t) sector << 9) >= img->cow_size) {
+            memset(buffer, 0x00, (uint64_t) count << 9);
+            return;
+        }
+
+        if (n > ((uint32_t) ((img->cow_size + 511) >> 9) - sector))
+            n = (uint32_t) ((img->cow_size + 511) >> 9) - sector;
+
+        if (img->cow_table != NULL) {
+            /* 86S base - resolve through its cluster table. */
+            uint32_t c   = sector / HDD_86S_CLUSTER_SECTORS;
+            uint32_t off = sector % HDD_86S_CLUSTER_SECTORS;
+
+            if (n > (HDD_86S_CLUSTER_SECTORS - off))
+                n = HDD_86S_CLUSTER_SECTORS - off;
+
+            if ((c >= img->cow_clusters) || (img->cow_table[c] == HDD_86S_UNALLOCATED)) {
+                memset(buffer, 0x00, n << 9);
+                buffer += n << 9;
+                sector += n;
+                count -= n;
+                continue;
+            }
+
+            addr = img->cow_data_base + ((uint64_t) img->cow_table[c] * HDD_86S_CLUSTER_SIZE) + ((uint64_t) off << 9);
+        } else
+            addr = (uint64_t) sector << 9;
+
+        if (fseeko64(img->cow_file, addr, SEEK_SET) == -1)
+            fatal("Hard disk image %i: Base image read error during seek\n", id);
+        if (fread(buffer, 512, n, img->cow_file) != n)
+            memset(buffer, 0x00, n << 9);
+
+        buffer += n << 9;
+        sector += n;
+        count -= n;
+    }
+}
+
+static int
+hdd_image_86s_is_zero(const uint8_t *buffer, uint32_t len)
+{
+    const uint64_t *p = (const uint64_t *) buffer;
+
+    for (uint32_t i = 0; i < (len >> 3); i++) {
+        if (p[i] != 0)
+            return 0;
+    }
+
+    return 1;
+}
+
+static void
+hdd_image_86s_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    while (count > 0) {
+        uint32_t c   = sector / HDD_86S_CLUSTER_SECTORS;
+        uint32_t off = sector % HDD_86S_CLUSTER_SECTORS;
+        uint32_t n   = HDD_86S_CLUSTER_SECTORS - off;
+
+        if (n > count)
+            n = count;
+
+        if ((c >= img->spr_clusters) || (img->spr_table[c] == HDD_86S_UNALLOCATED)) {
+            if (img->cow_file != NULL)
+                hdd_image_cow_read(id, sector, n, buffer);
+            else
+                memset(buffer, 0x00, n << 9);
+        } else {
+            off64_t addr = img->spr_data_base + ((uint64_t) img->spr_table[c] * HDD_86S_CLUSTER_SIZE) + ((uint64_t) off << 9);
+
+            if (fseeko64(img->file, addr, SEEK_SET) == -1)
+                fatal("Hard disk image %i: Sparse read error during seek\n", id);
+            if (fread(buffer, 512, n, img->file) != n)
+                memset(buffer, 0x00, n << 9);
+        }
+
+        buffer += n << 9;
+        sector += n;
+        count -= n;
+    }
+
+    img->pos = sector;
+}
+
+static void
+hdd_image_86s_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    while (count > 0) {
+        uint32_t c   = sector / HDD_86S_CLUSTER_SECTORS;
+        uint32_t off = sector % HDD_86S_CLUSTER_SECTORS;
+        uint32_t n   = HDD_86S_CLUSTER_SECTORS - off;
+        off64_t  addr;
+
+        if (n > count)
+            n = count;
+
+        if (c >= img->spr_clusters)
+            break;
+
+        if (img->spr_table[c] == HDD_86S_UNALLOCATED) {
+            /* Zeros written to an unallocated cluster change nothing - this
+               is what keeps mostly-zero images sparse. Does not apply with a
+               base image, where the cluster may hold base data. */
+            if ((img->cow_file == NULL) && hdd_image_86s_is_zero(buffer, n << 9)) {
+                buffer += n << 9;
+                sector += n;
+                count -= n;
+                continue;
+            }
+
+            img->spr_table[c] = img->spr_alloc++;
+
+            /* Fill the parts of the new cluster the write does not cover:
+               copy-on-write from the base image if there is one, zeros
+               otherwise. */
+            if ((off != 0) || (n < HDD_86S_CLUSTER_SECTORS) || (img->cow_file != NULL)) {
+                uint8_t *fill = (uint8_t *) calloc(1, HDD_86S_CLUSTER_SIZE);
+
+                if (fill == NULL)
+                    fatal("Hard disk image %i: Sparse cluster allocation failed\n", id);
+                if (img->cow_file != NULL)
+                    hdd_image_cow_read(id, c * HDD_86S_CLUSTER_SECTORS, HDD_86S_CLUSTER_SECTORS, fill);
+                addr = img->spr_data_base + ((uint64_t) img->spr_table[c] * HDD_86S_CLUSTER_SIZE);
+                if (fseeko64(img->file, addr, SEEK_SET) == -1)
+                    fatal("Hard disk image %i: Sparse write error during seek\n", id);
+                fwrite(fill, 1, HDD_86S_CLUSTER_SIZE, img->file);
+                free(fill);
+            }
+
+            /* Persist the new table entry. */
+            if (fseeko64(img->file, HDD_86S_HEADER_SIZE + ((uint64_t) c * 4), SEEK_SET) == -1)
+                fatal("Hard disk image %i: Sparse write error during seek\n", id);
+            fwrite(&img->spr_table[c], 1, 4, img->file);
+        }
+
+        addr = img->spr_data_base + ((uint64_t) img->spr_table[c] * HDD_86S_CLUSTER_SIZE) + ((uint64_t) off << 9);
+        if (fseeko64(img->file, addr, SEEK_SET) == -1)
+            fatal("Hard disk image %i: Sparse write error during seek\n", id);
+        fwrite(buffer, 512, n, img->file);
+
+        buffer += n << 9;
+        sector += n;
+        count -= n;
+    }
+
+    img->pos = sector;
+}
+
+static void
+hdd_image_read_direct(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
 {
     int    non_transferred_sectors;
     size_t num_read;
 
+    if (hdd_images[id].type == HDD_IMAGE_86S) {
+        hdd_image_86s_read(id, sector, count, buffer);
+        return;
+    }
+
     if (hdd_images[id].type == HDD_IMAGE_VHD) {
         non_transferred_sectors = mvhd_read_sectors(hdd_images[id].vhd, sector, count, buffer);
         hdd_images[id].pos      = sector + count - non_transferred_sectors - 1;
@@ -520,6 +1020,14 @@ hdd_image_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
     }
 }
 
+void
+hdd_image_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_io_drain(id);
+
+    hdd_image_cache_read(id, sector, count, buffer);
+}
+
 uint32_t
 hdd_image_get_last_sector(uint8_t id)
 {
@@ -548,12 +1056,17 @@ hdd_image_read_ex(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
     return 0;
 }
 
-void
-hdd_image_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+static void
+hdd_image_write_direct(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
 {
     int    non_transferred_sectors;
     size_t num_write;
 
+    if (hdd_images[id].type == HDD_IMAGE_86S) {
+        hdd_image_86s_write(id, sector, count, buffer);
+        return;
+    }
+
     if (hdd_images[id].type == HDD_IMAGE_VHD) {
         non_transferred_sectors = mvhd_write_sectors(hdd_images[id].vhd, sector, count, buffer);
         hdd_images[id].pos      = sector + count - non_transferred_sectors - 1;
@@ -568,6 +1081,470 @@ hdd_image_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
     }
 }
 
+void
+hdd_image_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_io_drain(id);
+
+    if (hdd_writeback) {
+        hdd_image_cache_write(id, sector, count, buffer);
+        return;
+    }
+
+    hdd_image_cache_invalidate(id, sector, count);
+
+    hdd_image_write_direct(id, sector, count, buffer);
+}
+
+static void
+hdd_image_io_thread(void *priv)
+{
+    hdd_image_t *img = (hdd_image_t *) priv;
+    uint8_t      id  = (uint8_t) (img - hdd_images);
+
+    while (1) {
+        thread_wait_event(img->io_wake, -1);
+        thread_reset_event(img->io_wake);
+
+        if (img->io_op == HDD_IMAGE_IO_EXIT)
+            break;
+
+        if (img->io_op == HDD_IMAGE_IO_READ)
+            hdd_image_read_direct(id, img->io_sector, img->io_count, img->io_buffer);
+        else if (img->io_op == HDD_IMAGE_IO_WRITE)
+            hdd_image_write_direct(id, img->io_sector, img->io_count, img->io_buffer);
+        else if (img->io_op == HDD_IMAGE_IO_READAHEAD) {
+            hdd_image_read_direct(id, img->io_sector, img->io_count, img->ra_buffer);
+            img->ra_valid = 1;
+        } else if (img->io_op == HDD_IMAGE_IO_FLUSH)
+            hdd_image_cache_flush_direct(id);
+
+        img->io_op = HDD_IMAGE_IO_NONE;
+        atomic_store(&img->io_busy, 0);
+        thread_set_event(img->io_idle);
+    }
+
+    atomic_store(&img->io_busy, 0);
+    thread_set_event(img->io_idle);
+}
+
+/* Wait for the in-flight request, if any, so synchronous accesses and
+   teardown never overlap the I/O thread. */
+static void
+hdd_image_io_drain(uint8_t id)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if ((img->io_thread != NULL) && atomic_load(&img->io_busy))
+        thread_wait_event(img->io_idle, -1);
+}
+
+static void
+hdd_image_io_queue(uint8_t id, uint8_t op, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if (img->io_thread == NULL) {
+        img->io_wake   = thread_create_event();
+        img->io_idle   = thread_create_event();
+        img->io_thread = thread_create(hdd_image_io_thread, img);
+    }
+
+    hdd_image_io_drain(id);
+
+    img->io_op     = op;
+    img->io_sector = sector;
+    img->io_count  = count;
+    img->io_buffer = buffer;
+    thread_reset_event(img->io_idle);
+    atomic_store(&img->io_busy, 1);
+    thread_set_event(img->io_wake);
+}
+
+static void
+hdd_image_io_stop(uint8_t id)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if (img->io_thread == NULL)
+        return;
+
+    hdd_image_io_drain(id);
+
+    img->io_op = HDD_IMAGE_IO_EXIT;
+    thread_reset_event(img->io_idle);
+    atomic_store(&img->io_busy, 1);
+    thread_set_event(img->io_wake);
+    thread_wait(img->io_thread);
+
+    thread_destroy_event(img->io_wake);
+    thread_destroy_event(img->io_idle);
+    img->io_thread = NULL;
+    img->io_wake   = NULL;
+    img->io_idle   = NULL;
+}
+
+void
+hdd_image_read_queued(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_io_queue(id, HDD_IMAGE_IO_READ, sector, count, buffer);
+}
+
+void
+hdd_image_write_queued(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_io_drain(id);
+
+    if (hdd_writeback) {
+        /* Absorbing the write into dirty blocks is a memcpy - no need to
+           bounce it through the I/O thread. */
+        hdd_image_cache_write(id, sector, count, buffer);
+        return;
+    }
+
+    hdd_image_cache_invalidate(id, sector, count);
+
+    hdd_image_io_queue(id, HDD_IMAGE_IO_WRITE, sector, count, buffer);
+}
+
+int
+hdd_image_queued_done(uint8_t id)
+{
+    return (hdd_images[id].io_thread == NULL) || !atomic_load(&hdd_images[id].io_busy);
+}
+
+static hdd_cache_block_t *
+hdd_image_cache_lookup(hdd_image_t *img, uint32_t tag)
+{
+    for (uint32_t i = 0; i < img->cache_blocks; i++) {
+        if (img->cache[i].valid && (img->cache[i].tag == tag))
+            return &img->cache[i];
+    }
+
+    return NULL;
+}
+
+static hdd_cache_block_t *
+hdd_image_cache_victim(hdd_image_t *img)
+{
+    hdd_cache_block_t *victim = &img->cache[0];
+
+    for (uint32_t i = 0; i < img->cache_blocks; i++) {
+        if (!img->cache[i].valid)
+            return &img->cache[i];
+        if (img->cache[i].lru < victim->lru)
+            victim = &img->cache[i];
+    }
+
+    return victim;
+}
+
+/* Make a block reusable, writing it out first if it holds dirty data. */
+static void
+hdd_image_cache_evict(uint8_t id, hdd_cache_block_t *blk)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if (blk->valid && blk->dirty) {
+        uint32_t blk_count = HDD_CACHE_BLOCK_SECTORS;
+
+        if ((img->last_sector - blk->tag + 1) < blk_count)
+            blk_count = img->last_sector - blk->tag + 1;
+
+        hdd_image_write_direct(id, blk->tag, blk_count, blk->data);
+        blk->dirty = 0;
+        img->dirty_count--;
+    }
+    blk->valid = 0;
+}
+
+/* Allocate the cache on first use; a failed allocation disables it. */
+static void
+hdd_image_cache_alloc(hdd_image_t *img)
+{
+    uint32_t blocks = ((uint32_t) hdd_cache_size << 20) / HDD_CACHE_BLOCK_SIZE;
+
+    img->cache_off = 1;
+    if ((hdd_cache_size <= 0) || (blocks == 0))
+        return;
+
+    img->cache = (hdd_cache_block_t *) calloc(blocks, sizeof(hdd_cache_block_t));
+    if (img->cache == NULL)
+        return;
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        img->cache[i].data = (uint8_t *) malloc(HDD_CACHE_BLOCK_SIZE);
+        if (img->cache[i].data == NULL) {
+            while (i-- > 0)
+                free(img->cache[i].data);
+            free(img->cache);
+            img->cache = NULL;
+            return;
+        }
+    }
+
+    img->ra_buffer = (uint8_t *) malloc(HDD_CACHE_BLOCK_SIZE);
+    if (img->ra_buffer == NULL) {
+        for (uint32_t i = 0; i < blocks; i++)
+            free(img->cache[i].data);
+        free(img->cache);
+        img->cache = NULL;
+        return;
+    }
+
+    img->cache_blocks = blocks;
+    img->seq_next     = 0xffffffff;
+}
+
+static void
+hdd_image_cache_free(uint8_t id)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    hdd_image_cache_flush_direct(id);
+
+    if (img->cache != NULL) {
+        for (uint32_t i = 0; i < img->cache_blocks; i++)
+            free(img->cache[i].data);
+        free(img->cache);
+        img->cache = NULL;
+    }
+    free(img->ra_buffer);
+    img->ra_buffer    = NULL;
+    img->cache_blocks = 0;
+    img->ra_valid     = 0;
+    img->cache_off    = 0;
+}
+
+/* Promote a completed read-ahead block into the cache. The caller must have
+   drained the I/O thread. */
+static void
+hdd_image_cache_install_ra(uint8_t id)
+{
+    hdd_image_t       *img = &hdd_images[id];
+    hdd_cache_block_t *blk;
+    uint8_t           *tmp;
+
+    if (!img->ra_valid)
+        return;
+    img->ra_valid = 0;
+
+    if ((img->cache == NULL) || (hdd_image_cache_lookup(img, img->ra_tag) != NULL))
+        return;
+
+    blk = hdd_image_cache_victim(img);
+    hdd_image_cache_evict(id, blk);
+    tmp            = blk->data;
+    blk->data      = img->ra_buffer;
+    img->ra_buffer = tmp;
+    blk->tag       = img->ra_tag;
+    blk->valid     = 1;
+    blk->lru       = ++img->cache_tick;
+}
+
+/* Drop cached copies of sectors that are about to be rewritten. Dirty blocks
+   are written out first so their unaffected sectors are not lost. The caller
+   must have drained the I/O thread. */
+static void
+hdd_image_cache_invalidate(uint8_t id, uint32_t sector, uint32_t count)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if (img->cache == NULL)
+        return;
+
+    for (uint32_t i = 0; i < img->cache_blocks; i++) {
+        if (img->cache[i].valid && (img->cache[i].tag < (sector + count))
+            && ((img->cache[i].tag + HDD_CACHE_BLOCK_SECTORS) > sector))
+            hdd_image_cache_evict(id, &img->cache[i]);
+    }
+
+    if (img->ra_valid && (img->ra_tag < (sector + count))
+        && ((img->ra_tag + HDD_CACHE_BLOCK_SECTORS) > sector))
+        img->ra_valid = 0;
+}
+
+static void
+hdd_image_cache_read(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t       *img = &hdd_images[id];
+    hdd_cache_block_t *blk;
+    int                seq = (sector == img->seq_next);
+
+    if ((img->cache == NULL) && !img->cache_off)
+        hdd_image_cache_alloc(img);
+
+    if (img->cache == NULL) {
+        hdd_image_read_direct(id, sector, count, buffer);
+        return;
+    }
+
+    img->seq_next = sector + count;
+
+    hdd_image_cache_install_ra(id);
+
+    while (count > 0) {
+        uint32_t tag = HDD_CACHE_TAG(sector);
+        uint32_t off = sector - tag;
+        uint32_t n   = HDD_CACHE_BLOCK_SECTORS - off;
+
+        if (n > count)
+            n = count;
+
+        if (tag > img->last_sector) {
+            /* Out-of-range access - let the raw path produce whatever it
+               would have produced before. */
+            hdd_image_read_direct(id, sector, count, buffer);
+            return;
+        }
+
+        blk = hdd_image_cache_lookup(img, tag);
+        if (blk == NULL) {
+            uint32_t blk_count = HDD_CACHE_BLOCK_SECTORS;
+
+            if ((img->last_sector - tag + 1) < blk_count)
+                blk_count = img->last_sector - tag + 1;
+
+            blk = hdd_image_cache_victim(img);
+            hdd_image_cache_evict(id, blk);
+            hdd_image_read_direct(id, tag, blk_count, blk->data);
+            blk->tag   = tag;
+            blk->valid = 1;
+        }
+        blk->lru = ++img->cache_tick;
+
+        memcpy(buffer, blk->data + (off << 9), n << 9);
+        buffer += n << 9;
+        sector += n;
+        count -= n;
+    }
+
+    /* Sequential stream - pull the next block in on the I/O thread so it is
+       already here when the guest asks for it. */
+    if (seq && !img->ra_valid) {
+        uint32_t tag = HDD_CACHE_TAG(img->seq_next);
+
+        if ((tag <= img->last_sector) && (hdd_image_cache_lookup(img, tag) == NULL)) {
+            uint32_t blk_count = HDD_CACHE_BLOCK_SECTORS;
+
+            if ((img->last_sector - tag + 1) < blk_count)
+                blk_count = img->last_sector - tag + 1;
+
+            img->ra_tag = tag;
+            hdd_image_io_queue(id, HDD_IMAGE_IO_READAHEAD, tag, blk_count, NULL);
+        }
+    }
+}
+
+/* Write-back mode: absorb the write into dirty cache blocks. The caller must
+   have drained the I/O thread. */
+static void
+hdd_image_cache_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
+{
+    hdd_image_t       *img = &hdd_images[id];
+    hdd_cache_block_t *blk;
+
+    if ((img->cache == NULL) && !img->cache_off)
+        hdd_image_cache_alloc(img);
+
+    if (img->cache == NULL) {
+        hdd_image_write_direct(id, sector, count, buffer);
+        return;
+    }
+
+    hdd_image_cache_install_ra(id);
+
+    while (count > 0) {
+        uint32_t tag = HDD_CACHE_TAG(sector);
+        uint32_t off = sector - tag;
+        uint32_t n   = HDD_CACHE_BLOCK_SECTORS - off;
+
+        if (n > count)
+            n = count;
+
+        if (tag > img->last_sector) {
+            hdd_image_write_direct(id, sector, count, buffer);
+            return;
+        }
+
+        blk = hdd_image_cache_lookup(img, tag);
+        if (blk == NULL) {
+            uint32_t blk_count = HDD_CACHE_BLOCK_SECTORS;
+
+            if ((img->last_sector - tag + 1) < blk_count)
+                blk_count = img->last_sector - tag + 1;
+
+            blk = hdd_image_cache_victim(img);
+            hdd_image_cache_evict(id, blk);
+            /* A partial block needs its current contents under the write. */
+            if ((off != 0) || (n < blk_count))
+                hdd_image_read_direct(id, tag, blk_count, blk->data);
+            blk->tag   = tag;
+            blk->valid = 1;
+        }
+
+        memcpy(blk->data + (off << 9), buffer, n << 9);
+        if (!blk->dirty) {
+            blk->dirty = 1;
+            img->dirty_count++;
+        }
+        blk->lru = ++img->cache_tick;
+
+        buffer += n << 9;
+        sector += n;
+        count -= n;
+    }
+
+    img->pos = sector;
+
+    /* Bound the amount of unwritten data - flush on the I/O thread once half
+       the cache is dirty. */
+    if (img->dirty_count >= (img->cache_blocks >> 1))
+        hdd_image_io_queue(id, HDD_IMAGE_IO_FLUSH, 0, 0, NULL);
+}
+
+/* Write dirty blocks back in ascending tag order so adjacent guest writes
+   coalesce into one sequential pass over the host file. Runs on the I/O
+   thread for the bounded-dirty flush and on the CPU thread for explicit
+   flushes and teardown. */
+static void
+hdd_image_cache_flush_direct(uint8_t id)
+{
+    hdd_image_t *img = &hdd_images[id];
+
+    if (img->cache == NULL)
+        return;
+
+    while (img->dirty_count > 0) {
+        hdd_cache_block_t *best = NULL;
+        uint32_t           blk_count;
+
+        for (uint32_t i = 0; i < img->cache_blocks; i++) {
+            if (img->cache[i].valid && img->cache[i].dirty
+                && ((best == NULL) || (img->cache[i].tag < best->tag)))
+                best = &img->cache[i];
+        }
+        if (best == NULL)
+            break;
+
+        blk_count = HDD_CACHE_BLOCK_SECTORS;
+        if ((img->last_sector - best->tag + 1) < blk_count)
+            blk_count = img->last_sector - best->tag + 1;
+
+        hdd_image_write_direct(id, best->tag, blk_count, best->data);
+        best->dirty = 0;
+        img->dirty_count--;
+    }
+}
+
+void
+hdd_image_flush(uint8_t id)
+{
+    hdd_image_io_drain(id);
+
+    hdd_image_cache_flush_direct(id);
+}
+
 int
 hdd_image_write_ex(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
 {
@@ -587,7 +1564,16 @@ hdd_image_write_ex(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer)
 void
 hdd_image_zero(uint8_t id, uint32_t sector, uint32_t count)
 {
-    if (hdd_images[id].type == HDD_IMAGE_VHD) {
+    hdd_image_io_drain(id);
+    hdd_image_cache_invalidate(id, sector, count);
+
+    if (hdd_images[id].type == HDD_IMAGE_86S) {
+        memset(empty_sector, 0, 512);
+
+        /* Zeroing unallocated clusters is a no-op, so the image stays sparse. */
+        for (uint32_t i = 0; i < count; i++)
+            hdd_image_86s_write(id, sector + i, 1, (uint8_t *) empty_sector);
+    } else if (hdd_images[id].type == HDD_IMAGE_VHD) {
         int non_transferred_sectors = mvhd_format_sectors(hdd_images[id].vhd, sector, count);
         hdd_images[id].pos          = sector + count - non_transferred_sectors - 1;
     } else {
@@ -642,6 +1628,10 @@ hdd_image_unload(uint8_t id, UNUSED(int fn_preserve))
     if (strlen(hdd[id].fn) == 0)
         return;
 
+    hdd_image_io_stop(id);
+    hdd_image_cache_free(id);
+    hdd_image_86s_close(id);
+
     if (hdd_images[id].loaded) {
         if (hdd_images[id].file != NULL) {
             fclose(hdd_images[id].file);
@@ -666,6 +1656,10 @@ hdd_image_close(uint8_t id)
     if (!hdd_images[id].loaded)
         return;
 
+    hdd_image_io_stop(id);
+    hdd_image_cache_free(id);
+    hdd_image_86s_close(id);
+
     if (hdd_images[id].file != NULL) {
         fclose(hdd_images[id].file);
         hdd_images[id].file = NULL;
@@ -231,7 +231,9 @@ mvhd_create_fixed(const char* path, MVHDGeom geom, int* err, mvhd_progress_callb
 MVHDMeta*
 mvhd_create_fixed_raw(const char* path, FILE* raw_img, uint64_t size_in_bytes, MVHDGeom* geom, int* err, mvhd_progress_callback progress_callback)
 {
-    uint8_t img_data[MVHD_SECTOR_SIZE] = {0};
+    /* Sectors are copied in chunks of this size: a stdio call per sector
+       makes creating multi-GB fixed images take minutes. */
+    uint8_t img_data[MVHD_SECTOR_SIZE * 64] = {0};
     uint8_t footer_buff[MVHD_FOOTER_SIZE] = {0};
 
     if (geom == NULL || (geom->cyl == 0 || geom->heads == 0 || geom->spt == 0)) {
@@ -252,7 +254,8 @@ mvhd_create_fixed_raw(const char* path, FILE* raw_img, uint64_t size_in_bytes, M
     mvhd_fseeko64(fp, 0, SEEK_SET);
 
     uint32_t size_sectors = (uint32_t)(size_in_bytes / MVHD_SECTOR_SIZE);
-    uint32_t s;
+    uint32_t chunk_sectors = sizeof img_data / MVHD_SECTOR_SIZE;
+    uint32_t s, n;
 
     if (progress_callback)
         progress_callback(0, size_sectors);
@@ -267,18 +270,26 @@ mvhd_create_fixed_raw(const char* path, FILE* raw_img, uint64_t size_in_bytes, M
         }
         gen_footer(&vhdm->footer, raw_size, geom, MVHD_TYPE_FIXED, 0);
         mvhd_fseeko64(raw_img, 0, SEEK_SET);
-        for (s = 0; s < size_sectors; s++) {
-            (void) !fread(img_data, sizeof img_data, 1, raw_img);
-            fwrite(img_data, sizeof img_data, 1, fp);
+        for (s = 0; s < size_sectors; s += n) {
+            n = size_sectors - s;
+            if (n > chunk_sectors) {
+                n = chunk_sectors;
+            }
+            (void) !fread(img_data, (size_t)MVHD_SECTOR_SIZE * n, 1, raw_img);
+            fwrite(img_data, (size_t)MVHD_SECTOR_SIZE * n, 1, fp);
             if (progress_callback)
-                progress_callback(s + 1, size_sectors);
+                progress_callback(s + n, size_sectors);
         }
     } else {
         gen_footer(&vhdm->footer, size_in_bytes, geom, MVHD_TYPE_FIXED, 0);
-        for (s = 0; s < size_sectors; s++) {
-            fwrite(img_data, sizeof img_data, 1, fp);
+        for (s = 0; s < size_sectors; s += n) {
+            n = size_sectors - s;
+            if (n > chunk_sectors) {
+                n = chunk_sectors;
+            }
+            fwrite(img_data, (size_t)MVHD_SECTOR_SIZE * n, 1, fp);
             if (progress_callback)
-                progress_callback(s + 1, size_sectors);
+                progress_callback(s + n, size_sectors);
         }
     }
     mvhd_footer_to_buffer(&vhdm->footer, footer_buff);
@@ -83,10 +83,17 @@ check_sectors(uint32_t offset, int num_sectors, uint32_t total_sectors, int* tra
 void
 mvhd_write_empty_sectors(FILE* f, int sector_count)
 {
-    uint8_t zero_bytes[MVHD_SECTOR_SIZE] = {0};
+    uint8_t zero_bytes[MVHD_SECTOR_SIZE * 64] = {0};
 
-    for (int i = 0; i < sector_count; i++) {
+    /* Write in multi-sector chunks. Block creation zero-fills an entire
+       data block (typically 4096 sectors) through this function, and one
+       stdio call per sector dominates the allocation time. */
+    while (sector_count >= 64) {
         fwrite(zero_bytes, sizeof zero_bytes, 1, f);
+        sector_count -= 64;
+    }
+    if (sector_count > 0) {
+        fwrite(zero_bytes, (size_t)MVHD_SECTOR_SIZE * sector_count, 1, f);
     }
 }
 
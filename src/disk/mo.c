@@ -39,6 +39,7 @@
 #include <86box/ui.h>
 #include <86box/hdc.h>
 #include <86box/hdc_ide.h>
+#include <86box/thread.h>
 #include <86box/mo.h>
 #include <86box/version.h>
 
@@ -323,7 +324,6 @@ mo_load_abort(mo_t *dev)
     dev->drv->fp           = NULL;
     dev->drv->medium_size = 0;
     dev->drv->sector_size = 0;
-    mo_eject(dev->id); /* Make sure the host OS knows we've rejected (and ejected) the image. */
     return 0;
 }
 
@@ -336,17 +336,17 @@ image_is_mdi(const char *s)
         return 0;
 }
 
-int
-mo_load(mo_t *dev, char *fn)
+/* Open, validate and probe an image; only touches the drive's file state,
+   so it is safe to run off the emulation thread. */
+static int
+mo_load_image(mo_t *dev, char *fn)
 {
     int          is_mdi;
     uint32_t     size  = 0;
     unsigned int found = 0;
 
-    if (!dev->drv) {
-        mo_eject(dev->id);
+    if (!dev->drv)
         return 0;
-    }
 
     is_mdi = image_is_mdi(fn);
 
@@ -391,6 +391,49 @@ mo_load(mo_t *dev, char *fn)
     return 1;
 }
 
+int
+mo_load(mo_t *dev, char *fn)
+{
+    int ret = mo_load_image(dev, fn);
+
+    if (!ret)
+        mo_eject(dev->id); /* Make sure the host OS knows we've rejected (and ejected) the image. */
+
+    return ret;
+}
+
+static void
+mo_load_thread(void *priv)
+{
+    mo_t *dev = (mo_t *) priv;
+
+    dev->load_state = mo_load_image(dev, dev->load_path) ? MO_LOAD_DONE : MO_LOAD_FAIL;
+}
+
+/* Start mounting an image on a worker thread; the drive reports itself as
+   becoming ready until the validation and geometry probe have finished.
+   The result is picked up on the emulation thread by the pre-execution
+   check, which is also where the host UI is notified of a failure. */
+void
+mo_load_async(mo_t *dev, char *fn)
+{
+    if (dev->load_state == MO_LOAD_BUSY)
+        return;
+
+    if (dev->load_thread) {
+        thread_wait(dev->load_thread);
+        dev->load_thread = NULL;
+    }
+
+    strncpy(dev->load_path, fn, sizeof(dev->load_path) - 1);
+    dev->load_path[sizeof(dev->load_path) - 1] = 0;
+    /* Record the path right away so a config save at mount time keeps it. */
+    strncpy(dev->drv->image_path, fn, sizeof(dev->drv->image_path) - 1);
+
+    dev->load_state  = MO_LOAD_BUSY;
+    dev->load_thread = thread_create(mo_load_thread, dev);
+}
+
 void
 mo_disk_reload(mo_t *dev)
 {
@@ -866,6 +909,15 @@ mo_not_ready(mo_t *dev)
     mo_cmd_error(dev);
 }
 
+static void
+mo_becoming_ready(mo_t *dev)
+{
+    mo_sense_key = SENSE_NOT_READY;
+    mo_asc       = ASC_NOT_READY;
+    mo_ascq      = ASCQ_UNIT_IN_PROCESS_OF_BECOMING_READY;
+    mo_cmd_error(dev);
+}
+
 static void
 mo_write_protected(mo_t *dev)
 {
@@ -1119,6 +1171,20 @@ mo_pre_execution_check(mo_t *dev, uint8_t *cdb)
         return 0;
     }
 
+    /* Pick up the result of an asynchronous mount; this runs on the
+       emulation thread, so the host UI can be notified of a failure. */
+    if (dev->load_state >= MO_LOAD_DONE) {
+        if (dev->load_thread) {
+            thread_wait(dev->load_thread);
+            dev->load_thread = NULL;
+        }
+        if (dev->load_state == MO_LOAD_DONE)
+            mo_insert(dev);
+        else
+            mo_eject(dev->id);
+        dev->load_state = MO_LOAD_IDLE;
+    }
+
     ready = (dev->drv->fp != NULL);
 
     /* If the drive is not ready, there is no reason to keep the
@@ -1153,7 +1219,12 @@ mo_pre_execution_check(mo_t *dev, uint8_t *cdb)
     /* Next it's time for NOT READY. */
     if ((mo_command_flags[cdb[0]] & CHECK_READY) && !ready) {
         mo_log("MO %i: Not ready (%02X)\n", dev->id, cdb[0]);
-        mo_not_ready(dev);
+        /* A mount still being validated on the worker thread is reported
+           as the unit being in the process of becoming ready. */
+        if (dev->load_state == MO_LOAD_BUSY)
+            mo_becoming_ready(dev);
+        else
+            mo_not_ready(dev);
         return 0;
     }
 
@@ -2191,6 +2262,12 @@ mo_close(void)
         dev = (mo_t *) mo_drives[c].priv;
 
         if (dev) {
+            /* A mount may still be validating on its worker thread. */
+            if (dev->load_thread) {
+                thread_wait(dev->load_thread);
+                dev->load_thread = NULL;
+            }
+
             mo_disk_unload(dev);
 
             if (dev->tf)
@@ -34,6 +34,7 @@
 #include <86box/ui.h>
 #include <86box/hdc.h>
 #include <86box/hdc_ide.h>
+#include <86box/thread.h>
 #include <86box/zip.h>
 
 #define IDE_ATAPI_IS_EARLY             id->sc->pad0
@@ -476,19 +477,18 @@ zip_load_abort(zip_t *dev)
         fclose(dev->drv->fp);
     dev->drv->fp           = NULL;
     dev->drv->medium_size = 0;
-    zip_eject(dev->id); /* Make sure the host OS knows we've rejected (and ejected) the image. */
     return 0;
 }
 
-int
-zip_load(zip_t *dev, char *fn)
+/* Open, validate and probe an image; only touches the drive's file state,
+   so it is safe to run off the emulation thread. */
+static int
+zip_load_image(zip_t *dev, char *fn)
 {
     int size = 0;
 
-    if (!dev->drv) {
-        zip_eject(dev->id);
+    if (!dev->drv)
         return 0;
-    }
 
     dev->drv->fp = plat_fopen(fn, dev->drv->read_only ? "rb" : "rb+");
     if (!dev->drv->fp) {
@@ -536,6 +536,49 @@ zip_load(zip_t *dev, char *fn)
     return 1;
 }
 
+int
+zip_load(zip_t *dev, char *fn)
+{
+    int ret = zip_load_image(dev, fn);
+
+    if (!ret)
+        zip_eject(dev->id); /* Make sure the host OS knows we've rejected (and ejected) the image. */
+
+    return ret;
+}
+
+static void
+zip_load_thread(void *priv)
+{
+    zip_t *dev = (zip_t *) priv;
+
+    dev->load_state = zip_load_image(dev, dev->load_path) ? ZIP_LOAD_DONE : ZIP_LOAD_FAIL;
+}
+
+/* Start mounting an image on a worker thread; the drive reports itself as
+   becoming ready until the validation and geometry probe have finished.
+   The result is picked up on the emulation thread by the pre-execution
+   check, which is also where the host UI is notified of a failure. */
+void
+zip_load_async(zip_t *dev, char *fn)
+{
+    if (dev->load_state == ZIP_LOAD_BUSY)
+        return;
+
+    if (dev->load_thread) {
+        thread_wait(dev->load_thread);
+        dev->load_thread = NULL;
+    }
+
+    strncpy(dev->load_path, fn, sizeof(dev->load_path) - 1);
+    dev->load_path[sizeof(dev->load_path) - 1] = 0;
+    /* Record the path right away so a config save at mount time keeps it. */
+    strncpy(dev->drv->image_path, fn, sizeof(dev->drv->image_path) - 1);
+
+    dev->load_state  = ZIP_LOAD_BUSY;
+    dev->load_thread = thread_create(zip_load_thread, dev);
+}
+
 void
 zip_disk_reload(zip_t *dev)
 {
@@ -1035,6 +1078,15 @@ zip_not_ready(zip_t *dev)
     zip_cmd_error(dev);
 }
 
+static void
+zip_becoming_ready(zip_t *dev)
+{
+    zip_sense_key = SENSE_NOT_READY;
+    zip_asc       = ASC_NOT_READY;
+    zip_ascq      = ASCQ_UNIT_IN_PROCESS_OF_BECOMING_READY;
+    zip_cmd_error(dev);
+}
+
 static void
 zip_write_protected(zip_t *dev)
 {
@@ -1191,6 +1243,20 @@ zip_pre_execution_check(zip_t *dev, uint8_t *cdb)
         return 0;
     }
 
+    /* Pick up the result of an asynchronous mount; this runs on the
+       emulation thread, so the host UI can be notified of a failure. */
+    if (dev->load_state >= ZIP_LOAD_DONE) {
+        if (dev->load_thread) {
+            thread_wait(dev->load_thread);
+            dev->load_thread = NULL;
+        }
+        if (dev->load_state == ZIP_LOAD_DONE)
+            zip_insert(dev);
+        else
+            zip_eject(dev->id);
+        dev->load_state = ZIP_LOAD_IDLE;
+    }
+
     ready = (dev->drv->fp != NULL);
 
     /* If the drive is not ready, there is no reason to keep the
@@ -1225,7 +1291,12 @@ zip_pre_execution_check(zip_t *dev, uint8_t *cdb)
     /* Next it's time for NOT READY. */
     if ((zip_command_flags[cdb[0]] & CHECK_READY) && !ready) {
         zip_log("ZIP %i: Not ready (%02X)\n", dev->id, cdb[0]);
-        zip_not_ready(dev);
+        /* A mount still being validated on the worker thread is reported
+           as the unit being in the process of becoming ready. */
+        if (dev->load_state == ZIP_LOAD_BUSY)
+            zip_becoming_ready(dev);
+        else
+            zip_not_ready(dev);
         return 0;
     }
 
@@ -2430,6 +2501,12 @@ zip_close(void)
         dev = (zip_t *) zip_drives[c].priv;
 
         if (dev) {
+            /* A mount may still be validating on its worker thread. */
+            if (dev->load_thread) {
+                thread_wait(dev->load_thread);
+                dev->load_thread = NULL;
+            }
+
             zip_disk_unload(dev);
 
             if (dev->tf)
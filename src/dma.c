@@ -1366,27 +1366,35 @@ dma_advance(dma_t *dma_c)
         dma_c->ac = ((dma_c->ac & 0xffff0000) & dma_mask) | ((dma_c->ac + as) & 0xffff);
 }
 
-int
-dma_channel_read(int channel)
+static int
+dma_channel_readable(int channel)
 {
-    dma_t   *dma_c = &dma[channel];
-    uint16_t temp;
-    int      tc = 0;
+    const dma_t *dma_c = &dma[channel];
 
     if (channel < 4) {
         if (dma_command[0] & 0x04)
-            return (DMA_NODATA);
+            return 0;
     } else {
         if (dma_command[1] & 0x04)
-            return (DMA_NODATA);
+            return 0;
     }
 
     if (!(dma_e & (1 << channel)))
-        return (DMA_NODATA);
+        return 0;
     if ((dma_m & (1 << channel)) && !dma_req_is_soft)
-        return (DMA_NODATA);
+        return 0;
     if ((dma_c->mode & 0xC) != 8)
-        return (DMA_NODATA);
+        return 0;
+
+    return 1;
+}
+
+static int
+dma_channel_read_step(int channel)
+{
+    dma_t   *dma_c = &dma[channel];
+    uint16_t temp;
+    int      tc = 0;
 
     if (!dma_at && !channel)
         refreshread();
@@ -1459,24 +1467,69 @@ dma_channel_read(int channel)
 }
 
 int
-dma_channel_write(int channel, uint16_t val)
+dma_channel_read(int channel)
 {
-    dma_t *dma_c = &dma[channel];
+    if (!dma_channel_readable(channel))
+        return (DMA_NODATA);
+
+    return dma_channel_read_step(channel);
+}
+
+/* Read up to count bytes from a channel into the caller's buffer, checking
+   the channel state once for the whole block. On 16-bit channels the words
+   are stored least significant byte first. Returns the number of bytes
+   transferred, with DMA_OVER merged in if terminal count was reached. */
+int
+dma_channel_read_block(int channel, uint8_t *buffer, int count)
+{
+    const dma_t *dma_c = &dma[channel];
+    int          done  = 0;
+    int          temp;
+
+    if (!dma_channel_readable(channel))
+        return (DMA_NODATA);
+
+    while (done < count) {
+        temp = dma_channel_read_step(channel);
+
+        buffer[done++] = temp & 0xff;
+        if (dma_c->size && (done < count))
+            buffer[done++] = (temp >> 8) & 0xff;
+
+        if (temp & DMA_OVER)
+            return (done | DMA_OVER);
+    }
+
+    return done;
+}
+
+static int
+dma_channel_writeable(int channel)
+{
+    const dma_t *dma_c = &dma[channel];
 
     if (channel < 4) {
         if (dma_command[0] & 0x04)
-            return (DMA_NODATA);
+            return 0;
     } else {
         if (dma_command[1] & 0x04)
-            return (DMA_NODATA);
+            return 0;
     }
 
     if (!(dma_e & (1 << channel)))
-        return (DMA_NODATA);
+        return 0;
     if ((dma_m & (1 << channel)) && !dma_req_is_soft)
-        return (DMA_NODATA);
+        return 0;
     if ((dma_c->mode & 0xC) != 4)
-        return (DMA_NODATA);
+        return 0;
+
+    return 1;
+}
+
+static int
+dma_channel_write_step(int channel, uint16_t val)
+{
+    dma_t *dma_c = &dma[channel];
 
     if (!dma_c->size) {
         _dma_write(dma_c->ac, val & 0xff, dma_c);
@@ -1545,6 +1598,41 @@ dma_channel_write(int channel, uint16_t val)
     return 0;
 }
 
+int
+dma_channel_write(int channel, uint16_t val)
+{
+    if (!dma_channel_writeable(channel))
+        return (DMA_NODATA);
+
+    return dma_channel_write_step(channel, val);
+}
+
+/* Write up to count bytes from the caller's buffer to a channel, checking
+   the channel state once for the whole block. On 16-bit channels the words
+   are taken least significant byte first. Returns the number of bytes
+   transferred, with DMA_OVER merged in if terminal count was reached. */
+int
+dma_channel_write_block(int channel, const uint8_t *buffer, int count)
+{
+    const dma_t *dma_c = &dma[channel];
+    int          done  = 0;
+    uint16_t     val;
+
+    if (!dma_channel_writeable(channel))
+        return (DMA_NODATA);
+
+    while (done < count) {
+        val = buffer[done++];
+        if (dma_c->size && (done < count))
+            val |= ((uint16_t) buffer[done++]) << 8;
+
+        if (dma_channel_write_step(channel, val) & DMA_OVER)
+            return (done | DMA_OVER);
+    }
+
+    return done;
+}
+
 static void
 dma_ps2_run(int channel)
 {
@@ -1647,6 +1735,15 @@ dma_bm_read(uint32_t PhysAddress, uint8_t *DataRead, uint32_t TotalSize, int Tra
     uint32_t n2;
     uint8_t  bytes[4] = { 0, 0, 0, 0 };
 
+    /* If the entire block is backed by directly addressable memory, move it
+       in one go instead of one word at a time through the mapping handlers. */
+    const uint8_t *p = mem_get_phys_ptr(PhysAddress, TotalSize, 0);
+    if (p != NULL) {
+        mem_logical_addr = 0xffffffff;
+        memcpy(DataRead, p, TotalSize);
+        return;
+    }
+
     n  = TotalSize & ~(TransferSize - 1);
     n2 = TotalSize - n;
 
@@ -1670,6 +1767,15 @@ dma_bm_write(uint32_t PhysAddress, const uint8_t *DataWrite, uint32_t TotalSize,
     uint32_t n2;
     uint8_t  bytes[4] = { 0, 0, 0, 0 };
 
+    uint8_t *p = mem_get_phys_ptr(PhysAddress, TotalSize, 1);
+    if (p != NULL) {
+        mem_logical_addr = 0xffffffff;
+        memcpy(p, DataWrite, TotalSize);
+        if (dma_at)
+            mem_invalidate_range(PhysAddress, PhysAddress + TotalSize - 1);
+        return;
+    }
+
     n  = TotalSize & ~(TransferSize - 1);
     n2 = TotalSize - n;
 
@@ -1689,3 +1795,50 @@ dma_bm_write(uint32_t PhysAddress, const uint8_t *DataWrite, uint32_t TotalSize,
     if (dma_at)
         mem_invalidate_range(PhysAddress, PhysAddress + TotalSize - 1);
 }
+
+/* Cached guest-memory windows; see the description in dma.h. */
+void
+dma_bm_window_set(dma_bm_window_t *win, uint32_t base, uint32_t size)
+{
+    win->base       = base;
+    win->size       = size;
+    win->generation = 0; /* Always stale, forcing a revalidation. */
+    win->read_ptr   = NULL;
+    win->write_ptr  = NULL;
+}
+
+static void
+dma_bm_window_revalidate(dma_bm_window_t *win)
+{
+    win->read_ptr   = mem_get_phys_ptr(win->base, win->size, 0);
+    win->write_ptr  = mem_get_phys_ptr(win->base, win->size, 1);
+    win->generation = mem_mapping_generation;
+}
+
+void
+dma_bm_window_read(dma_bm_window_t *win, uint32_t addr, uint8_t *buf, uint32_t size)
+{
+    if (win->generation != mem_mapping_generation)
+        dma_bm_window_revalidate(win);
+
+    if ((win->read_ptr != NULL) && (addr >= win->base) && (((addr - win->base) + size) <= win->size)) {
+        mem_logical_addr = 0xffffffff;
+        memcpy(buf, win->read_ptr + (addr - win->base), size);
+    } else
+        dma_bm_read(addr, buf, size, 4);
+}
+
+void
+dma_bm_window_write(dma_bm_window_t *win, uint32_t addr, const uint8_t *buf, uint32_t size)
+{
+    if (win->generation != mem_mapping_generation)
+        dma_bm_window_revalidate(win);
+
+    if ((win->write_ptr != NULL) && (addr >= win->base) && (((addr - win->base) + size) <= win->size)) {
+        mem_logical_addr = 0xffffffff;
+        memcpy(win->write_ptr + (addr - win->base), buf, size);
+        if (dma_at)
+            mem_invalidate_range(addr, addr + size - 1);
+    } else
+        dma_bm_write(addr, buf, size, 4);
+}
@@ -25,6 +25,7 @@
 #else
 #define HAVE_STDARG_H
 #include <86box/86box.h>
+#include <86box/device.h>
 #include <86box/fifo.h>
 #endif
 
@@ -375,18 +376,29 @@ fifo_reset_evt(void *priv)
 void
 fifo_close(void *priv)
 {
+#ifdef FIFO_STANDALONE
     free(priv);
+#else
+    /* Arena-backed; released wholesale by device_close_all(). */
+    (void) priv;
+#endif
 }
 
+#ifdef FIFO_STANDALONE
+#    define fifo_alloc(sz) calloc(1, sz)
+#else
+#    define fifo_alloc(sz) device_calloc(1, sz)
+#endif
+
 void *
 fifo_init(int len)
 {
     void *fifo = NULL;
 
     if (len == 64)
-        fifo = calloc(1, sizeof(fifo64_t));
+        fifo = fifo_alloc(sizeof(fifo64_t));
     else if (len == 16)
-        fifo = calloc(1, sizeof(fifo16_t));
+        fifo = fifo_alloc(sizeof(fifo16_t));
     else {
         fatal("FIFO  : Invalid FIFO length: %i\n", len);
         return NULL;
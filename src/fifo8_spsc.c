@@ -0,0 +1,152 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Lock-free single-producer/single-consumer byte FIFO.
+ *
+ *          The indices grow monotonically and are masked on use, so the
+ *          full/empty distinction needs no reserved slot. The producer
+ *          only writes tail (release) and reads head (acquire); the
+ *          consumer does the opposite.
+ */
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <wchar.h>
+#include <86box/86box.h>
+#include <86box/fifo8_spsc.h>
+
+void
+fifo8_spsc_create(Fifo8Spsc *fifo, uint32_t capacity)
+{
+    uint32_t cap = 1;
+
+    while (cap < capacity)
+        cap <<= 1;
+
+    fifo->data     = (uint8_t *) calloc(1, cap);
+    fifo->capacity = cap;
+    fifo->mask     = cap - 1;
+    atomic_store(&fifo->tail, 0);
+    atomic_store(&fifo->head, 0);
+}
+
+void
+fifo8_spsc_destroy(Fifo8Spsc *fifo)
+{
+    if (fifo->data) {
+        free(fifo->data);
+        fifo->data = NULL;
+    }
+}
+
+int
+fifo8_spsc_push(Fifo8Spsc *fifo, uint8_t data)
+{
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+
+    if ((tail - head) >= fifo->capacity)
+        return 0;
+
+    fifo->data[tail & fifo->mask] = data;
+    atomic_store_explicit(&fifo->tail, tail + 1, memory_order_release);
+
+    return 1;
+}
+
+uint32_t
+fifo8_spsc_push_buf(Fifo8Spsc *fifo, const uint8_t *data, uint32_t num)
+{
+    uint32_t tail  = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    uint32_t head  = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    uint32_t free  = fifo->capacity - (tail - head);
+    uint32_t start;
+    uint32_t part;
+
+    if (num > free)
+        num = free;
+    if (num == 0)
+        return 0;
+
+    /* At most two memcpys: up to the end of the ring, then the rest. */
+    start = tail & fifo->mask;
+    part  = fifo->capacity - start;
+    if (part > num)
+        part = num;
+    memcpy(&fifo->data[start], data, part);
+    if (num > part)
+        memcpy(fifo->data, data + part, num - part);
+
+    atomic_store_explicit(&fifo->tail, tail + num, memory_order_release);
+
+    return num;
+}
+
+int
+fifo8_spsc_pop(Fifo8Spsc *fifo, uint8_t *data)
+{
+    uint32_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    if (head == tail)
+        return 0;
+
+    *data = fifo->data[head & fifo->mask];
+    atomic_store_explicit(&fifo->head, head + 1, memory_order_release);
+
+    return 1;
+}
+
+uint32_t
+fifo8_spsc_pop_buf(Fifo8Spsc *fifo, uint8_t *data, uint32_t max)
+{
+    uint32_t head  = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    uint32_t tail  = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    uint32_t used  = tail - head;
+    uint32_t start;
+    uint32_t part;
+
+    if (max > used)
+        max = used;
+    if (max == 0)
+        return 0;
+
+    start = head & fifo->mask;
+    part  = fifo->capacity - start;
+    if (part > max)
+        part = max;
+    memcpy(data, &fifo->data[start], part);
+    if (max > part)
+        memcpy(data + part, fifo->data, max - part);
+
+    atomic_store_explicit(&fifo->head, head + max, memory_order_release);
+
+    return max;
+}
+
+void
+fifo8_spsc_reset(Fifo8Spsc *fifo)
+{
+    atomic_store(&fifo->tail, 0);
+    atomic_store(&fifo->head, 0);
+}
+
+uint32_t
+fifo8_spsc_num_used(Fifo8Spsc *fifo)
+{
+    return atomic_load_explicit(&fifo->tail, memory_order_acquire) -
+           atomic_load_explicit(&fifo->head, memory_order_acquire);
+}
+
+uint32_t
+fifo8_spsc_num_free(Fifo8Spsc *fifo)
+{
+    return fifo->capacity - fifo8_spsc_num_used(fifo);
+}
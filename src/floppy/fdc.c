@@ -1989,14 +1989,12 @@ fdc_data(fdc_t *fdc, uint8_t data, int last)
                 if (fdc->fifobufpos > 0)
                     fdc->fifobufpos = 0;
 
-                for (int i = 0; i <= n; i++) {
-                    result = dma_channel_write(fdc->dma_ch, fdc->fifobuf[i]);
+                result = dma_channel_write_block(fdc->dma_ch, fdc->fifobuf, n + 1);
 
-                    if (result & DMA_OVER) {
-                        dma_set_drq(fdc->dma_ch, 0);
-                        fdc->tc = 1;
-                        return -1;
-                    }
+                if (result & DMA_OVER) {
+                    dma_set_drq(fdc->dma_ch, 0);
+                    fdc->tc = 1;
+                    return -1;
                 }
                 dma_set_drq(fdc->dma_ch, 0);
             }
@@ -2120,16 +2118,11 @@ fdc_getdata(fdc_t *fdc, int last)
             }
         } else {
             if (fdc->fifobufpos == 0) {
-                for (int i = 0; i <= fdc->tfifo; i++) {
-                    data            = dma_channel_read(fdc->dma_ch);
-                    fdc->fifobuf[i] = data;
+                data = dma_channel_read_block(fdc->dma_ch, fdc->fifobuf, fdc->tfifo + 1);
+
+                if (data & DMA_OVER)
+                    fdc->tc = 1;
 
-                    if (data & DMA_OVER) {
-                        dma_set_drq(fdc->dma_ch, 0);
-                        fdc->tc = 1;
-                        break;
-                    }
-                }
                 dma_set_drq(fdc->dma_ch, 0);
             }
 
@@ -201,6 +201,14 @@ typedef struct d86f_t {
     uint16_t  current_byte[2];
     uint16_t  current_bit[2];
     uint16_t  last_word[2];
+    /* Lazily decoded per-track cache: the current track's encoded data in
+       host bit order plus its geometry, so the per-bit-cell hot path does
+       not have to go through the handler and re-swap every word. Invalid
+       whenever the track buffer or its layout may have changed. */
+    uint16_t *track_cache[2];
+    uint32_t  track_cache_size[2];
+    uint32_t  track_cache_index[2];
+    uint8_t   track_cache_valid[2];
 #ifdef D86F_COMPRESS
     int is_compressed;
 #endif
@@ -580,6 +588,8 @@ d86f_set_version(int drive, uint16_t version)
     dev->version = version;
 }
 
+static void d86f_invalidate_track_cache(int drive, int side);
+
 void
 d86f_unregister(int drive)
 {
@@ -601,6 +611,9 @@ d86f_unregister(int drive)
     d86f_handler[drive].get_raw_size      = common_get_raw_size;
     d86f_handler[drive].check_crc         = 0;
 
+    d86f_invalidate_track_cache(drive, 0);
+    d86f_invalidate_track_cache(drive, 1);
+
     dev->version = 0x0063; /* Proxied formats report as version 0.99. */
 }
 
@@ -619,6 +632,9 @@ d86f_register_86f(int drive)
     d86f_handler[drive].index_hole_pos    = d86f_index_hole_pos;
     d86f_handler[drive].get_raw_size      = common_get_raw_size;
     d86f_handler[drive].check_crc         = 1;
+
+    d86f_invalidate_track_cache(drive, 0);
+    d86f_invalidate_track_cache(drive, 1);
 }
 
 int
@@ -1070,6 +1086,47 @@ d86f_can_read_address(int drive)
     return temp;
 }
 
+static void
+d86f_invalidate_track_cache(int drive, int side)
+{
+    d86f_t *dev = d86f[drive];
+
+    if (dev != NULL)
+        dev->track_cache_valid[side] = 0;
+}
+
+/* Decode the current track into the cache: normalize the word order once so
+   the bit getter does not re-swap on every single bit cell, and latch the
+   raw size and index hole position so the advance step needs no handler
+   calls either. Fuzzy surface bits must be re-generated on every read, so
+   tracks with surface data are never cached, and only handlers backed by
+   the common track buffer are - proxies with private buffers (FDI, MFM)
+   can swap them out from under us on a density change. */
+static void
+d86f_cache_track(int drive, int side)
+{
+    d86f_t         *dev = d86f[drive];
+    const uint16_t *enc = dev->track_encoded_data[side];
+
+    dev->track_cache_size[side]  = d86f_handler[drive].get_raw_size(drive, side);
+    dev->track_cache_index[side] = d86f_handler[drive].index_hole_pos(drive, side);
+
+    if (dev->track_cache[side] == NULL) {
+        dev->track_cache[side] = (uint16_t *) malloc(106096);
+        if (dev->track_cache[side] == NULL)
+            return;
+    }
+
+    if (d86f_reverse_bytes(drive))
+        memcpy(dev->track_cache[side], enc, 106096);
+    else {
+        for (uint32_t w = 0; w < 53048; w++)
+            dev->track_cache[side][w] = (enc[w] >> 8) | (enc[w] << 8);
+    }
+
+    dev->track_cache_valid[side] = 1;
+}
+
 void
 d86f_get_bit(int drive, int side)
 {
@@ -1081,6 +1138,16 @@ d86f_get_bit(int drive, int side)
     uint16_t current_bit;
     uint16_t surface_bit;
 
+    if (!dev->track_cache_valid[side] && !d86f_has_surface_desc(drive) && (d86f_handler[drive].encoded_data == common_encoded_data))
+        d86f_cache_track(drive, side);
+
+    if (dev->track_cache_valid[side]) {
+        track_word           = dev->track_pos >> 4;
+        track_bit            = 15 - (dev->track_pos & 15);
+        dev->last_word[side] = (dev->last_word[side] << 1) | ((dev->track_cache[side][track_word] >> track_bit) & 1);
+        return;
+    }
+
     track_word = dev->track_pos >> 4;
 
     /* We need to make sure we read the bits from MSB to LSB. */
@@ -1191,6 +1258,10 @@ d86f_put_bit(int drive, int side, int bit)
     encoded_data &= ~(1 << track_bit);
     encoded_data |= (current_bit << track_bit);
 
+    /* The local word is already normalized, update the cache in place. */
+    if (dev->track_cache_valid[side])
+        dev->track_cache[side][track_word] = encoded_data;
+
     if (d86f_reverse_bytes(drive)) {
         d86f_handler[drive].encoded_data(drive, side)[track_word] = encoded_data;
     } else {
@@ -1761,6 +1832,22 @@ d86f_advance_bit(int drive, int side)
 {
     d86f_t *dev = d86f[drive];
 
+    if (dev->track_cache_valid[side]) {
+        /* Use the geometry latched when the track was cached. */
+        dev->track_pos++;
+        if (dev->track_pos >= dev->track_cache_size[side])
+            dev->track_pos = 0;
+
+        if (dev->track_pos == dev->track_cache_index[side]) {
+            d86f_handler[drive].read_revolution(drive);
+
+            if (dev->state != STATE_IDLE)
+                dev->index_count++;
+        }
+
+        return;
+    }
+
     dev->track_pos++;
     dev->track_pos %= d86f_handler[drive].get_raw_size(drive, side);
 
@@ -1859,6 +1946,9 @@ d86f_write_direct_common(int drive, int side, uint16_t byte, uint8_t type, uint3
 
     dev->track_encoded_data[side][pos] = encoded_byte;
     dev->last_word[side]               = encoded_byte;
+
+    /* Direct writes splice the track buffer behind the cache's back. */
+    dev->track_cache_valid[side] = 0;
 }
 
 void
@@ -2614,6 +2704,7 @@ d86f_reset_index_hole_pos(int drive, int side)
     d86f_t *dev = d86f[drive];
 
     dev->index_hole_pos[side] = 0;
+    d86f_invalidate_track_cache(drive, side);
 }
 
 uint16_t
@@ -2985,6 +3076,7 @@ d86f_zero_track(int drive)
         if (d86f_has_surface_desc(drive))
             memset(dev->track_surface_data[side], 0, 106096);
         memset(dev->track_encoded_data[side], 0, 106096);
+        d86f_invalidate_track_cache(drive, side);
     }
 }
 
@@ -3928,6 +4020,13 @@ d86f_destroy(int drive)
     d86f_destroy_linked_lists(drive, 0);
     d86f_destroy_linked_lists(drive, 1);
 
+    for (uint8_t i = 0; i < 2; i++) {
+        if (dev->track_cache[i]) {
+            free(dev->track_cache[i]);
+            dev->track_cache[i] = NULL;
+        }
+    }
+
     free(d86f[drive]);
     d86f[drive] = NULL;
 
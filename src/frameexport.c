@@ -0,0 +1,122 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Shared-memory frame export channel. Started from the command
+ *          line (--frameexport path), it maps 'path' as a shared file
+ *          mapping holding a small ring of frames and publishes every
+ *          blitted frame of monitor 1 into it, together with the dirty
+ *          rectangle the video card reported. An external capture
+ *          process maps the same file and consumes frames without any
+ *          pipe or socket in the path; the layout and the seqlock
+ *          protocol are described in 86box/frameexport.h. Publishing is
+ *          one row-wise copy per frame on the emulation thread, bounded
+ *          by the blit rectangle - the consumer side is zero-copy.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/plat.h>
+#include <86box/timer.h>
+#include <86box/mem.h>
+#include <86box/video.h>
+#include <86box/frameexport.h>
+
+int frameexport_on = 0;
+
+static frameexport_header_t *frameexport_hdr = NULL;
+static size_t                frameexport_size;
+static uint32_t              frameexport_slot_size;
+
+void
+frameexport_start(const char *path)
+{
+    frameexport_slot_size = sizeof(frameexport_slot_t) + (FRAMEEXPORT_MAX_W * FRAMEEXPORT_MAX_H * sizeof(uint32_t));
+    frameexport_size      = sizeof(frameexport_header_t) + ((size_t) FRAMEEXPORT_SLOTS * frameexport_slot_size);
+
+    frameexport_hdr = plat_mmap_file(path, frameexport_size);
+    if (frameexport_hdr == NULL) {
+        pclog("FRAMEEXPORT: unable to map \"%s\"\n", path);
+        return;
+    }
+
+    frameexport_hdr->magic     = FRAMEEXPORT_MAGIC;
+    frameexport_hdr->version   = FRAMEEXPORT_VERSION;
+    frameexport_hdr->nr_slots  = FRAMEEXPORT_SLOTS;
+    frameexport_hdr->slot_size = frameexport_slot_size;
+    frameexport_hdr->max_w     = FRAMEEXPORT_MAX_W;
+    frameexport_hdr->max_h     = FRAMEEXPORT_MAX_H;
+    frameexport_hdr->seq       = 0;
+
+    frameexport_on = 1;
+    pclog("FRAMEEXPORT: exporting frames to \"%s\"\n", path);
+}
+
+/* Called on the emulation thread for every submitted frame, after the
+   blit rectangle has been latched and before the blit thread is woken,
+   so the target buffer is stable for the duration of the copy. */
+void
+frameexport_frame(int x, int y, int w, int h,
+                  int dirty_x, int dirty_y, int dirty_w, int dirty_h,
+                  int dirty_valid, int monitor_index)
+{
+    const bitmap_t     *buf = monitors[monitor_index].target_buffer;
+    frameexport_slot_t *slot;
+    uint32_t           *dst;
+    uint32_t            seq;
+
+    if (!frameexport_on || (monitor_index != 0))
+        return;
+
+    if ((w > FRAMEEXPORT_MAX_W) || (h > FRAMEEXPORT_MAX_H))
+        return;
+
+    seq  = frameexport_hdr->seq + 1;
+    slot = (frameexport_slot_t *) ((uint8_t *) (frameexport_hdr + 1) + ((seq % FRAMEEXPORT_SLOTS) * frameexport_slot_size));
+
+    /* Open the seqlock: a consumer seeing seq0 != seq1 rereads. */
+    slot->seq0 = seq;
+    atomic_thread_fence(memory_order_release);
+
+    slot->x = x;
+    slot->y = y;
+    slot->w = w;
+    slot->h = h;
+    if (dirty_valid) {
+        slot->dirty_x = dirty_x;
+        slot->dirty_y = dirty_y;
+        slot->dirty_w = dirty_w;
+        slot->dirty_h = dirty_h;
+    } else
+        slot->dirty_x = slot->dirty_y = slot->dirty_w = slot->dirty_h = 0;
+    slot->dirty_valid = !!dirty_valid;
+    slot->stride      = w;
+
+    dst = (uint32_t *) (slot + 1);
+    for (int row = 0; row < h; row++) {
+        memcpy(dst, &(buf->line[y + row][x]), w * sizeof(uint32_t));
+        dst += w;
+    }
+
+    /* Close the seqlock, then advertise the frame. */
+    atomic_thread_fence(memory_order_release);
+    slot->seq1 = seq;
+    atomic_thread_fence(memory_order_release);
+    frameexport_hdr->seq = seq;
+}
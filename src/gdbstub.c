@@ -367,12 +367,15 @@ gdbstub_jump(uint32_t new_pc)
 {
     /* Nasty hack; qemu always uses the full 32-bit EIP internally... */
     if (cpu_state.op32 || ((new_pc >= cs) && (new_pc < (cs + 65536)))) {
+        /* Same code segment: just move EIP, the caches stay valid. This is
+           the hot case, as some clients resume every single step with an
+           explicit address. */
         cpu_state.pc = new_pc - cs;
     } else {
         loadseg((new_pc >> 4) & 0xf000, &cpu_state.seg_cs);
         cpu_state.pc = new_pc & 0xffff;
+        flushmmucache();
     }
-    flushmmucache();
 }
 
 static inline int
@@ -546,8 +549,13 @@ gdbstub_client_write_reg(int index, uint8_t *buf)
 
         case GDB_REG_CS ... GDB_REG_GS:
             width = 2;
-            loadseg(*((uint16_t *) buf), segment_regs[index - GDB_REG_CS]);
-            flushmmucache();
+            /* gdb writes the whole register file back on every step; only
+               reload the segment (and flush the caches) if the selector
+               actually changed. */
+            if (*((uint16_t *) buf) != segment_regs[index - GDB_REG_CS]->seg) {
+                loadseg(*((uint16_t *) buf), segment_regs[index - GDB_REG_CS]);
+                flushmmucache();
+            }
             break;
 
 #if 0
@@ -558,8 +566,10 @@ gdbstub_client_write_reg(int index, uint8_t *buf)
 #endif
 
         case GDB_REG_CR0 ... GDB_REG_CR4:
-            *cr_regs[index - GDB_REG_CR0] = *((uint32_t *) buf);
-            flushmmucache();
+            if (*cr_regs[index - GDB_REG_CR0] != *((uint32_t *) buf)) {
+                *cr_regs[index - GDB_REG_CR0] = *((uint32_t *) buf);
+                flushmmucache();
+            }
             break;
 
         case GDB_REG_EFER:
@@ -1362,6 +1372,12 @@ unknown:
                         l++;
                     }
                 }
+
+                /* Drop any fast-path lookups already established for the
+                   watched pages; addreadlookup/addwritelookup won't re-add
+                   them, so only accesses to those pages take the slow path
+                   with the watchpoint check. */
+                flushmmucache_nopc();
             }
 
             /* Respond positively. */
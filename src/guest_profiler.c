@@ -0,0 +1,172 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Sampling profiler for emulated guest code. A timer periodically
+ *          records CS:EIP and the CPU mode into a ring; on stop, the ring
+ *          is aggregated and written out in the collapsed-stack format
+ *          flamegraph.pl consumes. Unlike attaching the GDB stub, sampling
+ *          runs on emulated time and does not perturb guest timing.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/timer.h>
+#include <86box/plat.h>
+#include <86box/plat_unused.h>
+#include <86box/guest_profiler.h>
+
+/* Number of samples kept; the oldest are overwritten once the ring is full.
+   At the 10 kHz sampling rate this covers the last ~6.5 emulated seconds. */
+#define GPROF_RING_LEN    (1 << 16)
+#define GPROF_RING_MASK   (GPROF_RING_LEN - 1)
+
+/* Sampling period in emulated microseconds. */
+#define GPROF_PERIOD_USEC 100.0
+
+typedef struct gprof_sample_t {
+    uint32_t eip;
+    uint16_t seg;
+    uint8_t  mode;
+} gprof_sample_t;
+
+enum {
+    GPROF_MODE_REAL = 0,
+    GPROF_MODE_PROT,
+    GPROF_MODE_V86,
+    GPROF_MODE_MAX
+};
+
+static const char *gprof_mode_names[GPROF_MODE_MAX] = { "real", "prot", "v86" };
+
+int guest_profiler_on = 0;
+
+static gprof_sample_t gprof_ring[GPROF_RING_LEN];
+static uint32_t       gprof_count       = 0;
+static pc_timer_t     gprof_timer;
+static int            gprof_timer_added = 0;
+static char           gprof_path[1024];
+
+static void
+gprof_timer_callback(UNUSED(void *priv))
+{
+    gprof_sample_t *sample = &gprof_ring[gprof_count & GPROF_RING_MASK];
+
+    sample->eip  = cpu_state.pc;
+    sample->seg  = CS;
+    if (msw & 1)
+        sample->mode = (cpu_state.eflags & VM_FLAG) ? GPROF_MODE_V86 : GPROF_MODE_PROT;
+    else
+        sample->mode = GPROF_MODE_REAL;
+    /* Flag samples taken while the recompiler is in use. */
+    if (cpu_use_dynarec)
+        sample->mode |= 0x80;
+
+    gprof_count++;
+
+    timer_on_auto(&gprof_timer, GPROF_PERIOD_USEC);
+}
+
+static int
+gprof_sample_cmp(const void *a, const void *b)
+{
+    const gprof_sample_t *sa = (const gprof_sample_t *) a;
+    const gprof_sample_t *sb = (const gprof_sample_t *) b;
+
+    if (sa->mode != sb->mode)
+        return (sa->mode < sb->mode) ? -1 : 1;
+    if (sa->seg != sb->seg)
+        return (sa->seg < sb->seg) ? -1 : 1;
+    if (sa->eip != sb->eip)
+        return (sa->eip < sb->eip) ? -1 : 1;
+
+    return 0;
+}
+
+/* Aggregate the ring and write one collapsed-stack line per distinct
+   mode/CS/EIP triple: "prot;cs_0028;eip_c0123456 37". */
+static void
+gprof_dump(void)
+{
+    FILE           *fp;
+    gprof_sample_t *sorted;
+    uint32_t        len = (gprof_count < GPROF_RING_LEN) ? gprof_count : GPROF_RING_LEN;
+    uint32_t        run;
+
+    if (len == 0)
+        return;
+
+    fp = plat_fopen(gprof_path, "w");
+    if (fp == NULL) {
+        pclog("GPROF: unable to open %s\n", gprof_path);
+        return;
+    }
+
+    sorted = malloc(len * sizeof(gprof_sample_t));
+    memcpy(sorted, gprof_ring, len * sizeof(gprof_sample_t));
+    qsort(sorted, len, sizeof(gprof_sample_t), gprof_sample_cmp);
+
+    for (uint32_t i = 0; i < len; i += run) {
+        const gprof_sample_t *sample = &sorted[i];
+
+        run = 1;
+        while (((i + run) < len) && !gprof_sample_cmp(sample, &sorted[i + run]))
+            run++;
+
+        fprintf(fp, "%s%s;cs_%04X;eip_%08X %u\n",
+                gprof_mode_names[sample->mode & 0x7f],
+                (sample->mode & 0x80) ? "_dyn" : "",
+                sample->seg, sample->eip, run);
+    }
+
+    free(sorted);
+    fclose(fp);
+
+    pclog("GPROF: wrote %u samples to %s\n", len, gprof_path);
+}
+
+void
+guest_profiler_start(const char *fn)
+{
+    if (guest_profiler_on)
+        return;
+
+    strncpy(gprof_path, fn, sizeof(gprof_path) - 1);
+    gprof_count = 0;
+
+    if (!gprof_timer_added) {
+        timer_add(&gprof_timer, gprof_timer_callback, NULL, 0);
+        gprof_timer_added = 1;
+    }
+    timer_on_auto(&gprof_timer, GPROF_PERIOD_USEC);
+
+    guest_profiler_on = 1;
+}
+
+void
+guest_profiler_stop(void)
+{
+    if (!guest_profiler_on)
+        return;
+
+    timer_stop(&gprof_timer);
+    guest_profiler_on = 0;
+
+    gprof_dump();
+}
@@ -136,6 +136,8 @@ extern uint32_t mem_size;                   /* (C) memory size (Installed on sys
 extern uint32_t isa_mem_size;               /* (C) memory size (ISA Memory Cards) */
 extern int      cpu;                        /* (C) cpu type */
 extern int      cpu_use_dynarec;            /* (C) cpu uses/needs Dyna */
+extern int      cpu_dynarec_threshold;      /* (C) dynarec warm-up threshold */
+extern int      mem_hugepages;              /* (C) use host huge pages for guest RAM and the JIT arena */
 extern int      fpu_type;                   /* (C) fpu type */
 extern int      fpu_softfloat;              /* (C) fpu uses softfloat */
 extern int      time_sync;                  /* (C) enable time sync */
@@ -221,6 +223,13 @@ extern double isa_timing;
 extern int    io_delay;
 extern int    framecountx;
 
+/* Cycle-slice governor (86box.c): emulated ms consumed per pc_run() call,
+   and the achieved-speed percentiles of the last second (p99 = slowest 1%
+   of slices). */
+extern int pc_slice_ms;
+extern int pc_speed_p50;
+extern int pc_speed_p99;
+
 extern volatile int     cpu_thread_run;
 extern          uint8_t postcard_codes[POSTCARDS_NUM];
 
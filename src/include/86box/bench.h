@@ -0,0 +1,33 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the deterministic macro-benchmark harness.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_BENCH_H
+#define EMU_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int bench_on;
+
+extern void bench_start(const char *path, int seconds);
+extern void bench_onesec(int cur_fps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_BENCH_H*/
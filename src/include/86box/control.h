@@ -0,0 +1,86 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the control socket, including the wire
+ *          protocol an external orchestrator speaks to drive a running
+ *          instance.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_CONTROL_H
+#define EMU_CONTROL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Wire protocol: the client sends a 4-byte frame header followed by
+   'len' payload bytes, and receives one response frame per request.
+   All fields are little endian. In a request 'arg' carries the
+   command argument (drive id, pause flag); in a response it carries
+   the status code. Payloads holding paths are not NUL-terminated;
+   'len' is the path length. */
+typedef struct control_frame_t {
+    uint8_t  cmd; /* CONTROL_CMD_*; echoed in the response */
+    uint8_t  arg;
+    uint16_t len; /* payload bytes following the header */
+} control_frame_t;
+
+enum {
+    CONTROL_CMD_PING = 1,   /* no-op, returns CONTROL_OK */
+    CONTROL_CMD_PAUSE,      /* arg: 1 = pause, 0 = resume */
+    CONTROL_CMD_RESET,      /* queue a hard reset */
+    CONTROL_CMD_SCREENSHOT, /* request a screenshot of monitor 0 */
+    CONTROL_CMD_SAVE_STATE, /* payload: state file path */
+    CONTROL_CMD_LOAD_STATE, /* payload: state file path */
+    CONTROL_CMD_COUNTERS,   /* returns a control_counters_t payload */
+    /* Media commands: arg bits 0-6 are the drive id, bit 7 is write
+       protect where the medium supports it. An empty payload ejects. */
+    CONTROL_CMD_FLOPPY = 0x10,
+    CONTROL_CMD_CDROM,
+    CONTROL_CMD_ZIP,
+    CONTROL_CMD_MO
+};
+
+enum {
+    CONTROL_OK = 0,
+    CONTROL_EBADCMD, /* unknown command */
+    CONTROL_EARG,    /* drive id out of range or payload too long */
+    CONTROL_EFAIL    /* the operation itself failed */
+};
+
+#define CONTROL_ARG_WP      0x80
+#define CONTROL_ARG_ID_MASK 0x7f
+
+/* CONTROL_CMD_COUNTERS response payload: the performance counters of
+   the last completed emulated second, plus the current pause state. */
+typedef struct control_counters_t {
+    uint32_t fps;
+    uint32_t speed_p50; /* achieved speed percentiles, percent of real time */
+    uint32_t speed_p99;
+    uint32_t paused;
+    uint64_t insns; /* the perf_counters_t fields, see 86box/perfstats.h */
+    uint64_t blocks_compiled;
+    uint64_t blocks_unrolled;
+    uint64_t blocks_deleted;
+    uint64_t lookup_fills;
+    uint64_t timer_fires;
+} control_counters_t;
+
+extern void control_init(uint16_t port);
+extern void control_onesec(int cur_fps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_CONTROL_H*/
@@ -155,12 +155,27 @@ typedef struct _device_ {
     void (*force_redraw)(void *priv);
 
     const device_config_t *config;
+
+    /* Optional save-state hooks: write or read the device's runtime state
+       through the opaque stdio stream. Devices without hooks are skipped
+       on save and keep their current state on load. */
+    void (*save_state)(void *priv, void *fp);
+    void (*load_state)(void *priv, void *fp, uint32_t len);
 } device_t;
 
+/* Power of 2; config arrays too large for the table fall back to the
+   linear walk. */
+#define DEVICE_CONFIG_HASH_SIZE 64
+
 typedef struct device_context_t {
     const device_t *dev;
     char            name[2048];
     int             instance;
+    /* Open-addressed index over dev->config entry names, built by
+       device_set_context() so repeated device_get_config_*() calls do not
+       re-walk the array; config_hashed is 0 when the index is unusable. */
+    const device_config_t *config_hash[DEVICE_CONFIG_HASH_SIZE];
+    int                    config_hashed;
 } device_context_t;
 
 #ifdef __cplusplus
@@ -190,11 +205,18 @@ extern void  device_cadd_inst_ex(const device_t *dev, const device_t *cd, void *
 extern void  device_cadd_inst_ex_parameters(const device_t *dev, const device_t *cd, void *priv, int inst, void *params);
 extern void  device_close_all(void);
 extern void  device_reset_all(uint32_t match_flags);
+/* Machine-lifetime allocation: memory comes from a contiguous arena in
+   init order and is released wholesale at the end of device_close_all(),
+   so close callbacks must not free() it. */
+extern void *device_calloc(size_t nmemb, size_t size);
 extern void *device_find_first_priv(uint32_t match_flags);
 extern void *device_get_priv(const device_t *dev);
 extern int   device_available(const device_t *dev);
 extern int   device_poll(const device_t *dev);
 extern void  device_speed_changed(void);
+extern void  device_state_save(void *fp);
+extern int   device_state_load(void *fp, uint32_t len);
+extern void  device_dump(void *fp);
 extern void  device_force_redraw(void);
 extern void  device_get_name(const device_t *dev, int bus, char *name);
 extern int   device_has_config(const device_t *dev);
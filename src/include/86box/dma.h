@@ -98,6 +98,8 @@ extern void dma_set_drq(int channel, int set);
 
 extern int dma_channel_read(int channel);
 extern int dma_channel_write(int channel, uint16_t val);
+extern int dma_channel_read_block(int channel, uint8_t *buffer, int count);
+extern int dma_channel_write_block(int channel, const uint8_t *buffer, int count);
 
 extern void dma_alias_set(void);
 extern void dma_alias_set_piix(void);
@@ -107,6 +109,24 @@ extern void dma_alias_remove_piix(void);
 extern void dma_bm_read(uint32_t PhysAddress, uint8_t *DataRead, uint32_t TotalSize, int TransferSize);
 extern void dma_bm_write(uint32_t PhysAddress, const uint8_t *DataWrite, uint32_t TotalSize, int TransferSize);
 
+/* Cached guest-memory window for bus masters that stream samples or walk
+   descriptor rings in a fixed guest buffer: the physical pointer for the
+   whole window is translated once and revalidated against the memory
+   mapping generation, so repeated accesses are plain copies. Accesses
+   outside the window or to non-RAM targets fall back to dma_bm_read()/
+   dma_bm_write(). */
+typedef struct dma_bm_window_t {
+    uint32_t base;
+    uint32_t size;
+    uint32_t generation;
+    uint8_t *read_ptr;
+    uint8_t *write_ptr;
+} dma_bm_window_t;
+
+extern void dma_bm_window_set(dma_bm_window_t *win, uint32_t base, uint32_t size);
+extern void dma_bm_window_read(dma_bm_window_t *win, uint32_t addr, uint8_t *buf, uint32_t size);
+extern void dma_bm_window_write(dma_bm_window_t *win, uint32_t addr, const uint8_t *buf, uint32_t size);
+
 void dma_set_params(uint8_t advanced, uint32_t mask);
 void dma_set_mask(uint32_t mask);
 
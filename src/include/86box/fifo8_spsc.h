@@ -0,0 +1,137 @@
+#ifndef EMU_FIFO8_SPSC_H
+#define EMU_FIFO8_SPSC_H
+
+#include <stdatomic.h>
+
+/* Single-producer/single-consumer byte FIFO, lock-free. Companion to the
+ * Fifo8 ring for streams that cross a thread boundary (serial
+ * passthrough, audio/input rings): exactly one thread may push and
+ * exactly one may pop, with no further synchronisation. The indices
+ * grow monotonically and are masked on use; they live on separate cache
+ * lines so producer and consumer do not false-share. */
+typedef struct Fifo8Spsc {
+    uint8_t *data;
+    uint32_t capacity; /* always a power of two */
+    uint32_t mask;
+
+    /* Producer-written index, on its own cache line. */
+    uint8_t     pad0[64];
+    atomic_uint tail;
+
+    /* Consumer-written index, on its own cache line. */
+    uint8_t     pad1[64];
+    atomic_uint head;
+
+    uint8_t pad2[64];
+} Fifo8Spsc;
+
+/**
+ * fifo8_spsc_create:
+ * @fifo: struct Fifo8Spsc to initialise with new FIFO
+ * @capacity: minimum capacity of the newly created FIFO
+ *
+ * Create a FIFO of at least the specified size; the size is rounded up
+ * to the next power of two. Clients should call fifo8_spsc_destroy()
+ * when finished using the fifo. The FIFO is initially empty.
+ */
+
+extern void fifo8_spsc_create(Fifo8Spsc *fifo, uint32_t capacity);
+
+/**
+ * fifo8_spsc_destroy:
+ * @fifo: FIFO to cleanup
+ *
+ * Cleanup a FIFO created with fifo8_spsc_create(). Frees memory created
+ * for FIFO storage. The FIFO is no longer usable after this has been
+ * called. Both threads must have stopped using the FIFO first.
+ */
+
+extern void fifo8_spsc_destroy(Fifo8Spsc *fifo);
+
+/**
+ * fifo8_spsc_push:
+ * @fifo: FIFO to push to
+ * @data: data byte to push
+ *
+ * Push a data byte to the FIFO. Producer thread only.
+ *
+ * Returns: 1 if the byte was pushed, 0 if the FIFO was full.
+ */
+
+extern int fifo8_spsc_push(Fifo8Spsc *fifo, uint8_t data);
+
+/**
+ * fifo8_spsc_push_buf:
+ * @fifo: FIFO to push to
+ * @data: data to push
+ * @num: number of bytes to push
+ *
+ * Push up to num bytes to the FIFO in bulk. Producer thread only.
+ *
+ * Returns: The number of bytes actually pushed, which is less than num
+ * if the FIFO filled up.
+ */
+
+extern uint32_t fifo8_spsc_push_buf(Fifo8Spsc *fifo, const uint8_t *data, uint32_t num);
+
+/**
+ * fifo8_spsc_pop:
+ * @fifo: FIFO to pop from
+ * @data: receives the popped byte
+ *
+ * Pop a data byte from the FIFO. Consumer thread only.
+ *
+ * Returns: 1 if a byte was popped, 0 if the FIFO was empty.
+ */
+
+extern int fifo8_spsc_pop(Fifo8Spsc *fifo, uint8_t *data);
+
+/**
+ * fifo8_spsc_pop_buf:
+ * @fifo: FIFO to pop from
+ * @data: buffer receiving the popped bytes
+ * @max: maximum number of bytes to pop
+ *
+ * Pop up to max bytes from the FIFO in bulk. Consumer thread only.
+ *
+ * Returns: The number of bytes actually popped, which is less than max
+ * if the FIFO ran empty.
+ */
+
+extern uint32_t fifo8_spsc_pop_buf(Fifo8Spsc *fifo, uint8_t *data, uint32_t max);
+
+/**
+ * fifo8_spsc_reset:
+ * @fifo: FIFO to reset
+ *
+ * Reset a FIFO. All data is discarded and the FIFO is emptied. Not
+ * thread-safe: both threads must have stopped using the FIFO first.
+ */
+
+extern void fifo8_spsc_reset(Fifo8Spsc *fifo);
+
+/**
+ * fifo8_spsc_num_used:
+ * @fifo: FIFO to check
+ *
+ * Return the number of used bytes in the FIFO. Exact on the consumer
+ * thread; a lower bound on the producer thread.
+ *
+ * Returns: Number of used bytes.
+ */
+
+extern uint32_t fifo8_spsc_num_used(Fifo8Spsc *fifo);
+
+/**
+ * fifo8_spsc_num_free:
+ * @fifo: FIFO to check
+ *
+ * Return the number of free bytes in the FIFO. Exact on the producer
+ * thread; a lower bound on the consumer thread.
+ *
+ * Returns: Number of free bytes.
+ */
+
+extern uint32_t fifo8_spsc_num_free(Fifo8Spsc *fifo);
+
+#endif /* EMU_FIFO8_SPSC_H */
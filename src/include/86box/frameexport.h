@@ -0,0 +1,82 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the shared-memory frame export channel,
+ *          including the on-disk/shared layout an external capture
+ *          process maps to consume frames.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_FRAMEEXPORT_H
+#define EMU_FRAMEEXPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAMEEXPORT_MAGIC   0x58463638 /* '86FX' when read as bytes */
+#define FRAMEEXPORT_VERSION 1
+#define FRAMEEXPORT_SLOTS   4
+/* Matches the size of a monitor's target buffer. */
+#define FRAMEEXPORT_MAX_W   2048
+#define FRAMEEXPORT_MAX_H   2048
+
+/* Shared layout: one header, then FRAMEEXPORT_SLOTS slots of slot_size
+   bytes each (slot struct followed by its pixel payload). The emulator
+   only ever writes; a consumer maps the same file read-only.
+
+   Publication is a per-slot seqlock: the producer writes seq0, then the
+   slot fields and payload, then seq1 (equal to seq0), then header.seq.
+   A consumer reads header.seq, picks slot seq % FRAMEEXPORT_SLOTS,
+   copies it out, and accepts the copy only if seq0 == seq1 == seq both
+   before and after the copy; otherwise the producer lapped it and it
+   rereads. With FRAMEEXPORT_SLOTS frames of headroom a consumer that
+   keeps up never retries. */
+typedef struct frameexport_header_t {
+    uint32_t magic;     /* FRAMEEXPORT_MAGIC */
+    uint32_t version;   /* FRAMEEXPORT_VERSION */
+    uint32_t nr_slots;  /* FRAMEEXPORT_SLOTS */
+    uint32_t slot_size; /* bytes per slot, payload included */
+    uint32_t max_w;     /* payload capacity in pixels */
+    uint32_t max_h;
+    uint32_t reserved[2];
+    volatile uint32_t seq; /* sequence number of the latest complete frame */
+} frameexport_header_t;
+
+typedef struct frameexport_slot_t {
+    volatile uint32_t seq0; /* written before the payload... */
+    uint32_t x;             /* blit rectangle within the emulated screen */
+    uint32_t y;
+    uint32_t w;
+    uint32_t h;
+    uint32_t dirty_x; /* area changed since the previous frame; only   */
+    uint32_t dirty_y; /* meaningful when dirty_valid is set - cards    */
+    uint32_t dirty_w; /* that do not track dirty state leave it clear  */
+    uint32_t dirty_h; /* and the whole rectangle must be assumed dirty */
+    uint32_t dirty_valid; /* an empty rectangle with this set means nothing changed */
+    uint32_t stride;        /* pixels per payload row (equals w) */
+    volatile uint32_t seq1; /* ...and after; equal values mean consistent */
+    /* w * h XRGB pixels follow. */
+} frameexport_slot_t;
+
+extern int frameexport_on;
+
+extern void frameexport_start(const char *path);
+extern void frameexport_frame(int x, int y, int w, int h,
+                              int dirty_x, int dirty_y, int dirty_w, int dirty_h,
+                              int dirty_valid, int monitor_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_FRAMEEXPORT_H*/
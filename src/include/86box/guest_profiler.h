@@ -0,0 +1,33 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the guest code sampling profiler.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_GUEST_PROFILER_H
+#define EMU_GUEST_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int guest_profiler_on;
+
+extern void guest_profiler_start(const char *fn);
+extern void guest_profiler_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_GUEST_PROFILER_H*/
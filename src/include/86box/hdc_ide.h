@@ -95,6 +95,8 @@ typedef struct ide_s {
     int      reset;
     int      mdma_mode;
     int      do_initial_read;
+    int      dma_io_pending;
+    int      block_total;
     uint32_t drive;
     uint32_t cfg_spt;
     uint32_t cfg_hpc;
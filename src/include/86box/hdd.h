@@ -158,6 +158,7 @@ typedef struct hard_disk_t {
 
     char fn[1024];         /* Name of current image file */
     char vhd_parent[1041]; /* Differential VHD parent file */
+    char cow_base[1041];   /* Read-only base image for an 86S copy-on-write overlay */
 
     uint32_t seek_pos;
     uint32_t seek_len;
@@ -202,6 +203,12 @@ extern void     hdd_image_read(uint8_t id, uint32_t sector, uint32_t count, uint
 extern int      hdd_image_read_ex(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
 extern void     hdd_image_write(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
 extern int      hdd_image_write_ex(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
+extern int      hdd_cache_size;
+extern int      hdd_writeback;
+extern void     hdd_image_read_queued(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
+extern void     hdd_image_write_queued(uint8_t id, uint32_t sector, uint32_t count, uint8_t *buffer);
+extern int      hdd_image_queued_done(uint8_t id);
+extern void     hdd_image_flush(uint8_t id);
 extern void     hdd_image_zero(uint8_t id, uint32_t sector, uint32_t count);
 extern int      hdd_image_zero_ex(uint8_t id, uint32_t sector, uint32_t count);
 extern uint32_t hdd_image_get_last_sector(uint8_t id);
@@ -214,6 +221,7 @@ extern void     hdd_image_calc_chs(uint32_t *c, uint32_t *h, uint32_t *s, uint32
 extern int image_is_hdi(const char *s);
 extern int image_is_hdx(const char *s, int check_signature);
 extern int image_is_vhd(const char *s, int check_signature);
+extern int image_is_86s(const char *s, int check_signature);
 
 extern double      hdd_timing_write(hard_disk_t *hdd, uint32_t addr, uint32_t len);
 extern double      hdd_timing_read(hard_disk_t *hdd, uint32_t addr, uint32_t len);
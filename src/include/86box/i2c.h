@@ -46,6 +46,9 @@ extern void i2c_handler(int set, void *bus_handle, uint8_t base, int size,
                         void (*stop)(void *bus, uint8_t addr, void *priv),
                         void *priv);
 
+extern void    i2c_set_fast(void *bus_handle, uint8_t base, int size, uint8_t fast);
+extern uint8_t i2c_is_fast(void *bus_handle, uint8_t addr);
+
 extern uint8_t i2c_start(void *bus_handle, uint8_t addr, uint8_t read);
 extern uint8_t i2c_read(void *bus_handle, uint8_t addr);
 extern uint8_t i2c_write(void *bus_handle, uint8_t addr, uint8_t data);
@@ -346,6 +346,8 @@ extern void *                 machine_snd;
 /* Core functions. */
 extern int         machine_count(void);
 extern int         machine_available(int m);
+extern void        machine_available_scan_all(void);
+extern void        machine_available_flush(void);
 extern const char *machine_getname(void);
 extern const char *machine_getname_ex(int m);
 extern const char *machine_get_internal_name(void);
@@ -29,4 +29,10 @@ extern machine_status_t machine_status;
 
 extern void machine_status_init(void);
 
+/* Change counter bumped whenever a device pushes a new LED or media state;
+   the UI tick compares it against the last value it consumed and skips the
+   full table rescan while nothing has changed. */
+extern void     machine_status_mark(void);
+extern uint32_t machine_status_changes(void);
+
 #endif /*EMU_MACHINE_STATUS_H*/
\ No newline at end of file
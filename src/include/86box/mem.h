@@ -271,6 +271,25 @@ extern int        readlnext;
 extern int        writelookup[256];
 extern uintptr_t *writelookup2;
 extern int        writelnext;
+
+/* Micro-TLB in front of readlookup2/writelookup2 - the last few translated
+   pages per direction, small enough to stay cache-hot where the 8 MB lookup
+   tables do not. Entries are copies of lookup table entries and must be
+   flushed (mem_mutlb_flush_*) whenever a lookup table entry is evicted. */
+#define MUTLB_NR  4
+#define MUTLB_INV 0xffffffff
+
+typedef struct mutlb_t {
+    uint32_t  page[MUTLB_NR];
+    uintptr_t lookup[MUTLB_NR];
+    uint32_t  next;
+} mutlb_t;
+
+extern mutlb_t mutlb_read;
+extern mutlb_t mutlb_write;
+
+extern void mem_mutlb_flush_read(void);
+extern void mem_mutlb_flush_write(void);
 extern uint32_t   ram_mapped_addr[64];
 extern uint8_t    page_ff[4096];
 
@@ -285,6 +304,7 @@ extern mem_mapping_t bios_mapping;
 extern mem_mapping_t bios_high_mapping;
 
 extern uint32_t mem_logical_addr;
+extern uint32_t mem_mapping_generation;
 
 extern page_t  *pages;
 extern page_t **page_lookup;
@@ -350,6 +370,20 @@ extern void     writememll_no_mmut_2386(uint32_t addr, uint32_t *a64, uint32_t v
 extern void     do_mmutranslate_2386(uint32_t addr, uint32_t *a64, int num, int write);
 
 extern uint8_t *getpccache(uint32_t a);
+
+/* Direct-mapped second-level fetch cache behind the single-entry pccache.
+   Lines are keyed by linear page and tagged with mem_mapping_generation,
+   so a mapping recalc implicitly drops them all; any MMU cache flush
+   drops them explicitly via pccache_l2_flush(). */
+#define PCCACHE_L2_NR 64
+typedef struct pccache_line_t {
+    uint32_t page;       /* Linear page number, 0xffffffff if invalid. */
+    uint32_t generation; /* mem_mapping_generation at fill time. */
+    uint8_t *ptr;
+} pccache_line_t;
+extern pccache_line_t pccache_l2[PCCACHE_L2_NR];
+extern void           pccache_l2_flush(void);
+
 extern uint64_t mmutranslatereal(uint32_t addr, int rw);
 extern uint32_t mmutranslatereal32(uint32_t addr, int rw);
 extern void     addreadlookup(uint32_t virt, uint32_t phys);
@@ -393,10 +427,16 @@ extern void mem_mapping_set_p(mem_mapping_t *, void *priv);
 extern void mem_mapping_set_addr(mem_mapping_t *,
                                  uint32_t base, uint32_t size);
 extern void mem_mapping_set_exec(mem_mapping_t *, uint8_t *exec);
+extern void mem_mapping_update_exec(mem_mapping_t *, uint8_t *exec);
 extern void mem_mapping_set_mask(mem_mapping_t *, uint32_t mask);
 extern void mem_mapping_disable(mem_mapping_t *);
 extern void mem_mapping_enable(mem_mapping_t *);
 extern void mem_mapping_recalc(uint64_t base, uint64_t size);
+/* Batch several mem_set_mem_state()/flushmmucache() calls into one recalc
+   and at most one flush; for chipset register handlers that derive multiple
+   shadow/SMRAM ranges from a single write. Nestable. */
+extern void mem_recalc_begin(void);
+extern void mem_recalc_commit(void);
 
 extern void mem_set_access(uint8_t bitmap, int mode, uint32_t base, uint32_t size, uint16_t access);
 
@@ -408,6 +448,7 @@ extern void     mem_writeb_phys(uint32_t addr, uint8_t val);
 extern void     mem_writew_phys(uint32_t addr, uint16_t val);
 extern void     mem_writel_phys(uint32_t addr, uint32_t val);
 extern void     mem_write_phys(void *src, uint32_t addr, int tranfer_size);
+extern uint8_t *mem_get_phys_ptr(uint32_t addr, uint32_t len, int write);
 
 extern uint8_t  mem_read_ram(uint32_t addr, void *priv);
 extern uint16_t mem_read_ramw(uint32_t addr, void *priv);
@@ -434,10 +475,24 @@ extern void mem_write_ramw_page(uint32_t addr, uint16_t val, page_t *page);
 extern void mem_write_raml_page(uint32_t addr, uint32_t val, page_t *page);
 extern void mem_flush_write_page(uint32_t addr, uint32_t virt);
 
+/* Write watch backing the segment descriptor cache in x86seg.c: arming a
+   physical page forces its stores onto the page_t handlers, which bump
+   mem_desc_watch_gen on the first real modification. */
+extern void     mem_desc_watch_page(uint32_t phys_page);
+extern uint32_t mem_desc_watch_gen;
+
+/* Write-combining lookups for framebuffer-style mappings: the owner installs
+   direct host pointers for pages with plain-RAM write semantics and replaces
+   the per-write dirty updates with a sweep at frame boundaries. */
+extern void addwritelookup_wc(uint32_t virt, uint32_t phys, uint8_t *host_page, void *tag);
+extern void mem_wc_flush(void);
+extern void mem_wc_sweep(void *tag, void (*mark)(uint32_t phys_page, void *tag));
+
 extern void mem_reset_page_blocks(void);
 
 extern void flushmmucache(void);
 extern void flushmmucache_nopc(void);
+extern void flushmmucache_range(uint64_t base, uint64_t size);
 
 extern void mem_debug_check_addr(uint32_t addr, int write);
 
@@ -448,6 +503,8 @@ extern void mem_init(void);
 extern void mem_close(void);
 extern void mem_reset(void);
 extern void mem_remap_top(int kb);
+extern void mem_compact(void);
+extern void mem_scavenge(int max_chunks);
 
 extern mem_mapping_t *read_mapping[MEM_MAPPINGS_NO];
 extern mem_mapping_t *write_mapping[MEM_MAPPINGS_NO];
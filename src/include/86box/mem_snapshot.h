@@ -0,0 +1,43 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the copy-on-write guest RAM snapshot engine.
+ *
+ *
+ *
+ * Authors: The 86Box team.
+ *
+ *          Copyright 2026 The 86Box team.
+ */
+
+#ifndef EMU_MEM_SNAPSHOT_H
+#define EMU_MEM_SNAPSHOT_H
+
+/* Start an asynchronous snapshot of guest RAM to the given file. Returns 0
+   on success; the call itself only arms the copy-on-write tracking and
+   spawns the writer thread, so it returns quickly regardless of RAM size.
+   Fails (-1) if a snapshot is already in progress or the file cannot be
+   created. */
+extern int mem_snapshot_start(const char *path);
+
+/* Non-zero while a snapshot writer is still running. */
+extern int mem_snapshot_busy(void);
+
+/* Block until the current snapshot (if any) has been written out. */
+extern void mem_snapshot_wait(void);
+
+/* Restore guest RAM from a snapshot file. Synchronous; the caller must make
+   sure the emulated machine is paused. Returns 0 on success. */
+extern int mem_snapshot_restore(const char *path);
+
+/* Internal interface used by the memory subsystem's write paths. */
+extern int  mem_snapshot_active;
+extern int  mem_snapshot_page_pending(uint32_t phys_page);
+extern void mem_snapshot_cow(uint32_t addr);
+
+#endif /*EMU_MEM_SNAPSHOT_H*/
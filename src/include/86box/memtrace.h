@@ -0,0 +1,59 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the guest memory access tracer.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_MEMTRACE_H
+#define EMU_MEMTRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMTRACE_READ  0
+#define MEMTRACE_WRITE 1
+
+/* One record per traced access, written verbatim to the trace file. */
+typedef struct memtrace_rec_t {
+    uint32_t pc;   /* linear PC (CS base + EIP) */
+    uint32_t addr; /* linear address of the access */
+    uint8_t  size; /* 1/2/4/8 */
+    uint8_t  write;
+    uint16_t pad;
+} memtrace_rec_t;
+
+extern int      memtrace_on;
+extern uint64_t memtrace_pages[(((uint32_t) -1) >> (12 + 6)) + 1];
+
+extern void memtrace_start(const char *path);
+extern void memtrace_stop(void);
+extern void memtrace_filter(uint32_t addr, uint32_t len);
+extern void memtrace_access(uint32_t addr, int size, int rw);
+
+/* Hook for the slow memory handlers: one predictable branch when the
+   tracer is off, a page filter lookup when it is on. */
+#define MEMTRACE_ACCESS(addr, width, rw)                                             \
+    do {                                                                             \
+        if (memtrace_on) {                                                           \
+            uint32_t memtrace_page = (addr) >> 12;                                   \
+            if (memtrace_pages[memtrace_page >> 6] & (1ULL << (memtrace_page & 63))) \
+                memtrace_access((addr), (width), (rw));                              \
+        }                                                                            \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_MEMTRACE_H*/
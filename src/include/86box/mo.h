@@ -90,6 +90,14 @@ enum {
     MO_BUS_USB      = 7
 };
 
+/* States of an asynchronous image mount. */
+enum {
+    MO_LOAD_IDLE = 0,
+    MO_LOAD_BUSY,
+    MO_LOAD_DONE,
+    MO_LOAD_FAIL
+};
+
 typedef struct mo_drive_t {
     uint8_t id;
 
@@ -172,6 +180,12 @@ typedef struct mo_t {
     uint32_t packet_len;
 
     double callback;
+
+    /* Asynchronous mount state; load_state is only ever written by one
+       side at a time (worker while BUSY, emulation thread otherwise). */
+    void *load_thread;
+    int   load_state;
+    char  load_path[1024];
 } mo_t;
 
 extern mo_t      *mo[MO_NUM];
@@ -199,6 +213,7 @@ extern void mo_hard_reset(void);
 
 extern void mo_reset(scsi_common_t *sc);
 extern int  mo_load(mo_t *dev, char *fn);
+extern void mo_load_async(mo_t *dev, char *fn);
 extern void mo_close(void);
 
 #ifdef __cplusplus
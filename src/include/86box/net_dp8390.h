@@ -186,6 +186,14 @@ typedef struct dp8390_t {
     int tx_timer_index;
     int tx_timer_active;
 
+    /* RX acceptance state precompiled from CR/RCR/TCR/DCR/MAR writes,
+       evaluated by dp8390_rx_filter() on the host RX thread before packets
+       queue toward the device. */
+    int      rx_filter_active;
+    int      rx_accept_bcast;
+    int      rx_accept_mcast;
+    uint64_t rx_mcast_bits;
+
     void      *priv;
     netcard_t *card;
 
@@ -203,6 +211,9 @@ extern void     dp8390_write_cr(dp8390_t *dev, uint32_t val);
 
 extern int dp8390_rx(void *priv, uint8_t *buf, int io_len);
 
+extern int  dp8390_rx_filter(void *priv, const uint8_t *buf, int io_len);
+extern void dp8390_rx_filter_update(dp8390_t *dev);
+
 extern uint32_t dp8390_page0_read(dp8390_t *dev, uint32_t off, unsigned int len);
 extern void     dp8390_page0_write(dp8390_t *dev, uint32_t off, uint32_t val, unsigned len);
 extern uint32_t dp8390_page1_read(dp8390_t *dev, uint32_t off, unsigned int len);
@@ -47,6 +47,13 @@
 #define EMU_NETWORK_H
 #include <stdint.h>
 
+#ifdef __cplusplus
+#    include <atomic>
+using atomic_int = std::atomic_int;
+#else
+#    include <stdatomic.h>
+#endif
+
 /* Network provider types. */
 #define NET_TYPE_NONE  0 /* use the null network driver */
 #define NET_TYPE_SLIRP 1 /* use the SLiRP port forwarder */
@@ -54,8 +61,9 @@
 #define NET_TYPE_VDE   3 /* use the VDE plug API */
 
 #define NET_MAX_FRAME  1518
-/* Queue size must be a power of 2 */
-#define NET_QUEUE_LEN      16
+/* Queue size must be a power of 2. Deep enough to absorb a capture burst
+   handed over by the host backend in one batch. */
+#define NET_QUEUE_LEN      64
 #define NET_QUEUE_LEN_MASK (NET_QUEUE_LEN - 1)
 #define NET_QUEUE_COUNT 3
 #define NET_CARD_MAX       4
@@ -100,6 +108,7 @@ extern netcard_conf_t net_cards_conf[NET_CARD_MAX];
 extern uint16_t       net_card_current;
 
 typedef int (*NETRXCB)(void *, uint8_t *, int);
+typedef int (*NETRXFILTER)(void *, const uint8_t *, int);
 typedef int (*NETSETLINKSTATE)(void *, uint32_t link_state);
 
 typedef struct netpkt {
@@ -107,14 +116,19 @@ typedef struct netpkt {
     int      len;
 } netpkt_t;
 
+/* Single-producer single-consumer ring; the atomic head/tail indexes make the
+   handoff between the emulator thread and the host backend thread lock-free. */
 typedef struct netqueue_t {
-    netpkt_t packets[NET_QUEUE_LEN];
-    int      head;
-    int      tail;
+    netpkt_t   packets[NET_QUEUE_LEN];
+    atomic_int head;
+    atomic_int tail;
 } netqueue_t;
 
 typedef struct _netcard_t netcard_t;
 
+/* Optional per-card capture tap; internals live in network.c. */
+typedef struct netcap_t netcap_t;
+
 typedef struct netdrv_t {
     void (*notify_in)(void *priv);
     void *(*init)(const netcard_t *card, const uint8_t *mac_addr, void *priv, char *netdrv_errbuf);
@@ -132,10 +146,16 @@ struct _netcard_t {
     void           *card_drv;
     struct netdrv_t host_drv;
     NETRXCB         rx;
+    /* Optional early acceptance check run by RX producers; packets it
+       rejects are dropped before they pay for queueing and a poll. */
+    NETRXFILTER     rx_filter;
     NETSETLINKSTATE set_link_state;
     netqueue_t      queues[NET_QUEUE_COUNT];
     netpkt_t        queued_pkt;
-    mutex_t        *tx_mutex;
+    /* Capture tap, NULL unless net_NN_capture is enabled in the config. */
+    netcap_t       *cap;
+    /* Serializes RX producers only (host backend thread and device loopback);
+       the RX consumer and both TX directions run lock-free. */
     mutex_t        *rx_mutex;
     pc_timer_t      timer;
     uint16_t        card_num;
@@ -174,11 +194,14 @@ extern netdev_t         network_devs[NET_HOST_INTF_MAX];
 /* Function prototypes. */
 extern void       network_init(void);
 extern netcard_t *network_attach(void *card_drv, uint8_t *mac, NETRXCB rx, NETSETLINKSTATE set_link_state);
+extern void       network_set_rx_filter(netcard_t *card, NETRXFILTER rx_filter);
 extern void       netcard_close(netcard_t *card);
 extern void       network_close(void);
 extern void       network_reset(void);
 extern int        network_available(void);
 extern void       network_tx(netcard_t *card, uint8_t *, int);
+extern netpkt_t  *network_tx_reserve(netcard_t *card);
+extern void       network_tx_commit(netcard_t *card, int len);
 
 extern int net_pcap_prepare(netdev_t *);
 extern int net_vde_prepare(void);
@@ -59,6 +59,7 @@
 #define TIME_SYNC_DISABLED 0
 #define TIME_SYNC_ENABLED  1
 #define TIME_SYNC_UTC      2
+#define TIME_SYNC_DRIFT    4 /* keep slewing the guest clock to host time */
 
 /* Define a generic RTC/NVRAM device. */
 typedef struct _nvr_ {
@@ -110,6 +111,8 @@ extern int   nvr_load(void);
 extern void  nvr_close(void);
 extern void  nvr_set_ven_save(void (*ven_save)(void));
 extern int   nvr_save(void);
+extern void  nvr_file_dirty(const char *fn, const void *data, int size);
+extern void  nvr_file_sync(const char *fn);
 
 extern int  nvr_is_leap(int year);
 extern int  nvr_get_days(int month, int year);
@@ -0,0 +1,46 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the always-on hot-path performance counters.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_PERFSTATS_H
+#define EMU_PERFSTATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hot-path event counters, incremented inline and reset every emulated
+   second. All counting sites run on the emulation thread, so plain
+   increments are sufficient. */
+typedef struct perf_counters_t {
+    uint64_t insns;           /* guest instructions executed */
+    uint64_t blocks_compiled; /* recompiler blocks (re)compiled */
+    uint64_t blocks_unrolled; /* blocks compiled with the loop body unrolled */
+    uint64_t blocks_deleted;  /* recompiler blocks evicted or invalidated */
+    uint64_t lookup_fills;    /* read/write address lookup cache fills */
+    uint64_t timer_fires;     /* timer callbacks dispatched */
+} perf_counters_t;
+
+extern perf_counters_t perfc;
+
+extern int perfstats_on;
+
+extern void perfstats_onesec(int cur_fps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_PERFSTATS_H*/
@@ -59,6 +59,23 @@ typedef struct pic {
 extern pic_t pic;
 extern pic_t pic2;
 
+/* Set when an IRQ line change has been recorded but the cascade priority
+   resolver has not run on it yet; the resolver pass is deferred to the
+   CPU's interrupt poll at the next instruction boundary. */
+extern int  pic_pending_dirty;
+extern void pic_update_pending(void);
+
+/* Interrupt poll helper for the CPU cores: run the deferred resolver pass,
+   if one is outstanding, and report whether an interrupt is pending. */
+static __inline uint8_t
+pic_irq_pending(void)
+{
+    if (pic_pending_dirty)
+        pic_update_pending();
+
+    return pic.int_pending;
+}
+
 extern void     pic_reset_smi_irq_mask(void);
 extern void     pic_set_smi_irq_mask(int irq, int set);
 extern uint16_t pic_get_smi_irq_status(void);
@@ -65,6 +65,10 @@ typedef struct PIT {
     int        clock;
     pc_timer_t callback_timer;
 
+    uint32_t skip_clocks; /* full input clocks covered by the current timer batch */
+    uint32_t skip_folded; /* clocks of the batch already folded into the counters */
+    uint64_t skip_len;    /* length of the current batch, in 32:32 TSC ticks */
+
     ctr_t counters[3];
 
     uint8_t ctrl;
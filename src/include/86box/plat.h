@@ -118,6 +118,7 @@ extern char    *fix_exe_path(char *str);
 extern FILE    *plat_fopen(const char *path, const char *mode);
 extern FILE    *plat_fopen64(const char *path, const char *mode);
 extern void     plat_remove(char *path);
+extern int      plat_rename(char *oldpath, char *newpath);
 extern int      plat_getcwd(char *bufp, int max);
 extern int      plat_chdir(char *path);
 extern void     plat_tempfile(char *bufp, char *prefix, char *suffix);
@@ -127,7 +128,12 @@ extern void     plat_init_rom_paths(void);
 extern int      plat_dir_check(char *path);
 extern int      plat_dir_create(char *path);
 extern void    *plat_mmap(size_t size, uint8_t executable);
+extern void    *plat_mmap_huge(size_t size, uint8_t executable);
 extern void     plat_munmap(void *ptr, size_t size);
+extern void    *plat_mmap_file(const char *path, size_t size);
+extern void     plat_munmap_file(void *ptr, size_t size);
+extern void     plat_memory_cold(void *ptr, size_t size);
+extern void     plat_memory_free_zero(void *ptr, size_t size);
 extern uint64_t plat_timer_read(void);
 extern uint32_t plat_get_ticks(void);
 extern uint32_t plat_get_micro_ticks(void);
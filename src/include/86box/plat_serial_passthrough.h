@@ -27,6 +27,7 @@ extern "C" {
 
 extern void plat_serpt_write(void *priv, uint8_t data);
 extern int  plat_serpt_read(void *priv, uint8_t *data);
+extern int  plat_serpt_read_buf(void *priv, uint8_t *data, int max);
 extern int  plat_serpt_open_device(void *priv);
 extern void plat_serpt_close(void *priv);
 extern void plat_serpt_set_params(void *priv);
@@ -0,0 +1,33 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the POST fast-forward mode.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_POSTFF_H
+#define EMU_POSTFF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int postff_on;
+
+extern void postff_start(int seconds);
+extern void postff_machine_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_POSTFF_H*/
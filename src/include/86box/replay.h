@@ -0,0 +1,50 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for deterministic input record/replay.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_REPLAY_H
+#define EMU_REPLAY_H
+
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    REPLAY_OFF = 0,
+    REPLAY_RECORD,
+    REPLAY_PLAY
+};
+
+extern int replay_mode;
+
+/* Set while the replayer itself is injecting an event, so the input
+   paths can tell injected events from live ones (which are ignored
+   during playback). */
+extern int replay_injecting;
+
+extern void   replay_start_record(const char *path);
+extern void   replay_start_play(const char *path);
+extern void   replay_machine_init(void);
+extern void   replay_close(void);
+extern void   replay_record_key(int down, uint16_t scan);
+extern time_t replay_host_time(time_t host);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_REPLAY_H*/
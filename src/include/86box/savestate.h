@@ -0,0 +1,33 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the versioned machine save-state subsystem.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_SAVESTATE_H
+#define EMU_SAVESTATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Both return 1 on success and 0 on failure; savestate_load() refuses a
+   state taken on a different machine, memory size or format version. */
+extern int savestate_save(const char *path);
+extern int savestate_load(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_SAVESTATE_H*/
@@ -68,6 +68,7 @@ typedef struct serial_s {
     uint8_t bits;
     uint8_t data_bits;
     uint8_t baud_cycles;
+    uint8_t baud_pending;
     uint8_t txsr;
     uint8_t txsr_empty;
     uint8_t msr_set;
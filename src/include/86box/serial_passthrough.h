@@ -47,6 +47,11 @@ typedef struct serial_passthrough_s {
     uint8_t                      data_bits;
     uint8_t                      port;
     uint8_t                      data;
+    uint8_t                      unthrottled; /* Pace host->guest delivery at the RSR rate
+                                               * instead of the full byte frame time. */
+    int                          ring_head;   /* Bytes read from the host in bulk, drained */
+    int                          ring_tail;   /* into the UART one at a time. */
+    uint8_t                      ring[4096];
     char                         slave_pt[32]; /* used for pseudo term name of slave side */
     intptr_t                     master_fd;    /* file desc for master pseudo terminal or
                                                 * socket or alike */
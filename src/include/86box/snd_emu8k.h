@@ -1,12 +1,23 @@
 #ifndef SOUND_EMU8K_H
 #define SOUND_EMU8K_H
 
+#include <86box/thread.h>
+
 /* All these defines are in samples, not in bytes. */
 #define EMU8K_MEM_ADDRESS_MASK  0xFFFFFF
 #define EMU8K_RAM_MEM_START     0x200000
 #define EMU8K_FM_MEM_ADDRESS    0xFFFFE0
 #define EMU8K_RAM_POINTERS_MASK 0x3F
 #define EMU8K_LFOCHORUS_SIZE    0x4000
+
+/* Worker pool for the voice section of emu8k_update(). Each worker owns a
+ * fixed bank of voices and accumulates into private buffers, which the
+ * emulation thread then sums into the output and effect send buffers. */
+#define EMU8K_RENDER_THREADS    2
+#define EMU8K_VOICES_PER_THREAD 16
+/* Batches shorter than this render inline on the emulation thread; waking the
+ * workers costs more than the voice math for a handful of samples. */
+#define EMU8K_RENDER_MIN_SAMPLES 64
 /*
  * Everything in this file assumes little endian
  */
@@ -397,6 +408,16 @@ typedef struct emu8k_t {
     int     pos;
     int32_t buffer[SOUNDBUFLEN * 2];
 
+    thread_t    *render_thread[EMU8K_RENDER_THREADS];
+    event_t     *render_wake[EMU8K_RENDER_THREADS];
+    event_t     *render_done[EMU8K_RENDER_THREADS];
+    volatile int render_run;
+    int          render_pos;
+    int          render_new_pos;
+    int32_t      render_buffer[EMU8K_RENDER_THREADS][SOUNDBUFLEN * 2];
+    int32_t      render_reverb_in[EMU8K_RENDER_THREADS][SOUNDBUFLEN];
+    int32_t      render_chorus_in[EMU8K_RENDER_THREADS][SOUNDBUFLEN];
+
     uint16_t addr;
 } emu8k_t;
 
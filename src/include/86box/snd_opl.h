@@ -26,9 +26,10 @@ enum fm_type {
 };
 
 enum fm_driver {
-    FM_DRV_NUKED = 0,
-    FM_DRV_YMFM  = 1,
-    FM_DRV_MAX   = 2
+    FM_DRV_NUKED   = 0,
+    FM_DRV_YMFM    = 1,
+    FM_DRV_CAPTURE = 2, /* log register writes for offline synthesis, output silence */
+    FM_DRV_MAX     = 3
 };
 
 typedef struct fm_drv_t {
@@ -45,11 +46,15 @@ extern uint8_t fm_driver_get(int chip_id, fm_drv_t *drv);
 
 extern const fm_drv_t nuked_opl_drv;
 extern const fm_drv_t ymfm_drv;
+extern const fm_drv_t opl_capture_drv;
 
 #ifdef EMU_DEVICE_H
 extern const device_t ym3812_nuked_device;
 extern const device_t ymf262_nuked_device;
 
+extern const device_t ym3812_capture_device;
+extern const device_t ymf262_capture_device;
+
 extern const device_t ym3812_ymfm_device;
 extern const device_t ymf262_ymfm_device;
 extern const device_t ymf289b_ymfm_device;
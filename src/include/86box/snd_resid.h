@@ -1,10 +1,16 @@
 #ifndef SOUND_RESID_H
 #define SOUND_RESID_H
 
+enum {
+    SID_QUALITY_HIGH = 0, /* filter and external filter active (default) */
+    SID_QUALITY_FAST      /* filter stages bypassed */
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 void   *sid_init(void);
+void    sid_set_quality(void *priv, int quality);
 void    sid_close(void *priv);
 void    sid_reset(void *priv);
 uint8_t sid_read(uint16_t addr, void *priv);
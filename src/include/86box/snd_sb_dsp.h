@@ -114,6 +114,9 @@ typedef struct sb_dsp_t {
     double sblatcho;
     double sblatchi;
 
+    int    sb_output_batch; /* sample clocks covered by the pending output timer event */
+    double sb_output_latch; /* delay the pending output event was scheduled with */
+
     uint16_t sb_addr;
 
     int stereo;
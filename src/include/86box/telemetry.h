@@ -0,0 +1,78 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the telemetry export channel, including the
+ *          shared layout an external collector maps to consume the
+ *          per-slice timing records.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_TELEMETRY_H
+#define EMU_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_MAGIC   0x4C543638 /* '86TL' when read as bytes */
+#define TELEMETRY_VERSION 1
+/* At the 10-40 ms slice lengths the governor uses this holds roughly
+   10-40 seconds of history. */
+#define TELEMETRY_SLOTS   1024
+
+/* Shared layout: one header, then TELEMETRY_SLOTS fixed-size records.
+   The emulator only ever writes; a collector maps the same file
+   read-only. Publication follows the same per-slot seqlock protocol as
+   the frame export channel (see 86box/frameexport.h): the producer
+   writes seq0, the record fields, then seq1, then header.seq, and a
+   consumer accepts a copy only when seq0 == seq1 == seq around it. */
+typedef struct telemetry_header_t {
+    uint32_t magic;       /* TELEMETRY_MAGIC */
+    uint32_t version;     /* TELEMETRY_VERSION */
+    uint32_t nr_slots;    /* TELEMETRY_SLOTS */
+    uint32_t record_size; /* sizeof(telemetry_record_t) */
+    uint32_t reserved[3];
+    volatile uint32_t seq; /* sequence number of the latest complete record */
+} telemetry_header_t;
+
+/* One record per pc_run() slice. */
+typedef struct telemetry_record_t {
+    volatile uint32_t seq0; /* written before the fields... */
+    uint32_t emu_us;        /* emulated time the slice covered */
+    uint32_t host_us;       /* host wall-clock time the slice took */
+    uint32_t speed_pct;     /* achieved speed, percent of real time */
+    uint32_t blit_us;       /* host time the blit thread spent rendering */
+    uint32_t audio_fill;    /* playback queue depth last seen by the backend */
+    uint32_t audio_underruns; /* times the playback source ran dry */
+    uint32_t audio_drops;   /* buffers discarded because the queue was full */
+    volatile uint32_t seq1; /* ...and after; equal values mean consistent */
+} telemetry_record_t;
+
+extern int telemetry_on;
+
+/* Monotonic counters fed by the blit and audio threads and sampled as
+   deltas on the emulation thread once per slice. They are word-sized
+   and unlocked; a torn read at worst skews a single record. Sound
+   backends without queue introspection leave the audio ones at zero. */
+extern uint32_t telemetry_blit_us;
+extern uint32_t telemetry_audio_underruns;
+extern uint32_t telemetry_audio_drops;
+extern uint32_t telemetry_audio_fill;
+
+extern void telemetry_start(const char *path);
+extern void telemetry_slice(int slice_ms, uint32_t host_us, uint32_t speed_pct);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_TELEMETRY_H*/
@@ -50,8 +50,9 @@ typedef struct pc_timer_t {
     void (*callback)(void *priv);
     void *priv;
 
-    struct pc_timer_t *prev;
-    struct pc_timer_t *next;
+    struct pc_timer_t *prev;  /* Previous sibling, or the parent if we are its first child. */
+    struct pc_timer_t *next;  /* Next sibling in the pairing heap. */
+    struct pc_timer_t *child; /* First child in the pairing heap. */
 } pc_timer_t;
 
 #ifdef __cplusplus
@@ -78,6 +79,21 @@ extern void timer_init(void);
   timestamp - this is useful for permanently enabled timers*/
 extern void timer_add(pc_timer_t *timer, void (*callback)(void *priv), void *priv, int start_timer);
 
+/*Microseconds of emulated time until the nearest enabled timer expires,
+  read from a seqlock-protected snapshot so host-side threads can pace
+  their sleeps against it. Returns 0.0 when a deadline is already due and
+  a negative value when no snapshot is available.*/
+extern double timer_next_deadline_us(void);
+
+/*Coherent (tsc, timer_target, TIMER_USEC) triple from the same snapshot,
+  for threads that need emulated time without touching the CPU thread's
+  live globals. Returns 0 if no snapshot has been published yet.*/
+extern int timer_read_snapshot(uint64_t *tsc_snap, uint32_t *target, uint64_t *usec_scale);
+
+/*Best-effort textual dump of the pending timer heap, for the hang
+  watchdog. fp is a FILE pointer.*/
+extern void timer_dump(void *fp);
+
 /*1us in 32:32 format*/
 extern uint64_t TIMER_USEC;
 
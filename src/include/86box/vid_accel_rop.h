@@ -0,0 +1,205 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Raster operation kernels for the XGA and 8514/A blit engines.
+ *          The two adapters use different mix opcode tables, so each
+ *          gets its own kernel; both take the pre-masked mix opcode as
+ *          a value so the callers can hoist the register read out of
+ *          their per-pixel loops and the switch compiles to a jump
+ *          table on a register. Expects MIN/MAX from <86box/86box.h>.
+ *
+ *
+ *
+ * Authors: TheCollector1995, <mariogplayer@gmail.com>,
+ *          Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef VIDEO_ACCEL_ROP_H
+#define VIDEO_ACCEL_ROP_H
+
+/* XGA mix table (Inverting ... Average). */
+static __inline uint32_t
+xga_accel_rop(uint8_t rop, uint32_t d, uint32_t s)
+{
+    switch (rop) {
+        case 0x00:
+            return 0;
+        case 0x01:
+            return s & d;
+        case 0x02:
+            return s & ~d;
+        case 0x03:
+            return s;
+        case 0x04:
+            return ~s & d;
+        case 0x05:
+            return d;
+        case 0x06:
+            return s ^ d;
+        case 0x07:
+            return s | d;
+        case 0x08:
+            return ~s & ~d;
+        case 0x09:
+            return s ^ ~d;
+        case 0x0a:
+            return ~d;
+        case 0x0b:
+            return s | ~d;
+        case 0x0c:
+            return ~s;
+        case 0x0d:
+            return ~s | d;
+        case 0x0e:
+            return ~s | ~d;
+        case 0x0f:
+            return ~0;
+        case 0x10:
+            return MAX(s, d);
+        case 0x11:
+            return MIN(s, d);
+        case 0x12:
+            return MIN(~0, s + d);
+        case 0x13:
+            return MAX(0, d - s);
+        case 0x14:
+            return MAX(0, s - d);
+        case 0x15:
+            return (s + d) >> 1;
+
+        default:
+            break;
+    }
+    return d;
+}
+
+/* 8514/A mix table (NOT destination ... saturating average). The engine
+   works on 8/16-bit pixels in int arithmetic; the saturating cases rely
+   on the operands staying signed, so do not widen them to uint32_t. */
+static __inline int
+ibm8514_accel_mix(uint8_t rop, int d, int s)
+{
+    switch (rop) {
+        case 0x00:
+            return ~d;
+        case 0x01:
+            return 0;
+        case 0x02:
+            return ~0;
+        case 0x03:
+            return d;
+        case 0x04:
+            return ~s;
+        case 0x05:
+            return s ^ d;
+        case 0x06:
+            return ~(s ^ d);
+        case 0x07:
+            return s;
+        case 0x08:
+            return ~(s & d);
+        case 0x09:
+            return ~s | d;
+        case 0x0a:
+            return s | ~d;
+        case 0x0b:
+            return s | d;
+        case 0x0c:
+            return s & d;
+        case 0x0d:
+            return s & ~d;
+        case 0x0e:
+            return ~s & d;
+        case 0x0f:
+            return ~(s | d);
+        case 0x10:
+            return MIN(s, d);
+        case 0x11:
+            return d - s;
+        case 0x12:
+            return s - d;
+        case 0x13:
+            return s + d;
+        case 0x14:
+            return MAX(s, d);
+        case 0x15:
+            return (d - s) >> 1;
+        case 0x16:
+            return (s - d) >> 1;
+        case 0x17:
+            return (d + s) >> 1;
+        case 0x18:
+        case 0x19:
+            return MAX(0, (d - s));
+        case 0x1a:
+            return MAX(0, (s - d));
+        case 0x1b:
+            return MIN(~0, (d + s));
+        case 0x1c:
+        case 0x1d:
+            return MAX(0, (d - s)) / 2;
+        case 0x1e:
+            return MAX(0, (s - d)) / 2;
+        case 0x1f:
+            return (~0 < (s + d)) ? ~0 : ((s + d) >> 1);
+
+        default:
+            break;
+    }
+    return d;
+}
+
+/* Mach64 mix table: the 16 logical 8514-style mixes plus average; the
+   remaining opcodes leave the destination unchanged, as before. */
+static __inline uint32_t
+mach64_accel_mix(uint8_t rop, uint32_t d, uint32_t s)
+{
+    switch (rop) {
+        case 0x00:
+            return ~d;
+        case 0x01:
+            return 0;
+        case 0x02:
+            return 0xffffffff;
+        case 0x03:
+            return d;
+        case 0x04:
+            return ~s;
+        case 0x05:
+            return s ^ d;
+        case 0x06:
+            return ~(s ^ d);
+        case 0x07:
+            return s;
+        case 0x08:
+            return ~(s & d);
+        case 0x09:
+            return ~s | d;
+        case 0x0a:
+            return s | ~d;
+        case 0x0b:
+            return s | d;
+        case 0x0c:
+            return s & d;
+        case 0x0d:
+            return s & ~d;
+        case 0x0e:
+            return ~s & d;
+        case 0x0f:
+            return ~(s | d);
+        case 0x17:
+            return (d + s) >> 1;
+
+        default:
+            break;
+    }
+    return d;
+}
+
+#endif /*VIDEO_ACCEL_ROP_H*/
@@ -67,6 +67,9 @@ typedef struct cga_t {
     int snow_enabled;
     int rgb_type;
     int double_type;
+
+    uint32_t line_hash[1024]; /* Per-scanline content hashes for redraw skipping. */
+    uint8_t  line_clean[1024];
 } cga_t;
 
 void    cga_init(cga_t *cga);
@@ -62,6 +62,8 @@ typedef struct {
     uint8_t *vram;
     int      monitor_index;
     int      prev_monitor_index;
+
+    uint32_t line_hash[1024]; /* Per-scanline content hashes for redraw skipping. */
 } hercules_t;
 
 #define VIDEO_MONITOR_PROLOGUE()                        \
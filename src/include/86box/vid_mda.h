@@ -39,6 +39,8 @@ typedef struct mda_t {
     int      prev_monitor_index;
 
     uint8_t *vram;
+
+    uint32_t line_hash[512]; /* Per-scanline content hashes for redraw skipping. */
 } mda_t;
 
 #define VIDEO_MONITOR_PROLOGUE()                        \
@@ -110,6 +110,11 @@ typedef struct svga_t {
     int lastline;
     int firstline_draw;
     int lastline_draw;
+    int dirty_x0;
+    int dirty_x1;
+
+    int frame_skip_active;
+
     int displine;
     int fullchange;
     int x_add;
@@ -180,6 +185,11 @@ typedef struct svga_t {
     void (*render8514)(struct svga_t *svga);
     void (*recalctimings_ex)(struct svga_t *svga);
 
+    /* Bumped by svga_recalctimings() whenever the selected render function
+       actually changes; consumers can compare stamps instead of function
+       pointers to detect a real mode switch across a recalc storm. */
+    uint32_t render_version;
+
     void (*video_out)(uint16_t addr, uint8_t val, void *priv);
     uint8_t (*video_in)(uint16_t addr, void *priv);
 
@@ -216,6 +226,14 @@ typedef struct svga_t {
     uint8_t *vram;
     uint8_t *changedvram;
 
+    /* One dirty bit per 4K page of changedvram, one 64-bit word per 256K
+       region, so the frame-end aging pass in svga_poll() only visits
+       regions whose word is non-zero. Kept in step with the byte counters
+       by svga_dirty_mark(). */
+    uint64_t *changedvram_sum;
+    uint32_t  changedvram_words;
+    uint32_t  changedvram_scrub;
+
     uint8_t crtcreg;
     uint8_t gdcaddr;
     uint8_t attrff;
@@ -283,8 +301,29 @@ typedef struct svga_t {
     void *  dev8514;
     void *  ext8514;
     void *  xga;
+
+    /* Per-scanline tables live at the tail so the 10 KB they occupy does
+       not sit between the scalars svga_poll() touches every scanline. */
+
+    /* Per-scanline content hashes for the 80-column text renderer; cleared
+       whenever the line is overwritten by anything else. */
+    uint32_t text_line_hash[2048];
+
+    /* Scanlines the hardware cursor or an overlay drew over last frame;
+       they are re-rendered from VRAM on the next frame so the overdraw is
+       erased without aging the changed VRAM pages. */
+    uint8_t line_overdrawn[2048];
 } svga_t;
 
+/* Mark a 4K VRAM page changed. All writers go through here so the per-page
+   age counter and its summary bit stay in step. */
+static __inline void
+svga_dirty_mark(svga_t *svga, uint32_t page)
+{
+    svga->changedvram[page] = svga->monitor->mon_changeframecount;
+    svga->changedvram_sum[page >> 6] |= 1ULL << (page & 0x3f);
+}
+
 extern int vga_on;
 
 extern void    ibm8514_poll(void *priv, svga_t *svga);
@@ -316,6 +355,8 @@ extern int  svga_init(const device_t *info, svga_t *svga, void *priv, int memsiz
 extern void svga_recalctimings(svga_t *svga);
 extern void svga_close(svga_t *svga);
 
+extern uint32_t svga_conv_16to32(struct svga_t *svga, uint16_t color, uint8_t bpp);
+
 uint8_t  svga_read(uint32_t addr, void *priv);
 uint16_t svga_readw(uint32_t addr, void *priv);
 uint32_t svga_readl(uint32_t addr, void *priv);
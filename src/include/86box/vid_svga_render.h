@@ -33,11 +33,14 @@ extern int      cgablink;
 
 extern int scrollcache;
 
-extern uint8_t edatlookup[4][4];
-extern uint8_t egaremap2bpp[256];
+extern uint8_t  edatlookup[4][4];
+extern uint8_t  egaremap2bpp[256];
+extern uint64_t plane4lookup[4][256];
 
 extern void svga_recalc_remap_func(svga_t *svga);
 
+extern void svga_render_thread_drain(void);
+
 extern void svga_render_null(svga_t *svga);
 extern void svga_render_blank(svga_t *svga);
 extern void svga_render_overscan_left(svga_t *svga);
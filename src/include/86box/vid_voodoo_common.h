@@ -32,6 +32,9 @@
 
 #define TEX_CACHE_MAX   64
 
+/* Highest number of scanline-interleaved render threads supported. */
+#define VOODOO_RENDER_THREADS_MAX 8
+
 #ifdef __cplusplus
 #    include <atomic>
 using atomic_int = std::atomic<int>;
@@ -234,7 +237,7 @@ typedef struct texture_t {
     uint32_t   base;
     uint32_t   tLOD;
     atomic_int refcount;
-    atomic_int refcount_r[4];
+    atomic_int refcount_r[VOODOO_RENDER_THREADS_MAX];
     int        is16;
     uint32_t   palette_checksum;
     uint32_t   addr_start[4];
@@ -362,25 +365,25 @@ typedef struct voodoo_t {
     int    ncc_dirty[2];
 
     thread_t *fifo_thread;
-    thread_t *render_thread[4];
+    thread_t *render_thread[VOODOO_RENDER_THREADS_MAX];
     event_t  *wake_fifo_thread;
     event_t  *wake_main_thread;
     event_t  *fifo_not_full_event;
-    event_t  *render_not_full_event[4];
-    event_t  *wake_render_thread[4];
+    event_t  *render_not_full_event[VOODOO_RENDER_THREADS_MAX];
+    event_t  *wake_render_thread[VOODOO_RENDER_THREADS_MAX];
 
     int voodoo_busy;
-    int render_voodoo_busy[4];
+    int render_voodoo_busy[VOODOO_RENDER_THREADS_MAX];
 
     int render_threads;
     int odd_even_mask;
 
-    int pixel_count[4];
-    int texel_count[4];
+    int pixel_count[VOODOO_RENDER_THREADS_MAX];
+    int texel_count[VOODOO_RENDER_THREADS_MAX];
     int tri_count;
     int frame_count;
-    int pixel_count_old[4];
-    int texel_count_old[4];
+    int pixel_count_old[VOODOO_RENDER_THREADS_MAX];
+    int texel_count_old[VOODOO_RENDER_THREADS_MAX];
     int wr_count;
     int rd_count;
     int tex_count;
@@ -410,7 +413,7 @@ typedef struct voodoo_t {
     atomic_int   cmd_written_fifo;
 
     voodoo_params_t params_buffer[PARAM_SIZE];
-    atomic_int      params_read_idx[4];
+    atomic_int      params_read_idx[VOODOO_RENDER_THREADS_MAX];
     atomic_int      params_write_idx;
 
     uint32_t   cmdfifo_base;
@@ -650,7 +653,7 @@ typedef struct voodoo_t {
     int      palette_dirty[2];
 
     uint64_t time;
-    int      render_time[4];
+    int      render_time[VOODOO_RENDER_THREADS_MAX];
 
     int      force_blit_count;
     int      can_blit;
@@ -662,10 +665,11 @@ typedef struct voodoo_t {
     struct voodoo_set_t *set;
 
     uint8_t fifo_thread_run;
-    uint8_t render_thread_run[4];
+    uint8_t render_thread_run[VOODOO_RENDER_THREADS_MAX];
 
     uint8_t *vram;
     uint8_t *changedvram;
+    uint64_t *changedvram_sum;
 
     void   *priv;
     uint8_t monitor_index;
@@ -129,6 +129,10 @@ typedef struct monitor_t {
     int                      mon_cga_palette_static; /* Whether it should not be freed by the API. */
     const video_timings_t   *mon_vid_timings;
     int                      mon_vid_type;
+    double                   mon_host_refresh;     /* Refresh rate of the host display in Hz, 0 = unknown. */
+    int                      mon_frame_skip_limit; /* Max consecutive render-skipped frames, 0 = pacing off. */
+    int                      mon_frames_skipped;
+    uint64_t                 mon_last_present;
     struct blit_data_struct *mon_blit_data_ptr;
 } monitor_t;
 
@@ -209,6 +213,8 @@ extern int          herc_blend;
 extern int          vid_cga_contrast;
 extern int          video_grayscale;
 extern int          video_graytype;
+extern int          video_threaded_render;
+extern int          video_frame_pacing;
 
 extern double cpuclock;
 extern int    emu_fps;
@@ -253,6 +259,20 @@ extern void video_blit_memtoscreen_8(int x, int y, int w, int h);
 extern void video_blend_monitor(int x, int y, int monitor_index);
 extern void video_process_8_monitor(int x, int y, int monitor_index);
 extern void video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index);
+extern void video_blit_set_dirty_rect_monitor(int x, int y, int w, int h, int monitor_index);
+extern void video_host_refresh_rate_monitor(double hz, int monitor_index);
+extern int  video_frame_pace_monitor(int monitor_index);
+
+#define VIDEO_HASH_INIT 0x811c9dc5u
+extern uint32_t video_hash(uint32_t hash, const void *data, int len);
+extern void video_blit_take_dirty_rect_monitor(int *x, int *y, int *w, int *h, int monitor_index);
+
+/* CPU-side frame scaler (video_scaler.c), for renderers without GPU
+   scaling. Pitches are in pixels; bilinear selects the filter kernel. */
+extern void video_scaler_blit(uint32_t *dst, int dst_pitch, int dst_w, int dst_h,
+                              const uint32_t *src, int src_pitch, int src_x, int src_y,
+                              int src_w, int src_h, int bilinear);
+extern void video_scaler_close(void);
 extern void video_blit_complete_monitor(int monitor_index);
 extern void video_wait_for_blit_monitor(int monitor_index);
 extern void video_wait_for_buffer_monitor(int monitor_index);
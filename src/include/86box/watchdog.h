@@ -0,0 +1,54 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Definitions for the CPU thread hang watchdog.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#ifndef EMU_WATCHDOG_H
+#define EMU_WATCHDOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Ring of the most recently dispatched code block addresses, stored by
+   the dynarec dispatcher. Word-sized unlocked stores like the perfstats
+   counters: the watchdog thread reading a torn ring at worst misreads
+   entries of a dump that is advisory to begin with. */
+#define WATCHDOG_BLOCK_RING 64 /* must be a power of two */
+
+extern uint32_t watchdog_blocks[WATCHDOG_BLOCK_RING];
+extern uint32_t watchdog_block_idx;
+
+static __inline void
+watchdog_block(uint32_t pc)
+{
+    watchdog_blocks[watchdog_block_idx++ & (WATCHDOG_BLOCK_RING - 1)] = pc;
+}
+
+extern volatile uint32_t watchdog_heartbeat;
+
+/* Called at the end of every pc_run() slice. */
+static __inline void
+watchdog_slice(void)
+{
+    watchdog_heartbeat++;
+}
+
+extern void watchdog_start(int secs, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*EMU_WATCHDOG_H*/
@@ -38,6 +38,14 @@ enum {
     ZIP_BUS_USB      = 7
 };
 
+/* States of an asynchronous image mount. */
+enum {
+    ZIP_LOAD_IDLE = 0,
+    ZIP_LOAD_BUSY,
+    ZIP_LOAD_DONE,
+    ZIP_LOAD_FAIL
+};
+
 typedef struct zip_drive_t {
     uint8_t id;
 
@@ -118,6 +126,12 @@ typedef struct zip_t {
     uint32_t packet_len;
 
     double callback;
+
+    /* Asynchronous mount state; load_state is only ever written by one
+       side at a time (worker while BUSY, emulation thread otherwise). */
+    void *load_thread;
+    int   load_state;
+    char  load_path[1024];
 } zip_t;
 
 extern zip_t      *zip[ZIP_NUM];
@@ -143,6 +157,7 @@ extern void zip_hard_reset(void);
 
 extern void zip_reset(scsi_common_t *sc);
 extern int  zip_load(zip_t *dev, char *fn);
+extern void zip_load_async(zip_t *dev, char *fn);
 extern void zip_close(void);
 
 #ifdef __cplusplus
@@ -42,10 +42,20 @@ typedef struct _list_ {
     struct _list_ *next;
 } list_t;
 
+/* The handle given out as ini_t. The dirty flag is set whenever a value
+   actually changes, so ini_write() can skip rewriting an unchanged file. */
+typedef struct ini_head_t {
+    list_t list;
+
+    int dirty;
+} ini_head_t;
+
 typedef struct section_t {
     list_t list;
 
-    char name[128];
+    char        name[128];
+    uint32_t    hash;
+    ini_head_t *parent;
 
     list_t entry_head;
 } section_t;
@@ -53,11 +63,34 @@ typedef struct section_t {
 typedef struct entry_t {
     list_t list;
 
-    char    name[128];
-    char    data[512];
-    wchar_t wdata[512];
+    char     name[128];
+    uint32_t hash;
+    char     data[512];
+    wchar_t  wdata[512];
 } entry_t;
 
+/* FNV-1a; names are compared by hash first so lookups in the per-machine
+   sections of a large config do not strcmp every entry. */
+static uint32_t
+ini_hash(const char *name)
+{
+    uint32_t hash = 0x811c9dc5;
+
+    while (*name) {
+        hash ^= (uint8_t) *name++;
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+static void
+ini_mark_dirty(section_t *section)
+{
+    if ((section != NULL) && (section->parent != NULL))
+        section->parent->dirty = 1;
+}
+
 #define list_add(new, head)        \
     {                              \
         list_t *next = head;       \
@@ -105,12 +138,14 @@ find_section(list_t *head, const char *name)
 {
     section_t *sec     = (section_t *) head->next;
     const char blank[] = "";
+    uint32_t   hash;
 
     if (name == NULL)
         name = blank;
+    hash = ini_hash(name);
 
     while (sec != NULL) {
-        if (!strncmp(sec->name, name, sizeof(sec->name)))
+        if ((sec->hash == hash) && !strncmp(sec->name, name, sizeof(sec->name)))
             return sec;
 
         sec = (section_t *) sec->list.next;
@@ -138,17 +173,20 @@ ini_rename_section(ini_section_t section, const char *name)
 
     memset(sec->name, 0x00, sizeof(sec->name));
     memcpy(sec->name, name, MIN(128, strlen(name) + 1));
+    sec->hash = ini_hash(sec->name);
+    ini_mark_dirty(sec);
 }
 
 static entry_t *
 find_entry(section_t *section, const char *name)
 {
     entry_t *ent;
+    uint32_t hash = ini_hash(name);
 
     ent = (entry_t *) section->entry_head.next;
 
     while (ent != NULL) {
-        if (!strncmp(ent->name, name, sizeof(ent->name)))
+        if ((ent->hash == hash) && !strncmp(ent->name, name, sizeof(ent->name)))
             return ent;
 
         ent = (entry_t *) ent->list.next;
@@ -182,6 +220,7 @@ delete_section_if_empty(list_t *head, section_t *section)
         return;
 
     if (entries_num(section) == 0) {
+        ((ini_head_t *) head)->dirty = 1;
         list_delete(&section->list, head);
         free(section);
     }
@@ -203,6 +242,8 @@ create_section(list_t *head, const char *name)
 
     memset(ns, 0x00, sizeof(section_t));
     memcpy(ns->name, name, strlen(name) + 1);
+    ns->hash   = ini_hash(ns->name);
+    ns->parent = (ini_head_t *) head;
     list_add(&ns->list, head);
 
     return ns;
@@ -228,7 +269,9 @@ create_entry(section_t *section, const char *name)
 
     memset(ne, 0x00, sizeof(entry_t));
     memcpy(ne->name, name, strlen(name) + 1);
+    ne->hash = ini_hash(ne->name);
     list_add(&ne->list, &section->entry_head);
+    ini_mark_dirty(section);
 
     return ne;
 }
@@ -335,11 +378,12 @@ ini_read(const char *fn)
     if (fp == NULL)
         return NULL;
 
-    head = malloc(sizeof(list_t));
-    memset(head, 0x00, sizeof(list_t));
+    head = malloc(sizeof(ini_head_t));
+    memset(head, 0x00, sizeof(ini_head_t));
 
     sec = malloc(sizeof(section_t));
     memset(sec, 0x00, sizeof(section_t));
+    sec->parent = (ini_head_t *) head;
 
     list_add(&sec->list, head);
     if (bom)
@@ -391,6 +435,8 @@ ini_read(const char *fn)
             ns = malloc(sizeof(section_t));
             memset(ns, 0x00, sizeof(section_t));
             memcpy(ns->name, sname, 128);
+            ns->hash   = ini_hash(ns->name);
+            ns->parent = (ini_head_t *) head;
             list_add(&ns->list, head);
 
             /* New section is now the current one. */
@@ -423,6 +469,7 @@ ini_read(const char *fn)
         ne = malloc(sizeof(entry_t));
         memset(ne, 0x00, sizeof(entry_t));
         memcpy(ne->name, ename, 128);
+        ne->hash = ini_hash(ne->name);
         wcsncpy(ne->wdata, &buff[d], sizeof_w(ne->wdata) - 1);
         ne->wdata[sizeof_w(ne->wdata) - 1] = L'\0';
 #ifdef _WIN32 /* Make sure the string is converted to UTF-8 rather than a legacy codepage */
@@ -454,6 +501,11 @@ ini_write(ini_t ini, const char *fn)
     if (list == NULL)
         return;
 
+    /* Nothing changed since the file was read or last written - skip the
+       rewrite, which stalls the UI on slow storage. */
+    if (!((ini_head_t *) ini)->dirty)
+        return;
+
     sec = (section_t *) list->next;
 
 #if defined(ANSI_CFG) || !defined(_WIN32)
@@ -494,13 +546,15 @@ ini_write(ini_t ini, const char *fn)
     }
 
     (void) fclose(fp);
+
+    ((ini_head_t *) ini)->dirty = 0;
 }
 
 ini_t
 ini_new(void)
 {
-    ini_t ini = malloc(sizeof(list_t));
-    memset(ini, 0, sizeof(list_t));
+    ini_t ini = malloc(sizeof(ini_head_t));
+    memset(ini, 0, sizeof(ini_head_t));
     return ini;
 }
 
@@ -538,6 +592,7 @@ ini_section_delete_var(ini_section_t self, const char *name)
     if (entry != NULL) {
         list_delete(&entry->list, &section->entry_head);
         free(entry);
+        ini_mark_dirty(section);
     }
 }
 
@@ -719,12 +774,19 @@ ini_section_set_int(ini_section_t self, const char *name, int val)
     if (section == NULL)
         return;
 
+    char temp[512];
+
     ent = find_entry(section, name);
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%i", val);
+    sprintf(temp, "%i", val);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, 512);
+    ini_mark_dirty(section);
 }
 
 void
@@ -736,12 +798,19 @@ ini_section_set_uint(ini_section_t self, const char *name, uint32_t val)
     if (section == NULL)
         return;
 
+    char temp[512];
+
     ent = find_entry(section, name);
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%i", val);
+    sprintf(temp, "%i", val);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, 512);
+    ini_mark_dirty(section);
 }
 
 #if 0
@@ -768,6 +837,7 @@ ini_section_set_double(ini_section_t self, const char *name, double val)
 {
     section_t *section = (section_t *) self;
     entry_t   *ent;
+    char       temp[512];
 
     if (section == NULL)
         return;
@@ -776,8 +846,13 @@ ini_section_set_double(ini_section_t self, const char *name, double val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%lg", val);
+    sprintf(temp, "%lg", val);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, 512);
+    ini_mark_dirty(section);
 }
 
 void
@@ -785,6 +860,7 @@ ini_section_set_hex16(ini_section_t self, const char *name, int val)
 {
     section_t *section = (section_t *) self;
     entry_t   *ent;
+    char       temp[512];
 
     if (section == NULL)
         return;
@@ -793,8 +869,13 @@ ini_section_set_hex16(ini_section_t self, const char *name, int val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%04X", val);
+    sprintf(temp, "%04X", val);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, sizeof_w(ent->wdata));
+    ini_mark_dirty(section);
 }
 
 void
@@ -802,6 +883,7 @@ ini_section_set_hex20(ini_section_t self, const char *name, int val)
 {
     section_t *section = (section_t *) self;
     entry_t   *ent;
+    char       temp[512];
 
     if (section == NULL)
         return;
@@ -810,8 +892,13 @@ ini_section_set_hex20(ini_section_t self, const char *name, int val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%05X", val);
+    sprintf(temp, "%05X", val);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, sizeof_w(ent->wdata));
+    ini_mark_dirty(section);
 }
 
 void
@@ -819,6 +906,7 @@ ini_section_set_mac(ini_section_t self, const char *name, int val)
 {
     section_t *section = (section_t *) self;
     entry_t   *ent;
+    char       temp[512];
 
     if (section == NULL)
         return;
@@ -827,9 +915,14 @@ ini_section_set_mac(ini_section_t self, const char *name, int val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
-    sprintf(ent->data, "%02x:%02x:%02x",
+    sprintf(temp, "%02x:%02x:%02x",
             (val >> 16) & 0xff, (val >> 8) & 0xff, val & 0xff);
+    if (!strcmp(ent->data, temp))
+        return;
+
+    strcpy(ent->data, temp);
     mbstowcs(ent->wdata, ent->data, 512);
+    ini_mark_dirty(section);
 }
 
 void
@@ -845,10 +938,14 @@ ini_section_set_string(ini_section_t self, const char *name, const char *val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
+    if (!strncmp(ent->data, val, sizeof(ent->data) - 1))
+        return;
+
     if ((strlen(val) + 1) <= sizeof(ent->data))
         memcpy(ent->data, val, strlen(val) + 1);
     else
         memcpy(ent->data, val, sizeof(ent->data));
+    ini_mark_dirty(section);
 #ifdef _WIN32 /* Make sure the string is converted from UTF-8 rather than a legacy codepage */
     mbstoc16s(ent->wdata, ent->data, sizeof_w(ent->wdata));
 #else
@@ -869,7 +966,11 @@ ini_section_set_wstring(ini_section_t self, const char *name, wchar_t *val)
     if (ent == NULL)
         ent = create_entry(section, name);
 
+    if (!wcsncmp(ent->wdata, val, sizeof_w(ent->wdata) - 1))
+        return;
+
     memcpy(ent->wdata, val, sizeof_w(ent->wdata));
+    ini_mark_dirty(section);
 #ifdef _WIN32 /* Make sure the string is converted to UTF-8 rather than a legacy codepage */
     c16stombs(ent->data, ent->wdata, sizeof(ent->data));
 #else
@@ -59,6 +59,21 @@ int   initialized = 0;
 io_t *io[NPORTS];
 io_t *io_last[NPORTS];
 
+/* Flattened byte-access dispatch: when exactly one handler on a port
+   provides inb (or outb), the hot inb/outb paths call it directly instead
+   of walking the handler list. A NULL entry means no handler or stacked
+   handlers, and the composing list walk runs instead. Word and dword
+   accesses keep the list walk, as they also have to merge neighbouring
+   byte handlers. */
+typedef struct io_fast_t {
+    uint8_t (*inb)(uint16_t addr, void *priv);
+    void (*outb)(uint16_t addr, uint8_t val, void *priv);
+    void *inb_priv;
+    void *outb_priv;
+} io_fast_t;
+
+static io_fast_t io_fast[NPORTS];
+
 #ifdef ENABLE_IO_LOG
 int io_do_log = ENABLE_IO_LOG;
 
@@ -77,6 +92,34 @@ io_log(const char *fmt, ...)
 #    define io_log(fmt, ...)
 #endif
 
+/* Rebuild the flattened dispatch entry for one port from its handler list. */
+static void
+io_fast_recalc(uint16_t port)
+{
+    io_fast_t  *fast   = &io_fast[port];
+    const io_t *p;
+    int         inb_n  = 0;
+    int         outb_n = 0;
+
+    for (p = io[port]; p; p = p->next) {
+        if (p->inb) {
+            fast->inb      = p->inb;
+            fast->inb_priv = p->priv;
+            inb_n++;
+        }
+        if (p->outb) {
+            fast->outb      = p->outb;
+            fast->outb_priv = p->priv;
+            outb_n++;
+        }
+    }
+
+    if (inb_n != 1)
+        fast->inb = NULL;
+    if (outb_n != 1)
+        fast->outb = NULL;
+}
+
 void
 io_init(void)
 {
@@ -106,6 +149,8 @@ io_init(void)
         /* io[c] should be NULL. */
         io[c] = io_last[c] = NULL;
     }
+
+    memset(io_fast, 0, sizeof(io_fast));
 }
 
 void
@@ -145,6 +190,8 @@ io_sethandler_common(uint16_t base, int size,
         q->next = NULL;
 
         io_last[base + c] = q;
+
+        io_fast_recalc(base + c);
     }
 }
 
@@ -182,6 +229,8 @@ io_removehandler_common(uint16_t base, int size,
             }
             p = q;
         }
+
+        io_fast_recalc(base + c);
     }
 }
 
@@ -301,6 +350,13 @@ inb(uint16_t port)
         found = 1;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].inb) {
+        /* Exactly one handler - call it without walking the list. */
+        ret = io_fast[port].inb(port, io_fast[port].inb_priv);
+        found = 1;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
@@ -361,6 +417,13 @@ outb(uint16_t port, uint8_t val)
         found = 1;
 #ifdef ENABLE_IO_LOG
         qfound = 1;
+#endif
+    } else if (io_fast[port].outb) {
+        /* Exactly one handler - call it without walking the list. */
+        io_fast[port].outb(port, val, io_fast[port].outb_priv);
+        found = 1;
+#ifdef ENABLE_IO_LOG
+        qfound = 1;
 #endif
     } else {
         p = io[port];
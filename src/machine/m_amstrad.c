@@ -2104,6 +2104,7 @@ kbd_write(uint16_t port, uint8_t val, void *priv)
             if (speaker_enable)
                 was_speaker_enable = 1;
             pit_devs[0].set_gate(pit_devs[0].data, 2, val & 0x01);
+            speaker_update();
 
             if (val & 0x80) {
                 /* Keyboard enabled, so enable PA reading. */
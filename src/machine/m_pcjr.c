@@ -624,6 +624,7 @@ kbd_write(uint16_t port, uint8_t val, void *priv)
             if (speaker_enable)
                 was_speaker_enable = 1;
             pit_devs[0].set_gate(pit_devs[0].data, 2, val & 1);
+            speaker_update();
             sn76489_mute = speaker_mute = 1;
             switch (val & 0x60) {
                 case 0x00:
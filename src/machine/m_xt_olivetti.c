@@ -630,6 +630,7 @@ m24_kbd_write(uint16_t port, uint8_t val, void *priv)
             if (speaker_enable)
                 was_speaker_enable = 1;
             pit_devs[0].set_gate(pit_devs[0].data, 2, val & 1);
+            speaker_update();
             break;
 
         case 0x64:
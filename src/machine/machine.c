@@ -17,7 +17,9 @@
  *          Copyright 2017-2020 Fred N. van Kempen.
  */
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <wchar.h>
@@ -40,6 +42,7 @@
 #include <86box/machine.h>
 #include <86box/isamem.h>
 #include <86box/pci.h>
+#include <86box/thread.h>
 #include <86box/plat_unused.h>
 
 int bios_only = 0;
@@ -136,13 +139,26 @@ machine_init(void)
     (void) machine_init_ex(machine);
 }
 
-int
-machine_available(int m)
+/* Probing a machine's ROMs opens every BIOS image, which is expensive on
+   network-mounted ROM sets - and the settings dialog re-filters the full
+   table on every machine type change. Remember each probe result until
+   the next flush; the dialog flushes once when it opens, so ROMs added
+   on disk are still picked up. */
+static int8_t *machine_avail_cache = NULL;
+
+void
+machine_available_flush(void)
 {
-    int             ret;
-    const device_t *dev = machine_get_device(m);
+    if (machine_avail_cache != NULL)
+        memset(machine_avail_cache, -1, machine_count());
+}
 
-    bios_only = 1;
+/* The BIOS-only probe itself; the caller must have set bios_only. */
+static int
+machine_probe(int m)
+{
+    const device_t *dev = machine_get_device(m);
+    int             ret;
 
     ret = device_available(dev);
     /* Do not check via machine_init_ex() if the device is not NULL and
@@ -150,9 +166,71 @@ machine_available(int m)
     if ((dev == NULL) || (ret != -1))
         ret = machine_init_ex(m);
 
+    return !!ret;
+}
+
+static void
+machine_avail_cache_alloc(void)
+{
+    if (machine_avail_cache == NULL) {
+        machine_avail_cache = (int8_t *) malloc(machine_count());
+        memset(machine_avail_cache, -1, machine_count());
+    }
+}
+
+int
+machine_available(int m)
+{
+    machine_avail_cache_alloc();
+
+    if (machine_avail_cache[m] >= 0)
+        return machine_avail_cache[m];
+
+    bios_only = 1;
+    machine_avail_cache[m] = machine_probe(m);
     bios_only = 0;
 
-    return !!ret;
+    return machine_avail_cache[m];
+}
+
+/* The cold-start ROM scan probes every machine in the table, and nearly
+   all of the cost is opening BIOS images; the probes are independent, so
+   spread them over a few threads. bios_only is set once around the whole
+   scan (not per probe, or one worker finishing would flip it under
+   another mid-probe); in BIOS-only mode the probes read no emulator
+   state, and the ROM cache they share is locked in rom.c. */
+#define MACHINE_SCAN_THREADS 4
+
+static atomic_int machine_scan_next;
+
+static void
+machine_scan_thread(UNUSED(void *priv))
+{
+    const int count = machine_count();
+    int       m;
+
+    while ((m = atomic_fetch_add(&machine_scan_next, 1)) < count) {
+        if (machine_avail_cache[m] < 0)
+            machine_avail_cache[m] = machine_probe(m);
+    }
+}
+
+void
+machine_available_scan_all(void)
+{
+    thread_t *threads[MACHINE_SCAN_THREADS];
+
+    machine_avail_cache_alloc();
+
+    bios_only = 1;
+    atomic_store(&machine_scan_next, 0);
+
+    for (int c = 0; c < MACHINE_SCAN_THREADS; c++)
+        threads[c] = thread_create_named(machine_scan_thread, NULL, "Machine ROM scan");
+    for (int c = 0; c < MACHINE_SCAN_THREADS; c++)
+        thread_wait(threads[c]);
+
+    bios_only = 0;
 }
 
 void
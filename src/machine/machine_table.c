@@ -21,6 +21,7 @@
  */
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <wchar.h>
 #include <86box/86box.h>
@@ -14059,18 +14060,43 @@ machine_get_type(int m)
     return (machines[m].type);
 }
 
+/* Index of the machine table sorted by internal name, built once on
+   first lookup so config load and the settings dialog do not scan the
+   full table linearly for every name. */
+static int *machine_name_index     = NULL;
+static int  machine_name_index_len = 0;
+
+static int
+machine_name_index_compare(const void *a, const void *b)
+{
+    return strcmp(machines[*(const int *) a].internal_name,
+                  machines[*(const int *) b].internal_name);
+}
+
+static int
+machine_name_index_search(const void *key, const void *elem)
+{
+    return strcmp((const char *) key, machines[*(const int *) elem].internal_name);
+}
+
 int
 machine_get_machine_from_internal_name(const char *s)
 {
-    int c = 0;
-
-    while (machines[c].init != NULL) {
-        if (!strcmp(machines[c].internal_name, s))
-            return c;
-        c++;
+    const int *found;
+
+    if (machine_name_index == NULL) {
+        machine_name_index_len = machine_count();
+        machine_name_index     = (int *) malloc(machine_name_index_len * sizeof(int));
+        for (int c = 0; c < machine_name_index_len; c++)
+            machine_name_index[c] = c;
+        qsort(machine_name_index, machine_name_index_len, sizeof(int),
+              machine_name_index_compare);
     }
 
-    return 0;
+    found = (const int *) bsearch(s, machine_name_index, machine_name_index_len,
+                                  sizeof(int), machine_name_index_search);
+
+    return (found != NULL) ? *found : 0;
 }
 
 int
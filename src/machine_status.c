@@ -25,6 +25,20 @@
 
 machine_status_t machine_status;
 
+static atomic_uint status_changes;
+
+void
+machine_status_mark(void)
+{
+    atomic_fetch_add(&status_changes, 1);
+}
+
+uint32_t
+machine_status_changes(void)
+{
+    return atomic_load(&status_changes);
+}
+
 void
 machine_status_init(void)
 {
@@ -55,4 +69,7 @@ machine_status_init(void)
         machine_status.net[i].active = false;
         machine_status.net[i].empty  = !network_is_connected(i);
     }
+
+    /* Make the UI pick up the initial state. */
+    machine_status_mark();
 }
\ No newline at end of file
@@ -56,7 +56,7 @@ enum {
 
 typedef struct flash_t {
     uint8_t command;
-    uint8_t pad;
+    uint8_t dirty;
     uint8_t pad0;
     uint8_t pad1;
     uint8_t *array;
@@ -132,12 +132,15 @@ flash_write(uint32_t addr, uint8_t val, void *priv)
 
     switch (dev->command) {
         case CMD_ERASE:
-            if (val == CMD_ERASE_CONFIRM)
+            if (val == CMD_ERASE_CONFIRM) {
                 memset(dev->array, 0xff, biosmask + 1);
+                dev->dirty = 1;
+            }
             break;
 
         case CMD_PROGRAM:
             dev->array[addr] = val;
+            dev->dirty       = 1;
             break;
 
         default:
@@ -211,7 +214,8 @@ catalyst_flash_init(UNUSED(const device_t *info))
     if (fp) {
         (void) !fread(dev->array, 0x20000, 1, fp);
         fclose(fp);
-    }
+    } else
+        dev->dirty = 1; /* It is by definition dirty on creation. */
 
     return dev;
 }
@@ -222,9 +226,13 @@ catalyst_flash_close(void *priv)
     FILE    *fp;
     flash_t *dev = (flash_t *) priv;
 
-    fp = nvr_fopen(flash_path, "wb");
-    fwrite(dev->array, 0x20000, 1, fp);
-    fclose(fp);
+    /* Only touch the backing file if the array was actually programmed
+       or erased this session. */
+    if (dev->dirty) {
+        fp = nvr_fopen(flash_path, "wb");
+        fwrite(dev->array, 0x20000, 1, fp);
+        fclose(fp);
+    }
 
     free(dev->array);
     dev->array = NULL;
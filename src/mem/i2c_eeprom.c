@@ -150,6 +150,9 @@ i2c_eeprom_init(void *i2c, uint8_t addr, uint8_t *data, uint32_t size, uint8_t w
 
     uint8_t i2c_mask = dev->addr_mask >> dev->addr_len;
     i2c_sethandler(dev->i2c, dev->addr & ~i2c_mask, i2c_mask + 1, i2c_eeprom_start, i2c_eeprom_read, i2c_eeprom_write, i2c_eeprom_stop, dev);
+    /* Plain memory with no timing of its own; let host controllers
+       complete transactions to it without a response timer. */
+    i2c_set_fast(dev->i2c, dev->addr & ~i2c_mask, i2c_mask + 1, 1);
 
     return dev;
 }
@@ -163,6 +166,7 @@ i2c_eeprom_close(void *dev_handle)
 
     uint8_t i2c_mask = dev->addr_mask >> dev->addr_len;
     i2c_removehandler(dev->i2c, dev->addr & ~i2c_mask, i2c_mask + 1, i2c_eeprom_start, i2c_eeprom_read, i2c_eeprom_write, i2c_eeprom_stop, dev);
+    i2c_set_fast(dev->i2c, dev->addr & ~i2c_mask, i2c_mask + 1, 0);
 
     free(dev);
 }
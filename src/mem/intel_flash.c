@@ -60,13 +60,14 @@ enum {
 typedef struct flash_t {
     uint8_t  command;
     uint8_t  status;
-    uint8_t  pad;
+    uint8_t  dirty;
     uint8_t  flags;
     uint8_t *array;
 
     uint16_t flash_id;
     uint16_t pad16;
 
+    uint32_t bb_mask;
     uint32_t program_addr;
     uint32_t block_start[BLOCKS_NUM];
     uint32_t block_end[BLOCKS_NUM];
@@ -166,11 +167,6 @@ static void
 flash_write(uint32_t addr, uint8_t val, void *priv)
 {
     flash_t *dev = (flash_t *) priv;
-    uint32_t bb_mask = biosmask & 0xffffe000;
-    if (biosmask == 0x7ffff)
-        bb_mask &= 0xffff8000;
-    else if (biosmask == 0x3ffff)
-        bb_mask &= 0xffffc000;
 
     if (dev->flags & FLAG_INV_A16)
         addr ^= 0x10000;
@@ -180,8 +176,10 @@ flash_write(uint32_t addr, uint8_t val, void *priv)
         case CMD_ERASE_SETUP:
             if (val == CMD_ERASE_CONFIRM) {
                 for (uint8_t i = 0; i < 6; i++) {
-                    if ((i == dev->program_addr) && (addr >= dev->block_start[i]) && (addr <= dev->block_end[i]))
+                    if ((i == dev->program_addr) && (addr >= dev->block_start[i]) && (addr <= dev->block_end[i])) {
                         memset(&(dev->array[dev->block_start[i]]), 0xff, dev->block_len[i]);
+                        dev->dirty = 1;
+                    }
                 }
 
                 dev->status = 0x80;
@@ -191,8 +189,10 @@ flash_write(uint32_t addr, uint8_t val, void *priv)
 
         case CMD_PROGRAM_SETUP:
         case CMD_PROGRAM_SETUP_ALT:
-            if (((addr & bb_mask) != (dev->block_start[6] & bb_mask)) && (addr == dev->program_addr))
+            if (((addr & dev->bb_mask) != (dev->block_start[6] & dev->bb_mask)) && (addr == dev->program_addr)) {
                 dev->array[addr] = val;
+                dev->dirty       = 1;
+            }
             dev->command = CMD_READ_STATUS;
             dev->status  = 0x80;
             break;
@@ -224,11 +224,6 @@ static void
 flash_writew(uint32_t addr, uint16_t val, void *priv)
 {
     flash_t *dev = (flash_t *) priv;
-    uint32_t bb_mask = biosmask & 0xffffe000;
-    if (biosmask == 0x7ffff)
-        bb_mask &= 0xffff8000;
-    else if (biosmask == 0x3ffff)
-        bb_mask &= 0xffffc000;
 
     if (dev->flags & FLAG_INV_A16)
         addr ^= 0x10000;
@@ -239,8 +234,10 @@ flash_writew(uint32_t addr, uint16_t val, void *priv)
             case CMD_ERASE_SETUP:
                 if (val == CMD_ERASE_CONFIRM) {
                     for (uint8_t i = 0; i < 6; i++) {
-                        if ((i == dev->program_addr) && (addr >= dev->block_start[i]) && (addr <= dev->block_end[i]))
+                        if ((i == dev->program_addr) && (addr >= dev->block_start[i]) && (addr <= dev->block_end[i])) {
                             memset(&(dev->array[dev->block_start[i]]), 0xff, dev->block_len[i]);
+                            dev->dirty = 1;
+                        }
                     }
 
                     dev->status = 0x80;
@@ -250,8 +247,10 @@ flash_writew(uint32_t addr, uint16_t val, void *priv)
 
             case CMD_PROGRAM_SETUP:
             case CMD_PROGRAM_SETUP_ALT:
-                if (((addr & bb_mask) != (dev->block_start[6] & bb_mask)) && (addr == dev->program_addr))
+                if (((addr & dev->bb_mask) != (dev->block_start[6] & dev->bb_mask)) && (addr == dev->program_addr)) {
                     *(uint16_t *) (&dev->array[addr]) = val;
+                    dev->dirty                        = 1;
+                }
                 dev->command = CMD_READ_STATUS;
                 dev->status  = 0x80;
                 break;
@@ -358,6 +357,14 @@ intel_flash_init(const device_t *info)
 
     dev->flags = info->local & 0xff;
 
+    /* The boot block mask only depends on the array size, so compute it
+       once instead of on every command cycle. */
+    dev->bb_mask = biosmask & 0xffffe000;
+    if (biosmask == 0x7ffff)
+        dev->bb_mask &= 0xffff8000;
+    else if (biosmask == 0x3ffff)
+        dev->bb_mask &= 0xffffc000;
+
     mem_mapping_disable(&bios_mapping);
     mem_mapping_disable(&bios_high_mapping);
 
@@ -525,7 +532,8 @@ intel_flash_init(const device_t *info)
         (void) !fread(&(dev->array[dev->block_start[BLOCK_DATA1]]), dev->block_len[BLOCK_DATA1], 1, fp);
         (void) !fread(&(dev->array[dev->block_start[BLOCK_DATA2]]), dev->block_len[BLOCK_DATA2], 1, fp);
         fclose(fp);
-    }
+    } else
+        dev->dirty = 1; /* It is by definition dirty on creation. */
 
     return dev;
 }
@@ -536,18 +544,22 @@ intel_flash_close(void *priv)
     FILE    *fp;
     flash_t *dev = (flash_t *) priv;
 
-    fp = nvr_fopen(flash_path, "wb");
-    fwrite(&(dev->array[dev->block_start[BLOCK_MAIN1]]), dev->block_len[BLOCK_MAIN1], 1, fp);
-    if (dev->block_len[BLOCK_MAIN2])
-        fwrite(&(dev->array[dev->block_start[BLOCK_MAIN2]]), dev->block_len[BLOCK_MAIN2], 1, fp);
-    if (dev->block_len[BLOCK_MAIN3])
-        fwrite(&(dev->array[dev->block_start[BLOCK_MAIN3]]), dev->block_len[BLOCK_MAIN3], 1, fp);
-    if (dev->block_len[BLOCK_MAIN4])
-        fwrite(&(dev->array[dev->block_start[BLOCK_MAIN4]]), dev->block_len[BLOCK_MAIN4], 1, fp);
-
-    fwrite(&(dev->array[dev->block_start[BLOCK_DATA1]]), dev->block_len[BLOCK_DATA1], 1, fp);
-    fwrite(&(dev->array[dev->block_start[BLOCK_DATA2]]), dev->block_len[BLOCK_DATA2], 1, fp);
-    fclose(fp);
+    /* Only touch the backing file if the array was actually programmed
+       or erased this session. */
+    if (dev->dirty) {
+        fp = nvr_fopen(flash_path, "wb");
+        fwrite(&(dev->array[dev->block_start[BLOCK_MAIN1]]), dev->block_len[BLOCK_MAIN1], 1, fp);
+        if (dev->block_len[BLOCK_MAIN2])
+            fwrite(&(dev->array[dev->block_start[BLOCK_MAIN2]]), dev->block_len[BLOCK_MAIN2], 1, fp);
+        if (dev->block_len[BLOCK_MAIN3])
+            fwrite(&(dev->array[dev->block_start[BLOCK_MAIN3]]), dev->block_len[BLOCK_MAIN3], 1, fp);
+        if (dev->block_len[BLOCK_MAIN4])
+            fwrite(&(dev->array[dev->block_start[BLOCK_MAIN4]]), dev->block_len[BLOCK_MAIN4], 1, fp);
+
+        fwrite(&(dev->array[dev->block_start[BLOCK_DATA1]]), dev->block_len[BLOCK_DATA1], 1, fp);
+        fwrite(&(dev->array[dev->block_start[BLOCK_DATA2]]), dev->block_len[BLOCK_DATA2], 1, fp);
+        fclose(fp);
+    }
 
     free(dev->array);
     dev->array = NULL;
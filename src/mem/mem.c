@@ -35,9 +35,12 @@
 #include <86box/config.h>
 #include <86box/io.h>
 #include <86box/mem.h>
+#include <86box/mem_snapshot.h>
+#include <86box/perfstats.h>
 #include <86box/plat.h>
 #include <86box/rom.h>
 #include <86box/gdbstub.h>
+#include <86box/memtrace.h>
 #ifdef USE_DYNAREC
 #    include "codegen_public.h"
 #else
@@ -83,6 +86,10 @@ uint32_t biosaddr;
 uint32_t pccache;
 uint8_t *pccache2;
 
+/* Second-level fetch cache consulted by the fetch paths in 386_common.h
+   when the single-entry pccache misses. */
+pccache_line_t pccache_l2[PCCACHE_L2_NR];
+
 int        readlnext;
 int        readlookup[256];
 uintptr_t *readlookup2;
@@ -92,8 +99,37 @@ int        writelnext;
 int        writelookup[256];
 uintptr_t *writelookup2;
 
+/* Physical page cached in each lookup ring slot, so a mapping change can
+   evict just the translations it actually affects (flushmmucache_range). */
+static uint32_t readlookup_phys[256];
+static uint32_t writelookup_phys[256];
+
+/* Write-combining lookups (addwritelookup_wc): ring slots whose host
+   pointer targets a device-owned backing store (e.g. a linear framebuffer)
+   rather than system RAM. The owner's tag lets mem_wc_sweep() revisit only
+   its own pages at frame boundaries, and mem_wc_live avoids touching the
+   ring at all while no such lookup exists. */
+static uint8_t writelookup_wc[256];
+static void   *writelookup_wc_tag[256];
+static int     mem_wc_live = 0;
+
+mutlb_t mutlb_read  = { .page = { MUTLB_INV, MUTLB_INV, MUTLB_INV, MUTLB_INV } };
+mutlb_t mutlb_write = { .page = { MUTLB_INV, MUTLB_INV, MUTLB_INV, MUTLB_INV } };
+
 uint32_t mem_logical_addr;
 
+/* Bumped on every mapping recalc so that cached physical pointers can be
+   revalidated cheaply. Starts at 1 so a zeroed cache is always stale. */
+uint32_t mem_mapping_generation = 1;
+
+/* Physical pages holding cached segment descriptors (see the descriptor
+   cache in x86seg.c). Writes to a watched page must take the page_t handler
+   path, where mem_desc_watch_check() bumps the generation below; the bit is
+   dropped again on the first such write. Starts at 1 so a zeroed descriptor
+   cache entry is always stale. */
+static uint64_t mem_desc_watch_pages[(1 << 20) >> 6];
+uint32_t        mem_desc_watch_gen = 1;
+
 int shadowbios = 0;
 int shadowbios_write;
 int readlnum  = 0;
@@ -132,6 +168,24 @@ static mem_mapping_t *last_mapping;
 static mem_mapping_t *read_mapping_bus[MEM_MAPPINGS_NO];
 static mem_mapping_t *write_mapping_bus[MEM_MAPPINGS_NO];
 static uint8_t       *_mem_exec[MEM_MAPPINGS_NO];
+
+/* Flattened per-page dispatch rebuilt by mem_mapping_recalc(): the final
+   handler and private pointer for each access size, so the hot CPU paths pay
+   a single indirect call instead of chasing the mapping pointer first. A NULL
+   handler means the access has to be composed from smaller sizes or hits a
+   hole in the map. */
+typedef struct mem_dispatch_t {
+    uint8_t (*read_b)(uint32_t addr, void *priv);
+    uint16_t (*read_w)(uint32_t addr, void *priv);
+    uint32_t (*read_l)(uint32_t addr, void *priv);
+    void *read_priv;
+    void (*write_b)(uint32_t addr, uint8_t val, void *priv);
+    void (*write_w)(uint32_t addr, uint16_t val, void *priv);
+    void (*write_l)(uint32_t addr, uint32_t val, void *priv);
+    void *write_priv;
+} mem_dispatch_t;
+
+static mem_dispatch_t mem_dispatch[MEM_MAPPINGS_NO];
 static uint8_t        ff_pccache[4] = { 0xff, 0xff, 0xff, 0xff };
 static mem_state_t    _mem_state[MEM_MAPPINGS_NO];
 static uint32_t       remap_start_addr;
@@ -170,6 +224,27 @@ mem_addr_is_ram(uint32_t addr)
            (mapping == &ram_mid_mapping2) || (mapping == &ram_remapped_mapping);
 }
 
+void
+mem_mutlb_flush_read(void)
+{
+    for (uint8_t c = 0; c < MUTLB_NR; c++)
+        mutlb_read.page[c] = MUTLB_INV;
+}
+
+void
+mem_mutlb_flush_write(void)
+{
+    for (uint8_t c = 0; c < MUTLB_NR; c++)
+        mutlb_write.page[c] = MUTLB_INV;
+}
+
+void
+pccache_l2_flush(void)
+{
+    for (uint8_t c = 0; c < PCCACHE_L2_NR; c++)
+        pccache_l2[c].page = 0xffffffff;
+}
+
 void
 resetreadlookup(void)
 {
@@ -189,15 +264,32 @@ resetreadlookup(void)
     memset(writelookup2, 0xff, (1 << 20) * sizeof(uintptr_t));
     memset(writelookupp, 0x04, (1 << 20) * sizeof(uint8_t));
 
+    mem_mutlb_flush_read();
+    mem_mutlb_flush_write();
+
     readlnext  = 0;
     writelnext = 0;
     pccache    = 0xffffffff;
+    pccache_l2_flush();
     high_page  = 0;
 }
 
+/* Shadow recalc transaction state (see mem_recalc_begin()). While the depth
+   is non-zero, mem_mapping_recalc() only widens the pending range and the
+   full-cache flushes just latch a flag; mem_recalc_commit() then does one
+   recalc and at most one flush for the whole batch. */
+static int      recalc_trans_depth = 0;
+static int      recalc_trans_flush = 0; /* 1 = nopc flush pending, 2 = full flush pending */
+static uint64_t recalc_trans_lo;
+static uint64_t recalc_trans_hi;
+
 void
 flushmmucache(void)
 {
+    if (recalc_trans_depth) {
+        recalc_trans_flush = 2;
+        return;
+    }
     for (uint16_t c = 0; c < 256; c++) {
         if (readlookup[c] != (int) 0xffffffff) {
             readlookup2[readlookup[c]] = LOOKUP_INV;
@@ -212,10 +304,16 @@ flushmmucache(void)
             writelookup[c]               = 0xffffffff;
         }
     }
+    mem_mutlb_flush_read();
+    mem_mutlb_flush_write();
     mmuflush++;
+    /* Linear-to-physical mappings may have changed under the descriptor
+       tables, so cached descriptors cannot be trusted either. */
+    mem_desc_watch_gen++;
 
     pccache  = (uint32_t) 0xffffffff;
     pccache2 = (uint8_t *) 0xffffffff;
+    pccache_l2_flush();
 
 #ifdef USE_DYNAREC
     codegen_flush();
@@ -225,6 +323,11 @@ flushmmucache(void)
 void
 flushmmucache_nopc(void)
 {
+    if (recalc_trans_depth) {
+        if (recalc_trans_flush < 1)
+            recalc_trans_flush = 1;
+        return;
+    }
     for (uint16_t c = 0; c < 256; c++) {
         if (readlookup[c] != (int) 0xffffffff) {
             readlookup2[readlookup[c]] = LOOKUP_INV;
@@ -239,6 +342,48 @@ flushmmucache_nopc(void)
             writelookup[c]               = 0xffffffff;
         }
     }
+    mem_mutlb_flush_read();
+    mem_mutlb_flush_write();
+    mem_desc_watch_gen++;
+
+    /* The "nopc" exemption only extends to the single-entry pccache: the
+       currently executing page keeps its pointer, but cached translations
+       for other pages must go. */
+    pccache_l2_flush();
+}
+
+/* Evict only the cached translations whose physical page falls inside the
+   given range - a mapping change (shadow RAM, SMRAM, a BAR move) only
+   affects the pages it covers, so the rest of the lookup cache stays warm. */
+void
+flushmmucache_range(uint64_t base, uint64_t size)
+{
+    uint64_t first         = base >> 12;
+    uint64_t last          = (base + size - 1) >> 12;
+    int      flushed_read  = 0;
+    int      flushed_write = 0;
+
+    for (uint16_t c = 0; c < 256; c++) {
+        if ((readlookup[c] != (int) 0xffffffff) && (readlookup_phys[c] >= first) && (readlookup_phys[c] <= last)) {
+            readlookup2[readlookup[c]] = LOOKUP_INV;
+            readlookupp[readlookup[c]] = 4;
+            readlookup[c]              = 0xffffffff;
+            flushed_read               = 1;
+        }
+        if ((writelookup[c] != (int) 0xffffffff) && (writelookup_phys[c] >= first) && (writelookup_phys[c] <= last)) {
+            page_lookup[writelookup[c]]  = NULL;
+            page_lookupp[writelookup[c]] = 4;
+            writelookup2[writelookup[c]] = LOOKUP_INV;
+            writelookupp[writelookup[c]] = 4;
+            writelookup[c]               = 0xffffffff;
+            flushed_write                = 1;
+        }
+    }
+    if (flushed_read)
+        mem_mutlb_flush_read();
+    if (flushed_write)
+        mem_mutlb_flush_write();
+    mem_desc_watch_gen++;
 }
 
 void
@@ -270,6 +415,45 @@ mem_flush_write_page(uint32_t addr, uint32_t virt)
             }
         }
     }
+    mem_mutlb_flush_write();
+}
+
+/* Arm the descriptor-cache write watch on a physical page. Any fast write
+   lookup already pointing into the page is dropped so subsequent stores
+   take the page_t handler path where the watch check lives. */
+void
+mem_desc_watch_page(uint32_t phys_page)
+{
+    int flushed = 0;
+
+    if (mem_desc_watch_pages[phys_page >> 6] & (1ULL << (phys_page & 63)))
+        return;
+    mem_desc_watch_pages[phys_page >> 6] |= 1ULL << (phys_page & 63);
+
+    for (uint16_t c = 0; c < 256; c++) {
+        if ((writelookup[c] != (int) 0xffffffff) && (writelookup_phys[c] == phys_page)) {
+            writelookup2[writelookup[c]] = LOOKUP_INV;
+            page_lookup[writelookup[c]]  = NULL;
+            writelookup[c]               = 0xffffffff;
+            flushed                      = 1;
+        }
+    }
+    if (flushed)
+        mem_mutlb_flush_write();
+}
+
+/* Invalidate all cached descriptors once a watched page is actually
+   modified. Called from the RAM page write handlers with a physical
+   address. */
+static inline void
+mem_desc_watch_check(uint32_t addr)
+{
+    uint32_t page = addr >> 12;
+
+    if (mem_desc_watch_pages[page >> 6] & (1ULL << (page & 63))) {
+        mem_desc_watch_pages[page >> 6] &= ~(1ULL << (page & 63));
+        mem_desc_watch_gen++;
+    }
 }
 
 #define mmutranslate_read(addr)  mmutranslatereal(addr, 0)
@@ -575,6 +759,13 @@ addreadlookup(uint32_t virt, uint32_t phys)
     if (virt == 0xffffffff)
         return;
 
+#ifdef USE_GDBSTUB
+    /* Keep watched pages out of the fast lookup, so their accesses always
+       take the slow path where the watchpoint check lives. */
+    if (gdbstub_watch_pages[(virt >> 12) >> 6] & (1ULL << ((virt >> 12) & 63)))
+        return;
+#endif
+
     if (readlookup2[virt >> 12] != (uintptr_t) LOOKUP_INV)
         return;
 
@@ -582,6 +773,7 @@ addreadlookup(uint32_t virt, uint32_t phys)
         if ((readlookup[readlnext] == ((es + DI) >> 12)) || (readlookup[readlnext] == ((es + EDI) >> 12)))
             uncached = 1;
         readlookup2[readlookup[readlnext]] = LOOKUP_INV;
+        mem_mutlb_flush_read();
     }
 
 #if (defined __amd64__ || defined _M_X64 || defined __aarch64__ || defined _M_ARM64)
@@ -596,9 +788,12 @@ addreadlookup(uint32_t virt, uint32_t phys)
 #endif
     readlookupp[virt >> 12] = mmu_perm;
 
-    readlookup[readlnext++] = virt >> 12;
+    readlookup_phys[readlnext] = phys >> 12;
+    readlookup[readlnext++]    = virt >> 12;
     readlnext &= (cachesize - 1);
 
+    perfc.lookup_fills++;
+
     cycles -= 9;
 }
 
@@ -612,25 +807,38 @@ addwritelookup(uint32_t virt, uint32_t phys)
     if (virt == 0xffffffff)
         return;
 
+#ifdef USE_GDBSTUB
+    /* See addreadlookup(): watched pages stay on the slow path. */
+    if (gdbstub_watch_pages[(virt >> 12) >> 6] & (1ULL << ((virt >> 12) & 63)))
+        return;
+#endif
+
     if (page_lookup[virt >> 12])
         return;
 
     if (writelookup[writelnext] != -1) {
         page_lookup[writelookup[writelnext]]  = NULL;
         writelookup2[writelookup[writelnext]] = LOOKUP_INV;
+        mem_mutlb_flush_write();
     }
 
+    /* While a snapshot is in progress, unsaved pages must stay on the page_t
+       write handlers so the copy-on-write hook sees every store. The same
+       applies to pages under the descriptor-cache write watch. */
+    int snap_force = (mem_snapshot_active && mem_snapshot_page_pending(phys >> 12))
+        || ((mem_desc_watch_pages[(phys >> 12) >> 6] >> ((phys >> 12) & 63)) & 1);
+
 #ifdef USE_NEW_DYNAREC
 #    ifdef USE_DYNAREC
-    if (pages[phys >> 12].block || (phys & ~0xfff) == recomp_page) {
+    if (snap_force || pages[phys >> 12].block || (phys & ~0xfff) == recomp_page) {
 #    else
-    if (pages[phys >> 12].block) {
+    if (snap_force || pages[phys >> 12].block) {
 #    endif
 #else
 #    ifdef USE_DYNAREC
-    if (pages[phys >> 12].block[0] || pages[phys >> 12].block[1] || pages[phys >> 12].block[2] || pages[phys >> 12].block[3] || (phys & ~0xfff) == recomp_page) {
+    if (snap_force || pages[phys >> 12].block[0] || pages[phys >> 12].block[1] || pages[phys >> 12].block[2] || pages[phys >> 12].block[3] || (phys & ~0xfff) == recomp_page) {
 #    else
-    if (pages[phys >> 12].block[0] || pages[phys >> 12].block[1] || pages[phys >> 12].block[2] || pages[phys >> 12].block[3]) {
+    if (snap_force || pages[phys >> 12].block[0] || pages[phys >> 12].block[1] || pages[phys >> 12].block[2] || pages[phys >> 12].block[3]) {
 #    endif
 #endif
         page_lookup[virt >> 12]  = &pages[phys >> 12];
@@ -649,12 +857,95 @@ addwritelookup(uint32_t virt, uint32_t phys)
     }
     writelookupp[virt >> 12] = mmu_perm;
 
-    writelookup[writelnext++] = virt >> 12;
+    writelookup_wc[writelnext]   = 0;
+    writelookup_phys[writelnext] = phys >> 12;
+    writelookup[writelnext++]    = virt >> 12;
     writelnext &= (cachesize - 1);
 
+    perfc.lookup_fills++;
+
     cycles -= 9;
 }
 
+/* Install a write lookup whose host pointer targets a device-owned page
+   (host_page = start of the backing page) instead of system RAM. Subsequent
+   stores to the page then take the CPU's direct-write path; the owner is
+   responsible for sweeping the dirty state at frame boundaries via
+   mem_wc_sweep() and for calling mem_wc_flush() when its decode state
+   changes. Any mapping recalc or MMU flush also drops these entries. */
+void
+addwritelookup_wc(uint32_t virt, uint32_t phys, uint8_t *host_page, void *tag)
+{
+    if (virt == 0xffffffff)
+        return;
+
+#ifdef USE_GDBSTUB
+    /* See addreadlookup(): watched pages stay on the slow path. */
+    if (gdbstub_watch_pages[(virt >> 12) >> 6] & (1ULL << ((virt >> 12) & 63)))
+        return;
+#endif
+
+    if (page_lookup[virt >> 12])
+        return;
+
+    if (writelookup[writelnext] != -1) {
+        page_lookup[writelookup[writelnext]]  = NULL;
+        writelookup2[writelookup[writelnext]] = LOOKUP_INV;
+        mem_mutlb_flush_write();
+    }
+
+    writelookup2[virt >> 12] = (uintptr_t) host_page - (uintptr_t) (virt & ~0xfff);
+    writelookupp[virt >> 12] = mmu_perm;
+
+    writelookup_wc[writelnext]     = 1;
+    writelookup_wc_tag[writelnext] = tag;
+    writelookup_phys[writelnext]   = phys >> 12;
+    writelookup[writelnext++]      = virt >> 12;
+    writelnext &= (cachesize - 1);
+    mem_wc_live = 1;
+
+    perfc.lookup_fills++;
+}
+
+/* Drop every write-combining lookup. Called whenever any mapping layout
+   changes and by owners whose decode state (banking, write mode, address
+   translation) no longer matches what the installed pointers assumed. */
+void
+mem_wc_flush(void)
+{
+    int flushed = 0;
+
+    if (!mem_wc_live)
+        return;
+
+    for (uint16_t c = 0; c < 256; c++) {
+        if (writelookup_wc[c] && (writelookup[c] != (int) 0xffffffff)) {
+            writelookup2[writelookup[c]] = LOOKUP_INV;
+            writelookup[c]               = 0xffffffff;
+            flushed                      = 1;
+        }
+        writelookup_wc[c] = 0;
+    }
+    mem_wc_live = 0;
+    if (flushed)
+        mem_mutlb_flush_write();
+}
+
+/* Report the physical page of every live write-combining lookup installed
+   with the given tag, so the owner can mark those pages dirty once per
+   frame in place of the per-write updates the direct path skips. */
+void
+mem_wc_sweep(void *tag, void (*mark)(uint32_t phys_page, void *tag))
+{
+    if (!mem_wc_live)
+        return;
+
+    for (uint16_t c = 0; c < 256; c++) {
+        if (writelookup_wc[c] && (writelookup_wc_tag[c] == tag) && (writelookup[c] != (int) 0xffffffff))
+            mark(writelookup_phys[c], tag);
+    }
+}
+
 uint8_t *
 getpccache(uint32_t a)
 {
@@ -698,16 +989,16 @@ getpccache(uint32_t a)
 uint8_t
 read_mem_b(uint32_t addr)
 {
-    mem_mapping_t *map;
-    uint8_t        ret        = 0xff;
-    int            old_cycles = cycles;
+    const mem_dispatch_t *disp;
+    uint8_t               ret        = 0xff;
+    int                   old_cycles = cycles;
 
     mem_logical_addr = addr;
     addr &= rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->read_b)
-        ret = map->read_b(addr, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->read_b)
+        ret = disp->read_b(addr, disp->read_priv);
 
     resub_cycles(old_cycles);
 
@@ -717,9 +1008,9 @@ read_mem_b(uint32_t addr)
 uint16_t
 read_mem_w(uint32_t addr)
 {
-    mem_mapping_t *map;
-    uint16_t       ret        = 0xffff;
-    int            old_cycles = cycles;
+    const mem_dispatch_t *disp;
+    uint16_t              ret        = 0xffff;
+    int                   old_cycles = cycles;
 
     mem_logical_addr = addr;
     addr &= rammask;
@@ -727,12 +1018,12 @@ read_mem_w(uint32_t addr)
     if (addr & 1)
         ret = read_mem_b(addr) | (read_mem_b(addr + 1) << 8);
     else {
-        map = read_mapping[addr >> MEM_GRANULARITY_BITS];
+        disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-        if (map && map->read_w)
-            ret = map->read_w(addr, map->priv);
-        else if (map && map->read_b)
-            ret = map->read_b(addr, map->priv) | (map->read_b(addr + 1, map->priv) << 8);
+        if (disp->read_w)
+            ret = disp->read_w(addr, disp->read_priv);
+        else if (disp->read_b)
+            ret = disp->read_b(addr, disp->read_priv) | (disp->read_b(addr + 1, disp->read_priv) << 8);
     }
 
     resub_cycles(old_cycles);
@@ -743,15 +1034,15 @@ read_mem_w(uint32_t addr)
 void
 write_mem_b(uint32_t addr, uint8_t val)
 {
-    mem_mapping_t *map;
-    int            old_cycles = cycles;
+    const mem_dispatch_t *disp;
+    int                   old_cycles = cycles;
 
     mem_logical_addr = addr;
     addr &= rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->write_b)
-        map->write_b(addr, val, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->write_b)
+        disp->write_b(addr, val, disp->write_priv);
 
     resub_cycles(old_cycles);
 }
@@ -759,8 +1050,8 @@ write_mem_b(uint32_t addr, uint8_t val)
 void
 write_mem_w(uint32_t addr, uint16_t val)
 {
-    mem_mapping_t *map;
-    int            old_cycles = cycles;
+    const mem_dispatch_t *disp;
+    int                   old_cycles = cycles;
 
     mem_logical_addr = addr;
     addr &= rammask;
@@ -769,14 +1060,12 @@ write_mem_w(uint32_t addr, uint16_t val)
         write_mem_b(addr, val);
         write_mem_b(addr + 1, val >> 8);
     } else {
-        map = write_mapping[addr >> MEM_GRANULARITY_BITS];
-        if (map) {
-            if (map->write_w)
-                map->write_w(addr, val, map->priv);
-            else if (map->write_b) {
-                map->write_b(addr, val, map->priv);
-                map->write_b(addr + 1, val >> 8, map->priv);
-            }
+        disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+        if (disp->write_w)
+            disp->write_w(addr, val, disp->write_priv);
+        else if (disp->write_b) {
+            disp->write_b(addr, val, disp->write_priv);
+            disp->write_b(addr + 1, val >> 8, disp->write_priv);
         }
     }
 
@@ -786,10 +1075,11 @@ write_mem_w(uint32_t addr, uint16_t val)
 uint8_t
 readmembl(uint32_t addr)
 {
-    mem_mapping_t *map;
-    uint64_t       a;
+    const mem_dispatch_t *disp;
+    uint64_t              a;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_READ, 1);
+    MEMTRACE_ACCESS(addr, 1, MEMTRACE_READ);
 
     addr64           = (uint64_t) addr;
     mem_logical_addr = addr;
@@ -805,9 +1095,9 @@ readmembl(uint32_t addr)
     }
     addr = (uint32_t) (addr64 & rammask);
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->read_b)
-        return map->read_b(addr, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->read_b)
+        return disp->read_b(addr, disp->read_priv);
 
     return 0xff;
 }
@@ -815,10 +1105,11 @@ readmembl(uint32_t addr)
 void
 writemembl(uint32_t addr, uint8_t val)
 {
-    mem_mapping_t *map;
-    uint64_t       a;
+    const mem_dispatch_t *disp;
+    uint64_t              a;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_WRITE, 1);
+    MEMTRACE_ACCESS(addr, 1, MEMTRACE_WRITE);
 
     addr64           = (uint64_t) addr;
     mem_logical_addr = addr;
@@ -839,18 +1130,19 @@ writemembl(uint32_t addr, uint8_t val)
     }
     addr = (uint32_t) (addr64 & rammask);
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->write_b)
-        map->write_b(addr, val, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->write_b)
+        disp->write_b(addr, val, disp->write_priv);
 }
 
 /* Read a byte from memory without MMU translation - result of previous MMU translation passed as value. */
 uint8_t
 readmembl_no_mmut(uint32_t addr, uint32_t a64)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_READ, 1);
+    MEMTRACE_ACCESS(addr, 1, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -862,9 +1154,9 @@ readmembl_no_mmut(uint32_t addr, uint32_t a64)
     } else
         addr &= rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->read_b)
-        return map->read_b(addr, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->read_b)
+        return disp->read_b(addr, disp->read_priv);
 
     return 0xff;
 }
@@ -873,9 +1165,10 @@ readmembl_no_mmut(uint32_t addr, uint32_t a64)
 void
 writemembl_no_mmut(uint32_t addr, uint32_t a64, uint8_t val)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_WRITE, 1);
+    MEMTRACE_ACCESS(addr, 1, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -892,20 +1185,21 @@ writemembl_no_mmut(uint32_t addr, uint32_t a64, uint8_t val)
     } else
         addr &= rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->write_b)
-        map->write_b(addr, val, map->priv);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->write_b)
+        disp->write_b(addr, val, disp->write_priv);
 }
 
 uint16_t
 readmemwl(uint32_t addr)
 {
-    mem_mapping_t *map;
-    uint64_t       a;
+    const mem_dispatch_t *disp;
+    uint64_t              a;
 
     addr64a[0] = addr;
     addr64a[1] = addr + 1;
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_READ, 2);
+    MEMTRACE_ACCESS(addr, 2, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -930,6 +1224,10 @@ readmemwl(uint32_t addr)
             mmu_perm = readlookupp[addr >> 12];
             return *(uint16_t *) (readlookup2[addr >> 12] + addr);
         }
+    } else if (readlookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm = readlookupp[addr >> 12];
+        return *(uint16_t *) (readlookup2[addr >> 12] + addr);
     }
 
     if (cr0 >> 31) {
@@ -943,13 +1241,13 @@ readmemwl(uint32_t addr)
 
     addr = addr64a[0] & rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->read_w)
-        return map->read_w(addr, map->priv);
+    if (disp->read_w)
+        return disp->read_w(addr, disp->read_priv);
 
-    if (map && map->read_b) {
-        return map->read_b(addr, map->priv) | ((uint16_t) (map->read_b(addr + 1, map->priv)) << 8);
+    if (disp->read_b) {
+        return disp->read_b(addr, disp->read_priv) | ((uint16_t) (disp->read_b(addr + 1, disp->read_priv)) << 8);
     }
 
     return 0xffff;
@@ -958,12 +1256,13 @@ readmemwl(uint32_t addr)
 void
 writememwl(uint32_t addr, uint16_t val)
 {
-    mem_mapping_t *map;
-    uint64_t       a;
+    const mem_dispatch_t *disp;
+    uint64_t              a;
 
     addr64a[0] = addr;
     addr64a[1] = addr + 1;
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_WRITE, 2);
+    MEMTRACE_ACCESS(addr, 2, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -997,6 +1296,11 @@ writememwl(uint32_t addr, uint16_t val)
             *(uint16_t *) (writelookup2[addr >> 12] + addr) = val;
             return;
         }
+    } else if (writelookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm                                        = writelookupp[addr >> 12];
+        *(uint16_t *) (writelookup2[addr >> 12] + addr) = val;
+        return;
     }
 
     if (page_lookup[addr >> 12] && page_lookup[addr >> 12]->write_w) {
@@ -1015,16 +1319,16 @@ writememwl(uint32_t addr, uint16_t val)
 
     addr = addr64a[0] & rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->write_w) {
-        map->write_w(addr, val, map->priv);
+    if (disp->write_w) {
+        disp->write_w(addr, val, disp->write_priv);
         return;
     }
 
-    if (map && map->write_b) {
-        map->write_b(addr, val, map->priv);
-        map->write_b(addr + 1, val >> 8, map->priv);
+    if (disp->write_b) {
+        disp->write_b(addr, val, disp->write_priv);
+        disp->write_b(addr + 1, val >> 8, disp->write_priv);
         return;
     }
 }
@@ -1033,9 +1337,10 @@ writememwl(uint32_t addr, uint16_t val)
 uint16_t
 readmemwl_no_mmut(uint32_t addr, uint32_t *a64)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_READ, 2);
+    MEMTRACE_ACCESS(addr, 2, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -1053,6 +1358,10 @@ readmemwl_no_mmut(uint32_t addr, uint32_t *a64)
             mmu_perm = readlookupp[addr >> 12];
             return *(uint16_t *) (readlookup2[addr >> 12] + addr);
         }
+    } else if (readlookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm = readlookupp[addr >> 12];
+        return *(uint16_t *) (readlookup2[addr >> 12] + addr);
     }
 
     if (cr0 >> 31) {
@@ -1063,13 +1372,13 @@ readmemwl_no_mmut(uint32_t addr, uint32_t *a64)
     } else
         addr &= rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->read_w)
-        return map->read_w(addr, map->priv);
+    if (disp->read_w)
+        return disp->read_w(addr, disp->read_priv);
 
-    if (map && map->read_b) {
-        return map->read_b(addr, map->priv) | ((uint16_t) (map->read_b(addr + 1, map->priv)) << 8);
+    if (disp->read_b) {
+        return disp->read_b(addr, disp->read_priv) | ((uint16_t) (disp->read_b(addr + 1, disp->read_priv)) << 8);
     }
 
     return 0xffff;
@@ -1079,9 +1388,10 @@ readmemwl_no_mmut(uint32_t addr, uint32_t *a64)
 void
 writememwl_no_mmut(uint32_t addr, uint32_t *a64, uint16_t val)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_WRITE, 2);
+    MEMTRACE_ACCESS(addr, 2, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -1102,6 +1412,11 @@ writememwl_no_mmut(uint32_t addr, uint32_t *a64, uint16_t val)
             *(uint16_t *) (writelookup2[addr >> 12] + addr) = val;
             return;
         }
+    } else if (writelookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm                                        = writelookupp[addr >> 12];
+        *(uint16_t *) (writelookup2[addr >> 12] + addr) = val;
+        return;
     }
 
     if (page_lookup[addr >> 12] && page_lookup[addr >> 12]->write_w) {
@@ -1118,16 +1433,16 @@ writememwl_no_mmut(uint32_t addr, uint32_t *a64, uint16_t val)
     } else
         addr &= rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->write_w) {
-        map->write_w(addr, val, map->priv);
+    if (disp->write_w) {
+        disp->write_w(addr, val, disp->write_priv);
         return;
     }
 
-    if (map && map->write_b) {
-        map->write_b(addr, val, map->priv);
-        map->write_b(addr + 1, val >> 8, map->priv);
+    if (disp->write_b) {
+        disp->write_b(addr, val, disp->write_priv);
+        disp->write_b(addr + 1, val >> 8, disp->write_priv);
         return;
     }
 }
@@ -1135,13 +1450,14 @@ writememwl_no_mmut(uint32_t addr, uint32_t *a64, uint16_t val)
 uint32_t
 readmemll(uint32_t addr)
 {
-    mem_mapping_t *map;
-    int            i;
-    uint64_t       a = 0x0000000000000000ULL;
+    const mem_dispatch_t *disp;
+    int                   i;
+    uint64_t              a = 0x0000000000000000ULL;
 
     for (i = 0; i < 4; i++)
         addr64a[i] = (uint64_t) (addr + i);
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_READ, 4);
+    MEMTRACE_ACCESS(addr, 4, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -1180,6 +1496,10 @@ readmemll(uint32_t addr)
             mmu_perm = readlookupp[addr >> 12];
             return *(uint32_t *) (readlookup2[addr >> 12] + addr);
         }
+    } else if (readlookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm = readlookupp[addr >> 12];
+        return *(uint32_t *) (readlookup2[addr >> 12] + addr);
     }
 
     if (cr0 >> 31) {
@@ -1192,16 +1512,16 @@ readmemll(uint32_t addr)
 
     addr = addr64a[0] & rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->read_l)
-        return map->read_l(addr, map->priv);
+    if (disp->read_l)
+        return disp->read_l(addr, disp->read_priv);
 
-    if (map && map->read_w)
-        return map->read_w(addr, map->priv) | ((uint32_t) (map->read_w(addr + 2, map->priv)) << 16);
+    if (disp->read_w)
+        return disp->read_w(addr, disp->read_priv) | ((uint32_t) (disp->read_w(addr + 2, disp->read_priv)) << 16);
 
-    if (map && map->read_b)
-        return map->read_b(addr, map->priv) | ((uint32_t) (map->read_b(addr + 1, map->priv)) << 8) | ((uint32_t) (map->read_b(addr + 2, map->priv)) << 16) | ((uint32_t) (map->read_b(addr + 3, map->priv)) << 24);
+    if (disp->read_b)
+        return disp->read_b(addr, disp->read_priv) | ((uint32_t) (disp->read_b(addr + 1, disp->read_priv)) << 8) | ((uint32_t) (disp->read_b(addr + 2, disp->read_priv)) << 16) | ((uint32_t) (disp->read_b(addr + 3, disp->read_priv)) << 24);
 
     return 0xffffffff;
 }
@@ -1209,13 +1529,14 @@ readmemll(uint32_t addr)
 void
 writememll(uint32_t addr, uint32_t val)
 {
-    mem_mapping_t *map;
-    int            i;
-    uint64_t       a = 0x0000000000000000ULL;
+    const mem_dispatch_t *disp;
+    int                   i;
+    uint64_t              a = 0x0000000000000000ULL;
 
     for (i = 0; i < 4; i++)
         addr64a[i] = (uint64_t) (addr + i);
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_WRITE, 4);
+    MEMTRACE_ACCESS(addr, 4, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -1261,6 +1582,11 @@ writememll(uint32_t addr, uint32_t val)
             *(uint32_t *) (writelookup2[addr >> 12] + addr) = val;
             return;
         }
+    } else if (writelookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm                                        = writelookupp[addr >> 12];
+        *(uint32_t *) (writelookup2[addr >> 12] + addr) = val;
+        return;
     }
 
     if (page_lookup[addr >> 12] && page_lookup[addr >> 12]->write_l) {
@@ -1279,22 +1605,22 @@ writememll(uint32_t addr, uint32_t val)
 
     addr = addr64a[0] & rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->write_l) {
-        map->write_l(addr, val, map->priv);
+    if (disp->write_l) {
+        disp->write_l(addr, val, disp->write_priv);
         return;
     }
-    if (map && map->write_w) {
-        map->write_w(addr, val, map->priv);
-        map->write_w(addr + 2, val >> 16, map->priv);
+    if (disp->write_w) {
+        disp->write_w(addr, val, disp->write_priv);
+        disp->write_w(addr + 2, val >> 16, disp->write_priv);
         return;
     }
-    if (map && map->write_b) {
-        map->write_b(addr, val, map->priv);
-        map->write_b(addr + 1, val >> 8, map->priv);
-        map->write_b(addr + 2, val >> 16, map->priv);
-        map->write_b(addr + 3, val >> 24, map->priv);
+    if (disp->write_b) {
+        disp->write_b(addr, val, disp->write_priv);
+        disp->write_b(addr + 1, val >> 8, disp->write_priv);
+        disp->write_b(addr + 2, val >> 16, disp->write_priv);
+        disp->write_b(addr + 3, val >> 24, disp->write_priv);
         return;
     }
 }
@@ -1303,9 +1629,10 @@ writememll(uint32_t addr, uint32_t val)
 uint32_t
 readmemll_no_mmut(uint32_t addr, uint32_t *a64)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_READ, 4);
+    MEMTRACE_ACCESS(addr, 4, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -1323,6 +1650,10 @@ readmemll_no_mmut(uint32_t addr, uint32_t *a64)
             mmu_perm = readlookupp[addr >> 12];
             return *(uint32_t *) (readlookup2[addr >> 12] + addr);
         }
+    } else if (readlookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm = readlookupp[addr >> 12];
+        return *(uint32_t *) (readlookup2[addr >> 12] + addr);
     }
 
     if (cr0 >> 31) {
@@ -1333,16 +1664,16 @@ readmemll_no_mmut(uint32_t addr, uint32_t *a64)
     } else
         addr &= rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->read_l)
-        return map->read_l(addr, map->priv);
+    if (disp->read_l)
+        return disp->read_l(addr, disp->read_priv);
 
-    if (map && map->read_w)
-        return map->read_w(addr, map->priv) | ((uint32_t) (map->read_w(addr + 2, map->priv)) << 16);
+    if (disp->read_w)
+        return disp->read_w(addr, disp->read_priv) | ((uint32_t) (disp->read_w(addr + 2, disp->read_priv)) << 16);
 
-    if (map && map->read_b)
-        return map->read_b(addr, map->priv) | ((uint32_t) (map->read_b(addr + 1, map->priv)) << 8) | ((uint32_t) (map->read_b(addr + 2, map->priv)) << 16) | ((uint32_t) (map->read_b(addr + 3, map->priv)) << 24);
+    if (disp->read_b)
+        return disp->read_b(addr, disp->read_priv) | ((uint32_t) (disp->read_b(addr + 1, disp->read_priv)) << 8) | ((uint32_t) (disp->read_b(addr + 2, disp->read_priv)) << 16) | ((uint32_t) (disp->read_b(addr + 3, disp->read_priv)) << 24);
 
     return 0xffffffff;
 }
@@ -1351,9 +1682,10 @@ readmemll_no_mmut(uint32_t addr, uint32_t *a64)
 void
 writememll_no_mmut(uint32_t addr, uint32_t *a64, uint32_t val)
 {
-    mem_mapping_t *map;
+    const mem_dispatch_t *disp;
 
     GDBSTUB_MEM_ACCESS(addr, GDBSTUB_MEM_WRITE, 4);
+    MEMTRACE_ACCESS(addr, 4, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -1374,6 +1706,11 @@ writememll_no_mmut(uint32_t addr, uint32_t *a64, uint32_t val)
             *(uint32_t *) (writelookup2[addr >> 12] + addr) = val;
             return;
         }
+    } else if (writelookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm                                        = writelookupp[addr >> 12];
+        *(uint32_t *) (writelookup2[addr >> 12] + addr) = val;
+        return;
     }
 
     if (page_lookup[addr >> 12] && page_lookup[addr >> 12]->write_l) {
@@ -1390,22 +1727,22 @@ writememll_no_mmut(uint32_t addr, uint32_t *a64, uint32_t val)
     } else
         addr &= rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->write_l) {
-        map->write_l(addr, val, map->priv);
+    if (disp->write_l) {
+        disp->write_l(addr, val, disp->write_priv);
         return;
     }
-    if (map && map->write_w) {
-        map->write_w(addr, val, map->priv);
-        map->write_w(addr + 2, val >> 16, map->priv);
+    if (disp->write_w) {
+        disp->write_w(addr, val, disp->write_priv);
+        disp->write_w(addr + 2, val >> 16, disp->write_priv);
         return;
     }
-    if (map && map->write_b) {
-        map->write_b(addr, val, map->priv);
-        map->write_b(addr + 1, val >> 8, map->priv);
-        map->write_b(addr + 2, val >> 16, map->priv);
-        map->write_b(addr + 3, val >> 24, map->priv);
+    if (disp->write_b) {
+        disp->write_b(addr, val, disp->write_priv);
+        disp->write_b(addr + 1, val >> 8, disp->write_priv);
+        disp->write_b(addr + 2, val >> 16, disp->write_priv);
+        disp->write_b(addr + 3, val >> 24, disp->write_priv);
         return;
     }
 }
@@ -1413,13 +1750,14 @@ writememll_no_mmut(uint32_t addr, uint32_t *a64, uint32_t val)
 uint64_t
 readmemql(uint32_t addr)
 {
-    mem_mapping_t *map;
-    int            i;
-    uint64_t       a = 0x0000000000000000ULL;
+    const mem_dispatch_t *disp;
+    int                   i;
+    uint64_t              a = 0x0000000000000000ULL;
 
     for (i = 0; i < 8; i++)
         addr64a[i] = (uint64_t) (addr + i);
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_READ, 8);
+    MEMTRACE_ACCESS(addr, 8, MEMTRACE_READ);
 
     mem_logical_addr = addr;
 
@@ -1457,6 +1795,10 @@ readmemql(uint32_t addr)
             mmu_perm = readlookupp[addr >> 12];
             return *(uint64_t *) (readlookup2[addr >> 12] + addr);
         }
+    } else if (readlookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm = readlookupp[addr >> 12];
+        return *(uint64_t *) (readlookup2[addr >> 12] + addr);
     }
 
     if (cr0 >> 31) {
@@ -1469,9 +1811,9 @@ readmemql(uint32_t addr)
 
     addr = addr64a[0] & rammask;
 
-    map = read_mapping[addr >> MEM_GRANULARITY_BITS];
-    if (map && map->read_l)
-        return map->read_l(addr, map->priv) | ((uint64_t) map->read_l(addr + 4, map->priv) << 32);
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
+    if (disp->read_l)
+        return disp->read_l(addr, disp->read_priv) | ((uint64_t) disp->read_l(addr + 4, disp->read_priv) << 32);
 
     return readmemll(addr) | ((uint64_t) readmemll(addr + 4) << 32);
 }
@@ -1479,13 +1821,14 @@ readmemql(uint32_t addr)
 void
 writememql(uint32_t addr, uint64_t val)
 {
-    mem_mapping_t *map;
-    int            i;
-    uint64_t       a = 0x0000000000000000ULL;
+    const mem_dispatch_t *disp;
+    int                   i;
+    uint64_t              a = 0x0000000000000000ULL;
 
     for (i = 0; i < 8; i++)
         addr64a[i] = (uint64_t) (addr + i);
     GDBSTUB_MEM_ACCESS_FAST(addr64a, GDBSTUB_MEM_WRITE, 8);
+    MEMTRACE_ACCESS(addr, 8, MEMTRACE_WRITE);
 
     mem_logical_addr = addr;
 
@@ -1530,6 +1873,11 @@ writememql(uint32_t addr, uint64_t val)
             *(uint64_t *) (writelookup2[addr >> 12] + addr) = val;
             return;
         }
+    } else if (writelookup2[addr >> 12] != (uintptr_t) LOOKUP_INV) {
+        /* Aligned accesses never cross a page - use the lookup table directly. */
+        mmu_perm                                        = writelookupp[addr >> 12];
+        *(uint64_t *) (writelookup2[addr >> 12] + addr) = val;
+        return;
     }
 
     if (page_lookup[addr >> 12] && page_lookup[addr >> 12]->write_l) {
@@ -1547,29 +1895,29 @@ writememql(uint32_t addr, uint64_t val)
 
     addr = addr64a[0] & rammask;
 
-    map = write_mapping[addr >> MEM_GRANULARITY_BITS];
+    disp = &mem_dispatch[addr >> MEM_GRANULARITY_BITS];
 
-    if (map && map->write_l) {
-        map->write_l(addr, val, map->priv);
-        map->write_l(addr + 4, val >> 32, map->priv);
+    if (disp->write_l) {
+        disp->write_l(addr, val, disp->write_priv);
+        disp->write_l(addr + 4, val >> 32, disp->write_priv);
         return;
     }
-    if (map && map->write_w) {
-        map->write_w(addr, val, map->priv);
-        map->write_w(addr + 2, val >> 16, map->priv);
-        map->write_w(addr + 4, val >> 32, map->priv);
-        map->write_w(addr + 6, val >> 48, map->priv);
+    if (disp->write_w) {
+        disp->write_w(addr, val, disp->write_priv);
+        disp->write_w(addr + 2, val >> 16, disp->write_priv);
+        disp->write_w(addr + 4, val >> 32, disp->write_priv);
+        disp->write_w(addr + 6, val >> 48, disp->write_priv);
         return;
     }
-    if (map && map->write_b) {
-        map->write_b(addr, val, map->priv);
-        map->write_b(addr + 1, val >> 8, map->priv);
-        map->write_b(addr + 2, val >> 16, map->priv);
-        map->write_b(addr + 3, val >> 24, map->priv);
-        map->write_b(addr + 4, val >> 32, map->priv);
-        map->write_b(addr + 5, val >> 40, map->priv);
-        map->write_b(addr + 6, val >> 48, map->priv);
-        map->write_b(addr + 7, val >> 56, map->priv);
+    if (disp->write_b) {
+        disp->write_b(addr, val, disp->write_priv);
+        disp->write_b(addr + 1, val >> 8, disp->write_priv);
+        disp->write_b(addr + 2, val >> 16, disp->write_priv);
+        disp->write_b(addr + 3, val >> 24, disp->write_priv);
+        disp->write_b(addr + 4, val >> 32, disp->write_priv);
+        disp->write_b(addr + 5, val >> 40, disp->write_priv);
+        disp->write_b(addr + 6, val >> 48, disp->write_priv);
+        disp->write_b(addr + 7, val >> 56, disp->write_priv);
         return;
     }
 }
@@ -1758,6 +2106,41 @@ mem_writel_phys(uint32_t addr, uint32_t val)
     }
 }
 
+/* Resolve a physical address range to a direct host pointer. This succeeds
+   only when every granularity bucket in the range resolves to the same
+   mapping, the mapping has directly addressable backing (exec) and the
+   mapped window is linear across the whole range; bus masters use it to
+   move entire blocks with one memcpy instead of walking the mapping
+   handlers one word at a time. */
+uint8_t *
+mem_get_phys_ptr(uint32_t addr, uint32_t len, int write)
+{
+    mem_mapping_t **bus = write ? write_mapping_bus : read_mapping_bus;
+    mem_mapping_t  *map;
+    uint32_t        first;
+    uint32_t        last;
+
+    if (!len || ((addr + len - 1) < addr))
+        return NULL;
+
+    first = addr >> MEM_GRANULARITY_BITS;
+    last  = (addr + len - 1) >> MEM_GRANULARITY_BITS;
+
+    map = bus[first];
+    if (!map || !map->exec)
+        return NULL;
+
+    for (uint32_t i = first + 1; i <= last; i++) {
+        if (bus[i] != map)
+            return NULL;
+    }
+
+    if ((((addr - map->base) & map->mask) + len - 1) != ((addr + len - 1 - map->base) & map->mask))
+        return NULL;
+
+    return &map->exec[(addr - map->base) & map->mask];
+}
+
 void
 mem_write_phys(void *src, uint32_t addr, int transfer_size)
 {
@@ -1896,11 +2279,15 @@ mem_write_ramb_page(uint32_t addr, uint8_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask        = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         int      byte_offset = (addr >> PAGE_BYTE_MASK_SHIFT) & PAGE_BYTE_MASK_OFFSET_MASK;
         uint64_t byte_mask   = (uint64_t) 1 << (addr & PAGE_BYTE_MASK_MASK);
@@ -1921,11 +2308,15 @@ mem_write_ramw_page(uint32_t addr, uint16_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint16_t *) &page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint16_t *) &page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask        = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         int      byte_offset = (addr >> PAGE_BYTE_MASK_SHIFT) & PAGE_BYTE_MASK_OFFSET_MASK;
         uint64_t byte_mask   = (uint64_t) 1 << (addr & PAGE_BYTE_MASK_MASK);
@@ -1956,11 +2347,15 @@ mem_write_raml_page(uint32_t addr, uint32_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint32_t *) &page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint32_t *) &page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask        = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         int      byte_offset = (addr >> PAGE_BYTE_MASK_SHIFT) & PAGE_BYTE_MASK_OFFSET_MASK;
         uint64_t byte_mask   = (uint64_t) 0xf << (addr & PAGE_BYTE_MASK_MASK);
@@ -1988,11 +2383,15 @@ mem_write_ramb_page(uint32_t addr, uint8_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         page->dirty_mask[(addr >> PAGE_MASK_INDEX_SHIFT) & PAGE_MASK_INDEX_MASK] |= mask;
         page->mem[addr & 0xfff] = val;
@@ -2005,11 +2404,15 @@ mem_write_ramw_page(uint32_t addr, uint16_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint16_t *) &page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint16_t *) &page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         if ((addr & 0xf) == 0xf)
             mask |= (mask << 1);
@@ -2024,11 +2427,15 @@ mem_write_raml_page(uint32_t addr, uint32_t val, page_t *page)
     if (page == NULL)
         return;
 
+    if (mem_snapshot_active)
+        mem_snapshot_cow(addr);
+
 #    ifdef USE_DYNAREC
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint32_t *) &page->mem[addr & 0xfff]) || codegen_in_recompile) {
 #    else
     if ((page->mem == NULL) || (page->mem == page_ff) || (val != *(uint32_t *) &page->mem[addr & 0xfff])) {
 #    endif
+        mem_desc_watch_check(addr);
         uint64_t mask = (uint64_t) 1 << ((addr >> PAGE_MASK_SHIFT) & PAGE_MASK_MASK);
         if ((addr & 0xf) >= 0xd)
             mask |= (mask << 1);
@@ -2209,40 +2616,49 @@ mem_write_remappedl2(uint32_t addr, uint32_t val, UNUSED(void *priv))
 void
 mem_invalidate_range(uint32_t start_addr, uint32_t end_addr)
 {
-#ifdef USE_NEW_DYNAREC
-    page_t *page;
+    uint32_t cur_addr;
+    uint32_t first;
+    uint32_t last;
 
     start_addr &= ~PAGE_MASK_MASK;
     end_addr = (end_addr + PAGE_MASK_MASK) & ~PAGE_MASK_MASK;
 
-    for (; start_addr <= end_addr; start_addr += 0x1000) {
-        if ((start_addr >> 12) >= pages_sz)
+    /*Only mark the regions actually covered by the range as dirty - marking
+      the whole page would also evict codeblocks the range never touched.*/
+    for (cur_addr = start_addr & ~0xfff; cur_addr <= end_addr; cur_addr += 0x1000) {
+        /* Do nothing if the pages array is empty or DMA reads/writes to/from PCI device memory addresses
+           may crash the emulator. */
+        if ((cur_addr >> 12) >= pages_sz)
             continue;
 
-        page = &pages[start_addr >> 12];
-        if (page) {
-            page->dirty_mask = 0xffffffffffffffffULL;
+        first = (cur_addr < start_addr) ? (start_addr & 0xfff) : 0;
+        last  = ((cur_addr | 0xfff) > end_addr) ? (end_addr & 0xfff) : 0xfff;
+
+#ifdef USE_NEW_DYNAREC
+        page_t *page = &pages[cur_addr >> 12];
 
-            if ((page->mem != page_ff) && page->byte_dirty_mask)
-                memset(page->byte_dirty_mask, 0xff, 64 * sizeof(uint64_t));
+        for (uint32_t c = (first >> PAGE_MASK_SHIFT); c <= (last >> PAGE_MASK_SHIFT); c++)
+            page->dirty_mask |= (uint64_t) 1 << (c & PAGE_MASK_MASK);
 
-            if (!page_in_evict_list(page))
-                page_add_to_evict_list(page);
+        if ((page->mem != page_ff) && page->byte_dirty_mask) {
+            for (uint32_t c = (first >> PAGE_BYTE_MASK_SHIFT); c <= (last >> PAGE_BYTE_MASK_SHIFT); c++) {
+                uint32_t lo = (c == (first >> PAGE_BYTE_MASK_SHIFT)) ? (first & PAGE_BYTE_MASK_MASK) : 0;
+                uint32_t hi = (c == (last >> PAGE_BYTE_MASK_SHIFT)) ? (last & PAGE_BYTE_MASK_MASK) : PAGE_BYTE_MASK_MASK;
+
+                if ((hi - lo) == PAGE_BYTE_MASK_MASK)
+                    page->byte_dirty_mask[c & PAGE_BYTE_MASK_OFFSET_MASK] = 0xffffffffffffffffULL;
+                else
+                    page->byte_dirty_mask[c & PAGE_BYTE_MASK_OFFSET_MASK] |= ((((uint64_t) 1 << (hi - lo + 1)) - 1) << lo);
+            }
         }
-    }
-#else
-    uint32_t cur_addr;
-    start_addr &= ~PAGE_MASK_MASK;
-    end_addr = (end_addr + PAGE_MASK_MASK) & ~PAGE_MASK_MASK;
 
-    for (; start_addr <= end_addr; start_addr += 0x1000) {
-        /* Do nothing if the pages array is empty or DMA reads/writes to/from PCI device memory addresses
-           may crash the emulator. */
-        cur_addr = (start_addr >> 12);
-        if (cur_addr < pages_sz)
-            memset(pages[cur_addr].dirty_mask, 0xff, sizeof(pages[cur_addr].dirty_mask));
-    }
+        if (!page_in_evict_list(page))
+            page_add_to_evict_list(page);
+#else
+        for (uint32_t c = (first >> PAGE_MASK_SHIFT); c <= (last >> PAGE_MASK_SHIFT); c++)
+            pages[cur_addr >> 12].dirty_mask[(c >> 6) & PAGE_MASK_INDEX_MASK] |= (uint64_t) 1 << (c & PAGE_MASK_MASK);
 #endif
+    }
 }
 
 static __inline int
@@ -2278,20 +2694,54 @@ mem_mapping_access_allowed(uint32_t flags, uint16_t access)
     return ret;
 }
 
+/* Ranges up to this many granules have their old tables snapshotted so a
+   recalc that reproduces them exactly (a chipset re-programming shadow
+   state to the same value, for instance) can skip the TLB and lookup
+   flushes. Larger ranges are rare and almost always real changes. */
+#define RECALC_SNAP_MAX 64
+
 void
 mem_mapping_recalc(uint64_t base, uint64_t size)
 {
     mem_mapping_t *map;
+    mem_mapping_t *old_read[RECALC_SNAP_MAX];
+    mem_mapping_t *old_write[RECALC_SNAP_MAX];
+    mem_mapping_t *old_read_bus[RECALC_SNAP_MAX];
+    mem_mapping_t *old_write_bus[RECALC_SNAP_MAX];
+    uint8_t       *old_exec[RECALC_SNAP_MAX];
     int            n;
+    int            track;
+    int            changed;
     uint64_t       c;
 
     if (!size || (base_mapping == NULL))
         return;
 
+    /* Inside a transaction, just widen the pending range; the commit
+       performs a single recalc over the union. */
+    if (recalc_trans_depth) {
+        if (base < recalc_trans_lo)
+            recalc_trans_lo = base;
+        if ((base + size) > recalc_trans_hi)
+            recalc_trans_hi = base + size;
+        return;
+    }
+
+    track = ((size >> MEM_GRANULARITY_BITS) <= RECALC_SNAP_MAX) && !(base & MEM_GRANULARITY_MASK) && !(size & MEM_GRANULARITY_MASK);
+
     map = base_mapping;
 
-    /* Clear out old mappings. */
+    /* Clear out old mappings, keeping the previous tables for small ranges
+       so a no-op republication can be detected below. */
     for (c = base; c < base + size; c += MEM_GRANULARITY_SIZE) {
+        if (track) {
+            n                = (c - base) >> MEM_GRANULARITY_BITS;
+            old_exec[n]      = _mem_exec[c >> MEM_GRANULARITY_BITS];
+            old_write[n]     = write_mapping[c >> MEM_GRANULARITY_BITS];
+            old_read[n]      = read_mapping[c >> MEM_GRANULARITY_BITS];
+            old_write_bus[n] = write_mapping_bus[c >> MEM_GRANULARITY_BITS];
+            old_read_bus[n]  = read_mapping_bus[c >> MEM_GRANULARITY_BITS];
+        }
         _mem_exec[c >> MEM_GRANULARITY_BITS]         = NULL;
         write_mapping[c >> MEM_GRANULARITY_BITS]     = NULL;
         read_mapping[c >> MEM_GRANULARITY_BITS]      = NULL;
@@ -2329,7 +2779,50 @@ mem_mapping_recalc(uint64_t base, uint64_t size)
         map = map->next;
     }
 
-    flushmmucache_nopc();
+    /* If the republished tables are identical to what was already live, the
+       cached translations and lookups still describe them - skip the
+       invalidation entirely. */
+    changed = !track;
+    if (track) {
+        for (c = base; c < base + size; c += MEM_GRANULARITY_SIZE) {
+            n = (c - base) >> MEM_GRANULARITY_BITS;
+            if ((old_exec[n] != _mem_exec[c >> MEM_GRANULARITY_BITS])
+                || (old_write[n] != write_mapping[c >> MEM_GRANULARITY_BITS])
+                || (old_read[n] != read_mapping[c >> MEM_GRANULARITY_BITS])
+                || (old_write_bus[n] != write_mapping_bus[c >> MEM_GRANULARITY_BITS])
+                || (old_read_bus[n] != read_mapping_bus[c >> MEM_GRANULARITY_BITS])) {
+                changed = 1;
+                break;
+            }
+        }
+    }
+
+    if (changed) {
+        /* Any mapping change invalidates cached physical pointers held by
+           bus masters (see dma_bm_window_*) and any write-combining lookups
+           pointing into device backing stores. */
+        mem_mapping_generation++;
+        mem_wc_flush();
+
+        /* Rebuild the flattened per-page dispatch from the final mappings. */
+        for (c = base; c < base + size; c += MEM_GRANULARITY_SIZE) {
+            mem_dispatch_t *disp = &mem_dispatch[c >> MEM_GRANULARITY_BITS];
+
+            map              = read_mapping[c >> MEM_GRANULARITY_BITS];
+            disp->read_b     = map ? map->read_b : NULL;
+            disp->read_w     = map ? map->read_w : NULL;
+            disp->read_l     = map ? map->read_l : NULL;
+            disp->read_priv  = map ? map->priv : NULL;
+
+            map              = write_mapping[c >> MEM_GRANULARITY_BITS];
+            disp->write_b    = map ? map->write_b : NULL;
+            disp->write_w    = map ? map->write_w : NULL;
+            disp->write_l    = map ? map->write_l : NULL;
+            disp->write_priv = map ? map->priv : NULL;
+        }
+
+        flushmmucache_range(base, size);
+    }
 
 #ifdef ENABLE_MEM_LOG
     pclog("\nMemory map:\n");
@@ -2382,6 +2875,39 @@ mem_mapping_recalc(uint64_t base, uint64_t size)
 #endif
 }
 
+/* Open a shadow recalc transaction. BIOSes reprogram shadow RAM a nibble at
+   a time, and a single chipset register write can fan out into several
+   mem_set_mem_state() calls plus a full MMU cache flush each; a transaction
+   lets the register handler apply every derived range and pay for one
+   recalc and one flush at commit. Transactions nest (SMRAM handlers called
+   from inside a PAM handler just bump the depth), and nothing else may run
+   between begin and commit - the dispatch tables are stale until then. */
+void
+mem_recalc_begin(void)
+{
+    if (!recalc_trans_depth++) {
+        recalc_trans_lo    = (uint64_t) -1;
+        recalc_trans_hi    = 0;
+        recalc_trans_flush = 0;
+    }
+}
+
+void
+mem_recalc_commit(void)
+{
+    if (--recalc_trans_depth > 0)
+        return;
+
+    if (recalc_trans_lo < recalc_trans_hi)
+        mem_mapping_recalc(recalc_trans_lo, recalc_trans_hi - recalc_trans_lo);
+
+    if (recalc_trans_flush == 2)
+        flushmmucache();
+    else if (recalc_trans_flush == 1)
+        flushmmucache_nopc();
+    recalc_trans_flush = 0;
+}
+
 void
 mem_mapping_set(mem_mapping_t *map,
                 uint32_t       base,
@@ -2514,6 +3040,44 @@ mem_mapping_set_exec(mem_mapping_t *map, uint8_t *exec)
     mem_mapping_recalc(map->base, map->size);
 }
 
+void
+mem_mapping_update_exec(mem_mapping_t *map, uint8_t *exec)
+{
+    uint8_t *old = map->exec;
+    uint64_t c;
+
+    if (old == exec)
+        return;
+
+    map->exec = exec;
+
+    /* Fast path for bank-switched RAM (EMS page frames): if this mapping
+       currently owns the exec pointers for its whole range, rewrite them
+       in place instead of recalculating the range - no mapping list walk,
+       no dispatch rebuild.  The handlers stay the same, only the backing
+       page moves. */
+    if (map->enable && (old != NULL) && (exec != NULL)) {
+        for (c = map->base; c < ((uint64_t) map->base + map->size); c += MEM_GRANULARITY_SIZE) {
+            if (_mem_exec[c >> MEM_GRANULARITY_BITS] != (old + (c - map->base))) {
+                /* Someone else (shadowing, SMRAM) owns part of the range -
+                   take the slow path. */
+                mem_mapping_recalc(map->base, map->size);
+                return;
+            }
+        }
+
+        for (c = map->base; c < ((uint64_t) map->base + map->size); c += MEM_GRANULARITY_SIZE)
+            _mem_exec[c >> MEM_GRANULARITY_BITS] = exec + (c - map->base);
+
+        /* Cached physical pointers may still reference the old page. */
+        mem_mapping_generation++;
+        flushmmucache_range(map->base, map->size);
+        return;
+    }
+
+    mem_mapping_recalc(map->base, map->size);
+}
+
 void
 mem_mapping_set_mask(mem_mapping_t *map, uint32_t mask)
 {
@@ -2526,6 +3090,9 @@ void
 mem_mapping_set_p(mem_mapping_t *map, void *priv)
 {
     map->priv = priv;
+
+    /* The flattened dispatch caches the private pointer per page. */
+    mem_mapping_recalc(map->base, map->size);
 }
 
 void
@@ -2642,6 +3209,95 @@ mem_init_ram_mapping(mem_mapping_t *mapping, uint32_t base, uint32_t size)
     mem_add_ram_mapping(mapping, base, size);
 }
 
+/* Allocate a guest RAM block. When mem_hugepages is set, first try a host
+   huge-page mapping, rounding the length up to a 2 MB multiple - the rounded
+   length is stored back through the pointer, as plat_munmap() must be given
+   the same length for a huge mapping. On failure (no huge pages reserved,
+   missing privilege, unsupported platform) fall back to a regular mapping of
+   the requested size. The returned block is zero-filled by the host (anonymous
+   mmap / VirtualAlloc), so the callers must not clear it again: the pages stay
+   lazily committed until the guest first touches them, and with several
+   emulator instances on one host, RAM the guests never use costs no resident
+   memory. First-touch NUMA placement likewise follows the emulation thread's
+   actual access pattern. */
+static void *
+mem_ram_alloc(size_t *size)
+{
+    if (mem_hugepages) {
+        size_t rounded = (*size + 0x1fffff) & ~((size_t) 0x1fffff);
+        void  *ret     = plat_mmap_huge(rounded, 0);
+        if (ret != NULL) {
+            *size = rounded;
+            return ret;
+        }
+        pclog("MEM: huge-page allocation of %zu bytes failed, falling back to normal pages\n", rounded);
+    }
+
+    return plat_mmap(*size, 0);
+}
+
+/* Advise the OS that all of guest RAM is cold. Called when the machine is
+   parked (paused), so hundreds of idle instances cost little resident
+   memory; pages fault back in on demand once the guest runs again, and
+   nothing is ever discarded. */
+void
+mem_compact(void)
+{
+    if (ram != NULL)
+        plat_memory_cold(ram, ram_size);
+#if (!(defined __amd64__ || defined _M_X64 || defined __aarch64__ || defined _M_ARM64))
+    if (ram2 != NULL)
+        plat_memory_cold(ram2, ram2_size);
+#endif
+}
+
+/* Incremental zero-page scavenger. Overcommitted hosts hold mostly-idle
+   instances whose guest RAM is largely zeros; host swap reclaims it
+   indiscriminately and hits hot emulator structures first. Scan a small
+   budget of guest RAM per CPU slice and hand all-zero chunks back to the
+   host - dropped anonymous memory reads back as zeros, so this is
+   lossless and every cached host pointer into the range stays valid.
+   Chunks are sized for the largest common host page so the advice is
+   never misaligned. Runs on the CPU thread between slices, so it cannot
+   race guest stores. */
+#define SCAVENGE_CHUNK 16384
+
+static size_t mem_scavenge_cursor = 0;
+
+static int
+mem_chunk_is_zero(const uint8_t *p)
+{
+    const uint64_t *q = (const uint64_t *) p;
+
+    for (unsigned int i = 0; i < (SCAVENGE_CHUNK / sizeof(uint64_t)); i++) {
+        if (q[i])
+            return 0;
+    }
+    return 1;
+}
+
+void
+mem_scavenge(int max_chunks)
+{
+    size_t limit;
+
+    /* Huge-page backed RAM must not be split back into small pages. */
+    if ((ram == NULL) || mem_hugepages)
+        return;
+
+    limit = ram_size & ~((size_t) (SCAVENGE_CHUNK - 1));
+
+    while (max_chunks-- > 0) {
+        if (mem_scavenge_cursor >= limit)
+            mem_scavenge_cursor = 0;
+        if (limit == 0)
+            return;
+        if (mem_chunk_is_zero(&ram[mem_scavenge_cursor]))
+            plat_memory_free_zero(&ram[mem_scavenge_cursor], SCAVENGE_CHUNK);
+        mem_scavenge_cursor += SCAVENGE_CHUNK;
+    }
+}
+
 /* Reset the memory state. */
 void
 mem_reset(void)
@@ -2689,15 +3345,14 @@ mem_reset(void)
 #if (!(defined __amd64__ || defined _M_X64 || defined __aarch64__ || defined _M_ARM64))
     if (mem_size > 1048576) {
         ram_size = 1 << 30;
-        ram      = (uint8_t *) plat_mmap(ram_size, 0); /* allocate and clear the RAM block of the first 1 GB */
+        ram      = (uint8_t *) mem_ram_alloc(&ram_size); /* allocate the RAM block of the first 1 GB */
         if (ram == NULL) {
             fatal("Failed to allocate primary RAM block. Make sure you have enough RAM available.\n");
             return;
         }
-        memset(ram, 0x00, ram_size);
-        ram2_size = m - (1 << 30);
         /* Allocate 16 extra bytes of RAM to mitigate some dynarec recompiler memory access quirks. */
-        ram2      = (uint8_t *) plat_mmap(ram2_size + 16, 0); /* allocate and clear the RAM block above 1 GB */
+        ram2_size = m - (1 << 30) + 16;
+        ram2      = (uint8_t *) mem_ram_alloc(&ram2_size); /* allocate the RAM block above 1 GB */
         if (ram2 == NULL) {
             if (config_changed == 2)
                 fatal(EMU_NAME " must be restarted for the memory amount change to be applied.\n");
@@ -2705,18 +3360,16 @@ mem_reset(void)
                 fatal("Failed to allocate secondary RAM block. Make sure you have enough RAM available.\n");
             return;
         }
-        memset(ram2, 0x00, ram2_size + 16);
     } else
 #endif
     {
-        ram_size = m;
         /* Allocate 16 extra bytes of RAM to mitigate some dynarec recompiler memory access quirks. */
-        ram      = (uint8_t *) plat_mmap(ram_size + 16, 0); /* allocate and clear the RAM block */
+        ram_size = m + 16;
+        ram      = (uint8_t *) mem_ram_alloc(&ram_size); /* allocate the RAM block */
         if (ram == NULL) {
             fatal("Failed to allocate RAM block. Make sure you have enough RAM available.\n");
             return;
         }
-        memset(ram, 0x00, ram_size + 16);
         if (mem_size > 1048576)
             ram2 = &(ram[1 << 30]);
     }
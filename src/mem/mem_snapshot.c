@@ -0,0 +1,380 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Copy-on-write guest RAM snapshot engine.
+ *
+ *          A snapshot only arms per-page dirty tracking and spawns a writer
+ *          thread, so initiating one is cheap no matter how much RAM the
+ *          guest has. While a page is still unsaved, writes to it are forced
+ *          through the page_t write handlers (the same mechanism used for
+ *          pages holding code), which copy the old contents aside before the
+ *          store lands; the writer thread then saves either the live page or
+ *          the copy. Pages are run-length encoded, which collapses the
+ *          zero/0xFF pages that dominate most guests.
+ *
+ *
+ *
+ * Authors: The 86Box team.
+ *
+ *          Copyright 2026 The 86Box team.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/mem.h>
+#include <86box/mem_snapshot.h>
+#include <86box/plat.h>
+#include <86box/thread.h>
+
+#define SNAP_MAGIC      "86BSNAP1"
+#define SNAP_VERSION    1
+#define SNAP_PAGE_SIZE  4096
+/* Worst-case RLE expansion: one control byte per 128 literals, rounded up. */
+#define SNAP_RLE_MAX    (SNAP_PAGE_SIZE + (SNAP_PAGE_SIZE / 128) + 1)
+#define SNAP_END_MARKER 0xffffffff
+
+typedef struct snap_header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t page_size;
+    uint32_t page_count;
+    uint32_t reserved;
+} snap_header_t;
+
+int mem_snapshot_active = 0;
+
+static FILE      *snap_file;
+static thread_t  *snap_thread;
+static mutex_t   *snap_mutex;
+static event_t   *snap_done_event;
+static uint64_t  *snap_pending;     /* one bit per RAM page, set = not saved yet */
+static uint8_t  **snap_cow;         /* copied-aside page contents, if any */
+static uint32_t   snap_page_count;
+
+#ifdef ENABLE_MEM_SNAPSHOT_LOG
+int mem_snapshot_do_log = ENABLE_MEM_SNAPSHOT_LOG;
+
+static void
+mem_snapshot_log(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (mem_snapshot_do_log) {
+        va_start(ap, fmt);
+        pclog_ex(fmt, ap);
+        va_end(ap);
+    }
+}
+#else
+#    define mem_snapshot_log(fmt, ...)
+#endif
+
+/* PackBits-style run length encoding: a control byte 0..127 is followed by
+   that many + 1 literal bytes, 129..255 repeats the next byte 257 - control
+   times, 128 is unused. */
+static uint32_t
+snap_rle_encode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t s = 0;
+    uint32_t d = 0;
+
+    while (s < len) {
+        uint32_t run = 1;
+
+        while (((s + run) < len) && (run < 128) && (src[s + run] == src[s]))
+            run++;
+
+        if (run >= 3) {
+            dst[d++] = (uint8_t) (257 - run);
+            dst[d++] = src[s];
+            s += run;
+        } else {
+            uint32_t lit = s;
+
+            while ((lit < len) && ((lit - s) < 128)) {
+                if (((lit + 2) < len) && (src[lit] == src[lit + 1]) && (src[lit] == src[lit + 2]))
+                    break;
+                lit++;
+            }
+            dst[d++] = (uint8_t) (lit - s - 1);
+            memcpy(&dst[d], &src[s], lit - s);
+            d += lit - s;
+            s = lit;
+        }
+    }
+
+    return d;
+}
+
+static int
+snap_rle_decode(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t dst_len)
+{
+    uint32_t s = 0;
+    uint32_t d = 0;
+
+    while (s < len) {
+        uint8_t ctrl = src[s++];
+
+        if (ctrl & 0x80) {
+            uint32_t run = 257 - ctrl;
+
+            if ((s >= len) || ((d + run) > dst_len))
+                return -1;
+            memset(&dst[d], src[s++], run);
+            d += run;
+        } else {
+            uint32_t lit = ctrl + 1;
+
+            if (((s + lit) > len) || ((d + lit) > dst_len))
+                return -1;
+            memcpy(&dst[d], &src[s], lit);
+            s += lit;
+            d += lit;
+        }
+    }
+
+    return (d == dst_len) ? 0 : -1;
+}
+
+int
+mem_snapshot_page_pending(uint32_t phys_page)
+{
+    if (phys_page >= snap_page_count)
+        return 0;
+
+    return !!(snap_pending[phys_page >> 6] & ((uint64_t) 1 << (phys_page & 63)));
+}
+
+/* Called from the page_t write handlers before the store lands: if the page
+   has not been saved yet, copy its old contents aside for the writer. */
+void
+mem_snapshot_cow(uint32_t addr)
+{
+    uint32_t page = addr >> 12;
+
+    if ((page >= snap_page_count) || !mem_snapshot_page_pending(page))
+        return;
+
+    thread_wait_mutex(snap_mutex);
+    if (mem_snapshot_page_pending(page) && (snap_cow[page] == NULL) && (pages[page].mem != NULL)) {
+        snap_cow[page] = malloc(SNAP_PAGE_SIZE);
+        memcpy(snap_cow[page], pages[page].mem, SNAP_PAGE_SIZE);
+    }
+    thread_release_mutex(snap_mutex);
+}
+
+/* The pending bitmap and copy-aside array are kept allocated between
+   snapshots: the emulator thread peeks at them without the mutex, so they
+   must never be freed while a stale mem_snapshot_active read is possible. */
+static void
+snap_finish_file(void)
+{
+    for (uint32_t c = 0; c < snap_page_count; c++) {
+        free(snap_cow[c]);
+        snap_cow[c] = NULL;
+    }
+    if (snap_file != NULL) {
+        fclose(snap_file);
+        snap_file = NULL;
+    }
+}
+
+static void
+snap_save_page(uint32_t page, uint8_t *scratch, uint8_t *rle)
+{
+    uint32_t len;
+    int      have_data = 0;
+
+    thread_wait_mutex(snap_mutex);
+    if (mem_snapshot_page_pending(page)) {
+        if (snap_cow[page] != NULL) {
+            memcpy(scratch, snap_cow[page], SNAP_PAGE_SIZE);
+            free(snap_cow[page]);
+            snap_cow[page] = NULL;
+            have_data      = 1;
+        } else if (pages[page].mem != NULL) {
+            memcpy(scratch, pages[page].mem, SNAP_PAGE_SIZE);
+            have_data = 1;
+        }
+        snap_pending[page >> 6] &= ~((uint64_t) 1 << (page & 63));
+    }
+    thread_release_mutex(snap_mutex);
+
+    if (!have_data)
+        return;
+
+    len = snap_rle_encode(scratch, SNAP_PAGE_SIZE, rle);
+    fwrite(&page, sizeof(uint32_t), 1, snap_file);
+    fwrite(&len, sizeof(uint32_t), 1, snap_file);
+    fwrite(rle, 1, len, snap_file);
+}
+
+static void
+snap_writer_thread(UNUSED(void *priv))
+{
+    uint32_t end_marker = SNAP_END_MARKER;
+    uint32_t end_len    = 0;
+    uint8_t *scratch    = malloc(SNAP_PAGE_SIZE);
+    uint8_t *rle        = malloc(SNAP_RLE_MAX);
+
+    for (uint32_t c = 0; c < snap_page_count; c++)
+        snap_save_page(c, scratch, rle);
+
+    fwrite(&end_marker, sizeof(uint32_t), 1, snap_file);
+    fwrite(&end_len, sizeof(uint32_t), 1, snap_file);
+
+    free(rle);
+    free(scratch);
+
+    thread_wait_mutex(snap_mutex);
+    mem_snapshot_active = 0;
+    snap_finish_file();
+    thread_release_mutex(snap_mutex);
+
+    mem_snapshot_log("MEM: snapshot complete\n");
+    thread_set_event(snap_done_event);
+}
+
+int
+mem_snapshot_start(const char *path)
+{
+    snap_header_t hdr;
+
+    if (mem_snapshot_active)
+        return -1;
+
+    snap_file = plat_fopen(path, "wb");
+    if (snap_file == NULL)
+        return -1;
+
+    if (snap_mutex == NULL)
+        snap_mutex = thread_create_mutex();
+    if (snap_done_event == NULL)
+        snap_done_event = thread_create_event();
+    thread_reset_event(snap_done_event);
+
+    if (snap_page_count != pages_sz) {
+        free(snap_pending);
+        free(snap_cow);
+        snap_page_count = pages_sz;
+        snap_pending    = calloc((snap_page_count + 63) >> 6, sizeof(uint64_t));
+        snap_cow        = calloc(snap_page_count, sizeof(uint8_t *));
+    }
+    for (uint32_t c = 0; c < snap_page_count; c++) {
+        if (pages[c].mem != NULL)
+            snap_pending[c >> 6] |= (uint64_t) 1 << (c & 63);
+    }
+
+    memcpy(hdr.magic, SNAP_MAGIC, 8);
+    hdr.version    = SNAP_VERSION;
+    hdr.page_size  = SNAP_PAGE_SIZE;
+    hdr.page_count = snap_page_count;
+    hdr.reserved   = 0;
+    fwrite(&hdr, sizeof(hdr), 1, snap_file);
+
+    mem_snapshot_active = 1;
+
+    /* Drop all cached write translations so every unsaved page goes back
+       through addwritelookup(), which keeps pending pages on the page_t
+       write handlers until they have been copied aside or saved. */
+    flushmmucache_nopc();
+
+    if (!is286) {
+        /* The 8088/80186 cores store to RAM directly without going through
+           the write handlers, so copy-on-write cannot intercept anything -
+           save synchronously instead (such machines have tiny RAM). */
+        uint8_t *scratch = malloc(SNAP_PAGE_SIZE);
+        uint8_t *rle     = malloc(SNAP_RLE_MAX);
+
+        for (uint32_t c = 0; c < snap_page_count; c++)
+            snap_save_page(c, scratch, rle);
+        free(rle);
+        free(scratch);
+
+        snap_writer_thread(NULL);
+        return 0;
+    }
+
+    snap_thread = thread_create_named(snap_writer_thread, NULL, "snapshot writer");
+
+    return 0;
+}
+
+int
+mem_snapshot_busy(void)
+{
+    return mem_snapshot_active;
+}
+
+void
+mem_snapshot_wait(void)
+{
+    if (mem_snapshot_active)
+        thread_wait_event(snap_done_event, -1);
+}
+
+int
+mem_snapshot_restore(const char *path)
+{
+    snap_header_t hdr;
+    FILE         *fp;
+    uint8_t      *scratch;
+    uint8_t      *rle;
+    int           ret = 0;
+
+    if (mem_snapshot_active)
+        return -1;
+
+    fp = plat_fopen(path, "rb");
+    if (fp == NULL)
+        return -1;
+
+    if ((fread(&hdr, sizeof(hdr), 1, fp) != 1) || memcmp(hdr.magic, SNAP_MAGIC, 8) || (hdr.version != SNAP_VERSION) || (hdr.page_size != SNAP_PAGE_SIZE)) {
+        fclose(fp);
+        return -1;
+    }
+
+    scratch = malloc(SNAP_PAGE_SIZE);
+    rle     = malloc(SNAP_RLE_MAX);
+
+    for (;;) {
+        uint32_t page;
+        uint32_t len;
+
+        if ((fread(&page, sizeof(uint32_t), 1, fp) != 1) || (fread(&len, sizeof(uint32_t), 1, fp) != 1)) {
+            ret = -1;
+            break;
+        }
+        if (page == SNAP_END_MARKER)
+            break;
+        if ((page >= pages_sz) || (len > SNAP_RLE_MAX) || (fread(rle, 1, len, fp) != len)) {
+            ret = -1;
+            break;
+        }
+        if (snap_rle_decode(rle, len, scratch, SNAP_PAGE_SIZE)) {
+            ret = -1;
+            break;
+        }
+        if ((pages[page].mem != NULL) && (pages[page].mem != page_ff))
+            memcpy(pages[page].mem, scratch, SNAP_PAGE_SIZE);
+    }
+
+    free(rle);
+    free(scratch);
+    fclose(fp);
+
+    /* Every page may now hold different code - invalidate everything. */
+    mem_invalidate_range(0, (pages_sz << 12) - 1);
+    flushmmucache();
+
+    return ret;
+}
@@ -0,0 +1,144 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Guest memory access tracer. The slow memory handlers call the
+ *          MEMTRACE_ACCESS hook, which tests a per-page filter bitmap
+ *          and appends a compact binary record (PC, address, size,
+ *          direction) to an in-memory buffer that is flushed to the
+ *          trace file as it fills. Accesses served by the fast
+ *          readlookup2/writelookup2 path are not seen - drop the pages
+ *          of interest from the filter of a running trace only if that
+ *          is acceptable, or trace RAM the guest has not yet cached.
+ *          When the tracer is off the hook costs a single predictable
+ *          branch.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/mem.h>
+#include <86box/plat.h>
+#include <86box/memtrace.h>
+
+#define MEMTRACE_MAGIC    0x544d3638 /* '86MT' (little endian) */
+#define MEMTRACE_VERSION  1
+#define MEMTRACE_BUF_RECS 16384
+
+typedef struct memtrace_header_t {
+    uint32_t magic;
+    uint32_t version;
+} memtrace_header_t;
+
+int      memtrace_on = 0;
+uint64_t memtrace_pages[(((uint32_t) -1) >> (12 + 6)) + 1];
+
+static FILE          *memtrace_fp = NULL;
+static memtrace_rec_t memtrace_buf[MEMTRACE_BUF_RECS];
+static int            memtrace_cnt    = 0;
+static int            memtrace_filter_set = 0;
+
+static void
+memtrace_flush(void)
+{
+    if (memtrace_cnt > 0) {
+        fwrite(memtrace_buf, sizeof(memtrace_rec_t), memtrace_cnt, memtrace_fp);
+        memtrace_cnt = 0;
+    }
+}
+
+/* Restrict the trace to [addr, addr + len); may be called repeatedly to
+   build up a filter set. A length of 0 clears the filter, which means
+   "trace everything". Call before memtrace_start(). */
+void
+memtrace_filter(uint32_t addr, uint32_t len)
+{
+    uint32_t last;
+
+    if (len == 0) {
+        memset(memtrace_pages, 0x00, sizeof(memtrace_pages));
+        memtrace_filter_set = 0;
+        return;
+    }
+
+    last = (addr + len - 1) >> 12;
+    for (uint32_t i = addr >> 12; i <= last; i++)
+        memtrace_pages[i >> 6] |= (1ULL << (i & 63));
+    memtrace_filter_set = 1;
+}
+
+void
+memtrace_start(const char *path)
+{
+    memtrace_header_t hdr;
+
+    if (memtrace_on)
+        return;
+
+    memtrace_fp = plat_fopen(path, "wb");
+    if (memtrace_fp == NULL) {
+        pclog("MEMTRACE: unable to open \"%s\" for writing\n", path);
+        return;
+    }
+
+    hdr.magic   = MEMTRACE_MAGIC;
+    hdr.version = MEMTRACE_VERSION;
+    fwrite(&hdr, sizeof(hdr), 1, memtrace_fp);
+
+    /* No filter configured: trace the entire address space. */
+    if (!memtrace_filter_set)
+        memset(memtrace_pages, 0xff, sizeof(memtrace_pages));
+
+    memtrace_cnt = 0;
+    memtrace_on  = 1;
+
+    pclog("MEMTRACE: tracing to \"%s\"\n", path);
+}
+
+void
+memtrace_stop(void)
+{
+    if (!memtrace_on)
+        return;
+
+    memtrace_on = 0;
+    memtrace_flush();
+    fclose(memtrace_fp);
+    memtrace_fp = NULL;
+
+    if (!memtrace_filter_set)
+        memset(memtrace_pages, 0x00, sizeof(memtrace_pages));
+
+    pclog("MEMTRACE: trace closed\n");
+}
+
+void
+memtrace_access(uint32_t addr, int size, int rw)
+{
+    memtrace_rec_t *rec = &memtrace_buf[memtrace_cnt++];
+
+    rec->pc    = cs + cpu_state.pc;
+    rec->addr  = addr;
+    rec->size  = size;
+    rec->write = rw;
+    rec->pad   = 0;
+
+    if (memtrace_cnt >= MEMTRACE_BUF_RECS)
+        memtrace_flush();
+}
@@ -35,6 +35,7 @@
 #include <86box/rom.h>
 #include <86box/path.h>
 #include <86box/plat.h>
+#include <86box/thread.h>
 #include <86box/machine.h>
 #include <86box/m_xt_xi8088.h>
 
@@ -56,6 +57,15 @@ rom_log(const char *fmt, ...)
 #    define rom_log(fmt, ...)
 #endif
 
+/* Guards the ROM cache list during the parallel availability scan
+   (machine_available_scan_all()); created by the first rom_add_path()
+   call, which happens on the main thread before any probing. The file
+   read itself runs outside the lock so concurrent misses overlap their
+   I/O. A returned entry may be trimmed by another thread's insert before
+   the caller looks at it - safe only because the scan runs bios_only
+   probes, which never dereference ent->data. */
+static mutex_t *rom_cache_mutex = NULL;
+
 void
 rom_add_path(const char *path)
 {
@@ -63,6 +73,10 @@ rom_add_path(const char *path)
 
     rom_path_t *rom_path = &rom_paths;
 
+    /* First call happens on the main thread before any image is probed. */
+    if (rom_cache_mutex == NULL)
+        rom_cache_mutex = thread_create_mutex();
+
     if (rom_paths.path[0] != '\0') {
         // Iterate to the end of the list.
         while (rom_path->next != NULL) {
@@ -109,6 +123,113 @@ rom_fopen(const char *fn, char *mode)
     }
 }
 
+/* ROM images are read over and over: availability probes open every BIOS
+   image of every machine, and automated hard-reset cycles re-read the same
+   files on each reset, which is slow on network-mounted ROM sets. Cache
+   file contents in memory, keyed by the name passed in (the machine tables
+   use consistent names), with the list kept in LRU order and trimmed to a
+   fixed budget so probing the full set cannot pin the whole romset. */
+#define ROM_CACHE_MAX (64 << 20)
+
+typedef struct rom_cache_entry_t {
+    char                      fn[1024];
+    uint8_t                  *data;
+    uint32_t                  size;
+    struct rom_cache_entry_t *next;
+} rom_cache_entry_t;
+
+static rom_cache_entry_t *rom_cache       = NULL;
+static uint32_t           rom_cache_total = 0;
+
+/* Cache lookup under the lock; moves a hit to the front of the LRU list. */
+static rom_cache_entry_t *
+rom_cache_find(const char *fn)
+{
+    rom_cache_entry_t  *ent;
+    rom_cache_entry_t **prev;
+
+    for (prev = &rom_cache; (ent = *prev) != NULL; prev = &ent->next) {
+        if (!strcmp(ent->fn, fn)) {
+            *prev     = ent->next;
+            ent->next = rom_cache;
+            rom_cache = ent;
+            return ent;
+        }
+    }
+
+    return NULL;
+}
+
+static rom_cache_entry_t *
+rom_cache_get(const char *fn)
+{
+    rom_cache_entry_t  *ent;
+    rom_cache_entry_t **prev;
+    FILE               *fp;
+    long                size;
+
+    if (rom_cache_mutex == NULL)
+        rom_cache_mutex = thread_create_mutex();
+
+    thread_wait_mutex(rom_cache_mutex);
+    ent = rom_cache_find(fn);
+    thread_release_mutex(rom_cache_mutex);
+    if (ent != NULL)
+        return ent;
+
+    fp = rom_fopen(fn, "rb");
+    if (fp == NULL)
+        return NULL;
+
+    (void) fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    if (fseek(fp, 0, SEEK_SET) == -1)
+        fatal("rom_cache_get(): Error seeking to the beginning of the file\n");
+
+    ent = (rom_cache_entry_t *) calloc(1, sizeof(rom_cache_entry_t));
+    strncpy(ent->fn, fn, sizeof(ent->fn) - 1);
+    ent->size = (uint32_t) size;
+    ent->data = (uint8_t *) malloc(size ? size : 1);
+    if (fread(ent->data, 1, size, fp) != (size_t) size)
+        fatal("rom_cache_get(): Error reading '%s'\n", fn);
+    (void) fclose(fp);
+
+    thread_wait_mutex(rom_cache_mutex);
+
+    /* Another scan thread may have inserted the same image while we were
+       reading it; keep the copy already in the list. */
+    rom_cache_entry_t *race = rom_cache_find(fn);
+    if (race != NULL) {
+        thread_release_mutex(rom_cache_mutex);
+        free(ent->data);
+        free(ent);
+        return race;
+    }
+
+    ent->next = rom_cache;
+    rom_cache = ent;
+    rom_cache_total += ent->size;
+
+    /* Trim least-recently-used entries once over budget, but always keep
+       the entry just loaded. */
+    prev = &rom_cache->next;
+    while ((*prev != NULL) && (rom_cache_total > ROM_CACHE_MAX)) {
+        if ((*prev)->next == NULL) {
+            rom_cache_entry_t *victim = *prev;
+
+            *prev = NULL;
+            rom_cache_total -= victim->size;
+            free(victim->data);
+            free(victim);
+        } else
+            prev = &(*prev)->next;
+    }
+
+    thread_release_mutex(rom_cache_mutex);
+
+    return ent;
+}
+
 int
 rom_getfile(char *fn, char *s, int size)
 {
@@ -140,15 +261,9 @@ rom_getfile(char *fn, char *s, int size)
 int
 rom_present(const char *fn)
 {
-    FILE *fp;
-
-    fp = rom_fopen(fn, "rb");
-    if (fp != NULL) {
-        (void) fclose(fp);
-        return 1;
-    }
-
-    return 0;
+    /* Pull the image into the cache while we are at it - a presence check
+       is almost always followed by a load of the same file. */
+    return (rom_cache_get(fn) != NULL);
 }
 
 uint8_t
@@ -205,9 +320,9 @@ rom_readl(uint32_t addr, void *priv)
 int
 rom_load_linear_oddeven(const char *fn, uint32_t addr, int sz, int off, uint8_t *ptr)
 {
-    FILE *fp = rom_fopen(fn, "rb");
+    const rom_cache_entry_t *ent = rom_cache_get(fn);
 
-    if (fp == NULL) {
+    if (ent == NULL) {
         rom_log("ROM: image '%s' not found\n", fn);
         return 0;
     }
@@ -219,20 +334,14 @@ rom_load_linear_oddeven(const char *fn, uint32_t addr, int sz, int off, uint8_t
         addr &= 0x03ffff;
 
     if (ptr != NULL) {
-        if (fseek(fp, off, SEEK_SET) == -1)
-            fatal("rom_load_linear(): Error seeking to the beginning of the file\n");
-        for (int i = 0; i < (sz >> 1); i++) {
-            if (fread(ptr + (addr + (i << 1)), 1, 1, fp) != 1)
-                fatal("rom_load_linear(): Error reading even data\n");
-        }
-        for (int i = 0; i < (sz >> 1); i++) {
-            if (fread(ptr + (addr + (i << 1) + 1), 1, 1, fp) != 1)
-                fatal("rom_load_linear(): Error reading od data\n");
-        }
+        if ((off + sz) > (int) ent->size)
+            fatal("rom_load_linear(): Error reading data\n");
+        for (int i = 0; i < (sz >> 1); i++)
+            ptr[addr + (i << 1)] = ent->data[off + i];
+        for (int i = 0; i < (sz >> 1); i++)
+            ptr[addr + (i << 1) + 1] = ent->data[off + (sz >> 1) + i];
     }
 
-    (void) fclose(fp);
-
     return 1;
 }
 
@@ -240,9 +349,9 @@ rom_load_linear_oddeven(const char *fn, uint32_t addr, int sz, int off, uint8_t
 int
 rom_load_linear(const char *fn, uint32_t addr, int sz, int off, uint8_t *ptr)
 {
-    FILE *fp = rom_fopen(fn, "rb");
+    const rom_cache_entry_t *ent = rom_cache_get(fn);
 
-    if (fp == NULL) {
+    if (ent == NULL) {
         rom_log("ROM: image '%s' not found\n", fn);
         return 0;
     }
@@ -253,14 +362,13 @@ rom_load_linear(const char *fn, uint32_t addr, int sz, int off, uint8_t *ptr)
     else
         addr &= 0x03ffff;
 
-    if (ptr != NULL) {
-        if (fseek(fp, off, SEEK_SET) == -1)
-            fatal("rom_load_linear(): Error seeking to the beginning of the file\n");
-        if (fread(ptr + addr, 1, sz, fp) > sz)
-            fatal("rom_load_linear(): Error reading data\n");
-    }
+    if ((ptr != NULL) && (off < (int) ent->size)) {
+        int len = sz;
 
-    (void) fclose(fp);
+        if ((off + len) > (int) ent->size)
+            len = ent->size - off;
+        memcpy(ptr + addr, ent->data + off, len);
+    }
 
     return 1;
 }
@@ -269,9 +377,9 @@ rom_load_linear(const char *fn, uint32_t addr, int sz, int off, uint8_t *ptr)
 int
 rom_load_linear_inverted(const char *fn, uint32_t addr, int sz, int off, uint8_t *ptr)
 {
-    FILE *fp = rom_fopen(fn, "rb");
+    const rom_cache_entry_t *ent = rom_cache_get(fn);
 
-    if (fp == NULL) {
+    if (ent == NULL) {
         rom_log("ROM: image '%s' not found\n", fn);
         return 0;
     }
@@ -283,23 +391,14 @@ rom_load_linear_inverted(const char *fn, uint32_t addr, int sz, int off, uint8_t
         addr &= 0x03ffff;
     }
 
-    (void) fseek(fp, 0, SEEK_END);
-    if (ftell(fp) < sz) {
-        (void) fclose(fp);
+    if ((int) ent->size < sz)
         return 0;
-    }
 
-    if (ptr != NULL) {
-        if (fseek(fp, off, SEEK_SET) == -1)
-            fatal("rom_load_linear_inverted(): Error seeking to the beginning of the file\n");
-        if (fread(ptr + addr + 0x10000, 1, sz >> 1, fp) > (sz >> 1))
-            fatal("rom_load_linear_inverted(): Error reading the upper half of the data\n");
-        if (fread(ptr + addr, sz >> 1, 1, fp) > (sz >> 1))
-            fatal("rom_load_linear_inverted(): Error reading the lower half of the data\n");
+    if ((ptr != NULL) && ((off + sz) <= (int) ent->size)) {
+        memcpy(ptr + addr + 0x10000, ent->data + off, sz >> 1);
+        memcpy(ptr + addr, ent->data + off + (sz >> 1), sz >> 1);
     }
 
-    (void) fclose(fp);
-
     return 1;
 }
 
@@ -307,18 +406,14 @@ rom_load_linear_inverted(const char *fn, uint32_t addr, int sz, int off, uint8_t
 int
 rom_load_interleaved(const char *fnl, const char *fnh, uint32_t addr, int sz, int off, uint8_t *ptr)
 {
-    FILE *fpl = rom_fopen(fnl, "rb");
-    FILE *fph = rom_fopen(fnh, "rb");
+    const rom_cache_entry_t *entl = rom_cache_get(fnl);
+    const rom_cache_entry_t *enth = rom_cache_get(fnh);
 
-    if (fpl == NULL || fph == NULL) {
-        if (fpl == NULL)
+    if (entl == NULL || enth == NULL) {
+        if (entl == NULL)
             rom_log("ROM: image '%s' not found\n", fnl);
-        else
-            (void) fclose(fpl);
-        if (fph == NULL)
+        if (enth == NULL)
             rom_log("ROM: image '%s' not found\n", fnh);
-        else
-            (void) fclose(fph);
 
         return 0;
     }
@@ -331,17 +426,14 @@ rom_load_interleaved(const char *fnl, const char *fnh, uint32_t addr, int sz, in
     }
 
     if (ptr != NULL) {
-        (void) fseek(fpl, off, SEEK_SET);
-        (void) fseek(fph, off, SEEK_SET);
         for (int c = 0; c < sz; c += 2) {
-            ptr[addr + c]     = fgetc(fpl) & 0xff;
-            ptr[addr + c + 1] = fgetc(fph) & 0xff;
+            int i = off + (c >> 1);
+
+            ptr[addr + c]     = (i < (int) entl->size) ? entl->data[i] : 0xff;
+            ptr[addr + c + 1] = (i < (int) enth->size) ? enth->data[i] : 0xff;
         }
     }
 
-    (void) fclose(fph);
-    (void) fclose(fpl);
-
     return 1;
 }
 
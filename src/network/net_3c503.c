@@ -638,6 +638,7 @@ threec503_nic_init(UNUSED(const device_t *info))
 
     /* Attach ourselves to the network module. */
     dev->dp8390->card = network_attach(dev->dp8390, dev->dp8390->physaddr, dp8390_rx, NULL);
+    network_set_rx_filter(dev->dp8390->card, dp8390_rx_filter);
 
     return dev;
 }
@@ -240,6 +240,8 @@ dp8390_write_cr(dp8390_t *dev, uint32_t val)
                 dev->interrupt(dev->priv, 0);
         }
     }
+
+    dp8390_rx_filter_update(dev);
 }
 
 static void
@@ -417,6 +419,59 @@ dp8390_rx(void *priv, uint8_t *buf, int io_len)
     return dp8390_rx_common(priv, buf, io_len);
 }
 
+/*
+ * Recompile the RX acceptance state after a filter-related register write.
+ * The flattened MAR bits and mode flags are read by dp8390_rx_filter() on
+ * the host RX thread.
+ */
+void
+dp8390_rx_filter_update(dp8390_t *dev)
+{
+    uint64_t bits = 0;
+
+    for (uint8_t i = 0; i < 8; i++)
+        bits |= ((uint64_t) dev->mchash[i]) << (i << 3);
+
+    dev->rx_mcast_bits   = bits;
+    dev->rx_accept_bcast = dev->RCR.broadcast;
+    dev->rx_accept_mcast = dev->RCR.multicast;
+
+    /* Early dropping is only safe while dp8390_rx() would reach the
+       address filter and reject with no side effects: a stopped device,
+       loopback mode or a full ring must instead hold packets in the queue
+       so existing backpressure behavior is preserved, and promiscuous
+       mode accepts everything anyway. */
+    dev->rx_filter_active = !dev->CR.stop && (dev->DCR.loop != 0)
+        && (dev->TCR.loop_cntl == 0) && !dev->RCR.promisc;
+}
+
+/*
+ * Early acceptance check, run on the host RX thread before a packet is
+ * queued toward the device: anything the device would reject purely on
+ * destination address grounds is dropped before it pays for the queue and
+ * the device-side poll. Everything uncertain is let through.
+ */
+int
+dp8390_rx_filter(void *priv, const uint8_t *buf, int io_len)
+{
+    const dp8390_t *dev           = (const dp8390_t *) priv;
+    static uint8_t  bcast_addr[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+    if (!dev->rx_filter_active || (dev->page_start == 0) || (io_len < 40))
+        return 1;
+
+    if (!memcmp(buf, bcast_addr, 6))
+        return dev->rx_accept_bcast;
+
+    if (buf[0] & 0x01) {
+        if (!dev->rx_accept_mcast)
+            return 0;
+        return (dev->rx_mcast_bits >> mcast_index(buf)) & 1;
+    }
+
+    return !memcmp(buf, dev->physaddr, 6);
+}
+
 /* Handle reads/writes to the 'zeroth' page of the DS8390 register file. */
 uint32_t
 dp8390_page0_read(dp8390_t *dev, uint32_t off, unsigned int len)
@@ -694,6 +749,8 @@ dp8390_page0_write(dp8390_t *dev, uint32_t off, uint32_t val, UNUSED(unsigned le
             dp8390_log("DP8390: Page0 write, bad register 0x%02x\n", off);
             break;
     }
+
+    dp8390_rx_filter_update(dev);
 }
 
 /* Handle reads/writes to the first page of the DS8390 register file. */
@@ -775,6 +832,8 @@ dp8390_page1_write(dp8390_t *dev, uint32_t off, uint32_t val, UNUSED(unsigned le
                        off);
             break;
     }
+
+    dp8390_rx_filter_update(dev);
 }
 
 /* Handle reads/writes to the second page of the DS8390 register file. */
@@ -990,6 +1049,8 @@ dp8390_reset(dp8390_t *dev)
 
     if (dev->interrupt)
         dev->interrupt(dev->priv, 0);
+
+    dp8390_rx_filter_update(dev);
 }
 
 void
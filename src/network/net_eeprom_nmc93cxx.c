@@ -131,25 +131,35 @@ nmc93cxx_eeprom_write(nmc93cxx_eeprom_t *eeprom, int eecs, int eesk, int eedi)
         /* End chip select cycle. This triggers write / erase. */
         if (!eeprom->dev.wp) {
             uint8_t subcommand = address >> (eeprom->addrbits - 2);
+            int     changed    = 0;
             if (command == 0 && subcommand == 2) {
                 /* Erase all. */
                 for (address = 0; address < eeprom->size; address++) {
                     eeprom->dev.data[address] = 0xffff;
                 }
+                changed = 1;
             } else if (command == 3) {
                 /* Erase word. */
                 eeprom->dev.data[address] = 0xffff;
+                changed = 1;
             } else if (tick >= 2 + 2 + eeprom->addrbits + 16) {
                 if (command == 1) {
                     /* Write word. */
                     eeprom->dev.data[address] &= eeprom->dev.dat;
+                    changed = 1;
                 } else if (command == 0 && subcommand == 1) {
                     /* Write all. */
                     for (address = 0; address < eeprom->size; address++) {
                         eeprom->dev.data[address] &= eeprom->dev.dat;
                     }
+                    changed = 1;
                 }
             }
+            /* Schedule the backing file for the NVR layer's deferred save
+               pass, so the contents now also survive a crash instead of
+               only being written at device close. */
+            if (changed)
+                nvr_file_dirty(eeprom->filename, eeprom->dev.data, eeprom->size * sizeof(uint16_t));
         }
         /* Output DO is tristate, read results in 1. */
         eedo = 1;
@@ -252,11 +262,10 @@ static void
 nmc93cxx_eeprom_close(void *priv)
 {
     nmc93cxx_eeprom_t *eeprom = (nmc93cxx_eeprom_t *) priv;
-    FILE              *fp     = nvr_fopen(eeprom->filename, "wb");
-    if (fp) {
-        fwrite(eeprom->dev.data, 2, eeprom->size, fp);
-        fclose(fp);
-    }
+
+    /* Flush any contents the deferred save pass has not written yet. */
+    nvr_file_sync(eeprom->filename);
+
     free(priv);
 }
 
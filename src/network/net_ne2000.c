@@ -1120,6 +1120,7 @@ nic_init(const device_t *info)
 
     /* Attach ourselves to the network module. */
     dev->dp8390->card = network_attach(dev->dp8390, dev->dp8390->physaddr, dp8390_rx, NULL);
+    network_set_rx_filter(dev->dp8390->card, dp8390_rx_filter);
 
     nelog(1, "%s: %s attached IO=0x%X IRQ=%d\n", dev->name,
           dev->is_pci ? "PCI" : "ISA", dev->base_address, dev->base_irq);
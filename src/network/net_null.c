@@ -6,7 +6,20 @@
 *
 *          This file is part of the 86Box distribution.
 *
-*          Null network driver
+*          Null network driver, with an optional loopback benchmark mode.
+*
+*          In its default configuration the driver discards every packet,
+*          as before. Setting "null_loopback=1" in the [Network] section
+*          of the configuration file turns it into a controlled loopback
+*          link for benchmarking the emulated NIC stack in isolation:
+*          transmitted frames are reflected back to the guest with their
+*          MAC addresses swapped, optionally shaped by
+*          "null_bandwidth" (kbit/s, 0 = unlimited),
+*          "null_latency" (ms) and "null_jitter" (ms, uniform).
+*          "null_train" injects that many unsolicited packets toward the
+*          guest every "null_train_interval" ms ("null_train_size" bytes
+*          each) to exercise the RX path on its own. Traffic counters are
+*          logged every five seconds.
 *
 *
 *
@@ -32,7 +45,11 @@
 
 #define HAVE_STDARG_H
 #include <86box/86box.h>
+#include <86box/ini.h>
+#include <86box/config.h>
 #include <86box/device.h>
+#include <86box/plat.h>
+#include <86box/random.h>
 #include <86box/thread.h>
 #include <86box/timer.h>
 #include <86box/network.h>
@@ -54,6 +71,11 @@ enum {
 
 #define NULL_PKT_BATCH NET_QUEUE_LEN
 
+/* Power of two; in-flight reflected frames beyond this are dropped. */
+#define NULL_DELAY_RING 256
+
+#define NULL_STATS_PERIOD_US 5000000ULL
+
 typedef struct net_null_t {
     uint8_t    mac_addr[6];
     netcard_t *card;
@@ -62,6 +84,39 @@ typedef struct net_null_t {
     net_evt_t  stop_event;
     netpkt_t   pkt;
     netpkt_t   pktv[NULL_PKT_BATCH];
+
+    /* Benchmark configuration; all zero in plain discard mode. */
+    int      loopback;
+    uint32_t bw_kbit;
+    uint32_t latency_us;
+    uint32_t jitter_us;
+    uint32_t train_len;
+    uint32_t train_size;
+    uint32_t train_interval_us;
+
+    /* 64-bit extension of plat_get_micro_ticks(). */
+    uint32_t time_lo;
+    uint64_t time_hi;
+
+    /* When the shaped link finishes serializing the last reflected frame. */
+    uint64_t link_free;
+
+    uint64_t next_train;
+    uint64_t next_stats;
+
+    /* Reflected frames waiting out their latency, oldest at tail. */
+    netpkt_t delay_pkt[NULL_DELAY_RING];
+    uint64_t delay_due[NULL_DELAY_RING];
+    int      delay_head;
+    int      delay_tail;
+
+    uint8_t *train_data;
+
+    uint64_t tx_packets;
+    uint64_t tx_bytes;
+    uint64_t rx_packets;
+    uint64_t rx_bytes;
+    uint64_t dropped;
 } net_null_t;
 
 #ifdef ENABLE_NET_NULL_LOG
@@ -82,6 +137,125 @@ net_null_log(const char *fmt, ...)
 #    define net_null_log(fmt, ...)
 #endif
 
+static uint64_t
+net_null_now_us(net_null_t *net_null)
+{
+    uint32_t now = plat_get_micro_ticks();
+
+    net_null->time_hi += (uint64_t) (uint32_t) (now - net_null->time_lo);
+    net_null->time_lo = now;
+
+    return net_null->time_hi;
+}
+
+/* Account a transmitted frame and, in loopback mode, schedule its
+   reflection back toward the guest. */
+static void
+net_null_tx(net_null_t *net_null, const netpkt_t *pkt)
+{
+    net_null->tx_packets++;
+    net_null->tx_bytes += pkt->len;
+
+    if (!net_null->loopback || (pkt->len < 12) || (pkt->len > NET_MAX_FRAME)) {
+        net_null_log("Null Network: Ignoring TX packet (%d bytes)\n", pkt->len);
+        return;
+    }
+
+    const int head = net_null->delay_head;
+    const int next = (head + 1) & (NULL_DELAY_RING - 1);
+
+    if (next == net_null->delay_tail) {
+        net_null->dropped++;
+        return;
+    }
+
+    uint64_t now = net_null_now_us(net_null);
+    uint64_t due = now;
+
+    if (net_null->bw_kbit) {
+        /* The link serializes one frame at a time. */
+        if (net_null->link_free < now)
+            net_null->link_free = now;
+        net_null->link_free += ((uint64_t) pkt->len * 8000ULL) / net_null->bw_kbit;
+        due = net_null->link_free;
+    }
+    due += net_null->latency_us;
+    if (net_null->jitter_us) {
+        uint32_t r = ((uint32_t) random_generate() << 16) | ((uint32_t) random_generate() << 8) | random_generate();
+        due += r % (net_null->jitter_us + 1);
+    }
+
+    netpkt_t *slot = &net_null->delay_pkt[head];
+
+    /* Swap the MAC addresses so the guest accepts its own frame back. */
+    memcpy(slot->data, pkt->data + 6, 6);
+    memcpy(slot->data + 6, pkt->data, 6);
+    memcpy(slot->data + 12, pkt->data + 12, pkt->len - 12);
+    slot->len = pkt->len;
+
+    net_null->delay_due[head] = due;
+    net_null->delay_head      = next;
+}
+
+/* Run whatever timed work is due (reflections, packet trains, counter
+   dumps) and return the poll timeout in milliseconds until the next
+   scheduled piece of work, or -1 to sleep until an event. */
+static int
+net_null_service(net_null_t *net_null)
+{
+    uint64_t now  = net_null_now_us(net_null);
+    uint64_t next = 0;
+
+    while (net_null->delay_tail != net_null->delay_head) {
+        const int i = net_null->delay_tail;
+
+        if (net_null->delay_due[i] > now) {
+            next = net_null->delay_due[i];
+            break;
+        }
+        if (network_rx_put(net_null->card, net_null->delay_pkt[i].data, net_null->delay_pkt[i].len)) {
+            net_null->rx_packets++;
+            net_null->rx_bytes += net_null->delay_pkt[i].len;
+        } else
+            net_null->dropped++;
+        net_null->delay_tail = (i + 1) & (NULL_DELAY_RING - 1);
+    }
+
+    if (net_null->train_len) {
+        if (now >= net_null->next_train) {
+            for (uint32_t i = 0; i < net_null->train_len; i++) {
+                if (network_rx_put(net_null->card, net_null->train_data, net_null->train_size)) {
+                    net_null->rx_packets++;
+                    net_null->rx_bytes += net_null->train_size;
+                } else
+                    net_null->dropped++;
+            }
+            net_null->next_train = now + net_null->train_interval_us;
+        }
+        if (!next || (net_null->next_train < next))
+            next = net_null->next_train;
+    }
+
+    if (net_null->loopback || net_null->train_len) {
+        if (now >= net_null->next_stats) {
+            pclog("Null Network: tx %llu pkts / %llu bytes, rx %llu pkts / %llu bytes, dropped %llu\n",
+                  (unsigned long long) net_null->tx_packets, (unsigned long long) net_null->tx_bytes,
+                  (unsigned long long) net_null->rx_packets, (unsigned long long) net_null->rx_bytes,
+                  (unsigned long long) net_null->dropped);
+            net_null->next_stats = now + NULL_STATS_PERIOD_US;
+        }
+        if (!next || (net_null->next_stats < next))
+            next = net_null->next_stats;
+    }
+
+    if (!next)
+        return -1;
+    if (next <= now)
+        return 0;
+
+    return (int) ((next - now + 999ULL) / 1000ULL);
+}
+
 #ifdef _WIN32
 static void
 net_null_thread(void *priv)
@@ -97,7 +271,9 @@ net_null_thread(void *priv)
     bool run = true;
 
     while (run) {
-        int ret = WaitForMultipleObjects(NET_EVENT_TX_MAX, events, FALSE, INFINITE);
+        int timeout = net_null_service(net_null);
+        int ret     = WaitForMultipleObjects(NET_EVENT_TX_MAX, events, FALSE,
+                                             (timeout < 0) ? INFINITE : (DWORD) timeout);
 
         switch (ret - WAIT_OBJECT_0) {
             case NET_EVENT_STOP:
@@ -109,12 +285,12 @@ net_null_thread(void *priv)
                 net_event_clear(&net_null->tx_event);
                 int packets = network_tx_popv(net_null->card, net_null->pktv, NULL_PKT_BATCH);
                 for (int i = 0; i < packets; i++) {
-                    net_null_log("Null Network: Ignoring TX packet (%d bytes)\n", net_null->pktv[i].len);
+                    net_null_tx(net_null, &net_null->pktv[i]);
                 }
                 break;
 
             default:
-                net_null_log("Null Network: Unknown event.\n");
+                /* Wakeups for timed work land in net_null_service(). */
                 break;
         }
     }
@@ -137,7 +313,9 @@ net_null_thread(void *priv)
     pfd[NET_EVENT_TX].events = POLLIN | POLLPRI;
 
     while (1) {
-        poll(pfd, NET_EVENT_MAX, -1);
+        int timeout = net_null_service(net_null);
+
+        poll(pfd, NET_EVENT_MAX, timeout);
 
         if (pfd[NET_EVENT_STOP].revents & POLLIN) {
             net_event_clear(&net_null->stop_event);
@@ -149,7 +327,7 @@ net_null_thread(void *priv)
 
             int packets = network_tx_popv(net_null->card, net_null->pktv, NULL_PKT_BATCH);
             for (int i = 0; i < packets; i++) {
-                net_null_log("Null Network: Ignoring TX packet (%d bytes)\n", net_null->pktv[i].len);
+                net_null_tx(net_null, &net_null->pktv[i]);
             }
         }
     }
@@ -172,6 +350,47 @@ net_null_init(const netcard_t *card, const uint8_t *mac_addr, UNUSED(void *priv)
     }
     net_null->pkt.data = calloc(1, NET_MAX_FRAME);
 
+    net_null->loopback          = !!config_get_int("Network", "null_loopback", 0);
+    net_null->bw_kbit           = config_get_int("Network", "null_bandwidth", 0);
+    net_null->latency_us        = config_get_int("Network", "null_latency", 0) * 1000;
+    net_null->jitter_us         = config_get_int("Network", "null_jitter", 0) * 1000;
+    net_null->train_len         = config_get_int("Network", "null_train", 0);
+    net_null->train_size        = config_get_int("Network", "null_train_size", 1514);
+    net_null->train_interval_us = config_get_int("Network", "null_train_interval", 10) * 1000;
+
+    if (net_null->train_size < 60)
+        net_null->train_size = 60;
+    if (net_null->train_size > NET_MAX_FRAME)
+        net_null->train_size = NET_MAX_FRAME;
+    if (net_null->train_interval_us < 1000)
+        net_null->train_interval_us = 1000;
+
+    if (net_null->loopback) {
+        for (int i = 0; i < NULL_DELAY_RING; i++)
+            net_null->delay_pkt[i].data = calloc(1, NET_MAX_FRAME);
+        pclog("Null Network: loopback benchmark mode, %u kbit/s, %u us latency, %u us jitter\n",
+              net_null->bw_kbit, net_null->latency_us, net_null->jitter_us);
+    }
+
+    if (net_null->train_len) {
+        /* Unsolicited frames toward the guest: local experimental
+           EtherType, locally administered source address. */
+        static const uint8_t train_src[6] = { 0x02, 0x00, 0x86, 0x42, 0x00, 0x01 };
+
+        net_null->train_data = calloc(1, NET_MAX_FRAME);
+        memcpy(net_null->train_data, mac_addr, 6);
+        memcpy(net_null->train_data + 6, train_src, 6);
+        net_null->train_data[12] = 0x88;
+        net_null->train_data[13] = 0xb5;
+        for (uint32_t i = 14; i < net_null->train_size; i++)
+            net_null->train_data[i] = i & 0xff;
+        pclog("Null Network: generating %u-packet trains of %u bytes every %u us\n",
+              net_null->train_len, net_null->train_size, net_null->train_interval_us);
+    }
+
+    net_null->time_lo    = plat_get_micro_ticks();
+    net_null->next_stats = NULL_STATS_PERIOD_US;
+
     net_event_init(&net_null->tx_event);
     net_event_init(&net_null->stop_event);
     net_null->poll_tid = thread_create(net_null_thread, net_null);
@@ -211,6 +430,12 @@ net_null_close(void *priv)
     }
     free(net_null->pkt.data);
 
+    if (net_null->loopback) {
+        for (int i = 0; i < NULL_DELAY_RING; i++)
+            free(net_null->delay_pkt[i].data);
+    }
+    free(net_null->train_data);
+
     net_event_close(&net_null->tx_event);
     net_event_close(&net_null->stop_event);
 
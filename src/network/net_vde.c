@@ -21,6 +21,9 @@
  * See the COPYING file at the top of the 86box for license details.
  * TL;DR: GPL version 2.
  */
+#if defined(__linux__)
+#define _GNU_SOURCE // for sendmmsg()/recvmmsg()
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -34,6 +37,14 @@
 #error VDE is not supported under windows
 #endif
 
+// Linux can move a whole batch of datagrams per syscall. The classic
+// vde_switch transport is a plain datagram socket, which we verify at
+// init time before bypassing vde_send/vde_recv for the data fd.
+#if defined(__linux__)
+#include <sys/socket.h>
+#define VDE_HAVE_MMSG 1
+#endif
+
 #include <libvdeplug.h>
 
 #define HAVE_STDARG_H
@@ -70,6 +81,8 @@ typedef struct net_vde_t {
     net_evt_t  stop_event;          // Stop thread event
     netpkt_t   pkt;                 // Packet read/sent
     netpkt_t   pktv[VDE_PKT_BATCH]; // Packet queue
+    netpkt_t   rx_pktv[VDE_PKT_BATCH]; // Batched receive buffers (swapped into the RX queue)
+    int        has_mmsg;            // Data fd is a datagram socket usable with sendmmsg/recvmmsg
     uint8_t    mac_addr[6];         // MAC Address
 } net_vde_t;
 
@@ -151,6 +164,30 @@ static void net_vde_thread(void *priv) {
         if (pfd[NET_EVENT_TX].revents & POLLIN) {
             net_event_clear(&vde->tx_event);
             int packets = network_tx_popv(vde->card, vde->pktv, VDE_PKT_BATCH);
+#ifdef VDE_HAVE_MMSG
+            if (vde->has_mmsg && (packets > 0)) {
+                struct mmsghdr msgv[VDE_PKT_BATCH];
+                struct iovec   iov[VDE_PKT_BATCH];
+                memset(msgv, 0, packets * sizeof(msgv[0]));
+                for (int i=0; i<packets; i++) {
+                    iov[i].iov_base         = vde->pktv[i].data;
+                    iov[i].iov_len          = vde->pktv[i].len;
+                    msgv[i].msg_hdr.msg_iov = &iov[i];
+                    msgv[i].msg_hdr.msg_iovlen = 1;
+                }
+                int sent = 0;
+                while (sent < packets) {
+                    int nc = sendmmsg(pfd[NET_EVENT_RX].fd, msgv + sent, packets - sent, 0);
+                    if (nc < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        vde_log("VDE: sendmmsg failed (%s).\n", strerror(errno));
+                        break;
+                    }
+                    sent += nc;
+                }
+            } else
+#endif
             for (int i=0; i<packets; i++) {
                 int nc = f_vde_send(vde->vdeconn, vde->pktv[i].data,vde->pktv[i].len, 0 );
                 if (nc == 0) {
@@ -161,9 +198,32 @@ static void net_vde_thread(void *priv) {
 
         // Packets are available for reading. Read packet and queue it
         if (pfd[NET_EVENT_RX].revents & POLLIN) {
-            int nc = f_vde_recv(vde->vdeconn, vde->pkt.data, NET_MAX_FRAME, 0);
-            vde->pkt.len = nc;
-            network_rx_put_pkt(vde->card, &vde->pkt);
+#ifdef VDE_HAVE_MMSG
+            if (vde->has_mmsg) {
+                struct mmsghdr msgv[VDE_PKT_BATCH];
+                struct iovec   iov[VDE_PKT_BATCH];
+                memset(msgv, 0, sizeof(msgv));
+                // Rebuilt every pass: queueing a packet swaps its buffer
+                // with one from the RX queue's pool.
+                for (int i=0; i<VDE_PKT_BATCH; i++) {
+                    iov[i].iov_base         = vde->rx_pktv[i].data;
+                    iov[i].iov_len          = NET_MAX_FRAME;
+                    msgv[i].msg_hdr.msg_iov = &iov[i];
+                    msgv[i].msg_hdr.msg_iovlen = 1;
+                }
+                int nc = recvmmsg(pfd[NET_EVENT_RX].fd, msgv, VDE_PKT_BATCH, MSG_DONTWAIT, NULL);
+                for (int i=0; i<nc; i++) {
+                    vde->rx_pktv[i].len = msgv[i].msg_len;
+                    if (vde->rx_pktv[i].len > 0)
+                        network_rx_put_pkt(vde->card, &vde->rx_pktv[i]);
+                }
+            } else
+#endif
+            {
+                int nc = f_vde_recv(vde->vdeconn, vde->pkt.data, NET_MAX_FRAME, 0);
+                vde->pkt.len = nc;
+                network_rx_put_pkt(vde->card, &vde->pkt);
+            }
         }
 
         // We have been told to close
@@ -219,6 +279,7 @@ void net_vde_close(void *priv) {
     // Free all the mallocs!
     for(i=0;i<VDE_PKT_BATCH; i++) {
         free(vde->pktv[i].data);
+        free(vde->rx_pktv[i].data);
     }
     free(vde->pkt.data);
     f_vde_close(vde->vdeconn);
@@ -289,8 +350,21 @@ void *net_vde_init(const netcard_t *card, const uint8_t *mac_addr, void *priv, c
 
     for(uint8_t i = 0; i < VDE_PKT_BATCH; i++) {
         vde->pktv[i].data = calloc(1, NET_MAX_FRAME);
+        vde->rx_pktv[i].data = calloc(1, NET_MAX_FRAME);
     }
     vde->pkt.data = calloc(1,NET_MAX_FRAME);
+
+#ifdef VDE_HAVE_MMSG
+    // Only the classic vde_switch transport hands us a datagram socket;
+    // other libvdeplug plugins keep going through vde_send/vde_recv.
+    int       sotype = 0;
+    socklen_t solen  = sizeof(sotype);
+    if ((getsockopt(f_vde_datafd(vde->vdeconn), SOL_SOCKET, SO_TYPE, &sotype, &solen) == 0)
+        && ((sotype == SOCK_DGRAM) || (sotype == SOCK_SEQPACKET))) {
+        vde->has_mmsg = 1;
+        vde_log("VDE: data fd is a datagram socket, using batched syscalls.\n");
+    }
+#endif
     net_event_init(&vde->tx_event);
     net_event_init(&vde->stop_event);
     vde->poll_tid = thread_create(net_vde_thread, vde);     // Fire up the read-write thread!
@@ -786,6 +786,7 @@ wd_init(const device_t *info)
 
     /* Attach ourselves to the network module. */
     dev->dp8390->card = network_attach(dev->dp8390, dev->dp8390->physaddr, dp8390_rx, NULL);
+    network_set_rx_filter(dev->dp8390->card, dp8390_rx_filter);
 
     if (!(dev->board_chip & WE_ID_BUS_MCA)) {
         wdlog("%s: attached IO=0x%X IRQ=%d, RAM addr=0x%06x\n", dev->name,
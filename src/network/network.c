@@ -61,6 +61,8 @@
 #define HAVE_STDARG_H
 #include <86box/86box.h>
 #include <86box/device.h>
+#include <86box/ini.h>
+#include <86box/config.h>
 #include <86box/timer.h>
 #include <86box/plat.h>
 #include <86box/thread.h>
@@ -75,6 +77,7 @@
 #include <86box/net_wd8003.h>
 #include <86box/net_tulip.h>
 #include <86box/net_rtl8139.h>
+#include "crc32speed.h"
 
 #ifdef _WIN32
 #    define WIN32_LEAN_AND_MEAN
@@ -204,6 +207,171 @@ network_dump_packet(netpkt_t *pkt)
 #    define network_dump_packet(pkt)
 #endif
 
+/* Per-card capture tap. Both directions of a card's traffic are teed into
+   SPSC rings (RX producers already serialized by rx_mutex, TX produced by
+   the emulator thread) and drained to a pcap file by a writer thread, so
+   the data path only ever pays a buffer copy - never file I/O. Timestamps
+   are emulated-time TSC snapshots, which is what an external tcpdump on
+   the host cannot give us. */
+
+#define NET_CAP_RING_LEN  256 /* Must be a power of 2. */
+#define NET_CAP_RING_MASK (NET_CAP_RING_LEN - 1)
+
+enum {
+    NET_CAP_RX = 0,
+    NET_CAP_TX,
+    NET_CAP_DIR_MAX
+};
+
+typedef struct netcap_slot_t {
+    uint8_t *data;
+    int      len;
+    uint64_t ts; /* TSC snapshot at tee time */
+} netcap_slot_t;
+
+typedef struct netcap_ring_t {
+    netcap_slot_t slots[NET_CAP_RING_LEN];
+    atomic_int    head;
+    atomic_int    tail;
+} netcap_ring_t;
+
+struct netcap_t {
+    FILE         *file;
+    thread_t     *writer_tid;
+    event_t      *wake;
+    atomic_bool   stop;
+    uint32_t      dropped;
+    netcap_ring_t rings[NET_CAP_DIR_MAX];
+};
+
+static void
+network_cap_tee(netcap_t *cap, int dir, const uint8_t *data, int len)
+{
+    netcap_ring_t *ring = &cap->rings[dir];
+
+    if ((len <= 0) || (len > NET_MAX_FRAME))
+        return;
+
+    if (((ring->head + 1) & NET_CAP_RING_MASK) == ring->tail) {
+        /* Writer fell behind; losing a capture record must never stall
+           the data path. */
+        cap->dropped++;
+        return;
+    }
+
+    netcap_slot_t *slot = &ring->slots[ring->head];
+    memcpy(slot->data, data, len);
+    slot->len = len;
+    /* The RX tee reads the TSC from the host backend thread; a torn read
+       can only garble a diagnostic timestamp, never the data path. */
+    slot->ts    = tsc;
+    ring->head  = (ring->head + 1) & NET_CAP_RING_MASK;
+
+    thread_set_event(cap->wake);
+}
+
+static int
+network_cap_drain(netcap_t *cap)
+{
+    int drained = 0;
+
+    for (int dir = 0; dir < NET_CAP_DIR_MAX; dir++) {
+        netcap_ring_t *ring = &cap->rings[dir];
+
+        while (ring->tail != ring->head) {
+            netcap_slot_t *slot = &ring->slots[ring->tail];
+
+            /* Timer timestamps are 32:32 fixed point cycles; TIMER_USEC
+               is the cycles-per-microsecond constant in the same format. */
+            uint64_t us = (uint64_t) ((double) slot->ts * 4294967296.0 / (double) TIMER_USEC);
+            struct {
+                uint32_t ts_sec, ts_usec, incl_len, orig_len;
+            } pcap_packet_hdr = {
+                (uint32_t) (us / 1000000), (uint32_t) (us % 1000000), slot->len, slot->len
+            };
+
+            fwrite(&pcap_packet_hdr, sizeof(pcap_packet_hdr), 1, cap->file);
+            fwrite(slot->data, 1, slot->len, cap->file);
+
+            ring->tail = (ring->tail + 1) & NET_CAP_RING_MASK;
+            drained++;
+        }
+    }
+
+    return drained;
+}
+
+static void
+network_cap_thread(void *priv)
+{
+    netcap_t *cap = (netcap_t *) priv;
+
+    while (1) {
+        thread_wait_event(cap->wake, 100);
+        thread_reset_event(cap->wake);
+
+        network_cap_drain(cap);
+
+        /* Only leave once the rings have been drained past the stop flag,
+           so netcard_close() gets every packet on disk. */
+        if (atomic_load(&cap->stop) && !network_cap_drain(cap))
+            break;
+
+        fflush(cap->file);
+    }
+}
+
+static netcap_t *
+network_cap_open(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (!file) {
+        network_log("NETWORK: unable to open capture file %s\n", path);
+        return NULL;
+    }
+
+    struct {
+        uint32_t magic_number;
+        uint16_t version_major, version_minor;
+        int32_t  thiszone;
+        uint32_t sigfigs, snaplen, network;
+    } pcap_hdr = {
+        0xa1b2c3d4,
+        2, 4,
+        0,
+        0, 65535, 1
+    };
+    fwrite(&pcap_hdr, sizeof(pcap_hdr), 1, file);
+
+    netcap_t *cap = calloc(1, sizeof(netcap_t));
+    cap->file     = file;
+    for (int dir = 0; dir < NET_CAP_DIR_MAX; dir++) {
+        for (int i = 0; i < NET_CAP_RING_LEN; i++)
+            cap->rings[dir].slots[i].data = calloc(1, NET_MAX_FRAME);
+    }
+    cap->wake       = thread_create_event();
+    cap->writer_tid = thread_create(network_cap_thread, cap);
+
+    return cap;
+}
+
+static void
+network_cap_close(netcap_t *cap)
+{
+    atomic_store(&cap->stop, true);
+    thread_set_event(cap->wake);
+    thread_wait(cap->writer_tid);
+
+    fclose(cap->file);
+    thread_destroy_event(cap->wake);
+    for (int dir = 0; dir < NET_CAP_DIR_MAX; dir++) {
+        for (int i = 0; i < NET_CAP_RING_LEN; i++)
+            free(cap->rings[dir].slots[i].data);
+    }
+    free(cap);
+}
+
 #ifdef _WIN32
 static void
 network_winsock_clean(void)
@@ -230,6 +398,9 @@ network_init(void)
     atexit(network_winsock_clean);
 #endif
 
+    /* Build the slice-by-8 tables the cards use for frame checksums. */
+    crc32speed_init_native();
+
     /* Create a first device entry that's always there, as needed by UI. */
     strcpy(network_devs[0].device, "none");
     strcpy(network_devs[0].description, "None");
@@ -397,10 +568,8 @@ network_rx_queue(void *priv)
     uint32_t rx_bytes = 0;
     for (int i = 0; i < NET_QUEUE_LEN; i++) {
         if (card->queued_pkt.len == 0) {
-            thread_wait_mutex(card->rx_mutex);
-            int res = network_queue_get_swap(&card->queues[NET_QUEUE_RX], &card->queued_pkt);
-            thread_release_mutex(card->rx_mutex);
-            if (!res)
+            /* We are the only RX consumer, so no lock is needed here. */
+            if (!network_queue_get_swap(&card->queues[NET_QUEUE_RX], &card->queued_pkt))
                 break;
         }
 
@@ -412,16 +581,16 @@ network_rx_queue(void *priv)
         card->queued_pkt.len = 0;
     }
 
-    /* Transmission. */
+    /* Transmission. We are the only TX_HOST producer and the host backend
+       thread is its only consumer, so the ring handles the handoff on its
+       own. */
     uint32_t tx_bytes = 0;
-    thread_wait_mutex(card->tx_mutex);
     for (int i = 0; i < NET_QUEUE_LEN; i++) {
         uint32_t bytes = network_queue_move(&card->queues[NET_QUEUE_TX_HOST], &card->queues[NET_QUEUE_TX_VM]);
         if (!bytes)
             break;
         tx_bytes += bytes;
     }
-    thread_release_mutex(card->tx_mutex);
     if (tx_bytes) {
         /* Notify host that a packet is available in the TX queue */
         card->host_drv.notify_in(card->host_drv.priv);
@@ -458,7 +627,6 @@ network_attach(void *card_drv, uint8_t *mac, NETRXCB rx, NETSETLINKSTATE set_lin
     card->card_drv        = card_drv;
     card->rx              = rx;
     card->set_link_state  = set_link_state;
-    card->tx_mutex        = thread_create_mutex();
     card->rx_mutex        = thread_create_mutex();
     card->card_num        = net_card_current;
     card->byte_period     = NET_PERIOD_10M;
@@ -513,7 +681,6 @@ network_attach(void *card_drv, uint8_t *mac, NETRXCB rx, NETSETLINKSTATE set_lin
         // If null fails, something is very wrong
         // Clean up and fatal
         if(!card->host_drv.priv) {
-            thread_close_mutex(card->tx_mutex);
             thread_close_mutex(card->rx_mutex);
             for (int i = 0; i < NET_QUEUE_COUNT; i++) {
                 network_queue_clear(&card->queues[i]);
@@ -528,6 +695,15 @@ network_attach(void *card_drv, uint8_t *mac, NETRXCB rx, NETSETLINKSTATE set_lin
 
     }
 
+    char temp[64];
+    sprintf(temp, "net_%02i_capture", card->card_num + 1);
+    if (config_get_int("Network", temp, 0)) {
+        char def_fn[64];
+        sprintf(temp, "net_%02i_capture_file", card->card_num + 1);
+        sprintf(def_fn, "net_%02i_capture.pcap", card->card_num + 1);
+        card->cap = network_cap_open(config_get_string("Network", temp, def_fn));
+    }
+
     timer_add(&card->timer, network_rx_queue, card, 0);
     timer_on_auto(&card->timer, 100);
 
@@ -540,7 +716,9 @@ netcard_close(netcard_t *card)
     timer_stop(&card->timer);
     card->host_drv.close(card->host_drv.priv);
 
-    thread_close_mutex(card->tx_mutex);
+    if (card->cap)
+        network_cap_close(card->cap);
+
     thread_close_mutex(card->rx_mutex);
     for (int i = 0; i < NET_QUEUE_COUNT; i++) {
         network_queue_clear(&card->queues[i]);
@@ -594,19 +772,49 @@ network_reset(void)
 void
 network_tx(netcard_t *card, uint8_t *bufp, int len)
 {
+    if (card->cap)
+        network_cap_tee(card->cap, NET_CAP_TX, bufp, len);
     network_queue_put(&card->queues[NET_QUEUE_TX_VM], bufp, len);
 }
 
-int
-network_tx_pop(netcard_t *card, netpkt_t *out_pkt)
+/* Reserve the next TX slot so a device can assemble or DMA a frame directly
+ * into the queue buffer instead of staging it elsewhere and copying it with
+ * network_tx(). Returns NULL when the queue is full. Like network_tx(), this
+ * runs on the emulator thread, which is the only accessor of the VM-side TX
+ * queue, so no locking is needed. */
+netpkt_t *
+network_tx_reserve(netcard_t *card)
 {
-    int ret = 0;
+    netqueue_t *queue = &card->queues[NET_QUEUE_TX_VM];
 
-    thread_wait_mutex(card->tx_mutex);
-    ret = network_queue_get_swap(&card->queues[NET_QUEUE_TX_HOST], out_pkt);
-    thread_release_mutex(card->tx_mutex);
+    if (network_queue_full(queue))
+        return NULL;
 
-    return ret;
+    return &queue->packets[queue->head];
+}
+
+/* Queue a frame previously written into the slot from network_tx_reserve(). */
+void
+network_tx_commit(netcard_t *card, int len)
+{
+    netqueue_t *queue = &card->queues[NET_QUEUE_TX_VM];
+
+    if ((len == 0) || (len > NET_MAX_FRAME))
+        return;
+
+    if (card->cap)
+        network_cap_tee(card->cap, NET_CAP_TX, queue->packets[queue->head].data, len);
+
+    queue->packets[queue->head].len = len;
+    queue->head                     = (queue->head + 1) & NET_QUEUE_LEN_MASK;
+}
+
+/* The host backend thread is the only TX_HOST consumer, so popping runs
+   lock-free against the emulator thread filling the ring. */
+int
+network_tx_pop(netcard_t *card, netpkt_t *out_pkt)
+{
+    return network_queue_get_swap(&card->queues[NET_QUEUE_TX_HOST], out_pkt);
 }
 
 int
@@ -615,24 +823,42 @@ network_tx_popv(netcard_t *card, netpkt_t *pkt_vec, int vec_size)
     int pkt_count = 0;
 
     netqueue_t *queue = &card->queues[NET_QUEUE_TX_HOST];
-    thread_wait_mutex(card->tx_mutex);
     for (int i = 0; i < vec_size; i++) {
         if (!network_queue_get_swap(queue, pkt_vec))
             break;
         pkt_count++;
         pkt_vec++;
     }
-    thread_release_mutex(card->tx_mutex);
 
     return pkt_count;
 }
 
+/* Install an early acceptance check run on the RX producer side. The card
+   keeps the filter state current on its own register writes; a packet
+   racing a reconfiguration can only be misfiled the way a frame in flight
+   past real hardware being reprogrammed would be. */
+void
+network_set_rx_filter(netcard_t *card, NETRXFILTER rx_filter)
+{
+    card->rx_filter = rx_filter;
+}
+
+/* The rx_mutex only serializes RX producers against each other (the host
+   backend thread and device loopback on the emulator thread); the consumer
+   drains the ring without taking it. */
 int
 network_rx_put(netcard_t *card, uint8_t *bufp, int len)
 {
     int ret = 0;
 
+    if (card->rx_filter && !card->rx_filter(card->card_drv, bufp, len))
+        return 1;
+
     thread_wait_mutex(card->rx_mutex);
+    /* Tee before the put so the capture also shows packets a full RX ring
+       had to drop; rx_mutex keeps the RX capture ring single-producer. */
+    if (card->cap)
+        network_cap_tee(card->cap, NET_CAP_RX, bufp, len);
     ret = network_queue_put(&card->queues[NET_QUEUE_RX], bufp, len);
     thread_release_mutex(card->rx_mutex);
 
@@ -644,7 +870,14 @@ network_rx_put_pkt(netcard_t *card, netpkt_t *pkt)
 {
     int ret = 0;
 
+    if (card->rx_filter && !card->rx_filter(card->card_drv, pkt->data, pkt->len)) {
+        pkt->len = 0;
+        return 1;
+    }
+
     thread_wait_mutex(card->rx_mutex);
+    if (card->cap)
+        network_cap_tee(card->cap, NET_CAP_RX, pkt->data, pkt->len);
     ret = network_queue_put_swap(&card->queues[NET_QUEUE_RX], pkt);
     thread_release_mutex(card->rx_mutex);
 
@@ -59,6 +59,7 @@
 #include <86box/path.h>
 #include <86box/plat.h>
 #include <86box/nvr.h>
+#include <86box/replay.h>
 
 int nvr_dosave; /* NVR is dirty, needs saved */
 
@@ -66,6 +67,33 @@ static int8_t    days_in_month[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 3
 static struct tm intclk;
 static nvr_t    *saved_nvr = NULL;
 
+/* Drift compensation (TIME_SYNC_DRIFT): host wall clock at the last
+   sync and emulated seconds ticked since, compared once per emulated
+   second. When emulation cannot hold real time the guest clock falls
+   behind its own RTC; with drift compensation it is slewed back toward
+   the host's (NTP-disciplined) clock instead of drifting away. */
+#define DRIFT_SLEW_THRESHOLD 2 /* seconds of drift before slewing */
+
+static time_t  drift_host_base  = 0;
+static int64_t drift_guest_secs = 0;
+
+/* NVR-class backing files (EEPROMs and the like) persisted through the
+   deferred save pass: a device that changed its contents hands us a copy
+   and the periodic nvr_save() writes every pending file out in one go,
+   instead of each device synchronously rewriting its file on every write
+   burst. The copy also means a pending save survives the device itself
+   being closed, e.g. across a hard reset. */
+#define NVR_MAXFILES 16
+
+typedef struct nvrfile_t {
+    char     fn[256];
+    uint8_t *data;
+    int      size;
+    int      dirty;
+} nvrfile_t;
+
+static nvrfile_t nvr_files[NVR_MAXFILES];
+
 #ifdef ENABLE_NVR_LOG
 int nvr_do_log = ENABLE_NVR_LOG;
 
@@ -108,11 +136,10 @@ nvr_get_days(int month, int year)
     return (nvr_is_leap(year) ? 29 : 28);
 }
 
-/* One more second has passed, update the internal clock. */
-void
-rtc_tick(void)
+/* Advance the internal clock by one second. */
+static void
+rtc_advance(void)
 {
-    /* Ping the internal clock. */
     if (++intclk.tm_sec == 60) {
         intclk.tm_sec = 0;
         if (++intclk.tm_min == 60) {
@@ -131,6 +158,34 @@ rtc_tick(void)
     }
 }
 
+/* One more second has passed, update the internal clock. */
+void
+rtc_tick(void)
+{
+    int ticks = 1;
+
+    if ((time_sync & TIME_SYNC_ENABLED) && (time_sync & TIME_SYNC_DRIFT) && (drift_host_base != 0)) {
+        time_t  now;
+        int64_t drift;
+
+        (void) time(&now);
+        now   = replay_host_time(now);
+        drift = (int64_t) (now - drift_host_base) - drift_guest_secs;
+
+        /* Slew, never step: at most one second gained or lost per
+           emulated second, so guest alarms and timeouts keep passing
+           every value on the way. */
+        if (drift > DRIFT_SLEW_THRESHOLD)
+            ticks = 2;
+        else if (drift < -DRIFT_SLEW_THRESHOLD)
+            ticks = 0;
+    }
+
+    drift_guest_secs += ticks;
+    while (ticks-- > 0)
+        rtc_advance();
+}
+
 /* This is the RTC one-second timer. */
 static void
 onesec_timer(void *priv)
@@ -270,26 +325,100 @@ nvr_set_ven_save(void (*ven_save)(void))
     saved_nvr->ven_save = ven_save;
 }
 
+/* Write an NVR-class file out via a temporary and a rename, so a crash
+   mid-write can never leave a torn backing file behind. */
+static int
+nvr_write_file(const char *fn, const void *data, size_t size)
+{
+    char  path[1024];
+    char  temp_path[1024];
+    FILE *fp;
+
+    strncpy(path, nvr_path((char *) fn), sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+    snprintf(temp_path, sizeof(temp_path), "%s.new", path);
+
+    fp = plat_fopen(temp_path, "wb");
+    if (fp == NULL)
+        return 0;
+    if (fwrite(data, size, 1, fp) != 1) {
+        fclose(fp);
+        plat_remove(temp_path);
+        return 0;
+    }
+    fclose(fp);
+
+    if (plat_rename(temp_path, path)) {
+        plat_remove(temp_path);
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Hand over the new contents of an NVR-class file for the next deferred
+   save pass. Called by the EEPROM devices on every completed write burst;
+   the copy is cheap, the file write is not and is left to nvr_save(). */
+void
+nvr_file_dirty(const char *fn, const void *data, int size)
+{
+    nvrfile_t *file = NULL;
+
+    for (uint8_t i = 0; i < NVR_MAXFILES; i++) {
+        if (nvr_files[i].data != NULL) {
+            if (!strcmp(nvr_files[i].fn, fn) && (nvr_files[i].size == size)) {
+                file = &nvr_files[i];
+                break;
+            }
+        } else if (file == NULL)
+            file = &nvr_files[i];
+    }
+    if (file == NULL)
+        return;
+
+    if (file->data == NULL) {
+        strncpy(file->fn, fn, sizeof(file->fn) - 1);
+        file->size = size;
+        file->data = malloc(size);
+    }
+    memcpy(file->data, data, size);
+
+    file->dirty = 1;
+    nvr_dosave  = 1;
+}
+
+/* Write a pending NVR-class file out immediately; used by device close
+   handlers that cannot wait for the next deferred save pass. */
+void
+nvr_file_sync(const char *fn)
+{
+    for (uint8_t i = 0; i < NVR_MAXFILES; i++) {
+        if ((nvr_files[i].data != NULL) && nvr_files[i].dirty && !strcmp(nvr_files[i].fn, fn)) {
+            if (nvr_write_file(nvr_files[i].fn, nvr_files[i].data, nvr_files[i].size))
+                nvr_files[i].dirty = 0;
+        }
+    }
+}
+
 /* Save the current NVR to a file. */
 int
 nvr_save(void)
 {
-    const char *path;
-    FILE       *fp;
+    /* Group commit: flush every pending NVR-class file in the same pass. */
+    for (uint8_t i = 0; i < NVR_MAXFILES; i++) {
+        if ((nvr_files[i].data != NULL) && nvr_files[i].dirty) {
+            if (nvr_write_file(nvr_files[i].fn, nvr_files[i].data, nvr_files[i].size))
+                nvr_files[i].dirty = 0;
+        }
+    }
 
     /* Make sure we have been initialized. */
     if (saved_nvr == NULL)
         return 0;
 
     if (saved_nvr->size != 0) {
-        path = nvr_path(saved_nvr->fn);
-        nvr_log("NVR: saving to '%s'\n", path);
-        fp = plat_fopen(path, "wb");
-        if (fp != NULL) {
-            /* Save NVR contents to file. */
-            (void) fwrite(saved_nvr->regs, saved_nvr->size, 1, fp);
-            fclose(fp);
-        }
+        nvr_log("NVR: saving to '%s'\n", nvr_path(saved_nvr->fn));
+        (void) nvr_write_file(saved_nvr->fn, saved_nvr->regs, saved_nvr->size);
     }
 
     if (saved_nvr->ven_save)
@@ -315,6 +444,7 @@ nvr_time_sync(void)
 
     /* Get the current time of day, and convert to local time. */
     (void) time(&now);
+    now = replay_host_time(now);
     if (time_sync & TIME_SYNC_UTC)
         tm = gmtime(&now);
     else
@@ -322,6 +452,10 @@ nvr_time_sync(void)
 
     /* Set the internal clock. */
     nvr_time_set(tm);
+
+    /* Re-baseline the drift compensation. */
+    drift_host_base  = now;
+    drift_guest_secs = 0;
 }
 
 /* Get current time from internal clock. */
@@ -323,6 +323,12 @@ typedef struct local_t {
     uint64_t   rtc_time;
     pc_timer_t update_timer;
     pc_timer_t rtc_timer;
+
+    /* Lazy periodic mode (PIE clear): no timer runs at the periodic
+       rate; pt_base is the cycle count at the current phase origin and
+       the PF bit is derived from it when register C is read. */
+    int      pt_lazy;
+    uint64_t pt_base;
 } local_t;
 
 static uint8_t nvr_at_inited = 0;
@@ -507,6 +513,7 @@ timer_load_count(nvr_t *nvr)
     local_t *local = (local_t *) nvr->data;
 
     timer_disable(&local->rtc_timer);
+    local->pt_lazy = 0;
 
     if ((nvr->regs[RTC_REGA] & 0x70) != 0x20) {
         local->state = 0;
@@ -518,17 +525,45 @@ timer_load_count(nvr_t *nvr)
     switch (c) {
         case 0:
             local->state = 0;
-            break;
+            return;
         case 1:
         case 2:
             local->count = 1 << (c + 6);
-            timer_set_delay_u64(&local->rtc_timer, (local->count) * RTCCONST);
             break;
         default:
             local->count = 1 << (c - 1);
-            timer_set_delay_u64(&local->rtc_timer, (local->count) * RTCCONST);
             break;
     }
+
+    /* With PIE clear the periodic tick only has to keep the PF bit
+       honest, which rtc_lazy_pf() derives from the cycle counter when
+       register C is read - no timer runs at the periodic rate. NT-class
+       guests program 1024 Hz here and poll, so this removes their top
+       timer source. */
+    if (!(nvr->regs[RTC_REGB] & REGB_PIE)) {
+        local->pt_base = tsc;
+        local->pt_lazy = 1;
+    } else
+        timer_set_delay_u64(&local->rtc_timer, (local->count) * RTCCONST);
+}
+
+/* Fold the periodic ticks that elapsed while no timer was running into
+   the PF bit, keeping the phase origin on a period boundary. */
+static void
+rtc_lazy_pf(nvr_t *nvr)
+{
+    local_t *local  = (local_t *) nvr->data;
+    uint64_t period = ((uint64_t) local->count * RTCCONST) >> 32;
+    uint64_t elapsed;
+
+    if (!local->pt_lazy || (local->state != 1) || (period == 0))
+        return;
+
+    elapsed = tsc - local->pt_base;
+    if (elapsed >= period) {
+        nvr->regs[RTC_REGC] |= REGC_PF;
+        local->pt_base += (elapsed / period) * period;
+    }
 }
 
 static void
@@ -615,6 +650,13 @@ nvr_reg_write(uint16_t reg, uint8_t val, void *priv)
             }
 
             nvr->regs[RTC_REGB] = val;
+            if ((old ^ val) & REGB_PIE) {
+                /* Materialize any lazily accrued PF first, so enabling
+                   PIE right after a poll cannot lose a tick, then
+                   switch between the lazy and the armed modes. */
+                rtc_lazy_pf(nvr);
+                timer_load_count(nvr);
+            }
             timer_update_irq(nvr);
             break;
 
@@ -708,6 +750,7 @@ nvr_read(uint16_t addr, void *priv)
                 break;
 
             case RTC_REGC:
+                rtc_lazy_pf(nvr);
                 ret = nvr->regs[RTC_REGC] & (REGC_IRQF | REGC_PF | REGC_AF | REGC_UF);
                 nvr->regs[RTC_REGC] &= ~(REGC_IRQF | REGC_PF | REGC_AF | REGC_UF);
                 timer_update_irq(nvr);
@@ -1023,6 +1066,9 @@ nvr_at_reset(void *priv)
     /* These bits are reset on reset. */
     nvr->regs[RTC_REGB] &= ~(REGB_PIE | REGB_AIE | REGB_UIE | REGB_SQWE);
     nvr->regs[RTC_REGC] &= ~(REGC_PF | REGC_AF | REGC_UF | REGC_IRQF);
+
+    /* PIE was just cleared: drop back to the lazy periodic mode. */
+    timer_load_count(nvr);
 }
 
 static void *
@@ -1143,7 +1189,6 @@ nvr_at_init(const device_t *info)
         if ((nvr->regs[RTC_REGA] & 0x70) == 0x00)
             nvr->regs[RTC_REGA] = (nvr->regs[RTC_REGA] & 0x8f) | 0x20;
         nvr_at_reset(nvr);
-        timer_load_count(nvr);
 
         /* Set up the I/O handler for this device. */
         if (info->local == 8) {
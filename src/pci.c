@@ -94,8 +94,36 @@ static int         pci_key;
 static int         pci_trc_reg = 0;
 static uint32      pci_enable = 0x00000000;
 
+/* Cached result of the bus -> index -> slot resolution for the currently
+   addressed device. Guest configuration scans hit the same device with long
+   runs of byte accesses, so resolving the mapping tables once per addressed
+   device instead of once per byte takes the lookups off the hot path. */
+static int         pci_slot_cache_bus  = -1;
+static int         pci_slot_cache_card = -1;
+static uint8_t     pci_slot_cache      = PCI_CARD_INVALID;
+
 static void        pci_reset_regs(void);
 
+static void
+pci_slot_cache_flush(void)
+{
+    pci_slot_cache_bus  = -1;
+    pci_slot_cache_card = -1;
+    pci_slot_cache      = PCI_CARD_INVALID;
+}
+
+static uint8_t
+pci_resolve_slot(void)
+{
+    if ((pci_bus != pci_slot_cache_bus) || (pci_card != pci_slot_cache_card)) {
+        pci_slot_cache_bus  = pci_bus;
+        pci_slot_cache_card = pci_card;
+        pci_slot_cache      = pci_card_to_slot_mapping[pci_bus_number_to_index_mapping[pci_bus]][pci_card];
+    }
+
+    return pci_slot_cache;
+}
+
 #ifdef ENABLE_PCI_LOG
 int pci_do_log = ENABLE_PCI_LOG;
 
@@ -235,6 +263,7 @@ static void
 pci_clear_slot(int card)
 {
     pci_card_to_slot_mapping[pci_cards[card].bus][pci_cards[card].id] = PCI_CARD_INVALID;
+    pci_slot_cache_flush();
 
     pci_cards[card].id   = 0xff;
     pci_cards[card].type = 0xff;
@@ -276,6 +305,8 @@ pci_relocate_slot(int type, int new_slot)
 
     if (pci_card_to_slot_mapping[0][new_slot] == PCI_CARD_INVALID)
         pci_card_to_slot_mapping[0][new_slot] = card;
+
+    pci_slot_cache_flush();
 }
 
 /* Write PCI enable/disable key, split for the ALi M1435. */
@@ -332,7 +363,7 @@ pci_reg_write(uint16_t port, uint8_t val)
         pci_index = port & 0xfc;
     }
 
-    slot = pci_card_to_slot_mapping[pci_bus_number_to_index_mapping[pci_bus]][pci_card];
+    slot = pci_resolve_slot();
     if (slot != PCI_CARD_INVALID) {
         if (pci_cards[slot].write)
             pci_cards[slot].write(pci_func, pci_index | (port & 0x03), val, pci_cards[slot].priv);
@@ -542,7 +573,7 @@ pci_reg_read(uint16_t port)
         pci_index = port & 0xfc;
     }
 
-    slot = pci_card_to_slot_mapping[pci_bus_number_to_index_mapping[pci_bus]][pci_card];
+    slot = pci_resolve_slot();
     if (slot != PCI_CARD_INVALID) {
         if (pci_cards[slot].read)
             ret = pci_cards[slot].read(pci_func, pci_index | (port & 0x03), pci_cards[slot].priv);
@@ -684,6 +715,8 @@ pci_remap_bus(uint8_t bus_index, uint8_t bus_number)
 
     if ((bus_number > 0) && (bus_number < 0xff))
         pci_bus_number_to_index_mapping[bus_number] = bus_index;
+
+    pci_slot_cache_flush();
 }
 
 void
@@ -702,6 +735,7 @@ pci_register_bus_slot(int bus, int card, int type, int inta, int intb, int intc,
     dev->write                          = NULL;
     dev->priv                           = NULL;
     pci_card_to_slot_mapping[bus][card] = last_pci_card;
+    pci_slot_cache_flush();
 
     pci_log("pci_register_slot(): pci_cards[%i].bus = %02X; .id = %02X\n", last_pci_card, bus, card);
 
@@ -0,0 +1,62 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Always-on hot-path performance counters. The counting sites
+ *          (recompiler, address lookup fills, timer dispatch) increment
+ *          plain fields in perfc; once per emulated second the totals
+ *          are formatted into the status bar when the display is enabled
+ *          and reset. Unlike minitrace, this needs no rebuild and costs
+ *          one increment per event when the display is off.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/ui.h>
+#include <86box/perfstats.h>
+
+perf_counters_t perfc;
+
+int perfstats_on = 0;
+
+static int perfstats_was_on = 0;
+
+/* Called from the 1-second title refresh timer. */
+void
+perfstats_onesec(int cur_fps)
+{
+    char temp[256];
+
+    if (perfstats_on) {
+        snprintf(temp, sizeof(temp),
+                 "%.2f MIPS, %d fps, p50 %d%% p99 %d%%, %" PRIu64 " blk/s, %" PRIu64 " loop/s, %" PRIu64 " evict/s, %" PRIu64 " lookup/s, %" PRIu64 " timer/s",
+                 (double) perfc.insns / 1000000.0, cur_fps,
+                 pc_speed_p50, pc_speed_p99,
+                 perfc.blocks_compiled, perfc.blocks_unrolled, perfc.blocks_deleted,
+                 perfc.lookup_fills, perfc.timer_fires);
+        ui_sb_set_text(temp);
+    } else if (perfstats_was_on) {
+        /* Display was just turned off - clear our line from the status bar. */
+        ui_sb_set_text(NULL);
+    }
+
+    perfstats_was_on = perfstats_on;
+
+    memset(&perfc, 0x00, sizeof(perf_counters_t));
+}
@@ -65,6 +65,28 @@ static uint16_t latched_irqs   = 0x0000;
 
 static void (*update_pending)(void);
 
+int pic_pending_dirty = 0;
+
+/* Run the deferred priority resolver pass. Called from the CPU cores'
+   interrupt poll (through pic_irq_pending()) and from the few places in
+   here that consume the resolved state themselves. */
+void
+pic_update_pending(void)
+{
+    pic_pending_dirty = 0;
+    update_pending();
+}
+
+/* Record that the resolver has to run again before the pending state is
+   next consumed. Devices hammering an IRQ line (serial FIFOs, sound DMA)
+   thus cost a flag write per line change instead of a full cascade
+   resolution. */
+static __inline void
+pic_mark_pending(void)
+{
+    pic_pending_dirty = 1;
+}
+
 #ifdef ENABLE_PIC_LOG
 int pic_do_log = ENABLE_PIC_LOG;
 
@@ -246,7 +268,7 @@ pic_update_pending_at(void)
 static void
 pic_callback(void *priv)
 {
-    update_pending();
+    pic_update_pending();
 }
 
 void
@@ -275,6 +297,8 @@ pic_reset(void)
 
     smi_irq_mask = smi_irq_status = 0x0000;
 
+    pic_pending_dirty = 0;
+
     shadow  = 0;
     pic_pci = 0;
 }
@@ -357,7 +381,7 @@ pic_action(pic_t *dev, uint8_t irq, uint8_t eoi, uint8_t rotate)
         if (rotate)
             dev->priority = (irq + 1) & 7;
 
-        update_pending();
+        pic_mark_pending();
     }
 }
 
@@ -455,6 +479,10 @@ pic_read(uint16_t addr, void *priv)
 {
     pic_t *dev = (pic_t *) priv;
 
+    /* Poll mode and IRR reads consume the resolved state. */
+    if (pic_pending_dirty)
+        pic_update_pending();
+
     if (shadow) {
         /* VIA PIC shadow read */
         if (addr & 0x0001)
@@ -478,7 +506,7 @@ pic_read(uint16_t addr, void *priv)
                 dev->data_bus = 0x80 | (dev->interrupt & 7);
                 pic_acknowledge(dev);
                 dev->int_pending = 0;
-                update_pending();
+                pic_mark_pending();
             } else
                 dev->data_bus = 0x00;
             dev->ocw3 &= ~0x04;
@@ -530,7 +558,7 @@ pic_write(uint16_t addr, uint8_t val, void *priv)
             case STATE_NONE:
                 dev->imr = val;
                 if (is286)
-                    update_pending();
+                    pic_mark_pending();
                 else
                     timer_on_auto(&pic_timer, .0 * ((10000000.0 * (double) xt_cpu_multi) / (double) cpu_s->rspeed));
                 break;
@@ -560,7 +588,7 @@ pic_write(uint16_t addr, uint8_t val, void *priv)
             dev->interrupt                                = 0x17;
             dev->int_pending                              = 0x00;
             dev->state                                    = STATE_ICW2;
-            update_pending();
+            pic_mark_pending();
         } else if (val & 0x08) {
             dev->ocw3 = val;
             if (dev->ocw3 & 0x04)
@@ -772,7 +800,7 @@ picint_common(uint16_t num, int level, int set, uint8_t *irq_state)
             }
         }
 
-        update_pending();
+        pic_mark_pending();
     }
 }
 
@@ -831,6 +859,9 @@ pic_irq_ack(void)
 {
     uint8_t ret;
 
+    if (pic_pending_dirty)
+        pic_update_pending();
+
     /* Needed for Xi8088. */
     if ((pic.ack_bytes == 0) && pic.int_pending && pic_slave_on(&pic, pic.interrupt)) {
         if (!pic.slaves[pic.interrupt]->int_pending) {
@@ -850,7 +881,7 @@ pic_irq_ack(void)
         if (pic.interrupt & 0x40)
             pic2.interrupt = 0x17;
         pic.interrupt = 0x17;
-        update_pending();
+        pic_mark_pending();
     }
 
     return ret;
@@ -861,6 +892,9 @@ picinterrupt(void)
 {
     int ret = -1;
 
+    if (pic_pending_dirty)
+        pic_update_pending();
+
     if (pic.int_pending) {
         if (pic_slave_on(&pic, pic.interrupt)) {
             if (!pic.slaves[pic.interrupt]->int_pending) {
@@ -892,7 +926,7 @@ picinterrupt(void)
             if (pic.interrupt & 0x40)
                 pic2.interrupt = 0x17;
             pic.interrupt = 0x17;
-            update_pending();
+            pic_mark_pending();
         }
     }
 
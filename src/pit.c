@@ -303,6 +303,184 @@ ctr_tick(ctr_t *ctr)
     }
 }
 
+/* The timer no longer fires once per half input clock: from a falling edge,
+   pit_timer_over() derives how many full clocks can pass on every counter
+   with nothing but count decrements - no output transitions, no reloads, no
+   state changes - and sleeps across all of them in one timer event.  The
+   skipped decrements are folded into the counters lazily, either when the
+   batch ends or when the guest touches the device mid-batch, so reads and
+   latches still see cycle-exact counts. */
+#define PIT_SKIP_MAX 0xffff
+
+/* How many full input clocks ctr_tick() would spend purely decrementing this
+   counter.  Anything the per-clock machine reacts to - BCD carries, pending
+   latches or reloads, counts about to run out - returns 0 so those clocks
+   are stepped one at a time. */
+static uint32_t
+ctr_safe_clocks(const ctr_t *ctr)
+{
+    int count = ctr->count;
+
+    if (ctr->bcd || ctr->latch || ctr->newcount || ((ctr->state & 0x03) == 0x01))
+        return 0;
+
+    switch (ctr->m) {
+        case 0:
+        case 1:
+            /* Terminal count / one-shot: OUT goes high when the count runs
+               out in state 2. */
+            if (ctr->state == 2) {
+                if ((ctr->m == 0) && !ctr->gate)
+                    return PIT_SKIP_MAX;
+                return (count >= 2) ? (uint32_t) (count - 1) : 0;
+            }
+            return PIT_SKIP_MAX;
+
+        case 2:
+            /* Rate generator: OUT pulses when the count reaches 1. */
+            if (ctr->state == 2) {
+                if (!ctr->gate)
+                    return PIT_SKIP_MAX;
+                return (count >= 3) ? (uint32_t) (count - 2) : 0;
+            }
+            return 0; /* State 3 reloads on the next clock. */
+
+        case 3:
+            /* Square wave: OUT toggles when the count runs out. */
+            if ((ctr->state != 2) && (ctr->state != 3))
+                return PIT_SKIP_MAX;
+            if (!ctr->gate)
+                return PIT_SKIP_MAX;
+            return (count >= 2) ? (uint32_t) (count >> 1) : 0;
+
+        case 4:
+        case 5:
+            /* Strobe: OUT pulses when the count runs out in state 2. */
+            if ((ctr->m == 4) && !ctr->gate)
+                return PIT_SKIP_MAX;
+            if (ctr->state == 2)
+                return (count >= 2) ? (uint32_t) (count - 1) : 0;
+            if (ctr->state == 3)
+                return 0; /* Strobe ends on the next clock. */
+            return PIT_SKIP_MAX;
+
+        default:
+            return 0;
+    }
+}
+
+/* Apply n skipped clocks to a counter.  This mirrors exactly what n calls of
+   ctr_tick() would have done, which the ctr_safe_clocks() guarantee reduces
+   to a plain subtraction. */
+static void
+ctr_skip_clocks(ctr_t *ctr, uint32_t n)
+{
+    if (n == 0)
+        return;
+
+    switch (ctr->m) {
+        case 0:
+            if ((ctr->state == 2) && ctr->gate && (ctr->count >= 1))
+                ctr->count -= (int) n;
+            else if (ctr->state == 3)
+                ctr->count = (ctr->count - (int) n) & 0xffff;
+            break;
+        case 1:
+            if ((ctr->state == 2) && (ctr->count >= 1))
+                ctr->count -= (int) n;
+            else if ((ctr->state == 3) || (ctr->state == 6))
+                ctr->count = (ctr->count - (int) n) & 0xffff;
+            break;
+        case 2:
+            if ((ctr->state == 2) && ctr->gate && (ctr->count >= 2))
+                ctr->count -= (int) n;
+            break;
+        case 3:
+            if (((ctr->state == 2) || (ctr->state == 3)) && ctr->gate)
+                ctr->count -= (int) (n << 1);
+            break;
+        case 4:
+        case 5:
+            if (ctr->gate || (ctr->m != 4)) {
+                if ((ctr->state == 0) || (ctr->state == 6))
+                    ctr->count = (ctr->count - (int) n) & 0xffff;
+                else if ((ctr->state == 2) && (ctr->count >= 1))
+                    ctr->count -= (int) n;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static uint32_t
+pit_safe_clocks(pit_t *dev)
+{
+    uint32_t safe = PIT_SKIP_MAX;
+    uint32_t s;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        if (!dev->counters[i].using_timer)
+            continue;
+        s = ctr_safe_clocks(&dev->counters[i]);
+        if (s < safe)
+            safe = s;
+    }
+
+    return safe;
+}
+
+/* Fold the first 'clocks' clocks of the current batch into the counters. */
+static void
+pit_batch_fold(pit_t *dev, uint32_t clocks)
+{
+    uint32_t n;
+
+    if (clocks > dev->skip_clocks)
+        clocks = dev->skip_clocks;
+    if (clocks <= dev->skip_folded)
+        return;
+
+    n = clocks - dev->skip_folded;
+    for (uint8_t i = 0; i < 3; i++) {
+        if (dev->counters[i].using_timer)
+            ctr_skip_clocks(&dev->counters[i], n);
+    }
+    dev->skip_folded = clocks;
+}
+
+/* The guest is about to read or reprogram the device mid-batch: fold in the
+   clocks that have already elapsed so it sees exact counts, and end the
+   batch at the next clock edge since its safety analysis no longer holds. */
+static void
+pit_batch_sync(pit_t *dev)
+{
+    uint64_t half = PITCONST >> 1ULL;
+    uint64_t remaining;
+    uint64_t elapsed;
+    uint64_t halves;
+    uint64_t boundary;
+
+    if (dev->skip_clocks == 0)
+        return;
+
+    remaining = timer_get_remaining_u64(&dev->callback_timer);
+    elapsed   = (remaining < dev->skip_len) ? (dev->skip_len - remaining) : 0;
+    halves    = elapsed / half;
+
+    pit_batch_fold(dev, (uint32_t) (halves >> 1));
+    dev->skip_clocks = 0;
+    dev->skip_folded = 0;
+
+    /* Wake at the next rising edge so the normal per-edge machinery takes
+       over from there. */
+    boundary = halves | 1ULL;
+    if ((boundary * half) <= elapsed)
+        boundary += 2ULL;
+    timer_set_delay_u64(&dev->callback_timer, (boundary * half) - elapsed);
+}
+
 static void
 ctr_clock(void *data, int counter_id)
 {
@@ -432,6 +610,8 @@ pit_ctr_set_gate(void *data, int counter_id, int gate)
     pit_t *pit = (pit_t *) data;
     ctr_t *ctr = &pit->counters[counter_id];
 
+    pit_batch_sync(pit);
+
     int     old  = ctr->gate;
     uint8_t mode = ctr->m & 3;
 
@@ -503,22 +683,37 @@ pit_ctr_set_using_timer(void *data, int counter_id, int using_timer)
 {
     if (tsc > 0)
         timer_process();
-    pit_t *pit       = (pit_t *) data;
-    ctr_t *ctr       = &pit->counters[counter_id];
+    pit_t *pit = (pit_t *) data;
+    ctr_t *ctr = &pit->counters[counter_id];
+
+    pit_batch_sync(pit);
     ctr->using_timer = using_timer;
 }
 
 static void
 pit_timer_over(void *priv)
 {
-    pit_t *dev = (pit_t *) priv;
+    pit_t   *dev = (pit_t *) priv;
+    uint32_t skip;
+
+    /* Close out the batch that just elapsed. */
+    pit_batch_fold(dev, dev->skip_clocks);
+    dev->skip_clocks = 0;
+    dev->skip_folded = 0;
 
     dev->clock ^= 1;
 
     for (uint8_t i = 0; i < 3; i++)
         pit_ctr_set_clock_common(&dev->counters[i], dev->clock);
 
-    timer_advance_u64(&dev->callback_timer, PITCONST >> 1ULL);
+    /* From a falling edge, sleep across every clock that is guaranteed to
+       pass without an event; rising edges only matter while a counter sits
+       in state 1, which ctr_safe_clocks() treats as unsafe. */
+    skip = dev->clock ? 0 : pit_safe_clocks(dev);
+
+    dev->skip_clocks = skip;
+    dev->skip_len    = (PITCONST >> 1ULL) * (uint64_t) ((skip << 1) + 1);
+    timer_advance_u64(&dev->callback_timer, dev->skip_len);
 }
 
 static void
@@ -530,6 +725,8 @@ pit_write(uint16_t addr, uint8_t val, void *priv)
 
     pit_log("[%04X:%08X] pit_write(%04X, %02X, %08X)\n", CS, cpu_state.pc, addr, val, priv);
 
+    pit_batch_sync(dev);
+
     switch (addr & 3) {
         case 3: /* control */
             t = val >> 6;
@@ -682,6 +879,8 @@ pit_read(uint16_t addr, void *priv)
     int     t = (addr & 3);
     ctr_t  *ctr;
 
+    pit_batch_sync(dev);
+
     switch (addr & 3) {
         case 3: /* Control. */
             /* This is 8254-only, 8253 returns 0x00. */
@@ -801,6 +1000,9 @@ pit_speaker_timer(int new_out, UNUSED(int old_out))
         speakon = new_out;
 
     ppispeakon = new_out;
+
+    /* Record the new output level with its timestamp. */
+    speaker_update();
 }
 
 void
@@ -859,15 +1061,12 @@ pit_close(void *priv)
 
     if (dev == pit_devs[1].data)
         pit_devs[1].data = NULL;
-
-    if (dev != NULL)
-        free(dev);
 }
 
 static void *
 pit_init(const device_t *info)
 {
-    pit_t *dev = (pit_t *) malloc(sizeof(pit_t));
+    pit_t *dev = (pit_t *) device_calloc(1, sizeof(pit_t));
     pit_reset(dev);
 
     if (!(dev->flags & PIT_PS2) && !(dev->flags & PIT_CUSTOM_CLOCK)) {
@@ -663,15 +663,12 @@ pitf_close(void *priv)
 
     if (dev == pit_devs[1].data)
         pit_devs[1].data = NULL;
-
-    if (dev != NULL)
-        free(dev);
 }
 
 static void *
 pitf_init(const device_t *info)
 {
-    pitf_t *dev = (pitf_t *) malloc(sizeof(pitf_t));
+    pitf_t *dev = (pitf_t *) device_calloc(1, sizeof(pitf_t));
     pitf_reset(dev);
 
     dev->flags = info->local;
@@ -70,6 +70,7 @@ port_6x_write(uint16_t port, uint8_t val, void *priv)
             if (speaker_enable)
                 was_speaker_enable = 1;
             pit_devs[0].set_gate(pit_devs[0].data, 2, val & 1);
+            speaker_update();
 
             if (dev->flags & PORT_6X_TURBO)
                 xi8088_turbo_set(!!(val & 0x04));
@@ -0,0 +1,124 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          POST fast-forward mode. Started from the command line
+ *          (--postff secs), it keeps one save state per configuration
+ *          next to the config file, named after a hash of the config
+ *          contents. The first hard reset runs the full BIOS POST and
+ *          captures the state 'secs' emulated seconds in; every later
+ *          hard reset restores that state instead of re-running POST.
+ *          Any configuration change gives a different hash, so a stale
+ *          state is simply never looked up again, and savestate_load()
+ *          itself refuses states taken on a different machine or memory
+ *          size. Meant for automated runs that reset the same machine
+ *          many times; 'secs' must be long enough for POST (and any
+ *          memory test) to have finished on the machine in question.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/timer.h>
+#include <86box/path.h>
+#include <86box/plat.h>
+#include <86box/savestate.h>
+#include <86box/postff.h>
+
+int postff_on = 0;
+
+static int        postff_secs      = 0;
+static int        postff_countdown = 0;
+static char       postff_path[1024];
+static pc_timer_t postff_timer;
+
+void
+postff_start(int seconds)
+{
+    postff_secs = seconds;
+    postff_on   = 1;
+}
+
+/* FNV-1a over the config file contents; any hardware change rewrites the
+   config, so it changes the hash and with it the state file looked up. */
+static uint32_t
+postff_config_hash(void)
+{
+    uint32_t hash = 0x811c9dc5;
+    uint8_t  buf[4096];
+    size_t   n;
+    FILE    *fp;
+
+    fp = plat_fopen(cfg_path, "rb");
+    if (fp == NULL)
+        return hash;
+
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            hash ^= buf[i];
+            hash *= 0x01000193;
+        }
+    }
+    fclose(fp);
+
+    return hash;
+}
+
+static void
+postff_tick(void *priv)
+{
+    (void) priv;
+
+    if (--postff_countdown > 0) {
+        timer_on_auto(&postff_timer, 1000000.0);
+        return;
+    }
+
+    if (savestate_save(postff_path))
+        pclog("POSTFF: post-POST state captured to \"%s\"\n", postff_path);
+}
+
+/* Called on every hard reset, once the machine has been reinitialized. */
+void
+postff_machine_init(void)
+{
+    char  temp[64];
+    FILE *fp;
+
+    if (!postff_on)
+        return;
+
+    sprintf(temp, "post_%08x.86ss", postff_config_hash());
+    path_append_filename(postff_path, usr_path, temp);
+
+    fp = plat_fopen(postff_path, "rb");
+    if (fp != NULL) {
+        fclose(fp);
+        if (savestate_load(postff_path)) {
+            pclog("POSTFF: POST fast-forwarded from \"%s\"\n", postff_path);
+            return;
+        }
+        /* Stale or foreign state - drop it and recapture. */
+        plat_remove(postff_path);
+    }
+
+    postff_countdown = postff_secs;
+    timer_add(&postff_timer, postff_tick, NULL, 0);
+    timer_on_auto(&postff_timer, 1000000.0);
+}
@@ -65,6 +65,7 @@
 #include <86box/pit.h>
 #include <86box/path.h>
 #include <86box/plat.h>
+#include <86box/thread.h>
 #include <86box/ui.h>
 #include <86box/lpt.h>
 #include <86box/video.h>
@@ -251,6 +252,12 @@ typedef struct escp_t {
     uint8_t ctrl;
 
     PALETTE palcol;
+
+    /* deferred page writer */
+    thread_t *dump_thread;
+    uint8_t  *dump_pixels; /* spare page buffer handed to the writer */
+    char      dump_path[2048];
+    PALETTE   dump_palcol;
 } escp_t;
 
 static void
@@ -346,15 +353,49 @@ escp_log(const char *fmt, ...)
 #    define escp_log(fmt, ...)
 #endif
 
+/* Worker for dump_page(): encoding a full page to PNG takes long enough
+   to stall emulation, so it runs on its own thread with a snapshot of
+   the page. */
+static void
+dump_page_thread(void *priv)
+{
+    escp_t *dev = (escp_t *) priv;
+
+    png_write_rgb(dev->dump_path, dev->dump_pixels, dev->page->w, dev->page->h, dev->page->pitch, dev->dump_palcol);
+}
+
 /* Dump the current page into a formatted file. */
 static void
 dump_page(escp_t *dev)
 {
-    char path[1024];
+    uint8_t *pixels;
+
+    /* Let the previous page finish writing before reusing its buffer. */
+    if (dev->dump_thread != NULL) {
+        thread_wait(dev->dump_thread);
+        dev->dump_thread = NULL;
+    }
+
+    if (dev->dump_pixels == NULL)
+        dev->dump_pixels = (uint8_t *) malloc((size_t) dev->page->pitch * dev->page->h);
+
+    strcpy(dev->dump_path, dev->pagepath);
+    strcat(dev->dump_path, dev->page_fn);
+
+    if (dev->dump_pixels == NULL) {
+        /* No spare buffer - write synchronously. */
+        png_write_rgb(dev->dump_path, dev->page->pixels, dev->page->w, dev->page->h, dev->page->pitch, dev->palcol);
+        return;
+    }
 
-    strcpy(path, dev->pagepath);
-    strcat(path, dev->page_fn);
-    png_write_rgb(path, dev->page->pixels, dev->page->w, dev->page->h, dev->page->pitch, dev->palcol);
+    /* Hand the finished page to the writer and continue printing on the
+       spare buffer; the callers clear it before drawing anything. */
+    pixels            = dev->page->pixels;
+    dev->page->pixels = dev->dump_pixels;
+    dev->dump_pixels  = pixels;
+    memcpy(dev->dump_palcol, dev->palcol, sizeof(PALETTE));
+
+    dev->dump_thread = thread_create(dump_page_thread, dev);
 }
 
 static void
@@ -2049,6 +2090,12 @@ escp_close(void *priv)
         if (dev->page->dirty)
             dump_page(dev);
 
+        /* Wait for the page writer before freeing its buffers. */
+        if (dev->dump_thread != NULL)
+            thread_wait(dev->dump_thread);
+        if (dev->dump_pixels != NULL)
+            free(dev->dump_pixels);
+
         if (dev->page->pixels != NULL)
             free(dev->page->pixels);
         free(dev->page);
@@ -30,6 +30,7 @@
 #include <86box/path.h>
 #include <86box/plat.h>
 #include <86box/plat_dynld.h>
+#include <86box/thread.h>
 #include <86box/ui.h>
 #include <86box/prt_devs.h>
 
@@ -81,6 +82,10 @@ typedef struct ps_t {
 
     char   buffer[POSTSCRIPT_BUFFER_LENGTH];
     size_t buffer_pos;
+
+    /* background PDF conversion */
+    thread_t *conv_thread;
+    char      conv_filename[260];
 } ps_t;
 
 typedef struct gsapi_revision_s {
@@ -140,7 +145,7 @@ pulse_timer(void *priv)
 }
 
 static int
-convert_to_pdf(ps_t *dev)
+convert_to_pdf(ps_t *dev, const char *filename)
 {
     volatile int code;
     void        *instance = NULL;
@@ -150,7 +155,7 @@ convert_to_pdf(ps_t *dev)
 
     strcpy(input_fn, dev->printer_path);
     path_slash(input_fn);
-    strcat(input_fn, dev->filename);
+    strcat(input_fn, filename);
 
     strcpy(output_fn, input_fn);
     strcpy(output_fn + strlen(output_fn) - 3, ".pdf");
@@ -189,6 +194,22 @@ convert_to_pdf(ps_t *dev)
     return code;
 }
 
+/* Worker for the finished-job conversion: Ghostscript can take minutes
+   on large jobs, so it must not run on the emulation thread. */
+static void
+convert_to_pdf_thread(void *priv)
+{
+    ps_t *dev = (ps_t *) priv;
+    char  status[512];
+
+    if (convert_to_pdf(dev, dev->conv_filename) == 0)
+        sprintf(status, "PostScript printer: print job converted to PDF");
+    else
+        sprintf(status, "PostScript printer: PDF conversion failed, PostScript file kept");
+
+    ui_sb_set_text(status);
+}
+
 static void
 write_buffer(ps_t *dev, bool finish)
 {
@@ -219,8 +240,15 @@ write_buffer(ps_t *dev, bool finish)
     dev->buffer_pos = 0;
 
     if (finish) {
-        if (ghostscript_handle != NULL)
-            convert_to_pdf(dev);
+        if (ghostscript_handle != NULL) {
+            /* One conversion at a time; a new job ending while the
+               previous one still converts waits here. */
+            if (dev->conv_thread != NULL)
+                thread_wait(dev->conv_thread);
+
+            strcpy(dev->conv_filename, dev->filename);
+            dev->conv_thread = thread_create(convert_to_pdf_thread, dev);
+        }
 
         dev->filename[0] = 0;
     }
@@ -388,6 +416,10 @@ ps_close(void *priv)
     if (dev->buffer[0] != 0)
         write_buffer(dev, true);
 
+    /* Drain the converter before unloading Ghostscript. */
+    if (dev->conv_thread != NULL)
+        thread_wait(dev->conv_thread);
+
     if (ghostscript_handle != NULL) {
         dynld_close(ghostscript_handle);
         ghostscript_handle = NULL;
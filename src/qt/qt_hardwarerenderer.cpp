@@ -220,6 +220,14 @@ HardwareRenderer::onBlit(int buf_idx, int x, int y, int w, int h)
     if (memcmp(&tval, &nuldata, sizeof(void *)) == 0)
         return;
     auto origSource = source;
+
+    /* A newer frame is already queued behind this one; drop it and recycle
+       its buffer so a UI-thread hitch never backs up the blitter thread. */
+    if (blitsQueued.fetch_sub(1) > 1) {
+        buf_usage[buf_idx].clear();
+        return;
+    }
+
     if (!m_texture || !m_texture->isCreated()) {
         buf_usage[buf_idx].clear();
         source.setRect(x, y, w, h);
@@ -263,8 +271,8 @@ HardwareRenderer::getBuffers()
 {
     std::vector<std::tuple<uint8_t *, std::atomic_flag *>> buffers;
 
-    buffers.push_back(std::make_tuple(imagebufs[0].get(), &buf_usage[0]));
-    buffers.push_back(std::make_tuple(imagebufs[1].get(), &buf_usage[1]));
+    for (size_t i = 0; i < imagebufs.size(); i++)
+        buffers.push_back(std::make_tuple(imagebufs[i].get(), &buf_usage[i]));
 
     return buffers;
 }
@@ -59,12 +59,14 @@ public:
         : QOpenGLWindow(QOpenGLWindow::NoPartialUpdate, parent->windowHandle())
         , QOpenGLFunctions()
     {
-        imagebufs[0] = std::unique_ptr<uint8_t>(new uint8_t[2048 * 2048 * 4]);
-        imagebufs[1] = std::unique_ptr<uint8_t>(new uint8_t[2048 * 2048 * 4]);
-
-        buf_usage = std::vector<std::atomic_flag>(2);
-        buf_usage[0].clear();
-        buf_usage[1].clear();
+        /* Triple buffering: the blitter thread always has a free buffer to
+           copy into while the UI thread holds one in the event queue and
+           uploads another. */
+        buf_usage = std::vector<std::atomic_flag>(imagebufs.size());
+        for (size_t i = 0; i < imagebufs.size(); i++) {
+            imagebufs[i] = std::unique_ptr<uint8_t>(new uint8_t[2048 * 2048 * 4]);
+            buf_usage[i].clear();
+        }
 
         setMinimumSize(QSize(16, 16));
         setFlags(Qt::FramelessWindowHint);
@@ -96,7 +98,7 @@ public slots:
     void onBlit(int buf_idx, int x, int y, int w, int h);
 
 protected:
-    std::array<std::unique_ptr<uint8_t>, 2> imagebufs;
+    std::array<std::unique_ptr<uint8_t>, 3> imagebufs;
 
     void resizeEvent(QResizeEvent *event) override;
     bool event(QEvent *event) override;
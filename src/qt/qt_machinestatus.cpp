@@ -250,6 +250,10 @@ struct MachineStatus::States {
     std::array<StateEmptyActive, NET_CARD_MAX> net;
     std::unique_ptr<ClickableLabel>            sound;
     std::unique_ptr<QLabel>                    text;
+
+    /* Last value of machine_status_changes() consumed by refreshIcons();
+       ~0 forces a full rescan on the next tick. */
+    uint32_t lastChange = ~0u;
 };
 
 MachineStatus::MachineStatus(QObject *parent)
@@ -372,6 +376,13 @@ MachineStatus::refreshIcons()
     if (!update_icons)
         return;
 
+    /* Devices bump the change counter whenever they push new state; skip
+       the rescan while it still matches what we last consumed. */
+    uint32_t changes = machine_status_changes();
+    if (changes == d->lastChange)
+        return;
+    d->lastChange = changes;
+
     for (size_t i = 0; i < FDD_NUM; ++i) {
         d->fdd[i].setActive(machine_status.fdd[i].active);
         d->fdd[i].setEmpty(machine_status.fdd[i].empty);
@@ -425,6 +436,9 @@ MachineStatus::clearActivity()
 void
 MachineStatus::refresh(QStatusBar *sbar)
 {
+    /* The widgets are about to be rebuilt; force a rescan on the next tick. */
+    d->lastChange = ~0u;
+
     bool has_mfm  = machine_has_flags(machine, MACHINE_MFM) > 0;
     bool has_xta  = machine_has_flags(machine, MACHINE_XTA) > 0;
     bool has_esdi = machine_has_flags(machine, MACHINE_ESDI) > 0;
@@ -52,6 +52,7 @@ extern "C" {
 #include <86box/86box.h>
 #include <86box/config.h>
 #include <86box/plat.h>
+#include <86box/timer.h>
 #include <86box/ui.h>
 #include <86box/video.h>
 #ifdef DISCORD
@@ -111,7 +112,7 @@ main_thread_fn()
         old_time = new_time;
         if (drawits > 0 && !dopause) {
             /* Yes, so do one frame now. */
-            drawits -= 10;
+            drawits -= pc_slice_ms;
             if (drawits > 50)
                 drawits = 0;
 
@@ -140,7 +141,15 @@ main_thread_fn()
             /* Just so we dont overload the host OS. */
             if (dopause)
                 ack_pause();
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            /* Sleep no longer than the next emulated deadline, so the
+               wakeup has work waiting for it instead of going back to
+               sleep after a no-op pass through the loop. */
+            double deadline_us = dopause ? -1.0 : timer_next_deadline_us();
+            if ((deadline_us < 0.0) || (deadline_us > 1000.0))
+                deadline_us = 1000.0;
+            else if (deadline_us < 100.0)
+                deadline_us = 100.0;
+            std::this_thread::sleep_for(std::chrono::microseconds((int64_t) deadline_us));
         }
     }
 
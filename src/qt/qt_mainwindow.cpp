@@ -63,6 +63,11 @@ extern int qt_nvr_save(void);
 #ifdef MTR_ENABLED
 #    include <minitrace/minitrace.h>
 #endif
+
+#include <86box/guest_profiler.h>
+#include <86box/memtrace.h>
+#include <86box/perfstats.h>
+#include <86box/savestate.h>
 };
 
 #include <QGuiApplication>
@@ -659,6 +664,47 @@ MainWindow::MainWindow(QWidget *parent)
     }
 #endif
 
+    {
+        ui->actionEnd_guest_profile->setDisabled(true);
+        connect(ui->actionBegin_guest_profile, &QAction::triggered, this, [this] {
+            if (guest_profiler_on)
+                return;
+            ui->actionBegin_guest_profile->setDisabled(true);
+            ui->actionEnd_guest_profile->setDisabled(false);
+            guest_profiler_start("guest_profile.folded");
+        });
+        connect(ui->actionEnd_guest_profile, &QAction::triggered, this, [this] {
+            if (!guest_profiler_on)
+                return;
+            ui->actionBegin_guest_profile->setDisabled(false);
+            ui->actionEnd_guest_profile->setDisabled(true);
+            guest_profiler_stop();
+        });
+
+        connect(ui->actionPerformance_counters, &QAction::triggered, this, [] (bool checked) {
+            perfstats_on = checked ? 1 : 0;
+        });
+
+        connect(ui->actionSave_state, &QAction::triggered, this, [] {
+            int currentPause = dopause;
+            plat_pause(1);
+            savestate_save("savestate.86ss");
+            plat_pause(currentPause);
+        });
+        connect(ui->actionLoad_state, &QAction::triggered, this, [] {
+            int currentPause = dopause;
+            plat_pause(1);
+            savestate_load("savestate.86ss");
+            plat_pause(currentPause);
+        });
+        connect(ui->actionMemory_trace, &QAction::triggered, this, [] (bool checked) {
+            if (checked)
+                memtrace_start("memtrace.bin");
+            else
+                memtrace_stop();
+        });
+    }
+
     setContextMenuPolicy(Qt::PreventContextMenu);
     /* Remove default Shift+F10 handler, which unfocuses keyboard input even with no context menu. */
     connect(new QShortcut(QKeySequence(Qt::SHIFT + Qt::Key_F10), this), &QShortcut::activated, this, [](){});
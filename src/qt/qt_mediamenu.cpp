@@ -644,8 +644,9 @@ MediaMenu::zipMount(int i, const QString &filename, bool wp)
     zip_drives[i].read_only = wp;
     if (!filename.isEmpty()) {
         QByteArray filenameBytes = filename.toUtf8();
-        zip_load(dev, filenameBytes.data());
-        zip_insert(dev);
+        /* Validation and spin-up run on a worker thread; the emulated
+           drive reports "becoming ready" until the mount completes. */
+        zip_load_async(dev, filenameBytes.data());
     }
 
     ui_sb_update_icon_state(SB_ZIP | i, filename.isEmpty() ? 1 : 0);
@@ -757,8 +758,9 @@ MediaMenu::moMount(int i, const QString &filename, bool wp)
     mo_drives[i].read_only = wp;
     if (!filename.isEmpty()) {
         QByteArray filenameBytes = filename.toUtf8();
-        mo_load(dev, filenameBytes.data());
-        mo_insert(dev);
+        /* Validation and spin-up run on a worker thread; the emulated
+           drive reports "becoming ready" until the mount completes. */
+        mo_load_async(dev, filenameBytes.data());
     }
 
     ui_sb_update_icon_state(SB_MO | i, filename.isEmpty() ? 1 : 0);
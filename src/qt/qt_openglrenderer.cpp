@@ -429,6 +429,13 @@ OpenGLRenderer::getBuffers()
 void
 OpenGLRenderer::onBlit(int buf_idx, int x, int y, int w, int h)
 {
+    /* A newer frame is already queued behind this one; drop it and recycle
+       its buffer so a UI-thread hitch never backs up the blitter thread. */
+    if (blitsQueued.fetch_sub(1) > 1) {
+        buf_usage[buf_idx].clear();
+        return;
+    }
+
     if (notReady())
         return;
 
@@ -52,6 +52,8 @@
 #ifdef Q_OS_UNIX
 #    include <pthread.h>
 #    include <sys/mman.h>
+#    include <fcntl.h>
+#    include <unistd.h>
 #endif
 
 #if 0
@@ -340,6 +342,20 @@ plat_remove(char *path)
     QFile(path).remove();
 }
 
+int
+plat_rename(char *oldpath, char *newpath)
+{
+    /* QFile::rename() refuses to overwrite; the NVR layer relies on an
+       atomic replace, so use the native primitives directly. */
+#if defined Q_OS_WINDOWS
+    return !MoveFileExW((LPCWSTR) QString::fromUtf8(oldpath).utf16(),
+                        (LPCWSTR) QString::fromUtf8(newpath).utf16(),
+                        MOVEFILE_REPLACE_EXISTING);
+#else
+    return rename(oldpath, newpath);
+#endif
+}
+
 void *
 plat_mmap(size_t size, uint8_t executable)
 {
@@ -355,6 +371,33 @@ plat_mmap(size_t size, uint8_t executable)
 #endif
 }
 
+void *
+plat_mmap_huge(size_t size, uint8_t executable)
+{
+#if defined Q_OS_WINDOWS
+    SIZE_T large_page = GetLargePageMinimum();
+
+    if (large_page == 0)
+        return nullptr;
+
+    /* Large-page allocations require a size that is a multiple of the
+       large page and the SeLockMemoryPrivilege; fail gracefully so the
+       caller can fall back to plat_mmap(). */
+    size = (size + (large_page - 1)) & ~(large_page - 1);
+
+    return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, executable ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE);
+#elif defined Q_OS_UNIX
+#    ifdef MAP_HUGETLB
+    void *ret = mmap(0, size, PROT_READ | PROT_WRITE | (executable ? PROT_EXEC : 0), MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    return (ret == MAP_FAILED) ? nullptr : ret;
+#    else
+    (void) size;
+    (void) executable;
+    return nullptr;
+#    endif
+#endif
+}
+
 void
 plat_munmap(void *ptr, size_t size)
 {
@@ -365,6 +408,89 @@ plat_munmap(void *ptr, size_t size)
 #endif
 }
 
+/* Map a file into memory as a shared read/write mapping, growing it to
+   'size' bytes; other processes mapping the same file see the writes. */
+void *
+plat_mmap_file(const char *path, size_t size)
+{
+#if defined Q_OS_WINDOWS
+    HANDLE file;
+    HANDLE mapping;
+    void  *view;
+
+    file = CreateFileW((LPCWSTR) QString::fromUtf8(path).utf16(),
+                       GENERIC_READ | GENERIC_WRITE,
+                       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                       OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    /* The mapping object grows the file to 'size' bytes. */
+    mapping = CreateFileMappingW(file, NULL, PAGE_READWRITE,
+                                 (DWORD) ((uint64_t) size >> 32),
+                                 (DWORD) (size & 0xffffffff), NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    /* The view keeps both handles alive until it is unmapped. */
+    CloseHandle(mapping);
+    CloseHandle(file);
+
+    return view;
+#else
+    void *ret;
+    int   fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+        return nullptr;
+
+    if (ftruncate(fd, (off_t) size) < 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    ret = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* The mapping keeps the file open. */
+    close(fd);
+
+    return (ret == MAP_FAILED) ? nullptr : ret;
+#endif
+}
+
+void
+plat_munmap_file(void *ptr, size_t size)
+{
+#if defined Q_OS_WINDOWS
+    (void) size;
+    UnmapViewOfFile(ptr);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+/* Tell the OS the range will not be touched for a while, so it can be
+   reclaimed under memory pressure; the contents stay valid and fault back
+   in on the next access. Advisory only - a no-op where unsupported. */
+void
+plat_memory_cold(void *ptr, size_t size)
+{
+#if defined Q_OS_WINDOWS
+    /* VirtualUnlock on an unlocked range drops it from the working set
+       onto the standby list. */
+    VirtualUnlock(ptr, size);
+#elif defined MADV_COLD
+    madvise(ptr, size, MADV_COLD);
+#elif defined MADV_PAGEOUT
+    madvise(ptr, size, MADV_PAGEOUT);
+#else
+    (void) ptr;
+    (void) size;
+#endif
+}
+
 void
 plat_pause(int p)
 {
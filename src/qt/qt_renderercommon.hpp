@@ -38,6 +38,11 @@ public:
     virtual bool hasBlitFunc() { return false; }
     virtual void blit(int x, int y, int w, int h) { }
 
+    /* Frames handed over by the blitter thread but not yet consumed on the
+       UI thread. When this is above 1 in onBlit(), a newer frame is already
+       queued behind the one being processed and the renderer may drop it. */
+    std::atomic<int> blitsQueued { 0 };
+
     int      r_monitor_index = 0;
 
 protected:
@@ -444,6 +444,11 @@ RendererStack::createRenderer(Renderer renderer)
 
     currentBuf = 0;
 
+    /* Tell the frame pacing logic how fast the host display this monitor
+       sits on can actually present. */
+    if (screen() != nullptr)
+        video_host_refresh_rate_monitor(screen()->refreshRate(), m_monitor_index);
+
     if (rendererWindow->hasBlitFunc()) {
         connect(this, &RendererStack::blit, this, &RendererStack::blitRenderer, Qt::DirectConnection);
     } else {
@@ -490,15 +495,39 @@ RendererStack::blitCommon(int x, int y, int w, int h)
     sw = this->w = w;
     sh = this->h       = h;
     uint8_t *imagebits = std::get<uint8_t *>(imagebufs[currentBuf]);
-    for (int y1 = y; y1 < (y + h); y1++) {
-        auto scanline = imagebits + (y1 * rendererWindow->getBytesPerRow()) + (x * 4);
-        video_copy(scanline, &(monitors[m_monitor_index].target_buffer->line[y1][x]), w * 4);
+
+    /* Limit the copy to the area this buffer is out of date on: the dirty
+       rectangles reported since it was last filled. A buffer that has never
+       been filled (or a blit rectangle change) forces a full copy. */
+    int dx;
+    int dy;
+    int dw;
+    int dh;
+    video_blit_take_dirty_rect_monitor(&dx, &dy, &dw, &dh, m_monitor_index);
+
+    const QRect blitRect(x, y, w, h);
+    if ((staleRects.size() != imagebufs.size()) || (blitRect != lastBlitRect)) {
+        staleRects.assign(imagebufs.size(), blitRect);
+        lastBlitRect = blitRect;
+    }
+
+    const QRect frameDirty = QRect(dx, dy, dw, dh) & blitRect;
+    for (auto &stale : staleRects)
+        stale |= frameDirty;
+
+    const QRect copyRect      = staleRects[currentBuf] & blitRect;
+    staleRects[currentBuf] = QRect();
+
+    for (int y1 = copyRect.top(); y1 <= copyRect.bottom(); y1++) {
+        auto scanline = imagebits + (y1 * rendererWindow->getBytesPerRow()) + (copyRect.left() * 4);
+        video_copy(scanline, &(monitors[m_monitor_index].target_buffer->line[y1][copyRect.left()]), copyRect.width() * 4);
     }
 
     if (monitors[m_monitor_index].mon_screenshots) {
         video_screenshot_monitor((uint32_t *) imagebits, x, y, 2048, m_monitor_index);
     }
     video_blit_complete_monitor(m_monitor_index);
+    rendererWindow->blitsQueued.fetch_add(1);
     emit blitToRenderer(currentBuf, sx, sy, sw, sh);
     currentBuf = (currentBuf + 1) % imagebufs.size();
 }
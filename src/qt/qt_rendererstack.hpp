@@ -111,6 +111,11 @@ private:
 
     std::vector<std::tuple<uint8_t *, std::atomic_flag *>> imagebufs;
 
+    /* Area of the emulator's target buffer each image buffer is missing;
+       partial copies only have to cover this plus the frame's dirty rect. */
+    std::vector<QRect> staleRects;
+    QRect              lastBlitRect;
+
     RendererCommon          *rendererWindow { nullptr };
     std::unique_ptr<QWidget> current;
     std::atomic<bool>        directBlitting { false };
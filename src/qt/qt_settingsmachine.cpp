@@ -48,6 +48,10 @@ SettingsMachine::SettingsMachine(QWidget *parent)
 {
     ui->setupUi(this);
 
+    /* Re-probe ROM availability once per dialog; every filter pass below
+       then hits the cache. */
+    machine_available_flush();
+
     switch (time_sync) {
         case TIME_SYNC_ENABLED:
             ui->radioButtonLocalTime->setChecked(true);
@@ -37,12 +37,14 @@ SoftwareRenderer::SoftwareRenderer(QWidget *parent)
 {
     RendererCommon::parentWidget = parent;
 
-    images[0] = std::make_unique<QImage>(QSize(2048, 2048), QImage::Format_RGB32);
-    images[1] = std::make_unique<QImage>(QSize(2048, 2048), QImage::Format_RGB32);
-
-    buf_usage = std::vector<std::atomic_flag>(2);
-    buf_usage[0].clear();
-    buf_usage[1].clear();
+    /* Triple buffering: the blitter thread always has a free image to copy
+       into while the UI thread holds one for display and another sits in
+       the event queue. */
+    buf_usage = std::vector<std::atomic_flag>(images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        images[i] = std::make_unique<QImage>(QSize(2048, 2048), QImage::Format_RGB32);
+        buf_usage[i].clear();
+    }
 #ifdef __HAIKU__
     this->setMouseTracking(true);
 #endif
@@ -65,8 +67,18 @@ SoftwareRenderer::onBlit(int buf_idx, int x, int y, int w, int h)
         return;
     auto origSource = source;
 
+    /* A newer frame is already queued behind this one; drop it and recycle
+       its buffer so a UI-thread hitch never backs up the blitter thread. */
+    if (blitsQueued.fetch_sub(1) > 1) {
+        buf_usage[buf_idx].clear();
+        return;
+    }
+
     cur_image = buf_idx;
-    buf_usage[(buf_idx + 1) % 2].clear();
+    for (size_t i = 0; i < buf_usage.size(); i++) {
+        if ((int) i != buf_idx)
+            buf_usage[i].clear();
+    }
 
     source.setRect(x, y, w, h);
 
@@ -113,7 +125,23 @@ SoftwareRenderer::onPaint(QPaintDevice *device)
     painter.fillRect(0, 0, device->width(), device->height(), Qt::black);
 #endif
     painter.setCompositionMode(QPainter::CompositionMode_Plus);
-    painter.drawImage(destination, *images[cur_image], source);
+    if (destination.size() == source.size()) {
+        painter.drawImage(destination, *images[cur_image], source);
+    } else {
+        /* Prescale on the band-parallel scaler instead of letting the
+           raster paint engine walk the frame pixel by pixel. */
+        const QImage &img = *images[cur_image];
+
+        if (!scaled || (scaled->size() != destination.size()))
+            scaled = std::make_unique<QImage>(destination.size(), QImage::Format_RGB32);
+
+        video_scaler_blit((uint32_t *) scaled->bits(), scaled->bytesPerLine() / 4,
+                          destination.width(), destination.height(),
+                          (const uint32_t *) img.constBits(), img.bytesPerLine() / 4,
+                          source.x(), source.y(), source.width(), source.height(),
+                          video_filter_method > 0 ? 1 : 0);
+        painter.drawImage(destination.topLeft(), *scaled);
+    }
     if (video_fullscreen && status_icons_fullscreen) drawStatusBarIcons(&painter);
 }
 
@@ -122,8 +150,8 @@ SoftwareRenderer::getBuffers()
 {
     std::vector<std::tuple<uint8_t *, std::atomic_flag *>> buffers;
 
-    buffers.push_back(std::make_tuple(images[0]->bits(), &buf_usage[0]));
-    buffers.push_back(std::make_tuple(images[1]->bits(), &buf_usage[1]));
+    for (size_t i = 0; i < images.size(); i++)
+        buffers.push_back(std::make_tuple(images[i]->bits(), &buf_usage[i]));
 
     return buffers;
 }
@@ -27,7 +27,8 @@ public slots:
     void onBlit(int buf_idx, int x, int y, int w, int h);
 
 protected:
-    std::array<std::unique_ptr<QImage>, 2> images;
+    std::array<std::unique_ptr<QImage>, 3> images;
+    std::unique_ptr<QImage>                scaled;
     int                                    cur_image = -1;
 
     void onPaint(QPaintDevice *device);
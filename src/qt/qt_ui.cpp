@@ -228,6 +228,15 @@ ui_sb_set_ready(int ready)
     }
 }
 
+/* Store a pushed status bit and bump the change counter only on an actual
+   transition, so repeated identical pushes keep the UI tick idle. */
+static void
+ui_sb_status_flag(atomic_bool_t &flag, bool b)
+{
+    if (flag.exchange(b) != b)
+        machine_status_mark();
+}
+
 void
 ui_sb_update_icon_state(int tag, int state)
 {
@@ -235,27 +244,27 @@ ui_sb_update_icon_state(int tag, int state)
     int item     = tag & 0xf;
     switch (category) {
         case SB_CASSETTE:
-            machine_status.cassette.empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.cassette.empty, state > 0);
             break;
         case SB_CARTRIDGE:
-            machine_status.cartridge[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.cartridge[item].empty, state > 0);
             break;
         case SB_FLOPPY:
-            machine_status.fdd[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.fdd[item].empty, state > 0);
             break;
         case SB_CDROM:
-            machine_status.cdrom[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.cdrom[item].empty, state > 0);
             break;
         case SB_ZIP:
-            machine_status.zip[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.zip[item].empty, state > 0);
             break;
         case SB_MO:
-            machine_status.mo[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.mo[item].empty, state > 0);
             break;
         case SB_HDD:
             break;
         case SB_NETWORK:
-            machine_status.net[item].empty = state > 0 ? true : false;
+            ui_sb_status_flag(machine_status.net[item].empty, state > 0);
             break;
         case SB_SOUND:
             break;
@@ -275,22 +284,22 @@ ui_sb_update_icon(int tag, int active)
         case SB_CARTRIDGE:
             break;
         case SB_FLOPPY:
-            machine_status.fdd[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.fdd[item].active, active > 0);
             break;
         case SB_CDROM:
-            machine_status.cdrom[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.cdrom[item].active, active > 0);
             break;
         case SB_ZIP:
-            machine_status.zip[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.zip[item].active, active > 0);
             break;
         case SB_MO:
-            machine_status.mo[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.mo[item].active, active > 0);
             break;
         case SB_HDD:
-            machine_status.hdd[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.hdd[item].active, active > 0);
             break;
         case SB_NETWORK:
-            machine_status.net[item].active = active > 0 ? true : false;
+            ui_sb_status_flag(machine_status.net[item].active, active > 0);
             break;
         case SB_SOUND:
             break;
@@ -103,11 +103,29 @@ joystick_get_axis(int joystick_nr, int mapping)
     } else
         return plat_joystick_state[joystick_nr].a[plat_joystick_state[joystick_nr].axis[mapping].id];
 }
+/* Everything the guest-visible remap below depends on: the raw device
+   state plus the user's mapping. When none of it changed since the last
+   poll, the remap (POV trigonometry included) can be skipped. */
+typedef struct joystick_snapshot_t {
+    int a[8];
+    int b[32];
+    int p[4];
+    int plat_joystick_nr;
+    int axis_mapping[8];
+    int button_mapping[32];
+    int pov_mapping[4][2];
+} joystick_snapshot_t;
+
 void
 joystick_process()
 {
+    static joystick_snapshot_t last_state[MAX_PLAT_JOYSTICKS > MAX_JOYSTICKS ? MAX_PLAT_JOYSTICKS : MAX_JOYSTICKS];
+    static int                 last_valid = 0;
+    static int                 last_type  = 0;
+
     int c;
     int d;
+    int changed;
 
     if (!joystick_type)
         return;
@@ -131,6 +149,29 @@ joystick_process()
         //                pclog("joystick %i - x=%i y=%i b[0]=%i b[1]=%i  %i\n", c, joystick_state[c].x, joystick_state[c].y, joystick_state[c].b[0], joystick_state[c].b[1], joysticks_present);
     }
 
+    changed = !last_valid || (joystick_type != last_type);
+    last_type = joystick_type;
+    for (c = 0; c < joysticks_present; c++) {
+        if (memcmp(last_state[c].a, plat_joystick_state[c].a, sizeof(last_state[c].a)) || memcmp(last_state[c].b, plat_joystick_state[c].b, sizeof(last_state[c].b)) || memcmp(last_state[c].p, plat_joystick_state[c].p, sizeof(last_state[c].p))) {
+            memcpy(last_state[c].a, plat_joystick_state[c].a, sizeof(last_state[c].a));
+            memcpy(last_state[c].b, plat_joystick_state[c].b, sizeof(last_state[c].b));
+            memcpy(last_state[c].p, plat_joystick_state[c].p, sizeof(last_state[c].p));
+            changed = 1;
+        }
+    }
+    for (c = 0; c < joystick_get_max_joysticks(joystick_type); c++) {
+        if ((last_state[c].plat_joystick_nr != joystick_state[c].plat_joystick_nr) || memcmp(last_state[c].axis_mapping, joystick_state[c].axis_mapping, sizeof(last_state[c].axis_mapping)) || memcmp(last_state[c].button_mapping, joystick_state[c].button_mapping, sizeof(last_state[c].button_mapping)) || memcmp(last_state[c].pov_mapping, joystick_state[c].pov_mapping, sizeof(last_state[c].pov_mapping))) {
+            last_state[c].plat_joystick_nr = joystick_state[c].plat_joystick_nr;
+            memcpy(last_state[c].axis_mapping, joystick_state[c].axis_mapping, sizeof(last_state[c].axis_mapping));
+            memcpy(last_state[c].button_mapping, joystick_state[c].button_mapping, sizeof(last_state[c].button_mapping));
+            memcpy(last_state[c].pov_mapping, joystick_state[c].pov_mapping, sizeof(last_state[c].pov_mapping));
+            changed = 1;
+        }
+    }
+    last_valid = 1;
+    if (!changed)
+        return;
+
     for (c = 0; c < joystick_get_max_joysticks(joystick_type); c++) {
         if (joystick_state[c].plat_joystick_nr) {
             int joystick_nr = joystick_state[c].plat_joystick_nr - 1;
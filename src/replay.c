@@ -0,0 +1,222 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Deterministic input record/replay. Nondeterministic inputs
+ *          are logged with the cycle counter (tsc) as the timestamp:
+ *          keyboard events at the point they enter keyboard_input(),
+ *          and host clock reads when the RTC synchronizes. On playback
+ *          live input is ignored and the logged events are re-injected
+ *          at the same cycle counts, so a run that started from the
+ *          same machine state takes the same execution path - which
+ *          makes slowdowns reproducible and benchmark runs repeatable.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/timer.h>
+#include <86box/keyboard.h>
+#include <86box/plat.h>
+#include <86box/replay.h>
+
+#define REPLAY_MAGIC   0x50523638 /* '86RP' (little endian) */
+#define REPLAY_VERSION 1
+
+/* How often playback checks for due events. */
+#define REPLAY_POLL_USEC 250.0
+
+enum {
+    REPLAY_EV_KEY = 1,
+    REPLAY_EV_TIME
+};
+
+typedef struct replay_event_t {
+    uint64_t tsc;
+    uint16_t type;
+    uint16_t down;
+    uint32_t scan;
+    int64_t  data;
+} replay_event_t;
+
+typedef struct replay_header_t {
+    uint32_t magic;
+    uint32_t version;
+} replay_header_t;
+
+int replay_mode      = REPLAY_OFF;
+int replay_injecting = 0;
+
+static FILE           *replay_fp     = NULL;
+static replay_event_t *replay_events = NULL;
+static int             replay_count  = 0;
+static int             replay_cur    = 0; /* next scheduled (keyboard) event */
+static int             replay_time_cur = 0; /* next on-demand clock event */
+static pc_timer_t      replay_timer;
+
+void
+replay_start_record(const char *path)
+{
+    replay_header_t hdr;
+
+    replay_fp = plat_fopen(path, "wb");
+    if (replay_fp == NULL) {
+        pclog("REPLAY: unable to open \"%s\" for writing\n", path);
+        return;
+    }
+
+    hdr.magic   = REPLAY_MAGIC;
+    hdr.version = REPLAY_VERSION;
+    fwrite(&hdr, sizeof(hdr), 1, replay_fp);
+
+    replay_mode = REPLAY_RECORD;
+}
+
+void
+replay_start_play(const char *path)
+{
+    replay_header_t hdr;
+    FILE           *fp;
+    long            size;
+
+    fp = plat_fopen(path, "rb");
+    if (fp == NULL) {
+        pclog("REPLAY: unable to open \"%s\"\n", path);
+        return;
+    }
+
+    if ((fread(&hdr, sizeof(hdr), 1, fp) != 1) || (hdr.magic != REPLAY_MAGIC) || (hdr.version != REPLAY_VERSION)) {
+        pclog("REPLAY: \"%s\" is not a version %i recording\n", path, REPLAY_VERSION);
+        fclose(fp);
+        return;
+    }
+
+    (void) fseek(fp, 0, SEEK_END);
+    size = ftell(fp) - sizeof(hdr);
+    (void) fseek(fp, sizeof(hdr), SEEK_SET);
+
+    replay_count  = size / sizeof(replay_event_t);
+    replay_events = (replay_event_t *) malloc(replay_count * sizeof(replay_event_t));
+    if (fread(replay_events, sizeof(replay_event_t), replay_count, fp) != (size_t) replay_count) {
+        pclog("REPLAY: error reading \"%s\"\n", path);
+        free(replay_events);
+        replay_events = NULL;
+        fclose(fp);
+        return;
+    }
+    fclose(fp);
+
+    replay_cur = replay_time_cur = 0;
+    replay_mode = REPLAY_PLAY;
+
+    pclog("REPLAY: replaying %i events from \"%s\"\n", replay_count, path);
+}
+
+static void
+replay_record_event(uint16_t type, uint16_t down, uint32_t scan, int64_t data)
+{
+    replay_event_t ev;
+
+    ev.tsc  = tsc;
+    ev.type = type;
+    ev.down = down;
+    ev.scan = scan;
+    ev.data = data;
+    fwrite(&ev, sizeof(ev), 1, replay_fp);
+}
+
+void
+replay_record_key(int down, uint16_t scan)
+{
+    if (replay_mode == REPLAY_RECORD)
+        replay_record_event(REPLAY_EV_KEY, down ? 1 : 0, scan, 0);
+}
+
+/* RTC synchronization: logged on record, substituted on playback so the
+   guest sees the same wall clock. */
+time_t
+replay_host_time(time_t host)
+{
+    if (replay_mode == REPLAY_RECORD)
+        replay_record_event(REPLAY_EV_TIME, 0, 0, (int64_t) host);
+    else if (replay_mode == REPLAY_PLAY) {
+        while (replay_time_cur < replay_count) {
+            const replay_event_t *ev = &replay_events[replay_time_cur++];
+
+            if (ev->type == REPLAY_EV_TIME)
+                return (time_t) ev->data;
+        }
+    }
+
+    return host;
+}
+
+static void
+replay_poll(void *priv)
+{
+    (void) priv;
+
+    if (replay_mode != REPLAY_PLAY)
+        return;
+
+    while (replay_cur < replay_count) {
+        const replay_event_t *ev = &replay_events[replay_cur];
+
+        if (ev->tsc > tsc)
+            break;
+        replay_cur++;
+
+        if (ev->type == REPLAY_EV_KEY) {
+            replay_injecting = 1;
+            keyboard_input(ev->down, (uint16_t) ev->scan);
+            replay_injecting = 0;
+        }
+    }
+
+    if (replay_cur >= replay_count) {
+        pclog("REPLAY: playback finished\n");
+        replay_mode = REPLAY_OFF;
+        return;
+    }
+
+    timer_on_auto(&replay_timer, REPLAY_POLL_USEC);
+}
+
+/* Called on every hard reset, after the timers have been cleared. */
+void
+replay_machine_init(void)
+{
+    if (replay_mode != REPLAY_PLAY)
+        return;
+
+    timer_add(&replay_timer, replay_poll, NULL, 0);
+    timer_on_auto(&replay_timer, REPLAY_POLL_USEC);
+}
+
+void
+replay_close(void)
+{
+    if ((replay_mode == REPLAY_RECORD) && (replay_fp != NULL)) {
+        fclose(replay_fp);
+        replay_fp = NULL;
+    }
+
+    replay_mode = REPLAY_OFF;
+}
@@ -0,0 +1,257 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Versioned machine save states. The container is a sequence of
+ *          tagged chunks behind a header that pins the format version,
+ *          machine and memory size: the CPU core state, guest RAM, and
+ *          one sub-chunk per device instance that implements the
+ *          save_state/load_state hooks on device_t. Devices without
+ *          hooks are skipped on save and keep their current state on
+ *          load - coverage grows as devices adopt the contract, and a
+ *          chunk whose device is missing is skipped by length, so old
+ *          states stay loadable.
+ *
+ *          Must be called with the emulation thread paused.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/device.h>
+#include <86box/machine.h>
+#include <86box/mem.h>
+#include <86box/plat.h>
+#include <86box/savestate.h>
+
+#define SAVESTATE_MAGIC   0x53533638 /* '86SS' (little endian) */
+/* Version 2: cpu_state_t field order changed (flags/eflags moved ahead
+   of the segment descriptors), so version 1 CPU0 chunks do not load. */
+#define SAVESTATE_VERSION 2
+
+typedef struct sstate_header_t {
+    uint32_t magic;
+    uint32_t version;
+    char     machine[32];
+    uint32_t mem_size; /* in KB */
+} sstate_header_t;
+
+typedef struct sstate_chunk_t {
+    char     id[4];
+    uint32_t len;
+} sstate_chunk_t;
+
+#ifdef ENABLE_SAVESTATE_LOG
+int savestate_do_log = ENABLE_SAVESTATE_LOG;
+
+static void
+savestate_log(const char *fmt, ...)
+{
+    va_list ap;
+
+    if (savestate_do_log) {
+        va_start(ap, fmt);
+        pclog_ex(fmt, ap);
+        va_end(ap);
+    }
+}
+#else
+#    define savestate_log(fmt, ...)
+#endif
+
+/* CPU core state outside of cpu_state proper. */
+typedef struct sstate_cpu_extra_t {
+    uint32_t cr2;
+    uint32_t cr3;
+    uint32_t cr4;
+} sstate_cpu_extra_t;
+
+static void
+sstate_write_chunk(FILE *fp, const char *id, const void *data, uint32_t len)
+{
+    sstate_chunk_t chunk;
+
+    memcpy(chunk.id, id, 4);
+    chunk.len = len;
+    fwrite(&chunk, sizeof(chunk), 1, fp);
+    if (len > 0)
+        fwrite(data, 1, len, fp);
+}
+
+static void
+sstate_write_ram(FILE *fp)
+{
+    sstate_chunk_t chunk;
+    uint32_t       total = mem_size << 10;
+
+    memcpy(chunk.id, "RAM0", 4);
+    chunk.len = total;
+    fwrite(&chunk, sizeof(chunk), 1, fp);
+
+    if (total > (1 << 30)) {
+        fwrite(ram, 1, 1 << 30, fp);
+        fwrite(ram2, 1, total - (1 << 30), fp);
+    } else
+        fwrite(ram, 1, total, fp);
+}
+
+static int
+sstate_read_ram(FILE *fp, uint32_t len)
+{
+    uint32_t total = mem_size << 10;
+
+    if (len != total)
+        return 0;
+
+    if (total > (1 << 30)) {
+        if (fread(ram, 1, 1 << 30, fp) != (1 << 30))
+            return 0;
+        if (fread(ram2, 1, total - (1 << 30), fp) != (total - (1 << 30)))
+            return 0;
+    } else if (fread(ram, 1, total, fp) != total)
+        return 0;
+
+    return 1;
+}
+
+int
+savestate_save(const char *path)
+{
+    sstate_header_t    hdr;
+    sstate_cpu_extra_t extra;
+    sstate_chunk_t     chunk;
+    FILE              *fp;
+    long               dev_start;
+    long               dev_end;
+
+    fp = plat_fopen(path, "wb");
+    if (fp == NULL) {
+        pclog("SAVESTATE: unable to open \"%s\" for writing\n", path);
+        return 0;
+    }
+
+    memset(&hdr, 0x00, sizeof(hdr));
+    hdr.magic   = SAVESTATE_MAGIC;
+    hdr.version = SAVESTATE_VERSION;
+    strncpy(hdr.machine, machine_get_internal_name(), sizeof(hdr.machine) - 1);
+    hdr.mem_size = mem_size;
+    fwrite(&hdr, sizeof(hdr), 1, fp);
+
+    sstate_write_chunk(fp, "CPU0", &cpu_state, sizeof(cpu_state));
+
+    extra.cr2 = cr2;
+    extra.cr3 = cr3;
+    extra.cr4 = cr4;
+    sstate_write_chunk(fp, "CPUX", &extra, sizeof(extra));
+
+    sstate_write_ram(fp);
+
+    /* Device sub-chunks; the length is back-patched once the hooks have
+       written their payloads. */
+    memcpy(chunk.id, "DEV0", 4);
+    chunk.len = 0;
+    fwrite(&chunk, sizeof(chunk), 1, fp);
+    dev_start = ftell(fp);
+    device_state_save(fp);
+    dev_end = ftell(fp);
+    fseek(fp, dev_start - sizeof(uint32_t), SEEK_SET);
+    chunk.len = dev_end - dev_start;
+    fwrite(&chunk.len, sizeof(uint32_t), 1, fp);
+    fseek(fp, dev_end, SEEK_SET);
+
+    fclose(fp);
+
+    savestate_log("SAVESTATE: state written to \"%s\"\n", path);
+
+    return 1;
+}
+
+int
+savestate_load(const char *path)
+{
+    sstate_header_t    hdr;
+    sstate_cpu_extra_t extra;
+    sstate_chunk_t     chunk;
+    FILE              *fp;
+    int                ret = 1;
+
+    fp = plat_fopen(path, "rb");
+    if (fp == NULL) {
+        pclog("SAVESTATE: unable to open \"%s\"\n", path);
+        return 0;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1) {
+        fclose(fp);
+        return 0;
+    }
+
+    if ((hdr.magic != SAVESTATE_MAGIC) || (hdr.version != SAVESTATE_VERSION)) {
+        pclog("SAVESTATE: \"%s\" is not a version %i state file\n", path, SAVESTATE_VERSION);
+        fclose(fp);
+        return 0;
+    }
+
+    if (strncmp(hdr.machine, machine_get_internal_name(), sizeof(hdr.machine)) || (hdr.mem_size != mem_size)) {
+        pclog("SAVESTATE: \"%s\" was taken on machine \"%s\" with %i KB - not loading\n",
+              path, hdr.machine, hdr.mem_size);
+        fclose(fp);
+        return 0;
+    }
+
+    while (fread(&chunk, sizeof(chunk), 1, fp) == 1) {
+        long next = ftell(fp) + chunk.len;
+
+        if (!memcmp(chunk.id, "CPU0", 4) && (chunk.len == sizeof(cpu_state))) {
+            if (fread(&cpu_state, sizeof(cpu_state), 1, fp) != 1)
+                ret = 0;
+        } else if (!memcmp(chunk.id, "CPUX", 4) && (chunk.len == sizeof(extra))) {
+            if (fread(&extra, sizeof(extra), 1, fp) == 1) {
+                cr2 = extra.cr2;
+                cr3 = extra.cr3;
+                cr4 = extra.cr4;
+            } else
+                ret = 0;
+        } else if (!memcmp(chunk.id, "RAM0", 4)) {
+            if (!sstate_read_ram(fp, chunk.len))
+                ret = 0;
+        } else if (!memcmp(chunk.id, "DEV0", 4)) {
+            if (!device_state_load(fp, chunk.len))
+                ret = 0;
+        } else
+            savestate_log("SAVESTATE: skipping unknown chunk %c%c%c%c\n",
+                          chunk.id[0], chunk.id[1], chunk.id[2], chunk.id[3]);
+
+        fseek(fp, next, SEEK_SET);
+    }
+
+    fclose(fp);
+
+    /* Guest memory changed behind the emulator's back: drop the address
+       lookup caches and any compiled code. */
+    flushmmucache();
+#ifdef USE_DYNAREC
+    if (cpu_use_dynarec)
+        codegen_reset();
+#endif
+
+    savestate_log("SAVESTATE: state restored from \"%s\"\n", path);
+
+    return ret;
+}
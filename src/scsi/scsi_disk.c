@@ -727,12 +727,12 @@ scsi_disk_blocks(scsi_disk_t *dev, int32_t *len, UNUSED(int first_batch), int ou
 
     *len = dev->requested_blocks << 9;
 
-    for (int i = 0; i < dev->requested_blocks; i++) {
-        if (out)
-            hdd_image_write(dev->id, dev->sector_pos + i, 1, dev->temp_buffer + (i << 9));
-        else
-            hdd_image_read(dev->id, dev->sector_pos + i, 1, dev->temp_buffer + (i << 9));
-    }
+    /* The whole phase is serviced from the image in one go - the period for
+       it has already been charged in aggregate by the command callback. */
+    if (out)
+        hdd_image_write(dev->id, dev->sector_pos, dev->requested_blocks, dev->temp_buffer);
+    else
+        hdd_image_read(dev->id, dev->sector_pos, dev->requested_blocks, dev->temp_buffer);
 
     scsi_disk_log("%s %i bytes of blocks...\n", out ? "Written" : "Read", *len);
 
@@ -997,6 +997,24 @@ ncr53c8xx_memcpy(ncr53c8xx_t *dev, uint32_t dest, uint32_t src, int count)
     uint8_t buf[NCR_BUF_SIZE];
 
     ncr53c8xx_log("memcpy dest 0x%08x src 0x%08x count %d\n", dest, src, count);
+
+    /* If both ends of the move are backed by directly addressable memory and
+       neither side is redirected to I/O space, translate once and move the
+       whole block, bypassing the bounce buffer. MMIO targets keep taking the
+       chunked path below, which goes through the mapping handlers. */
+    if (!(dev->dmode & (NCR_DMODE_SIOM | NCR_DMODE_DIOM))) {
+        const uint8_t *sp = mem_get_phys_ptr(src, count, 0);
+        uint8_t       *dp = mem_get_phys_ptr(dest, count, 1);
+
+        if ((sp != NULL) && (dp != NULL)) {
+            mem_logical_addr = 0xffffffff;
+            /* memmove() because SCRIPTS may issue overlapping moves. */
+            memmove(dp, sp, count);
+            mem_invalidate_range(dest, dest + count - 1);
+            return;
+        }
+    }
+
     while (count) {
         n = (count > NCR_BUF_SIZE) ? NCR_BUF_SIZE : count;
         ncr53c8xx_read(dev, src, buf, n);
@@ -1228,20 +1228,14 @@ static void
 x54x_cmd_done(x54x_t *dev, int suppress);
 
 static void
-x54x_cmd_callback(void *priv)
+x54x_cmd_sub_phase(x54x_t *dev)
 {
-    double  period;
-    x54x_t *dev = (x54x_t *) priv;
-
     int mailboxes_present;
     int bios_mailboxes_present;
 
     mailboxes_present      = (!(dev->Status & STAT_INIT) && dev->MailboxInit && dev->MailboxReq);
     bios_mailboxes_present = (dev->ven_callback && dev->BIOSMailboxInit && dev->BIOSMailboxReq);
 
-    dev->temp_period  = 0;
-    dev->media_period = 0.0;
-
     switch (dev->callback_sub_phase) {
         case 0:
             /* Sub-phase 0 - Look for mailbox. */
@@ -1291,6 +1285,29 @@ x54x_cmd_callback(void *priv)
             x54x_log("Invalid sub-phase: %02X\n", dev->callback_sub_phase);
             break;
     }
+}
+
+static void
+x54x_cmd_callback(void *priv)
+{
+    double  period;
+    x54x_t *dev = (x54x_t *) priv;
+    uint8_t prev_sub_phase;
+
+    dev->temp_period  = 0;
+    dev->media_period = 0.0;
+
+    /* Drain the state machine in one activation: chain the sub-phases of a
+       command and loop back to the lookup phase for the next pending
+       mailbox, charging the accumulated period in aggregate afterwards.
+       Completion interrupts coalesce through the pending interrupt logic,
+       which the mailbox protocol permits - the guest rescans the incoming
+       mailbox ring on every interrupt. The loop stops once a lookup finds
+       no work; the guest cannot refill mailboxes while we are in here. */
+    do {
+        prev_sub_phase = dev->callback_sub_phase;
+        x54x_cmd_sub_phase(dev);
+    } while (dev->callback_sub_phase != prev_sub_phase);
 
     period = (1000000.0 / dev->ha_bps) * ((double) dev->temp_period);
     timer_on_auto(&dev->timer, dev->media_period + period + 10.0);
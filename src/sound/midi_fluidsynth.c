@@ -19,7 +19,11 @@
 #include <86box/plat_unused.h>
 
 #define RENDER_RATE                100
-#define BUFFER_SEGMENTS            10
+/* Rendered segments in flight between the synth thread and the audio backend.
+ * The synth thread renders ahead until the ring is full, so one slow render
+ * can be absorbed without a gap, while note-on latency stays bounded by
+ * MIDI_RING_SEGMENTS segments instead of a whole backend buffer. */
+#define MIDI_RING_SEGMENTS         4
 
 /* Check the FluidSynth version to determine wheteher to use the older reverb/chorus
    control functions that were deprecated in 2.2.0, or their newer replacements */
@@ -38,11 +42,16 @@ typedef struct fluidsynth {
 
     thread_t *thread_h;
     event_t  *event, *start_event;
-    int       buf_size;
+    int       seg_size;
     float    *buffer;
     int16_t  *buffer_int16;
     int       midi_pos;
 
+    /* Lock-free single-producer/single-consumer ring of rendered segments:
+     * the synth thread advances ring_head, the poll side advances ring_tail. */
+    volatile uint32_t ring_head;
+    volatile uint32_t ring_tail;
+
     int on;
 } fluidsynth_t;
 
@@ -61,6 +70,17 @@ fluidsynth_poll(void)
     data->midi_pos++;
     if (data->midi_pos == SOUND_FREQ / RENDER_RATE) {
         data->midi_pos = 0;
+
+        /* Hand one pre-rendered segment to the backend, if the synth thread
+         * managed to stay ahead, and wake it up to refill the freed slot. */
+        if (data->ring_head != data->ring_tail) {
+            const uint32_t slot = data->ring_tail % MIDI_RING_SEGMENTS;
+            if (sound_is_float)
+                givealbuffer_midi((uint8_t *) data->buffer + (slot * data->seg_size), data->seg_size / sizeof(float));
+            else
+                givealbuffer_midi((uint8_t *) data->buffer_int16 + (slot * data->seg_size), data->seg_size / sizeof(int16_t));
+            data->ring_tail++;
+        }
         thread_set_event(data->event);
     }
 }
@@ -68,9 +88,7 @@ fluidsynth_poll(void)
 static void
 fluidsynth_thread(void *param)
 {
-    fluidsynth_t *data     = (fluidsynth_t *) param;
-    int           buf_pos  = 0;
-    int           buf_size = data->buf_size / BUFFER_SEGMENTS;
+    fluidsynth_t *data = (fluidsynth_t *) param;
 
     thread_set_event(data->start_event);
 
@@ -78,26 +96,22 @@ fluidsynth_thread(void *param)
         thread_wait_event(data->event, -1);
         thread_reset_event(data->event);
 
-        if (sound_is_float) {
-            float *buf = (float *) ((uint8_t *) data->buffer + buf_pos);
-            memset(buf, 0, buf_size);
-            if (data->synth)
-                fluid_synth_write_float(data->synth, buf_size / (2 * sizeof(float)), buf, 0, 2, buf, 1, 2);
-            buf_pos += buf_size;
-            if (buf_pos >= data->buf_size) {
-                givealbuffer_midi(data->buffer, data->buf_size / sizeof(float));
-                buf_pos = 0;
-            }
-        } else {
-            int16_t *buf = (int16_t *) ((uint8_t *) data->buffer_int16 + buf_pos);
-            memset(buf, 0, buf_size);
-            if (data->synth)
-                fluid_synth_write_s16(data->synth, buf_size / (2 * sizeof(int16_t)), buf, 0, 2, buf, 1, 2);
-            buf_pos += buf_size;
-            if (buf_pos >= data->buf_size) {
-                givealbuffer_midi(data->buffer_int16, data->buf_size / sizeof(int16_t));
-                buf_pos = 0;
+        /* Render ahead until the ring is full, then sleep until the consumer
+         * frees a slot. */
+        while (data->on && ((data->ring_head - data->ring_tail) < MIDI_RING_SEGMENTS)) {
+            const uint32_t slot = data->ring_head % MIDI_RING_SEGMENTS;
+            if (sound_is_float) {
+                float *buf = (float *) ((uint8_t *) data->buffer + (slot * data->seg_size));
+                memset(buf, 0, data->seg_size);
+                if (data->synth)
+                    fluid_synth_write_float(data->synth, data->seg_size / (2 * sizeof(float)), buf, 0, 2, buf, 1, 2);
+            } else {
+                int16_t *buf = (int16_t *) ((uint8_t *) data->buffer_int16 + (slot * data->seg_size));
+                memset(buf, 0, data->seg_size);
+                if (data->synth)
+                    fluid_synth_write_s16(data->synth, data->seg_size / (2 * sizeof(int16_t)), buf, 0, 2, buf, 1, 2);
             }
+            data->ring_head++;
         }
     }
 }
@@ -252,16 +266,16 @@ fluidsynth_init(UNUSED(const device_t *info))
     fluid_settings_getnum(data->settings, "synth.sample-rate", &samplerate);
     data->samplerate = (int) samplerate;
     if (sound_is_float) {
-        data->buf_size     = (data->samplerate / RENDER_RATE) * 2 * sizeof(float) * BUFFER_SEGMENTS;
-        data->buffer       = malloc(data->buf_size);
+        data->seg_size     = (data->samplerate / RENDER_RATE) * 2 * sizeof(float);
+        data->buffer       = malloc(data->seg_size * MIDI_RING_SEGMENTS);
         data->buffer_int16 = NULL;
     } else {
-        data->buf_size     = (data->samplerate / RENDER_RATE) * 2 * sizeof(int16_t) * BUFFER_SEGMENTS;
+        data->seg_size     = (data->samplerate / RENDER_RATE) * 2 * sizeof(int16_t);
         data->buffer       = NULL;
-        data->buffer_int16 = malloc(data->buf_size);
+        data->buffer_int16 = malloc(data->seg_size * MIDI_RING_SEGMENTS);
     }
 
-    al_set_midi(data->samplerate, data->buf_size);
+    al_set_midi(data->samplerate, data->seg_size);
 
     dev = malloc(sizeof(midi_device_t));
     memset(dev, 0, sizeof(midi_device_t));
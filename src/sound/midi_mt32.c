@@ -155,15 +155,113 @@ static event_t  *event       = NULL;
 static event_t  *start_event = NULL;
 static int       mt32_on     = 0;
 
-#define RENDER_RATE     100
-#define BUFFER_SEGMENTS 10
+#define RENDER_RATE 100
+/* Rendered segments in flight between the synth thread and the audio backend.
+ * The synth thread renders ahead until the ring is full, so one slow render
+ * can be absorbed without a gap, while note-on latency stays bounded by
+ * MIDI_RING_SEGMENTS segments instead of a whole backend buffer. */
+#define MIDI_RING_SEGMENTS 4
 
 static uint32_t samplerate   = 44100;
-static int      buf_size     = 0;
+static int      seg_size     = 0;
 static float   *buffer       = NULL;
 static int16_t *buffer_int16 = NULL;
 static int      midi_pos     = 0;
 
+/* Lock-free single-producer/single-consumer ring of rendered segments:
+ * the synth thread advances ring_head, the poll side advances ring_tail. */
+static volatile uint32_t ring_head = 0;
+static volatile uint32_t ring_tail = 0;
+
+/* Parallel partial rendering: a small worker pool splits the LA32 partials
+ * across threads inside the synth's render pass, each worker accumulating
+ * into its own buffers which the synth thread then sums into the target
+ * streams. Serial rendering (1 thread) keeps the stock 16-bit renderer. */
+#define MT32_MAX_RENDER_THREADS 4
+/* Matches MT32EMU_MAX_SAMPLES_PER_RUN - the dispatcher is never handed a longer run. */
+#define MT32_MAX_RUN_SAMPLES 4096
+
+typedef struct mt32_worker_t {
+    int       index;
+    thread_t *thread;
+    event_t  *start;
+    event_t  *done;
+    /* Per-thread accumulation buffers: non-reverb L/R, reverb dry L/R. */
+    float accum[4][MT32_MAX_RUN_SAMPLES];
+} mt32_worker_t;
+
+static int             render_threads = 1;
+static mt32_worker_t   workers[MT32_MAX_RENDER_THREADS - 1];
+static mutex_t        *partial_mutex = NULL;
+static uint32_t        partial_count = 0;
+static volatile uint32_t partial_job_len = 0;
+
+static void
+mt32_render_partial_stripe(uint32_t first, float *nrl, float *nrr, float *rdl, float *rdr, uint32_t len)
+{
+    for (uint32_t i = first; i < partial_count; i += render_threads) {
+        if (mt32emu_is_partial_reverb_routed(context, i))
+            mt32emu_produce_partial_float(context, i, rdl, rdr, len);
+        else
+            mt32emu_produce_partial_float(context, i, nrl, nrr, len);
+    }
+}
+
+static void
+mt32_partial_worker(void *param)
+{
+    mt32_worker_t *w = (mt32_worker_t *) param;
+
+    while (1) {
+        thread_wait_event(w->start, -1);
+        thread_reset_event(w->start);
+        if (!mt32_on)
+            break;
+
+        const uint32_t len = partial_job_len;
+        for (uint8_t s = 0; s < 4; s++)
+            memset(w->accum[s], 0, len * sizeof(float));
+        mt32_render_partial_stripe(w->index + 1, w->accum[0], w->accum[1], w->accum[2], w->accum[3], len);
+        thread_set_event(w->done);
+    }
+}
+
+static void MT32EMU_C_CALL
+mt32_partial_dispatcher(UNUSED(void *instance_data), float *nrl, float *nrr, float *rdl, float *rdr, mt32emu_bit32u len)
+{
+    partial_job_len = len;
+
+    for (int w = 0; w < render_threads - 1; w++)
+        thread_set_event(workers[w].start);
+
+    /* Stripe 0 renders on the calling (synth) thread, straight into the
+     * target buffers, which arrive zero-filled. */
+    mt32_render_partial_stripe(0, nrl, nrr, rdl, rdr, len);
+
+    for (int w = 0; w < render_threads - 1; w++) {
+        thread_wait_event(workers[w].done, -1);
+        thread_reset_event(workers[w].done);
+        for (uint32_t n = 0; n < len; n++) {
+            nrl[n] += workers[w].accum[0][n];
+            nrr[n] += workers[w].accum[1][n];
+            rdl[n] += workers[w].accum[2][n];
+            rdr[n] += workers[w].accum[3][n];
+        }
+    }
+}
+
+static void MT32EMU_C_CALL
+mt32_partial_lock(UNUSED(void *instance_data))
+{
+    thread_wait_mutex(partial_mutex);
+}
+
+static void MT32EMU_C_CALL
+mt32_partial_unlock(UNUSED(void *instance_data))
+{
+    thread_release_mutex(partial_mutex);
+}
+
 static mt32emu_report_handler_version
 get_mt32_report_handler_version(UNUSED(mt32emu_report_handler_i i))
 {
@@ -204,6 +302,17 @@ mt32_poll(void)
     midi_pos++;
     if (midi_pos == SOUND_FREQ / RENDER_RATE) {
         midi_pos = 0;
+
+        /* Hand one pre-rendered segment to the backend, if the synth thread
+         * managed to stay ahead, and wake it up to refill the freed slot. */
+        if (ring_head != ring_tail) {
+            const uint32_t slot = ring_tail % MIDI_RING_SEGMENTS;
+            if (sound_is_float)
+                givealbuffer_midi((uint8_t *) buffer + (slot * seg_size), seg_size / sizeof(float));
+            else
+                givealbuffer_midi((uint8_t *) buffer_int16 + (slot * seg_size), seg_size / sizeof(int16_t));
+            ring_tail++;
+        }
         thread_set_event(event);
     }
 }
@@ -211,8 +320,6 @@ mt32_poll(void)
 static void
 mt32_thread(UNUSED(void *param))
 {
-    int      buf_pos = 0;
-    int      bsize   = buf_size / BUFFER_SEGMENTS;
     float   *buf;
     int16_t *buf16;
 
@@ -222,24 +329,20 @@ mt32_thread(UNUSED(void *param))
         thread_wait_event(event, -1);
         thread_reset_event(event);
 
-        if (sound_is_float) {
-            buf = (float *) ((uint8_t *) buffer + buf_pos);
-            memset(buf, 0, bsize);
-            mt32_stream(buf, bsize / (2 * sizeof(float)));
-            buf_pos += bsize;
-            if (buf_pos >= buf_size) {
-                givealbuffer_midi(buffer, buf_size / sizeof(float));
-                buf_pos = 0;
-            }
-        } else {
-            buf16 = (int16_t *) ((uint8_t *) buffer_int16 + buf_pos);
-            memset(buf16, 0, bsize);
-            mt32_stream_int16(buf16, bsize / (2 * sizeof(int16_t)));
-            buf_pos += bsize;
-            if (buf_pos >= buf_size) {
-                givealbuffer_midi(buffer_int16, buf_size / sizeof(int16_t));
-                buf_pos = 0;
+        /* Render ahead until the ring is full, then sleep until the consumer
+         * frees a slot. */
+        while (mt32_on && ((ring_head - ring_tail) < MIDI_RING_SEGMENTS)) {
+            const uint32_t slot = ring_head % MIDI_RING_SEGMENTS;
+            if (sound_is_float) {
+                buf = (float *) ((uint8_t *) buffer + (slot * seg_size));
+                memset(buf, 0, seg_size);
+                mt32_stream(buf, seg_size / (2 * sizeof(float)));
+            } else {
+                buf16 = (int16_t *) ((uint8_t *) buffer_int16 + (slot * seg_size));
+                memset(buf16, 0, seg_size);
+                mt32_stream_int16(buf16, seg_size / (2 * sizeof(int16_t)));
             }
+            ring_head++;
         }
     }
 }
@@ -275,20 +378,40 @@ mt32emu_init(char *control_rom, char *pcm_rom)
     if (!mt32_check("mt32emu_add_rom_file", mt32emu_add_rom_file(context, fn), MT32EMU_RC_ADDED_PCM_ROM))
         return 0;
 
+    render_threads = device_get_config_int("render_threads");
+    if (render_threads < 1)
+        render_threads = 1;
+    if (render_threads > MT32_MAX_RENDER_THREADS)
+        render_threads = MT32_MAX_RENDER_THREADS;
+    /* The partial render dispatcher only exists on the float renderer path. */
+    if (render_threads > 1)
+        mt32emu_select_renderer_type(context, MT32EMU_RT_FLOAT);
+
     if (!mt32_check("mt32emu_open_synth", mt32emu_open_synth(context), MT32EMU_RC_OK))
         return 0;
 
+    if (render_threads > 1) {
+        partial_count = mt32emu_get_partial_count(context);
+        partial_mutex = thread_create_mutex();
+        for (int w = 0; w < render_threads - 1; w++) {
+            workers[w].index = w;
+            workers[w].start = thread_create_event();
+            workers[w].done  = thread_create_event();
+        }
+        mt32emu_set_partial_render_dispatcher(context, mt32_partial_dispatcher, mt32_partial_lock, mt32_partial_unlock, NULL);
+    }
+
     samplerate = mt32emu_get_actual_stereo_output_samplerate(context);
-    /* buf_size = samplerate/RENDER_RATE*2; */
     if (sound_is_float) {
-        buf_size     = (samplerate / RENDER_RATE) * 2 * BUFFER_SEGMENTS * sizeof(float);
-        buffer       = malloc(buf_size);
+        seg_size     = (samplerate / RENDER_RATE) * 2 * sizeof(float);
+        buffer       = malloc(seg_size * MIDI_RING_SEGMENTS);
         buffer_int16 = NULL;
     } else {
-        buf_size     = (samplerate / RENDER_RATE) * 2 * BUFFER_SEGMENTS * sizeof(int16_t);
+        seg_size     = (samplerate / RENDER_RATE) * 2 * sizeof(int16_t);
         buffer       = NULL;
-        buffer_int16 = malloc(buf_size);
+        buffer_int16 = malloc(seg_size * MIDI_RING_SEGMENTS);
     }
+    ring_head = ring_tail = 0;
 
     mt32emu_set_output_gain(context, device_get_config_int("output_gain") / 100.0f);
     mt32emu_set_reverb_enabled(context, device_get_config_int("reverb"));
@@ -296,7 +419,7 @@ mt32emu_init(char *control_rom, char *pcm_rom)
     mt32emu_set_reversed_stereo_enabled(context, device_get_config_int("reversed_stereo"));
     mt32emu_set_nice_amp_ramp_enabled(context, device_get_config_int("nice_ramp"));
 
-    al_set_midi(samplerate, buf_size);
+    al_set_midi(samplerate, seg_size);
 
     dev = malloc(sizeof(midi_device_t));
     memset(dev, 0, sizeof(midi_device_t));
@@ -309,6 +432,9 @@ mt32emu_init(char *control_rom, char *pcm_rom)
 
     mt32_on = 1;
 
+    for (int w = 0; w < render_threads - 1; w++)
+        workers[w].thread = thread_create(mt32_partial_worker, &workers[w]);
+
     start_event = thread_create_event();
 
     event    = thread_create_event();
@@ -358,6 +484,23 @@ mt32_close(void *priv)
     start_event = NULL;
     thread_h    = NULL;
 
+    /* The synth thread is gone, so no render pass can dispatch any more;
+     * now the partial workers can be joined. */
+    for (int w = 0; w < render_threads - 1; w++) {
+        thread_set_event(workers[w].start);
+        thread_wait(workers[w].thread);
+        thread_destroy_event(workers[w].start);
+        thread_destroy_event(workers[w].done);
+        workers[w].thread = NULL;
+        workers[w].start  = NULL;
+        workers[w].done   = NULL;
+    }
+    if (partial_mutex) {
+        thread_close_mutex(partial_mutex);
+        partial_mutex = NULL;
+    }
+    render_threads = 1;
+
     if (context) {
         mt32emu_close_synth(context);
         mt32emu_free_context(context);
@@ -409,6 +552,30 @@ static const device_config_t mt32_config[] = {
         .type = CONFIG_BINARY,
         .default_int = 0
     },
+    {
+        .name = "render_threads",
+        .description = "Render threads",
+        .type = CONFIG_SELECTION,
+        .default_string = "",
+        .default_int = 1,
+        .file_filter = "",
+        .spinner = { 0 },
+        .selection = {
+            {
+                .description = "1 (serial)",
+                .value = 1
+            },
+            {
+                .description = "2",
+                .value = 2
+            },
+            {
+                .description = "4",
+                .value = 4
+            },
+            { .description = "" }
+        }
+    },
     {
         .name = "nice_ramp",
         .description = "Nice ramp",
@@ -109,6 +109,15 @@ void Partial::activate(int part) {
 }
 
 void Partial::deactivate() {
+	// Deactivation mutates state shared between partials (the free partial list,
+	// the owning poly and part), so serialise it when partials may be rendered
+	// concurrently by a host partial render dispatcher.
+	synth->lockPartialState();
+	doDeactivate();
+	synth->unlockPartialState();
+}
+
+void Partial::doDeactivate() {
 	if (!isActive()) {
 		return;
 	}
@@ -126,7 +135,8 @@ void Partial::deactivate() {
 	} else {
 		la32Pair->deactivate(LA32PartialPair::MASTER);
 		if (hasRingModulatingSlave()) {
-			pair->deactivate();
+			// The lock is already held, don't re-take it.
+			pair->doDeactivate();
 			pair = NULL;
 		}
 	}
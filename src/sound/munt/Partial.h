@@ -105,6 +105,7 @@ public:
 	bool isActive() const;
 	void activate(int part);
 	void deactivate(void);
+	void doDeactivate(void);
 	void startPartial(const Part *part, Poly *usePoly, const PatchCache *useCache, const MemParams::RhythmTemp *rhythmTemp, Partial *pairPartial);
 	void startAbort();
 	void startDecayAll();
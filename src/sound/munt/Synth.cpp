@@ -178,6 +178,15 @@ protected:
 
 	void updateDisplayState();
 
+	bool dispatchPartialRender(IntSample *, IntSample *, IntSample *, IntSample *, Bit32u) {
+		// Only the float renderer supports the host partial render dispatcher.
+		return false;
+	}
+
+	bool dispatchPartialRender(FloatSample *nonReverbLeft, FloatSample *nonReverbRight, FloatSample *reverbDryLeft, FloatSample *reverbDryRight, Bit32u len) {
+		return synth.tryDispatchPartialRender(nonReverbLeft, nonReverbRight, reverbDryLeft, reverbDryRight, len);
+	}
+
 public:
 	Renderer(Synth &useSynth) : synth(useSynth) {}
 
@@ -255,6 +264,13 @@ public:
 
 	ReportHandler2 defaultReportHandler;
 	ReportHandler2 *reportHandler2;
+
+	// Optional host-provided dispatcher rendering partials in parallel (float renderer
+	// only), together with the lock callbacks guarding partial deactivation.
+	Synth::PartialRenderDispatcher partialRenderDispatcher;
+	Synth::PartialStateLockCallback partialStateLockCallback;
+	Synth::PartialStateLockCallback partialStateUnlockCallback;
+	void *partialRenderDispatcherData;
 };
 
 Bit32u Synth::getLibraryVersionInt() {
@@ -294,6 +310,10 @@ Synth::Synth(ReportHandler *useReportHandler) :
 	extensions.reportHandler2 = &extensions.defaultReportHandler;
 
 	extensions.preallocatedReverbMemory = false;
+	extensions.partialRenderDispatcher = NULL;
+	extensions.partialStateLockCallback = NULL;
+	extensions.partialStateUnlockCallback = NULL;
+	extensions.partialRenderDispatcherData = NULL;
 	for (int i = REVERB_MODE_ROOM; i <= REVERB_MODE_TAP_DELAY; i++) {
 		reverbModels[i] = NULL;
 	}
@@ -2477,11 +2497,13 @@ void RendererImpl<Sample>::produceStreams(const DACOutputStreams<Sample> &stream
 		Synth::muteSampleBuffer(reverbDryLeft, len);
 		Synth::muteSampleBuffer(reverbDryRight, len);
 
-		for (unsigned int i = 0; i < synth.getPartialCount(); i++) {
-			if (getPartialManager().shouldReverb(i)) {
-				getPartialManager().produceOutput(i, reverbDryLeft, reverbDryRight, len);
-			} else {
-				getPartialManager().produceOutput(i, nonReverbLeft, nonReverbRight, len);
+		if (!dispatchPartialRender(nonReverbLeft, nonReverbRight, reverbDryLeft, reverbDryRight, len)) {
+			for (unsigned int i = 0; i < synth.getPartialCount(); i++) {
+				if (getPartialManager().shouldReverb(i)) {
+					getPartialManager().produceOutput(i, reverbDryLeft, reverbDryRight, len);
+				} else {
+					getPartialManager().produceOutput(i, nonReverbLeft, nonReverbRight, len);
+				}
 			}
 		}
 
@@ -2529,6 +2551,44 @@ void Synth::printPartialUsage(Bit32u sampleOffset) {
 	}
 }
 
+void Synth::setPartialRenderDispatcher(PartialRenderDispatcher dispatcher, PartialStateLockCallback lockCallback, PartialStateLockCallback unlockCallback, void *instanceData) {
+	extensions.partialRenderDispatcher = dispatcher;
+	extensions.partialStateLockCallback = dispatcher != NULL ? lockCallback : NULL;
+	extensions.partialStateUnlockCallback = dispatcher != NULL ? unlockCallback : NULL;
+	extensions.partialRenderDispatcherData = dispatcher != NULL ? instanceData : NULL;
+}
+
+bool Synth::producePartialOutput(Bit32u partialNum, float *leftBuf, float *rightBuf, Bit32u len) {
+	if (!opened || partialNum >= partialCount) {
+		return false;
+	}
+	return partialManager->produceOutput(partialNum, leftBuf, rightBuf, len);
+}
+
+bool Synth::isPartialReverbRouted(Bit32u partialNum) {
+	return opened && partialNum < partialCount && partialManager->shouldReverb(partialNum);
+}
+
+void Synth::lockPartialState() {
+	if (extensions.partialStateLockCallback != NULL) {
+		extensions.partialStateLockCallback(extensions.partialRenderDispatcherData);
+	}
+}
+
+void Synth::unlockPartialState() {
+	if (extensions.partialStateUnlockCallback != NULL) {
+		extensions.partialStateUnlockCallback(extensions.partialRenderDispatcherData);
+	}
+}
+
+bool Synth::tryDispatchPartialRender(float *nonReverbLeft, float *nonReverbRight, float *reverbDryLeft, float *reverbDryRight, Bit32u len) {
+	if (extensions.partialRenderDispatcher == NULL) {
+		return false;
+	}
+	extensions.partialRenderDispatcher(extensions.partialRenderDispatcherData, nonReverbLeft, nonReverbRight, reverbDryLeft, reverbDryRight, len);
+	return true;
+}
+
 bool Synth::hasActivePartials() const {
 	if (!opened) {
 		return false;
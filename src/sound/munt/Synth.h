@@ -215,6 +215,15 @@ private:
 	Bit32u addMIDIInterfaceDelay(Bit32u len, Bit32u timestamp);
 	bool isAbortingPoly() const { return abortingPoly != NULL; }
 
+	// No-ops unless a partial render dispatcher with lock callbacks is installed.
+	void lockPartialState();
+	void unlockPartialState();
+
+	// Invokes the installed partial render dispatcher, if any; returns false to fall
+	// back to the built-in serial partial rendering loop.
+	bool tryDispatchPartialRender(float *nonReverbLeft, float *nonReverbRight,
+		float *reverbDryLeft, float *reverbDryRight, Bit32u len);
+
 	void writeSysexGlobal(Bit32u addr, const Bit8u *sysex, Bit32u len);
 	void readSysex(Bit8u channel, const Bit8u *sysex, Bit32u len) const;
 	void initMemoryRegions();
@@ -532,6 +541,31 @@ public:
 	MT32EMU_EXPORT void renderStreams(float *nonReverbLeft, float *nonReverbRight, float *reverbDryLeft, float *reverbDryRight, float *reverbWetLeft, float *reverbWetRight, Bit32u len);
 	MT32EMU_EXPORT void renderStreams(const DACOutputStreams<float> &streams, Bit32u len);
 
+	// A host-provided dispatcher invoked by the float renderer in place of the built-in
+	// serial partial rendering loop. The dispatcher must arrange for producePartialOutput()
+	// to be invoked for every partial (possibly concurrently from several threads, each
+	// accumulating into its own buffers) and sum the results into the four streams passed,
+	// which the renderer hands over zero-filled.
+	typedef void (*PartialRenderDispatcher)(void *instanceData,
+		float *nonReverbLeft, float *nonReverbRight,
+		float *reverbDryLeft, float *reverbDryRight, Bit32u len);
+	// Lock callbacks guarding partial deactivation, which mutates state shared between
+	// partials (the free partial list, the owning poly and part).
+	typedef void (*PartialStateLockCallback)(void *instanceData);
+
+	// Installs (or, given NULL, removes) a partial render dispatcher along with the lock
+	// callbacks it requires. Only the float renderer dispatches; the 16-bit integer
+	// renderer always renders partials serially.
+	MT32EMU_EXPORT void setPartialRenderDispatcher(PartialRenderDispatcher dispatcher,
+		PartialStateLockCallback lockCallback, PartialStateLockCallback unlockCallback,
+		void *instanceData);
+	// Renders the given partial into the caller's accumulation buffers. Intended to be
+	// invoked by a partial render dispatcher; returns false if the partial produced
+	// no output (inactive, already rendered or a ring modulating slave).
+	MT32EMU_EXPORT bool producePartialOutput(Bit32u partialNum, float *leftBuf, float *rightBuf, Bit32u len);
+	// Returns whether the given partial is routed to the reverb dry streams.
+	MT32EMU_EXPORT bool isPartialReverbRouted(Bit32u partialNum);
+
 	// Returns true when there is at least one active partial, otherwise false.
 	MT32EMU_EXPORT bool hasActivePartials() const;
 
@@ -931,6 +931,18 @@ mt32emu_bit32u MT32EMU_C_CALL mt32emu_get_partial_count(mt32emu_const_context co
 	return context->synth->getPartialCount();
 }
 
+void MT32EMU_C_CALL mt32emu_set_partial_render_dispatcher(mt32emu_context context, mt32emu_partial_render_dispatcher dispatcher, mt32emu_partial_state_lock_callback lock_callback, mt32emu_partial_state_lock_callback unlock_callback, void *instance_data) {
+	context->synth->setPartialRenderDispatcher(reinterpret_cast<Synth::PartialRenderDispatcher>(dispatcher), reinterpret_cast<Synth::PartialStateLockCallback>(lock_callback), reinterpret_cast<Synth::PartialStateLockCallback>(unlock_callback), instance_data);
+}
+
+mt32emu_boolean MT32EMU_C_CALL mt32emu_produce_partial_float(mt32emu_context context, mt32emu_bit32u partial_num, float *left, float *right, mt32emu_bit32u len) {
+	return context->synth->producePartialOutput(partial_num, left, right, len) ? MT32EMU_BOOL_TRUE : MT32EMU_BOOL_FALSE;
+}
+
+mt32emu_boolean MT32EMU_C_CALL mt32emu_is_partial_reverb_routed(mt32emu_context context, mt32emu_bit32u partial_num) {
+	return context->synth->isPartialReverbRouted(partial_num) ? MT32EMU_BOOL_TRUE : MT32EMU_BOOL_FALSE;
+}
+
 mt32emu_bit32u MT32EMU_C_CALL mt32emu_get_part_states(mt32emu_const_context context) {
 	return context->synth->getPartStates();
 }
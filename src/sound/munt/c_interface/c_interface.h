@@ -550,6 +550,28 @@ MT32EMU_EXPORT mt32emu_boolean MT32EMU_C_CALL mt32emu_is_active(mt32emu_const_co
 /** Returns the maximum number of partials playing simultaneously. */
 MT32EMU_EXPORT mt32emu_bit32u MT32EMU_C_CALL mt32emu_get_partial_count(mt32emu_const_context context);
 
+/**
+ * Installs (or, given NULL, removes) a partial render dispatcher along with the lock callbacks
+ * it requires. When installed, the float renderer invokes the dispatcher in place of its serial
+ * partial rendering loop; the dispatcher must arrange for mt32emu_produce_partial_float() to be
+ * invoked for every partial (possibly concurrently from several threads, each accumulating into
+ * its own buffers) and sum the results into the four streams passed, which arrive zero-filled.
+ * The 16-bit integer renderer always renders partials serially.
+ */
+MT32EMU_EXPORT void MT32EMU_C_CALL mt32emu_set_partial_render_dispatcher(mt32emu_context context,
+	mt32emu_partial_render_dispatcher dispatcher, mt32emu_partial_state_lock_callback lock_callback,
+	mt32emu_partial_state_lock_callback unlock_callback, void *instance_data);
+
+/**
+ * Renders the given partial into the caller's accumulation buffers. Intended to be invoked by a
+ * partial render dispatcher; returns false if the partial produced no output.
+ */
+MT32EMU_EXPORT mt32emu_boolean MT32EMU_C_CALL mt32emu_produce_partial_float(mt32emu_context context,
+	mt32emu_bit32u partial_num, float *left, float *right, mt32emu_bit32u len);
+
+/** Returns whether the given partial is routed to the reverb dry streams. */
+MT32EMU_EXPORT mt32emu_boolean MT32EMU_C_CALL mt32emu_is_partial_reverb_routed(mt32emu_context context, mt32emu_bit32u partial_num);
+
 /**
  * Returns current states of all the parts as a bit set. The least significant bit corresponds to the state of part 1,
  * total of 9 bits hold the states of all the parts. If the returned bit for a part is set, there is at least one active
@@ -112,6 +112,17 @@ typedef struct {
 	float *reverbWetRight;
 } mt32emu_dac_output_float_streams;
 
+/**
+ * Host-provided dispatcher invoked by the float renderer in place of the built-in serial
+ * partial rendering loop. See mt32emu_set_partial_render_dispatcher().
+ */
+typedef void (MT32EMU_C_CALL *mt32emu_partial_render_dispatcher)(void *instance_data,
+	float *non_reverb_left, float *non_reverb_right,
+	float *reverb_dry_left, float *reverb_dry_right, mt32emu_bit32u len);
+
+/** Lock callback guarding partial state shared between concurrently rendered partials. */
+typedef void (MT32EMU_C_CALL *mt32emu_partial_state_lock_callback)(void *instance_data);
+
 /* === Interface handling === */
 
 /** Report handler interface versions */
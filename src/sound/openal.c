@@ -33,6 +33,7 @@
 #include <86box/86box.h>
 #include <86box/midi.h>
 #include <86box/sound.h>
+#include <86box/telemetry.h>
 #include <86box/plat_unused.h>
 
 #define FREQ   SOUND_FREQ
@@ -238,10 +239,21 @@ givealbuffer_common(void *buf, uint8_t src, int size, int freq)
     alGetSourcei(source[src], AL_SOURCE_STATE, &state);
 
     if (state == 0x1014) {
+        /* The source ran dry and stopped - an audible underrun. */
+        if (src == 0)
+            telemetry_audio_underruns++;
         alSourcePlay(source[src]);
     }
 
     alGetSourcei(source[src], AL_BUFFERS_PROCESSED, &processed);
+    if (src == 0) {
+        int queued;
+
+        alGetSourcei(source[src], AL_BUFFERS_QUEUED, &queued);
+        telemetry_audio_fill = queued - processed;
+        if (processed < 1)
+            telemetry_audio_drops++;
+    }
     if (processed >= 1) {
         gain = pow(10.0, (double) sound_gain / 20.0);
         alListenerf(AL_GAIN, gain);
@@ -29,6 +29,7 @@
 
 #include <86box/86box.h>
 #include <86box/device.h>
+#include <86box/dma.h>
 #include <86box/gameport.h>
 #include <86box/io.h>
 #include <86box/mem.h>
@@ -86,6 +87,8 @@ typedef struct es1371_t {
         uint16_t count;
         uint16_t size;
 
+        dma_bm_window_t window;
+
         uint16_t samp_ct;
         int      curr_samp_ct;
 
@@ -1754,17 +1757,25 @@ es1371_fetch(es1371_t *dev, int dac_nr)
     if (dev->si_cr & (dac_nr ? SI_P2_PAUSE : SI_P1_PAUSE))
         return;
 
-    int format = dac_nr ? ((dev->si_cr >> 2) & 3) : (dev->si_cr & 3);
-    int pos    = dev->dac[dac_nr].buffer_pos & 63;
-    int c;
+    int      format  = dac_nr ? ((dev->si_cr >> 2) & 3) : (dev->si_cr & 3);
+    int      pos     = dev->dac[dac_nr].buffer_pos & 63;
+    uint32_t buf_len = ((uint32_t) dev->dac[dac_nr].size + 1) << 2;
+    uint8_t  frame[4];
+    int      c;
+
+    /* Keep the cached window aimed at the current sample buffer, so the
+       per-frame reads below are plain copies out of backing RAM. */
+    if ((dev->dac[dac_nr].window.base != dev->dac[dac_nr].addr_latch) || (dev->dac[dac_nr].window.size != buf_len))
+        dma_bm_window_set(&dev->dac[dac_nr].window, dev->dac[dac_nr].addr_latch, buf_len);
 
     switch (format) {
         case FORMAT_MONO_8:
             for (c = 0; c < 32; c += 4) {
-                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = dev->dac[dac_nr].buffer_r[(pos + c) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr + 1) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_l[(pos + c + 2) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 2) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr + 2) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_l[(pos + c + 3) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 3) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr + 3) ^ 0x80) << 8;
+                dma_bm_window_read(&dev->dac[dac_nr].window, dev->dac[dac_nr].addr, frame, 4);
+                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = dev->dac[dac_nr].buffer_r[(pos + c) & 63] = (frame[0] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = (frame[1] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_l[(pos + c + 2) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 2) & 63] = (frame[2] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_l[(pos + c + 3) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 3) & 63] = (frame[3] ^ 0x80) << 8;
                 dev->dac[dac_nr].addr += 4;
 
                 dev->dac[dac_nr].buffer_pos_end += 4;
@@ -1780,10 +1791,11 @@ es1371_fetch(es1371_t *dev, int dac_nr)
 
         case FORMAT_STEREO_8:
             for (c = 0; c < 16; c += 2) {
-                dev->dac[dac_nr].buffer_l[(pos + c) & 63]     = (mem_readb_phys(dev->dac[dac_nr].addr) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_r[(pos + c) & 63]     = (mem_readb_phys(dev->dac[dac_nr].addr + 1) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr + 2) ^ 0x80) << 8;
-                dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = (mem_readb_phys(dev->dac[dac_nr].addr + 3) ^ 0x80) << 8;
+                dma_bm_window_read(&dev->dac[dac_nr].window, dev->dac[dac_nr].addr, frame, 4);
+                dev->dac[dac_nr].buffer_l[(pos + c) & 63]     = (frame[0] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_r[(pos + c) & 63]     = (frame[1] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = (frame[2] ^ 0x80) << 8;
+                dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = (frame[3] ^ 0x80) << 8;
                 dev->dac[dac_nr].addr += 4;
 
                 dev->dac[dac_nr].buffer_pos_end += 2;
@@ -1799,8 +1811,9 @@ es1371_fetch(es1371_t *dev, int dac_nr)
 
         case FORMAT_MONO_16:
             for (c = 0; c < 16; c += 2) {
-                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = dev->dac[dac_nr].buffer_r[(pos + c) & 63] = mem_readw_phys(dev->dac[dac_nr].addr);
-                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = mem_readw_phys(dev->dac[dac_nr].addr + 2);
+                dma_bm_window_read(&dev->dac[dac_nr].window, dev->dac[dac_nr].addr, frame, 4);
+                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = dev->dac[dac_nr].buffer_r[(pos + c) & 63] = (int16_t) (frame[0] | (frame[1] << 8));
+                dev->dac[dac_nr].buffer_l[(pos + c + 1) & 63] = dev->dac[dac_nr].buffer_r[(pos + c + 1) & 63] = (int16_t) (frame[2] | (frame[3] << 8));
                 dev->dac[dac_nr].addr += 4;
 
                 dev->dac[dac_nr].buffer_pos_end += 2;
@@ -1816,8 +1829,9 @@ es1371_fetch(es1371_t *dev, int dac_nr)
 
         case FORMAT_STEREO_16:
             for (c = 0; c < 4; c++) {
-                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = mem_readw_phys(dev->dac[dac_nr].addr);
-                dev->dac[dac_nr].buffer_r[(pos + c) & 63] = mem_readw_phys(dev->dac[dac_nr].addr + 2);
+                dma_bm_window_read(&dev->dac[dac_nr].window, dev->dac[dac_nr].addr, frame, 4);
+                dev->dac[dac_nr].buffer_l[(pos + c) & 63] = (int16_t) (frame[0] | (frame[1] << 8));
+                dev->dac[dac_nr].buffer_r[(pos + c) & 63] = (int16_t) (frame[2] | (frame[3] << 8));
                 dev->dac[dac_nr].addr += 4;
 
                 dev->dac[dac_nr].buffer_pos_end++;
@@ -72,6 +72,8 @@ typedef struct cmi8x38_dma_t {
     uint8_t  fifo[256];
     uint8_t  restart;
 
+    dma_bm_window_t window;
+
     int16_t  out_fl;
     int16_t  out_fr;
     int16_t  out_rl;
@@ -1066,14 +1068,19 @@ cmi8x38_dma_process(void *priv)
             dma->frame_count_fragment                    = *((uint16_t *) &dev->io_regs[dma->reg | 0x6]) + 1;
 
             cmi8x38_log("CMI8x38: Starting DMA %d at %08X (count %04X fragment %04X)\n", dma->id, dma->sample_ptr, dma->frame_count_dma, dma->frame_count_fragment);
+
+            /* Aim the cached window at the new sample buffer, so the
+               per-dword accesses below are plain copies out of (or into)
+               backing RAM. */
+            dma_bm_window_set(&dma->window, dma->sample_ptr, (uint32_t) dma->frame_count_dma << 2);
         }
 
         if (dma_status & 0x01) {
             /* Write channel: read data from FIFO. */
-            mem_writel_phys(dma->sample_ptr, *((uint32_t *) &dma->fifo[dma->fifo_end & (sizeof(dma->fifo) - 1)]));
+            dma_bm_window_write(&dma->window, dma->sample_ptr, &dma->fifo[dma->fifo_end & (sizeof(dma->fifo) - 1)], 4);
         } else {
             /* Read channel: write data to FIFO. */
-            *((uint32_t *) &dma->fifo[dma->fifo_end & (sizeof(dma->fifo) - 1)]) = mem_readl_phys(dma->sample_ptr);
+            dma_bm_window_read(&dma->window, dma->sample_ptr, &dma->fifo[dma->fifo_end & (sizeof(dma->fifo) - 1)], 4);
         }
         dma->fifo_end += 4;
         dma->sample_ptr += 4;
@@ -15,63 +15,110 @@
 void
 cms_update(cms_t *cms)
 {
-    for (; cms->pos < sound_pos_global; cms->pos++) {
-        int16_t out_l = 0;
-        int16_t out_r = 0;
+    int       pos = cms->pos;
+    const int end = sound_pos_global;
+    uint8_t   noisebit[2][SOUNDBUFLEN];
 
-        for (uint8_t c = 0; c < 4; c++) {
-            switch (cms->noisetype[c >> 1][c & 1]) {
+    if (pos >= end)
+        return;
+
+    memset(&cms->buffer[pos << 1], 0x00, (end - pos) * 2 * sizeof(int16_t));
+
+    /* Register writes flush the buffer first, so the register state is
+       constant over the span: the noise rates can be computed once and
+       each voice rendered as constant-level runs instead of per sample. */
+    for (uint8_t c = 0; c < 2; c++) {
+        if (!(cms->regs[c][0x1C] & 1))
+            continue;
+
+        for (uint8_t d = 0; d < 2; d++) {
+            switch (cms->noisetype[c][d]) {
                 case 0:
-                    cms->noisefreq[c >> 1][c & 1] = MASTER_CLOCK / 256;
+                    cms->noisefreq[c][d] = MASTER_CLOCK / 256;
                     break;
                 case 1:
-                    cms->noisefreq[c >> 1][c & 1] = MASTER_CLOCK / 512;
+                    cms->noisefreq[c][d] = MASTER_CLOCK / 512;
                     break;
                 case 2:
-                    cms->noisefreq[c >> 1][c & 1] = MASTER_CLOCK / 1024;
+                    cms->noisefreq[c][d] = MASTER_CLOCK / 1024;
                     break;
                 case 3:
-                    cms->noisefreq[c >> 1][c & 1] = cms->freq[c >> 1][(c & 1) * 3];
+                    cms->noisefreq[c][d] = cms->freq[c][d * 3];
                     break;
 
                 default:
                     break;
             }
         }
-        for (uint8_t c = 0; c < 2; c++) {
-            if (cms->regs[c][0x1C] & 1) {
-                for (uint8_t d = 0; d < 6; d++) {
-                    if (cms->regs[c][0x14] & (1 << d)) {
-                        if (cms->stat[c][d])
-                            out_l += (cms->vol[c][d][0] * 90);
-                        if (cms->stat[c][d])
-                            out_r += (cms->vol[c][d][1] * 90);
-                        cms->count[c][d] += cms->freq[c][d];
-                        if (cms->count[c][d] >= 24000) {
-                            cms->count[c][d] -= 24000;
-                            cms->stat[c][d] ^= 1;
+
+        /* Advance the two noise LFSRs over the whole span up front,
+           keeping the per-sample output bit for the routed voices. */
+        for (uint8_t d = 0; d < 2; d++) {
+            int      count = cms->noisecount[c][d];
+            uint16_t noise = cms->noise[c][d];
+
+            for (int i = pos; i < end; i++) {
+                noisebit[d][i] = noise & 1;
+                count += cms->noisefreq[c][d];
+                while (count >= 24000) {
+                    count -= 24000;
+                    noise <<= 1;
+                    if (!(((noise & 0x4000) >> 8) ^ (noise & 0x40)))
+                        noise |= 1;
+                }
+            }
+            cms->noisecount[c][d] = count;
+            cms->noise[c][d]      = noise;
+        }
+
+        for (uint8_t d = 0; d < 6; d++) {
+            const int16_t voll = cms->vol[c][d][0] * 90;
+            const int16_t volr = cms->vol[c][d][1] * 90;
+
+            if (cms->regs[c][0x14] & (1 << d)) {
+                const int freq  = cms->freq[c][d];
+                float     count = cms->count[c][d];
+                int       stat  = cms->stat[c][d];
+                int       i     = pos;
+
+                while (i < end) {
+                    int run = end - i;
+
+                    if (freq > 0) {
+                        const int next = (int) ((24000.0f - count) / (float) freq) + 1;
+                        if (next < run)
+                            run = next;
+                    }
+                    if (stat) {
+                        for (int j = 0; j < run; j++) {
+                            cms->buffer[(i + j) << 1] += voll;
+                            cms->buffer[((i + j) << 1) + 1] += volr;
                         }
-                    } else if (cms->regs[c][0x15] & (1 << d)) {
-                        if (cms->noise[c][d / 3] & 1)
-                            out_l += (cms->vol[c][d][0] * 90);
-                        if (cms->noise[c][d / 3] & 1)
-                            out_r += (cms->vol[c][d][0] * 90);
                     }
+                    count += (float) (run * freq);
+                    if (count >= 24000) {
+                        count -= 24000;
+                        stat ^= 1;
+                    }
+                    i += run;
                 }
-                for (uint8_t d = 0; d < 2; d++) {
-                    cms->noisecount[c][d] += cms->noisefreq[c][d];
-                    while (cms->noisecount[c][d] >= 24000) {
-                        cms->noisecount[c][d] -= 24000;
-                        cms->noise[c][d] <<= 1;
-                        if (!(((cms->noise[c][d] & 0x4000) >> 8) ^ (cms->noise[c][d] & 0x40)))
-                            cms->noise[c][d] |= 1;
+                cms->count[c][d] = count;
+                cms->stat[c][d]  = stat;
+            } else if (cms->regs[c][0x15] & (1 << d)) {
+                const uint8_t *bits = noisebit[d / 3];
+
+                /* Left volume on both sides, as before. */
+                for (int i = pos; i < end; i++) {
+                    if (bits[i]) {
+                        cms->buffer[i << 1] += voll;
+                        cms->buffer[(i << 1) + 1] += voll;
                     }
                 }
             }
         }
-        cms->buffer[cms->pos << 1]       = out_l;
-        cms->buffer[(cms->pos << 1) + 1] = out_r;
     }
+
+    cms->pos = end;
 }
 
 void
@@ -1755,29 +1755,24 @@ int32_t old_pitch[32] = { 0 };
 int32_t old_cut[32]   = { 0 };
 int32_t old_vol[32]   = { 0 };
 #endif
-void
-emu8k_update(emu8k_t *emu8k)
+/* Render voices [first_voice, last_voice] over samples [start, end).
+ * out_buf is stereo interleaved and rev_buf/chor_buf are mono, all indexed
+ * relative to start, and all accumulated into, not overwritten. Nothing
+ * touched here is shared between voices, so disjoint banks of voices can
+ * be rendered concurrently as long as their destination buffers are too. */
+static void
+emu8k_render_voices(emu8k_t *emu8k, int first_voice, int last_voice, int start, int end,
+                    int32_t *out_buf, int32_t *rev_buf, int32_t *chor_buf)
 {
-    int new_pos = (sound_pos_global * FREQ_44100) / SOUND_FREQ;
-    if (emu8k->pos >= new_pos)
-        return;
-
     int32_t       *buf;
     emu8k_voice_t *emu_voice;
     int            pos;
 
-    /* Clean the buffers since we will accumulate into them. */
-    buf = &emu8k->buffer[emu8k->pos * 2];
-    memset(buf, 0, 2 * (new_pos - emu8k->pos) * sizeof(emu8k->buffer[0]));
-    memset(&emu8k->chorus_in_buffer[emu8k->pos], 0, (new_pos - emu8k->pos) * sizeof(emu8k->chorus_in_buffer[0]));
-    memset(&emu8k->reverb_in_buffer[emu8k->pos], 0, (new_pos - emu8k->pos) * sizeof(emu8k->reverb_in_buffer[0]));
-
-    /* Voices section  */
-    for (uint8_t c = 0; c < 32; c++) {
+    for (int c = first_voice; c <= last_voice; c++) {
         emu_voice = &emu8k->voice[c];
-        buf       = &emu8k->buffer[emu8k->pos * 2];
+        buf       = out_buf;
 
-        for (pos = emu8k->pos; pos < new_pos; pos++) {
+        for (pos = start; pos < end; pos++) {
             int32_t dat;
 
             if (emu_voice->cvcf_curr_volume) {
@@ -1882,10 +1877,10 @@ emu8k_update(emu8k_t *emu8k)
 
                     /* Effects section */
                     if (emu_voice->ptrx_revb_send > 0) {
-                        emu8k->reverb_in_buffer[pos] += (dat * emu_voice->ptrx_revb_send) >> 8;
+                        rev_buf[pos - start] += (dat * emu_voice->ptrx_revb_send) >> 8;
                     }
                     if (emu_voice->csl_chor_send > 0) {
-                        emu8k->chorus_in_buffer[pos] += (dat * emu_voice->csl_chor_send) >> 8;
+                        chor_buf[pos - start] += (dat * emu_voice->csl_chor_send) >> 8;
                     }
                 }
             }
@@ -2119,6 +2114,95 @@ emu8k_update(emu8k_t *emu8k)
         pclog("EMUFILT :%d\n", emu_voice->cvcf_curr_filt_ctoff);
 #endif
     }
+}
+
+static void
+emu8k_render_thread(emu8k_t *emu8k, int num)
+{
+    while (1) {
+        thread_wait_event(emu8k->render_wake[num], -1);
+        thread_reset_event(emu8k->render_wake[num]);
+
+        if (!emu8k->render_run)
+            break;
+
+        const int count = emu8k->render_new_pos - emu8k->render_pos;
+
+        memset(emu8k->render_buffer[num], 0, 2 * count * sizeof(emu8k->render_buffer[num][0]));
+        memset(emu8k->render_reverb_in[num], 0, count * sizeof(emu8k->render_reverb_in[num][0]));
+        memset(emu8k->render_chorus_in[num], 0, count * sizeof(emu8k->render_chorus_in[num][0]));
+
+        emu8k_render_voices(emu8k, num * EMU8K_VOICES_PER_THREAD,
+                            ((num + 1) * EMU8K_VOICES_PER_THREAD) - 1,
+                            emu8k->render_pos, emu8k->render_new_pos,
+                            emu8k->render_buffer[num],
+                            emu8k->render_reverb_in[num],
+                            emu8k->render_chorus_in[num]);
+
+        thread_set_event(emu8k->render_done[num]);
+    }
+}
+
+static void
+emu8k_render_thread_1(void *priv)
+{
+    emu8k_render_thread((emu8k_t *) priv, 0);
+}
+
+static void
+emu8k_render_thread_2(void *priv)
+{
+    emu8k_render_thread((emu8k_t *) priv, 1);
+}
+
+void
+emu8k_update(emu8k_t *emu8k)
+{
+    int new_pos = (sound_pos_global * FREQ_44100) / SOUND_FREQ;
+    if (emu8k->pos >= new_pos)
+        return;
+
+    int32_t *buf;
+    int      pos;
+
+    /* Clean the buffers since we will accumulate into them. */
+    buf = &emu8k->buffer[emu8k->pos * 2];
+    memset(buf, 0, 2 * (new_pos - emu8k->pos) * sizeof(emu8k->buffer[0]));
+    memset(&emu8k->chorus_in_buffer[emu8k->pos], 0, (new_pos - emu8k->pos) * sizeof(emu8k->chorus_in_buffer[0]));
+    memset(&emu8k->reverb_in_buffer[emu8k->pos], 0, (new_pos - emu8k->pos) * sizeof(emu8k->reverb_in_buffer[0]));
+
+    /* Voices section  */
+    if (emu8k->render_thread[0] && ((new_pos - emu8k->pos) >= EMU8K_RENDER_MIN_SAMPLES)) {
+        /* Hand one bank of voices to each worker and sum their private
+         * accumulation buffers once they are all done. */
+        emu8k->render_pos     = emu8k->pos;
+        emu8k->render_new_pos = new_pos;
+        for (uint8_t w = 0; w < EMU8K_RENDER_THREADS; w++) {
+            thread_reset_event(emu8k->render_done[w]);
+            thread_set_event(emu8k->render_wake[w]);
+        }
+        for (uint8_t w = 0; w < EMU8K_RENDER_THREADS; w++)
+            thread_wait_event(emu8k->render_done[w], -1);
+
+        for (uint8_t w = 0; w < EMU8K_RENDER_THREADS; w++) {
+            const int32_t *rbuf = emu8k->render_buffer[w];
+
+            buf = &emu8k->buffer[emu8k->pos * 2];
+            for (pos = emu8k->pos; pos < new_pos; pos++) {
+                (*buf++) += (*rbuf++);
+                (*buf++) += (*rbuf++);
+                emu8k->reverb_in_buffer[pos] += emu8k->render_reverb_in[w][pos - emu8k->pos];
+                emu8k->chorus_in_buffer[pos] += emu8k->render_chorus_in[w][pos - emu8k->pos];
+            }
+        }
+    } else {
+        /* Batch too short (or pool not up) to be worth a round trip to the
+         * workers: render all the voices inline. */
+        emu8k_render_voices(emu8k, 0, 31, emu8k->pos, new_pos,
+                            &emu8k->buffer[emu8k->pos * 2],
+                            &emu8k->reverb_in_buffer[emu8k->pos],
+                            &emu8k->chorus_in_buffer[emu8k->pos]);
+    }
 
     buf = &emu8k->buffer[emu8k->pos * 2];
     emu8k_work_reverb(&emu8k->reverb_in_buffer[emu8k->pos], buf, &emu8k->reverb_engine, new_pos - emu8k->pos);
@@ -2385,11 +2469,29 @@ emu8k_init(emu8k_t *emu8k, uint16_t emu_addr, int onboard_ram)
     emu8k->hwcf2 = 0x20;
     /* Initial state is muted. 0x04 is unmuted. */
     emu8k->hwcf3 = 0x00;
+
+    emu8k->render_run = 1;
+    for (c = 0; c < EMU8K_RENDER_THREADS; c++) {
+        emu8k->render_wake[c] = thread_create_event();
+        emu8k->render_done[c] = thread_create_event();
+    }
+    emu8k->render_thread[0] = thread_create_named(emu8k_render_thread_1, emu8k, "EMU8K render 1");
+    emu8k->render_thread[1] = thread_create_named(emu8k_render_thread_2, emu8k, "EMU8K render 2");
 }
 
 void
 emu8k_close(emu8k_t *emu8k)
 {
+    emu8k->render_run = 0;
+    for (int c = 0; c < EMU8K_RENDER_THREADS; c++)
+        thread_set_event(emu8k->render_wake[c]);
+    for (int c = 0; c < EMU8K_RENDER_THREADS; c++) {
+        thread_wait(emu8k->render_thread[c]);
+        thread_destroy_event(emu8k->render_wake[c]);
+        thread_destroy_event(emu8k->render_done[c]);
+        emu8k->render_thread[c] = NULL;
+    }
+
     free(emu8k->rom);
     free(emu8k->ram);
 }
@@ -48,6 +48,9 @@ enum {
     GUS_MAX     = 1,
 };
 
+/*Upper bound on how many sample clocks one wave timer event may cover*/
+#define GUS_WAVE_BLOCK 64
+
 typedef struct gus_t {
     int reset;
 
@@ -94,6 +97,8 @@ typedef struct gus_t {
 
     pc_timer_t samp_timer;
     uint64_t   samp_latch;
+    int        samp_batch; /* sample clocks covered by the pending wave timer event */
+    int        samp_done;  /* clocks of that batch already rendered by catch-up */
 
     uint8_t *ram;
     uint32_t gus_end_ram;
@@ -153,6 +158,8 @@ typedef struct gus_t {
 
 static int gus_gf1_irqs[8]  = { -1, 2, 5, 3, 7, 11, 12, 15 };
 static int gus_midi_irqs[8] = { -1, 2, 5, 3, 7, 11, 12, 15 };
+
+static void gus_wave_catchup(gus_t *gus);
 static int gus_dmas[8]      = { -1, 1, 3, 5, 6, 7, -1, -1 };
 
 int gusfreqs[] = {
@@ -260,6 +267,8 @@ writegus(uint16_t addr, uint8_t val, void *priv)
     uint16_t csioport;
 #endif
 
+    gus_wave_catchup(gus);
+
     if ((addr == 0x388) || (addr == 0x389))
         port = addr;
     else
@@ -718,6 +727,8 @@ readgus(uint16_t addr, void *priv)
     uint8_t  val = 0xff;
     uint16_t port;
 
+    gus_wave_catchup(gus);
+
     if ((addr == 0x388) || (addr == 0x389))
         port = addr;
     else
@@ -1006,9 +1017,11 @@ gus_poll_timer_2(void *priv)
 }
 
 static void
-gus_update(gus_t *gus)
+gus_update_to(gus_t *gus, int32_t limit)
 {
-    for (; gus->pos < sound_pos_global; gus->pos++) {
+    if (limit > sound_pos_global)
+        limit = sound_pos_global;
+    for (; gus->pos < limit; gus->pos++) {
         if (gus->out_l < -32768)
             gus->buffer[0][gus->pos] = -32768;
         else if (gus->out_l > 32767)
@@ -1024,19 +1037,20 @@ gus_update(gus_t *gus)
     }
 }
 
-void
-gus_poll_wave(void *priv)
+static void
+gus_update(gus_t *gus)
+{
+    gus_update_to(gus, sound_pos_global);
+}
+
+static void
+gus_poll_wave_tick(gus_t *gus)
 {
-    gus_t   *gus = (gus_t *) priv;
     uint32_t addr;
     int16_t  v;
     int32_t  vl;
     int      update_irqs = 0;
 
-    gus_update(gus);
-
-    timer_advance_u64(&gus->samp_timer, gus->samp_latch);
-
     gus->out_l = gus->out_r = 0;
 
     if ((gus->reset & 3) != 3)
@@ -1177,6 +1191,216 @@ gus_poll_wave(void *priv)
         gus_update_int_status(gus);
 }
 
+/* How many sample clocks from the current state are free of voice
+   boundaries (wave loop/end, ramp end). Within that horizon every running
+   voice advances linearly, so a block can be rendered without per-sample
+   control flow and a timer event may safely cover it. Returns at least 1;
+   the serial tick handles the boundary sample itself. */
+static int
+gus_wave_horizon(gus_t *gus)
+{
+    uint32_t n = GUS_WAVE_BLOCK;
+
+    if ((gus->reset & 3) != 3)
+        return 1;
+
+    for (uint8_t d = 0; d < 32; d++) {
+        if (!(gus->ctrl[d] & 3)) {
+            const uint32_t step = gus->freq[d] >> 1;
+
+            if (step) {
+                uint32_t dist;
+                uint32_t safe;
+
+                if (gus->ctrl[d] & 0x40)
+                    dist = (gus->cur[d] > gus->start[d]) ? (gus->cur[d] - gus->start[d]) : 0;
+                else
+                    dist = (gus->cur[d] < gus->end[d]) ? (gus->end[d] - gus->cur[d]) : 0;
+
+                safe = dist ? ((dist - 1) / step) : 0;
+                if (safe < n)
+                    n = safe;
+            }
+        }
+        if (!(gus->rctrl[d] & 3) && gus->rfreq[d]) {
+            int32_t  dist;
+            uint32_t safe;
+
+            if (gus->rctrl[d] & 0x40)
+                dist = gus->rcur[d] - gus->rstart[d];
+            else
+                dist = gus->rend[d] - gus->rcur[d];
+            if (dist < 0)
+                dist = 0;
+
+            safe = dist ? (((uint32_t) dist - 1) / gus->rfreq[d]) : 0;
+            if (safe < n)
+                n = safe;
+        }
+    }
+
+    return (n < 1) ? 1 : (int) n;
+}
+
+/* Render a boundary-free block voice-major: the per-voice inner loops have
+   no control flow the compiler cannot hoist, so they are open to
+   vectorization, and each voice touches its own state exactly once. */
+static void
+gus_poll_wave_block(gus_t *gus, int n, int32_t *acc_l, int32_t *acc_r)
+{
+    uint32_t addr;
+    int16_t  v;
+    int32_t  vl;
+
+    for (int i = 0; i < n; i++)
+        acc_l[i] = acc_r[i] = 0;
+
+    for (uint8_t d = 0; d < 32; d++) {
+        const int32_t rstep = (gus->rctrl[d] & 3) ? 0 : ((gus->rctrl[d] & 0x40) ? -((int32_t) gus->rfreq[d]) : ((int32_t) gus->rfreq[d]));
+
+        if (!(gus->ctrl[d] & 3)) {
+            const int32_t wstep = (gus->ctrl[d] & 0x40) ? -((int32_t) (gus->freq[d] >> 1)) : ((int32_t) (gus->freq[d] >> 1));
+            uint32_t      cur   = gus->cur[d];
+            int32_t       rcur  = gus->rcur[d];
+
+            for (int i = 0; i < n; i++) {
+                if (gus->ctrl[d] & 4) {
+                    addr = cur >> 9;
+                    addr = (addr & 0xC0000) | ((addr << 1) & 0x3FFFE);
+                    if (!(gus->freq[d] >> 10)) {
+                        /* Interpolate */
+                        if (((addr + 1) & 0xfffff) < gus->gus_end_ram)
+                            vl = (int16_t) (int8_t) ((gus->ram[(addr + 1) & 0xfffff] ^ 0x80) - 0x80) *
+                                 (511 - (cur & 511));
+                        else
+                            vl = 0;
+
+                        if (((addr + 3) & 0xfffff) < gus->gus_end_ram)
+                            vl += (int16_t) (int8_t) ((gus->ram[(addr + 3) & 0xfffff] ^ 0x80) - 0x80) *
+                                  (cur & 511);
+
+                        v = vl >> 9;
+                    } else if (((addr + 1) & 0xfffff) < gus->gus_end_ram)
+                        v = (int16_t) (int8_t) ((gus->ram[(addr + 1) & 0xfffff] ^ 0x80) - 0x80);
+                    else
+                        v = 0x0000;
+                } else {
+                    if (!(gus->freq[d] >> 10)) {
+                        /* Interpolate */
+                        if (((cur >> 9) & 0xfffff) < gus->gus_end_ram)
+                            vl = ((int8_t) ((gus->ram[(cur >> 9) & 0xfffff] ^ 0x80) - 0x80)) *
+                                           (511 - (cur & 511));
+                        else
+                            vl = 0;
+
+                        if ((((cur >> 9) + 1) & 0xfffff) < gus->gus_end_ram)
+                            vl += ((int8_t) ((gus->ram[((cur >> 9) + 1) & 0xfffff] ^ 0x80) - 0x80)) *
+                                  (cur & 511);
+
+                        v = vl >> 9;
+                    } else if (((cur >> 9) & 0xfffff) < gus->gus_end_ram)
+                        v = (int16_t) (int8_t) ((gus->ram[(cur >> 9) & 0xfffff] ^ 0x80) - 0x80);
+                    else
+                        v = 0x0000;
+                }
+
+                if ((rcur >> 14) > 4095)
+                    v = (int16_t) (float) (v) *24.0 * vol16bit[4095];
+                else
+                    v = (int16_t) (float) (v) *24.0 * vol16bit[(rcur >> 10) & 4095];
+
+                acc_l[i] += (v * gus->pan_l[d]) / 7;
+                acc_r[i] += (v * gus->pan_r[d]) / 7;
+
+                cur += (uint32_t) wstep;
+                rcur += rstep;
+            }
+
+            gus->cur[d]  = cur;
+            gus->rcur[d] = rcur;
+        } else
+            gus->rcur[d] += (int32_t) n * rstep;
+    }
+}
+
+/* Run n sample clocks, re-checking the boundary horizon as it goes: spans
+   with no boundary in sight render as voice-major blocks, boundary samples
+   fall back to the serial tick. Each sample still latches at its own
+   back-computed mixer position. */
+static void
+gus_poll_wave_run(gus_t *gus, int n)
+{
+    const double fps = ((double) gus->samp_latch * SOUND_FREQ) / ((double) TIMER_USEC * 1000000.0);
+    int32_t      acc_l[GUS_WAVE_BLOCK];
+    int32_t      acc_r[GUS_WAVE_BLOCK];
+    int          done = 0;
+
+    while (done < n) {
+        int block = n - done;
+        int safe  = gus_wave_horizon(gus);
+
+        if (block > safe)
+            block = safe;
+
+        if (block > 1) {
+            gus_poll_wave_block(gus, block, acc_l, acc_r);
+            for (int i = 0; i < block; i++) {
+                gus_update_to(gus, sound_pos_global - (int32_t) (((double) (n - 1 - done - i)) * fps + 0.5));
+                gus->out_l = acc_l[i];
+                gus->out_r = acc_r[i];
+            }
+            done += block;
+        } else {
+            gus_update_to(gus, sound_pos_global - (int32_t) (((double) (n - 1 - done)) * fps + 0.5));
+            gus_poll_wave_tick(gus);
+            done++;
+        }
+    }
+}
+
+/* Bring the voice state up to the present before a guest register access,
+   so mid-batch reads of voice position and volume see current values and
+   writes land on current state. */
+static void
+gus_wave_catchup(gus_t *gus)
+{
+    if ((gus->samp_batch > 1) && timer_is_enabled(&gus->samp_timer)) {
+        const uint64_t total     = gus->samp_latch * (uint64_t) gus->samp_batch;
+        const uint64_t remaining = timer_get_remaining_u64(&gus->samp_timer);
+        int            elapsed   = 0;
+
+        if (remaining < total)
+            elapsed = (int) ((total - remaining) / gus->samp_latch);
+
+        while (gus->samp_done < elapsed) {
+            gus_update(gus);
+            gus_poll_wave_tick(gus);
+            gus->samp_done++;
+        }
+    }
+}
+
+void
+gus_poll_wave(void *priv)
+{
+    gus_t *gus = (gus_t *) priv;
+    int    n   = (gus->samp_batch > 0) ? gus->samp_batch : 1;
+
+    /* Render the interval that just elapsed - less whatever a mid-batch
+       register access already caught up - then size and schedule the next
+       batch. Rendering lazily like this keeps gus_wave_catchup()'s elapsed
+       math and the per-sample position back-computation in step with the
+       timer: the newest tick always lands at the current mixer position. */
+    n -= gus->samp_done;
+    gus->samp_done = 0;
+
+    if (n > 0)
+        gus_poll_wave_run(gus, n);
+
+    gus->samp_batch = gus_wave_horizon(gus);
+    timer_advance_u64(&gus->samp_timer, gus->samp_latch * (uint64_t) gus->samp_batch);
+}
+
 static void
 gus_get_buffer(int32_t *buffer, int len, void *priv)
 {
@@ -30,17 +30,298 @@
 #include <86box/86box.h>
 #include <86box/device.h>
 #include <86box/io.h>
+#include <86box/timer.h>
 #include <86box/sound.h>
 #include <86box/snd_opl.h>
+#include <86box/plat_unused.h>
 
 static uint32_t fm_dev_inst[FM_DRV_MAX][FM_MAX];
 
+/* Capture driver: for music-capture workloads the synthesized audio is thrown
+   away, so instead of running nuked/ymfm this driver appends every register
+   write to a compact timestamped log (to be synthesized offline) and hands the
+   mixer silence. Only the timers are still emulated, since detection routines
+   and drivers poll the status register for timing. */
+
+enum {
+    STAT_TMR_OVER  = 0x60,
+    STAT_TMR1_OVER = 0x40,
+    STAT_TMR2_OVER = 0x20,
+    STAT_TMR_ANY   = 0x80
+};
+
+enum {
+    CTRL_RESET      = 0x80,
+    CTRL_TMR_MASK   = 0x60,
+    CTRL_TMR2_START = 0x02,
+    CTRL_TMR1_START = 0x01
+};
+
+#define CAPTURE_FLAG_OPL3   0x01
+#define CAPTURE_FLAG_CYCLES 0x02
+
+/* 10-byte magic, then one byte of chip type (enum fm_type). Records follow:
+   32-bit little-endian delay in microseconds since the previous record,
+   16-bit little-endian register index, one byte of data. */
+#define OPL_CAPTURE_MAGIC "86BOPLCAP1"
+
+typedef struct opl_capture_t {
+    uint8_t  flags;
+    uint8_t  status;
+    uint8_t  timer_ctrl;
+    uint8_t  newm;
+    uint16_t port;
+    uint16_t timer_count[2];
+    uint16_t timer_cur_count[2];
+
+    pc_timer_t timers[2];
+
+    FILE    *file;
+    uint64_t last_tsc;
+
+    int32_t buffer[SOUNDBUFLEN * 2];
+} opl_capture_t;
+
+static void
+opl_capture_append(opl_capture_t *dev, uint16_t reg, uint8_t val)
+{
+    uint8_t  rec[7];
+    uint64_t delta = (tsc - dev->last_tsc) / TIMER_USEC;
+
+    if (dev->file == NULL)
+        return;
+
+    if (delta > 0xffffffffULL)
+        delta = 0xffffffffULL;
+    /* Advance by whole microseconds only, so sub-microsecond remainders
+       accumulate instead of being dropped on every record. */
+    dev->last_tsc += delta * TIMER_USEC;
+
+    rec[0] = delta & 0xff;
+    rec[1] = (delta >> 8) & 0xff;
+    rec[2] = (delta >> 16) & 0xff;
+    rec[3] = (delta >> 24) & 0xff;
+    rec[4] = reg & 0xff;
+    rec[5] = (reg >> 8) & 0xff;
+    rec[6] = val;
+
+    fwrite(rec, 1, sizeof(rec), dev->file);
+}
+
+static void
+opl_capture_timer_tick(opl_capture_t *dev, int tmr)
+{
+    dev->timer_cur_count[tmr] = (dev->timer_cur_count[tmr] + 1) & 0xff;
+
+    if (dev->timer_cur_count[tmr] == 0x00) {
+        dev->status |= ((STAT_TMR1_OVER >> tmr) & ~dev->timer_ctrl);
+        dev->timer_cur_count[tmr] = dev->timer_count[tmr];
+    }
+
+    timer_on_auto(&dev->timers[tmr], (tmr == 1) ? 320.0 : 80.0);
+}
+
+static void
+opl_capture_timer_control(opl_capture_t *dev, int tmr, int start)
+{
+    timer_on_auto(&dev->timers[tmr], 0.0);
+
+    if (start) {
+        dev->timer_cur_count[tmr] = dev->timer_count[tmr];
+        if (dev->flags & CAPTURE_FLAG_OPL3)
+            opl_capture_timer_tick(dev, tmr); /* OPL3 starts counting immediately, unlike OPL2. */
+        else
+            timer_on_auto(&dev->timers[tmr], (tmr == 1) ? 320.0 : 80.0);
+    }
+}
+
+static void
+opl_capture_timer_1(void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    opl_capture_timer_tick(dev, 0);
+}
+
+static void
+opl_capture_timer_2(void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    opl_capture_timer_tick(dev, 1);
+}
+
+static void *
+opl_capture_init(const device_t *info)
+{
+    static uint32_t capture_inst = 0;
+    char            fn[1024 + 32];
+
+    opl_capture_t *dev = (opl_capture_t *) calloc(1, sizeof(opl_capture_t));
+    dev->flags         = CAPTURE_FLAG_CYCLES;
+    if (info->local == FM_YMF262)
+        dev->flags |= CAPTURE_FLAG_OPL3;
+    else
+        dev->status = 0x06;
+
+    snprintf(fn, sizeof(fn), "%sopl_capture_%u.bin", usr_path, capture_inst++);
+    dev->file = fopen(fn, "wb");
+    if (dev->file != NULL) {
+        fwrite(OPL_CAPTURE_MAGIC, 1, sizeof(OPL_CAPTURE_MAGIC) - 1, dev->file);
+        fputc(info->local, dev->file);
+    }
+    dev->last_tsc = tsc;
+
+    timer_add(&dev->timers[0], opl_capture_timer_1, dev, 0);
+    timer_add(&dev->timers[1], opl_capture_timer_2, dev, 0);
+
+    return dev;
+}
+
+static void
+opl_capture_close(void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    if (dev->file != NULL)
+        fclose(dev->file);
+
+    free(dev);
+}
+
+static int32_t *
+opl_capture_update(void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    /* Nothing is synthesized; the buffer stays silent. */
+    return dev->buffer;
+}
+
+static uint8_t
+opl_capture_read(uint16_t port, void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    if (dev->flags & CAPTURE_FLAG_CYCLES)
+        cycles -= ((int) (isa_timing * 8));
+
+    uint8_t ret = 0xff;
+
+    if ((port & 0x0003) == 0x0000) {
+        ret = dev->status;
+        if (dev->status & STAT_TMR_OVER)
+            ret |= STAT_TMR_ANY;
+    }
+
+    return ret;
+}
+
+static void
+opl_capture_write(uint16_t port, uint8_t val, void *priv)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    if ((port & 0x0001) == 0x0001) {
+        opl_capture_append(dev, dev->port, val);
+
+        switch (dev->port) {
+            case 0x002: /* Timer 1 */
+                dev->timer_count[0] = val;
+                break;
+
+            case 0x003: /* Timer 2 */
+                dev->timer_count[1] = val;
+                break;
+
+            case 0x004: /* Timer control */
+                if (val & CTRL_RESET)
+                    dev->status &= ~STAT_TMR_OVER;
+                else {
+                    dev->timer_ctrl = val;
+                    opl_capture_timer_control(dev, 0, val & CTRL_TMR1_START);
+                    opl_capture_timer_control(dev, 1, val & CTRL_TMR2_START);
+                }
+                break;
+
+            case 0x105:
+                dev->newm = val & 0x01;
+                break;
+
+            default:
+                break;
+        }
+    } else {
+        dev->port = val;
+        if ((dev->flags & CAPTURE_FLAG_OPL3) && (port & 0x0002) && dev->newm)
+            dev->port |= 0x100;
+    }
+}
+
+static void
+opl_capture_reset_buffer(UNUSED(void *priv))
+{
+    /* The silent buffer needs no position tracking. */
+}
+
+static void
+opl_capture_set_do_cycles(void *priv, int8_t do_cycles)
+{
+    opl_capture_t *dev = (opl_capture_t *) priv;
+
+    if (do_cycles)
+        dev->flags |= CAPTURE_FLAG_CYCLES;
+    else
+        dev->flags &= ~CAPTURE_FLAG_CYCLES;
+}
+
+const device_t ym3812_capture_device = {
+    .name          = "Yamaha YM3812 OPL2 (Register Capture)",
+    .internal_name = "ym3812_capture",
+    .flags         = 0,
+    .local         = FM_YM3812,
+    .init          = opl_capture_init,
+    .close         = opl_capture_close,
+    .reset         = NULL,
+    { .available = NULL },
+    .speed_changed = NULL,
+    .force_redraw  = NULL,
+    .config        = NULL
+};
+
+const device_t ymf262_capture_device = {
+    .name          = "Yamaha YMF262 OPL3 (Register Capture)",
+    .internal_name = "ymf262_capture",
+    .flags         = 0,
+    .local         = FM_YMF262,
+    .init          = opl_capture_init,
+    .close         = opl_capture_close,
+    .reset         = NULL,
+    { .available = NULL },
+    .speed_changed = NULL,
+    .force_redraw  = NULL,
+    .config        = NULL
+};
+
+const fm_drv_t opl_capture_drv = {
+    &opl_capture_read,
+    &opl_capture_write,
+    &opl_capture_update,
+    &opl_capture_reset_buffer,
+    &opl_capture_set_do_cycles,
+    NULL,
+    NULL,
+};
+
 uint8_t
 fm_driver_get(int chip_id, fm_drv_t *drv)
 {
     switch (chip_id) {
         case FM_YM3812:
-            if (fm_driver == FM_DRV_NUKED) {
+            if (fm_driver == FM_DRV_CAPTURE) {
+                *drv      = opl_capture_drv;
+                drv->priv = device_add_inst(&ym3812_capture_device, fm_dev_inst[fm_driver][chip_id]++);
+            } else if (fm_driver == FM_DRV_NUKED) {
                 *drv      = nuked_opl_drv;
                 drv->priv = device_add_inst(&ym3812_nuked_device, fm_dev_inst[fm_driver][chip_id]++);
             } else {
@@ -50,7 +331,10 @@ fm_driver_get(int chip_id, fm_drv_t *drv)
             break;
 
         case FM_YMF262:
-            if (fm_driver == FM_DRV_NUKED) {
+            if (fm_driver == FM_DRV_CAPTURE) {
+                *drv      = opl_capture_drv;
+                drv->priv = device_add_inst(&ymf262_capture_device, fm_dev_inst[fm_driver][chip_id]++);
+            } else if (fm_driver == FM_DRV_NUKED) {
                 *drv      = nuked_opl_drv;
                 drv->priv = device_add_inst(&ymf262_nuked_device, fm_dev_inst[fm_driver][chip_id]++);
             } else {
@@ -1248,6 +1248,32 @@ nuked_write_reg_buffered(void *priv, uint16_t reg, uint8_t val)
     dev->wrbuf_last                  = (dev->wrbuf_last + 1) % WRBUF_SIZE;
 }
 
+/* The chip is quiescent when every slot's envelope has fully released and
+   all operator outputs and feedback memories have decayed to zero, with
+   rhythm mode off. In that state the envelope and output stages of every
+   slot are no-ops, so a sample only has to run the phase generators (which
+   also step the noise LFSR) and the global counters to keep the state
+   bit-exact for whenever the chip is keyed on again. */
+static int
+nuked_quiescent(nuked_t *dev)
+{
+    const slot_t *slot;
+
+    if (dev->rhy & 0x20)
+        return 0;
+
+    for (uint8_t i = 0; i < 36; i++) {
+        slot = &dev->slot[i];
+
+        if (slot->key || (slot->eg_gen != envelope_gen_num_release) || (slot->eg_rout != 0x1ff))
+            return 0;
+        if (slot->out || slot->prout || slot->fbmod)
+            return 0;
+    }
+
+    return 1;
+}
+
 void
 nuked_generate(void *priv, int32_t *bufp)
 {
@@ -1259,6 +1285,18 @@ nuked_generate(void *priv, int32_t *bufp)
 
     bufp[1] = dev->mixbuff[1];
 
+    if (nuked_quiescent(dev)) {
+        /* Silent fast path - the full pipeline would produce all zeroes. */
+        dev->mixbuff[0] = 0;
+        bufp[0]         = 0;
+        dev->mixbuff[1] = 0;
+
+        for (i = 0; i < 36; i++)
+            phase_generate(&dev->slot[i]);
+
+        goto counters;
+    }
+
     for (i = 0; i < 15; i++) {
         slot_calc_fb(&dev->slot[i]);
         env_calc(&dev->slot[i]);
@@ -1310,6 +1348,7 @@ nuked_generate(void *priv, int32_t *bufp)
         slot_generate(&dev->slot[i]);
     }
 
+counters:
     if ((dev->timer & 0x3f) == 0x3f)
         dev->tremolopos = (dev->tremolopos + 1) % 210;
 
@@ -146,50 +146,75 @@ public:
         ymfm_set_timer(1, m_duration_in_clocks[1]);
     }
 
-    virtual void generate(int32_t *data, uint32_t num_samples) override
+    /* Native-rate samples are pulled out of the chip in blocks through its
+       block generate() interface, rather than one virtual call per sample
+       interleaved with the rate conversion arithmetic. */
+    static constexpr uint32_t GEN_BLOCK = 128;
+
+    inline void chip_sample_to_stereo(const typename ChipType::output_data &out, int32_t *left, int32_t *right)
     {
-        for (uint32_t i = 0; i < num_samples; i++) {
-            m_chip.generate(&m_output);
-            if ((m_type == FM_YMF278B) && (sizeof(m_output.data) > (4 * sizeof(int32_t)))) {
-                if (ChipType::OUTPUTS == 1) {
-                    *data++ = m_output.data[4];
-                    *data++ = m_output.data[4];
-                } else {
-                    *data++ = m_output.data[4];
-                    *data++ = m_output.data[5];
-                }
-            } else if (ChipType::OUTPUTS == 1) {
-                *data++ = m_output.data[0];
-                *data++ = m_output.data[0];
+        if ((m_type == FM_YMF278B) && (sizeof(out.data) > (4 * sizeof(int32_t)))) {
+            if (ChipType::OUTPUTS == 1) {
+                *left  = out.data[4];
+                *right = out.data[4];
             } else {
-                *data++ = m_output.data[0];
-                *data++ = m_output.data[1 % ChipType::OUTPUTS];
+                *left  = out.data[4];
+                *right = out.data[5];
+            }
+        } else if (ChipType::OUTPUTS == 1) {
+            *left  = out.data[0];
+            *right = out.data[0];
+        } else {
+            *left  = out.data[0];
+            *right = out.data[1 % ChipType::OUTPUTS];
+        }
+    }
+
+    virtual void generate(int32_t *data, uint32_t num_samples) override
+    {
+        typename ChipType::output_data block[GEN_BLOCK];
+
+        while (num_samples > 0) {
+            const uint32_t n = (num_samples > GEN_BLOCK) ? GEN_BLOCK : num_samples;
+            m_chip.generate(block, n);
+            for (uint32_t i = 0; i < n; i++) {
+                chip_sample_to_stereo(block[i], &data[0], &data[1]);
+                data += 2;
             }
+            num_samples -= n;
         }
     }
 
     virtual void generate_resampled(int32_t *data, uint32_t num_samples) override
     {
+        typename ChipType::output_data block[GEN_BLOCK];
+
+        /* Count the native samples the interpolator will consume over this
+           span, so the chip is never over-advanced. */
+        uint32_t needed = 0;
+        int32_t  cnt    = m_samplecnt;
+        for (uint32_t i = 0; i < num_samples; i++) {
+            while (cnt >= m_rateratio) {
+                needed++;
+                cnt -= m_rateratio;
+            }
+            cnt += 1 << RSM_FRAC;
+        }
+
+        uint32_t avail = 0;
+        uint32_t idx   = 0;
+
         for (uint32_t i = 0; i < num_samples; i++) {
             while (m_samplecnt >= m_rateratio) {
+                if (idx == avail) {
+                    avail = (needed > GEN_BLOCK) ? GEN_BLOCK : needed;
+                    m_chip.generate(block, avail);
+                    needed -= avail;
+                    idx = 0;
+                }
                 m_oldsamples[0] = m_samples[0];
                 m_oldsamples[1] = m_samples[1];
-                m_chip.generate(&m_output);
-                if ((m_type == FM_YMF278B) && (sizeof(m_output.data) > (4 * sizeof(int32_t)))) {
-                    if (ChipType::OUTPUTS == 1) {
-                        m_samples[0] = m_output.data[4];
-                        m_samples[1] = m_output.data[4];
-                    } else {
-                        m_samples[0] = m_output.data[4];
-                        m_samples[1] = m_output.data[5];
-                    }
-                } else if (ChipType::OUTPUTS == 1) {
-                    m_samples[0] = m_output.data[0];
-                    m_samples[1] = m_output.data[0];
-                } else {
-                    m_samples[0] = m_output.data[0];
-                    m_samples[1] = m_output.data[1 % ChipType::OUTPUTS];
-                }
+                chip_sample_to_stereo(block[idx++], &m_samples[0], &m_samples[1]);
                 m_samplecnt -= m_rateratio;
             }
 
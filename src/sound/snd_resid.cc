@@ -13,6 +13,7 @@ typedef struct psid_t {
     /* resid sid implementation */
     SIDFP  *sid;
     int16_t last_sample;
+    int     quality;
 } psid_t;
 
 psid_t *psid;
@@ -60,9 +61,29 @@ sid_init(void)
     psid->sid->input(0);
     psid->sid->get_filter().set_type3_properties(1.33e6f, 2.2e9f, 1.0056f, 7e3f);
 
+    psid->quality = SID_QUALITY_HIGH;
+
     return (void *) psid;
 }
 
+void
+sid_set_quality(UNUSED(void *priv), int quality)
+{
+#if 0
+    psid_t *psid = (psid_t *) priv;
+#endif
+
+    if (psid->quality == quality)
+        return;
+
+    /* Safe to flip at any point during playback: the filter stages
+       short-circuit to a pass-through when disabled and no sampling
+       state is touched, so there is no glitch on switch. */
+    psid->quality = quality;
+    psid->sid->enable_filter(quality != SID_QUALITY_FAST);
+    psid->sid->enable_external_filter(quality != SID_QUALITY_FAST);
+}
+
 void
 sid_close(UNUSED(void *priv))
 {
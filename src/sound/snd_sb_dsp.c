@@ -35,9 +35,14 @@
 /*The recording safety margin is intended for uneven "len" calls to the get_buffer mixer calls on sound_sb*/
 #define SB_DSP_REC_SAFEFTY_MARGIN 4096
 
+/*Upper bound on how many sample clocks one output timer event may cover*/
+#define SB_DSP_MAX_BATCH 64
+
 void pollsb(void *priv);
 void sb_poll_i(void *priv);
 
+static void sb_dsp_update_to(sb_dsp_t *dsp, int32_t limit);
+
 static int sbe2dat[4][9] = {
     {0x01,   -0x02, -0x04, 0x08,  -0x10, 0x20,  0x40,  -0x80, -106},
     { -0x01, 0x02,  -0x04, 0x08,  0x10,  -0x20, 0x40,  -0x80, 165 },
@@ -273,6 +278,9 @@ sb_dsp_reset(sb_dsp_t *dsp)
     timer_disable(&dsp->output_timer);
     timer_disable(&dsp->input_timer);
 
+    dsp->sb_output_batch = 0;
+    dsp->sb_output_latch = 0.0;
+
     dsp->sb_command = 0;
 
     dsp->sb_8_length  = 0xffff;
@@ -359,8 +367,11 @@ sb_start_dma(sb_dsp_t *dsp, int dma8, int autoinit, uint8_t format, int len)
         if (dsp->sb_16_enable && dsp->sb_16_output)
             dsp->sb_16_enable = 0;
         dsp->sb_8_output = 1;
-        if (!timer_is_enabled(&dsp->output_timer))
+        if (!timer_is_enabled(&dsp->output_timer)) {
             timer_set_delay_u64(&dsp->output_timer, dsp->sblatcho);
+            dsp->sb_output_batch = 1;
+            dsp->sb_output_latch = dsp->sblatcho;
+        }
         dsp->sbleftright = dsp->sbleftright_default;
         dsp->sbdacpos    = 0;
     } else {
@@ -372,8 +383,11 @@ sb_start_dma(sb_dsp_t *dsp, int dma8, int autoinit, uint8_t format, int len)
         if (dsp->sb_8_enable && dsp->sb_8_output)
             dsp->sb_8_enable = 0;
         dsp->sb_16_output = 1;
-        if (!timer_is_enabled(&dsp->output_timer))
+        if (!timer_is_enabled(&dsp->output_timer)) {
             timer_set_delay_u64(&dsp->output_timer, dsp->sblatcho);
+            dsp->sb_output_batch = 1;
+            dsp->sb_output_latch = dsp->sblatcho;
+        }
     }
 }
 
@@ -439,8 +453,9 @@ int
 sb_16_read_dma(void *priv)
 {
     const sb_dsp_t *dsp = (sb_dsp_t *) priv;
+    uint8_t buf[2] = { 0, 0 };
     int temp, ret = 0;
-    int dma_flags, dma_ch = dsp->sb_16_dmanum;
+    int dma_ch = dsp->sb_16_dmanum;
 
     if (dsp->sb_16_dma_enabled && dsp->sb_16_dma_supported && !dsp->sb_16_dma_translate)
         ret = dma_channel_read(dma_ch);
@@ -453,18 +468,13 @@ sb_16_read_dma(void *priv)
         } else
             /* High DMA channel disabled, always use the first 8-bit channel. */
             dma_ch = dsp->sb_8_dmanum;
-        temp = dma_channel_read(dma_ch);
-        ret = temp;
-        if ((temp != DMA_NODATA) && !(temp & DMA_OVER)) {
-            temp = dma_channel_read(dma_ch);
-            if (temp == DMA_NODATA)
-                ret = DMA_NODATA;
-            else {
-                dma_flags = temp & DMA_OVER;
-                temp &= ~DMA_OVER;
-                ret |= (temp << 8) | dma_flags;
-           }
-        }
+        temp = dma_channel_read_block(dma_ch, buf, 2);
+        if (temp == DMA_NODATA)
+            ret = DMA_NODATA;
+        else if ((temp & ~DMA_OVER) < 2)
+            ret = buf[0] | (temp & DMA_OVER);
+        else
+            ret = buf[0] | (buf[1] << 8) | (temp & DMA_OVER);
     }
 
     return ret;
@@ -474,9 +484,10 @@ int
 sb_16_write_dma(void *priv, uint16_t val)
 {
     const sb_dsp_t *dsp = (sb_dsp_t *) priv;
+    uint8_t buf[2] = { val & 0xff, val >> 8 };
     int temp, ret = 0;
     int dma_ch = dsp->sb_16_dmanum;
- 
+
     if (dsp->sb_16_dma_enabled && dsp->sb_16_dma_supported && !dsp->sb_16_dma_translate)
         ret = dma_channel_write(dma_ch, val) == DMA_NODATA;
     else {
@@ -488,12 +499,11 @@ sb_16_write_dma(void *priv, uint16_t val)
         } else
             /* High DMA channel disabled, always use the first 8-bit channel. */
             dma_ch = dsp->sb_8_dmanum;
-        temp = dma_channel_write(dma_ch, val & 0xff);
-        ret = temp;
-        if ((temp != DMA_NODATA) && (temp != DMA_OVER)) {
-            temp = dma_channel_write(dma_ch, val >> 8);
-            ret = temp;
-        }
+        temp = dma_channel_write_block(dma_ch, buf, 2);
+        if (temp == DMA_NODATA)
+            ret = DMA_NODATA;
+        else if (temp & DMA_OVER)
+            ret = DMA_OVER;
     }
 
     return ret;
@@ -821,8 +831,11 @@ sb_exec_command(sb_dsp_t *dsp)
             break;
         case 0x80: /* Pause DAC */
             dsp->sb_pausetime = dsp->sb_data[0] + (dsp->sb_data[1] << 8);
-            if (!timer_is_enabled(&dsp->output_timer))
+            if (!timer_is_enabled(&dsp->output_timer)) {
                 timer_set_delay_u64(&dsp->output_timer, dsp->sblatcho);
+                dsp->sb_output_batch = 1;
+                dsp->sb_output_latch = dsp->sblatcho;
+            }
             break;
         case 0x90: /* High speed 8-bit autoinit DMA output */
             if (dsp->sb_type >= SB2)
@@ -1311,17 +1324,53 @@ sb_dsp_dma_attach(sb_dsp_t *dsp,
     dsp->dma_priv   = priv;
 }
 
-void
-pollsb(void *priv)
+/* How many sample clocks the next output timer event may safely cover.
+   Batching only applies to the plain PCM formats in steady state; ADPCM,
+   pauses and concurrent 8/16-bit transfers stay at one sample per event,
+   and a batch never runs past the sample whose fetch raises the IRQ. */
+static int
+sb_dsp_output_batch(sb_dsp_t *dsp)
 {
-    sb_dsp_t *dsp = (sb_dsp_t *) priv;
-    int       tempi;
-    int       ref;
-    int       data[2];
+    int remain;
+    int max;
+
+    if (dsp->sb_pausetime > -1)
+        return 1;
+
+    if (dsp->sb_8_enable && dsp->sb_8_output && !(dsp->sb_16_enable && dsp->sb_16_output)) {
+        if (dsp->sb_8_pause || (dsp->sb_8_format & ~0x30))
+            return 1;
+        remain = ((dsp->sb_8_format & 0x20) ? (dsp->sb_8_length >> 1) : dsp->sb_8_length) + 1;
+    } else if (dsp->sb_16_enable && dsp->sb_16_output && !(dsp->sb_8_enable && dsp->sb_8_output)) {
+        if (dsp->sb_16_pause || (dsp->sb_16_format & ~0x30))
+            return 1;
+        remain = ((dsp->sb_16_format & 0x20) ? (dsp->sb_16_length >> 1) : dsp->sb_16_length) + 1;
+    } else
+        return 1;
+
+    if (remain < 1)
+        remain = 1;
+
+    /* Cap the batch at ~500us so DSP commands issued mid-transfer are not
+       deferred by more than half a millisecond. */
+    max = (int) ((TIMER_USEC * 500.0) / dsp->sblatcho);
+    if (max > SB_DSP_MAX_BATCH)
+        max = SB_DSP_MAX_BATCH;
+    if (max < 1)
+        max = 1;
+
+    return (remain < max) ? remain : max;
+}
+
+static void
+sb_dsp_output_tick(sb_dsp_t *dsp, int32_t limit)
+{
+    int tempi;
+    int ref;
+    int data[2];
 
-    timer_advance_u64(&dsp->output_timer, dsp->sblatcho);
     if (dsp->sb_8_enable && !dsp->sb_8_pause && dsp->sb_pausetime < 0 && dsp->sb_8_output) {
-        sb_dsp_update(dsp);
+        sb_dsp_update_to(dsp, limit);
 
         switch (dsp->sb_8_format) {
             case 0x00: /* Mono unsigned */
@@ -1514,7 +1563,7 @@ pollsb(void *priv)
         }
     }
     if (dsp->sb_16_enable && !dsp->sb_16_pause && (dsp->sb_pausetime < 0LL) && dsp->sb_16_output) {
-        sb_dsp_update(dsp);
+        sb_dsp_update_to(dsp, limit);
 
         switch (dsp->sb_16_format) {
             case 0x00: /* Mono unsigned */
@@ -1576,6 +1625,35 @@ pollsb(void *priv)
     }
 }
 
+void
+pollsb(void *priv)
+{
+    sb_dsp_t *dsp = (sb_dsp_t *) priv;
+    int       n   = (dsp->sb_output_batch > 0) ? dsp->sb_output_batch : 1;
+
+    /* Render the batch whose interval just elapsed, then size and schedule
+       the next one. Rendering lazily keeps the back-dated limits inside the
+       elapsed interval even when the batch size changes at a transfer start
+       or an auto-init block boundary - computed eagerly, the first ticks of
+       a grown batch would land before the mixer position and be clamped
+       away. */
+    for (int i = 1; i <= n; i++) {
+        int32_t limit = sound_pos_global;
+
+        /* Each sample clock in the batch still latches at its own point in
+           the mixer buffer, so transitions land where per-sample timer
+           events would have put them. */
+        if (i < n)
+            limit -= (int32_t) ((((double) (n - i)) * dsp->sblatcho * SOUND_FREQ) / (TIMER_USEC * 1000000.0) + 0.5);
+
+        sb_dsp_output_tick(dsp, limit);
+    }
+
+    dsp->sb_output_batch = sb_dsp_output_batch(dsp);
+    dsp->sb_output_latch = dsp->sb_output_batch * dsp->sblatcho;
+    timer_advance_u64(&dsp->output_timer, (uint64_t) dsp->sb_output_latch);
+}
+
 void
 sb_poll_i(void *priv)
 {
@@ -1683,19 +1761,27 @@ sb_poll_i(void *priv)
     }
 }
 
-void
-sb_dsp_update(sb_dsp_t *dsp)
+static void
+sb_dsp_update_to(sb_dsp_t *dsp, int32_t limit)
 {
+    if (limit > sound_pos_global)
+        limit = sound_pos_global;
     if (dsp->muted) {
         dsp->sbdatl = 0;
         dsp->sbdatr = 0;
     }
-    for (; dsp->pos < sound_pos_global; dsp->pos++) {
+    for (; dsp->pos < limit; dsp->pos++) {
         dsp->buffer[dsp->pos * 2]     = dsp->sbdatl;
         dsp->buffer[dsp->pos * 2 + 1] = dsp->sbdatr;
     }
 }
 
+void
+sb_dsp_update(sb_dsp_t *dsp)
+{
+    sb_dsp_update_to(dsp, sound_pos_global);
+}
+
 void
 sb_dsp_close(UNUSED(sb_dsp_t *dsp))
 {
@@ -24,39 +24,102 @@ static float volslog[16] = {
 void
 sn76489_update(sn76489_t *sn76489)
 {
-    for (; sn76489->pos < sound_pos_global; sn76489->pos++) {
-        int16_t result = 0;
-
-        for (uint8_t c = 1; c < 4; c++) {
-            if (sn76489->latch[c] > 256)
-                result += (int16_t) (volslog[sn76489->vol[c]] * sn76489->stat[c]);
-            else
-                result += (int16_t) (volslog[sn76489->vol[c]] * 127);
-
-            sn76489->count[c] -= (256 * sn76489->psgconst);
-            while (sn76489->count[c] < 0) {
-                sn76489->count[c] += sn76489->latch[c];
-                sn76489->stat[c] = -sn76489->stat[c];
+    int       pos = sn76489->pos;
+    const int end = sound_pos_global;
+
+    if (pos >= end)
+        return;
+
+    memset(&sn76489->buffer[pos], 0x00, (end - pos) * sizeof(int16_t));
+
+    /* Writes flush the buffer up to the write point before touching any
+       register, so the register state is constant over the span and each
+       channel can be rendered as a sequence of constant-level runs instead
+       of being stepped per sample. */
+    for (uint8_t c = 1; c < 4; c++) {
+        const double step  = 256.0 * sn76489->psgconst;
+        const int    latch = sn76489->latch[c];
+        const float  amp   = volslog[sn76489->vol[c]];
+        double       count = sn76489->count[c];
+        int          stat  = sn76489->stat[c];
+
+        if (latch <= 256) {
+            /* Period above Nyquist: heard as a constant level; fold the
+               skipped flips into count/stat in one step. */
+            const int16_t val = (int16_t) (amp * 127);
+            for (int i = pos; i < end; i++)
+                sn76489->buffer[i] += val;
+            count -= step * (double) (end - pos);
+            if (count < 0) {
+                const int flips = (int) (-count / latch) + 1;
+                count += (double) flips * latch;
+                if (flips & 1)
+                    stat = -stat;
             }
-        }
-        result += (((sn76489->shift & 1) ^ 1) * 127 * volslog[sn76489->vol[0]] * 2);
-
-        sn76489->count[0] -= (512 * sn76489->psgconst);
-        while (sn76489->count[0] < 0 && sn76489->latch[0]) {
-            sn76489->count[0] += (sn76489->latch[0] * 4);
-            if (!(sn76489->noise & 4)) {
-                if (sn76489->shift & 1)
-                    sn76489->shift |= 0x8000;
-                sn76489->shift >>= 1;
-            } else {
-                if ((sn76489->shift & 1) ^ ((sn76489->shift >> 1) & 1))
-                    sn76489->shift |= 0x8000;
-                sn76489->shift >>= 1;
+        } else {
+            int i = pos;
+            while (i < end) {
+                int run = (int) (count / step) + 1;
+                if (run > (end - i))
+                    run = end - i;
+                const int16_t val = (int16_t) (amp * stat);
+                for (int j = 0; j < run; j++)
+                    sn76489->buffer[i + j] += val;
+                i += run;
+                count -= (double) run * step;
+                while (count < 0) {
+                    count += latch;
+                    stat = -stat;
+                }
             }
         }
 
-        sn76489->buffer[sn76489->pos] = result;
+        sn76489->count[c] = (int) count;
+        sn76489->stat[c]  = stat;
+    }
+
+    /* Noise channel: the LFSR output is constant between shifts, so fill
+       runs between shifts the same way. */
+    {
+        const double step  = 512.0 * sn76489->psgconst;
+        const float  amp   = volslog[sn76489->vol[0]] * 254.0f;
+        const int    latch = sn76489->latch[0] * 4;
+        double       count = sn76489->count[0];
+        int          i     = pos;
+
+        if (!sn76489->latch[0]) {
+            const int16_t val = (int16_t) (((sn76489->shift & 1) ^ 1) * amp);
+            for (; i < end; i++)
+                sn76489->buffer[i] += val;
+            count -= step * (double) (end - pos);
+        } else
+            while (i < end) {
+                int run = (count >= 0.0) ? ((int) (count / step) + 1) : 1;
+                if (run > (end - i))
+                    run = end - i;
+                const int16_t val = (int16_t) (((sn76489->shift & 1) ^ 1) * amp);
+                for (int j = 0; j < run; j++)
+                    sn76489->buffer[i + j] += val;
+                i += run;
+                count -= (double) run * step;
+                while (count < 0) {
+                    count += latch;
+                    if (!(sn76489->noise & 4)) {
+                        if (sn76489->shift & 1)
+                            sn76489->shift |= 0x8000;
+                        sn76489->shift >>= 1;
+                    } else {
+                        if ((sn76489->shift & 1) ^ ((sn76489->shift >> 1) & 1))
+                            sn76489->shift |= 0x8000;
+                        sn76489->shift >>= 1;
+                    }
+                }
+            }
+
+        sn76489->count[0] = (int) count;
     }
+
+    sn76489->pos = end;
 }
 
 void
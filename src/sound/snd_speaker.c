@@ -38,16 +38,38 @@ int speakval;
 int speakon;
 
 static int32_t speaker_buffer[SOUNDBUFLEN];
-static int     speaker_pos = 0;
 
 static uint8_t speaker_mode  = 0;
 static double  speaker_count = 65535.0;
 
+/* Output transitions are recorded with their timestamp as they happen and
+ * turned into band-limited steps at mix time, so the output no longer has
+ * to be polled at the sample rate and sub-sample edge timing is kept.
+ * Deep enough for the fastest toggle rate the PIT hook lets through
+ * (counts below 25 force the output low) over one sound frame. */
+#define SPEAKER_EVENTS     2048
+#define SPEAKER_EVENT_MASK (SPEAKER_EVENTS - 1)
+
+typedef struct speaker_event_t {
+    uint64_t ts;
+    int32_t  level;
+} speaker_event_t;
+
+static speaker_event_t speaker_events[SPEAKER_EVENTS];
+static uint32_t        speaker_evt_head = 0;
+static uint32_t        speaker_evt_tail = 0;
+static int32_t         speaker_level    = 0; /* level after the newest event */
+static int32_t         speaker_render_level = 0; /* level after the last rendered event */
+static double          speaker_step_carry   = 0.0;
+static uint64_t        speaker_frame_ts     = 0;
+
 void
 speaker_set_count(uint8_t new_m, int new_count)
 {
     speaker_mode  = new_m;
     speaker_count = (double) new_count;
+
+    speaker_update();
 }
 
 void
@@ -61,37 +83,85 @@ speaker_update(void)
     if (amplitude > 5120.0)
         amplitude = 5120.0;
 
-    if (speaker_pos < sound_pos_global) {
-        for (; speaker_pos < sound_pos_global; speaker_pos++) {
-            if (speaker_gated && was_speaker_enable) {
-                if ((speaker_mode == 0) || (speaker_mode == 4))
-                    val = (int32_t) amplitude;
-                else if (speaker_count < 64.0)
-                    val = 0xa00;
-                else
-                    val = speakon ? 0x1400 : 0;
-            } else {
-                if (speaker_mode == 1)
-                    val = was_speaker_enable ? (int32_t) amplitude : 0;
-                else
-                    val = was_speaker_enable ? 0x1400 : 0;
-            }
+    if (!speaker_enable)
+        was_speaker_enable = 0;
+
+    if (speaker_gated && was_speaker_enable) {
+        if ((speaker_mode == 0) || (speaker_mode == 4))
+            val = (int32_t) amplitude;
+        else if (speaker_count < 64.0)
+            val = 0xa00;
+        else
+            val = speakon ? 0x1400 : 0;
+    } else {
+        if (speaker_mode == 1)
+            val = was_speaker_enable ? (int32_t) amplitude : 0;
+        else
+            val = was_speaker_enable ? 0x1400 : 0;
+    }
 
-            if (!speaker_enable)
-                was_speaker_enable = 0;
+    if (val == speaker_level)
+        return;
 
-            speaker_buffer[speaker_pos] = val;
-        }
+    if ((speaker_evt_head - speaker_evt_tail) >= SPEAKER_EVENTS) {
+        /* Ring full: fold into the newest event so the final level is kept. */
+        speaker_events[(speaker_evt_head - 1) & SPEAKER_EVENT_MASK].level = val;
+    } else {
+        speaker_events[speaker_evt_head & SPEAKER_EVENT_MASK].ts    = tsc;
+        speaker_events[speaker_evt_head & SPEAKER_EVENT_MASK].level = val;
+        speaker_evt_head++;
     }
+    speaker_level = val;
 }
 
 void
 speaker_get_buffer(int32_t *buffer, int len, UNUSED(void *priv))
 {
-    double val_l, val_r;
+    const double per_sample = ((double) TIMER_USEC * 1000000.0) / SOUND_FREQ;
+    double       val_l, val_r;
+    double       pend;
+    int32_t      level;
+    int          n = 0;
 
     speaker_update();
 
+    /* Turn the recorded transitions into band-limited steps: each edge is
+     * spread over the two samples next to its timestamp (polyBLEP), so edge
+     * timing is kept at sub-sample precision instead of being quantized to
+     * the poll grid. */
+    level = speaker_render_level;
+    pend  = speaker_step_carry;
+    while (speaker_evt_tail != speaker_evt_head) {
+        const speaker_event_t *evt = &speaker_events[speaker_evt_tail & SPEAKER_EVENT_MASK];
+        double                 x   = (evt->ts > speaker_frame_ts) ? ((double) (evt->ts - speaker_frame_ts) / per_sample) : 0.0;
+        int                    k   = (int) x;
+        double                 f   = x - k;
+        int32_t                delta;
+
+        if (k >= len) {
+            k = len - 1;
+            f = 1.0;
+        }
+        while (n <= k) {
+            speaker_buffer[n] = level + (int32_t) pend;
+            pend              = 0.0;
+            n++;
+        }
+        delta = evt->level - level;
+        speaker_buffer[k] += (int32_t) ((double) delta * 0.5 * (1.0 - f) * (1.0 - f));
+        pend -= (double) delta * 0.5 * f * f;
+        level = evt->level;
+        speaker_evt_tail++;
+    }
+    while (n < len) {
+        speaker_buffer[n] = level + (int32_t) pend;
+        pend              = 0.0;
+        n++;
+    }
+    speaker_render_level = level;
+    speaker_step_carry   = pend;
+    speaker_frame_ts     = tsc;
+
     if (!speaker_mute) {
         for (int c = 0; c < len * 2; c += 2) {
             val_l = val_r = (double) speaker_buffer[c >> 1];
@@ -104,8 +174,6 @@ speaker_get_buffer(int32_t *buffer, int len, UNUSED(void *priv))
             buffer[c + 1] += (int32_t) val_r;
         }
     }
-
-    speaker_pos = 0;
 }
 
 void
@@ -71,6 +71,7 @@ ssi2001_init(UNUSED(const device_t *info))
 
     ssi2001->psid = sid_init();
     sid_reset(ssi2001->psid);
+    sid_set_quality(ssi2001->psid, device_get_config_int("quality"));
     uint16_t addr             = device_get_config_hex16("base");
     ssi2001->gameport_enabled = device_get_config_int("gameport");
     io_sethandler(addr, 0x0020, ssi2001_read, NULL, NULL, ssi2001_write, NULL, NULL, ssi2001);
@@ -120,6 +121,26 @@ static const device_config_t ssi2001_config[] = {
             { .description = "" }
         }
     },
+    {
+        .name = "quality",
+        .description = "Emulation quality",
+        .type = CONFIG_SELECTION,
+        .default_string = "",
+        .default_int = SID_QUALITY_HIGH,
+        .file_filter = "",
+        .spinner = { 0 },
+        .selection = {
+            {
+                .description = "High (filter emulation)",
+                .value = SID_QUALITY_HIGH
+            },
+            {
+                .description = "Fast (filter bypassed)",
+                .value = SID_QUALITY_FAST
+            },
+            { .description = "" }
+        }
+    },
     { "gameport", "Enable Game port", CONFIG_BINARY, "",  1 },
     { "",         "",                                    -1 }
 // clang-format off
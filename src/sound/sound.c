@@ -42,6 +42,14 @@
 #include <86box/snd_opl.h>
 #include <86box/snd_sb_dsp.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    define SOUND_MIX_SSE2
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define SOUND_MIX_NEON
+#    include <arm_neon.h>
+#endif
+
 typedef struct {
     const device_t *device;
 } SOUND_CARD;
@@ -67,6 +75,16 @@ static int        sound_handlers_num;
 static pc_timer_t sound_poll_timer;
 static uint64_t   sound_poll_latch;
 
+static thread_t    *sound_render_thread_h;
+static event_t     *sound_render_event;
+static event_t     *sound_render_start_event;
+static event_t     *sound_render_idle_event;
+static int32_t     *render_buffer[2];
+static int          render_buf_pos;
+static volatile int render_buf_ready;
+static volatile int render_busy;
+static volatile int sound_render_on = 0;
+
 static int16_t      cd_buffer[CDROM_NUM][CD_BUFLEN * 2];
 static float        cd_out_buffer[CD_BUFLEN * 2];
 static int16_t      cd_out_buffer_int16[CD_BUFLEN * 2];
@@ -373,6 +391,103 @@ sound_cd_thread(UNUSED(void *param))
     }
 }
 
+/* Convert a completed mix buffer into the output format, vectorized where
+   the target supports it. SOUNDBUFLEN * 2 is a multiple of 8, so the SIMD
+   loops need no tail handling. */
+static void
+sound_render_convert(const int32_t *buf)
+{
+#if defined(SOUND_MIX_SSE2)
+    if (sound_is_float) {
+        const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+        for (int c = 0; c < SOUNDBUFLEN * 2; c += 4)
+            _mm_storeu_ps(&outbuffer_ex[c],
+                          _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) &buf[c])), scale));
+    } else {
+        for (int c = 0; c < SOUNDBUFLEN * 2; c += 8) {
+            const __m128i lo = _mm_loadu_si128((const __m128i *) &buf[c]);
+            const __m128i hi = _mm_loadu_si128((const __m128i *) &buf[c + 4]);
+
+            /* Packing saturates to the int16_t range, which is exactly the
+               clamp the scalar loop below performs. */
+            _mm_storeu_si128((__m128i *) &outbuffer_ex_int16[c], _mm_packs_epi32(lo, hi));
+        }
+    }
+#elif defined(SOUND_MIX_NEON)
+    if (sound_is_float) {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+
+        for (int c = 0; c < SOUNDBUFLEN * 2; c += 4)
+            vst1q_f32(&outbuffer_ex[c], vmulq_f32(vcvtq_f32_s32(vld1q_s32(&buf[c])), scale));
+    } else {
+        for (int c = 0; c < SOUNDBUFLEN * 2; c += 8) {
+            const int16x4_t lo = vqmovn_s32(vld1q_s32(&buf[c]));
+            const int16x4_t hi = vqmovn_s32(vld1q_s32(&buf[c + 4]));
+
+            vst1q_s16(&outbuffer_ex_int16[c], vcombine_s16(lo, hi));
+        }
+    }
+#else
+    for (int c = 0; c < SOUNDBUFLEN * 2; c++) {
+        if (sound_is_float)
+            outbuffer_ex[c] = ((float) buf[c]) / (float) 32768.0;
+        else {
+            int32_t sample = buf[c];
+
+            if (sample > 32767)
+                sample = 32767;
+            if (sample < -32768)
+                sample = -32768;
+
+            outbuffer_ex_int16[c] = sample;
+        }
+    }
+#endif
+}
+
+/* Convert and deliver completed mix buffers on a dedicated thread, so the
+   format conversion and the audio backend handoff never stall the emulation
+   thread. Synthesis itself stays on the emulation thread: the device update
+   callbacks render up to sound_pos_global on every register write, so
+   running them elsewhere would race the very state they catch up with. */
+static void
+sound_render_thread(UNUSED(void *param))
+{
+    const int32_t *buf;
+
+    thread_set_event(sound_render_start_event);
+
+    while (sound_render_on) {
+        thread_wait_event(sound_render_event, -1);
+        thread_reset_event(sound_render_event);
+
+        if (!sound_render_on)
+            return;
+
+        buf = render_buffer[render_buf_ready];
+
+        sound_render_convert(buf);
+
+        if (sound_is_float)
+            givealbuffer(outbuffer_ex);
+        else
+            givealbuffer(outbuffer_ex_int16);
+
+        render_busy = 0;
+        thread_set_event(sound_render_idle_event);
+    }
+}
+
+static void
+sound_render_drain(void)
+{
+    if ((sound_render_thread_h != NULL) && render_busy) {
+        thread_wait_event(sound_render_idle_event, -1);
+        thread_reset_event(sound_render_idle_event);
+    }
+}
+
 static void
 sound_realloc_buffers(void)
 {
@@ -403,9 +518,27 @@ sound_init(void)
     outbuffer_ex       = NULL;
     outbuffer_ex_int16 = NULL;
 
-    outbuffer = NULL;
-    outbuffer = calloc(SOUNDBUFLEN * 2, sizeof(int32_t));
-    memset(outbuffer, 0x00, SOUNDBUFLEN * 2 * sizeof(int32_t));
+    for (uint8_t i = 0; i < 2; i++) {
+        render_buffer[i] = calloc(SOUNDBUFLEN * 2, sizeof(int32_t));
+        memset(render_buffer[i], 0x00, SOUNDBUFLEN * 2 * sizeof(int32_t));
+    }
+
+    /* The emulation thread mixes into one buffer while the render thread
+       converts and delivers the other. */
+    render_buf_pos = 0;
+    outbuffer      = render_buffer[0];
+
+    sound_render_on          = 1;
+    render_busy              = 0;
+    sound_render_start_event = thread_create_event();
+    sound_render_event       = thread_create_event();
+    sound_render_idle_event  = thread_create_event();
+    sound_render_thread_h    = thread_create(sound_render_thread, NULL);
+
+    sound_log("Waiting for render start event...\n");
+    thread_wait_event(sound_render_start_event, -1);
+    thread_reset_event(sound_render_start_event);
+    sound_log("Done!\n");
 
     for (uint8_t i = 0; i < CDROM_NUM; i++) {
         if (cdrom[i].bus_type != CDROM_BUS_DISABLED)
@@ -472,23 +605,15 @@ sound_poll(UNUSED(void *priv))
         for (c = 0; c < sound_handlers_num; c++)
             sound_handlers[c].get_buffer(outbuffer, SOUNDBUFLEN, sound_handlers[c].priv);
 
-        for (c = 0; c < SOUNDBUFLEN * 2; c++) {
-            if (sound_is_float)
-                outbuffer_ex[c] = ((float) outbuffer[c]) / (float) 32768.0;
-            else {
-                if (outbuffer[c] > 32767)
-                    outbuffer[c] = 32767;
-                if (outbuffer[c] < -32768)
-                    outbuffer[c] = -32768;
-
-                outbuffer_ex_int16[c] = outbuffer[c];
-            }
-        }
-
-        if (sound_is_float)
-            givealbuffer(outbuffer_ex);
-        else
-            givealbuffer(outbuffer_ex_int16);
+        /* Hand the completed buffer to the render thread and keep mixing
+           into the other one. */
+        sound_render_drain();
+        render_buf_ready = render_buf_pos;
+        render_buf_pos ^= 1;
+        outbuffer        = render_buffer[render_buf_pos];
+        render_busy      = 1;
+        thread_reset_event(sound_render_idle_event);
+        thread_set_event(sound_render_event);
 
         if (cd_thread_enable) {
             cd_buf_update--;
@@ -511,6 +636,10 @@ sound_speed_changed(void)
 void
 sound_reset(void)
 {
+    /* Make sure the render thread is not converting out of the buffers
+       that are about to be reallocated. */
+    sound_render_drain();
+
     sound_realloc_buffers();
 
     midi_out_device_init();
@@ -0,0 +1,111 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          Telemetry export channel. Started from the command line
+ *          (--telemetry path), it maps 'path' as a shared file mapping
+ *          holding a ring of per-slice records: emulated versus host
+ *          time for every pc_run() slice, the host time the blit thread
+ *          spent rendering, and the playback queue fill and underrun
+ *          counts from the sound backend. An external collector maps
+ *          the same file read-only and computes frame-time percentiles
+ *          and underrun rates without attaching a profiler; the layout
+ *          and the seqlock protocol are described in 86box/telemetry.h.
+ *          Appending a record is a handful of word stores per slice on
+ *          the emulation thread.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include <86box/plat.h>
+#include <86box/telemetry.h>
+
+int telemetry_on = 0;
+
+uint32_t telemetry_blit_us;
+uint32_t telemetry_audio_underruns;
+uint32_t telemetry_audio_drops;
+uint32_t telemetry_audio_fill;
+
+static telemetry_header_t *telemetry_hdr = NULL;
+
+/* Counter values at the end of the previous slice, for the deltas. */
+static uint32_t telemetry_last_blit_us;
+static uint32_t telemetry_last_underruns;
+static uint32_t telemetry_last_drops;
+
+void
+telemetry_start(const char *path)
+{
+    size_t size = sizeof(telemetry_header_t) + ((size_t) TELEMETRY_SLOTS * sizeof(telemetry_record_t));
+
+    telemetry_hdr = plat_mmap_file(path, size);
+    if (telemetry_hdr == NULL) {
+        pclog("TELEMETRY: unable to map \"%s\"\n", path);
+        return;
+    }
+
+    telemetry_hdr->magic       = TELEMETRY_MAGIC;
+    telemetry_hdr->version     = TELEMETRY_VERSION;
+    telemetry_hdr->nr_slots    = TELEMETRY_SLOTS;
+    telemetry_hdr->record_size = sizeof(telemetry_record_t);
+    telemetry_hdr->seq         = 0;
+
+    telemetry_on = 1;
+    pclog("TELEMETRY: exporting slice records to \"%s\"\n", path);
+}
+
+/* Called on the emulation thread at the end of every pc_run() slice. */
+void
+telemetry_slice(int slice_ms, uint32_t host_us, uint32_t speed_pct)
+{
+    telemetry_record_t *rec;
+    uint32_t            seq;
+    uint32_t            blit_us   = telemetry_blit_us;
+    uint32_t            underruns = telemetry_audio_underruns;
+    uint32_t            drops     = telemetry_audio_drops;
+
+    if (!telemetry_on)
+        return;
+
+    seq = telemetry_hdr->seq + 1;
+    rec = ((telemetry_record_t *) (telemetry_hdr + 1)) + (seq % TELEMETRY_SLOTS);
+
+    /* Open the seqlock: a consumer seeing seq0 != seq1 rereads. */
+    rec->seq0 = seq;
+    atomic_thread_fence(memory_order_release);
+
+    rec->emu_us          = (uint32_t) slice_ms * 1000;
+    rec->host_us         = host_us;
+    rec->speed_pct       = speed_pct;
+    rec->blit_us         = blit_us - telemetry_last_blit_us;
+    rec->audio_fill      = telemetry_audio_fill;
+    rec->audio_underruns = underruns - telemetry_last_underruns;
+    rec->audio_drops     = drops - telemetry_last_drops;
+
+    /* Close the seqlock, then advertise the record. */
+    atomic_thread_fence(memory_order_release);
+    rec->seq1 = seq;
+    atomic_thread_fence(memory_order_release);
+    telemetry_hdr->seq = seq;
+
+    telemetry_last_blit_us   = blit_us;
+    telemetry_last_underruns = underruns;
+    telemetry_last_drops     = drops;
+}
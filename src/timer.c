@@ -1,15 +1,35 @@
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 #include <wchar.h>
 #include <86box/86box.h>
+#include <86box/perfstats.h>
 #include <86box/timer.h>
 
 uint64_t TIMER_USEC;
 uint32_t timer_target;
 
-/*Enabled timers are stored in a linked list, with the first timer to expire at
-  the head.*/
+/*Seqlock-published snapshot of the head deadline, for host-side threads
+  that pace their sleeps against emulated time. The pairing heap only
+  keeps its root ordered, so the snapshot carries the earliest deadline
+  rather than a sorted batch - which is the only value a sleeper needs.
+  Published from timer_process() on the CPU thread; read anywhere.*/
+static struct {
+    volatile uint32_t seq;
+    uint64_t          tsc_snap;
+    uint32_t          target;
+    uint64_t          usec_scale; /* TIMER_USEC at publish time. */
+    int               valid;
+} timer_snapshot;
+
+/*Enabled timers are stored in a pairing heap, rooted at the first timer to
+  expire. ->child points at a node's first child; ->next and ->prev link the
+  sibling list, with ->prev of a first child pointing back at the parent.
+  This keeps timer_enable() - and therefore the timer_advance_u64() re-arm
+  path devices hit every period - O(1), deferring the ordering work to an
+  amortized O(log n) pop in timer_process() instead of an O(n) sorted-list
+  insert per arm.*/
 pc_timer_t *timer_head = NULL;
 
 /* Are we initialized? */
@@ -17,91 +37,173 @@ int timer_inited = 0;
 
 static void timer_advance_ex(pc_timer_t *timer, int start);
 
+static void
+timer_publish_deadline(int valid)
+{
+    timer_snapshot.seq++;
+    atomic_thread_fence(memory_order_release);
+
+    timer_snapshot.tsc_snap   = tsc;
+    timer_snapshot.target     = timer_target;
+    timer_snapshot.usec_scale = TIMER_USEC;
+    timer_snapshot.valid      = valid;
+
+    atomic_thread_fence(memory_order_release);
+    timer_snapshot.seq++;
+}
+
+int
+timer_read_snapshot(uint64_t *tsc_snap, uint32_t *target, uint64_t *usec_scale)
+{
+    uint32_t seq0;
+    int      valid;
+
+    for (uint8_t tries = 0; tries < 16; tries++) {
+        seq0 = timer_snapshot.seq;
+        if (seq0 & 1)
+            continue; /* Publish in progress. */
+        atomic_thread_fence(memory_order_acquire);
+
+        *tsc_snap   = timer_snapshot.tsc_snap;
+        *target     = timer_snapshot.target;
+        *usec_scale = timer_snapshot.usec_scale;
+        valid       = timer_snapshot.valid;
+
+        atomic_thread_fence(memory_order_acquire);
+        if (timer_snapshot.seq != seq0)
+            continue; /* Torn read; retry. */
+
+        return valid;
+    }
+
+    return 0;
+}
+
+double
+timer_next_deadline_us(void)
+{
+    uint64_t tsc_snap;
+    uint32_t target;
+    uint64_t usec_scale;
+    int32_t  delta;
+
+    if (!timer_read_snapshot(&tsc_snap, &target, &usec_scale) || !usec_scale)
+        return -1.0;
+
+    delta = (int32_t) (target - (uint32_t) tsc_snap);
+    if (delta <= 0)
+        return 0.0;
+
+    /* delta is in CPU clock ticks; the scale is ticks/us in 32:32. */
+    return ((double) delta) * 4294967296.0 / ((double) usec_scale);
+}
+
+/*Meld two heaps, returning the new root. Both roots must be detached from
+  any sibling list.*/
+static pc_timer_t *
+timer_meld(pc_timer_t *a, pc_timer_t *b)
+{
+    pc_timer_t *parent;
+    pc_timer_t *child;
+
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+
+    if (TIMER_LESS_THAN(a, b)) {
+        parent = a;
+        child  = b;
+    } else {
+        parent = b;
+        child  = a;
+    }
+
+    child->next = parent->child;
+    if (child->next)
+        child->next->prev = child;
+    child->prev   = parent;
+    parent->child = child;
+    parent->next = parent->prev = NULL;
+
+    return parent;
+}
+
+/*Merge a detached root's child list pairwise into a single heap.*/
+static pc_timer_t *
+timer_merge_pairs(pc_timer_t *list)
+{
+    pc_timer_t *a = list;
+    pc_timer_t *b;
+    pc_timer_t *rest;
+
+    if (a == NULL)
+        return NULL;
+
+    b = a->next;
+    if (b == NULL) {
+        a->prev = NULL;
+        return a;
+    }
+
+    rest    = b->next;
+    a->next = a->prev = NULL;
+    b->next = b->prev = NULL;
+
+    return timer_meld(timer_meld(a, b), timer_merge_pairs(rest));
+}
+
 void
 timer_enable(pc_timer_t *timer)
 {
-    pc_timer_t *timer_node = timer_head;
-    int ret = 0;
-
     if (!timer_inited || (timer == NULL))
         return;
 
     if (timer->flags & TIMER_ENABLED)
         timer_disable(timer);
 
-    if (timer->next || timer->prev)
+    if (timer->next || timer->prev || timer->child)
         fatal("timer_enable - timer->next\n");
 
-    /*List currently empty - add to head*/
-    if (!timer_head) {
-        timer_head  = timer;
-        timer->next = timer->prev = NULL;
-        timer_target              = timer_head->ts.ts32.integer;
-        ret = 1;
-    } else if (TIMER_LESS_THAN(timer, timer_head)) {
-        timer->next      = timer_head;
-        timer->prev      = NULL;
-        timer_head->prev = timer;
-        timer_head       = timer;
-        timer_target     = timer_head->ts.ts32.integer;
-        ret = 1;
-    } else if (!timer_head->next) {
-        timer_head->next = timer;
-        timer->prev      = timer_head;
-        ret = 1;
-    }
-
-    if (ret == 0) {
-        pc_timer_t *prev = timer_head;
-        timer_node       = timer_head->next;
-
-        while (1) {
-            /*Timer expires before timer_node. Add to list in front of timer_node*/
-            if (TIMER_LESS_THAN(timer, timer_node)) {
-                timer->next      = timer_node;
-                timer->prev      = prev;
-                timer_node->prev = timer;
-                prev->next       = timer;
-                ret = 1;
-                break;
-            }
-
-            /*timer_node is last in the list. Add timer to end of list*/
-            if (!timer_node->next) {
-                timer_node->next = timer;
-                timer->prev      = timer_node;
-                ret = 1;
-                break;
-            }
-
-            prev       = timer_node;
-            timer_node = timer_node->next;
-        }
-    }
+    timer_head   = timer_meld(timer_head, timer);
+    timer_target = timer_head->ts.ts32.integer;
 
-    /* Do not mark it as enabled if it has failed every single condition. */
-    if (ret == 1)
-        timer->flags |= TIMER_ENABLED;
+    timer->flags |= TIMER_ENABLED;
 }
 
 void
 timer_disable(pc_timer_t *timer)
 {
+    pc_timer_t *sub;
+
     if (!timer_inited || (timer == NULL) || !(timer->flags & TIMER_ENABLED))
         return;
 
-    if (!timer->next && !timer->prev && timer != timer_head)
+    if (!timer->next && !timer->prev && !timer->child && timer != timer_head)
         fatal("timer_disable - !timer->next\n");
 
     timer->flags &= ~TIMER_ENABLED;
 
-    if (timer->prev)
-        timer->prev->next = timer->next;
-    else
-        timer_head = timer->next;
-    if (timer->next)
-        timer->next->prev = timer->prev;
+    sub          = timer_merge_pairs(timer->child);
+    timer->child = NULL;
+
+    if (timer == timer_head)
+        timer_head = sub;
+    else {
+        /*Unlink from the sibling list - ->prev is the parent when we are its
+          first child.*/
+        if (timer->prev->child == timer)
+            timer->prev->child = timer->next;
+        else
+            timer->prev->next = timer->next;
+        if (timer->next)
+            timer->next->prev = timer->prev;
+        timer_head = timer_meld(timer_head, sub);
+    }
     timer->prev = timer->next = NULL;
+
+    if (timer_head)
+        timer_target = timer_head->ts.ts32.integer;
 }
 
 void
@@ -109,8 +211,10 @@ timer_process(void)
 {
     pc_timer_t *timer;
 
-    if (!timer_head)
+    if (!timer_head) {
+        timer_publish_deadline(0);
         return;
+    }
 
     while (1) {
         timer = timer_head;
@@ -118,10 +222,8 @@ timer_process(void)
         if (!TIMER_LESS_THAN_VAL(timer, (uint32_t) tsc))
             break;
 
-        timer_head = timer->next;
-        if (timer_head)
-            timer_head->prev = NULL;
-
+        timer_head   = timer_merge_pairs(timer->child);
+        timer->child = NULL;
         timer->next = timer->prev = NULL;
         timer->flags &= ~TIMER_ENABLED;
 
@@ -131,38 +233,96 @@ timer_process(void)
         else if (timer->callback != NULL) /* Make sure it's not NULL, so that we can
                                              have a NULL callback when no operation
                                              is needed. */
+        {
+            perfc.timer_fires++;
             timer->callback(timer->priv);
+        }
     }
 
     timer_target = timer_head->ts.ts32.integer;
+    timer_publish_deadline(1);
+}
+
+/* Set all timers' heap pointers to NULL so it is assured that
+   timers that are not in malloc'd structs don't keep pointing
+   to timers that may be in malloc'd structs. */
+static void
+timer_clear_tree(pc_timer_t *timer)
+{
+    if (timer == NULL)
+        return;
+
+    timer_clear_tree(timer->child);
+    timer_clear_tree(timer->next);
+    timer->child = timer->prev = timer->next = NULL;
 }
 
 void
 timer_close(void)
 {
-    pc_timer_t *t = timer_head;
-    pc_timer_t *r;
-
-    /* Set all timers' prev and next to NULL so it is assured that
-       timers that are not in malloc'd structs don't keep pointing
-       to timers that may be in malloc'd structs. */
-    while (t != NULL) {
-        r       = t;
-        r->prev = r->next = NULL;
-        t                 = r->next;
-    }
+    timer_clear_tree(timer_head);
 
     timer_head = NULL;
 
     timer_inited = 0;
 }
 
+/* Best-effort dump of the pending timer heap for the hang watchdog.
+   Called from the watchdog thread while the CPU thread may still be
+   mutating the heap, so the walk is bounded rather than trusted: a
+   partially stale snapshot beats no diagnostics when the emulator is
+   wedged. */
+#define TIMER_DUMP_MAX 256
+
+static int
+timer_dump_node(FILE *fp, const pc_timer_t *timer, uint32_t tsc32, uint32_t cyc_per_us, int depth, int budget)
+{
+    while ((timer != NULL) && (budget > 0)) {
+        int32_t delta = (int32_t) (timer->ts.ts32.integer - tsc32);
+
+        fprintf(fp, "  %*s%p: flags=%02X callback=%p priv=%p deadline=%+d us\n",
+                depth * 2, "", (void *) timer, timer->flags,
+                (void *) (uintptr_t) timer->callback, timer->priv,
+                (int) (delta / (int32_t) cyc_per_us));
+        budget--;
+
+        if (timer->child != NULL)
+            budget = timer_dump_node(fp, timer->child, tsc32, cyc_per_us, depth + 1, budget);
+        timer = timer->next;
+    }
+
+    return budget;
+}
+
+void
+timer_dump(void *fp)
+{
+    FILE    *file       = (FILE *) fp;
+    uint64_t tsc_snap   = tsc;
+    uint64_t usec_scale = TIMER_USEC;
+    uint32_t target;
+    uint32_t cyc_per_us;
+
+    timer_read_snapshot(&tsc_snap, &target, &usec_scale);
+    cyc_per_us = usec_scale >> 32;
+    if (cyc_per_us == 0)
+        cyc_per_us = 1;
+
+    fprintf(file, "Pending timers (tsc=%08X, heap order):\n", (uint32_t) tsc_snap);
+    if (timer_head == NULL)
+        fprintf(file, "  (none)\n");
+    else
+        timer_dump_node(file, timer_head, (uint32_t) tsc_snap, cyc_per_us, 1, TIMER_DUMP_MAX);
+}
+
 void
 timer_init(void)
 {
     timer_target = 0ULL;
     tsc          = 0;
 
+    timer_publish_deadline(0);
+
     timer_inited = 1;
 }
 
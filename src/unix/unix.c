@@ -14,6 +14,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <inttypes.h>
 #include <dlfcn.h>
@@ -416,12 +417,85 @@ plat_mmap(size_t size, uint8_t executable)
     return (ret < 0) ? NULL : ret;
 }
 
+void *
+plat_mmap_huge(size_t size, uint8_t executable)
+{
+#ifdef MAP_HUGETLB
+    void *ret = mmap(0, size, PROT_READ | PROT_WRITE | (executable ? PROT_EXEC : 0), MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    return (ret == MAP_FAILED) ? NULL : ret;
+#else
+    (void) size;
+    (void) executable;
+    return NULL;
+#endif
+}
+
 void
 plat_munmap(void *ptr, size_t size)
 {
     munmap(ptr, size);
 }
 
+/* Map a file into memory as a shared read/write mapping, growing it to
+   'size' bytes; other processes mapping the same file see the writes. */
+void *
+plat_mmap_file(const char *path, size_t size)
+{
+    void *ret;
+    int   fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+        return NULL;
+
+    if (ftruncate(fd, (off_t) size) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    ret = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* The mapping keeps the file open. */
+    close(fd);
+
+    return (ret == MAP_FAILED) ? NULL : ret;
+}
+
+void
+plat_munmap_file(void *ptr, size_t size)
+{
+    munmap(ptr, size);
+}
+
+/* Tell the OS the range will not be touched for a while, so it can be
+   reclaimed under memory pressure; the contents stay valid and fault back
+   in on the next access. Advisory only - a no-op where unsupported. */
+void
+plat_memory_cold(void *ptr, size_t size)
+{
+#if defined MADV_COLD
+    madvise(ptr, size, MADV_COLD);
+#elif defined MADV_PAGEOUT
+    madvise(ptr, size, MADV_PAGEOUT);
+#else
+    (void) ptr;
+    (void) size;
+#endif
+}
+
+/* The caller guarantees the range contains only zero bytes: drop its
+   backing entirely. Private anonymous memory reads back as fresh zero
+   pages after MADV_DONTNEED, so the contents are preserved by
+   construction. A no-op where that guarantee does not hold. */
+void
+plat_memory_free_zero(void *ptr, size_t size)
+{
+#if defined MADV_DONTNEED
+    madvise(ptr, size, MADV_DONTNEED);
+#else
+    (void) ptr;
+    (void) size;
+#endif
+}
+
 uint64_t
 plat_timer_read(void)
 {
@@ -463,6 +537,12 @@ plat_remove(char *path)
     remove(path);
 }
 
+int
+plat_rename(char *oldpath, char *newpath)
+{
+    return rename(oldpath, newpath);
+}
+
 void
 ui_sb_update_icon_state(int tag, int state)
 {
@@ -562,7 +642,7 @@ main_thread(void *param)
         old_time = new_time;
         if (drawits > 0 && !dopause) {
             /* Yes, so do one frame now. */
-            drawits -= 10;
+            drawits -= pc_slice_ms;
             if (drawits > 50)
                 drawits = 0;
 
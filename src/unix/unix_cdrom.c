@@ -190,8 +190,9 @@ mo_mount(uint8_t id, char *fn, uint8_t wp)
 
     mo_disk_close(dev);
     mo_drives[id].read_only = wp;
-    mo_load(dev, fn);
-    mo_insert(dev);
+    /* Validation and spin-up run on a worker thread; the emulated
+       drive reports "becoming ready" until the mount completes. */
+    mo_load_async(dev, fn);
 
     ui_sb_update_icon_state(SB_MO | id, strlen(mo_drives[id].image_path) ? 0 : 1);
 #if 0
@@ -248,8 +249,9 @@ zip_mount(uint8_t id, char *fn, uint8_t wp)
 
     zip_disk_close(dev);
     zip_drives[id].read_only = wp;
-    zip_load(dev, fn);
-    zip_insert(dev);
+    /* Validation and spin-up run on a worker thread; the emulated
+       drive reports "becoming ready" until the mount completes. */
+    zip_load_async(dev, fn);
 
     ui_sb_update_icon_state(SB_ZIP | id, strlen(zip_drives[id].image_path) ? 0 : 1);
 #if 0
@@ -75,6 +75,38 @@ plat_serpt_read(void *priv, uint8_t *data)
     return 0;
 }
 
+int
+plat_serpt_read_buf(void *priv, uint8_t *data, int max)
+{
+    serial_passthrough_t *dev = (serial_passthrough_t *) priv;
+    int                   res;
+    struct timeval        tv;
+    fd_set                rdfds;
+
+    switch (dev->mode) {
+        case SERPT_MODE_VCON:
+        case SERPT_MODE_HOSTSER:
+            FD_ZERO(&rdfds);
+            FD_SET(dev->master_fd, &rdfds);
+            tv.tv_sec  = 0;
+            tv.tv_usec = 0;
+
+            res = select(dev->master_fd + 1, &rdfds, NULL, NULL, &tv);
+            if (res <= 0 || !FD_ISSET(dev->master_fd, &rdfds)) {
+                return 0;
+            }
+
+            res = read(dev->master_fd, data, max);
+            if (res > 0) {
+                return res;
+            }
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
 void
 plat_serpt_close(void *priv)
 {
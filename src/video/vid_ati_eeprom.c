@@ -69,11 +69,9 @@ ati_eeprom_load_mach8(ati_eeprom_t *eeprom, char *fn)
 void
 ati_eeprom_save(ati_eeprom_t *eeprom)
 {
-    FILE *fp = nvr_fopen(eeprom->fn, "wb");
-    if (!fp)
-        return;
-    fwrite(eeprom->data, 1, eeprom->type ? 512 : 128, fp);
-    fclose(fp);
+    /* Deferred: the contents are handed to the NVR layer, which writes the
+       file out on its periodic save pass instead of on every write burst. */
+    nvr_file_dirty(eeprom->fn, eeprom->data, eeprom->type ? 512 : 128);
 }
 
 void
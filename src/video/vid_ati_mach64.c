@@ -35,6 +35,7 @@
 #include <86box/thread.h>
 #include <86box/video.h>
 #include <86box/i2c.h>
+#include <86box/vid_accel_rop.h>
 #include <86box/vid_ddc.h>
 #include <86box/vid_svga.h>
 #include <86box/vid_svga_render.h>
@@ -1481,71 +1482,18 @@ mach64_start_line(mach64_t *mach64)
     else                                                                          \
         dat = (svga->vram[((addr) >> 3) & mach64->vram_mask] >> (7 - ((addr) &7))) & 1;
 
-#define MIX                                                      \
-    switch (mix ? mach64->accel.mix_fg : mach64->accel.mix_bg) { \
-        case 0x0:                                                \
-            dest_dat = ~dest_dat;                                \
-            break;                                               \
-        case 0x1:                                                \
-            dest_dat = 0;                                        \
-            break;                                               \
-        case 0x2:                                                \
-            dest_dat = 0xffffffff;                               \
-            break;                                               \
-        case 0x3:                                                \
-            dest_dat = dest_dat;                                 \
-            break;                                               \
-        case 0x4:                                                \
-            dest_dat = ~src_dat;                                 \
-            break;                                               \
-        case 0x5:                                                \
-            dest_dat = src_dat ^ dest_dat;                       \
-            break;                                               \
-        case 0x6:                                                \
-            dest_dat = ~(src_dat ^ dest_dat);                    \
-            break;                                               \
-        case 0x7:                                                \
-            dest_dat = src_dat;                                  \
-            break;                                               \
-        case 0x8:                                                \
-            dest_dat = ~(src_dat & dest_dat);                    \
-            break;                                               \
-        case 0x9:                                                \
-            dest_dat = ~src_dat | dest_dat;                      \
-            break;                                               \
-        case 0xa:                                                \
-            dest_dat = src_dat | ~dest_dat;                      \
-            break;                                               \
-        case 0xb:                                                \
-            dest_dat = src_dat | dest_dat;                       \
-            break;                                               \
-        case 0xc:                                                \
-            dest_dat = src_dat & dest_dat;                       \
-            break;                                               \
-        case 0xd:                                                \
-            dest_dat = src_dat & ~dest_dat;                      \
-            break;                                               \
-        case 0xe:                                                \
-            dest_dat = ~src_dat & dest_dat;                      \
-            break;                                               \
-        case 0xf:                                                \
-            dest_dat = ~(src_dat | dest_dat);                    \
-            break;                                               \
-        case 0x17:                                               \
-            dest_dat = (dest_dat + src_dat) >> 1;                \
-            break;                                               \
-    }
+#define MIX dest_dat = mach64_accel_mix(mix ? mix_rop_fg : mix_rop_bg, dest_dat, src_dat);
 
 #define WRITE(addr, width)                                                                  \
     if (width == 0) {                                                                       \
         svga->vram[(addr) &mach64->vram_mask]                = dest_dat;                    \
-        svga->changedvram[((addr) &mach64->vram_mask) >> 12] = svga->monitor->mon_changeframecount;            \
+        svga_dirty_mark(svga, ((addr) &mach64->vram_mask) >> 12);            \
     } else if (width == 1) {                                                                \
         *(uint16_t *) &svga->vram[((addr) << 1) & mach64->vram_mask] = dest_dat;            \
-        svga->changedvram[(((addr) << 1) & mach64->vram_mask) >> 12] = svga->monitor->mon_changeframecount;    \
+        svga_dirty_mark(svga, (((addr) << 1) & mach64->vram_mask) >> 12);    \
     } else if (width == 2) {                                                                \
         *(uint32_t *) &svga->vram[((addr) << 2) & mach64->vram_mask] = dest_dat;            \
-        svga->changedvram[(((addr) << 2) & mach64->vram_mask) >> 12] = svga->monitor->mon_changeframecount;    \
+        svga_dirty_mark(svga, (((addr) << 2) & mach64->vram_mask) >> 12);    \
     } else {                                                                                \
         if (dest_dat & 1) {                                                                 \
             if (mach64->dp_pix_width & DP_BYTE_PIX_ORDER)                                   \
@@ -1558,15 +1506,19 @@ mach64_start_line(mach64_t *mach64)
             else                                                                            \
                 svga->vram[((addr) >> 3) & mach64->vram_mask] &= ~(1 << (7 - ((addr) &7))); \
         }                                                                                   \
-        svga->changedvram[(((addr) >> 3) & mach64->vram_mask) >> 12] = svga->monitor->mon_changeframecount;    \
+        svga_dirty_mark(svga, (((addr) >> 3) & mach64->vram_mask) >> 12);    \
     }
 
 void
 mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
 {
-    svga_t *svga    = &mach64->svga;
-    int     cmp_clr = 0;
-    int     mix = 0;
+    svga_t       *svga       = &mach64->svga;
+    int           cmp_clr    = 0;
+    int           mix        = 0;
+    const uint8_t mix_rop_fg = mach64->accel.mix_fg;
+    const uint8_t mix_rop_bg = mach64->accel.mix_bg;
+    const int     source_fg  = mach64->accel.source_fg;
+    const int     source_bg  = mach64->accel.source_bg;
 
     if (!mach64->accel.busy) {
         mach64_log("mach64_blit : return as not busy\n");
@@ -1650,7 +1602,7 @@ mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
                 }
 
                 if (dst_x >= mach64->accel.sc_left && dst_x <= mach64->accel.sc_right && dst_y >= mach64->accel.sc_top && dst_y <= mach64->accel.sc_bottom) {
-                    switch (mix ? mach64->accel.source_fg : mach64->accel.source_bg) {
+                    switch (mix ? source_fg : source_bg) {
                         case SRC_HOST:
                             src_dat = host_dat;
                             break;
@@ -1886,7 +1838,7 @@ mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
                     }
 
                     if ((mach64->accel.dst_x >= mach64->accel.sc_left) && (mach64->accel.dst_x <= mach64->accel.sc_right) && (mach64->accel.dst_y >= mach64->accel.sc_top) && (mach64->accel.dst_y <= mach64->accel.sc_bottom)) {
-                        switch (mix ? mach64->accel.source_fg : mach64->accel.source_bg) {
+                        switch (mix ? source_fg : source_bg) {
                             case SRC_HOST:
                                 src_dat = host_dat;
                                 break;
@@ -2024,7 +1976,7 @@ mach64_blit(uint32_t cpu_dat, int count, mach64_t *mach64)
                         draw_pixel = 0;
 
                     if (mach64->accel.dst_x >= mach64->accel.sc_left && mach64->accel.dst_x <= mach64->accel.sc_right && mach64->accel.dst_y >= mach64->accel.sc_top && mach64->accel.dst_y <= mach64->accel.sc_bottom && draw_pixel) {
-                        switch (mix ? mach64->accel.source_fg : mach64->accel.source_bg) {
+                        switch (mix ? source_fg : source_bg) {
                             case SRC_HOST:
                                 src_dat = host_dat;
                                 break;
@@ -42,7 +42,13 @@ static void
 att49x_ramdac_control(uint8_t val, void *priv, svga_t *svga)
 {
     att49x_ramdac_t *ramdac = (att49x_ramdac_t *) priv;
-    ramdac->ctrl            = val;
+
+    /* Rewriting the same control value changes no derived state; skip the
+       bpp/ramdac type rederivation and the timing recalculation. */
+    if (ramdac->ctrl == val)
+        return;
+
+    ramdac->ctrl = val;
     switch ((ramdac->ctrl >> 5) & 7) {
         case 0:
         case 1:
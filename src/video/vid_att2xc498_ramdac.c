@@ -37,7 +37,13 @@ static void
 att498_ramdac_control(uint8_t val, void *priv, svga_t *svga)
 {
     att498_ramdac_t *ramdac = (att498_ramdac_t *) priv;
-    ramdac->ctrl            = val;
+
+    /* Rewriting the same control value changes no derived state; skip the
+       bpp/ramdac type rederivation and the timing recalculation. */
+    if (ramdac->ctrl == val)
+        return;
+
+    ramdac->ctrl = val;
 
     if (val == 0xff)
         return;
@@ -117,7 +117,6 @@ bt48x_ramdac_out(uint16_t addr, int rs2, int rs3, uint8_t val, void *priv, svga_
             break;
         case 0x05: /* Ext Palette Data Register (RS value = 0101) */
             svga->dac_status = 0;
-            svga->fullchange = changeframecount;
             switch (svga->dac_pos) {
                 case 0:
                     svga->dac_r = val;
@@ -128,14 +127,19 @@ bt48x_ramdac_out(uint16_t addr, int rs2, int rs3, uint8_t val, void *priv, svga_
                     svga->dac_pos++;
                     break;
                 case 2:
-                    index                   = svga->dac_addr & 3;
-                    ramdac->extpal[index].r = svga->dac_r;
-                    ramdac->extpal[index].g = svga->dac_g;
-                    ramdac->extpal[index].b = val;
-                    if (svga->ramdac_type == RAMDAC_8BIT)
-                        ramdac->extpallook[index] = makecol32(ramdac->extpal[index].r, ramdac->extpal[index].g, ramdac->extpal[index].b);
-                    else
-                        ramdac->extpallook[index] = makecol32(video_6to8[ramdac->extpal[index].r & 0x3f], video_6to8[ramdac->extpal[index].g & 0x3f], video_6to8[ramdac->extpal[index].b & 0x3f]);
+                    index = svga->dac_addr & 3;
+                    /* Only regenerate the lookup and force a redraw when the
+                       entry actually changes. */
+                    if ((ramdac->extpal[index].r != svga->dac_r) || (ramdac->extpal[index].g != svga->dac_g) || (ramdac->extpal[index].b != val)) {
+                        svga->fullchange        = changeframecount;
+                        ramdac->extpal[index].r = svga->dac_r;
+                        ramdac->extpal[index].g = svga->dac_g;
+                        ramdac->extpal[index].b = val;
+                        if (svga->ramdac_type == RAMDAC_8BIT)
+                            ramdac->extpallook[index] = makecol32(ramdac->extpal[index].r, ramdac->extpal[index].g, ramdac->extpal[index].b);
+                        else
+                            ramdac->extpallook[index] = makecol32(video_6to8[ramdac->extpal[index].r & 0x3f], video_6to8[ramdac->extpal[index].g & 0x3f], video_6to8[ramdac->extpal[index].b & 0x3f]);
+                    }
 
                     if (svga->ext_overscan && !index) {
                         o32                  = svga->overscan_color;
@@ -231,6 +231,41 @@ cga_render(cga_t *cga, int line)
     uint16_t dat;
     int      cols[4];
     int      col;
+    uint32_t hash;
+
+    cga->line_clean[line] = 0;
+
+    /* Hash everything that determines this scanline's output and skip both
+       the redraw and the palette pass when it matches what is already in
+       the buffer. Composite output is left alone - its filter carries
+       state between lines. */
+    if (!cga->composite) {
+        uint8_t state[12] = { cga->cgamode, cga->cgacol, cga->crtc[1], (uint8_t) cga->sc,
+                              (uint8_t) ((cga->con && cga->cursoron) | (cga->drawcursor << 1)),
+                              (uint8_t) (cga->cgablink & 8), (uint8_t) ca, (uint8_t) (ca >> 8),
+                              (uint8_t) cga->ma, (uint8_t) (cga->ma >> 8),
+                              (uint8_t) video_grayscale, (uint8_t) video_graytype };
+
+        hash = video_hash(VIDEO_HASH_INIT, state, sizeof(state));
+        hash = video_hash(hash, &cga->fontbase, sizeof(cga->fontbase));
+        if ((cga->cgamode & 8) && (cga->cgamode & 1))
+            hash = video_hash(hash, cga->charbuffer, cga->crtc[1] << 1);
+        else if (cga->cgamode & 8) {
+            for (x = 0; x < (cga->crtc[1] << 1); x++) {
+                uint8_t b = (cga->cgamode & 2) ? cga->vram[(((cga->ma << 1) + x) & 0x1fff) + ((cga->sc & 1) * 0x2000)]
+                                               : cga->vram[((cga->ma << 1) + x) & 0x3fff];
+
+                hash = video_hash(hash, &b, 1);
+            }
+        }
+
+        if (hash == cga->line_hash[line]) {
+            cga->ma += cga->crtc[1];
+            cga->line_clean[line] = 1;
+            return;
+        }
+        cga->line_hash[line] = hash;
+    }
 
     if ((cga->cgamode & 0x12) == 0x12) {
         for (c = 0; c < 8; ++c) {
@@ -360,6 +395,21 @@ cga_render_blank(cga_t *cga, int line)
 {
     int col = ((cga->cgamode & 0x12) == 0x12) ? 0 : (cga->cgacol & 15) + 16;
 
+    cga->line_clean[line] = 0;
+
+    if (!cga->composite) {
+        /* 0xff marks a blank line so it can never alias a rendered one. */
+        uint8_t  state[6] = { cga->cgamode, cga->cgacol, cga->crtc[1],
+                              (uint8_t) video_grayscale, (uint8_t) video_graytype, 0xff };
+        uint32_t hash     = video_hash(VIDEO_HASH_INIT, state, sizeof(state));
+
+        if (hash == cga->line_hash[line]) {
+            cga->line_clean[line] = 1;
+            return;
+        }
+        cga->line_hash[line] = hash;
+    }
+
     if (cga->cgamode & 1)
         hline(buffer32, 0, line, (cga->crtc[1] << 3) + 16, col);
     else
@@ -372,6 +422,10 @@ cga_render_process(cga_t *cga, int line)
     int      x;
     uint8_t  border;
 
+    /* The line still holds last frame's processed output. */
+    if (cga->line_clean[line])
+        return;
+
     if (cga->cgamode & 1)
         x = (cga->crtc[1] << 3) + 16;
     else
@@ -29,6 +29,11 @@
 #include <86box/vid_cga.h>
 #include <86box/vid_cga_comp.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    define CGA_COMP_SSE2
+#    include <emmintrin.h>
+#endif
+
 int CGA_Composite_Table[1024];
 
 static double brightness = 0;
@@ -75,14 +80,15 @@ double mode_hue;
 double min_v;
 double max_v;
 
-double video_ri;
-double video_rq;
-double video_gi;
-double video_gq;
-double video_bi;
-double video_bq;
-int    video_sharpness;
-int    tandy_mode_control = 0;
+/* Fixed-point decode coefficients; all per-pixel work below is integer. */
+int video_ri;
+int video_rq;
+int video_gi;
+int video_gq;
+int video_bi;
+int video_bq;
+int video_sharpness;
+int tandy_mode_control = 0;
 
 static bool new_cga = 0;
 
@@ -186,6 +192,24 @@ static int temp[SCALER_MAXWIDTH + 10] = { 0 };
 static int atemp[SCALER_MAXWIDTH + 2] = { 0 };
 static int btemp[SCALER_MAXWIDTH + 2] = { 0 };
 
+/* Chroma with the per-phase sign pattern already applied, interleaved
+   I,Q per pixel so the decode can consume it directly. The values are
+   bounded by the composite table, well inside 16 bits. */
+static int16_t iqtemp[(SCALER_MAXWIDTH + 2) * 2] = { 0 };
+
+#ifdef CGA_COMP_SSE2
+/* Low 32 bits of a lane-wise 32x32 multiply (sign-agnostic). */
+static inline __m128i
+mullo_epi32(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
 uint32_t *
 Composite_Process(uint8_t cgamode, uint8_t border, uint32_t blocks /*, bool doublewidth*/, uint32_t *TempLine)
 {
@@ -200,24 +224,7 @@ Composite_Process(uint8_t cgamode, uint8_t border, uint32_t blocks /*, bool doub
     uint32_t       *srgb;
     int            *ap;
     int            *bp;
-
-#define COMPOSITE_CONVERT(I, Q)                                                  \
-    do {                                                                         \
-        i[1] = (i[1] << 3) - ap[1];                                              \
-        a    = ap[0];                                                            \
-        b    = bp[0];                                                            \
-        c    = i[0] + i[0];                                                      \
-        d    = i[-1] + i[1];                                                     \
-        y    = ((c + d) << 8) + video_sharpness * (c - d);                       \
-        rr   = y + video_ri * (I) + video_rq * (Q);                              \
-        gg   = y + video_gi * (I) + video_gq * (Q);                              \
-        bb   = y + video_bi * (I) + video_bq * (Q);                              \
-        ++i;                                                                     \
-        ++ap;                                                                    \
-        ++bp;                                                                    \
-        *srgb = (byte_clamp(rr) << 16) | (byte_clamp(gg) << 8) | byte_clamp(bb); \
-        ++srgb;                                                                  \
-    } while (0)
+    const int16_t  *iqp;
 
 #define OUT(v)    \
     do {          \
@@ -263,27 +270,100 @@ Composite_Process(uint8_t cgamode, uint8_t border, uint32_t blocks /*, bool doub
             ++i;
         }
 
+        /* The luma update is a one-ahead in-place rewrite in the decode
+           loop of the original code; every sample's final value is just
+           (raw << 3) - chroma, so fold it here and the decode loop loses
+           its serial dependency. */
+        i = temp + 5;
+        for (int x = -1; x <= w; ++x)
+            i[x] = (i[x] << 3) - ap[x];
+
+        /* Apply the repeating 4-phase sign pattern to the chroma pair up
+           front; the decode then uses one (I, Q) form for every pixel. */
+        for (int x = 0; x < w; ++x) {
+            int a = ap[x];
+            int b2 = bp[x];
+
+            switch (x & 3) {
+                case 0:
+                    iqtemp[x * 2]     = a;
+                    iqtemp[x * 2 + 1] = b2;
+                    break;
+                case 1:
+                    iqtemp[x * 2]     = -b2;
+                    iqtemp[x * 2 + 1] = a;
+                    break;
+                case 2:
+                    iqtemp[x * 2]     = -a;
+                    iqtemp[x * 2 + 1] = -b2;
+                    break;
+                case 3:
+                    iqtemp[x * 2]     = b2;
+                    iqtemp[x * 2 + 1] = -a;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
         /* Decode */
-        i     = temp + 5;
-        i[-1] = (i[-1] << 3) - ap[-1];
-        i[0]  = (i[0] << 3) - ap[0];
-        srgb  = TempLine;
-        for (x2 = 0; x2 < blocks; ++x2) {
-            int y;
-            int a;
-            int b;
-            int c;
-            int d;
-            int rr;
-            int gg;
-            int bb;
-            COMPOSITE_CONVERT(a, b);
-            COMPOSITE_CONVERT(-b, a);
-            COMPOSITE_CONVERT(-a, -b);
-            COMPOSITE_CONVERT(b, -a);
+        i    = temp + 5;
+        iqp  = iqtemp;
+        srgb = TempLine;
+        x2   = 0;
+#ifdef CGA_COMP_SSE2
+        {
+            /* Four pixels (one full phase cycle) per iteration: luma from
+               32-bit lanes, the chroma contribution of each channel as one
+               multiply-add over the interleaved (I, Q) pairs, clamping via
+               the saturating packs - output matches the scalar code
+               exactly. */
+            const __m128i vsharp = _mm_set1_epi32(video_sharpness);
+            const __m128i vriq   = _mm_setr_epi16(video_ri, video_rq, video_ri, video_rq, video_ri, video_rq, video_ri, video_rq);
+            const __m128i vgiq   = _mm_setr_epi16(video_gi, video_gq, video_gi, video_gq, video_gi, video_gq, video_gi, video_gq);
+            const __m128i vbiq   = _mm_setr_epi16(video_bi, video_bq, video_bi, video_bq, video_bi, video_bq, video_bi, video_bq);
+            const __m128i zero   = _mm_setzero_si128();
+
+            for (; (x2 + 4) <= (uint32_t) w; x2 += 4) {
+                __m128i im1 = _mm_loadu_si128((const __m128i *) (i - 1));
+                __m128i i0  = _mm_loadu_si128((const __m128i *) i);
+                __m128i ip1 = _mm_loadu_si128((const __m128i *) (i + 1));
+                __m128i c   = _mm_add_epi32(i0, i0);
+                __m128i d   = _mm_add_epi32(im1, ip1);
+                __m128i y   = _mm_add_epi32(_mm_slli_epi32(_mm_add_epi32(c, d), 8),
+                                            mullo_epi32(vsharp, _mm_sub_epi32(c, d)));
+                __m128i iq  = _mm_loadu_si128((const __m128i *) iqp);
+                __m128i rr  = _mm_srai_epi32(_mm_add_epi32(y, _mm_madd_epi16(iq, vriq)), 13);
+                __m128i gg  = _mm_srai_epi32(_mm_add_epi32(y, _mm_madd_epi16(iq, vgiq)), 13);
+                __m128i bb  = _mm_srai_epi32(_mm_add_epi32(y, _mm_madd_epi16(iq, vbiq)), 13);
+                __m128i r8  = _mm_packus_epi16(_mm_packs_epi32(rr, rr), zero);
+                __m128i g8  = _mm_packus_epi16(_mm_packs_epi32(gg, gg), zero);
+                __m128i b8  = _mm_packus_epi16(_mm_packs_epi32(bb, bb), zero);
+                __m128i bg  = _mm_unpacklo_epi8(b8, g8);
+                __m128i r0  = _mm_unpacklo_epi8(r8, zero);
+
+                _mm_storeu_si128((__m128i *) srgb, _mm_unpacklo_epi16(bg, r0));
+                i += 4;
+                iqp += 8;
+                srgb += 4;
+            }
+        }
+#endif
+        for (; x2 < (uint32_t) w; ++x2) {
+            int c  = i[0] + i[0];
+            int d  = i[-1] + i[1];
+            int y  = ((c + d) << 8) + video_sharpness * (c - d);
+            int rr = y + video_ri * iqp[0] + video_rq * iqp[1];
+            int gg = y + video_gi * iqp[0] + video_gq * iqp[1];
+            int bb = y + video_bi * iqp[0] + video_bq * iqp[1];
+
+            *srgb = (byte_clamp(rr) << 16) | (byte_clamp(gg) << 8) | byte_clamp(bb);
+            ++srgb;
+            ++i;
+            iqp += 2;
         }
     }
-#undef COMPOSITE_CONVERT
 #undef OUT
 
     return TempLine;
@@ -665,6 +665,9 @@ gd54xx_set_svga_fast(gd54xx_t *gd54xx)
         svga->fast = ((svga->gdcreg[8] == 0xff) && !(svga->gdcreg[3] & 0x18) &&
                      !svga->gdcreg[1]) && ((svga->chain4 && svga->packed_chain4) ||
                      svga->fb_only);
+
+    if (!svga->fast)
+        mem_wc_flush();
 }
 
 static void
@@ -2317,7 +2320,7 @@ gd54xx_write_modes45(svga_t *svga, uint8_t val, uint32_t addr)
             break;
     }
 
-    svga->changedvram[addr >> 12] = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 }
 
 static int
@@ -3488,7 +3491,7 @@ gd54xx_pattern_copy(gd54xx_t *gd54xx)
                     gd54xx_blit(gd54xx, bitmask, dst, target, (x < gd54xx->blt.pattern_x));
             }
             pixel                                                   = (pixel + 1) & 7;
-            svga->changedvram[((dsta + x) & svga->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, ((dsta + x) & svga->vram_mask) >> 12);
         }
         pattern_y = (pattern_y + 1) & 7;
         dsta += gd54xx->blt.dst_pitch;
@@ -3562,7 +3565,7 @@ gd54xx_mem_sys_src(gd54xx_t *gd54xx, uint32_t cpu_dat, uint32_t count)
             if (gd54xx->blt.mode & CIRRUS_BLTMODE_COLOREXPAND)
                 gd54xx->blt.xx_count = (gd54xx->blt.xx_count + 1) % gd54xx->blt.pixel_width;
 
-            svga->changedvram[(gd54xx->blt.dst_addr_backup & svga->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, (gd54xx->blt.dst_addr_backup & svga->vram_mask) >> 12);
 
             if (!gd54xx->blt.xx_count) {
                 /* 1 mask bit = 1 blitted pixel */
@@ -3630,7 +3633,7 @@ gd54xx_normal_blit(uint32_t count, gd54xx_t *gd54xx, svga_t *svga)
         count--;
 
         dst                                                   = svga->vram[dst_addr & svga->vram_mask];
-        svga->changedvram[(dst_addr & svga->vram_mask) >> 12] = changeframecount;
+        svga_dirty_mark(svga, (dst_addr & svga->vram_mask) >> 12);
 
         gd54xx_rop(gd54xx, &dst, &dst, (const uint8_t *) &src);
 
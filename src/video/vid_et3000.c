@@ -103,6 +103,8 @@ et3000_out(uint16_t addr, uint8_t val, void *priv)
                 svga->chain2_write = !(val & 4);
                 svga->chain4       = (svga->chain4 & ~8) | (val & 8);
                 svga->fast         = (svga->gdcreg[8] == 0xff && !(svga->gdcreg[3] & 0x18) && !svga->gdcreg[1]) && svga->chain4 && !(svga->adv_flags & FLAG_ADDR_BY8);
+                if (!svga->fast)
+                    mem_wc_flush();
                 return;
             }
             break;
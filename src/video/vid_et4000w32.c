@@ -930,7 +930,7 @@ et4000w32p_mmu_write(uint32_t addr, uint8_t val, void *priv)
             } else {
                 if (((addr & 0x1fff) + et4000->mmu.base[et4000->bank]) < svga->vram_max) {
                     svga->vram[((addr & 0x1fff) + et4000->mmu.base[et4000->bank]) & et4000->vram_mask]                = val;
-                    svga->changedvram[(((addr & 0x1fff) + et4000->mmu.base[et4000->bank]) & et4000->vram_mask) >> 12] = changeframecount;
+                    svga_dirty_mark(svga, (((addr & 0x1fff) + et4000->mmu.base[et4000->bank]) & et4000->vram_mask) >> 12);
                 }
             }
             break;
@@ -2134,7 +2134,7 @@ et4000w32_blit(int count, int cpu_input, uint32_t src_dat, uint32_t mix_dat, et4
 
             /*Write the data*/
             svga->vram[et4000->acl.dest_addr & et4000->vram_mask]                = out;
-            svga->changedvram[(et4000->acl.dest_addr & et4000->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, (et4000->acl.dest_addr & et4000->vram_mask) >> 12);
 
             if (et4000->acl.internal.xy_dir & 1)
                 et4000w32_decx(1, et4000);
@@ -2183,7 +2183,7 @@ et4000w32_blit(int count, int cpu_input, uint32_t src_dat, uint32_t mix_dat, et4
 
             /*Write the data*/
             svga->vram[et4000->acl.dest_addr & et4000->vram_mask]                = out;
-            svga->changedvram[(et4000->acl.dest_addr & et4000->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, (et4000->acl.dest_addr & et4000->vram_mask) >> 12);
 
             if (et4000->acl.internal.xy_dir & 1)
                 et4000w32_decx(1, et4000);
@@ -2238,7 +2238,7 @@ et4000w32_blit(int count, int cpu_input, uint32_t src_dat, uint32_t mix_dat, et4
 
             /*Write the data*/
             svga->vram[et4000->acl.dest_addr & et4000->vram_mask]                = out;
-            svga->changedvram[(et4000->acl.dest_addr & et4000->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, (et4000->acl.dest_addr & et4000->vram_mask) >> 12);
 
             if (et4000->acl.internal.xy_dir & 1)
                 et4000w32_decx(1, et4000);
@@ -2325,7 +2325,7 @@ et4000w32p_blit(int count, uint32_t mix, uint32_t sdat, int cpu_input, et4000w32
             et4000w32_log("%06X = %02X\n", et4000->acl.dest_addr & et4000->vram_mask, out);
             if (!(et4000->acl.internal.ctrl_routing & 0x40)) {
                 svga->vram[et4000->acl.dest_addr & et4000->vram_mask]                = out;
-                svga->changedvram[(et4000->acl.dest_addr & et4000->vram_mask) >> 12] = changeframecount;
+                svga_dirty_mark(svga, (et4000->acl.dest_addr & et4000->vram_mask) >> 12);
             } else {
                 et4000->acl.cpu_dat |= ((uint64_t) out << (et4000->acl.cpu_dat_pos * 8));
                 et4000->acl.cpu_dat_pos++;
@@ -2435,7 +2435,7 @@ et4000w32p_blit(int count, uint32_t mix, uint32_t sdat, int cpu_input, et4000w32
 
             if (!(et4000->acl.internal.ctrl_routing & 0x40)) {
                 svga->vram[et4000->acl.dest_addr & et4000->vram_mask]                = out;
-                svga->changedvram[(et4000->acl.dest_addr & et4000->vram_mask) >> 12] = changeframecount;
+                svga_dirty_mark(svga, (et4000->acl.dest_addr & et4000->vram_mask) >> 12);
             } else {
                 et4000->acl.cpu_dat |= ((uint64_t) out << (et4000->acl.cpu_dat_pos * 8));
                 et4000->acl.cpu_dat_pos++;
@@ -314,68 +314,111 @@ hercules_poll(void *priv)
             }
             dev->lastline = dev->displine;
 
-            hercules_render_overscan_left(dev);
+            /* Hash the scanline's source data and state; a matching line is
+               still in the buffer from the last frame and the whole redraw
+               (overscan, glyphs/pixels and the palette pass) is skipped.
+               Blended graphics lines are always redrawn - video_blend()
+               carries state from one call into the next. */
+            uint8_t state[12] = { dev->crtc[1], (uint8_t) dev->sc, dev->ctrl, dev->ctrl2,
+                                  (uint8_t) (dev->blink & 16),
+                                  (uint8_t) (dev->con && dev->cursoron),
+                                  (uint8_t) ca, (uint8_t) (ca >> 8),
+                                  (uint8_t) dev->ma, (uint8_t) (dev->ma >> 8),
+                                  (uint8_t) video_grayscale, (uint8_t) herc_blend };
+            uint32_t hash     = video_hash(VIDEO_HASH_INIT, state, sizeof(state));
+            int      skip     = 0;
 
             if (dev->ctrl & 0x02) {
-                ca = (dev->sc & 3) * 0x2000;
-                if (dev->ctrl & 0x80)
-                    ca += 0x8000;
+                if (!herc_blend) {
+                    if (dev->ctrl & 8) {
+                        uint16_t base = (dev->sc & 3) * 0x2000;
 
-                for (x = 0; x < dev->crtc[1]; x++) {
-                    if (dev->ctrl & 8)
-                        dat = (dev->vram[((dev->ma << 1) & 0x1fff) + ca] << 8) | dev->vram[((dev->ma << 1) & 0x1fff) + ca + 1];
-                    else
-                        dat = 0;
-                    dev->ma++;
-                    for (c = 0; c < 16; c++)
-                        buffer32->line[dev->displine + 14][(x << 4) + c + 8] = (dat & (32768 >> c)) ? 7 : 0;
-                    for (c = 0; c < 16; c += 8)
-                        video_blend((x << 4) + c + 8, dev->displine + 14);
+                        if (dev->ctrl & 0x80)
+                            base += 0x8000;
+                        for (x = 0; x < dev->crtc[1]; x++)
+                            hash = video_hash(hash, &dev->vram[(((dev->ma + x) << 1) & 0x1fff) + base], 2);
+                    }
+                    skip = (hash == dev->line_hash[dev->displine]);
                 }
             } else {
-                for (x = 0; x < dev->crtc[1]; x++) {
-                    if (dev->ctrl & 8) {
-                        /* Undocumented behavior: page 1 in text mode means characters are read
-                           from page 1 and attributes from page 0. */
-                        chr  = dev->charbuffer[x << 1];
-                        attr = dev->charbuffer[(x << 1) + 1];
-                    } else
-                        chr = attr = 0;
-                    drawcursor = ((dev->ma == ca) && dev->con && dev->cursoron);
-                    blink      = ((dev->blink & 16) && (dev->ctrl & 0x20) && (attr & 0x80) && !drawcursor);
-
-                    if (dev->sc == 12 && ((attr & 7) == 1)) {
-                        for (c = 0; c < 9; c++)
-                            buffer32->line[dev->displine + 14][(x * 9) + c + 8] = dev->cols[attr][blink][1];
-                    } else {
-                        for (c = 0; c < 8; c++)
-                            buffer32->line[dev->displine + 14][(x * 9) + c + 8] = dev->cols[attr][blink][(fontdatm[chr][dev->sc] & (1 << (c ^ 7))) ? 1 : 0];
+                if (dev->ctrl & 8)
+                    hash = video_hash(hash, dev->charbuffer, dev->crtc[1] << 1);
+                skip = (hash == dev->line_hash[dev->displine]);
+            }
+
+            if (skip) {
+                if (dev->ctrl & 0x02)
+                    dev->ma += dev->crtc[1];
+                else if (dev->ctrl2 & 0x01)
+                    dev->ma = (dev->ma + dev->crtc[1]) & 0x3fff;
+                else
+                    dev->ma = (dev->ma + dev->crtc[1]) & 0x7ff;
+            } else {
+                dev->line_hash[dev->displine] = hash;
+
+                hercules_render_overscan_left(dev);
 
-                        if ((chr & ~0x1f) == 0xc0)
-                            buffer32->line[dev->displine + 14][(x * 9) + 8 + 8] = dev->cols[attr][blink][fontdatm[chr][dev->sc] & 1];
+                if (dev->ctrl & 0x02) {
+                    ca = (dev->sc & 3) * 0x2000;
+                    if (dev->ctrl & 0x80)
+                        ca += 0x8000;
+
+                    for (x = 0; x < dev->crtc[1]; x++) {
+                        if (dev->ctrl & 8)
+                            dat = (dev->vram[((dev->ma << 1) & 0x1fff) + ca] << 8) | dev->vram[((dev->ma << 1) & 0x1fff) + ca + 1];
                         else
-                            buffer32->line[dev->displine + 14][(x * 9) + 8 + 8] = dev->cols[attr][blink][0];
+                            dat = 0;
+                        dev->ma++;
+                        for (c = 0; c < 16; c++)
+                            buffer32->line[dev->displine + 14][(x << 4) + c + 8] = (dat & (32768 >> c)) ? 7 : 0;
+                        for (c = 0; c < 16; c += 8)
+                            video_blend((x << 4) + c + 8, dev->displine + 14);
                     }
-                    if (dev->ctrl2 & 0x01)
-                        dev->ma = (dev->ma + 1) & 0x3fff;
-                    else
-                        dev->ma = (dev->ma + 1) & 0x7ff;
+                } else {
+                    for (x = 0; x < dev->crtc[1]; x++) {
+                        if (dev->ctrl & 8) {
+                            /* Undocumented behavior: page 1 in text mode means characters are read
+                               from page 1 and attributes from page 0. */
+                            chr  = dev->charbuffer[x << 1];
+                            attr = dev->charbuffer[(x << 1) + 1];
+                        } else
+                            chr = attr = 0;
+                        drawcursor = ((dev->ma == ca) && dev->con && dev->cursoron);
+                        blink      = ((dev->blink & 16) && (dev->ctrl & 0x20) && (attr & 0x80) && !drawcursor);
+
+                        if (dev->sc == 12 && ((attr & 7) == 1)) {
+                            for (c = 0; c < 9; c++)
+                                buffer32->line[dev->displine + 14][(x * 9) + c + 8] = dev->cols[attr][blink][1];
+                        } else {
+                            for (c = 0; c < 8; c++)
+                                buffer32->line[dev->displine + 14][(x * 9) + c + 8] = dev->cols[attr][blink][(fontdatm[chr][dev->sc] & (1 << (c ^ 7))) ? 1 : 0];
+
+                            if ((chr & ~0x1f) == 0xc0)
+                                buffer32->line[dev->displine + 14][(x * 9) + 8 + 8] = dev->cols[attr][blink][fontdatm[chr][dev->sc] & 1];
+                            else
+                                buffer32->line[dev->displine + 14][(x * 9) + 8 + 8] = dev->cols[attr][blink][0];
+                        }
+                        if (dev->ctrl2 & 0x01)
+                            dev->ma = (dev->ma + 1) & 0x3fff;
+                        else
+                            dev->ma = (dev->ma + 1) & 0x7ff;
 
-                    if (drawcursor) {
-                        for (c = 0; c < 9; c++)
-                            buffer32->line[dev->displine + 14][(x * 9) + c + 8] ^= dev->cols[attr][0][1];
+                        if (drawcursor) {
+                            for (c = 0; c < 9; c++)
+                                buffer32->line[dev->displine + 14][(x * 9) + c + 8] ^= dev->cols[attr][0][1];
+                        }
                     }
                 }
-            }
 
-            hercules_render_overscan_right(dev);
+                hercules_render_overscan_right(dev);
 
-            if (dev->ctrl & 0x02)
-                x = dev->crtc[1] << 4;
-            else
-                x = dev->crtc[1] * 9;
+                if (dev->ctrl & 0x02)
+                    x = dev->crtc[1] << 4;
+                else
+                    x = dev->crtc[1] * 9;
 
-            video_process_8(x + 16, dev->displine + 14);
+                video_process_8(x + 16, dev->displine + 14);
+            }
         }
         dev->sc = oldsc;
 
@@ -425,6 +425,8 @@ ht216_out(uint16_t addr, uint8_t val, void *priv)
 
             if (svga->gdcaddr <= 8) {
                 svga->fast = (svga->gdcreg[8] == 0xff && !(svga->gdcreg[3] & 0x18) && !svga->gdcreg[1]) && svga->chain4 && svga->packed_chain4;
+                if (!svga->fast)
+                    mem_wc_flush();
             }
             break;
 
@@ -847,7 +849,7 @@ ht216_dm_write(ht216_t *ht216, uint32_t addr, uint8_t cpu_dat, uint8_t cpu_dat_u
     if (addr >= svga->vram_max)
         return;
 
-    svga->changedvram[addr >> 12] = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     if (ht216->ht_regs[0xcd] & HT_REG_CD_P8PCEXP)
         count = 8;
@@ -1055,7 +1057,7 @@ ht216_dm_extalu_write(ht216_t *ht216, uint32_t addr, uint8_t cpu_dat, uint8_t bi
     bg                                     = extalu(ht216->ht_regs[0xce] & 0xf, input_a, input_b);
     output                                 = (fg & rop_select) | (bg & ~rop_select);
     svga->vram[addr]                       = (svga->vram[remapped_addr] & ~bit_mask) | (output & bit_mask);
-    svga->changedvram[remapped_addr >> 12] = changeframecount;
+    svga_dirty_mark(svga, remapped_addr >> 12);
 }
 
 static void
@@ -1095,7 +1097,7 @@ ht216_dm_masked_write(ht216_t *ht216, uint32_t addr, uint8_t val, uint8_t bit_ma
 
     addr &= svga->vram_mask;
 
-    svga->changedvram[addr >> 12] = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     if (ht216->ht_regs[0xcd] & HT_REG_CD_P8PCEXP) {
         count     = 8;
@@ -155,30 +155,56 @@ mda_poll(void *priv)
                 video_wait_for_buffer();
             }
             mda->lastline = mda->displine;
-            for (x = 0; x < mda->crtc[1]; x++) {
-                chr        = mda->vram[(mda->ma << 1) & 0xfff];
-                attr       = mda->vram[((mda->ma << 1) + 1) & 0xfff];
-                drawcursor = ((mda->ma == ca) && mda->con && mda->cursoron);
-                blink      = ((mda->blink & 16) && (mda->ctrl & 0x20) && (attr & 0x80) && !drawcursor);
-                if (mda->sc == 12 && ((attr & 7) == 1)) {
-                    for (c = 0; c < 9; c++)
-                        buffer32->line[mda->displine][(x * 9) + c] = mdacols[attr][blink][1];
-                } else {
-                    for (c = 0; c < 8; c++)
-                        buffer32->line[mda->displine][(x * 9) + c] = mdacols[attr][blink][(fontdatm[chr + mda->fontbase][mda->sc] & (1 << (c ^ 7))) ? 1 : 0];
-                    if ((chr & ~0x1f) == 0xc0)
-                        buffer32->line[mda->displine][(x * 9) + 8] = mdacols[attr][blink][fontdatm[chr + mda->fontbase][mda->sc] & 1];
-                    else
-                        buffer32->line[mda->displine][(x * 9) + 8] = mdacols[attr][blink][0];
-                }
-                mda->ma++;
-                if (drawcursor) {
-                    for (c = 0; c < 9; c++)
-                        buffer32->line[mda->displine][(x * 9) + c] ^= mdacols[attr][0][1];
-                }
+
+            /* Hash the row's characters plus everything else that shapes
+               this scanline; when nothing changed, the buffer already
+               holds the right output and the glyph expansion and palette
+               pass can both be skipped. */
+            uint8_t state[10] = { mda->crtc[1], (uint8_t) mda->sc, mda->ctrl,
+                                  (uint8_t) (mda->blink & 16),
+                                  (uint8_t) (mda->con && mda->cursoron),
+                                  (uint8_t) ca, (uint8_t) (ca >> 8),
+                                  (uint8_t) mda->ma, (uint8_t) (mda->ma >> 8),
+                                  (uint8_t) video_grayscale };
+            uint32_t hash     = video_hash(VIDEO_HASH_INIT, state, sizeof(state));
+
+            hash = video_hash(hash, &mda->fontbase, sizeof(mda->fontbase));
+            for (x = 0; x < (mda->crtc[1] << 1); x++) {
+                uint8_t b = mda->vram[((mda->ma << 1) + x) & 0xfff];
+
+                hash = video_hash(hash, &b, 1);
             }
 
-            video_process_8(mda->crtc[1] * 9, mda->displine);
+            if (hash == mda->line_hash[mda->displine])
+                mda->ma += mda->crtc[1];
+            else {
+                mda->line_hash[mda->displine] = hash;
+
+                for (x = 0; x < mda->crtc[1]; x++) {
+                    chr        = mda->vram[(mda->ma << 1) & 0xfff];
+                    attr       = mda->vram[((mda->ma << 1) + 1) & 0xfff];
+                    drawcursor = ((mda->ma == ca) && mda->con && mda->cursoron);
+                    blink      = ((mda->blink & 16) && (mda->ctrl & 0x20) && (attr & 0x80) && !drawcursor);
+                    if (mda->sc == 12 && ((attr & 7) == 1)) {
+                        for (c = 0; c < 9; c++)
+                            buffer32->line[mda->displine][(x * 9) + c] = mdacols[attr][blink][1];
+                    } else {
+                        for (c = 0; c < 8; c++)
+                            buffer32->line[mda->displine][(x * 9) + c] = mdacols[attr][blink][(fontdatm[chr + mda->fontbase][mda->sc] & (1 << (c ^ 7))) ? 1 : 0];
+                        if ((chr & ~0x1f) == 0xc0)
+                            buffer32->line[mda->displine][(x * 9) + 8] = mdacols[attr][blink][fontdatm[chr + mda->fontbase][mda->sc] & 1];
+                        else
+                            buffer32->line[mda->displine][(x * 9) + 8] = mdacols[attr][blink][0];
+                    }
+                    mda->ma++;
+                    if (drawcursor) {
+                        for (c = 0; c < 9; c++)
+                            buffer32->line[mda->displine][(x * 9) + c] ^= mdacols[attr][0][1];
+                    }
+                }
+
+                video_process_8(mda->crtc[1] * 9, mda->displine);
+            }
         }
         mda->sc = oldsc;
         if (mda->vc == mda->crtc[7] && !mda->sc) {
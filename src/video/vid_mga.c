@@ -2874,7 +2874,7 @@ mystique_writeb_linear(uint32_t addr, uint8_t val, void *priv)
     if (addr >= svga->vram_max)
         return;
     addr &= svga->vram_mask;
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     svga->vram[addr]              = val;
 }
 
@@ -2889,7 +2889,7 @@ mystique_writew_linear(uint32_t addr, uint16_t val, void *priv)
     if (addr >= svga->vram_max)
         return;
     addr &= svga->vram_mask;
-    svga->changedvram[addr >> 12]   = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint16_t *) &svga->vram[addr] = val;
 }
 
@@ -2904,7 +2904,7 @@ mystique_writel_linear(uint32_t addr, uint32_t val, void *priv)
     if (addr >= svga->vram_max)
         return;
     addr &= svga->vram_mask;
-    svga->changedvram[addr >> 12]   = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint32_t *) &svga->vram[addr] = val;
 }
 
@@ -3239,8 +3239,12 @@ mystique_queue(mystique_t *mystique, uint32_t addr, uint32_t val, uint32_t type)
 
     if (FIFO_FULL) {
         thread_reset_event(mystique->fifo_not_full_event);
-        if (FIFO_FULL)
+        if (FIFO_FULL) {
+            /* The wake timer runs on the CPU thread, which is about to block -
+               signal the FIFO thread directly or nothing will ever drain. */
+            wake_fifo_thread_now(mystique);
             thread_wait_event(mystique->fifo_not_full_event, -1); /* Wait for room in ringbuffer */
+        }
     }
 
     fifo->val       = val;
@@ -3248,7 +3252,9 @@ mystique_queue(mystique_t *mystique, uint32_t addr, uint32_t val, uint32_t type)
 
     mystique->fifo_write_idx++;
 
-    if (FIFO_ENTRIES > FIFO_THRESHOLD || FIFO_ENTRIES < 8)
+    if (FIFO_ENTRIES > FIFO_THRESHOLD)
+        wake_fifo_thread_now(mystique);
+    else if (FIFO_ENTRIES < 8)
         wake_fifo_thread(mystique);
 }
 
@@ -3525,14 +3531,14 @@ blit_fbitblt(mystique_t *mystique)
                         src = svga->vram[src_addr & mystique->vram_mask];
 
                         svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask]                = src;
-                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                         break;
 
                     case MACCESS_PWIDTH_16:
                         src = ((uint16_t *) svga->vram)[src_addr & mystique->vram_mask_w];
 
                         ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = src;
-                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                         break;
 
                     case MACCESS_PWIDTH_24:
@@ -3540,14 +3546,14 @@ blit_fbitblt(mystique_t *mystique)
                         old_dst = *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask];
 
                         *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (src & 0xffffff) | (old_dst & 0xff000000);
-                        svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                        svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                         break;
 
                     case MACCESS_PWIDTH_32:
                         src = ((uint32_t *) svga->vram)[src_addr & mystique->vram_mask_l];
 
                         ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = src;
-                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10] = changeframecount;
+                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10);
                         break;
 
                     default:
@@ -3662,7 +3668,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
 
                                     dst                                                                                                  = bitop(data & 0xff, dst, mystique->dwgreg.dwgctrl_running);
                                     svga->vram[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask]                = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask) >> 12] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask) >> 12);
                                 }
 
                                 data >>= 8;
@@ -3675,7 +3681,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
 
                                     dst                                                                                                    = bitop(data & 0xffff, dst, mystique->dwgreg.dwgctrl_running);
                                     ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11);
                                 }
 
                                 data >>= 16;
@@ -3688,7 +3694,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
 
                                     dst                                                                                                          = bitop(data64, old_dst, mystique->dwgreg.dwgctrl_running);
                                     *((uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask]) = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                    svga->changedvram[(((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask) >> 12]   = changeframecount;
+                                    svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask) >> 12);
                                 }
 
                                 data64 >>= 24;
@@ -3701,7 +3707,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
 
                                     dst                                                                                                    = bitop(data, dst, mystique->dwgreg.dwgctrl_running);
                                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                                 }
 
                                 size = 0;
@@ -3747,7 +3753,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                     svga->vram[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask]                = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask) >> 12] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask) >> 12);
                                     break;
 
                                 case MACCESS_PWIDTH_16:
@@ -3756,7 +3762,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                     ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11);
                                     break;
 
                                 case MACCESS_PWIDTH_24:
@@ -3765,7 +3771,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(src, old_dst, mystique->dwgreg.dwgctrl_running);
 
                                     *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                    svga->changedvram[(((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                    svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) * 3) & mystique->vram_mask) >> 12);
                                     break;
 
                                 case MACCESS_PWIDTH_32:
@@ -3774,7 +3780,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                                     break;
 
                                 default:
@@ -3816,7 +3822,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(data64 & 0xffffff, dst, mystique->dwgreg.dwgctrl_running);
 
                                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                                     break;
 
                                 default:
@@ -3857,7 +3863,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
 
                             dst                                                                                                    = bitop(data, dst, mystique->dwgreg.dwgctrl_running);
                             ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                            svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                            svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                         }
 
                         size = 0;
@@ -3894,7 +3900,7 @@ blit_iload_iload(mystique_t *mystique, uint32_t data, int size)
                                     dst = bitop(data, dst2, mystique->dwgreg.dwgctrl_running);
 
                                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                                     break;
 
                                 default:
@@ -4009,7 +4015,7 @@ blit_iload_iload_scale(mystique_t *mystique, uint32_t data, int size)
                     uint16_t dst                                                                                           = ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w];
                     dst                                                                                                    = bitop(data & 0xffff, dst, mystique->dwgreg.dwgctrl_running);
                     ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w] = dst;
-                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11] = changeframecount;
+                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11);
                 }
 
                 mystique->dwgreg.ar[6] += mystique->dwgreg.ar[2];
@@ -4043,7 +4049,7 @@ blit_iload_iload_scale(mystique_t *mystique, uint32_t data, int size)
                     uint32_t dst                                                                                           = ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l];
                     dst                                                                                                    = bitop(data64, dst, mystique->dwgreg.dwgctrl_running);
                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                 }
 
                 mystique->dwgreg.ar[6] += mystique->dwgreg.ar[2];
@@ -4158,14 +4164,14 @@ blit_iload_iload_high(mystique_t *mystique, uint32_t data, int size)
                     dst                                                                                                    = ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w];
                     dst                                                                                                    = bitop(out_data, dst, mystique->dwgreg.dwgctrl_running);
                     ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w] = dst;
-                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11] = changeframecount;
+                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_w) >> 11);
                     break;
                 case MACCESS_PWIDTH_32:
                     out_data                                                                                               = out_b | (out_g << 8) | (out_r << 16);
                     dst                                                                                                    = ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l];
                     dst                                                                                                    = bitop(out_data, dst, mystique->dwgreg.dwgctrl_running);
                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l] = dst;
-                    svga->changedvram[((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10] = changeframecount;
+                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + mystique->dwgreg.xdst) & mystique->vram_mask_l) >> 10);
                     break;
 
                 default:
@@ -4333,10 +4339,10 @@ blit_line(mystique_t *mystique, int closed)
                             dst                                                                              = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                             if (closed) {
                                 svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask]                = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                             } else if (!closed && (len < mystique->dwgreg.length)) {
                                 svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask]                = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                             }
                             break;
 
@@ -4347,10 +4353,10 @@ blit_line(mystique_t *mystique, int closed)
                             dst                                                                                = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                             if (closed) {
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                             } else if (!closed && (len < mystique->dwgreg.length)) {
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                             }
                             break;
 
@@ -4361,10 +4367,10 @@ blit_line(mystique_t *mystique, int closed)
                             dst                                                                                    = bitop(src, old_dst, mystique->dwgreg.dwgctrl_running);
                             if (closed) {
                                 *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                             } else if (!closed && (len < mystique->dwgreg.length)) {
                                 *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                             }
                             break;
 
@@ -4375,10 +4381,10 @@ blit_line(mystique_t *mystique, int closed)
                             dst                                                                                = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                             if (closed) {
                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10);
                             } else if (!closed && (len < mystique->dwgreg.length)) {
                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10);
                             }
                             break;
 
@@ -4446,7 +4452,7 @@ blit_line(mystique_t *mystique, int closed)
                                 dst = (r << 11) | (g << 5) | b;
 
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                                 break;
 
                             default:
@@ -4572,23 +4578,23 @@ blit_trap(mystique_t *mystique)
                         switch (mystique->maccess_running & MACCESS_PWIDTH_MASK) {
                             case MACCESS_PWIDTH_8:
                                 svga->vram[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask]                = (pattern ? mystique->dwgreg.fcol : mystique->dwgreg.bcol) & 0xff;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12);
                                 break;
 
                             case MACCESS_PWIDTH_16:
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w] = (pattern ? mystique->dwgreg.fcol : mystique->dwgreg.bcol) & 0xffff;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11);
                                 break;
 
                             case MACCESS_PWIDTH_24:
                                 dst                                                                                        = *(uint32_t *) (&svga->vram[((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask]) & 0xff000000;
                                 *(uint32_t *) (&svga->vram[((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask]) = ((pattern ? mystique->dwgreg.fcol : mystique->dwgreg.bcol) & 0xffffff) | dst;
-                                svga->changedvram[(((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12]   = changeframecount;
+                                svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12);
                                 break;
 
                             case MACCESS_PWIDTH_32:
                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l] = pattern ? mystique->dwgreg.fcol : mystique->dwgreg.bcol;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10);
                                 break;
 
                             default:
@@ -4643,7 +4649,7 @@ blit_trap(mystique_t *mystique)
 
                                 dst                                                                                = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                                 svga->vram[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask]                = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12);
                                 break;
 
                             case MACCESS_PWIDTH_16:
@@ -4651,7 +4657,7 @@ blit_trap(mystique_t *mystique)
 
                                 dst                                                                                  = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11);
                                 break;
 
                             case MACCESS_PWIDTH_24:
@@ -4659,7 +4665,7 @@ blit_trap(mystique_t *mystique)
 
                                 dst                                                                                      = bitop(src, old_dst, mystique->dwgreg.dwgctrl_running);
                                 *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                svga->changedvram[(((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12);
                                 break;
 
                             case MACCESS_PWIDTH_32:
@@ -4667,7 +4673,7 @@ blit_trap(mystique_t *mystique)
 
                                 dst                                                                                  = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l] = dst;
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10);
                                 break;
 
                             default:
@@ -4757,24 +4763,24 @@ blit_trap(mystique_t *mystique)
                             switch (mystique->maccess_running & MACCESS_PWIDTH_MASK) {
                                 case MACCESS_PWIDTH_8:
                                     svga->vram[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask]                = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask) >> 12);
                                     break;
 
                                 case MACCESS_PWIDTH_16:
                                     dst                                                                                  = dither(mystique, r, g, b, x_l & 1, mystique->dwgreg.selline & 1);
                                     ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w] = dst;
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11);
                                     break;
 
                                 case MACCESS_PWIDTH_24:
                                     old_dst                                                                                    = *(uint32_t *) (&svga->vram[((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask]) & 0xff000000;
                                     *(uint32_t *) (&svga->vram[((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask]) = old_dst | dst;
-                                    svga->changedvram[(((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12]   = changeframecount;
+                                    svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x_l) * 3) & mystique->vram_mask) >> 12);
                                     break;
 
                                 case MACCESS_PWIDTH_32:
                                     ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l] = b | (g << 8) | (r << 16);
-                                    svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                    svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10);
                                     break;
 
                                 default:
@@ -5221,10 +5227,10 @@ blit_texture_trap(mystique_t *mystique)
 
                             if (dest32) {
                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l] = tex_b | (tex_g << 8) | (tex_r << 16);
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_l) >> 10);
                             } else {
                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w] = dither(mystique, tex_r, tex_g, tex_b, x_l & 1, mystique->dwgreg.selline & 1);
-                                svga->changedvram[((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x_l) & mystique->vram_mask_w) >> 11);
                             }
                             if (z_write) {
                                 if (mystique->maccess_running & MACCESS_ZWIDTH) {
@@ -5358,7 +5364,7 @@ blit_bitblt(mystique_t *mystique)
                                                 svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask] = mystique->dwgreg.fcol;
                                         } else
                                             svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask] = (svga->vram[byte_addr] & (1 << bit_offset)) ? mystique->dwgreg.fcol : mystique->dwgreg.bcol;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_16:
@@ -5367,7 +5373,7 @@ blit_bitblt(mystique_t *mystique)
                                                 ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = mystique->dwgreg.fcol;
                                         } else
                                             ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = (svga->vram[byte_addr] & (1 << bit_offset)) ? mystique->dwgreg.fcol : mystique->dwgreg.bcol;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                                         break;
 
                                     case MACCESS_PWIDTH_24:
@@ -5377,7 +5383,7 @@ blit_bitblt(mystique_t *mystique)
                                                 *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (old_dst & 0xff000000) | (mystique->dwgreg.fcol & 0xffffff);
                                         } else
                                             *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (old_dst & 0xff000000) | (((svga->vram[byte_addr] & (1 << bit_offset)) ? mystique->dwgreg.fcol : mystique->dwgreg.bcol) & 0xffffff);
-                                        svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_32:
@@ -5386,7 +5392,7 @@ blit_bitblt(mystique_t *mystique)
                                                 ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = mystique->dwgreg.fcol;
                                         } else
                                             ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = (svga->vram[byte_addr] & (1 << bit_offset)) ? mystique->dwgreg.fcol : mystique->dwgreg.bcol;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 11] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 11);
                                         break;
 
                                     default:
@@ -5472,7 +5478,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask]                = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_16:
@@ -5481,7 +5487,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                                         break;
 
                                     case MACCESS_PWIDTH_24:
@@ -5490,7 +5496,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, old_dst, mystique->dwgreg.dwgctrl_running); // & DWGCTRL_BOP_MASK
 
                                         *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                        svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_32:
@@ -5499,7 +5505,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10);
                                         break;
 
                                     default:
@@ -5555,7 +5561,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         svga->vram[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask]                = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_16:
@@ -5565,7 +5571,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         ((uint16_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w] = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_w) >> 11);
                                         break;
 
                                     case MACCESS_PWIDTH_24:
@@ -5575,7 +5581,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, old_dst, mystique->dwgreg.dwgctrl_running);
 
                                         *(uint32_t *) &svga->vram[((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask] = (dst & 0xffffff) | (old_dst & 0xff000000);
-                                        svga->changedvram[(((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12] = changeframecount;
+                                        svga_dirty_mark(svga, (((mystique->dwgreg.ydst_lin + x) * 3) & mystique->vram_mask) >> 12);
                                         break;
 
                                     case MACCESS_PWIDTH_32:
@@ -5585,7 +5591,7 @@ blit_bitblt(mystique_t *mystique)
                                         dst = bitop(src, dst, mystique->dwgreg.dwgctrl_running);
 
                                         ((uint32_t *) svga->vram)[(mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l] = dst;
-                                        svga->changedvram[((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10] = changeframecount;
+                                        svga_dirty_mark(svga, ((mystique->dwgreg.ydst_lin + x) & mystique->vram_mask_l) >> 10);
                                         break;
 
                                     default:
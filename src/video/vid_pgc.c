@@ -818,8 +818,9 @@ pgc_draw_line(pgc_t *dev, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16
 void
 pgc_fill_line_r(pgc_t *dev, int32_t x0, int32_t x1, int32_t y0)
 {
-    int32_t mask = 0x8000 >> (x0 & 0x0f);
-    int32_t x;
+    const uint16_t pattern = dev->fill_pattern[y0 & 0x0f];
+    uint8_t       *vram;
+    int32_t        x;
 
     if (x0 > x1) {
         x  = x1;
@@ -827,12 +828,49 @@ pgc_fill_line_r(pgc_t *dev, int32_t x0, int32_t x1, int32_t y0)
         x0 = x;
     }
 
-    for (x = x0; x <= x1; x++) {
-        if (dev->fill_pattern[y0 & 0x0F] & mask)
-            pgc_plot(dev, x, y0);
-        mask = mask >> 1;
-        if (mask == 0)
-            mask = 0x8000;
+    /* Clip the whole span against the viewport once rather than pixel
+     * by pixel in pgc_plot(). */
+    if (x0 < dev->vp_x1)
+        x0 = dev->vp_x1;
+    if (x1 > dev->vp_x2)
+        x1 = dev->vp_x2;
+    if ((uint32_t) x1 >= dev->maxw)
+        x1 = dev->maxw - 1;
+    if ((x0 > x1) || (y0 < dev->vp_y1) || (y0 > dev->vp_y2) || ((uint32_t) y0 >= dev->maxh))
+        return;
+
+    vram = pgc_vram_addr(dev, x0, y0);
+    if (!vram)
+        return;
+
+    /* A solid fill in WRITE mode covers most polygon and ellipse work;
+     * write the whole run at once. */
+    if ((pattern == 0xffff) && (dev->draw_mode == 0)) {
+        memset(vram, dev->color, x1 - x0 + 1);
+        return;
+    }
+
+    for (x = x0; x <= x1; x++, vram++) {
+        if (pattern & (0x8000 >> (x & 0x0f))) {
+            switch (dev->draw_mode) {
+                default:
+                case 0: /* WRITE */
+                    *vram = dev->color;
+                    break;
+
+                case 1: /* INVERT */
+                    *vram ^= 0xff;
+                    break;
+
+                case 2: /* XOR color */
+                    *vram ^= dev->color;
+                    break;
+
+                case 3: /* AND color */
+                    *vram &= dev->color;
+                    break;
+            }
+        }
     }
 }
 
@@ -2276,16 +2314,20 @@ pgc_write(uint32_t addr, uint8_t val, void *priv)
                     break;
 
                 case 0x303: /* output read pointer */
+                    /* The drawing thread is blocked with results ready;
+                     * going through the wake timer would stall it for
+                     * WAKE_DELAY on every drained byte, so signal it
+                     * directly. */
                     if (dev->waiting_output_fifo && dev->mapram[0x302] != (uint8_t) (dev->mapram[0x303] - 1)) {
                         dev->waiting_output_fifo = 0;
-                        pgc_wake(dev);
+                        wake_timer(dev);
                     }
                     break;
 
                 case 0x305: /* error read pointer */
                     if (dev->waiting_error_fifo && dev->mapram[0x304] != (uint8_t) (dev->mapram[0x305] - 1)) {
                         dev->waiting_error_fifo = 0;
-                        pgc_wake(dev);
+                        wake_timer(dev);
                     }
                     break;
 
@@ -39,6 +39,7 @@
 #include <86box/vid_ddc.h>
 #include <86box/vid_svga.h>
 #include <86box/vid_svga_render.h>
+#include <86box/vid_accel_rop.h>
 #include "cpu.h"
 
 #define ROM_ORCHID_86C911              "roms/video/s3/BIOS.BIN"
@@ -492,7 +493,11 @@ s3_queue(s3_t *s3, uint32_t addr, uint32_t val, uint32_t type)
 
     s3->fifo_write_idx++;
 
-    if (FIFO_ENTRIES > 0xe000 || FIFO_ENTRIES < 8)
+    /*Only signal the FIFO thread when the queue goes non-empty (it drains
+      everything pending before sleeping again) or when nearly full, so that
+      bursts of small blits batch up in the ring instead of paying for an
+      event signal on every register write.*/
+    if (FIFO_ENTRIES == 1 || FIFO_ENTRIES > 0xe000)
         wake_fifo_thread(s3);
 }
 
@@ -5887,59 +5892,10 @@ polygon_setup(s3_t *s3)
     } else                                                                \
         dat = vram_l[dword_remap_l(svga, addr) & (s3->vram_mask >> 2)];
 
-#define MIX_READ                                                                                  \
-    {                                                                                             \
-        switch ((mix_dat & mix_mask) ? (s3->accel.frgd_mix & 0xf) : (s3->accel.bkgd_mix & 0xf)) { \
-            case 0x0:                                                                             \
-                dest_dat = ~dest_dat;                                                             \
-                break;                                                                            \
-            case 0x1:                                                                             \
-                dest_dat = 0;                                                                     \
-                break;                                                                            \
-            case 0x2:                                                                             \
-                dest_dat = ~0;                                                                    \
-                break;                                                                            \
-            case 0x3:                                                                             \
-                dest_dat = dest_dat;                                                              \
-                break;                                                                            \
-            case 0x4:                                                                             \
-                dest_dat = ~src_dat;                                                              \
-                break;                                                                            \
-            case 0x5:                                                                             \
-                dest_dat = src_dat ^ dest_dat;                                                    \
-                break;                                                                            \
-            case 0x6:                                                                             \
-                dest_dat = ~(src_dat ^ dest_dat);                                                 \
-                break;                                                                            \
-            case 0x7:                                                                             \
-                dest_dat = src_dat;                                                               \
-                break;                                                                            \
-            case 0x8:                                                                             \
-                dest_dat = ~(src_dat & dest_dat);                                                 \
-                break;                                                                            \
-            case 0x9:                                                                             \
-                dest_dat = ~src_dat | dest_dat;                                                   \
-                break;                                                                            \
-            case 0xa:                                                                             \
-                dest_dat = src_dat | ~dest_dat;                                                   \
-                break;                                                                            \
-            case 0xb:                                                                             \
-                dest_dat = src_dat | dest_dat;                                                    \
-                break;                                                                            \
-            case 0xc:                                                                             \
-                dest_dat = src_dat & dest_dat;                                                    \
-                break;                                                                            \
-            case 0xd:                                                                             \
-                dest_dat = src_dat & ~dest_dat;                                                   \
-                break;                                                                            \
-            case 0xe:                                                                             \
-                dest_dat = ~src_dat & dest_dat;                                                   \
-                break;                                                                            \
-            case 0xf:                                                                             \
-                dest_dat = ~(src_dat | dest_dat);                                                 \
-                break;                                                                            \
-        }                                                                                         \
-    }
+/* The S3 mix opcodes are the logical half of the 8514/A table; frgd_rop
+   and bkgd_rop are latched from the mix registers at command start. */
+#define MIX_READ \
+    dest_dat = ibm8514_accel_mix((mix_dat & mix_mask) ? frgd_rop : bkgd_rop, dest_dat, src_dat);
 
 #define MIX                                                                                \
     {                                                                                      \
@@ -6732,19 +6688,19 @@ polygon_setup(s3_t *s3)
 #define WRITE(addr, dat)                                                                                                   \
     if ((s3->bpp == 0) && !s3->color_16bit) {                                                                                \
         svga->vram[dword_remap(svga, addr) & s3->vram_mask]                = dat;                                          \
-        svga->changedvram[(dword_remap(svga, addr) & s3->vram_mask) >> 12] = svga->monitor->mon_changeframecount;          \
+        svga_dirty_mark(svga, (dword_remap(svga, addr) & s3->vram_mask) >> 12);          \
     } else if ((s3->bpp == 1) || (s3->color_16bit && (svga->bpp < 24))) {                                                   \
         vram_w[dword_remap_w(svga, addr) & (s3->vram_mask >> 1)]                    = dat;                                 \
-        svga->changedvram[(dword_remap_w(svga, addr) & (s3->vram_mask >> 1)) >> 11] = svga->monitor->mon_changeframecount; \
+        svga_dirty_mark(svga, (dword_remap_w(svga, addr) & (s3->vram_mask >> 1)) >> 11); \
     } else if (s3->bpp == 2) {                                                  \
         svga->vram[dword_remap(svga, addr) & s3->vram_mask]                = dat;                                          \
-        svga->changedvram[(dword_remap(svga, addr) & s3->vram_mask) >> 12] = svga->monitor->mon_changeframecount;          \
+        svga_dirty_mark(svga, (dword_remap(svga, addr) & s3->vram_mask) >> 12);          \
     } else if (s3->color_16bit && (svga->bpp == 24)) { \
         vram_w[dword_remap_w(svga, addr) & (s3->vram_mask >> 1)]           = dat;                                 \
-        svga->changedvram[(dword_remap_w(svga, addr) & (s3->vram_mask >> 1)) >> 11] = svga->monitor->mon_changeframecount; \
+        svga_dirty_mark(svga, (dword_remap_w(svga, addr) & (s3->vram_mask >> 1)) >> 11); \
     } else {                                                                                                               \
         vram_l[dword_remap_l(svga, addr) & (s3->vram_mask >> 2)]                    = dat;                                 \
-        svga->changedvram[(dword_remap_l(svga, addr) & (s3->vram_mask >> 2)) >> 10] = svga->monitor->mon_changeframecount; \
+        svga_dirty_mark(svga, (dword_remap_l(svga, addr) & (s3->vram_mask >> 2)) >> 10); \
     }
 
 static __inline void
@@ -7150,6 +7106,8 @@ s3_911_accel_start(int count, int cpu_input, uint32_t mix_dat, uint32_t cpu_dat,
     uint32_t  wrt_mask     = s3->accel.wrt_mask;
     uint32_t  frgd_color   = s3->accel.frgd_color;
     uint32_t  bkgd_color   = s3->accel.bkgd_color;
+    const uint8_t frgd_rop = s3->accel.frgd_mix & 0xf;
+    const uint8_t bkgd_rop = s3->accel.bkgd_mix & 0xf;
     int       cmd          = s3->accel.cmd >> 13;
 
     if ((s3->accel.cmd & 0x100) && (s3_cpu_src(s3) || (s3_cpu_dest(s3))) && (!cpu_input || (s3_enable_fifo(s3) == 0)))
@@ -7906,6 +7864,8 @@ s3_accel_start(int count, int cpu_input, uint32_t mix_dat, uint32_t cpu_dat, voi
     uint32_t *vram_l       = (uint32_t *) svga->vram;
     uint32_t  compare      = s3->accel.color_cmp;
     uint8_t   rop          = s3->accel.ropmix & 0xff;
+    const uint8_t frgd_rop = s3->accel.frgd_mix & 0xf;
+    const uint8_t bkgd_rop = s3->accel.bkgd_mix & 0xf;
     int       compare_mode = (s3->accel.multifunc[0xe] >> 7) & 3;
     uint32_t  rd_mask      = s3->accel.rd_mask;
     uint32_t  wrt_mask     = s3->accel.wrt_mask;
@@ -9309,8 +9269,10 @@ fifo_thread(void *param)
         thread_wait_event(s3->wake_fifo_thread, -1);
         thread_reset_event(s3->wake_fifo_thread);
         s3->blitter_busy = 1;
+        /*Time the whole drained batch in one go - two timer reads per entry
+          dominate the cost of small register writes.*/
+        start_time = plat_timer_read();
         while (!FIFO_EMPTY) {
-            start_time         = plat_timer_read();
             fifo_entry_t *fifo = &s3->fifo[s3->fifo_read_idx & FIFO_MASK];
 
             switch (fifo->addr_type & FIFO_TYPE) {
@@ -9342,10 +9304,9 @@ fifo_thread(void *param)
 
             if (FIFO_ENTRIES > 0xe000)
                 thread_set_event(s3->fifo_not_full_event);
-
-            end_time = plat_timer_read();
-            s3->blitter_time += (end_time - start_time);
         }
+        end_time = plat_timer_read();
+        s3->blitter_time += (end_time - start_time);
         s3->blitter_busy = 0;
         s3->subsys_stat |= INT_FIFO_EMP;
         s3_update_irqs(s3);
@@ -2108,15 +2108,15 @@ s3_virge_mmio_write_l(uint32_t addr, uint32_t val, void *priv)
         switch (bpp) {                                                                                                               \
             case 0: /*8 bpp*/                                                                                                        \
                 vram[addr & virge->vram_mask]                      = val;                                                            \
-                svga->changedvram[(addr & virge->vram_mask) >> 12] = changeframecount;                                               \
+                svga_dirty_mark(svga, (addr & virge->vram_mask) >> 12);                                               \
                 break;                                                                                                               \
             case 1: /*16 bpp*/                                                                                                       \
                 *(uint16_t *) &vram[addr & virge->vram_mask]       = val;                                                            \
-                svga->changedvram[(addr & virge->vram_mask) >> 12] = changeframecount;                                               \
+                svga_dirty_mark(svga, (addr & virge->vram_mask) >> 12);                                               \
                 break;                                                                                                               \
             case 2: /*24 bpp*/                                                                                                       \
                 *(uint32_t *) &vram[addr & virge->vram_mask]       = (val & 0xffffff) | (vram[(addr + 3) & virge->vram_mask] << 24); \
-                svga->changedvram[(addr & virge->vram_mask) >> 12] = changeframecount;                                               \
+                svga_dirty_mark(svga, (addr & virge->vram_mask) >> 12);                                               \
                 break;                                                                                                               \
         }                                                                                                                            \
     }
@@ -3279,7 +3279,7 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
                 }
             }
 
-            svga->changedvram[(dest_offset & virge->vram_mask) >> 12] = changeframecount;
+            svga_dirty_mark(svga, (dest_offset & virge->vram_mask) >> 12);
 
             dest_addr = dest_offset + (x * (bpp + 1));
             z_addr    = z_offset + (x << 1);
@@ -3385,14 +3385,14 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
                         case 1: /*16 bpp*/
                             RGB15(state->dest_rgba.r, state->dest_rgba.g, state->dest_rgba.b, dest_col);
                             *(uint16_t *) &vram[dest_addr & virge->vram_mask]       = dest_col;
-                            svga->changedvram[(dest_addr & virge->vram_mask) >> 12] = changeframecount;
+                            svga_dirty_mark(svga, (dest_addr & virge->vram_mask) >> 12);
                             break;
                         case 2: /*24 bpp*/
                             dest_col                                                = RGB24(state->dest_rgba.r, state->dest_rgba.g, state->dest_rgba.b);
                             *(uint8_t *) &vram[dest_addr & virge->vram_mask]        = dest_col & 0xff;
                             *(uint8_t *) &vram[(dest_addr + 1) & virge->vram_mask]  = (dest_col >> 8) & 0xff;
                             *(uint8_t *) &vram[(dest_addr + 2) & virge->vram_mask]  = (dest_col >> 16) & 0xff;
-                            svga->changedvram[(dest_addr & virge->vram_mask) >> 12] = changeframecount;
+                            svga_dirty_mark(svga, (dest_addr & virge->vram_mask) >> 12);
                             break;
 
                         default:
@@ -3402,7 +3402,7 @@ tri(virge_t *virge, s3d_t *s3d_tri, s3d_state_t *state, int yc, int32_t dx1, int
 
                 if (use_z && (s3d_tri->cmd_set & CMD_SET_ZUP)) {
                     *(uint16_t *) &vram[z_addr & virge->vram_mask]       = src_z;
-                    svga->changedvram[(z_addr & virge->vram_mask) >> 12] = changeframecount;
+                    svga_dirty_mark(svga, (z_addr & virge->vram_mask) >> 12);
                 }
 
                 z += s3d_tri->TdZdX;
@@ -56,6 +56,11 @@ typedef struct sdac_ramdac_t {
 static void
 sdac_control_write(sdac_ramdac_t *ramdac, svga_t *svga, uint8_t val)
 {
+    /* Rewriting the same command value changes no derived state; skip the
+       bpp rederivation and the timing recalculation. */
+    if (ramdac->command == val)
+        return;
+
     ramdac->command = val;
 
     switch (ramdac->type & ICS_S3_MASK) {
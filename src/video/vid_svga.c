@@ -130,7 +130,6 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
             dev->dac_addr   = (val + (addr & 0x01)) & 0xff;
             break;
         case 0x2ed:
-            svga->fullchange = svga->monitor->mon_changeframecount;
             switch (dev->dac_pos) {
                 case 0:
                     dev->dac_r = val;
@@ -141,15 +140,21 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                     dev->dac_pos++;
                     break;
                 case 2:
-                    index                 = dev->dac_addr & 0xff;
+                    index      = dev->dac_addr & 0xff;
                     dev->dac_b = val;
-                    svga->vgapal[index].r = dev->dac_r;
-                    svga->vgapal[index].g = dev->dac_g;
-                    svga->vgapal[index].b = dev->dac_b;
-                    if (svga->ramdac_type == RAMDAC_8BIT)
-                        dev->pallook[index] = makecol32(svga->vgapal[index].r, svga->vgapal[index].g, svga->vgapal[index].b);
-                    else
-                        dev->pallook[index] = makecol32(video_6to8[svga->vgapal[index].r & 0x3f], video_6to8[svga->vgapal[index].g & 0x3f], video_6to8[svga->vgapal[index].b & 0x3f]);
+                    /* Only a completed write that actually changes the entry
+                       regenerates the lookup and forces a full redraw; palette
+                       animation re-uploading unchanged entries stays cheap. */
+                    if ((svga->vgapal[index].r != dev->dac_r) || (svga->vgapal[index].g != dev->dac_g) || (svga->vgapal[index].b != dev->dac_b)) {
+                        svga->fullchange      = svga->monitor->mon_changeframecount;
+                        svga->vgapal[index].r = dev->dac_r;
+                        svga->vgapal[index].g = dev->dac_g;
+                        svga->vgapal[index].b = dev->dac_b;
+                        if (svga->ramdac_type == RAMDAC_8BIT)
+                            dev->pallook[index] = makecol32(svga->vgapal[index].r, svga->vgapal[index].g, svga->vgapal[index].b);
+                        else
+                            dev->pallook[index] = makecol32(video_6to8[svga->vgapal[index].r & 0x3f], video_6to8[svga->vgapal[index].g & 0x3f], video_6to8[svga->vgapal[index].b & 0x3f]);
+                    }
                     dev->dac_pos  = 0;
                     dev->dac_addr = (dev->dac_addr + 1) & 0xff;
                     break;
@@ -255,6 +260,8 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                     svga->chain2_write = !(val & 4);
                     svga->chain4       = (svga->chain4 & ~8) | (val & 8);
                     svga->fast         = (svga->gdcreg[8] == 0xff && !(svga->gdcreg[3] & 0x18) && !svga->gdcreg[1]) && ((svga->chain4 && (svga->packed_chain4 || svga->force_old_addr)) || svga->fb_only) && !(svga->adv_flags & FLAG_ADDR_BY8);
+                    if (!svga->fast)
+                        mem_wc_flush();
                     break;
 
                 default:
@@ -273,7 +280,6 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
         case 0x3c9:
             if (svga->adv_flags & FLAG_RAMDAC_SHIFT)
                 val <<= 2;
-            svga->fullchange = svga->monitor->mon_changeframecount;
             switch (svga->dac_pos) {
                 case 0:
                     svga->dac_r = val;
@@ -284,15 +290,21 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
                     svga->dac_pos++;
                     break;
                 case 2:
-                    index                 = svga->dac_addr & 255;
-                    svga->dac_b           = val;
-                    svga->vgapal[index].r = svga->dac_r;
-                    svga->vgapal[index].g = svga->dac_g;
-                    svga->vgapal[index].b = svga->dac_b;
-                    if (svga->ramdac_type == RAMDAC_8BIT)
-                        svga->pallook[index] = makecol32(svga->vgapal[index].r, svga->vgapal[index].g, svga->vgapal[index].b);
-                    else
-                        svga->pallook[index] = makecol32(video_6to8[svga->vgapal[index].r & 0x3f], video_6to8[svga->vgapal[index].g & 0x3f], video_6to8[svga->vgapal[index].b & 0x3f]);
+                    index       = svga->dac_addr & 255;
+                    svga->dac_b = val;
+                    /* Only a completed write that actually changes the entry
+                       regenerates the lookup and forces a full redraw; palette
+                       animation re-uploading unchanged entries stays cheap. */
+                    if ((svga->vgapal[index].r != svga->dac_r) || (svga->vgapal[index].g != svga->dac_g) || (svga->vgapal[index].b != svga->dac_b)) {
+                        svga->fullchange      = svga->monitor->mon_changeframecount;
+                        svga->vgapal[index].r = svga->dac_r;
+                        svga->vgapal[index].g = svga->dac_g;
+                        svga->vgapal[index].b = svga->dac_b;
+                        if (svga->ramdac_type == RAMDAC_8BIT)
+                            svga->pallook[index] = makecol32(svga->vgapal[index].r, svga->vgapal[index].g, svga->vgapal[index].b);
+                        else
+                            svga->pallook[index] = makecol32(video_6to8[svga->vgapal[index].r & 0x3f], video_6to8[svga->vgapal[index].g & 0x3f], video_6to8[svga->vgapal[index].b & 0x3f]);
+                    }
                     svga->dac_pos  = 0;
                     svga->dac_addr = (svga->dac_addr + 1) & 255;
                     break;
@@ -352,6 +364,8 @@ svga_out(uint16_t addr, uint8_t val, void *priv)
             }
             svga->gdcreg[svga->gdcaddr & 15] = val;
             svga->fast                       = (svga->gdcreg[8] == 0xff && !(svga->gdcreg[3] & 0x18) && !svga->gdcreg[1]) && ((svga->chain4 && (svga->packed_chain4 || svga->force_old_addr)) || svga->fb_only);
+            if (!svga->fast)
+                mem_wc_flush();
             if (((svga->gdcaddr & 15) == 5 && (val ^ o) & 0x70) || ((svga->gdcaddr & 15) == 6 && (val ^ o) & 1))
                 svga_recalctimings(svga);
             break;
@@ -572,6 +586,15 @@ svga_recalctimings(svga_t *svga)
     double           _dispontime;
     double           _dispofftime;
     double           disptime;
+    void (*old_render)(struct svga_t *svga) = svga->render;
+    int              old_hdisp              = svga->hdisp;
+    int              old_dispend            = svga->dispend;
+    int              old_split              = svga->split;
+    int              old_rowoffset          = svga->rowoffset;
+    int              old_char_width         = svga->char_width;
+    uint32_t         old_ma_latch           = svga->ma_latch;
+    uint8_t          old_rowcount           = svga->rowcount;
+    uint8_t          old_linedbl            = svga->linedbl;
 #ifdef ENABLE_SVGA_LOG
     int              vsyncend;
     int              vblankend;
@@ -852,6 +875,25 @@ svga_recalctimings(svga_t *svga)
     if (!svga->force_old_addr)
         svga_recalc_remap_func(svga);
 
+    if (svga->render != old_render)
+        svga->render_version++;
+
+    /* Mode-set storms recalculate hundreds of times in a row while
+       republishing identical outputs; only invalidate when the renderer or
+       the geometry the caches were built under actually changed. */
+    if ((svga->render != old_render) || (svga->hdisp != old_hdisp) ||
+        (svga->dispend != old_dispend) || (svga->split != old_split) ||
+        (svga->rowoffset != old_rowoffset) || (svga->char_width != old_char_width) ||
+        (svga->ma_latch != old_ma_latch) || (svga->rowcount != old_rowcount) ||
+        (svga->linedbl != old_linedbl)) {
+        /* The text row hashes no longer describe what is in the buffer. */
+        memset(svga->text_line_hash, 0, sizeof(svga->text_line_hash));
+
+        /* The masks a write-combining lookup was installed under may have
+           changed - drop them and let the write path re-install. */
+        mem_wc_flush();
+    }
+
     /* Inform the user interface of any DPMS mode changes. */
     if (svga->dpms) {
         if (!svga->dpms_ui) {
@@ -867,14 +909,31 @@ svga_recalctimings(svga_t *svga)
 static void
 svga_do_render(svga_t *svga)
 {
+    int overdrawn = 0;
+    int force     = 0;
+    int line      = svga->displine + svga->y_add;
+
     /* Always render a blank screen and nothing else while in DPMS mode. */
     if (svga->dpms) {
         svga_render_blank(svga);
         return;
     }
 
+    /* A line the cursor or an overlay drew over last frame still holds that
+       overdraw; re-render it from VRAM even if its pages did not change so
+       the old cursor image is erased. */
+    if ((line >= 0) && (line < 2048) && svga->line_overdrawn[line]) {
+        svga->line_overdrawn[line] = 0;
+        if (!svga->fullchange)
+            force = 1;
+    }
+
     if (!svga->override) {
+        if (force)
+            svga->fullchange = 1;
         svga->render(svga);
+        if (force)
+            svga->fullchange = 0;
 
         svga->x_add = (svga->monitor->mon_overscan_x >> 1);
         svga_render_overscan_left(svga);
@@ -883,28 +942,163 @@ svga_do_render(svga_t *svga)
     }
 
     if (svga->overlay_on) {
-        if (!svga->override && svga->overlay_draw)
+        if (!svga->override && svga->overlay_draw) {
             svga->overlay_draw(svga, svga->displine + svga->y_add);
+            overdrawn = 1;
+        }
         svga->overlay_on--;
         if (svga->overlay_on && svga->interlace)
             svga->overlay_on--;
     }
 
     if (svga->dac_hwcursor_on) {
-        if (!svga->override && svga->dac_hwcursor_draw)
+        if (!svga->override && svga->dac_hwcursor_draw) {
             svga->dac_hwcursor_draw(svga, svga->displine + svga->y_add);
+            overdrawn = 1;
+        }
         svga->dac_hwcursor_on--;
         if (svga->dac_hwcursor_on && svga->interlace)
             svga->dac_hwcursor_on--;
     }
 
     if (svga->hwcursor_on) {
-        if (!svga->override && svga->hwcursor_draw)
+        if (!svga->override && svga->hwcursor_draw) {
             svga->hwcursor_draw(svga, svga->displine + svga->y_add);
+            overdrawn = 1;
+        }
         svga->hwcursor_on--;
         if (svga->hwcursor_on && svga->interlace)
             svga->hwcursor_on--;
     }
+
+    /* Overdrawn and force-erased lines change the buffer even when the
+       renderer's own change test skipped them; make sure the frame's draw
+       extent and dirty rectangle cover them. The overdraw can land anywhere
+       on the line, so dirty the full width. */
+    if (overdrawn || force) {
+        if (svga->firstline_draw == 2000)
+            svga->firstline_draw = svga->displine;
+        svga->lastline_draw = svga->displine;
+
+        if (svga->dirty_x0 > 0)
+            svga->dirty_x0 = 0;
+        if (svga->dirty_x1 < 2047)
+            svga->dirty_x1 = 2047;
+    }
+
+    /* Overlays and hardware cursors draw on top of the rendered line; its
+       text row hash no longer matches the buffer contents, and the line
+       must be re-rendered next frame to erase them. */
+    if (overdrawn && (line >= 0) && (line < 2048)) {
+        svga->text_line_hash[line] = 0;
+        svga->line_overdrawn[line] = 1;
+    }
+}
+
+/* Accumulate this scanline's horizontal dirty extent before it is rendered.
+   The vertical extent comes from firstline_draw/lastline_draw, which the
+   renderers only advance on scanlines they actually redraw; horizontally the
+   4k change pages are the finest grid the write paths maintain, and only the
+   packed direct colour modes can map those back onto pixel spans - everything
+   else dirties the full width. */
+static void
+svga_dirty_update_x(svga_t *svga)
+{
+    int      npix    = svga->hdisp + svga->scrollcache;
+    int      base_x  = (svga->monitor->mon_overscan_x >> 1) - svga->scrollcache;
+    int      bytespp = 0;
+    int      x0      = 0;
+    int      x1      = 2047;
+    uint32_t start;
+    uint32_t len;
+    uint32_t first_page;
+    uint32_t last_page;
+    uint32_t first;
+    uint32_t last;
+
+    start = svga->ma & svga->vram_display_mask;
+
+    /* Mirror the renderers' change test - scanlines they skip leave the
+       buffer untouched. */
+    if (!svga->fullchange && !svga->changedvram[start >> 12] && !svga->changedvram[(start >> 12) + 1])
+        return;
+
+    switch (svga->bpp) {
+        case 15:
+        case 16:
+            bytespp = 2;
+            break;
+        case 32:
+            bytespp = 4;
+            break;
+        default:
+            break;
+    }
+
+    /* Cursor and overlay overdraw is accounted for separately in
+       svga_do_render(). */
+    if (bytespp && !svga->fullchange && !svga->remap_required) {
+        len        = (uint32_t) npix * bytespp;
+        first_page = start >> 12;
+        last_page  = (start + len - 1) >> 12;
+
+        if ((start + len) <= (svga->vram_display_mask + 1)) {
+            first = last_page + 1;
+            last  = first_page;
+            for (uint32_t page = first_page; page <= last_page; page++) {
+                if (svga->changedvram[page]) {
+                    if (first > page)
+                        first = page;
+                    last = page;
+                }
+            }
+
+            if (first > last_page)
+                return;
+
+            x0 = (first == first_page) ? 0 : (int) (((first << 12) - start) / bytespp);
+            x1 = (last == last_page) ? (npix - 1) : ((int) ((((last + 1) << 12) - start) / bytespp) - 1);
+
+            x0 += base_x;
+            x1 += base_x;
+            if (x0 < 0)
+                x0 = 0;
+        }
+    }
+
+    if (x0 < svga->dirty_x0)
+        svga->dirty_x0 = x0;
+    if (x1 > svga->dirty_x1)
+        svga->dirty_x1 = x1;
+}
+
+/* While a linear framebuffer page has plain RAM write semantics (fast write
+   path, no address translation, page fully inside VRAM), install a
+   write-combining lookup so subsequent CPU stores to the page skip the
+   handler dispatch entirely. svga_wc_mark_page() stands in for the skipped
+   per-write changedvram updates once per frame, and the lookups are dropped
+   whenever the fast flag is recomputed, the timings are recalculated or any
+   memory mapping changes. */
+static void
+svga_wc_install(svga_t *svga, uint32_t phys, uint32_t addr)
+{
+    if (!is286 || svga->translate_address)
+        return;
+    if ((addr | 0xfff) >= svga->vram_max)
+        return;
+    if (((svga->decode_mask & 0xfff) != 0xfff) || ((svga->vram_mask & 0xfff) != 0xfff))
+        return;
+    addwritelookup_wc(mem_logical_addr, phys, &svga->vram[(addr & svga->vram_mask) & ~0xfff], svga);
+}
+
+static void
+svga_wc_mark_page(uint32_t phys_page, void *tag)
+{
+    svga_t  *svga = (svga_t *) tag;
+    uint32_t addr = (phys_page << 12) & svga->decode_mask;
+
+    if (addr < svga->vram_max)
+        svga_dirty_mark(svga, (addr & svga->vram_mask) >> 12);
 }
 
 void
@@ -972,36 +1166,44 @@ svga_poll(void *priv)
             svga->hdisp_on = 1;
 
             svga->ma &= svga->vram_display_mask;
-            if (svga->firstline == 2000) {
-                svga->firstline = svga->displine;
-                video_wait_for_buffer_monitor(svga->monitor_index);
-            }
 
-            if (svga->hwcursor_on || svga->dac_hwcursor_on || svga->overlay_on) {
-                svga->changedvram[svga->ma >> 12] = svga->changedvram[(svga->ma >> 12) + 1] = svga->interlace ? 3 : 2;
-            }
+            /* A paced-out frame keeps all CRTC timing and addressing but
+               skips the pixel work; changed VRAM pages are not aged either,
+               so the next rendered frame still picks them up. */
+            if (!svga->frame_skip_active) {
+                if (svga->firstline == 2000) {
+                    svga->firstline = svga->displine;
+                    video_wait_for_buffer_monitor(svga->monitor_index);
+                }
 
-            if (svga->vertical_linedbl) {
-                old_ma = svga->ma;
+                /* Cursor and overlay overdraw no longer ages the changed
+                   VRAM pages; svga_do_render() re-renders exactly the
+                   overdrawn lines and accounts for them in the dirty
+                   rectangle. */
+                svga_dirty_update_x(svga);
 
-                svga->displine <<= 1;
-                svga->y_add <<= 1;
+                if (svga->vertical_linedbl) {
+                    old_ma = svga->ma;
 
-                svga_do_render(svga);
+                    svga->displine <<= 1;
+                    svga->y_add <<= 1;
 
-                svga->displine++;
+                    svga_do_render(svga);
 
-                svga->ma = old_ma;
+                    svga->displine++;
 
-                svga_do_render(svga);
+                    svga->ma = old_ma;
 
-                svga->y_add >>= 1;
-                svga->displine >>= 1;
-            } else
-                svga_do_render(svga);
+                    svga_do_render(svga);
 
-            if (svga->lastline < svga->displine)
-                svga->lastline = svga->displine;
+                    svga->y_add >>= 1;
+                    svga->displine >>= 1;
+                } else
+                    svga_do_render(svga);
+
+                if (svga->lastline < svga->displine)
+                    svga->lastline = svga->displine;
+            }
         }
 
         svga->displine++;
@@ -1093,12 +1295,49 @@ svga_poll(void *priv)
 
             svga->blink = (svga->blink + 1) & 0x7f;
 
-            for (x = 0; x < ((svga->vram_mask + 1) >> 12); x++) {
-                if (svga->changedvram[x])
-                    svga->changedvram[x]--;
+            if (!svga->frame_skip_active) {
+                /* Pages the CPU writes through write-combining lookups get no
+                   per-write changedvram updates - mark them once per frame. */
+                mem_wc_sweep(svga, svga_wc_mark_page);
+
+                /* The blitter threads mark pages concurrently with the CPU
+                   and can lose a summary bit to the racing read-modify-
+                   write; rebuild one region's word per frame so a stranded
+                   page is still aged out, just later. */
+                if (svga->changedvram_words > 0) {
+                    uint64_t w = 0ULL;
+
+                    x = svga->changedvram_scrub;
+                    for (uint32_t b = 0; b < 64; b++) {
+                        if (svga->changedvram[(x << 6) + b])
+                            w |= 1ULL << b;
+                    }
+                    svga->changedvram_sum[x] |= w;
+                    svga->changedvram_scrub = (x + 1) % svga->changedvram_words;
+                }
+
+                /* Age only regions whose summary word holds dirty pages - a
+                   static screen costs one word load per 256K of VRAM
+                   instead of a byte test per 4K page. */
+                for (x = 0; x < svga->changedvram_words; x++) {
+                    uint64_t w = svga->changedvram_sum[x];
+
+                    if (w == 0ULL)
+                        continue;
+                    for (uint32_t b = 0; w != 0ULL; b++, w >>= 1) {
+                        if (w & 1ULL) {
+                            uint32_t page = (x << 6) + b;
+
+                            if (svga->changedvram[page])
+                                svga->changedvram[page]--;
+                            if (!svga->changedvram[page])
+                                svga->changedvram_sum[x] &= ~(1ULL << b);
+                        }
+                    }
+                }
+                if (svga->fullchange)
+                    svga->fullchange--;
             }
-            if (svga->fullchange)
-                svga->fullchange--;
         }
         if (svga->vc == svga->vsyncstart) {
             svga->dispon = 0;
@@ -1112,7 +1351,7 @@ svga_poll(void *priv)
 
             wx = x;
 
-            if (!svga->override) {
+            if (!svga->override && !svga->frame_skip_active) {
                 if (svga->vertical_linedbl) {
                     wy = (svga->lastline - svga->firstline) << 1;
                     svga_doblit(wx, wy, svga);
@@ -1156,6 +1395,11 @@ svga_poll(void *priv)
             svga->dispon   = 1;
             svga->displine = (svga->interlace && svga->oddeven) ? 1 : 0;
 
+            /* Decide up front whether the host display can show this frame
+               at all. Skipping interlaced fields would tear the frame pair
+               apart, so pacing stays off for interlaced modes. */
+            svga->frame_skip_active = (svga->override || svga->interlace) ? 0 : video_frame_pace_monitor(svga->monitor_index);
+
             svga->scrollcache = (svga->attrregs[0x13] & 0x0f);
             if (!(svga->gdcreg[6] & 1) && !(svga->attrregs[0x10] & 1)) { /*Text mode*/
                 if (svga->seqregs[1] & 1)
@@ -1237,13 +1481,19 @@ svga_init(const device_t *info, svga_t *svga, void *priv, int memsize,
     svga->vram_max          = memsize;
     svga->vram_display_mask = svga->vram_mask = memsize - 1;
     svga->decode_mask                         = 0x7fffff;
-    svga->changedvram                         = calloc(memsize >> 12, 1);
+    /* Page counters are rounded up to a whole number of summary words so
+       the per-word sweeps never read past the allocation. */
+    svga->changedvram_words                   = ((memsize >> 12) + 63) >> 6;
+    svga->changedvram                         = calloc(svga->changedvram_words << 6, 1);
+    svga->changedvram_sum                     = calloc(svga->changedvram_words, sizeof(uint64_t));
     svga->recalctimings_ex                    = recalctimings_ex;
     svga->video_in                            = video_in;
     svga->video_out                           = video_out;
     svga->hwcursor_draw                       = hwcursor_draw;
     svga->overlay_draw                        = overlay_draw;
     svga->conv_16to32                         = svga_conv_16to32;
+    svga->dirty_x0                            = 2048;
+    svga->dirty_x1                            = -1;
 
     svga->hwcursor.cur_xsize = svga->hwcursor.cur_ysize = 32;
 
@@ -1286,6 +1536,13 @@ svga_init(const device_t *info, svga_t *svga, void *priv, int memsize,
 void
 svga_close(svga_t *svga)
 {
+    /* Queued scanline jobs hold pointers into the monitor buffer. */
+    svga_render_thread_drain();
+
+    /* Write-combining lookups hold pointers into the VRAM being freed. */
+    mem_wc_flush();
+
+    free(svga->changedvram_sum);
     free(svga->changedvram);
     free(svga->vram);
 
@@ -1428,7 +1685,7 @@ svga_write_common(uint32_t addr, uint8_t val, uint8_t linear, void *priv)
 
     addr &= svga->vram_mask;
 
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     count = 4;
     if (svga->adv_flags & FLAG_LATCH8)
@@ -1793,6 +2050,24 @@ svga_doblit(int wx, int wy, svga_t *svga)
         }
     }
 
+    /* Make sure the render worker has finished all queued scanlines before
+       the blit thread starts reading the buffer. */
+    svga_render_thread_drain();
+
+    /* Report this frame's dirty rectangle so renderers can limit their
+       copies to it. Wait out the previous blit first so the renderer is
+       not reading the rectangle while we update it. */
+    video_wait_for_blit_monitor(svga->monitor_index);
+    if ((svga->firstline_draw != 2000) && (svga->dirty_x1 >= svga->dirty_x0))
+        video_blit_set_dirty_rect_monitor(svga->dirty_x0, svga->firstline_draw + svga->y_add,
+                                          svga->dirty_x1 - svga->dirty_x0 + 1,
+                                          svga->lastline_draw - svga->firstline_draw + 1,
+                                          svga->monitor_index);
+    else
+        video_blit_set_dirty_rect_monitor(0, 0, 0, 0, svga->monitor_index);
+    svga->dirty_x0 = 2048;
+    svga->dirty_x1 = -1;
+
     video_blit_memtoscreen_monitor(x_start, y_start, svga->monitor->mon_xsize + x_add, svga->monitor->mon_ysize + y_add, svga->monitor_index);
 
     if (svga->vertical_linedbl)
@@ -1802,7 +2077,8 @@ svga_doblit(int wx, int wy, svga_t *svga)
 void
 svga_writeb_linear(uint32_t addr, uint8_t val, void *priv)
 {
-    svga_t *svga = (svga_t *) priv;
+    svga_t  *svga = (svga_t *) priv;
+    uint32_t phys = addr;
 
     if (!svga->fast) {
         svga_write_linear(addr, val, priv);
@@ -1812,15 +2088,17 @@ svga_writeb_linear(uint32_t addr, uint8_t val, void *priv)
     addr &= svga->decode_mask;
     if (addr >= svga->vram_max)
         return;
+    svga_wc_install(svga, phys, addr);
     addr &= svga->vram_mask;
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     svga->vram[addr]              = val;
 }
 
 void
 svga_writew_common(uint32_t addr, uint16_t val, uint8_t linear, void *priv)
 {
-    svga_t *svga = (svga_t *) priv;
+    svga_t  *svga = (svga_t *) priv;
+    uint32_t phys = addr;
 
     if (!svga->fast) {
         svga_write_common(addr, val, linear, priv);
@@ -1842,20 +2120,22 @@ svga_writew_common(uint32_t addr, uint16_t val, uint8_t linear, void *priv)
         uint32_t addr2 = svga->translate_address(addr, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = val & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         addr2 = svga->translate_address(addr + 1, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = (val >> 8) & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         return;
     }
     if (addr >= svga->vram_max)
         return;
+    if (linear)
+        svga_wc_install(svga, phys, addr);
     addr &= svga->vram_mask;
 
-    svga->changedvram[addr >> 12]   = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint16_t *) &svga->vram[addr] = val;
 }
 
@@ -1874,7 +2154,8 @@ svga_writew_linear(uint32_t addr, uint16_t val, void *priv)
 void
 svga_writel_common(uint32_t addr, uint32_t val, uint8_t linear, void *priv)
 {
-    svga_t *svga = (svga_t *) priv;
+    svga_t  *svga = (svga_t *) priv;
+    uint32_t phys = addr;
 
     if (!svga->fast) {
         svga_write_common(addr, val, linear, priv);
@@ -1898,30 +2179,32 @@ svga_writel_common(uint32_t addr, uint32_t val, uint8_t linear, void *priv)
         uint32_t addr2 = svga->translate_address(addr, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = val & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         addr2 = svga->translate_address(addr + 1, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = (val >> 8) & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         addr2 = svga->translate_address(addr + 2, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = (val >> 16) & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         addr2 = svga->translate_address(addr + 3, priv);
         if (addr2 < svga->vram_max) {
             svga->vram[addr2 & svga->vram_mask] = (val >> 24) & 0xff;
-            svga->changedvram[addr2 >> 12]      = svga->monitor->mon_changeframecount;
+            svga_dirty_mark(svga, addr2 >> 12);
         }
         return;
     }
     if (addr >= svga->vram_max)
         return;
+    if (linear)
+        svga_wc_install(svga, phys, addr);
     addr &= svga->vram_mask;
 
-    svga->changedvram[addr >> 12]   = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint32_t *) &svga->vram[addr] = val;
 }
 
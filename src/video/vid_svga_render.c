@@ -19,12 +19,15 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <wchar.h>
 #include <86box/86box.h>
 #include <86box/device.h>
 #include <86box/mem.h>
 #include <86box/timer.h>
+#include <86box/thread.h>
+#include <86box/plat_unused.h>
 #include <86box/video.h>
 #include <86box/vid_svga.h>
 #include <86box/vid_svga_render.h>
@@ -44,6 +47,300 @@ svga_lookup_lut_ram(svga_t* svga, uint32_t val)
 
 #define lookup_lut(val) svga_lookup_lut_ram(svga, val)
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    define SVGA_RENDER_SSE2
+#    include <emmintrin.h>
+#endif
+
+/* Scanline format conversion kernels, shared by the render worker and the
+   synchronous fast path. The SSE2 variants expand the 5/6-bit components
+   arithmetically, eight pixels per iteration; the multiply-shift identities
+       floor(x * 255 / 31) == (x * 1053) >> 7
+       floor(x * 255 / 63) == (x << 2) + ((x * 3121) >> 16)
+   reproduce the video_15to32/video_16to32 tables bit for bit over the whole
+   component range. */
+#ifdef SVGA_RENDER_SSE2
+static __inline __m128i
+svga_conv_expand5(__m128i x)
+{
+    return _mm_srli_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(1053)), 7);
+}
+
+static __inline __m128i
+svga_conv_expand6(__m128i x)
+{
+    return _mm_add_epi16(_mm_slli_epi16(x, 2), _mm_mulhi_epu16(x, _mm_set1_epi16(3121)));
+}
+#endif
+
+static void
+svga_conv_line_15(uint32_t *dest, const uint8_t *src, int count)
+{
+    int c = 0;
+
+#ifdef SVGA_RENDER_SSE2
+    const __m128i m5 = _mm_set1_epi16(31);
+
+    for (; (c + 8) <= count; c += 8) {
+        __m128i v  = _mm_loadu_si128((const __m128i *) (src + (c << 1)));
+        __m128i b  = svga_conv_expand5(_mm_and_si128(v, m5));
+        __m128i g  = svga_conv_expand5(_mm_and_si128(_mm_srli_epi16(v, 5), m5));
+        __m128i r  = svga_conv_expand5(_mm_and_si128(_mm_srli_epi16(v, 10), m5));
+        __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+
+        _mm_storeu_si128((__m128i *) &dest[c], _mm_unpacklo_epi16(bg, r));
+        _mm_storeu_si128((__m128i *) &dest[c + 4], _mm_unpackhi_epi16(bg, r));
+    }
+#endif
+
+    for (; c < count; c++)
+        dest[c] = video_15to32[((const uint16_t *) src)[c]];
+}
+
+static void
+svga_conv_line_16(uint32_t *dest, const uint8_t *src, int count)
+{
+    int c = 0;
+
+#ifdef SVGA_RENDER_SSE2
+    const __m128i m5 = _mm_set1_epi16(31);
+    const __m128i m6 = _mm_set1_epi16(63);
+
+    for (; (c + 8) <= count; c += 8) {
+        __m128i v  = _mm_loadu_si128((const __m128i *) (src + (c << 1)));
+        __m128i b  = svga_conv_expand5(_mm_and_si128(v, m5));
+        __m128i g  = svga_conv_expand6(_mm_and_si128(_mm_srli_epi16(v, 5), m6));
+        __m128i r  = svga_conv_expand5(_mm_srli_epi16(v, 11));
+        __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+
+        _mm_storeu_si128((__m128i *) &dest[c], _mm_unpacklo_epi16(bg, r));
+        _mm_storeu_si128((__m128i *) &dest[c + 4], _mm_unpackhi_epi16(bg, r));
+    }
+#endif
+
+    for (; c < count; c++)
+        dest[c] = video_16to32[((const uint16_t *) src)[c]];
+}
+
+static void
+svga_conv_line_32(uint32_t *dest, const uint8_t *src, int count)
+{
+    int c = 0;
+
+#ifdef SVGA_RENDER_SSE2
+    const __m128i m24 = _mm_set1_epi32(0xffffff);
+
+    for (; (c + 4) <= count; c += 4)
+        _mm_storeu_si128((__m128i *) &dest[c], _mm_and_si128(_mm_loadu_si128((const __m128i *) (src + (c << 2))), m24));
+#endif
+
+    for (; c < count; c++)
+        dest[c] = ((const uint32_t *) src)[c] & 0xffffff;
+}
+
+static void
+svga_conv_line_8(uint32_t *dest, const uint8_t *src, int count, const uint32_t *pal)
+{
+    /* count is always a multiple of 4 here. */
+    for (int c = 0; c < count; c += 4) {
+        dest[c]     = pal[src[c]];
+        dest[c + 1] = pal[src[c + 1]];
+        dest[c + 2] = pal[src[c + 2]];
+        dest[c + 3] = pal[src[c + 3]];
+    }
+}
+
+/* Threaded scanline conversion (modeled on the Voodoo render threads): the
+   CPU thread copies the scanline's VRAM span into a job slot and a worker
+   thread performs the per-pixel format conversion into the monitor buffer.
+   Only the table-driven conversions use this - direct colour, and packed
+   8bpp with a snapshot of the palette - the copied span makes the job
+   self-contained, so emulation can keep writing VRAM while the worker
+   converts. svga_render_thread_drain() must run before anything
+   reads the monitor buffer (the blit in svga_poll() does this).
+
+   The queue is single-producer (renderers only run on the CPU thread, even
+   with two display devices) and single-consumer. */
+#define SVGA_RENDER_SPAN_MAX 2080 /* pixels per job */
+#define SVGA_RENDER_JOB_NR   16   /* must be a power of two */
+#define SVGA_RENDER_JOB_MASK (SVGA_RENDER_JOB_NR - 1)
+
+typedef struct svga_render_job_t {
+    uint32_t *dest;
+    int       count;
+    int       bpp;
+    uint8_t   src[SVGA_RENDER_SPAN_MAX * 4];
+    uint32_t  pal[256]; /* palette snapshot for 8bpp jobs - DAC writes may land before the worker runs */
+} svga_render_job_t;
+
+static svga_render_job_t *svga_render_jobs       = NULL;
+static volatile int       svga_render_write_idx  = 0;
+static volatile int       svga_render_read_idx   = 0;
+static volatile int       svga_render_thread_run = 0;
+static thread_t          *svga_render_thread_h   = NULL;
+static event_t           *svga_render_wake_event = NULL;
+static event_t           *svga_render_done_event = NULL;
+
+static void
+svga_render_thread(UNUSED(void *param))
+{
+    while (svga_render_thread_run) {
+        thread_wait_event(svga_render_wake_event, -1);
+        thread_reset_event(svga_render_wake_event);
+
+        while (svga_render_read_idx != svga_render_write_idx) {
+            const svga_render_job_t *job = &svga_render_jobs[svga_render_read_idx & SVGA_RENDER_JOB_MASK];
+
+            switch (job->bpp) {
+                case 8:
+                    svga_conv_line_8(job->dest, job->src, job->count, job->pal);
+                    break;
+
+                case 15:
+                    svga_conv_line_15(job->dest, job->src, job->count);
+                    break;
+
+                case 16:
+                    svga_conv_line_16(job->dest, job->src, job->count);
+                    break;
+
+                case 32:
+                    svga_conv_line_32(job->dest, job->src, job->count);
+                    break;
+
+                default:
+                    break;
+            }
+
+            svga_render_read_idx++;
+            thread_set_event(svga_render_done_event);
+        }
+    }
+}
+
+/* Wait for the worker to finish all queued scanlines. */
+void
+svga_render_thread_drain(void)
+{
+    if (!svga_render_thread_h)
+        return;
+
+    while (svga_render_read_idx != svga_render_write_idx) {
+        thread_set_event(svga_render_wake_event);
+        thread_wait_event(svga_render_done_event, 1);
+        thread_reset_event(svga_render_done_event);
+    }
+}
+
+/* If the scanline is a plain table conversion, run it through the vectorized
+   kernels - queued to the worker when threaded rendering is on, in place on
+   the CPU thread otherwise. Returns the pixel count the caller's loop would
+   have produced, or 0 to render inline. */
+static int
+svga_render_line_fast(svga_t *svga, uint32_t *p, int npix, int bpp)
+{
+    svga_render_job_t *job;
+    uint32_t           addr;
+    uint32_t           vram_size;
+    int                count;
+    int                len;
+
+    if (svga->remap_required)
+        return 0;
+
+    /* Cursor and overlay overdraw happens right after the render - those
+       scanlines have to be finished synchronously. */
+    if (svga->hwcursor_on || svga->dac_hwcursor_on || svga->overlay_on)
+        return 0;
+
+    /* Only the plain lookup table conversions run on the worker; RAMDAC
+       overrides and the LUT remap read live device state. */
+    if (((bpp == 15) || (bpp == 16)) && (svga->conv_16to32 != svga_conv_16to32))
+        return 0;
+    if ((bpp == 32) && svga->lut_map)
+        return 0;
+
+    /* 8bpp writes in groups of 4 pixels, 16-bit modes in groups of 8,
+       32bpp one per iteration. */
+    if (bpp == 8)
+        count = ((npix >> 2) + 1) << 2;
+    else if (bpp == 32)
+        count = npix + 1;
+    else
+        count = ((npix >> 3) + 1) << 3;
+    if ((count <= 0) || (count > SVGA_RENDER_SPAN_MAX))
+        return 0;
+
+    len       = count * ((bpp == 32) ? 4 : ((bpp == 8) ? 1 : 2));
+    vram_size = svga->vram_display_mask + 1;
+    addr      = svga->ma & svga->vram_display_mask;
+
+    if (!video_threaded_render) {
+        /* Synchronous path: convert straight out of VRAM. Spans that wrap
+           around the display mask stay with the per-pixel loops. */
+        if ((addr + len) > vram_size)
+            return 0;
+
+        switch (bpp) {
+            case 8:
+                svga_conv_line_8(p, &svga->vram[addr], count, svga->map8);
+                break;
+
+            case 15:
+                svga_conv_line_15(p, &svga->vram[addr], count);
+                break;
+
+            case 16:
+                svga_conv_line_16(p, &svga->vram[addr], count);
+                break;
+
+            case 32:
+                svga_conv_line_32(p, &svga->vram[addr], count);
+                break;
+
+            default:
+                break;
+        }
+
+        return count;
+    }
+
+    if (!svga_render_thread_h) {
+        svga_render_jobs       = calloc(SVGA_RENDER_JOB_NR, sizeof(svga_render_job_t));
+        svga_render_wake_event = thread_create_event();
+        svga_render_done_event = thread_create_event();
+        svga_render_thread_run = 1;
+        svga_render_thread_h   = thread_create_named(svga_render_thread, NULL, "svga renderer");
+    }
+
+    /* Wait for a free slot - the worker normally stays well ahead. */
+    while ((svga_render_write_idx - svga_render_read_idx) >= SVGA_RENDER_JOB_NR) {
+        thread_set_event(svga_render_wake_event);
+        thread_wait_event(svga_render_done_event, 1);
+        thread_reset_event(svga_render_done_event);
+    }
+
+    job        = &svga_render_jobs[svga_render_write_idx & SVGA_RENDER_JOB_MASK];
+    job->dest  = p;
+    job->count = count;
+    job->bpp   = bpp;
+
+    if (bpp == 8)
+        memcpy(job->pal, svga->map8, sizeof(job->pal));
+
+    if ((addr + len) <= vram_size)
+        memcpy(job->src, &svga->vram[addr], len);
+    else {
+        memcpy(job->src, &svga->vram[addr], vram_size - addr);
+        memcpy(job->src + (vram_size - addr), svga->vram, len - (vram_size - addr));
+    }
+
+    svga_render_write_idx++;
+    thread_set_event(svga_render_wake_event);
+
+    return count;
+}
+
 void
 svga_render_null(svga_t *svga)
 {
@@ -65,6 +362,9 @@ svga_render_blank(svga_t *svga)
         svga->firstline_draw = svga->displine;
     svga->lastline_draw = svga->displine;
 
+    if ((svga->displine + svga->y_add) < 2048)
+        svga->text_line_hash[svga->displine + svga->y_add] = 0;
+
     uint32_t char_width = 0;
 
     switch (svga->seqregs[1] & 9) {
@@ -236,6 +536,50 @@ svga_render_text_80(svga_t *svga)
         p    = &svga->monitor->target_buffer->line[svga->displine + svga->y_add][svga->x_add];
         xinc = (svga->seqregs[1] & 1) ? 8 : 9;
 
+        /* Hash the row's characters, attributes and font bytes together with
+           the cursor/blink state and the 16 resolved palette entries; if
+           nothing changed the line in the buffer is still valid and the
+           glyph expansion below is skipped. Lines something else has drawn
+           over have their stored hash cleared, so they never match. */
+        if ((svga->displine + svga->y_add) < 2048) {
+            uint32_t ma   = svga->ma;
+            uint32_t cols[16];
+            uint8_t  state[6] = { (uint8_t) (svga->con && svga->cursoron),
+                                  (uint8_t) (svga->blink & 16),
+                                  svga->attrregs[0x10], svga->seqregs[1],
+                                  (uint8_t) svga->sc, (uint8_t) svga->scrollcache };
+            uint32_t hash     = video_hash(VIDEO_HASH_INIT, state, sizeof(state));
+
+            hash = video_hash(hash, &svga->ma, sizeof(svga->ma));
+            hash = video_hash(hash, &svga->ca, sizeof(svga->ca));
+            for (xx = 0; xx < 16; xx++)
+                cols[xx] = svga->pallook[svga->egapal[xx]];
+            hash = video_hash(hash, cols, sizeof(cols));
+
+            for (int x = 0; x < (svga->hdisp + svga->scrollcache); x += xinc) {
+                uint8_t cdat[3];
+
+                if (svga->force_old_addr) {
+                    cdat[0] = svga->vram[(ma << 1) & svga->vram_display_mask];
+                    cdat[1] = svga->vram[((ma << 1) + 1) & svga->vram_display_mask];
+                } else {
+                    addr    = svga->remap_func(svga, ma) & svga->vram_display_mask;
+                    cdat[0] = svga->vram[addr];
+                    cdat[1] = svga->vram[addr + 1];
+                }
+                charaddr = ((cdat[1] & 8) ? svga->charsetb : svga->charseta) + (cdat[0] * 128);
+                cdat[2]  = svga->vram[charaddr + (svga->sc << 2)];
+                hash     = video_hash(hash, cdat, sizeof(cdat));
+                ma += 4;
+            }
+
+            if (hash == svga->text_line_hash[svga->displine + svga->y_add]) {
+                svga->ma = ma & svga->vram_display_mask;
+                return;
+            }
+            svga->text_line_hash[svga->displine + svga->y_add] = hash;
+        }
+
         for (int x = 0; x < (svga->hdisp + svga->scrollcache); x += xinc) {
             if (!svga->force_old_addr)
                 addr = svga->remap_func(svga, svga->ma) & svga->vram_display_mask;
@@ -551,6 +895,58 @@ svga_render_indexed_gfx(svga_t *svga, bool highres, bool combine8bits)
         svga->firstline_draw = svga->displine;
     svga->lastline_draw = svga->displine;
 
+    /* Plain packed 8bpp with none of the shifter features in play reduces to a
+       straight palette lookup per byte - route it through the scanline
+       conversion path so it can run vectorized and off the CPU thread. */
+    if (highres8bpp && !svga->ati_4color && !svga->packed_4bpp
+        && (loadevery == 1) && (incevery == 1) && (incbypow2 == 0)
+        && !svga->force_old_addr && !svga->remap_required
+        && (planemask == 0xffffffff) && !attrblink) {
+        x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 8);
+        if (x) {
+            svga->ma = (svga->ma + x) & svga->vram_display_mask;
+            return;
+        }
+    }
+
+    /* Planar 16-colour modes with none of the shifter features in play
+       (mode 12h and friends) expand whole bytes at a time: the four plane
+       bytes are widened to eight chunky 4bpp pixels with one table lookup
+       per plane, instead of shifting pixel by pixel below. */
+    if (!combine8bits && !svga->ati_4color && !shift4bit && !shift2bit
+        && (loadevery == 1) && (incevery == 1) && (incbypow2 == 0)
+        && !svga->force_old_addr) {
+        const uint64_t planemask64 = UINT64_C(0x1111111111111111) * (uint64_t) svga->plane_mask;
+        const uint64_t blinkmask64 = attrblink ? UINT64_C(0x8888888888888888) : 0;
+        const uint64_t blinkval64  = (attrblink && blinked) ? UINT64_C(0x8888888888888888) : 0;
+
+        for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += charwidth) {
+            addr = svga->remap_required ? svga->remap_func(svga, svga->ma) : svga->ma;
+            addr &= svga->vram_display_mask;
+
+            uint64_t edat64 = plane4lookup[0][svga->vram[addr]]
+                            | plane4lookup[1][svga->vram[addr + 1]]
+                            | plane4lookup[2][svga->vram[addr + 2]]
+                            | plane4lookup[3][svga->vram[addr + 3]];
+
+            svga->ma = (svga->ma + 4) & svga->vram_display_mask;
+
+            /* Same nibble-wise plane enable and blink logic as below. */
+            edat64 = ((edat64 & planemask64 & ~blinkmask64) | ((edat64 | ~planemask64) & blinkmask64 & blinkval64)) ^ blinkmask64;
+
+            if (highres) {
+                for (int i = 0; i < 8; i++)
+                    p[i] = svga->pallook[svga->egapal[(edat64 >> (i << 2)) & 0xF]];
+            } else {
+                for (int i = 0; i < 8; i++)
+                    p[i << 1] = p[(i << 1) + 1] = svga->pallook[svga->egapal[(edat64 >> (i << 2)) & 0xF]];
+            }
+
+            p += charwidth;
+        }
+        return;
+    }
+
     uint32_t incr_counter = 0;
     uint32_t load_counter = 0;
     uint32_t edat         = 0;
@@ -1148,22 +1544,25 @@ svga_render_15bpp_highres(svga_t *svga)
                 svga->firstline_draw = svga->displine;
             svga->lastline_draw = svga->displine;
 
-            for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
-                p[x]     = svga->conv_16to32(svga, dat & 0xffff, 15);
-                p[x + 1] = svga->conv_16to32(svga, dat >> 16, 15);
+            x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 15);
+            if (!x) {
+                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
+                    p[x]     = svga->conv_16to32(svga, dat & 0xffff, 15);
+                    p[x + 1] = svga->conv_16to32(svga, dat >> 16, 15);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
-                p[x + 2] = svga->conv_16to32(svga, dat & 0xffff, 15);
-                p[x + 3] = svga->conv_16to32(svga, dat >> 16, 15);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
+                    p[x + 2] = svga->conv_16to32(svga, dat & 0xffff, 15);
+                    p[x + 3] = svga->conv_16to32(svga, dat >> 16, 15);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
-                p[x + 4] = svga->conv_16to32(svga, dat & 0xffff, 15);
-                p[x + 5] = svga->conv_16to32(svga, dat >> 16, 15);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
+                    p[x + 4] = svga->conv_16to32(svga, dat & 0xffff, 15);
+                    p[x + 5] = svga->conv_16to32(svga, dat >> 16, 15);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
-                p[x + 6] = svga->conv_16to32(svga, dat & 0xffff, 15);
-                p[x + 7] = svga->conv_16to32(svga, dat >> 16, 15);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
+                    p[x + 6] = svga->conv_16to32(svga, dat & 0xffff, 15);
+                    p[x + 7] = svga->conv_16to32(svga, dat >> 16, 15);
+                }
             }
             svga->ma += x << 1;
             svga->ma &= svga->vram_display_mask;
@@ -1179,22 +1578,25 @@ svga_render_15bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+                x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 15);
+                if (!x) {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 15);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 15);
+                    }
                 }
                 svga->ma += x << 1;
             } else {
@@ -1380,22 +1782,25 @@ svga_render_16bpp_highres(svga_t *svga)
                 svga->firstline_draw = svga->displine;
             svga->lastline_draw = svga->displine;
 
-            for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                uint32_t dat = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
-                p[x]         = svga->conv_16to32(svga, dat & 0xffff, 16);
-                p[x + 1]     = svga->conv_16to32(svga, dat >> 16, 16);
+            x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 16);
+            if (!x) {
+                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                    uint32_t dat = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
+                    p[x]         = svga->conv_16to32(svga, dat & 0xffff, 16);
+                    p[x + 1]     = svga->conv_16to32(svga, dat >> 16, 16);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
-                p[x + 2] = svga->conv_16to32(svga, dat & 0xffff, 16);
-                p[x + 3] = svga->conv_16to32(svga, dat >> 16, 16);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
+                    p[x + 2] = svga->conv_16to32(svga, dat & 0xffff, 16);
+                    p[x + 3] = svga->conv_16to32(svga, dat >> 16, 16);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
-                p[x + 4] = svga->conv_16to32(svga, dat & 0xffff, 16);
-                p[x + 5] = svga->conv_16to32(svga, dat >> 16, 16);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
+                    p[x + 4] = svga->conv_16to32(svga, dat & 0xffff, 16);
+                    p[x + 5] = svga->conv_16to32(svga, dat >> 16, 16);
 
-                dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
-                p[x + 6] = svga->conv_16to32(svga, dat & 0xffff, 16);
-                p[x + 7] = svga->conv_16to32(svga, dat >> 16, 16);
+                    dat      = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
+                    p[x + 6] = svga->conv_16to32(svga, dat & 0xffff, 16);
+                    p[x + 7] = svga->conv_16to32(svga, dat >> 16, 16);
+                }
             }
             svga->ma += x << 1;
             svga->ma &= svga->vram_display_mask;
@@ -1411,22 +1816,25 @@ svga_render_16bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
-
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
-                    *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
-                    *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+                x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 16);
+                if (!x) {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x += 8) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1)) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 4) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 8) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 1) + 12) & svga->vram_display_mask]);
+                        *p++ = svga->conv_16to32(svga, dat & 0xffff, 16);
+                        *p++ = svga->conv_16to32(svga, dat >> 16, 16);
+                    }
                 }
                 svga->ma += x << 1;
             } else {
@@ -1682,9 +2090,11 @@ svga_render_32bpp_highres(svga_t *svga)
                 svga->firstline_draw = svga->displine;
             svga->lastline_draw = svga->displine;
 
-            for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
-                dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 2)) & svga->vram_display_mask]);
-                p[x] = lookup_lut(dat & 0xffffff);
+            if (!svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 32)) {
+                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
+                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 2)) & svga->vram_display_mask]);
+                    p[x] = lookup_lut(dat & 0xffffff);
+                }
             }
             svga->ma += 4;
             svga->ma &= svga->vram_display_mask;
@@ -1700,9 +2110,12 @@ svga_render_32bpp_highres(svga_t *svga)
             svga->lastline_draw = svga->displine;
 
             if (!svga->remap_required) {
-                for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
-                    dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 2)) & svga->vram_display_mask]);
-                    *p++ = lookup_lut(dat & 0xffffff);
+                x = svga_render_line_fast(svga, p, svga->hdisp + svga->scrollcache, 32);
+                if (!x) {
+                    for (x = 0; x <= (svga->hdisp + svga->scrollcache); x++) {
+                        dat  = *(uint32_t *) (&svga->vram[(svga->ma + (x << 2)) & svga->vram_display_mask]);
+                        *p++ = lookup_lut(dat & 0xffffff);
+                    }
                 }
                 svga->ma += (x * 4);
             } else {
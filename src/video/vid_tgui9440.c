@@ -1173,7 +1173,7 @@ tgui_ext_linear_write(uint32_t addr, uint8_t val, void *priv)
     addr &= (tgui->ext_gdc_regs[0] & EXT_CTRL_LATCH_COPY) ? ~0x0f : ~0x07;
 
     addr                          = dword_remap(svga, addr);
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     if (tgui->ext_gdc_regs[0] & EXT_CTRL_LATCH_COPY) {
         for (c = 0; c < 16; c++) {
@@ -1239,7 +1239,7 @@ tgui_ext_linear_writew(uint32_t addr, uint16_t val, void *priv)
     addr &= (tgui->ext_gdc_regs[0] & EXT_CTRL_LATCH_COPY) ? ~0x0f : ~0x07;
 
     addr                          = dword_remap(svga, addr);
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     val = (val >> 8) | (val << 8);
 
@@ -1304,7 +1304,7 @@ tgui_ext_linear_writel(uint32_t addr, uint32_t val, void *priv)
     addr &= (tgui->ext_gdc_regs[0] & EXT_CTRL_LATCH_COPY) ? ~0x0f : ~0x07;
 
     addr                          = dword_remap(svga, addr);
-    svga->changedvram[addr >> 12] = svga->monitor->mon_changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
 
     if (tgui->ext_gdc_regs[0] & (EXT_CTRL_MONO_EXPANSION | EXT_CTRL_MONO_TRANSPARENT | EXT_CTRL_LATCH_COPY)) {
         tgui_ext_linear_writew(addr, val & 0xffff, priv);
@@ -1387,13 +1387,13 @@ enum {
 #define WRITE(addr, dat)                                                               \
     if (tgui->accel.bpp == 0) {                                                        \
         svga->vram[(addr) &tgui->vram_mask]                   = dat;                   \
-        svga->changedvram[((addr) & (tgui->vram_mask)) >> 12] = svga->monitor->mon_changeframecount;      \
+        svga_dirty_mark(svga, ((addr) & (tgui->vram_mask)) >> 12);      \
     } else if (tgui->accel.bpp == 1) {                                                 \
         vram_w[(addr) & (tgui->vram_mask >> 1)]                    = dat;              \
-        svga->changedvram[((addr) & (tgui->vram_mask >> 1)) >> 11] = svga->monitor->mon_changeframecount; \
+        svga_dirty_mark(svga, ((addr) & (tgui->vram_mask >> 1)) >> 11); \
     } else {                                                                           \
         vram_l[(addr) & (tgui->vram_mask >> 2)]                    = dat;              \
-        svga->changedvram[((addr) & (tgui->vram_mask >> 2)) >> 10] = svga->monitor->mon_changeframecount; \
+        svga_dirty_mark(svga, ((addr) & (tgui->vram_mask >> 2)) >> 10); \
     }
 
 static void
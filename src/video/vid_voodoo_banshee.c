@@ -47,6 +47,11 @@
 #include <86box/vid_voodoo_regs.h>
 #include <86box/vid_voodoo_render.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    define BANSHEE_OVERLAY_SSE2
+#    include <emmintrin.h>
+#endif
+
 #define ROM_BANSHEE                 "roms/video/voodoo/Pci_sg.rom"
 #define ROM_CREATIVE_BANSHEE        "roms/video/voodoo/BlasterPCI.rom"
 #define ROM_VOODOO3_1000            "roms/video/voodoo/1k11sg.rom"
@@ -114,6 +119,7 @@ typedef struct banshee_t {
     uint32_t vidDesktopOverlayStride;
     uint32_t vidDesktopStartAddr;
     uint32_t vidProcCfg;
+    int      overlay_static; /* scaled overlay: no source changes this frame */
     uint32_t vidScreenSize;
     uint32_t vidSerialParallelPort;
 
@@ -512,7 +518,7 @@ banshee_render_16bpp_tiled(svga_t *svga)
 
     for (int x = 0; x <= svga->hdisp; x += 64) {
         if (svga->hwcursor_on || svga->overlay_on)
-            svga->changedvram[addr >> 12] = 2;
+            svga_dirty_mark(svga, addr >> 12);
         if (svga->changedvram[addr >> 12] || svga->fullchange) {
             const uint16_t *vram_p = (uint16_t *) &svga->vram[addr & svga->vram_display_mask];
 
@@ -1912,7 +1918,7 @@ banshee_write_linear(uint32_t addr, uint8_t val, void *priv)
 
     cycles -= svga->monitor->mon_video_timing_write_b;
 
-    svga->changedvram[addr >> 12]      = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     svga->vram[addr & svga->vram_mask] = val;
 }
 
@@ -1952,7 +1958,7 @@ banshee_write_linear_w(uint32_t addr, uint16_t val, void *priv)
 
     cycles -= svga->monitor->mon_video_timing_write_w;
 
-    svga->changedvram[addr >> 12]                     = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint16_t *) &svga->vram[addr & svga->vram_mask] = val;
 }
 
@@ -2001,7 +2007,7 @@ banshee_write_linear_l(uint32_t addr, uint32_t val, void *priv)
 
     cycles -= svga->monitor->mon_video_timing_write_l;
 
-    svga->changedvram[addr >> 12]                     = changeframecount;
+    svga_dirty_mark(svga, addr >> 12);
     *(uint32_t *) &svga->vram[addr & svga->vram_mask] = val;
     if (voodoo->cmdfifo_enabled && addr >= voodoo->cmdfifo_base && addr < voodoo->cmdfifo_end) {
 #if 0
@@ -2157,83 +2163,92 @@ banshee_hwcursor_draw(svga_t *svga, int displine)
         }                                                                                                               \
     } while (0)
 
-#define DECODE_YUYV422(buf)                                      \
-    do {                                                         \
-        int c;                                                   \
-        int wp = 0;                                              \
-                                                                 \
-        for (c = 0; c < voodoo->overlay.overlay_bytes; c += 4) { \
-            uint8_t y1, y2;                                      \
-            int8_t  Cr, Cb;                                      \
-            int     dR, dG, dB;                                  \
-            int     r, g, b;                                     \
-                                                                 \
-            y1 = src[0];                                         \
-            Cr = src[1] - 0x80;                                  \
-            y2 = src[2];                                         \
-            Cb = src[3] - 0x80;                                  \
-            src += 4;                                            \
-                                                                 \
-            dR = (359 * Cr) >> 8;                                \
-            dG = (88 * Cb + 183 * Cr) >> 8;                      \
-            dB = (453 * Cb) >> 8;                                \
-                                                                 \
-            r = y1 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y1 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y1 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-                                                                 \
-            r = y2 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y2 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y2 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-        }                                                        \
-    } while (0)
+/* Decode a line of packed 4:2:2 YUV into 32-bit RGB. Both overlay orders
+   put Cr in the first chroma byte of each pair; y_odd selects where the
+   luma bytes sit (0 = YUYV, 1 = UYVY). The SSE2 path converts eight
+   pixels per iteration: the chroma deltas are computed per pair with a
+   multiply-add (the same fixed-point weights as the scalar code), the
+   luma is added in 16-bit lanes and the unsigned-saturating pack does
+   the clamping. */
+static void
+banshee_decode_yuv_line(uint32_t *buf, const uint8_t *src, int bytes, int y_odd)
+{
+    int c  = 0;
+    int wp = 0;
+
+#ifdef BANSHEE_OVERLAY_SSE2
+    const __m128i m8   = _mm_set1_epi16(0xff);
+    const __m128i bias = _mm_set1_epi16(0x80);
+    const __m128i k_r  = _mm_set1_epi32(359);              /* [359,   0] per pair */
+    const __m128i k_g  = _mm_set1_epi32(183 | (88 << 16)); /* [183,  88] */
+    const __m128i k_b  = _mm_set1_epi32(453 << 16);        /* [  0, 453] */
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; (c + 16) <= bytes; c += 16) {
+        __m128i v  = _mm_loadu_si128((const __m128i *) (src + c));
+        __m128i y  = y_odd ? _mm_srli_epi16(v, 8) : _mm_and_si128(v, m8);
+        __m128i cc = _mm_sub_epi16(y_odd ? _mm_and_si128(v, m8) : _mm_srli_epi16(v, 8), bias);
+        __m128i dr = _mm_srai_epi32(_mm_madd_epi16(cc, k_r), 8);
+        __m128i dg = _mm_srai_epi32(_mm_madd_epi16(cc, k_g), 8);
+        __m128i db = _mm_srai_epi32(_mm_madd_epi16(cc, k_b), 8);
+
+        /* Narrow the four per-pair deltas and duplicate each one over
+           its two pixels. */
+        dr = _mm_packs_epi32(dr, dr);
+        dr = _mm_unpacklo_epi16(dr, dr);
+        dg = _mm_packs_epi32(dg, dg);
+        dg = _mm_unpacklo_epi16(dg, dg);
+        db = _mm_packs_epi32(db, db);
+        db = _mm_unpacklo_epi16(db, db);
+
+        __m128i r8 = _mm_packus_epi16(_mm_add_epi16(y, dr), zero);
+        __m128i g8 = _mm_packus_epi16(_mm_sub_epi16(y, dg), zero);
+        __m128i b8 = _mm_packus_epi16(_mm_add_epi16(y, db), zero);
+        __m128i rg = _mm_unpacklo_epi8(r8, g8);
+        __m128i bz = _mm_unpacklo_epi8(b8, zero);
+
+        _mm_storeu_si128((__m128i *) &buf[wp], _mm_unpacklo_epi16(rg, bz));
+        _mm_storeu_si128((__m128i *) &buf[wp + 4], _mm_unpackhi_epi16(rg, bz));
+        wp += 8;
+    }
+#endif
 
-#define DECODE_UYUV422(buf)                                      \
-    do {                                                         \
-        int c;                                                   \
-        int wp = 0;                                              \
-                                                                 \
-        for (c = 0; c < voodoo->overlay.overlay_bytes; c += 4) { \
-            uint8_t y1, y2;                                      \
-            int8_t  Cr, Cb;                                      \
-            int     dR, dG, dB;                                  \
-            int     r, g, b;                                     \
-                                                                 \
-            Cr = src[0] - 0x80;                                  \
-            y1 = src[1];                                         \
-            Cb = src[2] - 0x80;                                  \
-            y2 = src[3];                                         \
-            src += 4;                                            \
-                                                                 \
-            dR = (359 * Cr) >> 8;                                \
-            dG = (88 * Cb + 183 * Cr) >> 8;                      \
-            dB = (453 * Cb) >> 8;                                \
-                                                                 \
-            r = y1 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y1 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y1 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-                                                                 \
-            r = y2 + dR;                                         \
-            CLAMP(r);                                            \
-            g = y2 - dG;                                         \
-            CLAMP(g);                                            \
-            b = y2 + dB;                                         \
-            CLAMP(b);                                            \
-            buf[wp++] = r | (g << 8) | (b << 16);                \
-        }                                                        \
-    } while (0)
+    for (; c < bytes; c += 4) {
+        uint8_t y1, y2;
+        int8_t  Cr, Cb;
+        int     dR, dG, dB;
+        int     r, g, b;
+
+        y1 = src[c + y_odd];
+        Cr = src[c + !y_odd] - 0x80;
+        y2 = src[c + 2 + y_odd];
+        Cb = src[c + 2 + !y_odd] - 0x80;
+
+        dR = (359 * Cr) >> 8;
+        dG = (88 * Cb + 183 * Cr) >> 8;
+        dB = (453 * Cb) >> 8;
+
+        r = y1 + dR;
+        CLAMP(r);
+        g = y1 - dG;
+        CLAMP(g);
+        b = y1 + dB;
+        CLAMP(b);
+        buf[wp++] = r | (g << 8) | (b << 16);
+
+        r = y2 + dR;
+        CLAMP(r);
+        g = y2 - dG;
+        CLAMP(g);
+        b = y2 + dB;
+        CLAMP(b);
+        buf[wp++] = r | (g << 8) | (b << 16);
+    }
+}
+
+#define DECODE_YUYV422(buf) banshee_decode_yuv_line(buf, src, voodoo->overlay.overlay_bytes, 0)
+
+#define DECODE_UYUV422(buf) banshee_decode_yuv_line(buf, src, voodoo->overlay.overlay_bytes, 1)
 
 #define OVERLAY_SAMPLE(buf)                                                      \
     do {                                                                         \
@@ -2416,6 +2431,11 @@ banshee_overlay_draw(svga_t *svga, int displine)
     int             skip_filtering;
     const uint32_t *clut = &svga->pallook[(banshee->vidProcCfg & VIDPROCCFG_OVERLAY_CLUT_SEL) ? 256 : 0];
 
+    if (banshee->overlay_static) {
+        voodoo->overlay.src_y += voodoo->overlay.vidOverlayDvdy;
+        return;
+    }
+
     if (svga->render == svga_render_null && !svga->changedvram[src_addr >> 12] && !svga->changedvram[src_addr2 >> 12] && !svga->fullchange && ((voodoo->overlay.src_y >> 20) < 2048 && !voodoo->dirty_line[voodoo->overlay.src_y >> 20]) && !(banshee->vidProcCfg & VIDPROCCFG_V_SCALE_ENABLE)) {
         voodoo->overlay.src_y += (1 << 20);
         return;
@@ -2677,6 +2697,28 @@ banshee_vsync_callback(svga_t *svga)
     voodoo->overlay.src_y = 0;
     banshee->desktop_addr = banshee->vidDesktopStartAddr;
     banshee->desktop_y    = 0;
+
+    /* With vertical scaling several display lines share a source line, so
+       the per-line skip in banshee_overlay_draw() cannot be used there.
+       Instead flag the whole frame static when nothing under the overlay
+       source changed since the last one; the compose then leaves the
+       previous output untouched. */
+    banshee->overlay_static = 0;
+    if ((banshee->vidProcCfg & VIDPROCCFG_V_SCALE_ENABLE) && !(banshee->vidProcCfg & VIDPROCCFG_OVERLAY_TILE) && (svga->render == svga_render_null) && !svga->fullchange) {
+        uint32_t lines = ((uint32_t) svga->overlay_latch.cur_ysize * voodoo->overlay.vidOverlayDvdy) >> 20;
+        uint32_t last  = svga->overlay_latch.addr + ((lines + 1) * svga->overlay_latch.pitch);
+        int      clean = 1;
+
+        for (uint32_t page = svga->overlay_latch.addr >> 12; clean && (page <= (last >> 12)); page++) {
+            if (svga->changedvram[page & (svga->vram_mask >> 12)])
+                clean = 0;
+        }
+        for (uint32_t y = 0; clean && (y <= lines) && (y < 2048); y++) {
+            if (voodoo->dirty_line[y])
+                clean = 0;
+        }
+        banshee->overlay_static = clean;
+    }
 }
 
 static uint8_t
@@ -3071,6 +3113,10 @@ static const device_config_t banshee_sgram_config[] = {
                 .description = "4",
                 .value = 4
             },
+            {
+                .description = "8",
+                .value = 8
+            },
             {
                 .description = ""
             }
@@ -3126,6 +3172,10 @@ static const device_config_t banshee_sdram_config[] = {
                 .description = "4",
                 .value = 4
             },
+            {
+                .description = "8",
+                .value = 8
+            },
             {
                 .description = ""
             }
@@ -3235,6 +3285,7 @@ banshee_init_common(const device_t *info, char *fn, int has_sgram, int type, int
     banshee->voodoo->priv         = banshee;
     banshee->voodoo->vram         = banshee->svga.vram;
     banshee->voodoo->changedvram  = banshee->svga.changedvram;
+    banshee->voodoo->changedvram_sum = banshee->svga.changedvram_sum;
     banshee->voodoo->fb_mem       = banshee->svga.vram;
     banshee->voodoo->fb_mask      = banshee->svga.vram_mask;
     banshee->voodoo->tex_mem[0]   = banshee->svga.vram;
@@ -33,6 +33,15 @@
 #include <86box/vid_voodoo_banshee_blitter.h>
 #include <86box/vid_voodoo_render.h>
 
+/* The blitter writes through the aliased banshee changedvram - keep the
+   summary bitmap in step, same as svga_dirty_mark(). */
+static __inline void
+banshee_blt_dirty_mark(voodoo_t *voodoo, uint32_t page)
+{
+    voodoo->changedvram[page] = changeframecount;
+    voodoo->changedvram_sum[page >> 6] |= 1ULL << (page & 0x3f);
+}
+
 #define COMMAND_CMD_MASK                         (0xf)
 #define COMMAND_CMD_NOP                          (0 << 0)
 #define COMMAND_CMD_SCREEN_TO_SCREEN_BLT         (1 << 0)
@@ -217,7 +226,7 @@ PLOT(voodoo_t *voodoo, int x, int y, int pat_x, int pat_y, uint8_t pattern_mask,
                 uint32_t pattern = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern8[(pat_x & 7) + (pat_y & 7) * 8];
 
                 voodoo->vram[addr]              = MIX(voodoo, dest, src, pattern, src_colorkey, COLORKEY_8);
-                voodoo->changedvram[addr >> 12] = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_16_BPP:
@@ -227,7 +236,7 @@ PLOT(voodoo_t *voodoo, int x, int y, int pat_x, int pat_y, uint8_t pattern_mask,
                 uint32_t pattern = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern16[(pat_x & 7) + (pat_y & 7) * 8];
 
                 *(uint16_t *) &voodoo->vram[addr] = MIX(voodoo, dest, src, pattern, src_colorkey, COLORKEY_16);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_24_BPP:
@@ -237,7 +246,7 @@ PLOT(voodoo_t *voodoo, int x, int y, int pat_x, int pat_y, uint8_t pattern_mask,
                 uint32_t pattern = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern24[(pat_x & 7) + (pat_y & 7) * 8];
 
                 *(uint32_t *) &voodoo->vram[addr] = (MIX(voodoo, dest, src, pattern, src_colorkey, COLORKEY_32) & 0xffffff) | (dest & 0xff000000);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_32_BPP:
@@ -247,7 +256,7 @@ PLOT(voodoo_t *voodoo, int x, int y, int pat_x, int pat_y, uint8_t pattern_mask,
                 uint32_t pattern = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern[(pat_x & 7) + (pat_y & 7) * 8];
 
                 *(uint32_t *) &voodoo->vram[addr] = MIX(voodoo, dest, src, pattern, src_colorkey, COLORKEY_32);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
 
@@ -266,7 +275,7 @@ PLOT_LINE(voodoo_t *voodoo, int x, int y, UNUSED(uint8_t rop), uint32_t pattern,
                 uint32_t dest = voodoo->vram[addr];
 
                 voodoo->vram[addr]              = MIX(voodoo, dest, voodoo->banshee_blt.colorFore, pattern, src_colorkey, COLORKEY_8);
-                voodoo->changedvram[addr >> 12] = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_16_BPP:
@@ -275,7 +284,7 @@ PLOT_LINE(voodoo_t *voodoo, int x, int y, UNUSED(uint8_t rop), uint32_t pattern,
                 uint32_t dest = *(uint16_t *) &voodoo->vram[addr];
 
                 *(uint16_t *) &voodoo->vram[addr] = MIX(voodoo, dest, voodoo->banshee_blt.colorFore, pattern, src_colorkey, COLORKEY_16);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_24_BPP:
@@ -284,7 +293,7 @@ PLOT_LINE(voodoo_t *voodoo, int x, int y, UNUSED(uint8_t rop), uint32_t pattern,
                 uint32_t dest = *(uint32_t *) &voodoo->vram[addr];
 
                 *(uint32_t *) &voodoo->vram[addr] = (MIX(voodoo, dest, voodoo->banshee_blt.colorFore, pattern, src_colorkey, COLORKEY_32) & 0xffffff) | (dest & 0xff000000);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
         case DST_FORMAT_COL_32_BPP:
@@ -293,7 +302,7 @@ PLOT_LINE(voodoo_t *voodoo, int x, int y, UNUSED(uint8_t rop), uint32_t pattern,
                 uint32_t dest = *(uint32_t *) &voodoo->vram[addr];
 
                 *(uint32_t *) &voodoo->vram[addr] = MIX(voodoo, dest, voodoo->banshee_blt.colorFore, pattern, src_colorkey, COLORKEY_32);
-                voodoo->changedvram[addr >> 12]   = changeframecount;
+                banshee_blt_dirty_mark(voodoo, addr >> 12);
                 break;
             }
 
@@ -574,7 +583,7 @@ do_screen_to_screen_line(voodoo_t *voodoo, uint8_t *src_p, int use_x_dir, int sr
                                 uint32_t pattern  = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern8[(pat_x & 7) + (pat_y & 7) * 8];
 
                                 voodoo->vram[dst_addr]              = MIX(voodoo, dest, src, pattern, COLORKEY_8, COLORKEY_8);
-                                voodoo->changedvram[dst_addr >> 12] = changeframecount;
+                                banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                                 break;
                             }
                         case DST_FORMAT_COL_16_BPP:
@@ -585,7 +594,7 @@ do_screen_to_screen_line(voodoo_t *voodoo, uint8_t *src_p, int use_x_dir, int sr
                                 uint32_t pattern  = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern16[(pat_x & 7) + (pat_y & 7) * 8];
 
                                 *(uint16_t *) &voodoo->vram[dst_addr] = MIX(voodoo, dest, src, pattern, COLORKEY_16, COLORKEY_16);
-                                voodoo->changedvram[dst_addr >> 12]   = changeframecount;
+                                banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                                 break;
                             }
                         case DST_FORMAT_COL_24_BPP:
@@ -596,7 +605,7 @@ do_screen_to_screen_line(voodoo_t *voodoo, uint8_t *src_p, int use_x_dir, int sr
                                 uint32_t pattern  = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern24[(pat_x & 7) + (pat_y & 7) * 8];
 
                                 *(uint32_t *) &voodoo->vram[dst_addr] = (MIX(voodoo, dest, src, pattern, COLORKEY_32, COLORKEY_32) & 0xffffff) | (dest & 0xff000000);
-                                voodoo->changedvram[dst_addr >> 12]   = changeframecount;
+                                banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                                 break;
                             }
                         case DST_FORMAT_COL_32_BPP:
@@ -607,7 +616,7 @@ do_screen_to_screen_line(voodoo_t *voodoo, uint8_t *src_p, int use_x_dir, int sr
                                 uint32_t pattern  = (voodoo->banshee_blt.command & COMMAND_PATTERN_MONO) ? ((pattern_mask & (1 << (7 - (pat_x & 7)))) ? voodoo->banshee_blt.colorFore : voodoo->banshee_blt.colorBack) : voodoo->banshee_blt.colorPattern[(pat_x & 7) + (pat_y & 7) * 8];
 
                                 *(uint32_t *) &voodoo->vram[dst_addr] = MIX(voodoo, dest, src, pattern, COLORKEY_32, COLORKEY_32);
-                                voodoo->changedvram[dst_addr >> 12]   = changeframecount;
+                                banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                                 break;
                             }
 
@@ -908,7 +917,7 @@ do_screen_to_screen_stretch_line(voodoo_t *voodoo, uint8_t *src_p, int src_x, in
 #if 0
                             bansheeblt_log("%i,%i : sdp=%02x,%02x,%02x res=%02x\n", voodoo->banshee_blt.cur_x, voodoo->banshee_blt.cur_y, src, dest, pattern, voodoo->vram[dst_addr]);
 #endif
-                            voodoo->changedvram[dst_addr >> 12] = changeframecount;
+                            banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                             break;
                         }
                     case DST_FORMAT_COL_16_BPP:
@@ -922,7 +931,7 @@ do_screen_to_screen_stretch_line(voodoo_t *voodoo, uint8_t *src_p, int src_x, in
 #if 0
                             bansheeblt_log("%i,%i : sdp=%02x,%02x,%02x res=%02x\n", voodoo->banshee_blt.cur_x, voodoo->banshee_blt.cur_y, src, dest, pattern, *(uint16_t *)&voodoo->vram[dst_addr]);
 #endif
-                            voodoo->changedvram[dst_addr >> 12] = changeframecount;
+                            banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                             break;
                         }
                     case DST_FORMAT_COL_24_BPP:
@@ -936,7 +945,7 @@ do_screen_to_screen_stretch_line(voodoo_t *voodoo, uint8_t *src_p, int src_x, in
 #if 0
                             bansheeblt_log("%i,%i : sdp=%02x,%02x,%02x res=%02x\n", voodoo->banshee_blt.cur_x, voodoo->banshee_blt.cur_y, src, dest, pattern, voodoo->vram[dst_addr]);
 #endif
-                            voodoo->changedvram[dst_addr >> 12] = changeframecount;
+                            banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                             break;
                         }
                     case DST_FORMAT_COL_32_BPP:
@@ -950,7 +959,7 @@ do_screen_to_screen_stretch_line(voodoo_t *voodoo, uint8_t *src_p, int src_x, in
 #if 0
                             bansheeblt_log("%i,%i : sdp=%02x,%02x,%02x res=%02x\n", voodoo->banshee_blt.cur_x, voodoo->banshee_blt.cur_y, src, dest, pattern, voodoo->vram[dst_addr]);
 #endif
-                            voodoo->changedvram[dst_addr >> 12] = changeframecount;
+                            banshee_blt_dirty_mark(voodoo, dst_addr >> 12);
                             break;
                         }
 
@@ -40,6 +40,14 @@
 #include <86box/vid_voodoo_render.h>
 #include <86box/vid_voodoo_texture.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    define VOODOO_RENDER_SSE2
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define VOODOO_RENDER_NEON
+#    include <arm_neon.h>
+#endif
+
 typedef struct voodoo_state_t {
     int      xstart, xend, xdir;
     uint32_t base_r, base_g, base_b, base_a, base_z;
@@ -281,10 +289,48 @@ tex_read_4(voodoo_state_t *state, voodoo_texture_state_t *texture_state, int s,
         dat[3].u = state->tex[tmu][state->lod][s + 1 + ((t + 1) << texture_state->tex_shift)];
     }
 
+#ifdef VOODOO_RENDER_SSE2
+    /* Blend all four channels at once, mirroring what the recompiler
+       generates: the four texels unpacked to 16-bit lanes, multiplied by
+       their weights and summed pairwise. The weights total 256, so each
+       lane stays within 16 bits. */
+    __m128i texels = _mm_loadu_si128((__m128i *) dat);
+    __m128i zero   = _mm_setzero_si128();
+    __m128i t01    = _mm_unpacklo_epi8(texels, zero);
+    __m128i t23    = _mm_unpackhi_epi8(texels, zero);
+    __m128i w01    = _mm_set_epi16(d[1], d[1], d[1], d[1], d[0], d[0], d[0], d[0]);
+    __m128i w23    = _mm_set_epi16(d[3], d[3], d[3], d[3], d[2], d[2], d[2], d[2]);
+    __m128i sum    = _mm_add_epi16(_mm_mullo_epi16(t01, w01), _mm_mullo_epi16(t23, w23));
+    uint32_t bgra;
+
+    sum  = _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+    sum  = _mm_srli_epi16(sum, 8);
+    bgra = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+
+    state->tex_b[tmu] = bgra & 0xff;
+    state->tex_g[tmu] = (bgra >> 8) & 0xff;
+    state->tex_r[tmu] = (bgra >> 16) & 0xff;
+    state->tex_a[tmu] = (bgra >> 24) & 0xff;
+#elif defined(VOODOO_RENDER_NEON)
+    /* NEON equivalent of the SSE2 kernel above. */
+    uint8x16_t texels = vld1q_u8((const uint8_t *) dat);
+    uint16x8_t t01    = vmovl_u8(vget_low_u8(texels));
+    uint16x8_t t23    = vmovl_u8(vget_high_u8(texels));
+    uint16x8_t w01    = vcombine_u16(vdup_n_u16(d[0]), vdup_n_u16(d[1]));
+    uint16x8_t w23    = vcombine_u16(vdup_n_u16(d[2]), vdup_n_u16(d[3]));
+    uint16x8_t sum    = vaddq_u16(vmulq_u16(t01, w01), vmulq_u16(t23, w23));
+    uint16x4_t res    = vshr_n_u16(vadd_u16(vget_low_u16(sum), vget_high_u16(sum)), 8);
+
+    state->tex_b[tmu] = vget_lane_u16(res, 0);
+    state->tex_g[tmu] = vget_lane_u16(res, 1);
+    state->tex_r[tmu] = vget_lane_u16(res, 2);
+    state->tex_a[tmu] = vget_lane_u16(res, 3);
+#else
     state->tex_r[tmu] = (dat[0].rgba.r * d[0] + dat[1].rgba.r * d[1] + dat[2].rgba.r * d[2] + dat[3].rgba.r * d[3]) >> 8;
     state->tex_g[tmu] = (dat[0].rgba.g * d[0] + dat[1].rgba.g * d[1] + dat[2].rgba.g * d[2] + dat[3].rgba.g * d[3]) >> 8;
     state->tex_b[tmu] = (dat[0].rgba.b * d[0] + dat[1].rgba.b * d[1] + dat[2].rgba.b * d[2] + dat[3].rgba.b * d[3]) >> 8;
     state->tex_a[tmu] = (dat[0].rgba.a * d[0] + dat[1].rgba.a * d[1] + dat[2].rgba.a * d[2] + dat[3].rgba.a * d[3]) >> 8;
+#endif
 }
 
 static inline void
@@ -1588,28 +1634,52 @@ voodoo_render_thread_4(void *param)
 {
     render_thread(param, 3);
 }
+void
+voodoo_render_thread_5(void *param)
+{
+    render_thread(param, 4);
+}
+void
+voodoo_render_thread_6(void *param)
+{
+    render_thread(param, 5);
+}
+void
+voodoo_render_thread_7(void *param)
+{
+    render_thread(param, 6);
+}
+void
+voodoo_render_thread_8(void *param)
+{
+    render_thread(param, 7);
+}
+
+static int
+voodoo_param_full(voodoo_t *voodoo)
+{
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        if (PARAM_FULL(c))
+            return 1;
+    }
+
+    return 0;
+}
 
 void
 voodoo_queue_triangle(voodoo_t *voodoo, voodoo_params_t *params)
 {
     voodoo_params_t *params_new = &voodoo->params_buffer[voodoo->params_write_idx & PARAM_MASK];
-
-    while (PARAM_FULL(0) || (voodoo->render_threads >= 2 && PARAM_FULL(1)) || (voodoo->render_threads == 4 && (PARAM_FULL(2) || PARAM_FULL(3)))) {
-        thread_reset_event(voodoo->render_not_full_event[0]);
-        if (voodoo->render_threads >= 2)
-            thread_reset_event(voodoo->render_not_full_event[1]);
-        if (voodoo->render_threads == 4) {
-            thread_reset_event(voodoo->render_not_full_event[2]);
-            thread_reset_event(voodoo->render_not_full_event[3]);
+    int              c;
+    int              wake;
+
+    while (voodoo_param_full(voodoo)) {
+        for (c = 0; c < voodoo->render_threads; c++)
+            thread_reset_event(voodoo->render_not_full_event[c]);
+        for (c = 0; c < voodoo->render_threads; c++) {
+            if (PARAM_FULL(c))
+                thread_wait_event(voodoo->render_not_full_event[c], -1); /*Wait for room in ringbuffer*/
         }
-        if (PARAM_FULL(0))
-            thread_wait_event(voodoo->render_not_full_event[0], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads >= 2 && PARAM_FULL(1))
-            thread_wait_event(voodoo->render_not_full_event[1], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads == 4 && PARAM_FULL(2))
-            thread_wait_event(voodoo->render_not_full_event[2], -1); /*Wait for room in ringbuffer*/
-        if (voodoo->render_threads == 4 && PARAM_FULL(3))
-            thread_wait_event(voodoo->render_not_full_event[3], -1); /*Wait for room in ringbuffer*/
     }
 
     voodoo_use_texture(voodoo, params, 0);
@@ -1620,6 +1690,11 @@ voodoo_queue_triangle(voodoo_t *voodoo, voodoo_params_t *params)
 
     voodoo->params_write_idx++;
 
-    if (PARAM_ENTRIES(0) < 4 || (voodoo->render_threads >= 2 && PARAM_ENTRIES(1) < 4) || (voodoo->render_threads == 4 && (PARAM_ENTRIES(2) < 4 || PARAM_ENTRIES(3) < 4)))
+    wake = 0;
+    for (c = 0; c < voodoo->render_threads; c++) {
+        if (PARAM_ENTRIES(c) < 4)
+            wake = 1;
+    }
+    if (wake)
         voodoo_wake_render_thread(voodoo);
 }
@@ -239,6 +239,19 @@ voodoo_recalc_tex3(voodoo_t *voodoo, int tmu)
 
 #define makergba(r, g, b, a) ((b) | ((g) << 8) | ((r) << 16) | ((a) << 24))
 
+/* A texture entry is idle once every active render thread has consumed as
+   many references as have been queued. */
+static int
+voodoo_texture_idle(voodoo_t *voodoo, texture_t *tex)
+{
+    for (int c = 0; c < voodoo->render_threads; c++) {
+        if (tex->refcount != tex->refcount_r[c])
+            return 0;
+    }
+
+    return 1;
+}
+
 void
 voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
 {
@@ -285,7 +298,7 @@ voodoo_use_texture(voodoo_t *voodoo, voodoo_params_t *params, int tmu)
         for (c = 0; c < TEX_CACHE_MAX; c++) {
             voodoo->texture_last_removed++;
             voodoo->texture_last_removed &= (TEX_CACHE_MAX - 1);
-            if (voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount == voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount_r[0] && (voodoo->render_threads == 1 || voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount == voodoo->texture_cache[tmu][voodoo->texture_last_removed].refcount_r[1]))
+            if (voodoo_texture_idle(voodoo, &voodoo->texture_cache[tmu][voodoo->texture_last_removed]))
                 break;
         }
         if (c == TEX_CACHE_MAX)
@@ -576,7 +589,7 @@ flush_texture_cache(voodoo_t *voodoo, uint32_t dirty_addr, int tmu)
                         voodoo_texture_log("  Evict texture %i %08x\n", c, voodoo->texture_cache[tmu][c].base);
 #endif
 
-                        if (voodoo->texture_cache[tmu][c].refcount != voodoo->texture_cache[tmu][c].refcount_r[0] || (voodoo->render_threads == 2 && voodoo->texture_cache[tmu][c].refcount != voodoo->texture_cache[tmu][c].refcount_r[1]))
+                        if (!voodoo_texture_idle(voodoo, &voodoo->texture_cache[tmu][c]))
                             wait_for_idle = 1;
 
                         voodoo->texture_cache[tmu][c].base = -1;
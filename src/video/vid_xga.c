@@ -31,6 +31,7 @@
 #include <86box/timer.h>
 #include <86box/video.h>
 #include <86box/vid_xga.h>
+#include <86box/vid_accel_rop.h>
 #include <86box/vid_svga.h>
 #include <86box/vid_svga_render.h>
 #include <86box/vid_xga_device.h>
@@ -831,77 +832,7 @@ xga_ext_inb(uint16_t addr, void *priv)
     xga->vram[((addr)) & (xga->vram_mask)]                = dat >> 8;   \
     xga->changedvram[(((addr)) & (xga->vram_mask)) >> 12] = svga->monitor->mon_changeframecount;
 
-#define ROP(mix, d, s)                                                                 \
-    {                                                                                  \
-        switch ((mix) ? (xga->accel.frgd_mix & 0x1f) : (xga->accel.bkgd_mix & 0x1f)) { \
-            case 0x00:                                                                 \
-                d = 0;                                                                 \
-                break;                                                                 \
-            case 0x01:                                                                 \
-                d = s & d;                                                             \
-                break;                                                                 \
-            case 0x02:                                                                 \
-                d = s & ~d;                                                            \
-                break;                                                                 \
-            case 0x03:                                                                 \
-                d = s;                                                                 \
-                break;                                                                 \
-            case 0x04:                                                                 \
-                d = ~s & d;                                                            \
-                break;                                                                 \
-            case 0x05:                                                                 \
-                d = d;                                                                 \
-                break;                                                                 \
-            case 0x06:                                                                 \
-                d = s ^ d;                                                             \
-                break;                                                                 \
-            case 0x07:                                                                 \
-                d = s | d;                                                             \
-                break;                                                                 \
-            case 0x08:                                                                 \
-                d = ~s & ~d;                                                           \
-                break;                                                                 \
-            case 0x09:                                                                 \
-                d = s ^ ~d;                                                            \
-                break;                                                                 \
-            case 0x0a:                                                                 \
-                d = ~d;                                                                \
-                break;                                                                 \
-            case 0x0b:                                                                 \
-                d = s | ~d;                                                            \
-                break;                                                                 \
-            case 0x0c:                                                                 \
-                d = ~s;                                                                \
-                break;                                                                 \
-            case 0x0d:                                                                 \
-                d = ~s | d;                                                            \
-                break;                                                                 \
-            case 0x0e:                                                                 \
-                d = ~s | ~d;                                                           \
-                break;                                                                 \
-            case 0x0f:                                                                 \
-                d = ~0;                                                                \
-                break;                                                                 \
-            case 0x10:                                                                 \
-                d = MAX(s, d);                                                         \
-                break;                                                                 \
-            case 0x11:                                                                 \
-                d = MIN(s, d);                                                         \
-                break;                                                                 \
-            case 0x12:                                                                 \
-                d = MIN(~0, s + d);                                                  \
-                break;                                                                 \
-            case 0x13:                                                                 \
-                d = MAX(0, d - s);                                                     \
-                break;                                                                 \
-            case 0x14:                                                                 \
-                d = MAX(0, s - d);                                                     \
-                break;                                                                 \
-            case 0x15:                                                                 \
-                d = (s + d) >> 1;                                                      \
-                break;                                                                 \
-        }                                                                              \
-    }
+#define ROP(mix, d, s) d = xga_accel_rop((mix) ? frgd_rop : bkgd_rop, d, s)
 
 static uint32_t
 xga_accel_read_pattern_map_pixel(svga_t *svga, int x, int y, int map, uint32_t base, int width)
@@ -1128,7 +1059,9 @@ xga_accel_write_map_pixel(svga_t *svga, int x, int y, int map, uint32_t base, ui
 static void
 xga_short_stroke(svga_t *svga, uint8_t ssv)
 {
-    xga_t   *xga = (xga_t *) svga->xga;
+    xga_t        *xga      = (xga_t *) svga->xga;
+    const uint8_t frgd_rop = xga->accel.frgd_mix & 0x1f;
+    const uint8_t bkgd_rop = xga->accel.bkgd_mix & 0x1f;
     uint32_t src_dat;
     uint32_t dest_dat;
     uint32_t old_dest_dat;
@@ -1251,7 +1184,9 @@ xga_short_stroke(svga_t *svga, uint8_t ssv)
 static void
 xga_line_draw_write(svga_t *svga)
 {
-    xga_t   *xga = (xga_t *) svga->xga;
+    xga_t        *xga      = (xga_t *) svga->xga;
+    const uint8_t frgd_rop = xga->accel.frgd_mix & 0x1f;
+    const uint8_t bkgd_rop = xga->accel.bkgd_mix & 0x1f;
     uint32_t src_dat;
     uint32_t dest_dat;
     uint32_t old_dest_dat = 0x00000000;
@@ -1490,7 +1425,9 @@ xga_line_draw_write(svga_t *svga)
 static void
 xga_bitblt(svga_t *svga)
 {
-    xga_t   *xga = (xga_t *) svga->xga;
+    xga_t        *xga      = (xga_t *) svga->xga;
+    const uint8_t frgd_rop = xga->accel.frgd_mix & 0x1f;
+    const uint8_t bkgd_rop = xga->accel.bkgd_mix & 0x1f;
     uint8_t  area_state = 0;
     uint32_t src_dat;
     uint32_t dest_dat;
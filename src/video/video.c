@@ -73,12 +73,15 @@
 #include <86box/thread.h>
 #include <86box/video.h>
 #include <86box/vid_svga.h>
+#include <86box/frameexport.h>
+#include <86box/telemetry.h>
 
 #include <minitrace/minitrace.h>
 
 volatile int screenshots = 0;
 uint8_t      edatlookup[4][4];
 uint8_t      egaremap2bpp[256];
+uint64_t     plane4lookup[4][256];        /* Planar byte to 8 chunky 4bpp pixels */
 uint8_t      fontdat[2048][8];            /* IBM CGA font */
 uint8_t      fontdatm[2048][16];          /* IBM MDA font */
 uint8_t      fontdat2[2048][8];           /* IBM CGA 2nd instance font */
@@ -93,6 +96,8 @@ int          frames               = 0;
 int          fullchange           = 0;
 int          video_grayscale      = 0;
 int          video_graytype       = 0;
+int          video_threaded_render = 0;
+int          video_frame_pacing   = 0;
 int          monitor_index_global = 0;
 uint32_t    *video_6to8           = NULL;
 uint32_t    *video_8togs          = NULL;
@@ -241,6 +246,14 @@ typedef struct blit_data_struct {
     int thread_run;
     int monitor_index;
 
+    /* Dirty rectangle reported by the video card, accumulated until a
+       renderer takes it. dirty_pending flags that the card reported one
+       for the frame being submitted; cards that do not track dirty state
+       leave it clear and renderers get the full blit rectangle. */
+    int dirty_x, dirty_y, dirty_w, dirty_h;
+    int dirty_valid;
+    int dirty_pending;
+
     thread_t *blit_thread;
     event_t  *wake_blit_thread;
     event_t  *blit_complete;
@@ -307,13 +320,34 @@ video_wait_for_buffer_monitor(int monitor_index)
 static png_structp png_ptr[MONITORS_NUM];
 static png_infop   info_ptr[MONITORS_NUM];
 
+/* Asynchronous screenshot pipeline: the blit thread only copies the frame
+   into a job and queues it; a single worker thread does the PNG encode so
+   a capture does not stall blitting (and, through the buffer handshake,
+   the emulation thread). */
+#define SCREENSHOT_QUEUE_LEN 4
+
+typedef struct shot_job_t {
+    char      path[1024];
+    uint32_t *buf; /* tightly packed w*h pixel copy, owned by the job */
+    int       w;
+    int       h;
+    int       monitor_index;
+} shot_job_t;
+
+static shot_job_t   shot_queue[SCREENSHOT_QUEUE_LEN];
+static int          shot_head;
+static int          shot_tail;
+static mutex_t     *shot_mutex;
+static thread_t    *shot_thread;
+static event_t     *shot_wake;
+static volatile int shot_thread_run;
+
 static void
-video_take_screenshot_monitor(const char *fn, uint32_t *buf, int start_x, int start_y, int row_len, int monitor_index)
+video_take_screenshot_monitor(const char *fn, const uint32_t *buf, int start_x, int start_y, int row_len, int w, int h, int monitor_index)
 {
-    png_bytep         *b_rgb         = NULL;
-    FILE              *fp            = NULL;
-    uint32_t           temp          = 0x00000000;
-    const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+    png_bytep *b_rgb = NULL;
+    FILE      *fp    = NULL;
+    uint32_t   temp  = 0x00000000;
 
     /* create file */
     fp = plat_fopen(fn, (const char *) "wb");
@@ -340,20 +374,20 @@ video_take_screenshot_monitor(const char *fn, uint32_t *buf, int start_x, int st
 
     png_init_io(png_ptr[monitor_index], fp);
 
-    png_set_IHDR(png_ptr[monitor_index], info_ptr[monitor_index], blit_data_ptr->w, blit_data_ptr->h,
+    png_set_IHDR(png_ptr[monitor_index], info_ptr[monitor_index], w, h,
                  8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
                  PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
-    b_rgb = (png_bytep *) malloc(sizeof(png_bytep) * blit_data_ptr->h);
+    b_rgb = (png_bytep *) malloc(sizeof(png_bytep) * h);
     if (b_rgb == NULL) {
         video_log("[video_take_screenshot] Unable to Allocate RGB Bitmap Memory");
         fclose(fp);
         return;
     }
 
-    for (int y = 0; y < blit_data_ptr->h; ++y) {
+    for (int y = 0; y < h; ++y) {
         b_rgb[y] = (png_byte *) malloc(png_get_rowbytes(png_ptr[monitor_index], info_ptr[monitor_index]));
-        for (int x = 0; x < blit_data_ptr->w; ++x) {
+        for (int x = 0; x < w; ++x) {
             if (buf == NULL)
                 memset(&(b_rgb[y][x * 3]), 0x00, 3);
             else {
@@ -372,7 +406,7 @@ video_take_screenshot_monitor(const char *fn, uint32_t *buf, int start_x, int st
     png_write_end(png_ptr[monitor_index], NULL);
 
     /* cleanup heap allocation */
-    for (int i = 0; i < blit_data_ptr->h; i++)
+    for (int i = 0; i < h; i++)
         if (b_rgb[i])
             free(b_rgb[i]);
 
@@ -383,31 +417,90 @@ video_take_screenshot_monitor(const char *fn, uint32_t *buf, int start_x, int st
         fclose(fp);
 }
 
+static void
+screenshot_thread(UNUSED(void *param))
+{
+    shot_job_t job;
+    char       msg[1060];
+
+    while (1) {
+        thread_wait_event(shot_wake, -1);
+        thread_reset_event(shot_wake);
+
+        for (;;) {
+            thread_wait_mutex(shot_mutex);
+            if (shot_tail == shot_head) {
+                thread_release_mutex(shot_mutex);
+                break;
+            }
+            job       = shot_queue[shot_tail];
+            shot_tail = (shot_tail + 1) % SCREENSHOT_QUEUE_LEN;
+            thread_release_mutex(shot_mutex);
+
+            video_take_screenshot_monitor(job.path, job.buf, 0, 0, job.w, job.w, job.h, job.monitor_index);
+            png_destroy_write_struct(&png_ptr[job.monitor_index], &info_ptr[job.monitor_index]);
+            free(job.buf);
+
+            snprintf(msg, sizeof(msg), "Screenshot saved: %s", job.path);
+            ui_sb_set_text(msg);
+        }
+
+        if (!shot_thread_run)
+            break;
+    }
+}
+
 void
 video_screenshot_monitor(uint32_t *buf, int start_x, int start_y, int row_len, int monitor_index)
 {
-    char path[1024];
-    char fn[256];
+    const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+    shot_job_t         job;
+    char               fn[256];
 
     memset(fn, 0, sizeof(fn));
-    memset(path, 0, sizeof(path));
+    memset(&job, 0, sizeof(job));
 
-    path_append_filename(path, usr_path, SCREENSHOT_PATH);
+    path_append_filename(job.path, usr_path, SCREENSHOT_PATH);
 
-    if (!plat_dir_check(path))
-        plat_dir_create(path);
+    if (!plat_dir_check(job.path))
+        plat_dir_create(job.path);
 
-    path_slash(path);
-    strcat(path, "Monitor_");
-    snprintf(&path[strlen(path)], 42, "%d_", monitor_index + 1);
+    path_slash(job.path);
+    strcat(job.path, "Monitor_");
+    snprintf(&job.path[strlen(job.path)], 42, "%d_", monitor_index + 1);
 
     plat_tempfile(fn, NULL, ".png");
-    strcat(path, fn);
-
-    video_log("taking screenshot to: %s\n", path);
+    strcat(job.path, fn);
+
+    video_log("taking screenshot to: %s\n", job.path);
+
+    job.w             = blit_data_ptr->w;
+    job.h             = blit_data_ptr->h;
+    job.monitor_index = monitor_index;
+
+    /* Grab the frame now, while the caller's buffer is valid; the encode
+       happens later on the worker thread. A NULL buffer yields the same
+       black image it always did. */
+    if (buf != NULL) {
+        job.buf = malloc((size_t) job.w * job.h * sizeof(uint32_t));
+        if (job.buf != NULL) {
+            for (int row = 0; row < job.h; row++)
+                memcpy(&job.buf[row * job.w], &buf[((start_y + row) * row_len) + start_x], job.w * sizeof(uint32_t));
+        }
+    }
 
-    video_take_screenshot_monitor((const char *) path, buf, start_x, start_y, row_len, monitor_index);
-    png_destroy_write_struct(&png_ptr[monitor_index], &info_ptr[monitor_index]);
+    thread_wait_mutex(shot_mutex);
+    if (((shot_head + 1) % SCREENSHOT_QUEUE_LEN) == shot_tail) {
+        /* Queue full - drop this capture rather than stall the blit. */
+        thread_release_mutex(shot_mutex);
+        video_log("video_screenshot: queue full, dropping %s\n", job.path);
+        free(job.buf);
+    } else {
+        shot_queue[shot_head] = job;
+        shot_head             = (shot_head + 1) % SCREENSHOT_QUEUE_LEN;
+        thread_release_mutex(shot_mutex);
+        thread_set_event(shot_wake);
+    }
 
     atomic_fetch_sub(&monitors[monitor_index].mon_screenshots, 1);
 }
@@ -450,8 +543,12 @@ blit_thread(void *param)
         thread_reset_event(data->wake_blit_thread);
         MTR_BEGIN("video", "blit_thread");
 
-        if (blit_func)
+        if (blit_func) {
+            uint32_t blit_start = plat_get_micro_ticks();
+
             blit_func(data->x, data->y, data->w, data->h, data->monitor_index);
+            telemetry_blit_us += plat_get_micro_ticks() - blit_start;
+        }
 
         data->busy = 0;
 
@@ -460,6 +557,106 @@ blit_thread(void *param)
     }
 }
 
+/* Report the area of the target buffer the video card changed this frame.
+   Called (possibly repeatedly) before video_blit_memtoscreen_monitor();
+   an empty rectangle is valid and means nothing changed. */
+void
+video_blit_set_dirty_rect_monitor(int x, int y, int w, int h, int monitor_index)
+{
+    blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+
+    if ((w > 0) && (h > 0)) {
+        if (blit_data_ptr->dirty_w > 0) {
+            int x1 = blit_data_ptr->dirty_x + blit_data_ptr->dirty_w;
+            int y1 = blit_data_ptr->dirty_y + blit_data_ptr->dirty_h;
+
+            if (x < blit_data_ptr->dirty_x)
+                blit_data_ptr->dirty_x = x;
+            if (y < blit_data_ptr->dirty_y)
+                blit_data_ptr->dirty_y = y;
+            if ((x + w) > x1)
+                x1 = x + w;
+            if ((y + h) > y1)
+                y1 = y + h;
+
+            blit_data_ptr->dirty_w = x1 - blit_data_ptr->dirty_x;
+            blit_data_ptr->dirty_h = y1 - blit_data_ptr->dirty_y;
+        } else {
+            blit_data_ptr->dirty_x = x;
+            blit_data_ptr->dirty_y = y;
+            blit_data_ptr->dirty_w = w;
+            blit_data_ptr->dirty_h = h;
+        }
+    }
+
+    blit_data_ptr->dirty_pending = 1;
+}
+
+/* Called by the renderer (on the blit thread) when it is about to copy the
+   target buffer: returns the accumulated dirty rectangle and resets it. If
+   the card did not report dirty state for this frame, the full blit
+   rectangle is returned instead. */
+void
+video_blit_take_dirty_rect_monitor(int *x, int *y, int *w, int *h, int monitor_index)
+{
+    blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+
+    if (blit_data_ptr->dirty_valid) {
+        *x = blit_data_ptr->dirty_x;
+        *y = blit_data_ptr->dirty_y;
+        *w = blit_data_ptr->dirty_w;
+        *h = blit_data_ptr->dirty_h;
+    } else {
+        *x = blit_data_ptr->x;
+        *y = blit_data_ptr->y;
+        *w = blit_data_ptr->w;
+        *h = blit_data_ptr->h;
+    }
+
+    blit_data_ptr->dirty_w = 0;
+    blit_data_ptr->dirty_h = 0;
+}
+
+/* Called by the UI layer when the renderer learns the refresh rate of the
+   host display a monitor is shown on. */
+void
+video_host_refresh_rate_monitor(double hz, int monitor_index)
+{
+    monitors[monitor_index].mon_host_refresh = hz;
+}
+
+/* Frame pacing: decide at the start of an emulated frame whether its render
+   can be dropped because the host display cannot show it anyway - a 70 Hz
+   VGA mode on a 60 Hz host display produces frames nobody sees. Emulated
+   timing is unaffected; the caller keeps running its poll loop and only
+   omits the pixel work and the blit. Returns 1 if the frame may be
+   skipped. */
+int
+video_frame_pace_monitor(int monitor_index)
+{
+    monitor_t *monitor = &monitors[monitor_index];
+    uint64_t   period;
+
+    if ((monitor->mon_frame_skip_limit <= 0) || (monitor->mon_host_refresh <= 1.0))
+        return 0;
+
+    /* Never drop more frames in a row than the limit allows - a low limit
+       favours smoothness, a high one saves more render time. */
+    if (monitor->mon_frames_skipped >= monitor->mon_frame_skip_limit) {
+        monitor->mon_frames_skipped = 0;
+        return 0;
+    }
+
+    period = (uint64_t) ((double) timer_freq / monitor->mon_host_refresh);
+    if ((plat_timer_read() - monitor->mon_last_present) < period) {
+        monitor->mon_frames_skipped++;
+        return 1;
+    }
+
+    monitor->mon_frames_skipped = 0;
+    return 0;
+}
+
 void
 video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index)
 {
@@ -470,6 +667,9 @@ video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index)
 
     video_wait_for_blit_monitor(monitor_index);
 
+    monitors[monitor_index].mon_blit_data_ptr->dirty_valid   = monitors[monitor_index].mon_blit_data_ptr->dirty_pending;
+    monitors[monitor_index].mon_blit_data_ptr->dirty_pending = 0;
+    monitors[monitor_index].mon_last_present                 = plat_timer_read();
     monitors[monitor_index].mon_blit_data_ptr->busy          = 1;
     monitors[monitor_index].mon_blit_data_ptr->buffer_in_use = 1;
     monitors[monitor_index].mon_blit_data_ptr->x             = x;
@@ -477,10 +677,33 @@ video_blit_memtoscreen_monitor(int x, int y, int w, int h, int monitor_index)
     monitors[monitor_index].mon_blit_data_ptr->w             = w;
     monitors[monitor_index].mon_blit_data_ptr->h             = h;
 
+    /* Publish the frame to the export channel before the blit thread is
+       woken, while the target buffer is still ours. */
+    if (frameexport_on) {
+        const blit_data_t *blit_data_ptr = monitors[monitor_index].mon_blit_data_ptr;
+
+        frameexport_frame(x, y, w, h, blit_data_ptr->dirty_x, blit_data_ptr->dirty_y,
+                          blit_data_ptr->dirty_w, blit_data_ptr->dirty_h,
+                          blit_data_ptr->dirty_valid, monitor_index);
+    }
+
     thread_set_event(monitors[monitor_index].mon_blit_data_ptr->wake_blit_thread);
     MTR_END("video", "video_blit_memtoscreen");
 }
 
+/* FNV-1a running hash over a block of bytes; the text-mode renderers use it
+   to detect rows that have not changed since the last frame. */
+uint32_t
+video_hash(uint32_t hash, const void *data, int len)
+{
+    const uint8_t *p = (const uint8_t *) data;
+
+    while (len--)
+        hash = (hash ^ *p++) * 0x01000193;
+
+    return hash;
+}
+
 uint8_t
 pixels8(uint32_t *pixels)
 {
@@ -857,6 +1080,7 @@ video_monitor_init(int index)
     monitors[index].mon_unscaled_size_y                  = 480;
     monitors[index].mon_bpp                              = 8;
     monitors[index].mon_changeframecount                 = 2;
+    monitors[index].mon_frame_skip_limit                 = video_frame_pacing;
     monitors[index].target_buffer                        = create_bitmap(2048, 2048);
     monitors[index].mon_blit_data_ptr                    = calloc(1, sizeof(blit_data_t));
     monitors[index].mon_blit_data_ptr->wake_blit_thread  = thread_create_event();
@@ -935,6 +1159,21 @@ video_init(void)
         }
     }
 
+    /* Expansion of one plane byte to eight chunky 4bpp pixels: pixel k
+       (leftmost first) takes bit (7 - k) of the byte into nibble k, at the
+       bit position of the plane. ORing the four plane lookups together
+       yields a full 8-pixel group in one step. */
+    for (uint8_t plane = 0; plane < 4; plane++) {
+        for (uint16_t c = 0; c < 256; c++) {
+            uint64_t expanded = 0;
+            for (uint8_t k = 0; k < 8; k++) {
+                if (c & (0x80 >> k))
+                    expanded |= ((uint64_t) 1) << ((k << 2) + plane);
+            }
+            plane4lookup[plane][c] = expanded;
+        }
+    }
+
     for (uint16_t c = 0; c < 256; c++) {
         egaremap2bpp[c] = 0;
         if (c & 0x01)
@@ -967,6 +1206,11 @@ video_init(void)
     for (uint32_t c = 0; c < 65536; c++)
         video_16to32[c] = calc_16to32(c);
 
+    shot_mutex      = thread_create_mutex();
+    shot_wake       = thread_create_event();
+    shot_thread_run = 1;
+    shot_thread     = thread_create(screenshot_thread, NULL);
+
     memset(monitors, 0, sizeof(monitors));
     video_monitor_init(0);
 }
@@ -976,6 +1220,15 @@ video_close(void)
 {
     video_monitor_close(0);
 
+    /* The worker drains any queued screenshots before exiting. */
+    shot_thread_run = 0;
+    thread_set_event(shot_wake);
+    thread_wait(shot_thread);
+    thread_destroy_event(shot_wake);
+    thread_close_mutex(shot_mutex);
+
+    video_scaler_close();
+
     free(video_16to32);
     free(video_15to32);
     free(video_8to32);
@@ -0,0 +1,274 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          CPU-side frame scaler for renderers without GPU scaling.
+ *
+ *          The software renderer previously let the toolkit's raster
+ *          paint engine scale the emulated frame, one pixel at a time
+ *          on the UI thread. This module provides nearest-neighbour
+ *          and bilinear kernels that run band-parallel on a small
+ *          persistent worker pool (Voodoo render-thread style), with
+ *          an SSE2 path guarded the same way as the scanline
+ *          converters in vid_svga_render.c. The input frame already
+ *          contains any hardware cursor or overlay - the cards
+ *          compose those into the render buffer - so one pass over
+ *          the destination produces the final image.
+ *
+ * Authors: Sarah Walker, <https://pcem-emulator.co.uk/>
+ *          Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2008-2019 Sarah Walker.
+ *          Copyright 2016-2019 Miran Grca.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <wchar.h>
+
+#include <86box/86box.h>
+#include <86box/thread.h>
+#include <86box/video.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#    define SCALER_SSE2
+#    include <emmintrin.h>
+#endif
+
+/* Bands per frame: the calling thread takes one, the workers the rest. */
+#define SCALER_WORKERS 3
+#define SCALER_BANDS   (SCALER_WORKERS + 1)
+
+/* Frames shorter than this are scaled inline; waking the pool would cost
+   more than the row loops. */
+#define SCALER_MIN_PARALLEL_H 128
+
+/* One scale job at a time: the single caller (the UI paint path) fills
+   this in, fans the bands out, and waits for completion. */
+static struct {
+    uint32_t       *dst;
+    const uint32_t *src;
+    int             dst_pitch;
+    int             src_pitch;
+    int             dst_w;
+    int             dst_h;
+    int             src_w;
+    int             src_h;
+    int             bilinear;
+} scaler_job;
+
+typedef struct scaler_band_t {
+    thread_t *thread;
+    event_t  *wake;
+    event_t  *done;
+    int       y0;
+    int       y1;
+} scaler_band_t;
+
+static scaler_band_t scaler_bands[SCALER_WORKERS];
+static int           scaler_threads_run = 0;
+
+static void
+scale_row_nearest(uint32_t *dst, const uint32_t *src_row, int dst_w, uint32_t xstep)
+{
+    uint32_t u = xstep >> 1;
+
+    for (int x = 0; x < dst_w; x++) {
+        dst[x] = src_row[u >> 16];
+        u += xstep;
+    }
+}
+
+/* Per-channel-pair linear blend; f is 0-256. */
+static __inline uint32_t
+lerp_pixel(uint32_t a, uint32_t b, uint32_t f)
+{
+    uint32_t rb = ((((a & 0x00ff00ff) * (256 - f)) + ((b & 0x00ff00ff) * f)) >> 8) & 0x00ff00ff;
+    uint32_t ag = ((((a >> 8) & 0x00ff00ff) * (256 - f)) + (((b >> 8) & 0x00ff00ff) * f)) & 0xff00ff00;
+
+    return rb | ag;
+}
+
+static void
+scale_row_bilinear(uint32_t *dst, const uint32_t *row0, const uint32_t *row1,
+                   int dst_w, int src_w, uint32_t xstep, uint32_t fy)
+{
+    /* Half-texel offset so 1:1 spans reproduce the source exactly. */
+    int32_t u = (int32_t) (xstep >> 1) - 0x8000;
+    int     x = 0;
+
+#ifdef SCALER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vfy  = _mm_set1_epi16((short) fy);
+    const __m128i vify = _mm_set1_epi16((short) (256 - fy));
+
+    for (; x < dst_w; x++) {
+        int32_t uc = (u < 0) ? 0 : u;
+        int     sx = uc >> 16;
+
+        if (sx >= (src_w - 1))
+            break;
+
+        __m128i vfx  = _mm_set1_epi16((short) ((uc >> 8) & 0xff));
+        __m128i vifx = _mm_sub_epi16(_mm_set1_epi16(256), vfx);
+
+        /* [p00 p01] and [p10 p11] expanded to 16-bit channels. */
+        __m128i t01  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row0[sx]), zero);
+        __m128i b01  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) &row1[sx]), zero);
+        __m128i left = _mm_unpacklo_epi64(t01, b01);
+        __m128i rght = _mm_unpackhi_epi64(t01, b01);
+
+        /* Horizontal blend of both rows at once, then vertical blend. */
+        __m128i h = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(left, vifx),
+                                                 _mm_mullo_epi16(rght, vfx)), 8);
+        __m128i v = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(h, vify),
+                                                 _mm_mullo_epi16(_mm_unpackhi_epi64(h, h), vfy)), 8);
+
+        dst[x] = (uint32_t) _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+        u += (int32_t) xstep;
+    }
+#endif
+
+    /* Scalar path, also the right-edge tail of the SSE2 loop. */
+    for (; x < dst_w; x++) {
+        int32_t  uc  = (u < 0) ? 0 : u;
+        int      sx  = uc >> 16;
+        int      sx1 = (sx >= (src_w - 1)) ? (src_w - 1) : (sx + 1);
+        uint32_t fx  = (uc >> 8) & 0xff;
+
+        dst[x] = lerp_pixel(lerp_pixel(row0[sx], row0[sx1], fx),
+                            lerp_pixel(row1[sx], row1[sx1], fx), fy);
+        u += (int32_t) xstep;
+    }
+}
+
+static void
+scaler_run_band(int y0, int y1)
+{
+    uint32_t xstep = (uint32_t) ((((uint64_t) scaler_job.src_w) << 16) / scaler_job.dst_w);
+    uint32_t ystep = (uint32_t) ((((uint64_t) scaler_job.src_h) << 16) / scaler_job.dst_h);
+
+    if (scaler_job.bilinear) {
+        for (int y = y0; y < y1; y++) {
+            int32_t v = (int32_t) ((ystep >> 1) + ((uint32_t) y * ystep)) - 0x8000;
+            if (v < 0)
+                v = 0;
+
+            int sy  = v >> 16;
+            int sy1 = (sy >= (scaler_job.src_h - 1)) ? (scaler_job.src_h - 1) : (sy + 1);
+
+            scale_row_bilinear(scaler_job.dst + ((size_t) y * scaler_job.dst_pitch),
+                               scaler_job.src + ((size_t) sy * scaler_job.src_pitch),
+                               scaler_job.src + ((size_t) sy1 * scaler_job.src_pitch),
+                               scaler_job.dst_w, scaler_job.src_w, xstep, (v >> 8) & 0xff);
+        }
+    } else {
+        int prev_sy = -1;
+
+        for (int y = y0; y < y1; y++) {
+            int       sy  = (int) (((ystep >> 1) + ((uint32_t) y * ystep)) >> 16);
+            uint32_t *out = scaler_job.dst + ((size_t) y * scaler_job.dst_pitch);
+
+            /* Integer upscales repeat source rows; copy the finished row
+               instead of walking the DDA again. */
+            if (sy == prev_sy)
+                memcpy(out, out - scaler_job.dst_pitch, (size_t) scaler_job.dst_w * sizeof(uint32_t));
+            else
+                scale_row_nearest(out, scaler_job.src + ((size_t) sy * scaler_job.src_pitch),
+                                  scaler_job.dst_w, xstep);
+            prev_sy = sy;
+        }
+    }
+}
+
+static void
+scaler_thread(void *param)
+{
+    scaler_band_t *band = param;
+
+    while (scaler_threads_run) {
+        thread_wait_event(band->wake, -1);
+        thread_reset_event(band->wake);
+        if (!scaler_threads_run)
+            break;
+
+        scaler_run_band(band->y0, band->y1);
+        thread_set_event(band->done);
+    }
+}
+
+static void
+scaler_threads_init(void)
+{
+    scaler_threads_run = 1;
+
+    for (int c = 0; c < SCALER_WORKERS; c++) {
+        scaler_bands[c].wake   = thread_create_event();
+        scaler_bands[c].done   = thread_create_event();
+        scaler_bands[c].thread = thread_create_named(scaler_thread, &scaler_bands[c], "Frame scaler");
+    }
+}
+
+void
+video_scaler_blit(uint32_t *dst, int dst_pitch, int dst_w, int dst_h,
+                  const uint32_t *src, int src_pitch, int src_x, int src_y,
+                  int src_w, int src_h, int bilinear)
+{
+    if ((dst_w <= 0) || (dst_h <= 0) || (src_w <= 0) || (src_h <= 0))
+        return;
+
+    scaler_job.dst       = dst;
+    scaler_job.src       = src + ((size_t) src_y * src_pitch) + src_x;
+    scaler_job.dst_pitch = dst_pitch;
+    scaler_job.src_pitch = src_pitch;
+    scaler_job.dst_w     = dst_w;
+    scaler_job.dst_h     = dst_h;
+    scaler_job.src_w     = src_w;
+    scaler_job.src_h     = src_h;
+    scaler_job.bilinear  = bilinear;
+
+    if (dst_h < SCALER_MIN_PARALLEL_H) {
+        scaler_run_band(0, dst_h);
+        return;
+    }
+
+    if (!scaler_threads_run)
+        scaler_threads_init();
+
+    int band_h = (dst_h + SCALER_BANDS - 1) / SCALER_BANDS;
+
+    for (int c = 0; c < SCALER_WORKERS; c++) {
+        scaler_bands[c].y0 = (c + 1) * band_h;
+        scaler_bands[c].y1 = (c + 2) * band_h;
+        if (scaler_bands[c].y1 > dst_h)
+            scaler_bands[c].y1 = dst_h;
+        thread_set_event(scaler_bands[c].wake);
+    }
+
+    scaler_run_band(0, band_h);
+
+    for (int c = 0; c < SCALER_WORKERS; c++) {
+        thread_wait_event(scaler_bands[c].done, -1);
+        thread_reset_event(scaler_bands[c].done);
+    }
+}
+
+void
+video_scaler_close(void)
+{
+    if (!scaler_threads_run)
+        return;
+
+    scaler_threads_run = 0;
+    for (int c = 0; c < SCALER_WORKERS; c++) {
+        thread_set_event(scaler_bands[c].wake);
+        thread_wait(scaler_bands[c].thread);
+        thread_destroy_event(scaler_bands[c].wake);
+        thread_destroy_event(scaler_bands[c].done);
+    }
+}
@@ -178,21 +178,65 @@ vnc_display(rfbClientPtr cl)
 static void
 vnc_blit(int x, int y, int w, int h, int monitor_index)
 {
+    static int last_x = -1;
+    static int last_y = -1;
+    static int last_w = -1;
+    static int last_h = -1;
+    int        dx;
+    int        dy;
+    int        dw;
+    int        dh;
+
     if (monitor_index || (x < 0) || (y < 0) || (w < VNC_MIN_X) || (h < VNC_MIN_Y) || (w > VNC_MAX_X) || (h > VNC_MAX_Y) || (buffer32 == NULL)) {
         video_blit_complete_monitor(monitor_index);
         return;
     }
 
-    for (int row = 0; row < h; ++row)
-        video_copy(&(((uint8_t *) rfb->frameBuffer)[row * 2048 * sizeof(uint32_t)]), &(buffer32->line[y + row][x]), w * sizeof(uint32_t));
+    /* Only copy (and advertise) the area the video card changed this frame;
+       LibVNCServer's encoders then only process the hinted region instead of
+       re-encoding the whole framebuffer. Cards that do not track dirty state
+       report the full blit rectangle. */
+    video_blit_take_dirty_rect_monitor(&dx, &dy, &dw, &dh, monitor_index);
+
+    /* Translate from target buffer coordinates to framebuffer coordinates
+       and clamp; a blit rectangle change invalidates the whole frame. */
+    if ((x != last_x) || (y != last_y) || (w != last_w) || (h != last_h)) {
+        last_x = x;
+        last_y = y;
+        last_w = w;
+        last_h = h;
+
+        dx = 0;
+        dy = 0;
+        dw = w;
+        dh = h;
+    } else {
+        dx -= x;
+        dy -= y;
+        if (dx < 0) {
+            dw += dx;
+            dx = 0;
+        }
+        if (dy < 0) {
+            dh += dy;
+            dy = 0;
+        }
+        if ((dx + dw) > w)
+            dw = w - dx;
+        if ((dy + dh) > h)
+            dh = h - dy;
+    }
+
+    for (int row = dy; row < (dy + dh); ++row)
+        video_copy(&(((uint8_t *) rfb->frameBuffer)[((row * 2048) + dx) * sizeof(uint32_t)]), &(buffer32->line[y + row][x + dx]), dw * sizeof(uint32_t));
 
     if (screenshots)
         video_screenshot((uint32_t *) rfb->frameBuffer, 0, 0, VNC_MAX_X);
 
     video_blit_complete_monitor(monitor_index);
 
-    if (!updatingSize)
-        rfbMarkRectAsModified(rfb, 0, 0, allowedX, allowedY);
+    if (!updatingSize && (dw > 0) && (dh > 0))
+        rfbMarkRectAsModified(rfb, dx, dy, dx + dw, dy + dh);
 }
 
 /* Initialize VNC for operation. */
@@ -0,0 +1,140 @@
+/*
+ * 86Box    A hypervisor and IBM PC system emulator that specializes in
+ *          running old operating systems and software designed for IBM
+ *          PC systems and compatibles from 1981 through fairly recent
+ *          system designs based on the PCI bus.
+ *
+ *          This file is part of the 86Box distribution.
+ *
+ *          CPU thread hang watchdog. Started from the command line
+ *          (--watchdog s,path), it watches the pc_run() slice heartbeat
+ *          from its own thread: when the emulation thread has not
+ *          completed a slice for 's' seconds without being paused, it
+ *          writes a diagnostic dump to 'path' - current CS:EIP and
+ *          registers, the last blocks the dynarec dispatcher executed,
+ *          the pending timer heap and the registered devices - and the
+ *          process keeps running. One dump per stall: the trigger
+ *          re-arms once the heartbeat advances again.
+ *
+ *          The dump is advisory. It reads the CPU thread's state while
+ *          that thread may still be executing, so individual values can
+ *          be torn; for a wedged guest that is the trade that gets a
+ *          post-mortem without attaching a debugger.
+ *
+ *
+ *
+ * Authors: Miran Grca, <mgrca8@gmail.com>
+ *
+ *          Copyright 2026 Miran Grca.
+ */
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <wchar.h>
+#define HAVE_STDARG_H
+#include <86box/86box.h>
+#include "cpu.h"
+#include <86box/plat.h>
+#include <86box/plat_unused.h>
+#include <86box/thread.h>
+#include <86box/timer.h>
+#include <86box/device.h>
+#include <86box/gdbstub.h>
+#include <86box/version.h>
+#include <86box/watchdog.h>
+
+uint32_t watchdog_blocks[WATCHDOG_BLOCK_RING];
+uint32_t watchdog_block_idx = 0;
+
+volatile uint32_t watchdog_heartbeat = 0;
+
+static int  watchdog_secs = 0;
+static char watchdog_path[1024];
+
+static void
+watchdog_dump(int stalled_secs)
+{
+    char      now_str[64];
+    time_t    now = time(NULL);
+    uint32_t  idx = watchdog_block_idx;
+    FILE     *fp;
+
+    fp = plat_fopen(watchdog_path, "w");
+    if (fp == NULL) {
+        pclog("WATCHDOG: unable to open \"%s\" for writing\n", watchdog_path);
+        return;
+    }
+
+    strftime(now_str, sizeof(now_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    fprintf(fp, "%s v%s hang dump - %s\n", EMU_NAME, EMU_VERSION_FULL, now_str);
+    fprintf(fp, "No pc_run() slice completed for %d seconds (heartbeat %u).\n\n",
+            stalled_secs, watchdog_heartbeat);
+
+    fprintf(fp, "CPU state:\n");
+    fprintf(fp, "  PC=%08X (CS base %08X, EIP %08X), previous EIP %08X\n",
+            cs + cpu_state.pc, cs, cpu_state.pc, cpu_state.oldpc);
+    fprintf(fp, "  EAX=%08X EBX=%08X ECX=%08X EDX=%08X\n", EAX, EBX, ECX, EDX);
+    fprintf(fp, "  ESI=%08X EDI=%08X EBP=%08X ESP=%08X\n", ESI, EDI, EBP, ESP);
+    fprintf(fp, "  flags=%04X eflags=%04X\n\n", cpu_state.flags, cpu_state.eflags);
+
+    /* Oldest to newest, so the wedged loop reads bottom-up. */
+    fprintf(fp, "Last %d dispatched blocks (oldest first):\n", WATCHDOG_BLOCK_RING);
+    for (uint32_t i = 0; i < WATCHDOG_BLOCK_RING; i++)
+        fprintf(fp, "  %08X%s", watchdog_blocks[(idx + i) & (WATCHDOG_BLOCK_RING - 1)],
+                ((i & 7) == 7) ? "\n" : "");
+    fprintf(fp, "\n");
+
+    timer_dump(fp);
+    fprintf(fp, "\n");
+
+    device_dump(fp);
+
+    fclose(fp);
+
+    pclog("WATCHDOG: no slice for %d seconds, dump written to \"%s\"\n",
+          stalled_secs, watchdog_path);
+}
+
+static void
+watchdog_thread(UNUSED(void *priv))
+{
+    uint32_t last    = watchdog_heartbeat;
+    int      stalled = 0;
+    int      dumped  = 0;
+
+    while (1) {
+        plat_delay_ms(1000);
+
+        uint32_t beat = watchdog_heartbeat;
+
+        /* A paused machine and a CPU parked by the GDB stub are
+           stalled on purpose. */
+        if ((beat != last) || dopause || (gdbstub_step != GDBSTUB_EXEC)) {
+            last    = beat;
+            stalled = 0;
+            dumped  = 0;
+            continue;
+        }
+
+        if ((++stalled >= watchdog_secs) && !dumped) {
+            watchdog_dump(stalled);
+            dumped = 1;
+        }
+    }
+}
+
+void
+watchdog_start(int secs, const char *path)
+{
+    if (secs <= 0)
+        return;
+
+    watchdog_secs = secs;
+    strncpy(watchdog_path, path, sizeof(watchdog_path) - 1);
+
+    pclog("WATCHDOG: dumping to \"%s\" after %d stalled seconds\n", path, secs);
+    thread_create_named(watchdog_thread, NULL, "hang watchdog");
+}
@@ -538,7 +538,7 @@ main_thread(void *param)
         old_time = new_time;
         if (drawits > 0 && !dopause) {
             /* Yes, so do one frame now. */
-            drawits -= 10;
+            drawits -= pc_slice_ms;
             if (drawits > 50)
                 drawits = 0;
 
@@ -733,6 +733,34 @@ plat_remove(char *path)
     }
 }
 
+int
+plat_rename(char *oldpath, char *newpath)
+{
+    wchar_t *oldw;
+    wchar_t *neww;
+    int      len;
+    int      ret;
+
+    if (acp_utf8)
+        ret = !MoveFileExA(oldpath, newpath, MOVEFILE_REPLACE_EXISTING);
+    else {
+        len  = mbstoc16s(NULL, oldpath, 0) + 1;
+        oldw = malloc(len * sizeof(wchar_t));
+        mbstoc16s(oldw, oldpath, len);
+
+        len  = mbstoc16s(NULL, newpath, 0) + 1;
+        neww = malloc(len * sizeof(wchar_t));
+        mbstoc16s(neww, newpath, len);
+
+        ret = !MoveFileExW(oldw, neww, MOVEFILE_REPLACE_EXISTING);
+
+        free(oldw);
+        free(neww);
+    }
+
+    return ret;
+}
+
 void
 path_normalize(UNUSED(char *path))
 {
@@ -905,6 +933,22 @@ plat_mmap(size_t size, uint8_t executable)
     return VirtualAlloc(NULL, size, MEM_COMMIT, executable ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE);
 }
 
+void *
+plat_mmap_huge(size_t size, uint8_t executable)
+{
+    SIZE_T large_page = GetLargePageMinimum();
+
+    if (large_page == 0)
+        return NULL;
+
+    /* Large-page allocations require a size that is a multiple of the
+       large page and the SeLockMemoryPrivilege; fail gracefully so the
+       caller can fall back to plat_mmap(). */
+    size = (size + (large_page - 1)) & ~(large_page - 1);
+
+    return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, executable ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE);
+}
+
 void
 plat_get_global_config_dir(char *strptr)
 {
@@ -955,6 +999,79 @@ plat_munmap(void *ptr, UNUSED(size_t size))
     VirtualFree(ptr, 0, MEM_RELEASE);
 }
 
+/* Map a file into memory as a shared read/write mapping, growing it to
+   'size' bytes; other processes mapping the same file see the writes. */
+void *
+plat_mmap_file(const char *path, size_t size)
+{
+    HANDLE   file;
+    HANDLE   mapping;
+    void    *view;
+    wchar_t *pathw;
+    int      len;
+
+    if (acp_utf8)
+        file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    else {
+        len   = mbstoc16s(NULL, path, 0) + 1;
+        pathw = malloc(sizeof(wchar_t) * len);
+        mbstoc16s(pathw, path, len);
+
+        file = CreateFileW(pathw, GENERIC_READ | GENERIC_WRITE,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        free(pathw);
+    }
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    /* The mapping object grows the file to 'size' bytes. */
+    mapping = CreateFileMappingW(file, NULL, PAGE_READWRITE,
+                                 (DWORD) ((uint64_t) size >> 32),
+                                 (DWORD) (size & 0xffffffff), NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    /* The view keeps both handles alive until it is unmapped. */
+    CloseHandle(mapping);
+    CloseHandle(file);
+
+    return view;
+}
+
+void
+plat_munmap_file(void *ptr, UNUSED(size_t size))
+{
+    UnmapViewOfFile(ptr);
+}
+
+/* Tell the OS the range will not be touched for a while, so it can be
+   reclaimed under memory pressure; the contents stay valid and fault back
+   in on the next access. VirtualUnlock on an unlocked range drops it from
+   the working set onto the standby list. */
+void
+plat_memory_cold(void *ptr, size_t size)
+{
+    VirtualUnlock(ptr, size);
+}
+
+/* The caller guarantees the range contains only zero bytes. Windows has no
+   discard primitive that guarantees zero-fill on the next read
+   (DiscardVirtualMemory leaves the contents undefined), so this stays a
+   no-op here; the cold advice above still lets the range be paged out. */
+void
+plat_memory_free_zero(void *ptr, size_t size)
+{
+    (void) ptr;
+    (void) size;
+}
+
 uint64_t
 plat_timer_read(void)
 {
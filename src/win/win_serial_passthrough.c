@@ -167,6 +167,23 @@ plat_serpt_read(void *priv, uint8_t *data)
     return res;
 }
 
+int
+plat_serpt_read_buf(void *priv, uint8_t *data, int max)
+{
+    serial_passthrough_t *dev       = (serial_passthrough_t *) priv;
+    DWORD                 bytesRead = 0;
+
+    switch (dev->mode) {
+        case SERPT_MODE_VCON:
+        case SERPT_MODE_HOSTSER:
+            ReadFile((HANDLE) dev->master_fd, data, max, &bytesRead, NULL);
+            break;
+        default:
+            break;
+    }
+    return (int) bytesRead;
+}
+
 static int
 open_pseudo_terminal(serial_passthrough_t *dev)
 {